@@ -7,6 +7,9 @@
 /* Define to 1 if you have the `chdir' function. */
 #define HAVE_CHDIR 1
 
+/* Define to 1 if you have the `clock_gettime' function. */
+#define HAVE_CLOCK_GETTIME 1
+
 /* Define to 1 if you have the `close' function. */
 #define HAVE_CLOSE 1
 
@@ -16,6 +19,9 @@
 /* Define to 1 if you have the `ctime' function. */
 /* #undef HAVE_CTIME */
 
+/* Define to 1 if you have the <cpuid.h> header file. */
+#define HAVE_CPUID_H 1
+
 /* Define to 1 if you have the ctime_r function. */
 #define HAVE_CTIME_R 1
 
@@ -42,6 +48,9 @@
 /* Define to 1 if you have the <dlfcn.h> header file. */
 #define HAVE_DLFCN_H 1
 
+/* Define to 1 if you have the <emmintrin.h> header file. */
+#define HAVE_EMMINTRIN_H 1
+
 /* Define to 1 if you have the <errno.h> header file. */
 #define HAVE_ERRNO_H 1
 
@@ -81,6 +90,9 @@
 /* Define to 1 if you have the `getopt' function. */
 #define HAVE_GETOPT 1
 
+/* Define to 1 if you have the `gettimeofday' function. */
+#define HAVE_GETTIMEOFDAY 1
+
 /* Define to 1 if you have the <glob.h> header file. */
 #define HAVE_GLOB_H 1
 
@@ -93,6 +105,9 @@
 /* Define to 1 if GUID support is available. */
 #define HAVE_GUID_SUPPORT 1
 
+/* Define to 1 if you have the <immintrin.h> header file. */
+#define HAVE_IMMINTRIN_H 1
+
 /* Define to 1 if you have the <inttypes.h> header file. */
 #define HAVE_INTTYPES_H 1
 
@@ -111,6 +126,15 @@
 /* Define to 1 if you have the 'crypto' library (-lcrypto). */
 #define HAVE_LIBCRYPTO 1
 
+/* Define to 1 if you have the `deflate' library (-ldeflate). */
+/* #undef HAVE_LIBDEFLATE */
+
+/* Define to 1 if you have the <libdeflate.h> header file. */
+/* #undef HAVE_LIBDEFLATE_H */
+
+/* Define to 1 if you have the `pthread' library (-lpthread). */
+#define HAVE_LIBPTHREAD 1
+
 /* Define to 1 if you have the `una' library (-luna). */
 /* #undef HAVE_LIBUNA */
 
@@ -135,6 +159,9 @@
 /* Define to 1 if you have the <linux/hdreg.h> header file. */
 #define HAVE_LINUX_HDREG_H 1
 
+/* Define to 1 if you have the <linux/io_uring.h> header file. */
+#define HAVE_LINUX_IO_URING_H 1
+
 /* Define to 1 if you have the <linux/usbdevice_fs.h> header file. */
 #define HAVE_LINUX_USBDEVICE_FS_H 1
 
@@ -197,29 +224,38 @@
 #define HAVE_OPEN 1
 
 /* Define to 1 if you have the <openssl/evp.h> header file. */
-#define HAVE_OPENSSL_EVP_H 1
+/* #undef HAVE_OPENSSL_EVP_H */
 
 /* Define to 1 if you have the <openssl/md5.h> header file. */
-/* #undef HAVE_OPENSSL_MD5_H */
+#define HAVE_OPENSSL_MD5_H 1
 
 /* Define to 1 if you have the <openssl/opensslv.h> header file. */
 #define HAVE_OPENSSL_OPENSSLV_H 1
 
 /* Define to 1 if you have the <openssl/sha.h> header file. */
-/* #undef HAVE_OPENSSL_SHA_H */
+#define HAVE_OPENSSL_SHA_H 1
 
 /* Define to 1 if you have the posix_fadvise unction. */
 #define HAVE_POSIX_FADVISE 1
 
+/* Define to 1 if you have the `pread' function. */
+#define HAVE_PREAD 1
+
 /* Define to 1 whether printf supports the conversion specifier "%jd". */
-#define HAVE_PRINTF_JD 1
+/* #undef HAVE_PRINTF_JD */
 
 /* Define to 1 whether printf supports the conversion specifier "%zd". */
-#define HAVE_PRINTF_ZD 1
+/* #undef HAVE_PRINTF_ZD */
+
+/* Define to 1 if you have the <pthread.h> header file. */
+#define HAVE_PTHREAD_H 1
 
 /* Have Python bindings */
 /* #undef HAVE_PYTHON */
 
+/* Define to 1 if you have the `pwrite' function. */
+#define HAVE_PWRITE 1
+
 /* Define to 1 if you have the `read' function. */
 #define HAVE_READ 1
 
@@ -307,12 +343,18 @@
 /* Define to 1 if you have the <sys/ioctl.h> header file. */
 #define HAVE_SYS_IOCTL_H 1
 
+/* Define to 1 if you have the <sys/mman.h> header file. */
+#define HAVE_SYS_MMAN_H 1
+
 /* Define to 1 if you have the <sys/signal.h> header file. */
 #define HAVE_SYS_SIGNAL_H 1
 
 /* Define to 1 if you have the <sys/stat.h> header file. */
 #define HAVE_SYS_STAT_H 1
 
+/* Define to 1 if you have the <sys/syscall.h> header file. */
+#define HAVE_SYS_SYSCALL_H 1
+
 /* Define to 1 if you have the <sys/types.h> header file. */
 #define HAVE_SYS_TYPES_H 1
 
@@ -0,0 +1,129 @@
+/*
+ * Thread functions
+ *
+ * Copyright (c) 2006-2009, Joachim Metz <forensics@hoffmannbv.nl>,
+ * Hoffmann Investigations.
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _THREAD_H )
+#define _THREAD_H
+
+#include "common.h"
+
+#if defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
+#include <pthread.h>
+#endif
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The functions below return 0 if successful, as the POSIX thread functions do
+ */
+#if defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
+#define HAVE_MULTI_THREAD_SUPPORT	1
+
+typedef pthread_t thread_t;
+typedef pthread_mutex_t thread_mutex_t;
+typedef pthread_rwlock_t thread_read_write_lock_t;
+typedef pthread_cond_t thread_condition_t;
+typedef pthread_once_t thread_once_t;
+typedef pthread_key_t thread_key_t;
+
+/* Thread
+ */
+#define thread_create( thread, start_function, start_function_arguments ) \
+	pthread_create( thread, NULL, start_function, (void *) start_function_arguments )
+
+#define thread_join( thread ) \
+	pthread_join( thread, NULL )
+
+/* Mutex
+ */
+#define thread_mutex_initialize( mutex ) \
+	pthread_mutex_init( mutex, NULL )
+
+#define thread_mutex_free( mutex ) \
+	pthread_mutex_destroy( mutex )
+
+#define thread_mutex_grab( mutex ) \
+	pthread_mutex_lock( mutex )
+
+#define thread_mutex_release( mutex ) \
+	pthread_mutex_unlock( mutex )
+
+/* Read/write lock
+ */
+#define thread_read_write_lock_initialize( lock ) \
+	pthread_rwlock_init( lock, NULL )
+
+#define thread_read_write_lock_free( lock ) \
+	pthread_rwlock_destroy( lock )
+
+#define thread_read_write_lock_grab_for_read( lock ) \
+	pthread_rwlock_rdlock( lock )
+
+#define thread_read_write_lock_grab_for_write( lock ) \
+	pthread_rwlock_wrlock( lock )
+
+#define thread_read_write_lock_release( lock ) \
+	pthread_rwlock_unlock( lock )
+
+/* Condition
+ */
+#define thread_condition_initialize( condition ) \
+	pthread_cond_init( condition, NULL )
+
+#define thread_condition_free( condition ) \
+	pthread_cond_destroy( condition )
+
+#define thread_condition_wait( condition, mutex ) \
+	pthread_cond_wait( condition, mutex )
+
+#define thread_condition_signal( condition ) \
+	pthread_cond_signal( condition )
+
+#define thread_condition_broadcast( condition ) \
+	pthread_cond_broadcast( condition )
+
+/* Once
+ */
+#define THREAD_ONCE_INITIALIZER	PTHREAD_ONCE_INIT
+
+#define thread_once( once, function ) \
+	pthread_once( once, function )
+
+/* Thread specific value
+ */
+#define thread_key_create( key, free_function ) \
+	pthread_key_create( key, free_function )
+
+#define thread_key_get_value( key ) \
+	pthread_getspecific( key )
+
+#define thread_key_set_value( key, value ) \
+	pthread_setspecific( key, (void *) value )
+
+#endif
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif
+
@@ -0,0 +1,1914 @@
+/*
+ * Benchmark handle
+ *
+ * Copyright (C) 2007-2009, Joachim Metz <forensics@hoffmannbv.nl>,
+ * Hoffmann Investigations.
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include <liberror.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( TIME_WITH_SYS_TIME )
+#include <sys/time.h>
+#include <time.h>
+#elif defined( HAVE_SYS_TIME_H )
+#include <sys/time.h>
+#else
+#include <time.h>
+#endif
+
+/* If libtool DLL support is enabled set LIBEWF_DLL_IMPORT
+ * before including libewf.h
+ */
+#if defined( _WIN32 ) && defined( DLL_EXPORT )
+#define LIBEWF_DLL_IMPORT
+#endif
+
+#include <libewf.h>
+
+#include <libsystem.h>
+
+#include "bench_handle.h"
+
+/* Initializes the benchmark handle
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_initialize(
+     bench_handle_t **bench_handle,
+     liberror_error_t **error )
+{
+	static char *function = "bench_handle_initialize";
+
+	if( bench_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *bench_handle == NULL )
+	{
+		*bench_handle = (bench_handle_t *) memory_allocate(
+		                                    sizeof( bench_handle_t ) );
+
+		if( *bench_handle == NULL )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_MEMORY,
+			 LIBERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create benchmark handle.",
+			 function );
+
+			return( -1 );
+		}
+		if( memory_set(
+		     *bench_handle,
+		     0,
+		     sizeof( bench_handle_t ) ) == NULL )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_MEMORY,
+			 LIBERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear benchmark handle.",
+			 function );
+
+			memory_free(
+			 *bench_handle );
+
+			*bench_handle = NULL;
+
+			return( -1 );
+		}
+#if defined( HAVE_V2_API )
+		if( libewf_handle_initialize(
+		     &( ( *bench_handle )->handle ),
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize handle.",
+			 function );
+
+			memory_free(
+			 *bench_handle );
+
+			*bench_handle = NULL;
+
+			return( -1 );
+		}
+#endif
+		( *bench_handle )->maximum_number_of_threads = 1;
+	}
+	return( 1 );
+}
+
+/* Frees the benchmark handle and its elements
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_free(
+     bench_handle_t **bench_handle,
+     liberror_error_t **error )
+{
+	static char *function = "bench_handle_free";
+	int result            = 1;
+
+	if( bench_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *bench_handle != NULL )
+	{
+#if defined( HAVE_V2_API )
+		if( ( ( *bench_handle )->handle != NULL )
+		 && ( libewf_handle_free(
+		       &( ( *bench_handle )->handle ),
+		       error ) != 1 ) )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free handle.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		if( ( *bench_handle )->data != NULL )
+		{
+			memory_free(
+			 ( *bench_handle )->data );
+		}
+		if( ( *bench_handle )->process_buffer != NULL )
+		{
+			memory_free(
+			 ( *bench_handle )->process_buffer );
+		}
+		memory_free(
+		 *bench_handle );
+
+		*bench_handle = NULL;
+	}
+	return( result );
+}
+
+/* Signals the benchmark handle to abort
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_signal_abort(
+     bench_handle_t *bench_handle,
+     liberror_error_t **error )
+{
+	static char *function = "bench_handle_signal_abort";
+
+	if( bench_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	bench_handle->abort = 1;
+
+	if( bench_handle->handle != NULL )
+	{
+#if defined( HAVE_V2_API )
+		if( libewf_handle_signal_abort(
+		     bench_handle->handle,
+		     error ) != 1 )
+#else
+		if( libewf_signal_abort(
+		     bench_handle->handle ) != 1 )
+#endif
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal handle to abort.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Sets the data values and synthesizes the data
+ * The same data values always result in the same data
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_set_data_values(
+     bench_handle_t *bench_handle,
+     size_t process_buffer_size,
+     uint8_t entropy,
+     uint8_t sparsity,
+     uint32_t seed,
+     liberror_error_t **error )
+{
+	static char *function = "bench_handle_set_data_values";
+	size_t block_offset   = 0;
+	size_t data_offset    = 0;
+	size_t random_size    = 0;
+	uint32_t random_value = 0;
+
+	if( bench_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( bench_handle->data != NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid benchmark handle - data already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( process_buffer_size == 0 )
+	 || ( process_buffer_size > (size_t) SSIZE_MAX ) )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_OUT_OF_RANGE,
+		 "%s: invalid process buffer size value out of range.",
+		 function );
+
+		return( -1 );
+	}
+	if( entropy > 100 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_OUT_OF_RANGE,
+		 "%s: invalid entropy value out of range.",
+		 function );
+
+		return( -1 );
+	}
+	if( sparsity > 100 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_OUT_OF_RANGE,
+		 "%s: invalid sparsity value out of range.",
+		 function );
+
+		return( -1 );
+	}
+	/* The data size is a multiple of the process buffer size
+	 * so that a process buffer never wraps around the end of the data
+	 */
+	bench_handle->data_size = ( ( BENCH_HANDLE_DATA_SIZE + process_buffer_size - 1 ) / process_buffer_size )
+	                        * process_buffer_size;
+
+	bench_handle->data = (uint8_t *) memory_allocate(
+	                                  sizeof( uint8_t ) * bench_handle->data_size );
+
+	if( bench_handle->data == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_MEMORY,
+		 LIBERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create data.",
+		 function );
+
+		return( -1 );
+	}
+	bench_handle->process_buffer = (uint8_t *) memory_allocate(
+	                                            sizeof( uint8_t ) * process_buffer_size );
+
+	if( bench_handle->process_buffer == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_MEMORY,
+		 LIBERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create process buffer.",
+		 function );
+
+		memory_free(
+		 bench_handle->data );
+
+		bench_handle->data = NULL;
+
+		return( -1 );
+	}
+	bench_handle->process_buffer_size = process_buffer_size;
+	bench_handle->entropy             = entropy;
+	bench_handle->sparsity            = sparsity;
+	bench_handle->seed                = seed;
+
+	/* The pseudo random generator cannot be seeded with 0
+	 */
+	if( seed == 0 )
+	{
+		seed = 1;
+	}
+	bench_handle->random_value = seed;
+
+	for( block_offset = 0; block_offset < bench_handle->data_size; block_offset += BENCH_HANDLE_BLOCK_SIZE )
+	{
+		if( ( bench_handle_get_random_value(
+		       bench_handle ) % 100 ) < (uint32_t) sparsity )
+		{
+			for( data_offset = 0; data_offset < BENCH_HANDLE_BLOCK_SIZE; data_offset++ )
+			{
+				if( ( block_offset + data_offset ) >= bench_handle->data_size )
+				{
+					break;
+				}
+				bench_handle->data[ block_offset + data_offset ] = 0;
+			}
+			continue;
+		}
+		random_size = ( BENCH_HANDLE_BLOCK_SIZE * (size_t) entropy ) / 100;
+
+		for( data_offset = 0; data_offset < BENCH_HANDLE_BLOCK_SIZE; data_offset++ )
+		{
+			if( ( block_offset + data_offset ) >= bench_handle->data_size )
+			{
+				break;
+			}
+			if( data_offset < random_size )
+			{
+				if( ( data_offset % 4 ) == 0 )
+				{
+					random_value = bench_handle_get_random_value(
+					                bench_handle );
+				}
+				bench_handle->data[ block_offset + data_offset ] = (uint8_t) ( random_value & 0xff );
+
+				random_value >>= 8;
+			}
+			else
+			{
+				/* The remainder of the block contains repetitive text
+				 */
+				bench_handle->data[ block_offset + data_offset ] = (uint8_t) ( 'a' + ( ( data_offset / 8 ) % 26 ) );
+			}
+		}
+	}
+	/* Restart the pseudo random generator so that the random reads
+	 * do not depend on the size of the data
+	 */
+	bench_handle->random_value = seed;
+
+	return( 1 );
+}
+
+/* Sets the maximum number of threads used to process the chunks
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_set_maximum_number_of_threads(
+     bench_handle_t *bench_handle,
+     int maximum_number_of_threads,
+     liberror_error_t **error )
+{
+	static char *function = "bench_handle_set_maximum_number_of_threads";
+
+	if( bench_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_number_of_threads <= 0 )
+	 || ( maximum_number_of_threads > LIBEWF_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_OUT_OF_RANGE,
+		 "%s: invalid maximum number of threads value out of range.",
+		 function );
+
+		return( -1 );
+	}
+	bench_handle->maximum_number_of_threads = maximum_number_of_threads;
+
+	return( 1 );
+}
+
+/* Retrieves the next value of the pseudo random generator
+ * A xorshift generator is used so that the values are the same on every platform
+ * Returns the value
+ */
+uint32_t bench_handle_get_random_value(
+          bench_handle_t *bench_handle )
+{
+	uint32_t random_value = 0;
+
+	if( bench_handle == NULL )
+	{
+		return( 0 );
+	}
+	random_value = bench_handle->random_value;
+
+	random_value ^= random_value << 13;
+	random_value ^= random_value >> 17;
+	random_value ^= random_value << 5;
+
+	bench_handle->random_value = random_value;
+
+	return( random_value );
+}
+
+/* Retrieves a timestamp in nano seconds
+ * The timestamp is only meaningful relative to another timestamp
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_get_timestamp(
+     uint64_t *timestamp,
+     liberror_error_t **error )
+{
+#if defined( WINAPI )
+	LARGE_INTEGER counter;
+	LARGE_INTEGER frequency;
+#elif defined( HAVE_CLOCK_GETTIME ) && defined( CLOCK_MONOTONIC )
+	struct timespec time_value;
+#elif defined( HAVE_GETTIMEOFDAY )
+	struct timeval time_value;
+#endif
+
+	static char *function = "bench_handle_get_timestamp";
+
+	if( timestamp == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid timestamp.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( WINAPI )
+	if( ( QueryPerformanceFrequency(
+	       &frequency ) == 0 )
+	 || ( QueryPerformanceCounter(
+	       &counter ) == 0 ) )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve performance counter.",
+		 function );
+
+		return( -1 );
+	}
+	*timestamp = (uint64_t) ( ( (double) counter.QuadPart * 1000000000.0 ) / (double) frequency.QuadPart );
+
+#elif defined( HAVE_CLOCK_GETTIME ) && defined( CLOCK_MONOTONIC )
+	if( clock_gettime(
+	     CLOCK_MONOTONIC,
+	     &time_value ) != 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve clock time.",
+		 function );
+
+		return( -1 );
+	}
+	*timestamp = ( (uint64_t) time_value.tv_sec * 1000000000 ) + (uint64_t) time_value.tv_nsec;
+
+#elif defined( HAVE_GETTIMEOFDAY )
+	if( gettimeofday(
+	     &time_value,
+	     NULL ) != 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve time of day.",
+		 function );
+
+		return( -1 );
+	}
+	*timestamp = ( (uint64_t) time_value.tv_sec * 1000000000 ) + ( (uint64_t) time_value.tv_usec * 1000 );
+
+#else
+	*timestamp = (uint64_t) time( NULL ) * 1000000000;
+#endif
+
+	return( 1 );
+}
+
+/* Compares two timestamps, used to sort the latencies
+ * Returns -1 if the first timestamp is smaller, 1 if larger or 0 if equal
+ */
+int bench_handle_compare_timestamps(
+     const void *first_timestamp,
+     const void *second_timestamp )
+{
+	if( *( (uint64_t *) first_timestamp ) < *( (uint64_t *) second_timestamp ) )
+	{
+		return( -1 );
+	}
+	else if( *( (uint64_t *) first_timestamp ) > *( (uint64_t *) second_timestamp ) )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Opens the output of the benchmark handle
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_open_output(
+     bench_handle_t *bench_handle,
+     const libsystem_character_t *filename,
+     liberror_error_t **error )
+{
+	libsystem_character_t *filenames[ 1 ] = { NULL };
+	static char *function                 = "bench_handle_open_output";
+
+	if( bench_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_V2_API )
+	if( bench_handle->handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid benchmark handle - missing handle.",
+		 function );
+
+		return( -1 );
+	}
+#else
+	if( bench_handle->handle != NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid benchmark handle - handle already set.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( filename == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	filenames[ 0 ] = (libsystem_character_t *) filename;
+
+#if defined( LIBSYSTEM_HAVE_WIDE_CHARACTER )
+#if defined( HAVE_V2_API )
+	if( libewf_handle_open_wide(
+	     bench_handle->handle,
+	     filenames,
+	     1,
+	     LIBEWF_OPEN_WRITE,
+	     error ) != 1 )
+#else
+	bench_handle->handle = libewf_open_wide(
+	                        filenames,
+	                        1,
+	                        LIBEWF_OPEN_WRITE );
+
+	if( bench_handle->handle == NULL )
+#endif
+#else
+#if defined( HAVE_V2_API )
+	if( libewf_handle_open(
+	     bench_handle->handle,
+	     filenames,
+	     1,
+	     LIBEWF_OPEN_WRITE,
+	     error ) != 1 )
+#else
+	bench_handle->handle = libewf_open(
+	                        filenames,
+	                        1,
+	                        LIBEWF_OPEN_WRITE );
+
+	if( bench_handle->handle == NULL )
+#endif
+#endif
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_IO,
+		 LIBERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file.",
+		 function );
+
+		return( -1 );
+	}
+	if( bench_handle->maximum_number_of_threads > 1 )
+	{
+#if defined( HAVE_V2_API )
+		if( libewf_handle_set_maximum_number_of_threads(
+		     bench_handle->handle,
+		     bench_handle->maximum_number_of_threads,
+		     error ) != 1 )
+#else
+		if( libewf_set_maximum_number_of_threads(
+		     bench_handle->handle,
+		     bench_handle->maximum_number_of_threads ) != 1 )
+#endif
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set maximum number of threads.",
+			 function );
+
+			bench_handle_close(
+			 bench_handle,
+			 NULL );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Opens the input of the benchmark handle
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_open_input(
+     bench_handle_t *bench_handle,
+     const libsystem_character_t *filename,
+     liberror_error_t **error )
+{
+	libsystem_character_t **libewf_filenames = NULL;
+	static char *function                    = "bench_handle_open_input";
+	size_t filename_length                   = 0;
+	int amount_of_filenames                  = 0;
+	int result                               = 1;
+
+	if( bench_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_V2_API )
+	if( bench_handle->handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid benchmark handle - missing handle.",
+		 function );
+
+		return( -1 );
+	}
+#else
+	if( bench_handle->handle != NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid benchmark handle - handle already set.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( filename == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = libsystem_string_length(
+	                   filename );
+
+#if defined( LIBSYSTEM_HAVE_WIDE_CHARACTER )
+#if defined( HAVE_V2_API )
+	if( libewf_glob_wide(
+	     filename,
+	     filename_length,
+	     LIBEWF_FORMAT_UNKNOWN,
+	     &libewf_filenames,
+	     &amount_of_filenames,
+	     error ) != 1 )
+#else
+	amount_of_filenames = libewf_glob_wide(
+	                       filename,
+	                       filename_length,
+	                       LIBEWF_FORMAT_UNKNOWN,
+	                       &libewf_filenames );
+
+	if( amount_of_filenames <= 0 )
+#endif
+#else
+#if defined( HAVE_V2_API )
+	if( libewf_glob(
+	     filename,
+	     filename_length,
+	     LIBEWF_FORMAT_UNKNOWN,
+	     &libewf_filenames,
+	     &amount_of_filenames,
+	     error ) != 1 )
+#else
+	amount_of_filenames = libewf_glob(
+	                       filename,
+	                       filename_length,
+	                       LIBEWF_FORMAT_UNKNOWN,
+	                       &libewf_filenames );
+
+	if( amount_of_filenames <= 0 )
+#endif
+#endif
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to resolve filename(s).",
+		 function );
+
+		return( -1 );
+	}
+#if defined( LIBSYSTEM_HAVE_WIDE_CHARACTER )
+#if defined( HAVE_V2_API )
+	if( libewf_handle_open_wide(
+	     bench_handle->handle,
+	     libewf_filenames,
+	     amount_of_filenames,
+	     LIBEWF_OPEN_READ,
+	     error ) != 1 )
+#else
+	bench_handle->handle = libewf_open_wide(
+	                        libewf_filenames,
+	                        amount_of_filenames,
+	                        LIBEWF_OPEN_READ );
+
+	if( bench_handle->handle == NULL )
+#endif
+#else
+#if defined( HAVE_V2_API )
+	if( libewf_handle_open(
+	     bench_handle->handle,
+	     libewf_filenames,
+	     amount_of_filenames,
+	     LIBEWF_OPEN_READ,
+	     error ) != 1 )
+#else
+	bench_handle->handle = libewf_open(
+	                        libewf_filenames,
+	                        amount_of_filenames,
+	                        LIBEWF_OPEN_READ );
+
+	if( bench_handle->handle == NULL )
+#endif
+#endif
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_IO,
+		 LIBERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open files.",
+		 function );
+
+		result = -1;
+	}
+	for( ; amount_of_filenames > 0; amount_of_filenames-- )
+	{
+		memory_free(
+		 libewf_filenames[ amount_of_filenames - 1 ] );
+	}
+	memory_free(
+	 libewf_filenames );
+
+	if( ( result == 1 )
+	 && ( bench_handle->maximum_number_of_threads > 1 ) )
+	{
+#if defined( HAVE_V2_API )
+		if( libewf_handle_set_maximum_number_of_threads(
+		     bench_handle->handle,
+		     bench_handle->maximum_number_of_threads,
+		     error ) != 1 )
+#else
+		if( libewf_set_maximum_number_of_threads(
+		     bench_handle->handle,
+		     bench_handle->maximum_number_of_threads ) != 1 )
+#endif
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set maximum number of threads.",
+			 function );
+
+			bench_handle_close(
+			 bench_handle,
+			 NULL );
+
+			return( -1 );
+		}
+	}
+	return( result );
+}
+
+/* Closes the benchmark handle
+ * Returns the 0 if succesful or -1 on error
+ */
+int bench_handle_close(
+     bench_handle_t *bench_handle,
+     liberror_error_t **error )
+{
+	static char *function = "bench_handle_close";
+
+	if( bench_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( bench_handle->handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid benchmark handle - missing handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_V2_API )
+	if( libewf_handle_close(
+	     bench_handle->handle,
+	     error ) != 0 )
+#else
+	if( libewf_close(
+	     bench_handle->handle ) != 0 )
+#endif
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_IO,
+		 LIBERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close handle.",
+		 function );
+
+#if !defined( HAVE_V2_API )
+		bench_handle->handle = NULL;
+#endif
+		return( -1 );
+	}
+#if !defined( HAVE_V2_API )
+	bench_handle->handle = NULL;
+#endif
+	return( 0 );
+}
+
+/* Writes the synthesized data as the media data of an image
+ * The elapsed time includes finalizing and closing the image
+ * Returns 1 if successful, 0 if aborted or -1 on error
+ */
+int bench_handle_write(
+     bench_handle_t *bench_handle,
+     const libsystem_character_t *filename,
+     size64_t media_size,
+     int8_t compression_level,
+     uint8_t compression_flags,
+     uint64_t *elapsed_time,
+     liberror_error_t **error )
+{
+	static char *function    = "bench_handle_write";
+	size64_t write_offset    = 0;
+	uint64_t start_timestamp = 0;
+	uint64_t end_timestamp   = 0;
+	size_t write_size        = 0;
+	ssize_t write_count      = 0;
+
+	if( bench_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( bench_handle->data == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid benchmark handle - missing data.",
+		 function );
+
+		return( -1 );
+	}
+	if( elapsed_time == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid elapsed time.",
+		 function );
+
+		return( -1 );
+	}
+	if( bench_handle_open_output(
+	     bench_handle,
+	     filename,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_IO,
+		 LIBERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open output.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_V2_API )
+	if( libewf_handle_set_media_size(
+	     bench_handle->handle,
+	     media_size,
+	     error ) != 1 )
+#else
+	if( libewf_set_media_size(
+	     bench_handle->handle,
+	     media_size ) != 1 )
+#endif
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set media size.",
+		 function );
+
+		bench_handle_close(
+		 bench_handle,
+		 NULL );
+
+		return( -1 );
+	}
+#if defined( HAVE_V2_API )
+	if( libewf_handle_set_format(
+	     bench_handle->handle,
+	     LIBEWF_FORMAT_ENCASE6,
+	     error ) != 1 )
+#else
+	if( libewf_set_format(
+	     bench_handle->handle,
+	     LIBEWF_FORMAT_ENCASE6 ) != 1 )
+#endif
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set format.",
+		 function );
+
+		bench_handle_close(
+		 bench_handle,
+		 NULL );
+
+		return( -1 );
+	}
+#if defined( HAVE_V2_API )
+	if( libewf_handle_set_compression_values(
+	     bench_handle->handle,
+	     compression_level,
+	     compression_flags,
+	     error ) != 1 )
+#else
+	if( libewf_set_compression_values(
+	     bench_handle->handle,
+	     compression_level,
+	     compression_flags ) != 1 )
+#endif
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set compression values.",
+		 function );
+
+		bench_handle_close(
+		 bench_handle,
+		 NULL );
+
+		return( -1 );
+	}
+	if( bench_handle_get_timestamp(
+	     &start_timestamp,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve start timestamp.",
+		 function );
+
+		bench_handle_close(
+		 bench_handle,
+		 NULL );
+
+		return( -1 );
+	}
+	while( write_offset < media_size )
+	{
+		if( bench_handle->abort != 0 )
+		{
+			break;
+		}
+		write_size = bench_handle->process_buffer_size;
+
+		if( (size64_t) write_size > ( media_size - write_offset ) )
+		{
+			write_size = (size_t) ( media_size - write_offset );
+		}
+#if defined( HAVE_V2_API )
+		write_count = libewf_handle_write_buffer(
+		               bench_handle->handle,
+		               &( bench_handle->data[ write_offset % bench_handle->data_size ] ),
+		               write_size,
+		               error );
+#else
+		write_count = libewf_write_buffer(
+		               bench_handle->handle,
+		               &( bench_handle->data[ write_offset % bench_handle->data_size ] ),
+		               write_size );
+#endif
+
+		if( write_count != (ssize_t) write_size )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write data at offset: %" PRIu64 ".",
+			 function,
+			 write_offset );
+
+			bench_handle_close(
+			 bench_handle,
+			 NULL );
+
+			return( -1 );
+		}
+		write_offset += (size64_t) write_count;
+	}
+#if defined( HAVE_V2_API )
+	write_count = libewf_handle_write_finalize(
+	               bench_handle->handle,
+	               error );
+#else
+	write_count = libewf_write_finalize(
+	               bench_handle->handle );
+#endif
+
+	if( write_count == -1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_IO,
+		 LIBERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to finalize write.",
+		 function );
+
+		bench_handle_close(
+		 bench_handle,
+		 NULL );
+
+		return( -1 );
+	}
+	if( bench_handle_close(
+	     bench_handle,
+	     error ) != 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_IO,
+		 LIBERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close output.",
+		 function );
+
+		return( -1 );
+	}
+	if( bench_handle_get_timestamp(
+	     &end_timestamp,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve end timestamp.",
+		 function );
+
+		return( -1 );
+	}
+	*elapsed_time = end_timestamp - start_timestamp;
+
+	if( bench_handle->abort != 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Reads the media data of an image sequentially
+ * The data read is compared with the synthesized data
+ * Returns 1 if successful, 0 if aborted or -1 on error
+ */
+int bench_handle_read(
+     bench_handle_t *bench_handle,
+     const libsystem_character_t *filename,
+     size64_t *media_size,
+     uint64_t *elapsed_time,
+     liberror_error_t **error )
+{
+	static char *function    = "bench_handle_read";
+	size64_t read_offset     = 0;
+	uint64_t start_timestamp = 0;
+	uint64_t end_timestamp   = 0;
+	size_t read_size         = 0;
+	ssize_t read_count       = 0;
+
+	if( bench_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( bench_handle->data == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid benchmark handle - missing data.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_size == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media size.",
+		 function );
+
+		return( -1 );
+	}
+	if( elapsed_time == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid elapsed time.",
+		 function );
+
+		return( -1 );
+	}
+	if( bench_handle_get_timestamp(
+	     &start_timestamp,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve start timestamp.",
+		 function );
+
+		return( -1 );
+	}
+	if( bench_handle_open_input(
+	     bench_handle,
+	     filename,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_IO,
+		 LIBERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open input.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_V2_API )
+	if( libewf_handle_get_media_size(
+	     bench_handle->handle,
+	     media_size,
+	     error ) != 1 )
+#else
+	if( libewf_get_media_size(
+	     bench_handle->handle,
+	     media_size ) != 1 )
+#endif
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		bench_handle_close(
+		 bench_handle,
+		 NULL );
+
+		return( -1 );
+	}
+	while( read_offset < *media_size )
+	{
+		if( bench_handle->abort != 0 )
+		{
+			break;
+		}
+		read_size = bench_handle->process_buffer_size;
+
+		if( (size64_t) read_size > ( *media_size - read_offset ) )
+		{
+			read_size = (size_t) ( *media_size - read_offset );
+		}
+#if defined( HAVE_V2_API )
+		read_count = libewf_handle_read_buffer(
+		              bench_handle->handle,
+		              bench_handle->process_buffer,
+		              read_size,
+		              error );
+#else
+		read_count = libewf_read_buffer(
+		              bench_handle->handle,
+		              bench_handle->process_buffer,
+		              read_size );
+#endif
+
+		if( read_count != (ssize_t) read_size )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read data at offset: %" PRIu64 ".",
+			 function,
+			 read_offset );
+
+			bench_handle_close(
+			 bench_handle,
+			 NULL );
+
+			return( -1 );
+		}
+		if( memory_compare(
+		     bench_handle->process_buffer,
+		     &( bench_handle->data[ read_offset % bench_handle->data_size ] ),
+		     read_size ) != 0 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_INPUT,
+			 LIBERROR_INPUT_ERROR_VALUE_MISMATCH,
+			 "%s: mismatch in data read at offset: %" PRIu64 ".",
+			 function,
+			 read_offset );
+
+			bench_handle_close(
+			 bench_handle,
+			 NULL );
+
+			return( -1 );
+		}
+		read_offset += (size64_t) read_count;
+	}
+	if( bench_handle_close(
+	     bench_handle,
+	     error ) != 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_IO,
+		 LIBERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close input.",
+		 function );
+
+		return( -1 );
+	}
+	if( bench_handle_get_timestamp(
+	     &end_timestamp,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve end timestamp.",
+		 function );
+
+		return( -1 );
+	}
+	*elapsed_time = end_timestamp - start_timestamp;
+
+	if( bench_handle->abort != 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Reads the media data of an image at pseudo random offsets
+ * The latency of each read is stored in the latencies, which are sorted afterwards
+ * Returns 1 if successful, 0 if aborted or -1 on error
+ */
+int bench_handle_read_random(
+     bench_handle_t *bench_handle,
+     const libsystem_character_t *filename,
+     size_t read_size,
+     uint64_t *latencies,
+     int amount_of_reads,
+     liberror_error_t **error )
+{
+	static char *function    = "bench_handle_read_random";
+	size64_t media_size      = 0;
+	uint64_t end_timestamp   = 0;
+	uint64_t random_offset   = 0;
+	uint64_t start_timestamp = 0;
+	ssize_t read_count       = 0;
+	int read_iterator        = 0;
+
+	if( bench_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( read_size == 0 )
+	 || ( read_size > bench_handle->process_buffer_size ) )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_OUT_OF_RANGE,
+		 "%s: invalid read size value out of range.",
+		 function );
+
+		return( -1 );
+	}
+	if( latencies == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid latencies.",
+		 function );
+
+		return( -1 );
+	}
+	if( amount_of_reads <= 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid amount of reads value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( bench_handle_open_input(
+	     bench_handle,
+	     filename,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_IO,
+		 LIBERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open input.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_V2_API )
+	if( libewf_handle_get_media_size(
+	     bench_handle->handle,
+	     &media_size,
+	     error ) != 1 )
+#else
+	if( libewf_get_media_size(
+	     bench_handle->handle,
+	     &media_size ) != 1 )
+#endif
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		bench_handle_close(
+		 bench_handle,
+		 NULL );
+
+		return( -1 );
+	}
+	if( (size64_t) read_size > media_size )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_OUT_OF_RANGE,
+		 "%s: invalid read size value exceeds media size.",
+		 function );
+
+		bench_handle_close(
+		 bench_handle,
+		 NULL );
+
+		return( -1 );
+	}
+	/* Every image is read at the same offsets
+	 */
+	bench_handle->random_value = ( bench_handle->seed == 0 ) ? 1 : bench_handle->seed;
+
+	for( read_iterator = 0; read_iterator < amount_of_reads; read_iterator++ )
+	{
+		if( bench_handle->abort != 0 )
+		{
+			break;
+		}
+		random_offset   = (uint64_t) bench_handle_get_random_value(
+		                              bench_handle );
+		random_offset <<= 32;
+		random_offset  |= (uint64_t) bench_handle_get_random_value(
+		                              bench_handle );
+		random_offset  %= media_size - read_size + 1;
+
+		if( bench_handle_get_timestamp(
+		     &start_timestamp,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve start timestamp.",
+			 function );
+
+			bench_handle_close(
+			 bench_handle,
+			 NULL );
+
+			return( -1 );
+		}
+#if defined( HAVE_V2_API )
+		read_count = libewf_handle_read_random(
+		              bench_handle->handle,
+		              bench_handle->process_buffer,
+		              read_size,
+		              (off64_t) random_offset,
+		              error );
+#else
+		read_count = libewf_read_random(
+		              bench_handle->handle,
+		              bench_handle->process_buffer,
+		              read_size,
+		              (off64_t) random_offset );
+#endif
+
+		if( bench_handle_get_timestamp(
+		     &end_timestamp,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve end timestamp.",
+			 function );
+
+			bench_handle_close(
+			 bench_handle,
+			 NULL );
+
+			return( -1 );
+		}
+		if( read_count != (ssize_t) read_size )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read data at offset: %" PRIu64 ".",
+			 function,
+			 random_offset );
+
+			bench_handle_close(
+			 bench_handle,
+			 NULL );
+
+			return( -1 );
+		}
+		latencies[ read_iterator ] = end_timestamp - start_timestamp;
+	}
+	if( bench_handle_close(
+	     bench_handle,
+	     error ) != 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_IO,
+		 LIBERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close input.",
+		 function );
+
+		return( -1 );
+	}
+	if( bench_handle->abort != 0 )
+	{
+		return( 0 );
+	}
+	qsort(
+	 latencies,
+	 (size_t) amount_of_reads,
+	 sizeof( uint64_t ),
+	 &bench_handle_compare_timestamps );
+
+	return( 1 );
+}
+
+/* Measures a kernel on blocks of the process buffer size
+ * The synthesized data is processed block by block, the other data types fill a single block
+ * Returns 1 if successful, 0 if the kernel is not supported by the processor or -1 on error
+ */
+int bench_handle_measure_kernel(
+     bench_handle_t *bench_handle,
+     int kernel,
+     int data_type,
+     size64_t *amount_of_bytes,
+     uint64_t *elapsed_time,
+     liberror_error_t **error )
+{
+	uint8_t *block              = NULL;
+	static char *function       = "bench_handle_measure_kernel";
+	size64_t kernel_size        = 0;
+	size_t block_offset         = 0;
+	size_t data_offset          = 0;
+	uint64_t end_timestamp      = 0;
+	uint64_t start_timestamp    = 0;
+	uint32_t checksum           = 1;
+	uint32_t random_value       = 0;
+	uint32_t saved_random_value = 0;
+	int result                  = 0;
+
+	if( bench_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( bench_handle->data == NULL )
+	 || ( bench_handle->process_buffer == NULL ) )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid benchmark handle - missing data.",
+		 function );
+
+		return( -1 );
+	}
+	if( amount_of_bytes == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid amount of bytes.",
+		 function );
+
+		return( -1 );
+	}
+	if( elapsed_time == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid elapsed time.",
+		 function );
+
+		return( -1 );
+	}
+	block = bench_handle->process_buffer;
+
+	switch( data_type )
+	{
+		case BENCH_HANDLE_KERNEL_DATA_TYPE_RANDOM:
+			/* The pseudo random generator is restored afterwards
+			 * so that the random reads do not depend on the kernels measured
+			 */
+			saved_random_value = bench_handle->random_value;
+
+			for( block_offset = 0; block_offset < bench_handle->process_buffer_size; block_offset++ )
+			{
+				if( ( block_offset % 4 ) == 0 )
+				{
+					random_value = bench_handle_get_random_value(
+					                bench_handle );
+				}
+				block[ block_offset ] = (uint8_t) ( random_value & 0xff );
+
+				random_value >>= 8;
+			}
+			bench_handle->random_value = saved_random_value;
+
+			break;
+
+		case BENCH_HANDLE_KERNEL_DATA_TYPE_SYNTHESIZED:
+			break;
+
+		case BENCH_HANDLE_KERNEL_DATA_TYPE_UNIFORM:
+			if( memory_set(
+			     block,
+			     0xff,
+			     bench_handle->process_buffer_size ) == NULL )
+			{
+				liberror_error_set(
+				 error,
+				 LIBERROR_ERROR_DOMAIN_MEMORY,
+				 LIBERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to set block.",
+				 function );
+
+				return( -1 );
+			}
+			break;
+
+		case BENCH_HANDLE_KERNEL_DATA_TYPE_ZERO:
+			if( memory_set(
+			     block,
+			     0,
+			     bench_handle->process_buffer_size ) == NULL )
+			{
+				liberror_error_set(
+				 error,
+				 LIBERROR_ERROR_DOMAIN_MEMORY,
+				 LIBERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to clear block.",
+				 function );
+
+				return( -1 );
+			}
+			break;
+
+		default:
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported data type.",
+			 function );
+
+			return( -1 );
+	}
+	/* The kernel is run once before the measurement
+	 * to determine if it is supported by the processor
+	 */
+#if defined( HAVE_V2_API )
+	result = libewf_run_kernel(
+	          kernel,
+	          block,
+	          bench_handle->process_buffer_size,
+	          &checksum,
+	          error );
+#else
+	result = libewf_run_kernel(
+	          kernel,
+	          block,
+	          bench_handle->process_buffer_size,
+	          &checksum );
+#endif
+	if( result == -1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to run kernel.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	checksum = 1;
+
+	if( bench_handle_get_timestamp(
+	     &start_timestamp,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve start timestamp.",
+		 function );
+
+		return( -1 );
+	}
+	while( kernel_size < (size64_t) BENCH_HANDLE_KERNEL_SIZE )
+	{
+		if( bench_handle->abort != 0 )
+		{
+			return( 0 );
+		}
+		if( data_type == BENCH_HANDLE_KERNEL_DATA_TYPE_SYNTHESIZED )
+		{
+			if( ( data_offset + bench_handle->process_buffer_size ) > bench_handle->data_size )
+			{
+				data_offset = 0;
+			}
+			block        = &( bench_handle->data[ data_offset ] );
+			data_offset += bench_handle->process_buffer_size;
+		}
+#if defined( HAVE_V2_API )
+		result = libewf_run_kernel(
+		          kernel,
+		          block,
+		          bench_handle->process_buffer_size,
+		          &checksum,
+		          error );
+#else
+		result = libewf_run_kernel(
+		          kernel,
+		          block,
+		          bench_handle->process_buffer_size,
+		          &checksum );
+#endif
+		if( result != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to run kernel.",
+			 function );
+
+			return( -1 );
+		}
+		kernel_size += bench_handle->process_buffer_size;
+	}
+	if( bench_handle_get_timestamp(
+	     &end_timestamp,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve end timestamp.",
+		 function );
+
+		return( -1 );
+	}
+	/* The checksum, or the amount of empty blocks, is kept
+	 * so that the kernel calls cannot be optimized away
+	 */
+	bench_handle->kernel_checksum = checksum;
+
+	*amount_of_bytes = kernel_size;
+	*elapsed_time    = end_timestamp - start_timestamp;
+
+	return( 1 );
+}
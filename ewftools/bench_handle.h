@@ -0,0 +1,209 @@
+/*
+ * Benchmark handle
+ *
+ * Copyright (C) 2007-2009, Joachim Metz <forensics@hoffmannbv.nl>,
+ * Hoffmann Investigations.
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _BENCH_HANDLE_H )
+#define _BENCH_HANDLE_H
+
+#include <common.h>
+#include <types.h>
+
+#include <liberror.h>
+
+/* If libtool DLL support is enabled set LIBEWF_DLL_IMPORT
+ * before including libewf.h
+ */
+#if defined( _WIN32 ) && defined( DLL_EXPORT )
+#define LIBEWF_DLL_IMPORT
+#endif
+
+#include <libewf.h>
+
+#include <libsystem.h>
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The size of the blocks of the synthesized data
+ * the entropy and sparsity are applied per block
+ */
+#define BENCH_HANDLE_BLOCK_SIZE			( 32 * 1024 )
+
+/* The size of the synthesized data, which is repeated to fill the media
+ */
+#define BENCH_HANDLE_DATA_SIZE			( 16 * 1024 * 1024 )
+
+/* The amount of bytes processed by a kernel measurement
+ */
+#define BENCH_HANDLE_KERNEL_SIZE		( 256 * 1024 * 1024 )
+
+/* The data the kernels are measured on
+ */
+enum BENCH_HANDLE_KERNEL_DATA_TYPES
+{
+	BENCH_HANDLE_KERNEL_DATA_TYPE_RANDOM		= (int) 'r',
+	BENCH_HANDLE_KERNEL_DATA_TYPE_SYNTHESIZED	= (int) 's',
+	BENCH_HANDLE_KERNEL_DATA_TYPE_UNIFORM		= (int) 'u',
+	BENCH_HANDLE_KERNEL_DATA_TYPE_ZERO		= (int) 'z'
+};
+
+typedef struct bench_handle bench_handle_t;
+
+struct bench_handle
+{
+	/* The libewf handle
+	 */
+	libewf_handle_t *handle;
+
+	/* The synthesized data
+	 */
+	uint8_t *data;
+
+	/* The size of the synthesized data
+	 */
+	size_t data_size;
+
+	/* The process buffer
+	 */
+	uint8_t *process_buffer;
+
+	/* The size of the process buffer
+	 */
+	size_t process_buffer_size;
+
+	/* The percentage of each block that contains random data
+	 */
+	uint8_t entropy;
+
+	/* The percentage of blocks that contain only zero bytes
+	 */
+	uint8_t sparsity;
+
+	/* The seed of the pseudo random generator
+	 */
+	uint32_t seed;
+
+	/* The current value of the pseudo random generator
+	 */
+	uint32_t random_value;
+
+	/* The checksum of the last kernel measured
+	 */
+	uint32_t kernel_checksum;
+
+	/* The maximum number of threads used to process the chunks
+	 */
+	int maximum_number_of_threads;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+};
+
+int bench_handle_initialize(
+     bench_handle_t **bench_handle,
+     liberror_error_t **error );
+
+int bench_handle_free(
+     bench_handle_t **bench_handle,
+     liberror_error_t **error );
+
+int bench_handle_signal_abort(
+     bench_handle_t *bench_handle,
+     liberror_error_t **error );
+
+int bench_handle_set_data_values(
+     bench_handle_t *bench_handle,
+     size_t process_buffer_size,
+     uint8_t entropy,
+     uint8_t sparsity,
+     uint32_t seed,
+     liberror_error_t **error );
+
+int bench_handle_set_maximum_number_of_threads(
+     bench_handle_t *bench_handle,
+     int maximum_number_of_threads,
+     liberror_error_t **error );
+
+uint32_t bench_handle_get_random_value(
+          bench_handle_t *bench_handle );
+
+int bench_handle_get_timestamp(
+     uint64_t *timestamp,
+     liberror_error_t **error );
+
+int bench_handle_compare_timestamps(
+     const void *first_timestamp,
+     const void *second_timestamp );
+
+int bench_handle_open_output(
+     bench_handle_t *bench_handle,
+     const libsystem_character_t *filename,
+     liberror_error_t **error );
+
+int bench_handle_open_input(
+     bench_handle_t *bench_handle,
+     const libsystem_character_t *filename,
+     liberror_error_t **error );
+
+int bench_handle_close(
+     bench_handle_t *bench_handle,
+     liberror_error_t **error );
+
+int bench_handle_write(
+     bench_handle_t *bench_handle,
+     const libsystem_character_t *filename,
+     size64_t media_size,
+     int8_t compression_level,
+     uint8_t compression_flags,
+     uint64_t *elapsed_time,
+     liberror_error_t **error );
+
+int bench_handle_read(
+     bench_handle_t *bench_handle,
+     const libsystem_character_t *filename,
+     size64_t *media_size,
+     uint64_t *elapsed_time,
+     liberror_error_t **error );
+
+int bench_handle_read_random(
+     bench_handle_t *bench_handle,
+     const libsystem_character_t *filename,
+     size_t read_size,
+     uint64_t *latencies,
+     int amount_of_reads,
+     liberror_error_t **error );
+
+int bench_handle_measure_kernel(
+     bench_handle_t *bench_handle,
+     int kernel,
+     int data_type,
+     size64_t *amount_of_bytes,
+     uint64_t *elapsed_time,
+     liberror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif
+
@@ -20,6 +20,12 @@
  * along with this software.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+/* Required for O_DIRECT on Linux platforms
+ */
+#if defined( __linux__ ) && !defined( _GNU_SOURCE )
+#define _GNU_SOURCE
+#endif
+
 #include <common.h>
 #include <memory.h>
 #include <types.h>
@@ -44,6 +50,10 @@
 #include <unistd.h>
 #endif
 
+#if defined( HAVE_ERRNO_H ) || defined( WINAPI )
+#include <errno.h>
+#endif
+
 #if defined( WINAPI )
 #include <windows.h>
 
@@ -191,6 +201,11 @@ int device_handle_free(
 	}
 	if( *device_handle != NULL )
 	{
+		if( ( *device_handle )->direct_io_buffer_allocation != NULL )
+		{
+			memory_free(
+			 ( *device_handle )->direct_io_buffer_allocation );
+		}
 		memory_free(
 		 *device_handle );
 
@@ -223,6 +238,8 @@ int device_handle_open_input(
 	DWORD windows_version            = 0;
 #else
 	struct stat file_stat;
+
+	uint32_t bytes_per_sector        = 0;
 #endif
 
 	if( device_handle == NULL )
@@ -424,10 +441,37 @@ int device_handle_open_input(
 		}
 	}
 #else
-	device_handle->file_descriptor = open(
-	                                  filename,
-	                                  O_RDONLY );
+#if defined( O_DIRECT )
+	if( device_handle->use_direct_io != 0 )
+	{
+		device_handle->file_descriptor = open(
+		                                  filename,
+		                                  O_RDONLY | O_DIRECT );
+
+		/* Not every file system supports direct I/O
+		 * in which case the input is read buffered
+		 */
+		if( ( device_handle->file_descriptor == -1 )
+		 && ( errno == EINVAL ) )
+		{
+#if defined( HAVE_VERBOSE_OUTPUT )
+			libsystem_notify_verbose_printf(
+			 "%s: direct I/O not supported falling back to buffered I/O.\n",
+			 function );
+#endif
 
+			device_handle->use_direct_io = 0;
+		}
+	}
+#else
+	device_handle->use_direct_io = 0;
+#endif
+	if( device_handle->use_direct_io == 0 )
+	{
+		device_handle->file_descriptor = open(
+		                                  filename,
+		                                  O_RDONLY );
+	}
 	if( device_handle->file_descriptor == -1 )
 	{
 		liberror_error_set(
@@ -443,12 +487,14 @@ int device_handle_open_input(
 #if defined( HAVE_POSIX_FADVISE )
 	/* Use this function to double the read-ahead system buffer
 	 * This provides for some additional performance
+	 * Direct I/O bypasses the system buffer
 	 */
-	if( posix_fadvise(
-	     device_handle->file_descriptor,
-	     0,
-	     0,
-	     POSIX_FADV_SEQUENTIAL ) != 0 )
+	if( ( device_handle->use_direct_io == 0 )
+	 && ( posix_fadvise(
+	       device_handle->file_descriptor,
+	       0,
+	       0,
+	       POSIX_FADV_SEQUENTIAL ) != 0 ) )
 	{
 		liberror_error_set(
 		 error,
@@ -501,6 +547,28 @@ int device_handle_open_input(
 		device_handle->bytes_per_sector     = 512;
 		device_handle->bytes_per_sector_set = 1;
 	}
+#if defined( WINAPI )
+	device_handle->use_direct_io = 0;
+#else
+	if( device_handle->use_direct_io != 0 )
+	{
+		/* A device requires direct reads to be aligned to its sector size
+		 * the alignment of a file depends on the file system
+		 */
+		device_handle->direct_io_alignment = DEVICE_HANDLE_DIRECT_IO_ALIGNMENT;
+
+		if( ( device_handle->type == DEVICE_HANDLE_TYPE_DEVICE )
+		 && ( device_handle_get_bytes_per_sector(
+		       device_handle,
+		       &bytes_per_sector,
+		       NULL ) == 1 )
+		 && ( bytes_per_sector != 0 )
+		 && ( ( bytes_per_sector & ( bytes_per_sector - 1 ) ) == 0 ) )
+		{
+			device_handle->direct_io_alignment = bytes_per_sector;
+		}
+	}
+#endif
 	return( 1 );
 }
 
@@ -691,6 +759,14 @@ ssize_t device_handle_read_buffer(
 	     (LPDWORD) &read_count,
 	     NULL ) == 0 )
 #else
+	if( device_handle->use_direct_io != 0 )
+	{
+		return( device_handle_read_buffer_direct(
+		         device_handle,
+		         buffer,
+		         read_size,
+		         error ) );
+	}
 	read_count = read(
 	              device_handle->file_descriptor,
 	              buffer,
@@ -713,6 +789,255 @@ ssize_t device_handle_read_buffer(
 	return( read_count );
 }
 
+#if !defined( WINAPI )
+
+/* Reads a buffer from the input of the device handle using direct I/O
+ * A read that is not aligned is done using the direct I/O buffer
+ * Returns the amount of bytes read or -1 on error
+ */
+ssize_t device_handle_read_buffer_direct(
+         device_handle_t *device_handle,
+         uint8_t *buffer,
+         size_t read_size,
+         liberror_error_t **error )
+{
+	static char *function    = "device_handle_read_buffer_direct";
+	off64_t aligned_offset   = 0;
+	off64_t current_offset   = 0;
+	size_t aligned_read_size = 0;
+	size_t buffer_offset     = 0;
+	ssize_t read_count       = 0;
+	int read_errno           = 0;
+
+	if( device_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( device_handle->file_descriptor == -1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid device handle - missing file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( device_handle->direct_io_alignment == 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid device handle - missing direct I/O alignment.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_size > (size_t) ( SSIZE_MAX - ( 2 * device_handle->direct_io_alignment ) ) )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid read size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	current_offset = lseek(
+	                  device_handle->file_descriptor,
+	                  0,
+	                  SEEK_CUR );
+
+	if( current_offset < 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_IO,
+		 LIBERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to determine current offset.",
+		 function );
+
+		return( -1 );
+	}
+	/* The storage media buffers are aligned, so most reads are done
+	 * directly into the buffer
+	 */
+	if( ( ( (intptr_t) buffer % device_handle->direct_io_alignment ) == 0 )
+	 && ( ( current_offset % device_handle->direct_io_alignment ) == 0 )
+	 && ( ( read_size % device_handle->direct_io_alignment ) == 0 ) )
+	{
+		read_count = read(
+		              device_handle->file_descriptor,
+		              buffer,
+		              read_size );
+
+		if( read_count < 0 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer.",
+			 function );
+
+			return( -1 );
+		}
+		return( read_count );
+	}
+	/* Otherwise the aligned block that contains the data is read
+	 * e.g. the remainder at the end of the input or after skipping a read error
+	 */
+	buffer_offset     = (size_t) ( current_offset % device_handle->direct_io_alignment );
+	aligned_offset    = current_offset - (off64_t) buffer_offset;
+	aligned_read_size = buffer_offset + read_size;
+
+	if( ( aligned_read_size % device_handle->direct_io_alignment ) != 0 )
+	{
+		aligned_read_size += device_handle->direct_io_alignment
+		                   - ( aligned_read_size % device_handle->direct_io_alignment );
+	}
+	if( aligned_read_size > device_handle->direct_io_buffer_size )
+	{
+		if( device_handle->direct_io_buffer_allocation != NULL )
+		{
+			memory_free(
+			 device_handle->direct_io_buffer_allocation );
+
+			device_handle->direct_io_buffer      = NULL;
+			device_handle->direct_io_buffer_size = 0;
+		}
+		device_handle->direct_io_buffer_allocation = (uint8_t *) memory_allocate(
+		                                                          sizeof( uint8_t ) * ( aligned_read_size + device_handle->direct_io_alignment ) );
+
+		if( device_handle->direct_io_buffer_allocation == NULL )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_MEMORY,
+			 LIBERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create direct I/O buffer.",
+			 function );
+
+			return( -1 );
+		}
+		device_handle->direct_io_buffer = &( ( device_handle->direct_io_buffer_allocation )[
+		                                   ( device_handle->direct_io_alignment - ( (intptr_t) device_handle->direct_io_buffer_allocation % device_handle->direct_io_alignment ) )
+		                                   % device_handle->direct_io_alignment ] );
+
+		device_handle->direct_io_buffer_size = aligned_read_size;
+	}
+	if( lseek(
+	     device_handle->file_descriptor,
+	     aligned_offset,
+	     SEEK_SET ) != aligned_offset )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_IO,
+		 LIBERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek aligned offset: %" PRIjd ".",
+		 function,
+		 aligned_offset );
+
+		return( -1 );
+	}
+	read_count = read(
+	              device_handle->file_descriptor,
+	              device_handle->direct_io_buffer,
+	              aligned_read_size );
+
+	if( read_count < 0 )
+	{
+		/* Make sure the caller can determine the cause of the read error
+		 */
+		read_errno = errno;
+
+		lseek(
+		 device_handle->file_descriptor,
+		 current_offset,
+		 SEEK_SET );
+
+		errno = read_errno;
+
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_IO,
+		 LIBERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size_t) read_count <= buffer_offset )
+	{
+		read_count = 0;
+	}
+	else
+	{
+		read_count -= (ssize_t) buffer_offset;
+
+		if( read_count > (ssize_t) read_size )
+		{
+			read_count = (ssize_t) read_size;
+		}
+		if( memory_copy(
+		     buffer,
+		     &( ( device_handle->direct_io_buffer )[ buffer_offset ] ),
+		     (size_t) read_count ) == NULL )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_MEMORY,
+			 LIBERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy direct I/O buffer.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	/* Make sure the current offset reflects the amount of bytes read
+	 */
+	if( lseek(
+	     device_handle->file_descriptor,
+	     current_offset + (off64_t) read_count,
+	     SEEK_SET ) == -1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_IO,
+		 LIBERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: %" PRIjd ".",
+		 function,
+		 current_offset + (off64_t) read_count );
+
+		return( -1 );
+	}
+	return( read_count );
+}
+
+#endif
+
 /* Seeks the offset in the input file
  * Returns the new offset if successful or -1 on error
  */
@@ -2218,6 +2543,48 @@ int device_handle_set_read_error_values(
 	return( 1 );
 }
 
+/* Set the direct (unbuffered) I/O value in the device handle
+ * Direct I/O bypasses the system cache, the value must be set before the input is opened
+ * Returns 1 if successful or -1 on error
+ */
+int device_handle_set_direct_io(
+     device_handle_t *device_handle,
+     uint8_t use_direct_io,
+     liberror_error_t **error )
+{
+	static char *function = "device_handle_set_direct_io";
+
+	if( device_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( WINAPI )
+	if( device_handle->file_handle != INVALID_HANDLE_VALUE )
+#else
+	if( device_handle->file_descriptor != -1 )
+#endif
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid device handle - input already opened.",
+		 function );
+
+		return( -1 );
+	}
+	device_handle->use_direct_io = use_direct_io;
+
+	return( 1 );
+}
+
 /* Print the media information to a stream
  * Returns 1 if successful or -1 on error
  */
@@ -52,6 +52,10 @@ enum DEVICE_TYPES
 	DEVICE_TYPE_OPTICAL_DISK	= (int) 'o'
 };
 
+/* The default alignment of direct (unbuffered) I/O
+ */
+#define DEVICE_HANDLE_DIRECT_IO_ALIGNMENT	4096
+
 typedef struct device_handle device_handle_t;
 
 struct device_handle
@@ -130,6 +134,27 @@ struct device_handle
 	 * byte error granularity should be wiped on read error
 	 */
 	uint8_t wipe_block_on_read_error;
+
+	/* Value to indicate if direct (unbuffered) I/O should be used
+	 */
+	uint8_t use_direct_io;
+
+	/* The alignment of the offset, size and buffer of a direct read
+	 */
+	uint32_t direct_io_alignment;
+
+	/* The allocated direct I/O buffer
+	 */
+	uint8_t *direct_io_buffer_allocation;
+
+	/* The direct I/O buffer, aligned within the allocated direct I/O buffer
+	 * used for reads that do not meet the direct I/O alignment
+	 */
+	uint8_t *direct_io_buffer;
+
+	/* The direct I/O buffer size
+	 */
+	size_t direct_io_buffer_size;
 };
 
 int device_handle_initialize(
@@ -155,6 +180,14 @@ ssize_t device_handle_read_buffer(
          size_t read_size,
          liberror_error_t **error );
 
+#if !defined( WINAPI )
+ssize_t device_handle_read_buffer_direct(
+         device_handle_t *device_handle,
+         uint8_t *buffer,
+         size_t read_size,
+         liberror_error_t **error );
+#endif
+
 off64_t device_handle_seek_offset(
          device_handle_t *device_handle,
          off64_t offset,
@@ -202,6 +235,11 @@ int device_handle_set_read_error_values(
      uint8_t wipe_block_on_read_error,
      liberror_error_t **error );
 
+int device_handle_set_direct_io(
+     device_handle_t *device_handle,
+     uint8_t use_direct_io,
+     liberror_error_t **error );
+
 int device_handle_media_information_fprint(
      device_handle_t *device_handle,
      FILE *stream,
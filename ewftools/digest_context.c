@@ -54,7 +54,8 @@ int digest_context_initialize(
 		return( -1 );
 	}
 	if( ( type != DIGEST_CONTEXT_TYPE_MD5 )
-	 && ( type != DIGEST_CONTEXT_TYPE_SHA1 ) )
+	 && ( type != DIGEST_CONTEXT_TYPE_SHA1 )
+	 && ( type != DIGEST_CONTEXT_TYPE_SHA256 ) )
 	{
 		liberror_error_set(
 		 error,
@@ -114,6 +115,27 @@ int digest_context_initialize(
 	{
 		digest_type = CALG_SHA1;
 	}
+#if defined( CALG_SHA_256 )
+	else if( type == DIGEST_CONTEXT_TYPE_SHA256 )
+	{
+		digest_type = CALG_SHA_256;
+	}
+#endif
+	if( digest_type == 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: digest context type not supported by crypt provider.",
+		 function );
+
+		CryptReleaseContext(
+		 digest_context->crypt_provider,
+		 0 );
+
+		return( 0 );
+	}
 	if( CryptCreateHash(
 	     digest_context->crypt_provider,
 	     digest_type,
@@ -146,6 +168,10 @@ int digest_context_initialize(
 	{
 		digest_type = EVP_sha1();
 	}
+	else if( type == DIGEST_CONTEXT_TYPE_SHA256 )
+	{
+		digest_type = EVP_sha256();
+	}
 	if( EVP_DigestInit_ex(
 	     digest_context,
 	     digest_type,
@@ -45,7 +45,8 @@ extern "C" {
 enum DIGEST_CONTEXT_TYPES
 {
 	DIGEST_CONTEXT_TYPE_MD5		= (int) 'm',
-	DIGEST_CONTEXT_TYPE_SHA1	= (int) 's'
+	DIGEST_CONTEXT_TYPE_SHA1	= (int) 's',
+	DIGEST_CONTEXT_TYPE_SHA256	= (int) 'S'
 };
 
 #if defined( WINAPI )
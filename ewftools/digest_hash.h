@@ -36,9 +36,11 @@ extern "C" {
 
 #define DIGEST_HASH_SIZE_MD5	(size_t) ( sizeof( digest_hash_t ) * 16 )
 #define DIGEST_HASH_SIZE_SHA1	(size_t) ( sizeof( digest_hash_t ) * 20 )
+#define DIGEST_HASH_SIZE_SHA256	(size_t) ( sizeof( digest_hash_t ) * 32 )
 
 #define DIGEST_HASH_STRING_SIZE_MD5	33
 #define DIGEST_HASH_STRING_SIZE_SHA1	41
+#define DIGEST_HASH_STRING_SIZE_SHA256	65
 
 typedef uint8_t digest_hash_t;
 
@@ -0,0 +1,566 @@
+/*
+ * Digest thread
+ *
+ * Copyright (c) 2008-2009, Joachim Metz <forensics@hoffmannbv.nl>,
+ * Hoffmann Investigations.
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <thread.h>
+
+#include <liberror.h>
+
+#include <libsystem.h>
+
+#include "digest_context.h"
+#include "digest_thread.h"
+#include "md5.h"
+#include "sha1.h"
+#include "sha256.h"
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Initialize a digest thread and starts the thread
+ * Make sure the value digest thread is pointing to is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int digest_thread_initialize(
+     digest_thread_t **digest_thread,
+     uint8_t type,
+     void *context,
+     liberror_error_t **error )
+{
+	static char *function = "digest_thread_initialize";
+
+	if( digest_thread == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest thread.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( type != DIGEST_CONTEXT_TYPE_MD5 )
+	 && ( type != DIGEST_CONTEXT_TYPE_SHA1 )
+	 && ( type != DIGEST_CONTEXT_TYPE_SHA256 ) )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported digest type.",
+		 function );
+
+		return( -1 );
+	}
+	if( context == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *digest_thread == NULL )
+	{
+		*digest_thread = (digest_thread_t *) memory_allocate(
+		                                      sizeof( digest_thread_t ) );
+
+		if( *digest_thread == NULL )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_MEMORY,
+			 LIBERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create digest thread.",
+			 function );
+
+			return( -1 );
+		}
+		if( memory_set(
+		     *digest_thread,
+		     0,
+		     sizeof( digest_thread_t ) ) == NULL )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_MEMORY,
+			 LIBERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear digest thread.",
+			 function );
+
+			memory_free(
+			 *digest_thread );
+
+			*digest_thread = NULL;
+
+			return( -1 );
+		}
+		( *digest_thread )->type    = type;
+		( *digest_thread )->context = context;
+
+		if( thread_mutex_initialize(
+		     &( ( *digest_thread )->mutex ) ) != 0 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize mutex.",
+			 function );
+
+			memory_free(
+			 *digest_thread );
+
+			*digest_thread = NULL;
+
+			return( -1 );
+		}
+		if( thread_condition_initialize(
+		     &( ( *digest_thread )->pending_condition ) ) != 0 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize pending condition.",
+			 function );
+
+			thread_mutex_free(
+			 &( ( *digest_thread )->mutex ) );
+			memory_free(
+			 *digest_thread );
+
+			*digest_thread = NULL;
+
+			return( -1 );
+		}
+		if( thread_condition_initialize(
+		     &( ( *digest_thread )->processed_condition ) ) != 0 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize processed condition.",
+			 function );
+
+			thread_condition_free(
+			 &( ( *digest_thread )->pending_condition ) );
+			thread_mutex_free(
+			 &( ( *digest_thread )->mutex ) );
+			memory_free(
+			 *digest_thread );
+
+			*digest_thread = NULL;
+
+			return( -1 );
+		}
+		if( thread_create(
+		     &( ( *digest_thread )->thread ),
+		     digest_thread_update_context,
+		     *digest_thread ) != 0 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create thread.",
+			 function );
+
+			thread_condition_free(
+			 &( ( *digest_thread )->processed_condition ) );
+			thread_condition_free(
+			 &( ( *digest_thread )->pending_condition ) );
+			thread_mutex_free(
+			 &( ( *digest_thread )->mutex ) );
+			memory_free(
+			 *digest_thread );
+
+			*digest_thread = NULL;
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Stops the thread and frees the digest thread
+ * The digest context is not freed
+ * Returns 1 if successful or -1 on error
+ */
+int digest_thread_free(
+     digest_thread_t **digest_thread,
+     liberror_error_t **error )
+{
+	static char *function = "digest_thread_free";
+	int result            = 1;
+
+	if( digest_thread == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest thread.",
+		 function );
+
+		return( -1 );
+	}
+	if( *digest_thread != NULL )
+	{
+		if( thread_mutex_grab(
+		     &( ( *digest_thread )->mutex ) ) != 0 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			return( -1 );
+		}
+		( *digest_thread )->stop_thread = 1;
+
+		thread_condition_broadcast(
+		 &( ( *digest_thread )->pending_condition ) );
+
+		if( thread_mutex_release(
+		     &( ( *digest_thread )->mutex ) ) != 0 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			return( -1 );
+		}
+		if( thread_join(
+		     ( *digest_thread )->thread ) != 0 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join thread.",
+			 function );
+
+			result = -1;
+		}
+		if( ( *digest_thread )->error != NULL )
+		{
+			liberror_error_free(
+			 &( ( *digest_thread )->error ) );
+		}
+		thread_condition_free(
+		 &( ( *digest_thread )->processed_condition ) );
+		thread_condition_free(
+		 &( ( *digest_thread )->pending_condition ) );
+		thread_mutex_free(
+		 &( ( *digest_thread )->mutex ) );
+
+		memory_free(
+		 *digest_thread );
+
+		*digest_thread = NULL;
+	}
+	return( result );
+}
+
+/* Updates the digest context with the pending buffers
+ * Runs as the thread of the digest thread
+ */
+void *digest_thread_update_context(
+       void *arguments )
+{
+	digest_thread_t *digest_thread = NULL;
+	liberror_error_t *error        = NULL;
+	int result                     = 0;
+
+	digest_thread = (digest_thread_t *) arguments;
+
+	if( digest_thread == NULL )
+	{
+		return( NULL );
+	}
+	if( thread_mutex_grab(
+	     &( digest_thread->mutex ) ) != 0 )
+	{
+		return( NULL );
+	}
+	while( digest_thread->stop_thread == 0 )
+	{
+		if( digest_thread->update_pending == 0 )
+		{
+			thread_condition_wait(
+			 &( digest_thread->pending_condition ),
+			 &( digest_thread->mutex ) );
+
+			continue;
+		}
+		/* The buffer is not changed while the update is pending
+		 * so the mutex does not need to be held while the digest is calculated
+		 */
+		thread_mutex_release(
+		 &( digest_thread->mutex ) );
+
+		if( digest_thread->type == DIGEST_CONTEXT_TYPE_MD5 )
+		{
+			result = md5_update(
+			          (md5_context_t *) digest_thread->context,
+			          digest_thread->buffer,
+			          digest_thread->size,
+			          &error );
+		}
+		else if( digest_thread->type == DIGEST_CONTEXT_TYPE_SHA1 )
+		{
+			result = sha1_update(
+			          (sha1_context_t *) digest_thread->context,
+			          digest_thread->buffer,
+			          digest_thread->size,
+			          &error );
+		}
+		else if( digest_thread->type == DIGEST_CONTEXT_TYPE_SHA256 )
+		{
+			result = sha256_update(
+			          (sha256_context_t *) digest_thread->context,
+			          digest_thread->buffer,
+			          digest_thread->size,
+			          &error );
+		}
+		if( thread_mutex_grab(
+		     &( digest_thread->mutex ) ) != 0 )
+		{
+			if( error != NULL )
+			{
+				liberror_error_free(
+				 &error );
+			}
+			return( NULL );
+		}
+		if( result == 1 )
+		{
+			digest_thread->result = 1;
+		}
+		else
+		{
+			digest_thread->result = -1;
+		}
+		digest_thread->error          = error;
+		digest_thread->update_pending = 0;
+
+		error = NULL;
+
+		thread_condition_broadcast(
+		 &( digest_thread->processed_condition ) );
+	}
+	thread_mutex_release(
+	 &( digest_thread->mutex ) );
+
+	return( NULL );
+}
+
+/* Starts to update the digest context with the buffer
+ * The buffer must not be changed until digest_thread_wait_for_update returns
+ * Returns 1 if successful or -1 on error
+ */
+int digest_thread_start_update(
+     digest_thread_t *digest_thread,
+     uint8_t *buffer,
+     size_t size,
+     liberror_error_t **error )
+{
+	static char *function = "digest_thread_start_update";
+	int result            = 1;
+
+	if( digest_thread == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest thread.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( thread_mutex_grab(
+	     &( digest_thread->mutex ) ) != 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest_thread->update_pending != 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: update already pending.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		digest_thread->buffer         = buffer;
+		digest_thread->size           = size;
+		digest_thread->result         = 0;
+		digest_thread->update_pending = 1;
+
+		thread_condition_signal(
+		 &( digest_thread->pending_condition ) );
+	}
+	if( thread_mutex_release(
+	     &( digest_thread->mutex ) ) != 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Waits for the pending update of the digest context to finish
+ * Returns 1 if successful or -1 on error
+ */
+int digest_thread_wait_for_update(
+     digest_thread_t *digest_thread,
+     liberror_error_t **error )
+{
+	liberror_error_t *update_error = NULL;
+	static char *function          = "digest_thread_wait_for_update";
+	int result                     = 0;
+
+	if( digest_thread == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest thread.",
+		 function );
+
+		return( -1 );
+	}
+	if( thread_mutex_grab(
+	     &( digest_thread->mutex ) ) != 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( digest_thread->update_pending != 0 )
+	{
+		thread_condition_wait(
+		 &( digest_thread->processed_condition ),
+		 &( digest_thread->mutex ) );
+	}
+	result       = digest_thread->result;
+	update_error = digest_thread->error;
+
+	digest_thread->error = NULL;
+
+	if( thread_mutex_release(
+	     &( digest_thread->mutex ) ) != 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		if( update_error != NULL )
+		{
+			liberror_error_free(
+			 &update_error );
+		}
+		return( -1 );
+	}
+	if( update_error != NULL )
+	{
+		libsystem_notify_print_error_backtrace(
+		 update_error );
+		liberror_error_free(
+		 &update_error );
+	}
+	if( result != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update digest context.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#endif
+
@@ -0,0 +1,124 @@
+/*
+ * Digest thread
+ *
+ * Copyright (c) 2008-2009, Joachim Metz <forensics@hoffmannbv.nl>,
+ * Hoffmann Investigations.
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _DIGEST_THREAD_H )
+#define _DIGEST_THREAD_H
+
+#include <common.h>
+#include <thread.h>
+#include <types.h>
+
+#include <liberror.h>
+
+#include "digest_context.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+typedef struct digest_thread digest_thread_t;
+
+struct digest_thread
+{
+	/* The digest type
+	 */
+	uint8_t type;
+
+	/* The digest context, either a md5_context_t, sha1_context_t
+	 * or sha256_context_t depending on the digest type
+	 */
+	void *context;
+
+	/* The thread
+	 */
+	thread_t thread;
+
+	/* The buffer to update the digest context with
+	 */
+	uint8_t *buffer;
+
+	/* The size of the buffer
+	 */
+	size_t size;
+
+	/* Value to indicate an update is pending
+	 */
+	uint8_t update_pending;
+
+	/* Value to indicate the thread should stop
+	 */
+	uint8_t stop_thread;
+
+	/* The result of the last update
+	 */
+	int result;
+
+	/* The error of the last update
+	 */
+	liberror_error_t *error;
+
+	/* The mutex that protects the update values
+	 */
+	thread_mutex_t mutex;
+
+	/* The condition that signals the thread an update is pending
+	 */
+	thread_condition_t pending_condition;
+
+	/* The condition that signals the update was processed
+	 */
+	thread_condition_t processed_condition;
+};
+
+int digest_thread_initialize(
+     digest_thread_t **digest_thread,
+     uint8_t type,
+     void *context,
+     liberror_error_t **error );
+
+int digest_thread_free(
+     digest_thread_t **digest_thread,
+     liberror_error_t **error );
+
+void *digest_thread_update_context(
+       void *arguments );
+
+int digest_thread_start_update(
+     digest_thread_t *digest_thread,
+     uint8_t *buffer,
+     size_t size,
+     liberror_error_t **error );
+
+int digest_thread_wait_for_update(
+     digest_thread_t *digest_thread,
+     liberror_error_t **error );
+
+#endif
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif
+
@@ -23,6 +23,7 @@
 
 #include <common.h>
 #include <memory.h>
+#include <thread.h>
 #include <types.h>
 
 #include <liberror.h>
@@ -51,10 +52,97 @@
 #include "platform.h"
 #include "process_status.h"
 #include "storage_media_buffer.h"
+#include "storage_media_buffer_queue.h"
 
 #define EWFACQUIRE_2_TIB		0x20000000000ULL
 #define EWFACQUIRE_INPUT_BUFFER_SIZE	64
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* The amount of storage media buffers per thread used by the pipeline
+ */
+#define EWFACQUIRE_BUFFERS_PER_THREAD	4
+
+typedef struct ewfacquire_pipeline ewfacquire_pipeline_t;
+
+/* The acquiry pipeline
+ * The read thread reads the input into the buffers of the free queue and passes them
+ * to the hash thread by the read queue, the hash thread passes the hashed buffers
+ * by the write queue to the calling thread which writes them and returns them to the free queue
+ */
+struct ewfacquire_pipeline
+{
+	/* The imaging handle
+	 */
+	imaging_handle_t *imaging_handle;
+
+	/* The device handle
+	 */
+	device_handle_t *device_handle;
+
+	/* The amount of bytes to acquire
+	 */
+	size64_t acquiry_size;
+
+	/* The offset to start to acquire
+	 */
+	off64_t acquiry_offset;
+
+	/* Value to indicate the byte pairs should be swapped
+	 */
+	uint8_t swap_byte_pairs;
+
+	/* The error granularity in bytes
+	 */
+	uint32_t byte_error_granularity;
+
+	/* The amount of retries when a read error occurs
+	 */
+	uint8_t read_error_retry;
+
+	/* Value to indicate the block should be wiped on read error
+	 */
+	uint8_t wipe_block_on_read_error;
+
+	/* The queue of the buffers that can be read into
+	 */
+	storage_media_buffer_queue_t *free_queue;
+
+	/* The queue of the buffers that were read
+	 */
+	storage_media_buffer_queue_t *read_queue;
+
+	/* The queue of the buffers that were hashed
+	 */
+	storage_media_buffer_queue_t *write_queue;
+
+	/* The read thread
+	 */
+	thread_t read_thread;
+
+	/* The hash thread
+	 */
+	thread_t hash_thread;
+
+	/* The result of the read thread
+	 */
+	int read_result;
+
+	/* The error of the read thread
+	 */
+	liberror_error_t *read_error;
+
+	/* The result of the hash thread
+	 */
+	int hash_result;
+
+	/* The error of the hash thread
+	 */
+	liberror_error_t *hash_error;
+};
+
+#endif
+
 imaging_handle_t *ewfacquire_imaging_handle = NULL;
 int ewfacquire_abort                        = 0;
 
@@ -114,11 +202,12 @@ void usage_fprint(
 	fprintf( stream, "Usage: ewfacquire [ -A codepage ] [ -b amount_of_sectors ] [ -B amount_of_bytes ]\n"
 	                 "                  [ -c compression_type ] [ -C case_number ] [ -d digest_type ]\n"
 	                 "                  [ -D description ] [ -e examiner_name ] [ -E evidence_number ]\n"
-	                 "                  [ -f format ] [ -g amount_of_sectors ] [ -l log_filename ]\n"
-	                 "                  [ -m media_type ] [ -M media_flags ] [ -N notes ] [ -o offset ]\n"
-	                 "                  [ -p process_buffer_size ] [ -P bytes_per_sector ]\n"
+	                 "                  [ -f format ] [ -g amount_of_sectors ] [ -j amount_of_threads ]\n"
+	                 "                  [ -l log_filename ] [ -m media_type ] [ -M media_flags ]\n"
+	                 "                  [ -N notes ] [ -o offset ] [ -p process_buffer_size ]\n"
+	                 "                  [ -P bytes_per_sector ]\n"
 	                 "                  [ -r read_error_retries ] [ -S segment_file_size ]\n"
-	                 "                  [ -t target ] [ -2 secondary_target ] [ -hqRsuvVw ] source\n\n" );
+	                 "                  [ -t target ] [ -2 secondary_target ] [ -hOqRsuvVw ] source\n\n" );
 
 	fprintf( stream, "\tsource: the source file or device\n\n" );
 
@@ -131,7 +220,7 @@ void usage_fprint(
 	fprintf( stream, "\t-c:     specify the compression type, options: none (default), empty-block, fast\n"
 	                 "\t        or best\n" );
 	fprintf( stream, "\t-C:     specify the case number (default is case_number).\n" );
-	fprintf( stream, "\t-d:     calculate additional digest (hash) types besides md5, options: sha1\n" );
+	fprintf( stream, "\t-d:     calculate additional digest (hash) types besides md5, options: sha1, sha256\n" );
 	fprintf( stream, "\t-D:     specify the description (default is description).\n" );
 	fprintf( stream, "\t-e:     specify the examiner name (default is examiner_name).\n" );
 	fprintf( stream, "\t-E:     specify the evidence number (default is evidence_number).\n" );
@@ -141,11 +230,17 @@ void usage_fprint(
 	                 "\t        encase2, encase3, encase4, encase5, encase6 (default), linen5, linen6,\n"
 	                 "\t        ewfx\n" );
 	fprintf( stream, "\t-h:     shows this help\n" );
+	fprintf( stream, "\t-j:     specify the amount of threads used to process the data, options:\n"
+	                 "\t        1 (default) to %d (more than one thread reads, hashes and\n"
+	                 "\t        compresses the data concurrently)\n",
+	 LIBEWF_MAXIMUM_NUMBER_OF_THREADS );
 	fprintf( stream, "\t-l:     logs acquiry errors and the digest (hash) to the log_filename\n" );
 	fprintf( stream, "\t-m:     specify the media type, options: fixed (default), removable, optical, memory\n" );
 	fprintf( stream, "\t-M:     specify the media flags, options: logical, physical (default)\n" );
 	fprintf( stream, "\t-N:     specify the notes (default is notes).\n" );
 	fprintf( stream, "\t-o:     specify the offset to start to acquire (default is 0)\n" );
+	fprintf( stream, "\t-O:     use direct (unbuffered) I/O to read the source, this bypasses\n"
+	                 "\t        the system cache (if supported by the platform)\n" );
 	fprintf( stream, "\t-p:     specify the process buffer size (default is the chunk size)\n" );
 	fprintf( stream, "\t-P:     specify the amount of bytes per sector (default is 512)\n"
 	                 "\t        (use this to override the automatic bytes per sector detection)\n" );
@@ -1174,373 +1269,1166 @@ ssize_t ewfacquire_read_buffer(
 	return( read_count );
 }
 
-/* Reads data from a file descriptor and writes it in EWF format
- * Returns the amount of bytes written or -1 on error
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Reads the input into the free buffers of the pipeline
+ * Runs as the read thread of the pipeline
  */
-ssize64_t ewfacquire_read_input(
-           imaging_handle_t *imaging_handle,
-           device_handle_t *device_handle,
-           size64_t media_size,
-           size64_t acquiry_size,
-           off64_t acquiry_offset,
-           off64_t resume_acquiry_offset,
-           uint32_t bytes_per_sector,
-           uint8_t swap_byte_pairs,
-           uint32_t sector_error_granularity,
-           uint8_t read_error_retry,
-           uint8_t wipe_block_on_read_error,
-           size_t process_buffer_size,
-           libsystem_character_t *calculated_md5_hash_string,
-           size_t calculated_md5_hash_string_size,
-           libsystem_character_t *calculated_sha1_hash_string,
-           size_t calculated_sha1_hash_string_size,
-           process_status_t *process_status,
-           liberror_error_t **error )
+void *ewfacquire_read_input_thread(
+       void *arguments )
 {
+	ewfacquire_pipeline_t *pipeline              = NULL;
 	storage_media_buffer_t *storage_media_buffer = NULL;
-	static char *function                        = "ewfacquire_read_input";
+	static char *function                        = "ewfacquire_read_input_thread";
 	ssize64_t acquiry_count                      = 0;
-	size_t read_size                             = 0;
 	ssize_t read_count                           = 0;
-	ssize_t process_count                        = 0;
-	ssize_t write_count                          = 0;
-	uint32_t byte_error_granularity              = 0;
-	uint32_t chunk_size                          = 0;
-
-	if( imaging_handle == NULL )
-	{
-		liberror_error_set(
-		 error,
-		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid imaging handle.",
-		 function );
+	int result                                   = 0;
 
-		return( -1 );
-	}
-	if( device_handle == NULL )
-	{
-		liberror_error_set(
-		 error,
-		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid device handle.",
-		 function );
+	pipeline = (ewfacquire_pipeline_t *) arguments;
 
-		return( -1 );
-	}
-	if( process_buffer_size > (size_t) SSIZE_MAX )
+	if( pipeline == NULL )
 	{
-		liberror_error_set(
-		 error,
-		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid process buffer size value exceeds maximum.",
-		 function );
-
-		return( -1 );
+		return( NULL );
 	}
-	if( process_status == NULL )
-	{
-		liberror_error_set(
-		 error,
-		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid process status.",
-		 function );
+	pipeline->read_result = 1;
 
-		return( -1 );
-	}
-	if( ( acquiry_size == 0 )
-         || ( acquiry_size > media_size )
-         || ( acquiry_size > (ssize64_t) INT64_MAX ) )
+	while( acquiry_count < (ssize64_t) pipeline->acquiry_size )
 	{
-		liberror_error_set(
-		 error,
-		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBERROR_ARGUMENT_ERROR_VALUE_OUT_OF_RANGE,
-		 "%s: invalid write size value out of range.",
-		 function );
+		if( ewfacquire_abort != 0 )
+		{
+			break;
+		}
+		result = storage_media_buffer_queue_pop(
+		          pipeline->free_queue,
+		          &storage_media_buffer,
+		          &( pipeline->read_error ) );
 
-		return( -1 );
-	}
-	if( acquiry_offset > 0 )
-	{
-		if( ( acquiry_offset > (off64_t) media_size )
-		 || ( ( acquiry_size + acquiry_offset ) > media_size ) )
+		if( result == -1 )
 		{
 			liberror_error_set(
-			 error,
+			 &( pipeline->read_error ),
 			 LIBERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBERROR_RUNTIME_ERROR_VALUE_OUT_OF_RANGE,
-			 "%s: unable to acquire beyond media size.",
+			 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve free storage media buffer.",
 			 function );
 
-			return( -1 );
+			pipeline->read_result = -1;
+
+			break;
 		}
-		if( device_handle_seek_offset(
-		     device_handle,
-		     acquiry_offset,
-		     SEEK_SET,
-		     error ) == -1 )
+		else if( result == 0 )
 		{
-			liberror_error_set(
-			 error,
-			 LIBERROR_ERROR_DOMAIN_IO,
-			 LIBERROR_IO_ERROR_SEEK_FAILED,
-			 "%s: unable to find acquiry offset.",
-			 function );
-
-			return( -1 );
+			break;
 		}
-	}
-	if( resume_acquiry_offset > 0 )
-	{
-		if( ( acquiry_offset + resume_acquiry_offset ) > (off64_t) media_size )
+		read_count = ewfacquire_read_buffer(
+			      pipeline->imaging_handle,
+			      pipeline->device_handle,
+			      storage_media_buffer->raw_buffer,
+			      storage_media_buffer->raw_buffer_size,
+			      pipeline->acquiry_offset + acquiry_count,
+			      pipeline->acquiry_size,
+			      pipeline->read_error_retry,
+			      pipeline->byte_error_granularity,
+			      pipeline->wipe_block_on_read_error,
+			      &( pipeline->read_error ) );
+
+		if( read_count < 0 )
 		{
 			liberror_error_set(
-			 error,
-			 LIBERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBERROR_RUNTIME_ERROR_VALUE_OUT_OF_RANGE,
-			 "%s: unable to resume acquire beyond media size.",
+			 &( pipeline->read_error ),
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_READ_FAILED,
+			 "%s: error reading data from input.",
 			 function );
 
-			return( -1 );
+			pipeline->read_result = -1;
+
+			break;
 		}
-		if( device_handle_seek_offset(
-		     device_handle,
-		     resume_acquiry_offset,
-		     SEEK_CUR,
-		     error ) == -1 )
+		if( read_count == 0 )
 		{
 			liberror_error_set(
-			 error,
+			 &( pipeline->read_error ),
 			 LIBERROR_ERROR_DOMAIN_IO,
-			 LIBERROR_IO_ERROR_SEEK_FAILED,
-			 "%s: unable to find acquiry offset.",
+			 LIBERROR_IO_ERROR_READ_FAILED,
+			 "%s: unexpected end of input.",
 			 function );
 
-			return( -1 );
+			pipeline->read_result = -1;
+
+			break;
 		}
-		if( imaging_handle_seek_offset(
-		     imaging_handle,
-		     0,
-		     error ) == -1 )
+		storage_media_buffer->raw_buffer_amount = read_count;
+
+		result = storage_media_buffer_queue_push(
+		          pipeline->read_queue,
+		          storage_media_buffer,
+		          &( pipeline->read_error ) );
+
+		if( result == -1 )
 		{
 			liberror_error_set(
-			 error,
-			 LIBERROR_ERROR_DOMAIN_IO,
-			 LIBERROR_IO_ERROR_SEEK_FAILED,
-			 "%s: unable to seek imaging offset.",
+			 &( pipeline->read_error ),
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to queue read storage media buffer.",
 			 function );
 
-			return( -1 );
+			pipeline->read_result = -1;
+
+			break;
+		}
+		else if( result == 0 )
+		{
+			break;
 		}
+		acquiry_count += read_count;
 	}
-	byte_error_granularity = sector_error_granularity * bytes_per_sector;
-
-	if( imaging_handle_get_chunk_size(
-	     imaging_handle,
-	     &chunk_size,
-	     error ) != 1 )
+	/* Let the hash thread know no more buffers will be read
+	 */
+	if( storage_media_buffer_queue_finish(
+	     pipeline->read_queue,
+	     &( pipeline->read_error ) ) != 1 )
 	{
 		liberror_error_set(
-		 error,
+		 &( pipeline->read_error ),
 		 LIBERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve chunk size.",
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to finish read queue.",
 		 function );
 
-		return( -1 );
+		pipeline->read_result = -1;
 	}
-	if( chunk_size == 0 )
-	{
-		liberror_error_set(
-		 error,
-		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBERROR_ARGUMENT_ERROR_VALUE_OUT_OF_RANGE,
-		 "%s: invalid chunk size.",
-		 function );
+	return( NULL );
+}
 
-		return( -1 );
-	}
-#if defined( HAVE_LOW_LEVEL_FUNCTIONS )
-	process_buffer_size = (size_t) chunk_size;
-#else
-	if( process_buffer_size == 0 )
+/* Swaps the byte pairs if necessary and updates the integrity hash(es)
+ * of the buffers read by the read thread of the pipeline
+ * Runs as the hash thread of the pipeline
+ */
+void *ewfacquire_hash_input_thread(
+       void *arguments )
+{
+	ewfacquire_pipeline_t *pipeline              = NULL;
+	storage_media_buffer_t *storage_media_buffer = NULL;
+	static char *function                        = "ewfacquire_hash_input_thread";
+	int result                                   = 0;
+
+	pipeline = (ewfacquire_pipeline_t *) arguments;
+
+	if( pipeline == NULL )
 	{
-		process_buffer_size = (size_t) chunk_size;
+		return( NULL );
 	}
-#endif
+	pipeline->hash_result = 1;
 
-	if( storage_media_buffer_initialize(
-	     &storage_media_buffer,
-	     process_buffer_size,
-	     error ) != 1 )
+	while( ewfacquire_abort == 0 )
 	{
-		liberror_error_set(
-		 error,
-		 LIBERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create storage media buffer.",
-		 function );
+		result = storage_media_buffer_queue_pop(
+		          pipeline->read_queue,
+		          &storage_media_buffer,
+		          &( pipeline->hash_error ) );
 
-		return( -1 );
-	}
-	while( acquiry_count < (ssize64_t) acquiry_size )
-	{
-		read_size = process_buffer_size;
+		if( result == -1 )
+		{
+			liberror_error_set(
+			 &( pipeline->hash_error ),
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve read storage media buffer.",
+			 function );
 
-		if( ( (ssize64_t) acquiry_size - acquiry_count ) < (ssize64_t) read_size )
+			pipeline->hash_result = -1;
+
+			break;
+		}
+		else if( result == 0 )
 		{
-			read_size = (size_t) ( (ssize64_t) acquiry_size - acquiry_count );
+			break;
 		}
-		if( acquiry_count >= resume_acquiry_offset )
+		/* Swap byte pairs
+		 * The digest hashes are calcultated after swap
+		 */
+		if( ( pipeline->swap_byte_pairs == 1 )
+		 && ( imaging_handle_swap_byte_pairs(
+		       pipeline->imaging_handle,
+		       storage_media_buffer,
+		       storage_media_buffer->raw_buffer_amount,
+		       &( pipeline->hash_error ) ) != 1 ) )
 		{
-			read_count = ewfacquire_read_buffer(
-				      imaging_handle,
-				      device_handle,
-				      storage_media_buffer->raw_buffer,
-				      storage_media_buffer->raw_buffer_size,
-				      acquiry_offset + acquiry_count,
-				      acquiry_size,
-				      read_error_retry,
-				      byte_error_granularity,
-				      wipe_block_on_read_error,
-				      error );
+			liberror_error_set(
+			 &( pipeline->hash_error ),
+			 LIBERROR_ERROR_DOMAIN_CONVERSION,
+			 LIBERROR_CONVERSION_ERROR_GENERIC,
+			 "%s: unable to swap byte pairs.",
+			 function );
 
-			if( read_count < 0 )
-			{
-				liberror_error_set(
-				 error,
-				 LIBERROR_ERROR_DOMAIN_IO,
-				 LIBERROR_IO_ERROR_READ_FAILED,
-				 "%s: error reading data from input.",
-				 function );
+			pipeline->hash_result = -1;
 
-				storage_media_buffer_free(
-				 &storage_media_buffer,
-				 NULL );
+			break;
+		}
+		if( imaging_handle_update_integrity_hash(
+		     pipeline->imaging_handle,
+		     storage_media_buffer,
+		     storage_media_buffer->raw_buffer_amount,
+		     &( pipeline->hash_error ) ) != 1 )
+		{
+			liberror_error_set(
+			 &( pipeline->hash_error ),
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to update integrity hash(es).",
+			 function );
 
-				return( -1 );
+			pipeline->hash_result = -1;
+
+			break;
+		}
+		result = storage_media_buffer_queue_push(
+		          pipeline->write_queue,
+		          storage_media_buffer,
+		          &( pipeline->hash_error ) );
+
+		if( result == -1 )
+		{
+			liberror_error_set(
+			 &( pipeline->hash_error ),
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to queue hashed storage media buffer.",
+			 function );
+
+			pipeline->hash_result = -1;
+
+			break;
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+	}
+	/* Let the read thread stop if the hash thread stopped early
+	 * and the calling thread know no more buffers will be hashed
+	 */
+	if( storage_media_buffer_queue_finish(
+	     pipeline->read_queue,
+	     &( pipeline->hash_error ) ) != 1 )
+	{
+		liberror_error_set(
+		 &( pipeline->hash_error ),
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to finish read queue.",
+		 function );
+
+		pipeline->hash_result = -1;
+	}
+	if( storage_media_buffer_queue_finish(
+	     pipeline->write_queue,
+	     &( pipeline->hash_error ) ) != 1 )
+	{
+		liberror_error_set(
+		 &( pipeline->hash_error ),
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to finish write queue.",
+		 function );
+
+		pipeline->hash_result = -1;
+	}
+	return( NULL );
+}
+
+/* Reads data from a file descriptor and writes it in EWF format
+ * The input is read and hashed by separate threads while the calling thread
+ * writes the buffers, the chunks are compressed by the threads of the output handle
+ * Returns the amount of bytes written or -1 on error
+ */
+ssize64_t ewfacquire_read_input_concurrent(
+           imaging_handle_t *imaging_handle,
+           device_handle_t *device_handle,
+           size64_t acquiry_size,
+           off64_t acquiry_offset,
+           uint8_t swap_byte_pairs,
+           uint32_t byte_error_granularity,
+           uint8_t read_error_retry,
+           uint8_t wipe_block_on_read_error,
+           size_t process_buffer_size,
+           int maximum_number_of_threads,
+           process_status_t *process_status,
+           liberror_error_t **error )
+{
+	ewfacquire_pipeline_t pipeline;
+
+	storage_media_buffer_t **storage_media_buffers = NULL;
+	storage_media_buffer_t *storage_media_buffer   = NULL;
+	static char *function                          = "ewfacquire_read_input_concurrent";
+	ssize64_t acquiry_count                        = 0;
+	ssize_t process_count                          = 0;
+	ssize_t write_count                            = 0;
+	uint8_t read_thread_created                    = 0;
+	uint8_t hash_thread_created                    = 0;
+	int amount_of_buffers                          = 0;
+	int buffer_index                               = 0;
+	int result                                     = 1;
+
+	if( maximum_number_of_threads <= 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_OUT_OF_RANGE,
+		 "%s: invalid maximum number of threads value out of range.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     &pipeline,
+	     0,
+	     sizeof( ewfacquire_pipeline_t ) ) == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_MEMORY,
+		 LIBERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear pipeline.",
+		 function );
+
+		return( -1 );
+	}
+	pipeline.imaging_handle           = imaging_handle;
+	pipeline.device_handle            = device_handle;
+	pipeline.acquiry_size             = acquiry_size;
+	pipeline.acquiry_offset           = acquiry_offset;
+	pipeline.swap_byte_pairs          = swap_byte_pairs;
+	pipeline.byte_error_granularity   = byte_error_granularity;
+	pipeline.read_error_retry         = read_error_retry;
+	pipeline.wipe_block_on_read_error = wipe_block_on_read_error;
+
+	amount_of_buffers = maximum_number_of_threads * EWFACQUIRE_BUFFERS_PER_THREAD;
+
+	storage_media_buffers = (storage_media_buffer_t **) memory_allocate(
+	                                                     sizeof( storage_media_buffer_t * ) * amount_of_buffers );
+
+	if( storage_media_buffers == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_MEMORY,
+		 LIBERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create storage media buffers.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     storage_media_buffers,
+	     0,
+	     sizeof( storage_media_buffer_t * ) * amount_of_buffers ) == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_MEMORY,
+		 LIBERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear storage media buffers.",
+		 function );
+
+		memory_free(
+		 storage_media_buffers );
+
+		return( -1 );
+	}
+	if( storage_media_buffer_queue_initialize(
+	     &( pipeline.free_queue ),
+	     amount_of_buffers,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create free queue.",
+		 function );
+
+		result = -1;
+	}
+	if( ( result == 1 )
+	 && ( storage_media_buffer_queue_initialize(
+	       &( pipeline.read_queue ),
+	       amount_of_buffers,
+	       error ) != 1 ) )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create read queue.",
+		 function );
+
+		result = -1;
+	}
+	if( ( result == 1 )
+	 && ( storage_media_buffer_queue_initialize(
+	       &( pipeline.write_queue ),
+	       amount_of_buffers,
+	       error ) != 1 ) )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create write queue.",
+		 function );
+
+		result = -1;
+	}
+	if( result == 1 )
+	{
+		for( buffer_index = 0;
+		     buffer_index < amount_of_buffers;
+		     buffer_index++ )
+		{
+			if( storage_media_buffer_initialize(
+			     &( storage_media_buffers[ buffer_index ] ),
+			     process_buffer_size,
+			     error ) != 1 )
+			{
+				liberror_error_set(
+				 error,
+				 LIBERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create storage media buffer: %d.",
+				 function,
+				 buffer_index );
+
+				result = -1;
+
+				break;
 			}
-			if( read_count == 0 )
+			if( storage_media_buffer_queue_push(
+			     pipeline.free_queue,
+			     storage_media_buffers[ buffer_index ],
+			     error ) != 1 )
 			{
 				liberror_error_set(
 				 error,
-				 LIBERROR_ERROR_DOMAIN_IO,
-				 LIBERROR_IO_ERROR_READ_FAILED,
-				 "%s: unexpected end of input.",
-				 function );
+				 LIBERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to queue storage media buffer: %d.",
+				 function,
+				 buffer_index );
 
-				storage_media_buffer_free(
-				 &storage_media_buffer,
-				 NULL );
+				result = -1;
 
-				return( -1 );
+				break;
 			}
+		}
+	}
+	if( result == 1 )
+	{
+		if( thread_create(
+		     &( pipeline.read_thread ),
+		     ewfacquire_read_input_thread,
+		     &pipeline ) != 0 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create read thread.",
+			 function );
+
+			result = -1;
+		}
+		else
+		{
+			read_thread_created = 1;
+		}
+	}
+	if( result == 1 )
+	{
+		if( thread_create(
+		     &( pipeline.hash_thread ),
+		     ewfacquire_hash_input_thread,
+		     &pipeline ) != 0 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create hash thread.",
+			 function );
+
+			result = -1;
+		}
+		else
+		{
+			hash_thread_created = 1;
+		}
+	}
+	/* The buffers are written in the order they were read
+	 */
+	while( result == 1 )
+	{
+		result = storage_media_buffer_queue_pop(
+		          pipeline.write_queue,
+		          &storage_media_buffer,
+		          error );
+
+		if( result == -1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve hashed storage media buffer.",
+			 function );
+
+			break;
+		}
+		else if( result == 0 )
+		{
+			result = 1;
+
+			break;
+		}
 #if defined( HAVE_LOW_LEVEL_FUNCTIONS )
-			storage_media_buffer->data_in_compression_buffer = 0;
+		storage_media_buffer->data_in_compression_buffer = 0;
 #endif
-			storage_media_buffer->raw_buffer_amount = read_count;
+		process_count = imaging_handle_prepare_write_buffer(
+				 imaging_handle,
+				 storage_media_buffer,
+				 error );
 
-			/* Swap byte pairs
-			 * The digest hashes are calcultated after swap
-			 */
-			if( ( swap_byte_pairs == 1 )
-			 && ( imaging_handle_swap_byte_pairs(
+		if( process_count < 0 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_READ_FAILED,
+			"%s: unable to prepare buffer before write.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+		write_count = imaging_handle_write_buffer(
 			       imaging_handle,
 			       storage_media_buffer,
-			       read_count,
-			       error ) != 1 ) )
-			{
-				liberror_error_set(
-				 error,
-				 LIBERROR_ERROR_DOMAIN_CONVERSION,
-				 LIBERROR_CONVERSION_ERROR_GENERIC,
-				 "%s: unable to swap byte pairs.",
-				 function );
+			       process_count,
+			       error );
 
-				storage_media_buffer_free(
-				 &storage_media_buffer,
-				 NULL );
+		if( write_count < 0 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write data to file.",
+			 function );
 
-				return( -1 );
-			}
+			result = -1;
+
+			break;
 		}
-		else
+		acquiry_count += storage_media_buffer->raw_buffer_amount;
+
+		if( process_status_update(
+		     process_status,
+		     (size64_t) acquiry_count,
+		     acquiry_size,
+		     error ) != 1 )
 		{
-			/* Align with resume acquiry offset if necessary
-			 */
-			if( ( resume_acquiry_offset - (off64_t) acquiry_count ) < (off64_t) read_size )
-			{
-				read_size = (size_t) ( resume_acquiry_offset - acquiry_count );
-			}
-			read_count = imaging_handle_read_buffer(
-				      imaging_handle,
-				      storage_media_buffer,
-				      read_size,
-				      error );
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update process status.",
+			 function );
 
-			if( read_count < 0 )
-			{
-				liberror_error_set(
-				 error,
-				 LIBERROR_ERROR_DOMAIN_IO,
-				 LIBERROR_IO_ERROR_READ_FAILED,
-				"%s: unable to read data.",
-				 function );
+			result = -1;
 
-				storage_media_buffer_free(
-				 &storage_media_buffer,
-				 NULL );
+			break;
+		}
+		if( storage_media_buffer_queue_push(
+		     pipeline.free_queue,
+		     storage_media_buffer,
+		     error ) == -1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to queue free storage media buffer.",
+			 function );
 
-				return( -1 );
-			}
-			if( read_count == 0 )
-			{
-				liberror_error_set(
-				 error,
-				 LIBERROR_ERROR_DOMAIN_IO,
-				 LIBERROR_IO_ERROR_READ_FAILED,
-				 "%s: unexpected end of data.",
-				 function );
+			result = -1;
+
+			break;
+		}
+		if( ewfacquire_abort != 0 )
+		{
+			break;
+		}
+	}
+	/* Make sure the threads stop if the calling thread stopped early
+	 */
+	if( pipeline.free_queue != NULL )
+	{
+		storage_media_buffer_queue_finish(
+		 pipeline.free_queue,
+		 NULL );
+	}
+	if( pipeline.read_queue != NULL )
+	{
+		storage_media_buffer_queue_finish(
+		 pipeline.read_queue,
+		 NULL );
+	}
+	if( pipeline.write_queue != NULL )
+	{
+		storage_media_buffer_queue_finish(
+		 pipeline.write_queue,
+		 NULL );
+	}
+	if( read_thread_created != 0 )
+	{
+		if( thread_join(
+		     pipeline.read_thread ) != 0 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join read thread.",
+			 function );
+
+			result = -1;
+		}
+		else if( pipeline.read_result != 1 )
+		{
+			libsystem_notify_print_error_backtrace(
+			 pipeline.read_error );
+			liberror_error_free(
+			 &( pipeline.read_error ) );
+
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_READ_FAILED,
+			 "%s: error reading data from input.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( hash_thread_created != 0 )
+	{
+		if( thread_join(
+		     pipeline.hash_thread ) != 0 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join hash thread.",
+			 function );
+
+			result = -1;
+		}
+		else if( pipeline.hash_result != 1 )
+		{
+			libsystem_notify_print_error_backtrace(
+			 pipeline.hash_error );
+			liberror_error_free(
+			 &( pipeline.hash_error ) );
+
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to update integrity hash(es).",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( pipeline.write_queue != NULL )
+	{
+		storage_media_buffer_queue_free(
+		 &( pipeline.write_queue ),
+		 NULL );
+	}
+	if( pipeline.read_queue != NULL )
+	{
+		storage_media_buffer_queue_free(
+		 &( pipeline.read_queue ),
+		 NULL );
+	}
+	if( pipeline.free_queue != NULL )
+	{
+		storage_media_buffer_queue_free(
+		 &( pipeline.free_queue ),
+		 NULL );
+	}
+	for( buffer_index = 0;
+	     buffer_index < amount_of_buffers;
+	     buffer_index++ )
+	{
+		if( storage_media_buffers[ buffer_index ] != NULL )
+		{
+			storage_media_buffer_free(
+			 &( storage_media_buffers[ buffer_index ] ),
+			 NULL );
+		}
+	}
+	memory_free(
+	 storage_media_buffers );
+
+	if( result != 1 )
+	{
+		return( -1 );
+	}
+	return( acquiry_count );
+}
+
+#endif
+
+/* Reads data from a file descriptor and writes it in EWF format
+ * Returns the amount of bytes written or -1 on error
+ */
+ssize64_t ewfacquire_read_input(
+           imaging_handle_t *imaging_handle,
+           device_handle_t *device_handle,
+           size64_t media_size,
+           size64_t acquiry_size,
+           off64_t acquiry_offset,
+           off64_t resume_acquiry_offset,
+           uint32_t bytes_per_sector,
+           uint8_t swap_byte_pairs,
+           uint32_t sector_error_granularity,
+           uint8_t read_error_retry,
+           uint8_t wipe_block_on_read_error,
+           size_t process_buffer_size,
+           int maximum_number_of_threads,
+           libsystem_character_t *calculated_md5_hash_string,
+           size_t calculated_md5_hash_string_size,
+           libsystem_character_t *calculated_sha1_hash_string,
+           size_t calculated_sha1_hash_string_size,
+           libsystem_character_t *calculated_sha256_hash_string,
+           size_t calculated_sha256_hash_string_size,
+           process_status_t *process_status,
+           liberror_error_t **error )
+{
+	storage_media_buffer_t *storage_media_buffer = NULL;
+	static char *function                        = "ewfacquire_read_input";
+	ssize64_t acquiry_count                      = 0;
+	size_t read_size                             = 0;
+	ssize_t read_count                           = 0;
+	ssize_t process_count                        = 0;
+	ssize_t write_count                          = 0;
+	uint32_t byte_error_granularity              = 0;
+	uint32_t chunk_size                          = 0;
+
+	if( imaging_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( device_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( process_buffer_size > (size_t) SSIZE_MAX )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid process buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( process_status == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid process status.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( acquiry_size == 0 )
+         || ( acquiry_size > media_size )
+         || ( acquiry_size > (ssize64_t) INT64_MAX ) )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_OUT_OF_RANGE,
+		 "%s: invalid write size value out of range.",
+		 function );
+
+		return( -1 );
+	}
+	if( acquiry_offset > 0 )
+	{
+		if( ( acquiry_offset > (off64_t) media_size )
+		 || ( ( acquiry_size + acquiry_offset ) > media_size ) )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_VALUE_OUT_OF_RANGE,
+			 "%s: unable to acquire beyond media size.",
+			 function );
+
+			return( -1 );
+		}
+		if( device_handle_seek_offset(
+		     device_handle,
+		     acquiry_offset,
+		     SEEK_SET,
+		     error ) == -1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to find acquiry offset.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( resume_acquiry_offset > 0 )
+	{
+		if( ( acquiry_offset + resume_acquiry_offset ) > (off64_t) media_size )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_VALUE_OUT_OF_RANGE,
+			 "%s: unable to resume acquire beyond media size.",
+			 function );
+
+			return( -1 );
+		}
+		if( device_handle_seek_offset(
+		     device_handle,
+		     resume_acquiry_offset,
+		     SEEK_CUR,
+		     error ) == -1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to find acquiry offset.",
+			 function );
+
+			return( -1 );
+		}
+		if( imaging_handle_seek_offset(
+		     imaging_handle,
+		     0,
+		     error ) == -1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek imaging offset.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	byte_error_granularity = sector_error_granularity * bytes_per_sector;
+
+	if( imaging_handle_get_chunk_size(
+	     imaging_handle,
+	     &chunk_size,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_size == 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_OUT_OF_RANGE,
+		 "%s: invalid chunk size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LOW_LEVEL_FUNCTIONS )
+	process_buffer_size = (size_t) chunk_size;
+#else
+	if( process_buffer_size == 0 )
+	{
+		process_buffer_size = (size_t) chunk_size;
+	}
+#endif
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( ( maximum_number_of_threads > 1 )
+	 && ( resume_acquiry_offset == 0 ) )
+	{
+		acquiry_count = ewfacquire_read_input_concurrent(
+		                 imaging_handle,
+		                 device_handle,
+		                 acquiry_size,
+		                 acquiry_offset,
+		                 swap_byte_pairs,
+		                 byte_error_granularity,
+		                 read_error_retry,
+		                 wipe_block_on_read_error,
+		                 process_buffer_size,
+		                 maximum_number_of_threads,
+		                 process_status,
+		                 error );
+
+		if( acquiry_count == -1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to acquire input concurrently.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else
+#endif
+	{
+		if( storage_media_buffer_initialize(
+		     &storage_media_buffer,
+		     process_buffer_size,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create storage media buffer.",
+			 function );
+
+			return( -1 );
+		}
+		while( acquiry_count < (ssize64_t) acquiry_size )
+		{
+			read_size = process_buffer_size;
+
+			if( ( (ssize64_t) acquiry_size - acquiry_count ) < (ssize64_t) read_size )
+			{
+				read_size = (size_t) ( (ssize64_t) acquiry_size - acquiry_count );
+			}
+			if( acquiry_count >= resume_acquiry_offset )
+			{
+				read_count = ewfacquire_read_buffer(
+					      imaging_handle,
+					      device_handle,
+					      storage_media_buffer->raw_buffer,
+					      storage_media_buffer->raw_buffer_size,
+					      acquiry_offset + acquiry_count,
+					      acquiry_size,
+					      read_error_retry,
+					      byte_error_granularity,
+					      wipe_block_on_read_error,
+					      error );
+
+				if( read_count < 0 )
+				{
+					liberror_error_set(
+					 error,
+					 LIBERROR_ERROR_DOMAIN_IO,
+					 LIBERROR_IO_ERROR_READ_FAILED,
+					 "%s: error reading data from input.",
+					 function );
+
+					storage_media_buffer_free(
+					 &storage_media_buffer,
+					 NULL );
+
+					return( -1 );
+				}
+				if( read_count == 0 )
+				{
+					liberror_error_set(
+					 error,
+					 LIBERROR_ERROR_DOMAIN_IO,
+					 LIBERROR_IO_ERROR_READ_FAILED,
+					 "%s: unexpected end of input.",
+					 function );
+
+					storage_media_buffer_free(
+					 &storage_media_buffer,
+					 NULL );
+
+					return( -1 );
+				}
+	#if defined( HAVE_LOW_LEVEL_FUNCTIONS )
+				storage_media_buffer->data_in_compression_buffer = 0;
+	#endif
+				storage_media_buffer->raw_buffer_amount = read_count;
+
+				/* Swap byte pairs
+				 * The digest hashes are calcultated after swap
+				 */
+				if( ( swap_byte_pairs == 1 )
+				 && ( imaging_handle_swap_byte_pairs(
+				       imaging_handle,
+				       storage_media_buffer,
+				       read_count,
+				       error ) != 1 ) )
+				{
+					liberror_error_set(
+					 error,
+					 LIBERROR_ERROR_DOMAIN_CONVERSION,
+					 LIBERROR_CONVERSION_ERROR_GENERIC,
+					 "%s: unable to swap byte pairs.",
+					 function );
+
+					storage_media_buffer_free(
+					 &storage_media_buffer,
+					 NULL );
+
+					return( -1 );
+				}
+			}
+			else
+			{
+				/* Align with resume acquiry offset if necessary
+				 */
+				if( ( resume_acquiry_offset - (off64_t) acquiry_count ) < (off64_t) read_size )
+				{
+					read_size = (size_t) ( resume_acquiry_offset - acquiry_count );
+				}
+				read_count = imaging_handle_read_buffer(
+					      imaging_handle,
+					      storage_media_buffer,
+					      read_size,
+					      error );
+
+				if( read_count < 0 )
+				{
+					liberror_error_set(
+					 error,
+					 LIBERROR_ERROR_DOMAIN_IO,
+					 LIBERROR_IO_ERROR_READ_FAILED,
+					"%s: unable to read data.",
+					 function );
+
+					storage_media_buffer_free(
+					 &storage_media_buffer,
+					 NULL );
+
+					return( -1 );
+				}
+				if( read_count == 0 )
+				{
+					liberror_error_set(
+					 error,
+					 LIBERROR_ERROR_DOMAIN_IO,
+					 LIBERROR_IO_ERROR_READ_FAILED,
+					 "%s: unexpected end of data.",
+					 function );
+
+					storage_media_buffer_free(
+					 &storage_media_buffer,
+					 NULL );
+
+					return( -1 );
+				}
+				process_count = imaging_handle_prepare_read_buffer(
+						 imaging_handle,
+						 storage_media_buffer,
+						 error );
+
+				if( process_count < 0 )
+				{
+					liberror_error_set(
+					 error,
+					 LIBERROR_ERROR_DOMAIN_IO,
+					 LIBERROR_IO_ERROR_READ_FAILED,
+					"%s: unable to prepare buffer after read.",
+					 function );
 
-				storage_media_buffer_free(
-				 &storage_media_buffer,
-				 NULL );
+					storage_media_buffer_free(
+					 &storage_media_buffer,
+					 NULL );
 
-				return( -1 );
-			}
-			process_count = imaging_handle_prepare_read_buffer(
-					 imaging_handle,
-					 storage_media_buffer,
-					 error );
+					return( -1 );
+				}
+				if( process_count > (ssize_t) read_size )
+				{
+					liberror_error_set(
+					 error,
+					 LIBERROR_ERROR_DOMAIN_IO,
+					 LIBERROR_IO_ERROR_READ_FAILED,
+					 "%s: more bytes read than requested.",
+					 function,
+					 process_count, read_size );
 
-			if( process_count < 0 )
-			{
-				liberror_error_set(
-				 error,
-				 LIBERROR_ERROR_DOMAIN_IO,
-				 LIBERROR_IO_ERROR_READ_FAILED,
-				"%s: unable to prepare buffer after read.",
-				 function );
+					storage_media_buffer_free(
+					 &storage_media_buffer,
+					 NULL );
 
-				storage_media_buffer_free(
-				 &storage_media_buffer,
-				 NULL );
+					return( -1 );
+				}
+				read_count = process_count;
 
-				return( -1 );
+	#if defined( HAVE_LOW_LEVEL_FUNCTIONS )
+				/* Set the amount of chunk data in the buffer
+				 */
+				if( storage_media_buffer->data_in_compression_buffer == 1 )
+				{
+					storage_media_buffer->compression_buffer_amount = process_count;
+				}
+	#endif
 			}
-			if( process_count > (ssize_t) read_size )
+			if( imaging_handle_update_integrity_hash(
+			     imaging_handle,
+			     storage_media_buffer,
+			     read_count,
+			     error ) != 1 )
 			{
 				liberror_error_set(
 				 error,
-				 LIBERROR_ERROR_DOMAIN_IO,
-				 LIBERROR_IO_ERROR_READ_FAILED,
-				 "%s: more bytes read than requested.",
-				 function,
-				 process_count, read_size );
+				 LIBERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to update integrity hash(es).",
+				 function );
 
 				storage_media_buffer_free(
 				 &storage_media_buffer,
@@ -1548,71 +2436,63 @@ ssize64_t ewfacquire_read_input(
 
 				return( -1 );
 			}
-			read_count = process_count;
-
-#if defined( HAVE_LOW_LEVEL_FUNCTIONS )
-			/* Set the amount of chunk data in the buffer
-			 */
-			if( storage_media_buffer->data_in_compression_buffer == 1 )
+			if( acquiry_count >= resume_acquiry_offset )
 			{
-				storage_media_buffer->compression_buffer_amount = process_count;
-			}
-#endif
-		}
-		if( imaging_handle_update_integrity_hash(
-		     imaging_handle,
-		     storage_media_buffer,
-		     read_count,
-		     error ) != 1 )
-		{
-			liberror_error_set(
-			 error,
-			 LIBERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBERROR_RUNTIME_ERROR_GENERIC,
-			 "%s: unable to update integrity hash(es).",
-			 function );
+				process_count = imaging_handle_prepare_write_buffer(
+						 imaging_handle,
+						 storage_media_buffer,
+						 error );
 
-			storage_media_buffer_free(
-			 &storage_media_buffer,
-			 NULL );
+				if( process_count < 0 )
+				{
+					liberror_error_set(
+					 error,
+					 LIBERROR_ERROR_DOMAIN_IO,
+					 LIBERROR_IO_ERROR_READ_FAILED,
+					"%s: unable to prepare buffer before write.",
+					 function );
 
-			return( -1 );
-		}
-		if( acquiry_count >= resume_acquiry_offset )
-		{
-			process_count = imaging_handle_prepare_write_buffer(
-					 imaging_handle,
-					 storage_media_buffer,
-					 error );
+					storage_media_buffer_free(
+					 &storage_media_buffer,
+					 NULL );
 
-			if( process_count < 0 )
-			{
-				liberror_error_set(
-				 error,
-				 LIBERROR_ERROR_DOMAIN_IO,
-				 LIBERROR_IO_ERROR_READ_FAILED,
-				"%s: unable to prepare buffer before write.",
-				 function );
+					return( -1 );
+				}
+				write_count = imaging_handle_write_buffer(
+					       imaging_handle,
+					       storage_media_buffer,
+					       process_count,
+					       error );
 
-				storage_media_buffer_free(
-				 &storage_media_buffer,
-				 NULL );
+				if( write_count < 0 )
+				{
+					liberror_error_set(
+					 error,
+					 LIBERROR_ERROR_DOMAIN_IO,
+					 LIBERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write data to file.",
+					 function );
 
-				return( -1 );
+					storage_media_buffer_free(
+					 &storage_media_buffer,
+					 NULL );
+
+					return( -1 );
+				}
 			}
-			write_count = imaging_handle_write_buffer(
-				       imaging_handle,
-				       storage_media_buffer,
-				       process_count,
-				       error );
+			acquiry_count += read_count;
 
-			if( write_count < 0 )
+			if( process_status_update(
+			     process_status,
+			     (size64_t) acquiry_count,
+			     acquiry_size,
+			     error ) != 1 )
 			{
 				liberror_error_set(
 				 error,
-				 LIBERROR_ERROR_DOMAIN_IO,
-				 LIBERROR_IO_ERROR_WRITE_FAILED,
-				 "%s: unable to write data to file.",
+				 LIBERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to update process status.",
 				 function );
 
 				storage_media_buffer_free(
@@ -1621,45 +2501,24 @@ ssize64_t ewfacquire_read_input(
 
 				return( -1 );
 			}
+			if( ewfacquire_abort != 0 )
+			{
+				break;
+			}
 		}
-		acquiry_count += read_count;
-
-		if( process_status_update(
-		     process_status,
-		     (size64_t) acquiry_count,
-		     acquiry_size,
+		if( storage_media_buffer_free(
+		     &storage_media_buffer,
 		     error ) != 1 )
 		{
 			liberror_error_set(
 			 error,
 			 LIBERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to update process status.",
+			 LIBERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free storage media buffer.",
 			 function );
 
-			storage_media_buffer_free(
-			 &storage_media_buffer,
-			 NULL );
-
 			return( -1 );
 		}
-		if( ewfacquire_abort != 0 )
-		{
-			break;
-		}
-	}
-	if( storage_media_buffer_free(
-	     &storage_media_buffer,
-	     error ) != 1 )
-	{
-		liberror_error_set(
-		 error,
-		 LIBERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free storage media buffer.",
-		 function );
-
-		return( -1 );
 	}
 	if( acquiry_count >= resume_acquiry_offset )
 	{
@@ -1669,6 +2528,8 @@ ssize64_t ewfacquire_read_input(
 			       calculated_md5_hash_string_size,
 			       calculated_sha1_hash_string,
 			       calculated_sha1_hash_string_size,
+			       calculated_sha256_hash_string,
+			       calculated_sha256_hash_string_size,
 			       error );
 
 		if( write_count == -1 )
@@ -1746,6 +2607,7 @@ int main( int argc, char * const argv[] )
 	libsystem_character_t *acquiry_software_version         = NULL;
 	libsystem_character_t *calculated_md5_hash_string       = NULL;
 	libsystem_character_t *calculated_sha1_hash_string      = NULL;
+	libsystem_character_t *calculated_sha256_hash_string    = NULL;
 	libsystem_character_t *case_number                      = NULL;
 	libsystem_character_t *description                      = NULL;
 	libsystem_character_t *evidence_number                  = NULL;
@@ -1784,6 +2646,7 @@ int main( int argc, char * const argv[] )
 	uint32_t sectors_per_chunk                              = 0;
 	uint8_t calculate_md5                                   = 1;
 	uint8_t calculate_sha1                                  = 0;
+	uint8_t calculate_sha256                                = 0;
 	uint8_t compression_flags                               = 0;
 	uint8_t ewf_format                                      = LIBEWF_FORMAT_ENCASE6;
 	uint8_t media_flags                                     = LIBEWF_MEDIA_FLAG_PHYSICAL;
@@ -1792,6 +2655,7 @@ int main( int argc, char * const argv[] )
 	uint8_t read_error_retry                                = 2;
 	uint8_t resume_acquiry                                  = 0;
 	uint8_t swap_byte_pairs                                 = 0;
+	uint8_t use_direct_io                                   = 0;
 	uint8_t verbose                                         = 0;
 	uint8_t wipe_block_on_read_error                        = 0;
 	int8_t acquiry_parameters_confirmed                     = 0;
@@ -1813,6 +2677,7 @@ int main( int argc, char * const argv[] )
 	int error_abort                                         = 0;
 	int header_codepage                                     = LIBEWF_CODEPAGE_ASCII;
 	int interactive_mode                                    = 1;
+	int maximum_number_of_threads                           = 1;
 	int result                                              = 0;
 	int status                                              = 0;
 
@@ -1843,7 +2708,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = libsystem_getopt(
 	                   argc,
 	                   argv,
-	                   _LIBSYSTEM_CHARACTER_T_STRING( "A:b:B:c:C:d:D:e:E:f:g:hl:m:M:N:o:p:P:qr:RsS:t:uvVw2:" ) ) ) != (libsystem_integer_t) -1 )
+	                   _LIBSYSTEM_CHARACTER_T_STRING( "A:b:B:c:C:d:D:e:E:f:g:hj:l:m:M:N:o:Op:P:qr:RsS:t:uvVw2:" ) ) ) != (libsystem_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -1964,6 +2829,13 @@ int main( int argc, char * const argv[] )
 				{
 					calculate_sha1 = 1;
 				}
+				else if( libsystem_string_compare(
+				          optarg,
+				          _LIBSYSTEM_CHARACTER_T_STRING( "sha256" ),
+				          6 ) == 0 )
+				{
+					calculate_sha256 = 1;
+				}
 				else
 				{
 					fprintf(
@@ -2039,6 +2911,38 @@ int main( int argc, char * const argv[] )
 
 				return( EXIT_SUCCESS );
 
+			case (libsystem_integer_t) 'j':
+				string_length = libsystem_string_length(
+				                 optarg );
+
+				result = libsystem_string_to_uint64(
+				          optarg,
+				          string_length + 1,
+				          &input_size_variable,
+				          &error );
+
+				if( result != 1 )
+				{
+					libsystem_notify_print_error_backtrace(
+					 error );
+					liberror_error_free(
+					 &error );
+				}
+				if( ( result != 1 )
+				 || ( input_size_variable == 0 )
+				 || ( input_size_variable > (uint64_t) LIBEWF_MAXIMUM_NUMBER_OF_THREADS ) )
+				{
+					input_size_variable = 1;
+
+					fprintf(
+					 stderr,
+					 "Unsupported amount of threads defaulting to: %" PRIu64 ".\n",
+					 input_size_variable );
+				}
+				maximum_number_of_threads = (int) input_size_variable;
+
+				break;
+
 			case (libsystem_integer_t) 'l':
 				log_filename = optarg;
 
@@ -2121,6 +3025,11 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (libsystem_integer_t) 'O':
+				use_direct_io = 1;
+
+				break;
+
 			case (libsystem_integer_t) 'p':
 				string_length = libsystem_string_length(
 				                 optarg );
@@ -2353,6 +3262,26 @@ int main( int argc, char * const argv[] )
 
 		return( EXIT_FAILURE );
 	}
+	if( device_handle_set_direct_io(
+	     device_handle,
+	     use_direct_io,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to set direct I/O.\n" );
+
+		libsystem_notify_print_error_backtrace(
+		 error );
+		liberror_error_free(
+		 &error );
+
+		device_handle_free(
+		 &device_handle,
+		 NULL );
+
+		return( EXIT_FAILURE );
+	}
 	/* Open the input file or device size
 	 */
 	if( device_handle_open_input(
@@ -2820,6 +3749,7 @@ int main( int argc, char * const argv[] )
 	     &ewfacquire_imaging_handle,
 	     calculate_md5,
 	     calculate_sha1,
+	     calculate_sha256,
 	     &error ) != 1 )
 	{
 		fprintf(
@@ -3890,6 +4820,26 @@ int main( int argc, char * const argv[] )
 				error_abort = 1;
 			}
 		}
+		if( ( ewfacquire_abort == 0 )
+		 && ( error_abort == 0 )
+		 && ( maximum_number_of_threads > 1 ) )
+		{
+			if( imaging_handle_set_maximum_number_of_threads(
+			     ewfacquire_imaging_handle,
+			     maximum_number_of_threads,
+			     &error ) != 1 )
+			{
+				fprintf(
+				 stderr,
+				 "Unable to set maximum number of threads.\n" );
+
+				imaging_handle_close(
+				 ewfacquire_imaging_handle,
+				 NULL );
+
+				error_abort = 1;
+			}
+		}
 		if( ( ewfacquire_abort == 0 )
 		 && ( error_abort == 0 ) )
 		{
@@ -4026,6 +4976,42 @@ int main( int argc, char * const argv[] )
 			return( EXIT_FAILURE );
 		}
 	}
+	if( calculate_sha256 == 1 )
+	{
+		calculated_sha256_hash_string = (libsystem_character_t *) memory_allocate(
+		                                                           sizeof( libsystem_character_t ) * DIGEST_HASH_STRING_SIZE_SHA256 );
+
+		if( calculated_sha256_hash_string == NULL )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to create calculated SHA256 hash string.\n" );
+
+			if( calculate_sha1 == 1 )
+			{
+				memory_free(
+				 calculated_sha1_hash_string );
+			}
+			memory_free(
+			 calculated_md5_hash_string );
+
+			imaging_handle_close(
+			 ewfacquire_imaging_handle,
+			 NULL );
+			imaging_handle_free(
+			 &ewfacquire_imaging_handle,
+			 NULL );
+
+			device_handle_close(
+			 device_handle,
+			 NULL );
+			device_handle_free(
+			 &device_handle,
+			 NULL );
+
+			return( EXIT_FAILURE );
+		}
+	}
 	if( ewfacquire_abort == 0 )
 	{
 		if( process_status_initialize(
@@ -4046,6 +5032,11 @@ int main( int argc, char * const argv[] )
 			liberror_error_free(
 			 &error );
 
+			if( calculate_sha256 == 1 )
+			{
+				memory_free(
+				 calculated_sha256_hash_string );
+			}
 			if( calculate_sha1 == 1 )
 			{
 				memory_free(
@@ -4089,6 +5080,11 @@ int main( int argc, char * const argv[] )
 			 &process_status,
 			 NULL );
 
+			if( calculate_sha256 == 1 )
+			{
+				memory_free(
+				 calculated_sha256_hash_string );
+			}
 			if( calculate_sha1 == 1 )
 			{
 				memory_free(
@@ -4130,10 +5126,13 @@ int main( int argc, char * const argv[] )
 		              read_error_retry,
 		              wipe_block_on_read_error,
 		              (size_t) process_buffer_size,
+		              maximum_number_of_threads,
 		              calculated_md5_hash_string,
 		              DIGEST_HASH_STRING_SIZE_MD5,
 		              calculated_sha1_hash_string,
 		              DIGEST_HASH_STRING_SIZE_SHA1,
+		              calculated_sha256_hash_string,
+		              DIGEST_HASH_STRING_SIZE_SHA256,
 		              process_status,
 		              &error );
 
@@ -4170,6 +5169,11 @@ int main( int argc, char * const argv[] )
 		 &process_status,
 		 NULL );
 
+		if( calculate_sha256 == 1 )
+		{
+			memory_free(
+			 calculated_sha256_hash_string );
+		}
 		if( calculate_sha1 == 1 )
 		{
 			memory_free(
@@ -4210,6 +5214,11 @@ int main( int argc, char * const argv[] )
 		 &process_status,
 		 NULL );
 
+		if( calculate_sha256 == 1 )
+		{
+			memory_free(
+			 calculated_sha256_hash_string );
+		}
 		if( calculate_sha1 == 1 )
 		{
 			memory_free(
@@ -4252,6 +5261,11 @@ int main( int argc, char * const argv[] )
 		 &process_status,
 		 NULL );
 
+		if( calculate_sha256 == 1 )
+		{
+			memory_free(
+			 calculated_sha256_hash_string );
+		}
 		if( calculate_sha1 == 1 )
 		{
 			memory_free(
@@ -4284,6 +5298,11 @@ int main( int argc, char * const argv[] )
 		liberror_error_free(
 		 &error );
 
+		if( calculate_sha256 == 1 )
+		{
+			memory_free(
+			 calculated_sha256_hash_string );
+		}
 		if( calculate_sha1 == 1 )
 		{
 			memory_free(
@@ -4367,6 +5386,11 @@ int main( int argc, char * const argv[] )
 			libsystem_file_stream_close(
 			 log_file_stream );
 		}
+		if( calculate_sha256 == 1 )
+		{
+			memory_free(
+			 calculated_sha256_hash_string );
+		}
 		if( calculate_sha1 == 1 )
 		{
 			memory_free(
@@ -4401,6 +5425,11 @@ int main( int argc, char * const argv[] )
 			libsystem_file_stream_close(
 			 log_file_stream );
 		}
+		if( calculate_sha256 == 1 )
+		{
+			memory_free(
+			 calculated_sha256_hash_string );
+		}
 		if( calculate_sha1 == 1 )
 		{
 			memory_free(
@@ -4432,6 +5461,11 @@ int main( int argc, char * const argv[] )
 			libsystem_file_stream_close(
 			 log_file_stream );
 		}
+		if( calculate_sha256 == 1 )
+		{
+			memory_free(
+			 calculated_sha256_hash_string );
+		}
 		if( calculate_sha1 == 1 )
 		{
 			memory_free(
@@ -4478,6 +5512,23 @@ int main( int argc, char * const argv[] )
 		memory_free(
 		 calculated_sha1_hash_string );
 	}
+	if( calculate_sha256 == 1 )
+	{
+		fprintf(
+		 stdout,
+		 "SHA256 hash calculated over data:\t%" PRIs_LIBSYSTEM "\n",
+		 calculated_sha256_hash_string );
+
+		if( log_file_stream != NULL )
+		{
+			fprintf(
+			 log_file_stream,
+			 "SHA256 hash calculated over data:\t%" PRIs_LIBSYSTEM "\n",
+			 calculated_sha256_hash_string );
+		}
+		memory_free(
+		 calculated_sha256_hash_string );
+	}
 	if( log_file_stream != NULL )
 	{
 		if( libsystem_file_stream_close(
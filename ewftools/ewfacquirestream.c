@@ -130,7 +130,7 @@ void usage_fprint(
 	fprintf( stream, "\t-c: specify the compression type, options: none (default), empty-block, fast\n"
 	                 "\t    or best\n" );
 	fprintf( stream, "\t-C: specify the case number (default is case_number).\n" );
-	fprintf( stream, "\t-d: calculate additional digest (hash) types besides md5, options: sha1\n" );
+	fprintf( stream, "\t-d: calculate additional digest (hash) types besides md5, options: sha1, sha256\n" );
 	fprintf( stream, "\t-D: specify the description (default is description).\n" );
 	fprintf( stream, "\t-e: specify the examiner name (default is examiner_name).\n" );
 	fprintf( stream, "\t-E: specify the evidence number (default is evidence_number).\n" );
@@ -874,6 +874,8 @@ ssize64_t ewfacquirestream_read_input(
            size_t calculated_md5_hash_string_size,
            libsystem_character_t *calculated_sha1_hash_string,
            size_t calculated_sha1_hash_string_size,
+           libsystem_character_t *calculated_sha256_hash_string,
+           size_t calculated_sha256_hash_string_size,
            process_status_t *process_status,
            liberror_error_t **error )
 {
@@ -1169,6 +1171,8 @@ ssize64_t ewfacquirestream_read_input(
 	               calculated_md5_hash_string_size,
 	               calculated_sha1_hash_string,
 	               calculated_sha1_hash_string_size,
+	               calculated_sha256_hash_string,
+	               calculated_sha256_hash_string_size,
 	               error );
 
 	if( write_count == -1 )
@@ -1234,62 +1238,64 @@ int main( int argc, char * const argv[] )
 {
 	libsystem_character_t acquiry_operating_system[ 32 ];
 
-	liberror_error_t *error                            = NULL;
-
-	process_status_t *process_status                   = NULL;
-
-	libsystem_character_t *acquiry_software_version    = NULL;
-	libsystem_character_t *calculated_md5_hash_string  = NULL;
-	libsystem_character_t *calculated_sha1_hash_string = NULL;
-	libsystem_character_t *case_number                 = NULL;
-	libsystem_character_t *description                 = NULL;
-	libsystem_character_t *evidence_number             = NULL;
-	libsystem_character_t *examiner_name               = NULL;
-	libsystem_character_t *log_filename                = NULL;
-	libsystem_character_t *notes                       = NULL;
-	libsystem_character_t *option_case_number          = NULL;
-	libsystem_character_t *option_description          = NULL;
-	libsystem_character_t *option_examiner_name        = NULL;
-	libsystem_character_t *option_evidence_number      = NULL;
-	libsystem_character_t *option_notes                = NULL;
-	libsystem_character_t *program                     = _LIBSYSTEM_CHARACTER_T_STRING( "ewfacquirestream" );
-	libsystem_character_t *secondary_target_filename   = NULL;
-	libsystem_character_t *target_filename             = _LIBSYSTEM_CHARACTER_T_STRING( "image" );
-
-	FILE *log_file_stream                              = NULL;
-
-	libsystem_integer_t option                         = 0;
-	size_t case_number_length                          = 0;
-	size_t description_length                          = 0;
-	size_t evidence_number_length                      = 0;
-	size_t examiner_name_length                        = 0;
-	size_t notes_length                                = 0;
-	size_t string_length                               = 0;
-	int64_t write_count                                = 0;
-	uint64_t acquiry_offset                            = 0;
-	uint64_t acquiry_size                              = 0;
-	uint64_t process_buffer_size                       = EWFCOMMON_PROCESS_BUFFER_SIZE;
-	uint64_t segment_file_size                         = EWFCOMMON_DEFAULT_SEGMENT_FILE_SIZE;
-	uint32_t bytes_per_sector                          = 512;
-	uint32_t sectors_per_chunk                         = 64;
-	uint32_t sector_error_granularity                  = 64;
-	int8_t compression_level                           = LIBEWF_COMPRESSION_NONE;
-	uint8_t calculate_md5                              = 1;
-	uint8_t calculate_sha1                             = 0;
-	uint8_t compression_flags                          = 0;
-	uint8_t ewf_format                                 = LIBEWF_FORMAT_ENCASE6;
-	uint8_t media_flags                                = LIBEWF_MEDIA_FLAG_PHYSICAL;
-	uint8_t media_type                                 = LIBEWF_MEDIA_TYPE_FIXED;
-	uint8_t print_status_information                   = 1;
-	uint8_t read_error_retry                           = 2;
-	uint8_t resume_acquiry                             = 0;
-	uint8_t swap_byte_pairs                            = 0;
-	uint8_t verbose                                    = 0;
-	uint8_t wipe_block_on_read_error                   = 0;
-	int error_abort                                    = 0;
-	int header_codepage                                = LIBEWF_CODEPAGE_ASCII;
-	int result                                         = 0;
-	int status                                         = 0;
+	liberror_error_t *error                              = NULL;
+
+	process_status_t *process_status                     = NULL;
+
+	libsystem_character_t *acquiry_software_version      = NULL;
+	libsystem_character_t *calculated_md5_hash_string    = NULL;
+	libsystem_character_t *calculated_sha1_hash_string   = NULL;
+	libsystem_character_t *calculated_sha256_hash_string = NULL;
+	libsystem_character_t *case_number                   = NULL;
+	libsystem_character_t *description                   = NULL;
+	libsystem_character_t *evidence_number               = NULL;
+	libsystem_character_t *examiner_name                 = NULL;
+	libsystem_character_t *log_filename                  = NULL;
+	libsystem_character_t *notes                         = NULL;
+	libsystem_character_t *option_case_number            = NULL;
+	libsystem_character_t *option_description            = NULL;
+	libsystem_character_t *option_examiner_name          = NULL;
+	libsystem_character_t *option_evidence_number        = NULL;
+	libsystem_character_t *option_notes                  = NULL;
+	libsystem_character_t *program                       = _LIBSYSTEM_CHARACTER_T_STRING( "ewfacquirestream" );
+	libsystem_character_t *secondary_target_filename     = NULL;
+	libsystem_character_t *target_filename               = _LIBSYSTEM_CHARACTER_T_STRING( "image" );
+
+	FILE *log_file_stream                                = NULL;
+
+	libsystem_integer_t option                           = 0;
+	size_t case_number_length                            = 0;
+	size_t description_length                            = 0;
+	size_t evidence_number_length                        = 0;
+	size_t examiner_name_length                          = 0;
+	size_t notes_length                                  = 0;
+	size_t string_length                                 = 0;
+	int64_t write_count                                  = 0;
+	uint64_t acquiry_offset                              = 0;
+	uint64_t acquiry_size                                = 0;
+	uint64_t process_buffer_size                         = EWFCOMMON_PROCESS_BUFFER_SIZE;
+	uint64_t segment_file_size                           = EWFCOMMON_DEFAULT_SEGMENT_FILE_SIZE;
+	uint32_t bytes_per_sector                            = 512;
+	uint32_t sectors_per_chunk                           = 64;
+	uint32_t sector_error_granularity                    = 64;
+	int8_t compression_level                             = LIBEWF_COMPRESSION_NONE;
+	uint8_t calculate_md5                                = 1;
+	uint8_t calculate_sha1                               = 0;
+	uint8_t calculate_sha256                             = 0;
+	uint8_t compression_flags                            = 0;
+	uint8_t ewf_format                                   = LIBEWF_FORMAT_ENCASE6;
+	uint8_t media_flags                                  = LIBEWF_MEDIA_FLAG_PHYSICAL;
+	uint8_t media_type                                   = LIBEWF_MEDIA_TYPE_FIXED;
+	uint8_t print_status_information                     = 1;
+	uint8_t read_error_retry                             = 2;
+	uint8_t resume_acquiry                               = 0;
+	uint8_t swap_byte_pairs                              = 0;
+	uint8_t verbose                                      = 0;
+	uint8_t wipe_block_on_read_error                     = 0;
+	int error_abort                                      = 0;
+	int header_codepage                                  = LIBEWF_CODEPAGE_ASCII;
+	int result                                           = 0;
+	int status                                           = 0;
 
 	libsystem_notify_set_stream(
 	 stderr,
@@ -1453,6 +1459,13 @@ int main( int argc, char * const argv[] )
 				{
 					calculate_sha1 = 1;
 				}
+				else if( libsystem_string_compare(
+				          optarg,
+				          _LIBSYSTEM_CHARACTER_T_STRING( "sha256" ),
+				          6 ) == 0 )
+				{
+					calculate_sha256 = 1;
+				}
 				else
 				{
 					fprintf(
@@ -1952,6 +1965,7 @@ int main( int argc, char * const argv[] )
 		     &ewfacquirestream_imaging_handle,
 		     calculate_md5,
 		     calculate_sha1,
+		     calculate_sha256,
 		     &error ) != 1 )
 		{
 			fprintf(
@@ -2138,6 +2152,35 @@ int main( int argc, char * const argv[] )
 			return( EXIT_FAILURE );
 		}
 	}
+	if( calculate_sha256 == 1 )
+	{
+		calculated_sha256_hash_string = (libsystem_character_t *) memory_allocate(
+		                                                           sizeof( libsystem_character_t ) * DIGEST_HASH_STRING_SIZE_SHA256 );
+
+		if( calculated_sha256_hash_string == NULL )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to create calculated SHA256 hash string.\n" );
+
+			if( calculate_sha1 == 1 )
+			{
+				memory_free(
+				 calculated_sha1_hash_string );
+			}
+			memory_free(
+			 calculated_md5_hash_string );
+
+			imaging_handle_close(
+			 ewfacquirestream_imaging_handle,
+			 NULL );
+			imaging_handle_free(
+			 &ewfacquirestream_imaging_handle,
+			 NULL );
+
+			return( EXIT_FAILURE );
+		}
+	}
 	if( ewfacquirestream_abort == 0 )
 	{
 		if( process_status_initialize(
@@ -2158,6 +2201,11 @@ int main( int argc, char * const argv[] )
 			liberror_error_free(
 			 &error );
 
+			if( calculate_sha256 == 1 )
+			{
+				memory_free(
+				 calculated_sha256_hash_string );
+			}
 			if( calculate_sha1 == 1 )
 			{
 				memory_free(
@@ -2194,6 +2242,11 @@ int main( int argc, char * const argv[] )
 			 &process_status,
 			 NULL );
 
+			if( calculate_sha256 == 1 )
+			{
+				memory_free(
+				 calculated_sha256_hash_string );
+			}
 			if( calculate_sha1 == 1 )
 			{
 				memory_free(
@@ -2229,6 +2282,8 @@ int main( int argc, char * const argv[] )
 		               DIGEST_HASH_STRING_SIZE_MD5,
 		               calculated_sha1_hash_string,
 		               DIGEST_HASH_STRING_SIZE_SHA1,
+		               calculated_sha256_hash_string,
+		               DIGEST_HASH_STRING_SIZE_SHA256,
 		               process_status,
 		               &error );
 
@@ -2269,6 +2324,11 @@ int main( int argc, char * const argv[] )
 		 &process_status,
 		 NULL );
 
+		if( calculate_sha256 == 1 )
+		{
+			memory_free(
+			 calculated_sha256_hash_string );
+		}
 		if( calculate_sha1 == 1 )
 		{
 			memory_free(
@@ -2301,6 +2361,11 @@ int main( int argc, char * const argv[] )
 		liberror_error_free(
 		 &error );
 
+		if( calculate_sha256 == 1 )
+		{
+			memory_free(
+			 calculated_sha256_hash_string );
+		}
 		if( calculate_sha1 == 1 )
 		{
 			memory_free(
@@ -2384,6 +2449,11 @@ int main( int argc, char * const argv[] )
 			libsystem_file_stream_close(
 			 log_file_stream );
 		}
+		if( calculate_sha256 == 1 )
+		{
+			memory_free(
+			 calculated_sha256_hash_string );
+		}
 		if( calculate_sha1 == 1 )
 		{
 			memory_free(
@@ -2418,6 +2488,11 @@ int main( int argc, char * const argv[] )
 			libsystem_file_stream_close(
 			 log_file_stream );
 		}
+		if( calculate_sha256 == 1 )
+		{
+			memory_free(
+			 calculated_sha256_hash_string );
+		}
 		if( calculate_sha1 == 1 )
 		{
 			memory_free(
@@ -2449,6 +2524,11 @@ int main( int argc, char * const argv[] )
 			libsystem_file_stream_close(
 			 log_file_stream );
 		}
+		if( calculate_sha256 == 1 )
+		{
+			memory_free(
+			 calculated_sha256_hash_string );
+		}
 		if( calculate_sha1 == 1 )
 		{
 			memory_free(
@@ -2495,6 +2575,23 @@ int main( int argc, char * const argv[] )
 		memory_free(
 		 calculated_sha1_hash_string );
 	}
+	if( calculate_sha256 == 1 )
+	{
+		fprintf(
+		 stdout,
+		 "SHA256 hash calculated over data:\t%" PRIs_LIBSYSTEM "\n",
+		 calculated_sha256_hash_string );
+
+		if( log_file_stream != NULL )
+		{
+			fprintf(
+			 log_file_stream,
+			 "SHA256 hash calculated over data:\t%" PRIs_LIBSYSTEM "\n",
+			 calculated_sha256_hash_string );
+		}
+		memory_free(
+		 calculated_sha256_hash_string );
+	}
 	if( log_file_stream != NULL )
 	{
 		if( libsystem_file_stream_close(
@@ -0,0 +1,1050 @@
+/*
+ * ewfbench
+ * Measures the write and read performance of the EWF format
+ *
+ * Copyright (c) 2006-2009, Joachim Metz <forensics@hoffmannbv.nl>,
+ * Hoffmann Investigations.
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include <liberror.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+/* If libtool DLL support is enabled set LIBEWF_DLL_IMPORT
+ * before including libewf.h
+ */
+#if defined( _WIN32 ) && defined( DLL_EXPORT )
+#define LIBEWF_DLL_IMPORT
+#endif
+
+#include <libewf.h>
+
+#include <libsystem.h>
+
+#include "bench_handle.h"
+#include "byte_size_string.h"
+#include "ewfinput.h"
+#include "ewfoutput.h"
+
+#define EWFBENCH_DEFAULT_MEDIA_SIZE		( 64 * 1024 * 1024 )
+#define EWFBENCH_DEFAULT_PROCESS_BUFFER_SIZE	( 32 * 1024 )
+#define EWFBENCH_DEFAULT_READ_SIZE		4096
+#define EWFBENCH_DEFAULT_AMOUNT_OF_READS	1024
+#define EWFBENCH_MAXIMUM_AMOUNT_OF_READS	( 1024 * 1024 )
+#define EWFBENCH_FILENAME_SIZE			1024
+
+#define EWFBENCH_AMOUNT_OF_KERNELS		12
+
+bench_handle_t *ewfbench_bench_handle = NULL;
+int ewfbench_abort                    = 0;
+
+/* The kernels measured, the data type they are measured on and their name
+ */
+int ewfbench_kernels[ EWFBENCH_AMOUNT_OF_KERNELS ] = {
+	LIBEWF_KERNEL_ADLER32_ZLIB,
+	LIBEWF_KERNEL_ADLER32_SSSE3,
+	LIBEWF_KERNEL_ADLER32_AVX2,
+	LIBEWF_KERNEL_EMPTY_BLOCK_SCALAR,
+	LIBEWF_KERNEL_EMPTY_BLOCK_SSE2,
+	LIBEWF_KERNEL_EMPTY_BLOCK_AVX2,
+	LIBEWF_KERNEL_EMPTY_BLOCK_SCALAR,
+	LIBEWF_KERNEL_EMPTY_BLOCK_SSE2,
+	LIBEWF_KERNEL_EMPTY_BLOCK_AVX2,
+	LIBEWF_KERNEL_EMPTY_BLOCK_SCALAR,
+	LIBEWF_KERNEL_EMPTY_BLOCK_SSE2,
+	LIBEWF_KERNEL_EMPTY_BLOCK_AVX2 };
+
+int ewfbench_kernel_data_types[ EWFBENCH_AMOUNT_OF_KERNELS ] = {
+	BENCH_HANDLE_KERNEL_DATA_TYPE_SYNTHESIZED,
+	BENCH_HANDLE_KERNEL_DATA_TYPE_SYNTHESIZED,
+	BENCH_HANDLE_KERNEL_DATA_TYPE_SYNTHESIZED,
+	BENCH_HANDLE_KERNEL_DATA_TYPE_ZERO,
+	BENCH_HANDLE_KERNEL_DATA_TYPE_ZERO,
+	BENCH_HANDLE_KERNEL_DATA_TYPE_ZERO,
+	BENCH_HANDLE_KERNEL_DATA_TYPE_UNIFORM,
+	BENCH_HANDLE_KERNEL_DATA_TYPE_UNIFORM,
+	BENCH_HANDLE_KERNEL_DATA_TYPE_UNIFORM,
+	BENCH_HANDLE_KERNEL_DATA_TYPE_RANDOM,
+	BENCH_HANDLE_KERNEL_DATA_TYPE_RANDOM,
+	BENCH_HANDLE_KERNEL_DATA_TYPE_RANDOM };
+
+const char *ewfbench_kernel_names[ EWFBENCH_AMOUNT_OF_KERNELS ] = {
+	"adler32_zlib",
+	"adler32_ssse3",
+	"adler32_avx2",
+	"empty_block_scalar_zero",
+	"empty_block_sse2_zero",
+	"empty_block_avx2_zero",
+	"empty_block_scalar_uniform",
+	"empty_block_sse2_uniform",
+	"empty_block_avx2_uniform",
+	"empty_block_scalar_random",
+	"empty_block_sse2_random",
+	"empty_block_avx2_random" };
+
+/* Prints the executable usage information
+ */
+void usage_fprint(
+      FILE *stream )
+{
+	if( stream == NULL )
+	{
+		return;
+	}
+	fprintf( stream, "Use ewfbench to measure the write and read performance of the EWF format\n"
+	                 "(Expert Witness Compression Format) and the throughput of the checksum\n"
+	                 "and empty block kernels on a single thread. The results are written to\n"
+	                 "stdout in JSON.\n\n" );
+
+	fprintf( stream, "Usage: ewfbench [ -B amount_of_bytes ] [ -c compression_type ] [ -e entropy ]\n"
+	                 "                [ -j amount_of_threads ] [ -n amount_of_reads ]\n"
+	                 "                [ -p process_buffer_size ] [ -r read_size ] [ -s sparsity ]\n"
+	                 "                [ -t target ] [ -x seed ] [ -hkvV ]\n\n" );
+
+	fprintf( stream, "\t-B: specify the amount of bytes of the synthesized media (default is 64 MiB)\n" );
+	fprintf( stream, "\t-c: specify the compression type, options: none, empty-block, fast, best\n"
+	                 "\t    (default is all of them)\n" );
+	fprintf( stream, "\t-e: specify the percentage of each block that contains random data\n"
+	                 "\t    (default is 50), the remainder contains repetitive text\n" );
+	fprintf( stream, "\t-h: shows this help\n" );
+	fprintf( stream, "\t-j: specify the amount of threads used to process the data, options:\n"
+	                 "\t    1 (default) to %d\n",
+	 LIBEWF_MAXIMUM_NUMBER_OF_THREADS );
+	fprintf( stream, "\t-k: only measure the kernels, no images are written\n" );
+	fprintf( stream, "\t-n: specify the amount of random reads (default is %d)\n",
+	 EWFBENCH_DEFAULT_AMOUNT_OF_READS );
+	fprintf( stream, "\t-p: specify the process buffer size of the sequential reads and writes\n"
+	                 "\t    (default is 32 KiB)\n" );
+	fprintf( stream, "\t-r: specify the size of the random reads (default is %d)\n",
+	 EWFBENCH_DEFAULT_READ_SIZE );
+	fprintf( stream, "\t-s: specify the percentage of blocks that contain only zero bytes\n"
+	                 "\t    (default is 0)\n" );
+	fprintf( stream, "\t-t: specify the target base filename of the images (default is ewfbench)\n"
+	                 "\t    the compression type is appended, the images are not removed\n" );
+	fprintf( stream, "\t-v: verbose output to stderr\n" );
+	fprintf( stream, "\t-V: print version\n" );
+	fprintf( stream, "\t-x: specify the seed of the synthesized data and the random reads\n"
+	                 "\t    (default is 1)\n" );
+}
+
+/* Signal handler for ewfbench
+ */
+void ewfbench_signal_handler(
+      libsystem_signal_t signal )
+{
+	liberror_error_t *error = NULL;
+	static char *function   = "ewfbench_signal_handler";
+
+	ewfbench_abort = 1;
+
+	if( ( ewfbench_bench_handle != NULL )
+	 && ( bench_handle_signal_abort(
+	       ewfbench_bench_handle,
+	       &error ) != 1 ) )
+	{
+		libsystem_notify_printf(
+		 "%s: unable to signal benchmark handle to abort.\n",
+		 function );
+
+		libsystem_notify_print_error_backtrace(
+		 error );
+		liberror_error_free(
+		 &error );
+
+		return;
+	}
+}
+
+/* Prints the throughput of a run as a JSON member
+ * The member is preceded by a separator and indented by the amount of spaces
+ */
+void ewfbench_throughput_fprint(
+      FILE *stream,
+      int indentation,
+      const char *name,
+      size64_t amount_of_bytes,
+      uint64_t elapsed_time )
+{
+	double bytes_per_second = 0.0;
+
+	if( stream == NULL )
+	{
+		return;
+	}
+	if( elapsed_time > 0 )
+	{
+		bytes_per_second = ( (double) amount_of_bytes * 1000000000.0 ) / (double) elapsed_time;
+	}
+	fprintf(
+	 stream,
+	 ",\n%*s\"%s\": { \"bytes\": %" PRIu64 ", \"nanoseconds\": %" PRIu64 ", \"bytes_per_second\": %.0f }",
+	 indentation,
+	 "",
+	 name,
+	 amount_of_bytes,
+	 elapsed_time,
+	 bytes_per_second );
+}
+
+/* Prints the latencies of the random reads as a JSON member
+ * The member is preceded by a separator, the latencies must be sorted
+ */
+void ewfbench_latencies_fprint(
+      FILE *stream,
+      size_t read_size,
+      uint64_t *latencies,
+      int amount_of_reads )
+{
+	uint64_t total_latency = 0;
+	int read_iterator      = 0;
+
+	if( stream == NULL )
+	{
+		return;
+	}
+	if( ( latencies == NULL )
+	 || ( amount_of_reads <= 0 ) )
+	{
+		return;
+	}
+	for( read_iterator = 0; read_iterator < amount_of_reads; read_iterator++ )
+	{
+		total_latency += latencies[ read_iterator ];
+	}
+	fprintf(
+	 stream,
+	 ",\n      \"random_read\": { \"reads\": %d, \"read_size\": %" PRIzd ", \"latency_nanoseconds\": {"
+	 " \"minimum\": %" PRIu64 ", \"mean\": %" PRIu64 ", \"p50\": %" PRIu64 ", \"p90\": %" PRIu64 ","
+	 " \"p99\": %" PRIu64 ", \"p999\": %" PRIu64 ", \"maximum\": %" PRIu64 " } }",
+	 amount_of_reads,
+	 read_size,
+	 latencies[ 0 ],
+	 total_latency / (uint64_t) amount_of_reads,
+	 latencies[ ( amount_of_reads * 50 ) / 100 ],
+	 latencies[ ( amount_of_reads * 90 ) / 100 ],
+	 latencies[ ( amount_of_reads * 99 ) / 100 ],
+	 latencies[ (int) ( ( (int64_t) amount_of_reads * 999 ) / 1000 ) ],
+	 latencies[ amount_of_reads - 1 ] );
+}
+
+/* The main program
+ */
+#if defined( LIBSYSTEM_HAVE_WIDE_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	libsystem_character_t filename[ EWFBENCH_FILENAME_SIZE ];
+
+	bench_handle_t *bench_handle                = NULL;
+	liberror_error_t *error                     = NULL;
+	libsystem_character_t *compression_type     = NULL;
+	libsystem_character_t *program              = _LIBSYSTEM_CHARACTER_T_STRING( "ewfbench" );
+	libsystem_character_t *target_filename      = _LIBSYSTEM_CHARACTER_T_STRING( "ewfbench" );
+	libsystem_integer_t option                  = 0;
+	uint64_t *latencies                         = NULL;
+	size64_t media_size                         = EWFBENCH_DEFAULT_MEDIA_SIZE;
+	size64_t media_size_read                    = 0;
+	uint64_t elapsed_time                       = 0;
+	uint64_t input_size_variable                = 0;
+	uint64_t process_buffer_size                = EWFBENCH_DEFAULT_PROCESS_BUFFER_SIZE;
+	uint64_t read_size                          = EWFBENCH_DEFAULT_READ_SIZE;
+	size_t string_length                        = 0;
+	uint32_t seed                               = 1;
+	uint8_t compression_flags                   = 0;
+	uint8_t entropy                             = 50;
+	uint8_t kernels_only                        = 0;
+	uint8_t sparsity                            = 0;
+	uint8_t verbose                             = 0;
+	int8_t compression_level                    = 0;
+	int amount_of_reads                         = EWFBENCH_DEFAULT_AMOUNT_OF_READS;
+	int compression_type_iterator               = 0;
+	int kernel_iterator                         = 0;
+	int maximum_number_of_threads               = 1;
+	int print_count                             = 0;
+	int result                                  = 1;
+	int run_result                              = 0;
+
+	libsystem_notify_set_stream(
+	 stderr,
+	 NULL );
+	libsystem_notify_set_verbose(
+	 1 );
+
+	if( libsystem_initialize(
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize system values.\n" );
+
+		libsystem_notify_print_error_backtrace(
+		 error );
+		liberror_error_free(
+		 &error );
+
+		return( EXIT_FAILURE );
+	}
+	/* The version is printed to stderr to keep the output machine-readable
+	 */
+	ewfoutput_version_fprint(
+	 stderr,
+	 program );
+
+	while( ( option = libsystem_getopt(
+	                   argc,
+	                   argv,
+	                   _LIBSYSTEM_CHARACTER_T_STRING( "B:c:e:hj:kn:p:r:s:t:vVx:" ) ) ) != (libsystem_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (libsystem_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_LIBSYSTEM "\n",
+				 argv[ optind ] );
+
+				usage_fprint(
+				 stderr );
+
+				return( EXIT_FAILURE );
+
+			case (libsystem_integer_t) 'B':
+				string_length = libsystem_string_length(
+				                 optarg );
+
+				result = byte_size_string_convert(
+				          optarg,
+				          string_length,
+				          &media_size,
+				          &error );
+
+				if( result != 1 )
+				{
+					libsystem_notify_print_error_backtrace(
+					 error );
+					liberror_error_free(
+					 &error );
+				}
+				if( ( result != 1 )
+				 || ( media_size == 0 ) )
+				{
+					media_size = EWFBENCH_DEFAULT_MEDIA_SIZE;
+
+					fprintf(
+					 stderr,
+					 "Unsupported amount of bytes defaulting to: %" PRIu64 ".\n",
+					 media_size );
+				}
+				break;
+
+			case (libsystem_integer_t) 'c':
+				if( ewfinput_determine_compression_level(
+				     optarg,
+				     &compression_level,
+				     &compression_flags,
+				     &error ) != 1 )
+				{
+					libsystem_notify_print_error_backtrace(
+					 error );
+					liberror_error_free(
+					 &error );
+
+					fprintf(
+					 stderr,
+					 "Unsupported compression type: %" PRIs_LIBSYSTEM ".\n",
+					 optarg );
+
+					usage_fprint(
+					 stderr );
+
+					return( EXIT_FAILURE );
+				}
+				compression_type = optarg;
+
+				break;
+
+			case (libsystem_integer_t) 'e':
+				string_length = libsystem_string_length(
+				                 optarg );
+
+				result = libsystem_string_to_uint64(
+				          optarg,
+				          string_length + 1,
+				          &input_size_variable,
+				          &error );
+
+				if( result != 1 )
+				{
+					libsystem_notify_print_error_backtrace(
+					 error );
+					liberror_error_free(
+					 &error );
+				}
+				if( ( result != 1 )
+				 || ( input_size_variable > 100 ) )
+				{
+					input_size_variable = 50;
+
+					fprintf(
+					 stderr,
+					 "Unsupported entropy defaulting to: %" PRIu64 ".\n",
+					 input_size_variable );
+				}
+				entropy = (uint8_t) input_size_variable;
+
+				break;
+
+			case (libsystem_integer_t) 'h':
+				usage_fprint(
+				 stderr );
+
+				return( EXIT_SUCCESS );
+
+			case (libsystem_integer_t) 'j':
+				string_length = libsystem_string_length(
+				                 optarg );
+
+				result = libsystem_string_to_uint64(
+				          optarg,
+				          string_length + 1,
+				          &input_size_variable,
+				          &error );
+
+				if( result != 1 )
+				{
+					libsystem_notify_print_error_backtrace(
+					 error );
+					liberror_error_free(
+					 &error );
+				}
+				if( ( result != 1 )
+				 || ( input_size_variable == 0 )
+				 || ( input_size_variable > (uint64_t) LIBEWF_MAXIMUM_NUMBER_OF_THREADS ) )
+				{
+					input_size_variable = 1;
+
+					fprintf(
+					 stderr,
+					 "Unsupported amount of threads defaulting to: %" PRIu64 ".\n",
+					 input_size_variable );
+				}
+				maximum_number_of_threads = (int) input_size_variable;
+
+				break;
+
+			case (libsystem_integer_t) 'k':
+				kernels_only = 1;
+
+				break;
+
+			case (libsystem_integer_t) 'n':
+				string_length = libsystem_string_length(
+				                 optarg );
+
+				result = libsystem_string_to_uint64(
+				          optarg,
+				          string_length + 1,
+				          &input_size_variable,
+				          &error );
+
+				if( result != 1 )
+				{
+					libsystem_notify_print_error_backtrace(
+					 error );
+					liberror_error_free(
+					 &error );
+				}
+				if( ( result != 1 )
+				 || ( input_size_variable > (uint64_t) EWFBENCH_MAXIMUM_AMOUNT_OF_READS ) )
+				{
+					input_size_variable = EWFBENCH_DEFAULT_AMOUNT_OF_READS;
+
+					fprintf(
+					 stderr,
+					 "Unsupported amount of reads defaulting to: %" PRIu64 ".\n",
+					 input_size_variable );
+				}
+				amount_of_reads = (int) input_size_variable;
+
+				break;
+
+			case (libsystem_integer_t) 'p':
+				string_length = libsystem_string_length(
+				                 optarg );
+
+				result = byte_size_string_convert(
+				          optarg,
+				          string_length,
+				          &process_buffer_size,
+				          &error );
+
+				if( result != 1 )
+				{
+					libsystem_notify_print_error_backtrace(
+					 error );
+					liberror_error_free(
+					 &error );
+				}
+				if( ( result != 1 )
+				 || ( process_buffer_size == 0 )
+				 || ( process_buffer_size > (uint64_t) SSIZE_MAX ) )
+				{
+					process_buffer_size = EWFBENCH_DEFAULT_PROCESS_BUFFER_SIZE;
+
+					fprintf(
+					 stderr,
+					 "Unsupported process buffer size defaulting to: %" PRIu64 ".\n",
+					 process_buffer_size );
+				}
+				break;
+
+			case (libsystem_integer_t) 'r':
+				string_length = libsystem_string_length(
+				                 optarg );
+
+				result = byte_size_string_convert(
+				          optarg,
+				          string_length,
+				          &read_size,
+				          &error );
+
+				if( result != 1 )
+				{
+					libsystem_notify_print_error_backtrace(
+					 error );
+					liberror_error_free(
+					 &error );
+				}
+				if( ( result != 1 )
+				 || ( read_size == 0 )
+				 || ( read_size > (uint64_t) SSIZE_MAX ) )
+				{
+					read_size = EWFBENCH_DEFAULT_READ_SIZE;
+
+					fprintf(
+					 stderr,
+					 "Unsupported read size defaulting to: %" PRIu64 ".\n",
+					 read_size );
+				}
+				break;
+
+			case (libsystem_integer_t) 's':
+				string_length = libsystem_string_length(
+				                 optarg );
+
+				result = libsystem_string_to_uint64(
+				          optarg,
+				          string_length + 1,
+				          &input_size_variable,
+				          &error );
+
+				if( result != 1 )
+				{
+					libsystem_notify_print_error_backtrace(
+					 error );
+					liberror_error_free(
+					 &error );
+				}
+				if( ( result != 1 )
+				 || ( input_size_variable > 100 ) )
+				{
+					input_size_variable = 0;
+
+					fprintf(
+					 stderr,
+					 "Unsupported sparsity defaulting to: %" PRIu64 ".\n",
+					 input_size_variable );
+				}
+				sparsity = (uint8_t) input_size_variable;
+
+				break;
+
+			case (libsystem_integer_t) 't':
+				target_filename = optarg;
+
+				break;
+
+			case (libsystem_integer_t) 'v':
+				verbose = 1;
+
+				break;
+
+			case (libsystem_integer_t) 'V':
+				ewfoutput_copyright_fprint(
+				 stderr );
+
+				return( EXIT_SUCCESS );
+
+			case (libsystem_integer_t) 'x':
+				string_length = libsystem_string_length(
+				                 optarg );
+
+				result = libsystem_string_to_uint64(
+				          optarg,
+				          string_length + 1,
+				          &input_size_variable,
+				          &error );
+
+				if( result != 1 )
+				{
+					libsystem_notify_print_error_backtrace(
+					 error );
+					liberror_error_free(
+					 &error );
+				}
+				if( ( result != 1 )
+				 || ( input_size_variable > (uint64_t) UINT32_MAX ) )
+				{
+					input_size_variable = 1;
+
+					fprintf(
+					 stderr,
+					 "Unsupported seed defaulting to: %" PRIu64 ".\n",
+					 input_size_variable );
+				}
+				seed = (uint32_t) input_size_variable;
+
+				break;
+		}
+	}
+	/* The random reads are read into the process buffer
+	 */
+	if( read_size > process_buffer_size )
+	{
+		process_buffer_size = read_size;
+	}
+	if( read_size > media_size )
+	{
+		read_size = media_size;
+	}
+	libsystem_notify_set_verbose(
+	 verbose );
+#if defined( HAVE_V2_API )
+	libewf_notify_set_verbose(
+	 verbose );
+	libewf_notify_set_stream(
+	 stderr,
+	 NULL );
+#else
+	libewf_set_notify_values(
+	 stderr,
+	 verbose );
+#endif
+
+	if( amount_of_reads > 0 )
+	{
+		latencies = (uint64_t *) memory_allocate(
+		                          sizeof( uint64_t ) * amount_of_reads );
+
+		if( latencies == NULL )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to create latencies.\n" );
+
+			return( EXIT_FAILURE );
+		}
+	}
+	if( bench_handle_initialize(
+	     &bench_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create benchmark handle.\n" );
+
+		libsystem_notify_print_error_backtrace(
+		 error );
+		liberror_error_free(
+		 &error );
+
+		memory_free(
+		 latencies );
+
+		return( EXIT_FAILURE );
+	}
+	if( bench_handle_set_maximum_number_of_threads(
+	     bench_handle,
+	     maximum_number_of_threads,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to set maximum number of threads.\n" );
+
+		libsystem_notify_print_error_backtrace(
+		 error );
+		liberror_error_free(
+		 &error );
+
+		bench_handle_free(
+		 &bench_handle,
+		 NULL );
+		memory_free(
+		 latencies );
+
+		return( EXIT_FAILURE );
+	}
+	if( bench_handle_set_data_values(
+	     bench_handle,
+	     (size_t) process_buffer_size,
+	     entropy,
+	     sparsity,
+	     seed,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to synthesize data.\n" );
+
+		libsystem_notify_print_error_backtrace(
+		 error );
+		liberror_error_free(
+		 &error );
+
+		bench_handle_free(
+		 &bench_handle,
+		 NULL );
+		memory_free(
+		 latencies );
+
+		return( EXIT_FAILURE );
+	}
+	ewfbench_bench_handle = bench_handle;
+
+	if( libsystem_signal_attach(
+	     ewfbench_signal_handler,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to attach signal handler.\n" );
+
+		libsystem_notify_print_error_backtrace(
+		 error );
+		liberror_error_free(
+		 &error );
+	}
+	fprintf(
+	 stdout,
+	 "{\n"
+	 "  \"version\": \"%s\",\n"
+	 "  \"media_size\": %" PRIu64 ",\n"
+	 "  \"process_buffer_size\": %" PRIu64 ",\n"
+	 "  \"entropy\": %" PRIu8 ",\n"
+	 "  \"sparsity\": %" PRIu8 ",\n"
+	 "  \"seed\": %" PRIu32 ",\n"
+	 "  \"maximum_number_of_threads\": %d,\n"
+	 "  \"runs\": [",
+	 LIBEWF_VERSION_STRING,
+	 media_size,
+	 process_buffer_size,
+	 entropy,
+	 sparsity,
+	 seed,
+	 maximum_number_of_threads );
+
+	for( compression_type_iterator = 0;
+	     compression_type_iterator < EWFINPUT_COMPRESSION_LEVELS_AMOUNT;
+	     compression_type_iterator++ )
+	{
+		if( ( ewfbench_abort != 0 )
+		 || ( kernels_only != 0 ) )
+		{
+			break;
+		}
+		/* Without a compression type all of them are measured
+		 */
+		if( compression_type == NULL )
+		{
+			if( ewfinput_determine_compression_level(
+			     ewfinput_compression_levels[ compression_type_iterator ],
+			     &compression_level,
+			     &compression_flags,
+			     &error ) != 1 )
+			{
+				fprintf(
+				 stderr,
+				 "Unable to determine compression level.\n" );
+
+				libsystem_notify_print_error_backtrace(
+				 error );
+				liberror_error_free(
+				 &error );
+
+				result = -1;
+
+				break;
+			}
+		}
+		else if( libsystem_string_compare(
+		          compression_type,
+		          ewfinput_compression_levels[ compression_type_iterator ],
+		          libsystem_string_length(
+		           ewfinput_compression_levels[ compression_type_iterator ] ) + 1 ) != 0 )
+		{
+			continue;
+		}
+		print_count = libsystem_string_snprintf(
+		               filename,
+		               EWFBENCH_FILENAME_SIZE,
+		               _LIBSYSTEM_CHARACTER_T_STRING( "%" ) _LIBSYSTEM_CHARACTER_T_STRING( PRIs_LIBSYSTEM )
+		               _LIBSYSTEM_CHARACTER_T_STRING( "-%" ) _LIBSYSTEM_CHARACTER_T_STRING( PRIs_LIBSYSTEM ),
+		               target_filename,
+		               ewfinput_compression_levels[ compression_type_iterator ] );
+
+		if( ( print_count <= -1 )
+		 || ( print_count >= ( EWFBENCH_FILENAME_SIZE - 4 ) ) )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to create target filename.\n" );
+
+			result = -1;
+
+			break;
+		}
+		fprintf(
+		 stdout,
+		 "%s\n    {\n"
+		 "      \"compression_type\": \"%" PRIs_LIBSYSTEM "\"",
+		 ( compression_type_iterator == 0 ) || ( compression_type != NULL ) ? "" : ",",
+		 ewfinput_compression_levels[ compression_type_iterator ] );
+
+		run_result = bench_handle_write(
+		              bench_handle,
+		              filename,
+		              media_size,
+		              compression_level,
+		              compression_flags,
+		              &elapsed_time,
+		              &error );
+
+		if( run_result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to write image.\n" );
+
+			libsystem_notify_print_error_backtrace(
+			 error );
+			liberror_error_free(
+			 &error );
+
+			result = -1;
+		}
+		else if( run_result == 1 )
+		{
+			ewfbench_throughput_fprint(
+			 stdout,
+			 6,
+			 "write",
+			 media_size,
+			 elapsed_time );
+		}
+		/* The images are read using the first segment file
+		 */
+		libsystem_string_copy(
+		 &( filename[ print_count ] ),
+		 _LIBSYSTEM_CHARACTER_T_STRING( ".E01" ),
+		 5 );
+
+		if( run_result == 1 )
+		{
+			run_result = bench_handle_read(
+			              bench_handle,
+			              filename,
+			              &media_size_read,
+			              &elapsed_time,
+			              &error );
+
+			if( run_result == -1 )
+			{
+				fprintf(
+				 stderr,
+				 "Unable to read image.\n" );
+
+				libsystem_notify_print_error_backtrace(
+				 error );
+				liberror_error_free(
+				 &error );
+
+				result = -1;
+			}
+			else if( run_result == 1 )
+			{
+				ewfbench_throughput_fprint(
+				 stdout,
+				 6,
+				 "sequential_read",
+				 media_size_read,
+				 elapsed_time );
+			}
+		}
+		if( ( run_result == 1 )
+		 && ( amount_of_reads > 0 ) )
+		{
+			run_result = bench_handle_read_random(
+			              bench_handle,
+			              filename,
+			              (size_t) read_size,
+			              latencies,
+			              amount_of_reads,
+			              &error );
+
+			if( run_result == -1 )
+			{
+				fprintf(
+				 stderr,
+				 "Unable to randomly read image.\n" );
+
+				libsystem_notify_print_error_backtrace(
+				 error );
+				liberror_error_free(
+				 &error );
+
+				result = -1;
+			}
+			else if( run_result == 1 )
+			{
+				ewfbench_latencies_fprint(
+				 stdout,
+				 (size_t) read_size,
+				 latencies,
+				 amount_of_reads );
+			}
+		}
+		fprintf(
+		 stdout,
+		 "\n    }" );
+
+		if( result != 1 )
+		{
+			break;
+		}
+	}
+	/* The kernels are measured on a single thread
+	 */
+	fprintf(
+	 stdout,
+	 "\n  ],\n"
+	 "  \"kernels\": {\n"
+	 "    \"kernel_size\": %d",
+	 BENCH_HANDLE_KERNEL_SIZE );
+
+	for( kernel_iterator = 0;
+	     kernel_iterator < EWFBENCH_AMOUNT_OF_KERNELS;
+	     kernel_iterator++ )
+	{
+		if( ( ewfbench_abort != 0 )
+		 || ( result != 1 ) )
+		{
+			break;
+		}
+		run_result = bench_handle_measure_kernel(
+		              bench_handle,
+		              ewfbench_kernels[ kernel_iterator ],
+		              ewfbench_kernel_data_types[ kernel_iterator ],
+		              &media_size_read,
+		              &elapsed_time,
+		              &error );
+
+		if( run_result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to measure kernel: %s.\n",
+			 ewfbench_kernel_names[ kernel_iterator ] );
+
+			libsystem_notify_print_error_backtrace(
+			 error );
+			liberror_error_free(
+			 &error );
+
+			result = -1;
+		}
+		/* Kernels that are not supported by the processor are not printed
+		 */
+		else if( run_result == 1 )
+		{
+			ewfbench_throughput_fprint(
+			 stdout,
+			 4,
+			 ewfbench_kernel_names[ kernel_iterator ],
+			 media_size_read,
+			 elapsed_time );
+		}
+	}
+	fprintf(
+	 stdout,
+	 "\n  },\n"
+	 "  \"status\": \"%s\"\n"
+	 "}\n",
+	 ( ewfbench_abort != 0 ) ? "aborted" : ( ( result == 1 ) ? "completed" : "failed" ) );
+
+	if( libsystem_signal_detach(
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to detach signal handler.\n" );
+
+		libsystem_notify_print_error_backtrace(
+		 error );
+		liberror_error_free(
+		 &error );
+	}
+	ewfbench_bench_handle = NULL;
+
+	if( bench_handle_free(
+	     &bench_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free benchmark handle.\n" );
+
+		libsystem_notify_print_error_backtrace(
+		 error );
+		liberror_error_free(
+		 &error );
+
+		result = -1;
+	}
+	if( latencies != NULL )
+	{
+		memory_free(
+		 latencies );
+	}
+	if( ( ewfbench_abort != 0 )
+	 || ( result != 1 ) )
+	{
+		return( EXIT_FAILURE );
+	}
+	return( EXIT_SUCCESS );
+}
+
@@ -116,12 +116,12 @@ void usage_fprint(
 	fprintf( stream, "Usage: ewfexport [ -A codepage ] [ -b amount_of_sectors ] [ -B amount_of_bytes ]\n"
 	                 "                 [ -c compression_type ] [ -d digest_type ] [ -f format ]\n"
 	                 "                 [ -l log_filename ] [ -o offset ] [ -p process_buffer_size ]\n"
-	                 "                 [ -S segment_file_size ] [ -t target ] [ -hqsuvVw ] ewf_files\n\n" );
+	                 "                 [ -S segment_file_size ] [ -t target ] [ -hqsuvVwz ] ewf_files\n\n" );
 #else
 	fprintf( stream, "Usage: ewfexport [ -A codepage ] [ -B amount_of_bytes ] [ -c compression_type ]\n"
 	                 "                 [ -d digest_type ] [ -f format ] [ -l log_filename ]\n"
 	                 "                 [ -o offset ] [ -p process_buffer_size ] [ -S segment_file_size ]\n"
-	                 "                 [ -t target ] [ -hqsuvVw ] ewf_files\n\n" );
+	                 "                 [ -t target ] [ -hqsuvVwz ] ewf_files\n\n" );
 #endif
 
 	fprintf( stream, "\tewf_files: the first or the entire set of EWF segment files\n\n" );
@@ -137,8 +137,8 @@ void usage_fprint(
 	fprintf( stream, "\t-B:        specify the amount of bytes to export (default is all bytes)\n" );
 	fprintf( stream, "\t-c:        specify the compression type, options: none (default), empty-block,\n"
 	                 "\t           fast or best (not used for raw format)\n" );
-	fprintf( stream, "\t-d:        calculate additional digest (hash) types besides md5, options: sha1\n"
-	                 "\t           (not used for raw format)\n" );
+	fprintf( stream, "\t-d:        calculate additional digest (hash) types besides md5, options: sha1,\n"
+	                 "\t           sha256 (not used for raw format)\n" );
 	fprintf( stream, "\t-f:        specify the file format to write to, options: raw (default), ewf,\n"
 	                 "\t           smart, encase1, encase2, encase3, encase4, encase5, encase6, linen5,\n"
 	                 "\t           linen6, ewfx\n" );
@@ -179,6 +179,8 @@ void usage_fprint(
 	fprintf( stream, "\t-v:        verbose output to stderr\n" );
 	fprintf( stream, "\t-V:        print version\n" );
 	fprintf( stream, "\t-w:        wipe sectors on CRC error (mimic EnCase like behavior)\n" );
+	fprintf( stream, "\t-z:        write empty (zero byte) ranges as sparse regions in the target file\n"
+	                 "\t           (only used for raw format, not used for stdout)\n" );
 }
 
 /* Reads the media data and exports it
@@ -193,6 +195,8 @@ ssize64_t ewfexport_read_input(
            size_t calculated_md5_hash_string_size,
            libsystem_character_t *calculated_sha1_hash_string,
            size_t calculated_sha1_hash_string_size,
+           libsystem_character_t *calculated_sha256_hash_string,
+           size_t calculated_sha256_hash_string_size,
            uint8_t swap_byte_pairs,
            size_t process_buffer_size,
            process_status_t *process_status,
@@ -721,6 +725,8 @@ ssize64_t ewfexport_read_input(
 	               calculated_md5_hash_string_size,
 	               calculated_sha1_hash_string,
 	               calculated_sha1_hash_string_size,
+	               calculated_sha256_hash_string,
+	               calculated_sha256_hash_string_size,
 	               error );
 
 	if( write_count == -1 )
@@ -785,63 +791,66 @@ int main( int argc, char * const argv[] )
 	libsystem_character_t acquiry_operating_system[ 32 ];
 	libsystem_character_t input_buffer[ EWFEXPORT_INPUT_BUFFER_SIZE ];
 
-	libsystem_character_t * const *argv_filenames      = NULL;
+	libsystem_character_t * const *argv_filenames        = NULL;
 
-	export_handle_t *export_handle                     = NULL;
+	export_handle_t *export_handle                       = NULL;
 
 #if !defined( LIBSYSTEM_HAVE_GLOB )
-	libsystem_glob_t *glob                             = NULL;
+	libsystem_glob_t *glob                               = NULL;
 #endif
-	liberror_error_t *error                            = NULL;
-
-	process_status_t *process_status                   = NULL;
-
-	libsystem_character_t *acquiry_software_version    = NULL;
-	libsystem_character_t *calculated_md5_hash_string  = NULL;
-	libsystem_character_t *calculated_sha1_hash_string = NULL;
-	libsystem_character_t *fixed_string_variable       = NULL;
-	libsystem_character_t *log_filename                = NULL;
-	libsystem_character_t *option_target_filename      = NULL;
-	libsystem_character_t *program                     = _LIBSYSTEM_CHARACTER_T_STRING( "ewfexport" );
-	libsystem_character_t *target_filename             = NULL;
-
-	FILE *log_file_stream                              = NULL;
-
-	libsystem_integer_t option                         = 0;
-	size64_t media_size                                = 0;
-	ssize64_t export_count                             = 0;
-	size_t string_length                               = 0;
-	uint64_t export_offset                             = 0;
-	uint64_t export_size                               = 0;
-	uint64_t maximum_segment_file_size                 = 0;
-	uint64_t process_buffer_size                       = EWFCOMMON_PROCESS_BUFFER_SIZE;
-	uint64_t segment_file_size                         = 0;
-	uint32_t sectors_per_chunk                         = 64;
-	uint8_t calculate_md5                              = 1;
-	uint8_t calculate_sha1                             = 0;
-	uint8_t compression_flags                          = 0;
-	uint8_t export_handle_output_format                = 0;
-	uint8_t ewf_format                                 = LIBEWF_FORMAT_ENCASE6;
-	uint8_t print_status_information                   = 1;
-	uint8_t swap_byte_pairs                            = 0;
-	uint8_t wipe_chunk_on_error                        = 0;
-	uint8_t verbose                                    = 0;
-	int8_t compression_level                           = LIBEWF_COMPRESSION_NONE;
-	int amount_of_filenames                            = 0;
-	int argument_set_compression                       = 0;
-	int argument_set_format                            = 0;
-	int argument_set_offset                            = 0;
-	int argument_set_sectors_per_chunk                 = 0;
-	int argument_set_segment_file_size                 = 0;
-	int argument_set_size                              = 0;
-	int error_abort                                    = 0;
-	int header_codepage                                = LIBEWF_CODEPAGE_ASCII;
-	int interactive_mode                               = 1;
-	int output_raw                                     = 1;
-	int result                                         = 1;
-	int status                                         = 0;
-
-	libsystem_character_t *ewfexport_format_types[ 13 ] = \
+	liberror_error_t *error                              = NULL;
+
+	process_status_t *process_status                     = NULL;
+
+	libsystem_character_t *acquiry_software_version      = NULL;
+	libsystem_character_t *calculated_md5_hash_string    = NULL;
+	libsystem_character_t *calculated_sha1_hash_string   = NULL;
+	libsystem_character_t *calculated_sha256_hash_string = NULL;
+	libsystem_character_t *fixed_string_variable         = NULL;
+	libsystem_character_t *log_filename                  = NULL;
+	libsystem_character_t *option_target_filename        = NULL;
+	libsystem_character_t *program                       = _LIBSYSTEM_CHARACTER_T_STRING( "ewfexport" );
+	libsystem_character_t *target_filename               = NULL;
+
+	FILE *log_file_stream                                = NULL;
+
+	libsystem_integer_t option                           = 0;
+	size64_t media_size                                  = 0;
+	ssize64_t export_count                               = 0;
+	size_t string_length                                 = 0;
+	uint64_t export_offset                               = 0;
+	uint64_t export_size                                 = 0;
+	uint64_t maximum_segment_file_size                   = 0;
+	uint64_t process_buffer_size                         = EWFCOMMON_PROCESS_BUFFER_SIZE;
+	uint64_t segment_file_size                           = 0;
+	uint32_t sectors_per_chunk                           = 64;
+	uint8_t calculate_md5                                = 1;
+	uint8_t calculate_sha1                               = 0;
+	uint8_t calculate_sha256                             = 0;
+	uint8_t compression_flags                            = 0;
+	uint8_t export_handle_output_format                  = 0;
+	uint8_t ewf_format                                   = LIBEWF_FORMAT_ENCASE6;
+	uint8_t print_status_information                     = 1;
+	uint8_t sparse_output                                = 0;
+	uint8_t swap_byte_pairs                              = 0;
+	uint8_t wipe_chunk_on_error                          = 0;
+	uint8_t verbose                                      = 0;
+	int8_t compression_level                             = LIBEWF_COMPRESSION_NONE;
+	int amount_of_filenames                              = 0;
+	int argument_set_compression                         = 0;
+	int argument_set_format                              = 0;
+	int argument_set_offset                              = 0;
+	int argument_set_sectors_per_chunk                   = 0;
+	int argument_set_segment_file_size                   = 0;
+	int argument_set_size                                = 0;
+	int error_abort                                      = 0;
+	int header_codepage                                  = LIBEWF_CODEPAGE_ASCII;
+	int interactive_mode                                 = 1;
+	int output_raw                                       = 1;
+	int result                                           = 1;
+	int status                                           = 0;
+
+	libsystem_character_t *ewfexport_format_types[ 13 ]  = \
 	 { _LIBSYSTEM_CHARACTER_T_STRING( "raw" ),
 	   _LIBSYSTEM_CHARACTER_T_STRING( "ewf" ),
 	   _LIBSYSTEM_CHARACTER_T_STRING( "smart" ),
@@ -908,12 +917,12 @@ int main( int argc, char * const argv[] )
 	while( ( option = libsystem_getopt(
 	                   argc,
 	                   argv,
-	                   _LIBSYSTEM_CHARACTER_T_STRING( "A:b:B:c:d:f:hl:o:p:qsS:t:uvVw" ) ) ) != (libsystem_integer_t) -1 )
+	                   _LIBSYSTEM_CHARACTER_T_STRING( "A:b:B:c:d:f:hl:o:p:qsS:t:uvVwz" ) ) ) != (libsystem_integer_t) -1 )
 #else
 	while( ( option = libsystem_getopt(
 	                   argc,
 	                   argv,
-	                   _LIBSYSTEM_CHARACTER_T_STRING( "A:B:c:d:f:hl:o:p:qsS:t:uvVw" ) ) ) != (libsystem_integer_t) -1 )
+	                   _LIBSYSTEM_CHARACTER_T_STRING( "A:B:c:d:f:hl:o:p:qsS:t:uvVwz" ) ) ) != (libsystem_integer_t) -1 )
 #endif
 	{
 		switch( option )
@@ -1027,6 +1036,13 @@ int main( int argc, char * const argv[] )
 				{
 					calculate_sha1 = 1;
 				}
+				else if( libsystem_string_compare(
+				          optarg,
+				          _LIBSYSTEM_CHARACTER_T_STRING( "sha256" ),
+				          6 ) == 0 )
+				{
+					calculate_sha256 = 1;
+				}
 				else
 				{
 					fprintf(
@@ -1191,6 +1207,11 @@ int main( int argc, char * const argv[] )
 			case (libsystem_integer_t) 'w':
 				wipe_chunk_on_error = 1;
 
+				break;
+
+			case (libsystem_integer_t) 'z':
+				sparse_output = 1;
+
 				break;
 		}
 	}
@@ -1280,6 +1301,7 @@ int main( int argc, char * const argv[] )
 	     &export_handle,
 	     calculate_md5,
 	     calculate_sha1,
+	     calculate_sha256,
 	     &error ) != 1 )
 	{
 		fprintf(
@@ -1850,6 +1872,40 @@ int main( int argc, char * const argv[] )
 			return( EXIT_FAILURE );
 		}
 	}
+	if( calculate_sha256 == 1 )
+	{
+		calculated_sha256_hash_string = (libsystem_character_t *) memory_allocate(
+		                                                           sizeof( libsystem_character_t )* DIGEST_HASH_STRING_SIZE_SHA256 );
+
+		if( calculated_sha256_hash_string == NULL )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to create calculated SHA256 hash string.\n" );
+
+			if( calculate_sha1 == 1 )
+			{
+				memory_free(
+				 calculated_sha1_hash_string );
+			}
+			if( calculate_md5 == 1 )
+			{
+				memory_free(
+				 calculated_md5_hash_string );
+			}
+			memory_free(
+			 target_filename );
+
+			export_handle_close(
+			 export_handle,
+			 NULL );
+			export_handle_free(
+			 &export_handle,
+			 NULL );
+
+			return( EXIT_FAILURE );
+		}
+	}
 	if( ewfexport_abort == 0 )
 	{
 		fprintf(
@@ -1874,6 +1930,11 @@ int main( int argc, char * const argv[] )
 			liberror_error_free(
 			 &error );
 
+			if( calculate_sha256 == 1 )
+			{
+				memory_free(
+				 calculated_sha256_hash_string );
+			}
 			if( calculate_sha1 == 1 )
 			{
 				memory_free(
@@ -1913,6 +1974,11 @@ int main( int argc, char * const argv[] )
 			 &process_status,
 			 NULL );
 
+			if( calculate_sha256 == 1 )
+			{
+				memory_free(
+				 calculated_sha256_hash_string );
+			}
 			if( calculate_sha1 == 1 )
 			{
 				memory_free(
@@ -1962,6 +2028,11 @@ int main( int argc, char * const argv[] )
 			 &process_status,
 			 NULL );
 
+			if( calculate_sha256 == 1 )
+			{
+				memory_free(
+				 calculated_sha256_hash_string );
+			}
 			if( calculate_sha1 == 1 )
 			{
 				memory_free(
@@ -1987,6 +2058,48 @@ int main( int argc, char * const argv[] )
 		memory_free(
 		 target_filename );
 
+		if( export_handle_set_sparse_output(
+		     export_handle,
+		     sparse_output,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set sparse output.\n" );
+
+			libsystem_notify_print_error_backtrace(
+			 error );
+			liberror_error_free(
+			 &error );
+
+			process_status_free(
+			 &process_status,
+			 NULL );
+
+			if( calculate_sha256 == 1 )
+			{
+				memory_free(
+				 calculated_sha256_hash_string );
+			}
+			if( calculate_sha1 == 1 )
+			{
+				memory_free(
+				 calculated_sha1_hash_string );
+			}
+			if( calculate_md5 == 1 )
+			{
+				memory_free(
+				 calculated_md5_hash_string );
+			}
+			export_handle_close(
+			 export_handle,
+			 NULL );
+			export_handle_free(
+			 &export_handle,
+			 NULL );
+
+			return( EXIT_FAILURE );
+		}
 		if( platform_get_operating_system(
 		     acquiry_operating_system,
 		     32,
@@ -2033,6 +2146,11 @@ int main( int argc, char * const argv[] )
 			 &process_status,
 			 NULL );
 
+			if( calculate_sha256 == 1 )
+			{
+				memory_free(
+				 calculated_sha256_hash_string );
+			}
 			if( calculate_sha1 == 1 )
 			{
 				memory_free(
@@ -2063,6 +2181,8 @@ int main( int argc, char * const argv[] )
 				DIGEST_HASH_STRING_SIZE_MD5,
 				calculated_sha1_hash_string,
 				DIGEST_HASH_STRING_SIZE_SHA1,
+				calculated_sha256_hash_string,
+				DIGEST_HASH_STRING_SIZE_SHA256,
 				swap_byte_pairs,
 				(size_t) process_buffer_size,
 				process_status,
@@ -2105,6 +2225,11 @@ int main( int argc, char * const argv[] )
 		 &process_status,
 		 NULL );
 
+		if( calculate_sha256 == 1 )
+		{
+			memory_free(
+			 calculated_sha256_hash_string );
+		}
 		if( calculate_sha1 == 1 )
 		{
 			memory_free(
@@ -2137,6 +2262,11 @@ int main( int argc, char * const argv[] )
 		liberror_error_free(
 		 &error );
 
+		if( calculate_sha256 == 1 )
+		{
+			memory_free(
+			 calculated_sha256_hash_string );
+		}
 		if( calculate_sha1 == 1 )
 		{
 			memory_free(
@@ -2220,6 +2350,11 @@ int main( int argc, char * const argv[] )
 			libsystem_file_stream_close(
 			 log_file_stream );
 		}
+		if( calculate_sha256 == 1 )
+		{
+			memory_free(
+			 calculated_sha256_hash_string );
+		}
 		if( calculate_sha1 == 1 )
 		{
 			memory_free(
@@ -2254,6 +2389,11 @@ int main( int argc, char * const argv[] )
 			libsystem_file_stream_close(
 			 log_file_stream );
 		}
+		if( calculate_sha256 == 1 )
+		{
+			memory_free(
+			 calculated_sha256_hash_string );
+		}
 		if( calculate_sha1 == 1 )
 		{
 			memory_free(
@@ -2285,6 +2425,11 @@ int main( int argc, char * const argv[] )
 			libsystem_file_stream_close(
 			 log_file_stream );
 		}
+		if( calculate_sha256 == 1 )
+		{
+			memory_free(
+			 calculated_sha256_hash_string );
+		}
 		if( calculate_sha1 == 1 )
 		{
 			memory_free(
@@ -2331,6 +2476,23 @@ int main( int argc, char * const argv[] )
 		memory_free(
 		 calculated_sha1_hash_string );
 	}
+	if( calculate_sha256 == 1 )
+	{
+		fprintf(
+		 stderr,
+		 "SHA256 hash calculated over data:\t%" PRIs_LIBSYSTEM "\n",
+		 calculated_sha256_hash_string );
+
+		if( log_file_stream != NULL )
+		{
+			fprintf(
+			 log_file_stream,
+			 "SHA256 hash calculated over data:\t%" PRIs_LIBSYSTEM "\n",
+			 calculated_sha256_hash_string );
+		}
+		memory_free(
+		 calculated_sha256_hash_string );
+	}
 	if( log_file_stream != NULL )
 	{
 		if( libsystem_file_stream_close(
@@ -852,6 +852,66 @@ int ewfinput_determine_header_codepage(
 	return( result );
 }
 
+/* Determines the segment file IO open flags from an argument string
+ * Returns 1 if successful or -1 on error
+ */
+int ewfinput_determine_segment_file_io_flags(
+     const libsystem_character_t *argument,
+     uint8_t *segment_file_io_flags,
+     liberror_error_t **error )
+{
+	static char *function = "ewfinput_determine_segment_file_io_flags";
+	int result            = -1;
+
+	if( argument == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid argument string.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file_io_flags == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file IO flags.",
+		 function );
+
+		return( -1 );
+	}
+	if( libsystem_string_compare(
+	     argument,
+	     _LIBSYSTEM_CHARACTER_T_STRING( "file" ),
+	     4 ) == 0 )
+	{
+		*segment_file_io_flags = 0;
+		result                 = 1;
+	}
+	else if( libsystem_string_compare(
+	          argument,
+	          _LIBSYSTEM_CHARACTER_T_STRING( "async" ),
+	          5 ) == 0 )
+	{
+		*segment_file_io_flags = LIBEWF_FLAG_ASYNC_IO;
+		result                 = 1;
+	}
+	else if( libsystem_string_compare(
+	          argument,
+	          _LIBSYSTEM_CHARACTER_T_STRING( "mmap" ),
+	          4 ) == 0 )
+	{
+		*segment_file_io_flags = LIBEWF_FLAG_MEMORY_MAP;
+		result                 = 1;
+	}
+	return( result );
+}
+
 /* Determines the yes or no value from an argument string
  * Returns 1 if successful or -1 on error
  */
@@ -87,6 +87,11 @@ int ewfinput_determine_header_codepage(
      int *header_codepage,
      liberror_error_t **error );
 
+int ewfinput_determine_segment_file_io_flags(
+     const libsystem_character_t *argument,
+     uint8_t *segment_file_io_flags,
+     liberror_error_t **error );
+
 int ewfinput_determine_yes_no(
      const libsystem_character_t *argument,
      uint8_t *yes_no_value,
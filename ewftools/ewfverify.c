@@ -68,7 +68,8 @@ void usage_fprint(
 	fprintf( stream, "Use ewfverify to verify data stored in the EWF format (Expert Witness Compression\n"
 	                 "Format).\n\n" );
 
-	fprintf( stream, "Usage: ewfverify [ -A codepage ] [ -d digest_type ] [ -l log_filename ]\n"
+	fprintf( stream, "Usage: ewfverify [ -A codepage ] [ -d digest_type ] [ -i segment_file_io ]\n"
+	                 "                 [ -j amount_of_threads ] [ -l log_filename ]\n"
 	                 "                 [ -p process_buffer_size ] [ -hqvVw ] ewf_files\n\n" );
 
 	fprintf( stream, "\tewf_files: the first or the entire set of EWF segment files\n\n" );
@@ -76,8 +77,15 @@ void usage_fprint(
 	fprintf( stream, "\t-A:        codepage of header section, options: ascii (default), windows-874,\n"
 	                 "\t           windows-1250, windows-1251, windows-1252, windows-1253, windows-1254,\n"
 	                 "\t           windows-1255, windows-1256, windows-1257, windows-1258\n" );
-	fprintf( stream, "\t-d:        calculate additional digest (hash) types besides md5, options: sha1\n" );
+	fprintf( stream, "\t-d:        calculate additional digest (hash) types besides md5, options: sha1,\n"
+	                 "\t           sha256\n" );
 	fprintf( stream, "\t-h:        shows this help\n" );
+	fprintf( stream, "\t-i:        specify how the segment files are read, options: file (default),\n"
+	                 "\t           async (asynchronous file IO), mmap (memory mapped file IO)\n" );
+	fprintf( stream, "\t-j:        specify the amount of threads used to process the data, options:\n"
+	                 "\t           1 (default) to %d (more than one thread reads, checks and\n"
+	                 "\t           decompresses the chunks concurrently)\n",
+	 LIBEWF_MAXIMUM_NUMBER_OF_THREADS );
 	fprintf( stream, "\t-l:        logs verification errors and the digest (hash) to the log_filename\n" );
 	fprintf( stream, "\t-p:        specify the process buffer size (default is the chunk size)\n" );
 	fprintf( stream, "\t-q:        quiet shows no status information\n" );
@@ -86,13 +94,14 @@ void usage_fprint(
 	fprintf( stream, "\t-w:        wipe sectors on CRC error (mimic EnCase like behavior)\n" );
 }
 
-/* Reads the data to calculate the MD5 and SHA1 integrity hashes
+/* Reads the data to calculate the MD5, SHA1 and SHA256 integrity hashes
  * Returns the amount of bytes read if successful or -1 on error
  */
 ssize64_t ewfverify_read_input(
            verification_handle_t *verification_handle,
            uint8_t wipe_chunk_on_error,
            size_t process_buffer_size,
+           int maximum_number_of_threads,
            process_status_t *process_status,
            liberror_error_t **error )
 {
@@ -189,6 +198,24 @@ ssize64_t ewfverify_read_input(
 
 		return( -1 );
 	}
+	/* The chunks are read, checked and decompressed ahead by the libewf
+	 * read-ahead threads, the integrity hashes are calculated in order
+	 */
+	if( ( maximum_number_of_threads > 1 )
+	 && ( verification_handle_set_maximum_number_of_threads(
+	       verification_handle,
+	       maximum_number_of_threads,
+	       error ) != 1 ) )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set verification handle maximum number of threads.",
+		 function );
+
+		return( -1 );
+	}
 #if defined( HAVE_LOW_LEVEL_FUNCTIONS )
 	process_buffer_size = chunk_size;
 #else
@@ -406,45 +433,53 @@ int wmain( int argc, wchar_t * const argv[] )
 int main( int argc, char * const argv[] )
 #endif
 {
-	liberror_error_t *error                            = NULL;
+	liberror_error_t *error                              = NULL;
 
-	libsystem_character_t * const *argv_filenames      = NULL;
+	libsystem_character_t * const *argv_filenames        = NULL;
 
 #if !defined( LIBSYSTEM_HAVE_GLOB )
-	libsystem_glob_t *glob                             = NULL;
+	libsystem_glob_t *glob                               = NULL;
 #endif
 
-	process_status_t *process_status                   = NULL;
-
-	libsystem_character_t *calculated_md5_hash_string  = NULL;
-	libsystem_character_t *calculated_sha1_hash_string = NULL;
-	libsystem_character_t *log_filename                = NULL;
-	libsystem_character_t *program                     = _LIBSYSTEM_CHARACTER_T_STRING( "ewfverify" );
-	libsystem_character_t *stored_md5_hash_string      = NULL;
-	libsystem_character_t *stored_sha1_hash_string     = NULL;
-
-	verification_handle_t *verification_handle         = NULL;
-
-	FILE *log_file_stream                              = NULL;
-
-	libsystem_integer_t option                         = 0;
-	ssize64_t verify_count                             = 0;
-	size_t string_length                               = 0;
-	uint64_t process_buffer_size                       = EWFCOMMON_PROCESS_BUFFER_SIZE;
-	uint32_t amount_of_crc_errors                      = 0;
-	uint8_t calculate_md5                              = 1;
-	uint8_t calculate_sha1                             = 0;
-	uint8_t print_status_information                   = 1;
-	uint8_t wipe_chunk_on_error                        = 0;
-	uint8_t verbose                                    = 0;
-	int amount_of_filenames                            = 0;
-	int header_codepage                                = LIBEWF_CODEPAGE_ASCII;
-	int match_md5_hash                                 = 0;
-	int match_sha1_hash                                = 0;
-	int result                                         = 0;
-	int status                                         = 0;
-	int stored_md5_hash_available                      = 0;
-	int stored_sha1_hash_available                     = 0;
+	process_status_t *process_status                     = NULL;
+
+	libsystem_character_t *calculated_md5_hash_string    = NULL;
+	libsystem_character_t *calculated_sha1_hash_string   = NULL;
+	libsystem_character_t *calculated_sha256_hash_string = NULL;
+	libsystem_character_t *log_filename                  = NULL;
+	libsystem_character_t *program                       = _LIBSYSTEM_CHARACTER_T_STRING( "ewfverify" );
+	libsystem_character_t *stored_md5_hash_string        = NULL;
+	libsystem_character_t *stored_sha1_hash_string       = NULL;
+	libsystem_character_t *stored_sha256_hash_string     = NULL;
+
+	verification_handle_t *verification_handle           = NULL;
+
+	FILE *log_file_stream                                = NULL;
+
+	libsystem_integer_t option                           = 0;
+	ssize64_t verify_count                               = 0;
+	size_t string_length                                 = 0;
+	uint64_t input_size_variable                         = 0;
+	uint64_t process_buffer_size                         = EWFCOMMON_PROCESS_BUFFER_SIZE;
+	uint32_t amount_of_crc_errors                        = 0;
+	uint8_t calculate_md5                                = 1;
+	uint8_t calculate_sha1                               = 0;
+	uint8_t calculate_sha256                             = 0;
+	uint8_t print_status_information                     = 1;
+	uint8_t segment_file_io_flags                        = 0;
+	uint8_t wipe_chunk_on_error                          = 0;
+	uint8_t verbose                                      = 0;
+	int amount_of_filenames                              = 0;
+	int header_codepage                                  = LIBEWF_CODEPAGE_ASCII;
+	int match_md5_hash                                   = 0;
+	int maximum_number_of_threads                        = 1;
+	int match_sha1_hash                                  = 0;
+	int match_sha256_hash                                = 0;
+	int result                                           = 0;
+	int status                                           = 0;
+	int stored_md5_hash_available                        = 0;
+	int stored_sha1_hash_available                       = 0;
+	int stored_sha256_hash_available                     = 0;
 
 	libsystem_notify_set_stream(
 	 stderr,
@@ -473,7 +508,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = libsystem_getopt(
 	                   argc,
 	                   argv,
-	                   _LIBSYSTEM_CHARACTER_T_STRING( "A:d:hl:p:qvVw" ) ) ) != (libsystem_integer_t) -1 )
+	                   _LIBSYSTEM_CHARACTER_T_STRING( "A:d:hi:j:l:p:qvVw" ) ) ) != (libsystem_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -516,6 +551,13 @@ int main( int argc, char * const argv[] )
 				{
 					calculate_sha1 = 1;
 				}
+				else if( libsystem_string_compare(
+				          optarg,
+				          _LIBSYSTEM_CHARACTER_T_STRING( "sha256" ),
+				          6 ) == 0 )
+				{
+					calculate_sha256 = 1;
+				}
 				else
 				{
 					fprintf(
@@ -530,6 +572,57 @@ int main( int argc, char * const argv[] )
 
 				return( EXIT_SUCCESS );
 
+			case (libsystem_integer_t) 'i':
+				if( ewfinput_determine_segment_file_io_flags(
+				     optarg,
+				     &segment_file_io_flags,
+				     &error ) != 1 )
+				{
+					libsystem_notify_print_error_backtrace(
+					 error );
+					liberror_error_free(
+					 &error );
+
+					fprintf(
+					 stderr,
+					 "Unsupported segment file IO defaulting to: file.\n" );
+
+					segment_file_io_flags = 0;
+				}
+				break;
+
+			case (libsystem_integer_t) 'j':
+				string_length = libsystem_string_length(
+				                 optarg );
+
+				result = libsystem_string_to_uint64(
+				          optarg,
+				          string_length + 1,
+				          &input_size_variable,
+				          &error );
+
+				if( result != 1 )
+				{
+					libsystem_notify_print_error_backtrace(
+					 error );
+					liberror_error_free(
+					 &error );
+				}
+				if( ( result != 1 )
+				 || ( input_size_variable == 0 )
+				 || ( input_size_variable > (uint64_t) LIBEWF_MAXIMUM_NUMBER_OF_THREADS ) )
+				{
+					input_size_variable = 1;
+
+					fprintf(
+					 stderr,
+					 "Unsupported amount of threads defaulting to: %" PRIu64 ".\n",
+					 input_size_variable );
+				}
+				maximum_number_of_threads = (int) input_size_variable;
+
+				break;
+
 			case (libsystem_integer_t) 'l':
 				log_filename = optarg;
 
@@ -671,6 +764,7 @@ int main( int argc, char * const argv[] )
 	     &verification_handle,
 	     calculate_md5,
 	     calculate_sha1,
+	     calculate_sha256,
 	     &error ) != 1 )
 	{
 		fprintf(
@@ -722,6 +816,7 @@ int main( int argc, char * const argv[] )
 	          verification_handle,
 	          argv_filenames,
 	          amount_of_filenames,
+	          segment_file_io_flags,
 	          &error );
 
 #if !defined( LIBSYSTEM_HAVE_GLOB )
@@ -821,6 +916,7 @@ int main( int argc, char * const argv[] )
 		                verification_handle,
 		                wipe_chunk_on_error,
 		                (size_t) process_buffer_size,
+		                maximum_number_of_threads,
 		                process_status,
 		                &error );
 
@@ -992,6 +1088,76 @@ int main( int argc, char * const argv[] )
 				return( EXIT_FAILURE );
 			}
 		}
+		if( calculate_sha256 == 1 )
+		{
+			stored_sha256_hash_string = (libsystem_character_t *) memory_allocate(
+			                                                       sizeof( libsystem_character_t )* DIGEST_HASH_STRING_SIZE_SHA256 );
+
+			if( stored_sha256_hash_string == NULL )
+			{
+				fprintf(
+				 stderr,
+				 "Unable to create stored SHA256 hash string.\n" );
+
+				if( calculate_sha1 == 1 )
+				{
+					memory_free(
+					 stored_sha1_hash_string );
+					memory_free(
+					 calculated_sha1_hash_string );
+				}
+				if( calculate_md5 == 1 )
+				{
+					memory_free(
+					 stored_md5_hash_string );
+					memory_free(
+					 calculated_md5_hash_string );
+				}
+				verification_handle_close(
+				 verification_handle,
+				 NULL );
+				verification_handle_free(
+				 &verification_handle,
+				 NULL );
+
+				return( EXIT_FAILURE );
+			}
+			calculated_sha256_hash_string = (libsystem_character_t *) memory_allocate(
+			                                                           sizeof( libsystem_character_t )* DIGEST_HASH_STRING_SIZE_SHA256 );
+
+			if( calculated_sha256_hash_string == NULL )
+			{
+				fprintf(
+				 stderr,
+				 "Unable to create calculated SHA256 hash string.\n" );
+
+				memory_free(
+				 stored_sha256_hash_string );
+
+				if( calculate_sha1 == 1 )
+				{
+					memory_free(
+					 stored_sha1_hash_string );
+					memory_free(
+					 calculated_sha1_hash_string );
+				}
+				if( calculate_md5 == 1 )
+				{
+					memory_free(
+					 stored_md5_hash_string );
+					memory_free(
+					 calculated_md5_hash_string );
+				}
+				verification_handle_close(
+				 verification_handle,
+				 NULL );
+				verification_handle_free(
+				 &verification_handle,
+				 NULL );
+
+				return( EXIT_FAILURE );
+			}
+		}
 		if( verification_handle_finalize(
 		     verification_handle,
 		     calculated_md5_hash_string,
@@ -1004,6 +1170,11 @@ int main( int argc, char * const argv[] )
 		     stored_sha1_hash_string,
 		     DIGEST_HASH_STRING_SIZE_SHA1,
 		     &stored_sha1_hash_available,
+		     calculated_sha256_hash_string,
+		     DIGEST_HASH_STRING_SIZE_SHA256,
+		     stored_sha256_hash_string,
+		     DIGEST_HASH_STRING_SIZE_SHA256,
+		     &stored_sha256_hash_available,
 		     &error ) != 1 )
 		{
 			fprintf(
@@ -1015,6 +1186,13 @@ int main( int argc, char * const argv[] )
 			liberror_error_free(
 			 &error );
 
+			if( calculate_sha256 == 1 )
+			{
+				memory_free(
+				 stored_sha256_hash_string );
+				memory_free(
+				 calculated_sha256_hash_string );
+			}
 			if( calculate_sha1 == 1 )
 			{
 				memory_free(
@@ -1052,6 +1230,13 @@ int main( int argc, char * const argv[] )
 			liberror_error_free(
 			 &error );
 
+			if( calculate_sha256 == 1 )
+			{
+				memory_free(
+				 stored_sha256_hash_string );
+				memory_free(
+				 calculated_sha256_hash_string );
+			}
 			if( calculate_sha1 == 1 )
 			{
 				memory_free(
@@ -1215,6 +1400,52 @@ int main( int argc, char * const argv[] )
 					     calculated_sha1_hash_string,
 					     DIGEST_HASH_STRING_SIZE_SHA1 ) == 0 );
 		}
+		if( calculate_sha256 == 1 )
+		{
+			if( stored_sha256_hash_available == 0 )
+			{
+				fprintf(
+				 stdout, "SHA256 hash stored in file:\tN/A\n" );
+
+				if( log_file_stream != NULL )
+				{
+					fprintf(
+					 log_file_stream,
+					 "SHA256 hash stored in file:\tN/A\n" );
+				}
+			}
+			else
+			{
+				fprintf(
+				 stdout,
+				 "SHA256 hash stored in file:\t%" PRIs_LIBSYSTEM "\n",
+				 stored_sha256_hash_string );
+
+				if( log_file_stream != NULL )
+				{
+					fprintf(
+					 log_file_stream,
+					 "SHA256 hash stored in file:\t%" PRIs_LIBSYSTEM "\n",
+					 stored_sha256_hash_string );
+				}
+			}
+			fprintf(
+			 stdout,
+			 "SHA256 hash calculated over data:\t%" PRIs_LIBSYSTEM "\n",
+			 calculated_sha256_hash_string );
+
+			if( log_file_stream != NULL )
+			{
+				fprintf(
+				 log_file_stream,
+				 "SHA256 hash calculated over data:\t%" PRIs_LIBSYSTEM "\n",
+				 calculated_sha256_hash_string );
+			}
+			match_sha256_hash = ( libsystem_string_compare(
+					       stored_sha256_hash_string,
+					       calculated_sha256_hash_string,
+					       DIGEST_HASH_STRING_SIZE_SHA256 ) == 0 );
+		}
 		if( verification_handle_additional_hash_values_fprint(
 		     verification_handle,
 		     stdout,
@@ -1258,6 +1489,13 @@ int main( int argc, char * const argv[] )
 			memory_free(
 			 calculated_sha1_hash_string );
 		}
+		if( calculate_sha256 == 1 )
+		{
+			memory_free(
+			 stored_sha256_hash_string );
+			memory_free(
+			 calculated_sha256_hash_string );
+		}
 	}
 	if( verification_handle_close(
 	     verification_handle,
@@ -1343,7 +1581,10 @@ int main( int argc, char * const argv[] )
 	  || match_md5_hash )
 	 && ( ( calculate_sha1 == 0 )
 	  || ( stored_sha1_hash_available == 0 )
-	  || match_sha1_hash ) )
+	  || match_sha1_hash )
+	 && ( ( calculate_sha256 == 0 )
+	  || ( stored_sha256_hash_available == 0 )
+	  || match_sha256_hash ) )
 	{
 		fprintf(
 		 stdout,
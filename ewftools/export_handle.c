@@ -51,6 +51,7 @@
 #include "guid.h"
 #include "md5.h"
 #include "sha1.h"
+#include "sha256.h"
 
 #if !defined( USE_LIBEWF_GET_HASH_VALUE_MD5 ) && !defined( USE_LIBEWF_GET_MD5_HASH )
 #define USE_LIBEWF_GET_HASH_VALUE_MD5
@@ -63,6 +64,7 @@ int export_handle_initialize(
      export_handle_t **export_handle,
      uint8_t calculate_md5,
      uint8_t calculate_sha1,
+     uint8_t calculate_sha256,
      liberror_error_t **error )
 {
 	static char *function = "export_handle_initialize";
@@ -135,6 +137,7 @@ int export_handle_initialize(
 #endif
 		( *export_handle )->calculate_md5              = calculate_md5;
 		( *export_handle )->calculate_sha1             = calculate_sha1;
+		( *export_handle )->calculate_sha256           = calculate_sha256;
 		( *export_handle )->raw_output_file_descriptor = -1;
 
 		if( ( ( *export_handle )->calculate_md5 != 0 )
@@ -185,6 +188,96 @@ int export_handle_initialize(
 
 			return( -1 );
 		}
+		if( ( ( *export_handle )->calculate_sha256 != 0 )
+		 && ( sha256_initialize(
+		       &( ( *export_handle )->sha256_context ),
+		       error ) != 1 ) )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize SHA256 context.",
+			 function );
+
+#if defined( HAVE_V2_API )
+			libewf_handle_free(
+			 &( ( *export_handle )->ewf_output_handle ),
+			 NULL );
+#endif
+			memory_free(
+			 *export_handle );
+
+			*export_handle = NULL;
+
+			return( -1 );
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		/* The MD5 digest hash is calculated by the calling thread, if more than one
+		 * digest hash is calculated the other digest hashes get a thread of their own
+		 */
+		if( ( ( *export_handle )->calculate_sha1 != 0 )
+		 && ( ( *export_handle )->calculate_md5 != 0 )
+		 && ( digest_thread_initialize(
+		       &( ( *export_handle )->sha1_digest_thread ),
+		       DIGEST_CONTEXT_TYPE_SHA1,
+		       (void *) &( ( *export_handle )->sha1_context ),
+		       error ) != 1 ) )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize SHA1 digest thread.",
+			 function );
+
+#if defined( HAVE_V2_API )
+			libewf_handle_free(
+			 &( ( *export_handle )->ewf_output_handle ),
+			 NULL );
+#endif
+			memory_free(
+			 *export_handle );
+
+			*export_handle = NULL;
+
+			return( -1 );
+		}
+		if( ( ( *export_handle )->calculate_sha256 != 0 )
+		 && ( ( ( *export_handle )->calculate_md5 != 0 )
+		  || ( ( *export_handle )->calculate_sha1 != 0 ) )
+		 && ( digest_thread_initialize(
+		       &( ( *export_handle )->sha256_digest_thread ),
+		       DIGEST_CONTEXT_TYPE_SHA256,
+		       (void *) &( ( *export_handle )->sha256_context ),
+		       error ) != 1 ) )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize SHA256 digest thread.",
+			 function );
+
+			if( ( *export_handle )->sha1_digest_thread != NULL )
+			{
+				digest_thread_free(
+				 &( ( *export_handle )->sha1_digest_thread ),
+				 NULL );
+			}
+#if defined( HAVE_V2_API )
+			libewf_handle_free(
+			 &( ( *export_handle )->ewf_output_handle ),
+			 NULL );
+#endif
+			memory_free(
+			 *export_handle );
+
+			*export_handle = NULL;
+
+			return( -1 );
+		}
+#endif
 	}
 	return( 1 );
 }
@@ -242,6 +335,36 @@ int export_handle_free(
 			result = -1;
 		}
 #endif
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( ( *export_handle )->sha1_digest_thread != NULL )
+		 && ( digest_thread_free(
+		       &( ( *export_handle )->sha1_digest_thread ),
+		       error ) != 1 ) )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free SHA1 digest thread.",
+			 function );
+
+			result = -1;
+		}
+		if( ( ( *export_handle )->sha256_digest_thread != NULL )
+		 && ( digest_thread_free(
+		       &( ( *export_handle )->sha256_digest_thread ),
+		       error ) != 1 ) )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free SHA256 digest thread.",
+			 function );
+
+			result = -1;
+		}
+#endif
 		memory_free(
 		 *export_handle );
 
@@ -935,6 +1058,11 @@ ssize_t export_handle_read_buffer(
 	static char *function = "export_handle_read_buffer";
 	ssize_t read_count    = 0;
 
+#if !defined( HAVE_LOW_LEVEL_FUNCTIONS )
+	off64_t read_offset   = 0;
+	int result            = 0;
+#endif
+
 	if( export_handle == NULL )
 	{
 		liberror_error_set(
@@ -989,6 +1117,98 @@ ssize_t export_handle_read_buffer(
 	              &( storage_media_buffer->process_crc ) );
 #endif
 #else
+	export_handle->input_range_is_empty = 0;
+
+	/* Ranges that are known to be empty from the chunk data
+	 * are not read when the raw output is sparse
+	 */
+	if( ( export_handle->sparse_output != 0 )
+	 && ( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_RAW )
+	 && ( export_handle->raw_output_file_descriptor != 1 ) )
+	{
+#if defined( HAVE_V2_API )
+		if( libewf_handle_get_offset(
+		     export_handle->input_handle,
+		     &read_offset,
+		     error ) != 1 )
+		{
+			read_offset = -1;
+		}
+#else
+		read_offset = libewf_get_offset(
+		               export_handle->input_handle );
+#endif
+		if( read_offset < 0 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve input offset.",
+			 function );
+
+			return( -1 );
+		}
+#if defined( HAVE_V2_API )
+		result = libewf_handle_is_empty_range(
+		          export_handle->input_handle,
+		          read_offset,
+		          (size64_t) read_size,
+		          error );
+#else
+		result = libewf_is_empty_range(
+		          export_handle->input_handle,
+		          read_offset,
+		          (size64_t) read_size );
+#endif
+		if( result == -1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if input range is empty.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			if( memory_set(
+			     storage_media_buffer->raw_buffer,
+			     0,
+			     read_size ) == NULL )
+			{
+				liberror_error_set(
+				 error,
+				 LIBERROR_ERROR_DOMAIN_MEMORY,
+				 LIBERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to clear raw buffer.",
+				 function );
+
+				return( -1 );
+			}
+			if( export_handle_seek_offset(
+			     export_handle,
+			     read_offset + (off64_t) read_size,
+			     error ) == -1 )
+			{
+				liberror_error_set(
+				 error,
+				 LIBERROR_ERROR_DOMAIN_IO,
+				 LIBERROR_IO_ERROR_SEEK_FAILED,
+				 "%s: unable to seek offset.",
+				 function );
+
+				return( -1 );
+			}
+			export_handle->input_range_is_empty = 1;
+
+			storage_media_buffer->raw_buffer_amount = (ssize_t) read_size;
+
+			return( (ssize_t) read_size );
+		}
+	}
 #if defined( HAVE_V2_API )
 	read_count = libewf_handle_read_buffer(
                       export_handle->input_handle,
@@ -1017,11 +1237,52 @@ ssize_t export_handle_read_buffer(
 	storage_media_buffer->compression_buffer_amount = read_count;
 #else
 	storage_media_buffer->raw_buffer_amount         = read_count;
+
+	/* Chunks that are not known to be empty, such as uncompressed chunks,
+	 * are tested for zero bytes after they have been read
+	 */
+	if( ( export_handle->sparse_output != 0 )
+	 && ( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_RAW )
+	 && ( export_handle->raw_output_file_descriptor != 1 ) )
+	{
+		export_handle->input_range_is_empty = export_handle_buffer_is_empty(
+		                                       storage_media_buffer->raw_buffer,
+		                                       (size_t) read_count );
+	}
 #endif
 
 	return( read_count );
 }
 
+/* Determines if a buffer contains zero bytes only
+ * Returns 1 if the buffer is empty or 0 if not
+ */
+int export_handle_buffer_is_empty(
+     const uint8_t *buffer,
+     size_t buffer_size )
+{
+	if( ( buffer == NULL )
+	 || ( buffer_size == 0 ) )
+	{
+		return( 0 );
+	}
+	if( buffer[ 0 ] != 0 )
+	{
+		return( 0 );
+	}
+	/* Comparing the buffer to itself shifted by one byte
+	 * tests every byte against the first byte
+	 */
+	if( memory_compare(
+	     buffer,
+	     &( buffer[ 1 ] ),
+	     buffer_size - 1 ) != 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
 /* Prepares a buffer before writing the output of the export handle
  * Returns the resulting buffer size or -1 on error
  */
@@ -1254,6 +1515,29 @@ ssize_t export_handle_write_buffer(
 
 			return( -1 );
 		}
+		/* Empty ranges are skipped leaving a sparse region (hole)
+		 * in the raw output file
+		 */
+		if( export_handle->input_range_is_empty != 0 )
+		{
+			if( libsystem_file_io_lseek(
+			     export_handle->raw_output_file_descriptor,
+			     (off64_t) write_size,
+			     SEEK_CUR ) == -1 )
+			{
+				liberror_error_set(
+				 error,
+				 LIBERROR_ERROR_DOMAIN_IO,
+				 LIBERROR_IO_ERROR_SEEK_FAILED,
+				 "%s: unable to seek beyond sparse region in raw output file.",
+				 function );
+
+				return( -1 );
+			}
+			export_handle->raw_output_sparse_size += write_size;
+
+			return( (ssize_t) write_size );
+		}
 		write_count = libsystem_file_io_write(
 		               export_handle->raw_output_file_descriptor,
 			       storage_media_buffer->raw_buffer,
@@ -1270,6 +1554,7 @@ ssize_t export_handle_write_buffer(
 
 			return( -1 );
 		}
+		export_handle->raw_output_sparse_size = 0;
 	}
 	return( write_count );
 }
@@ -1439,6 +1724,7 @@ int export_handle_update_integrity_hash(
 	uint8_t *data         = NULL;
 	static char *function = "export_handle_update_integrity_hash";
 	size_t data_size      = 0;
+	int result            = 1;
 
 	if( export_handle == NULL )
 	{
@@ -1489,17 +1775,56 @@ int export_handle_update_integrity_hash(
 
 		return( -1 );
 	}
-	if( export_handle->calculate_md5 != 0 )
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The digest threads calculate their digest hash while the calling thread
+	 * calculates the MD5 digest hash
+	 */
+	if( ( export_handle->sha1_digest_thread != NULL )
+	 && ( digest_thread_start_update(
+	       export_handle->sha1_digest_thread,
+	       data,
+	       read_size,
+	       error ) != 1 ) )
 	{
-		/* TODO check for return value */
-		md5_update(
-		 &( export_handle->md5_context ),
-		 data,
-		 read_size,
-		 error );
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to start update of SHA1 digest hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( export_handle->sha256_digest_thread != NULL )
+	 && ( digest_thread_start_update(
+	       export_handle->sha256_digest_thread,
+	       data,
+	       read_size,
+	       error ) != 1 ) )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to start update of SHA256 digest hash.",
+		 function );
 
-		if( ( error != NULL )
-		 && ( *error != NULL ) )
+		if( export_handle->sha1_digest_thread != NULL )
+		{
+			digest_thread_wait_for_update(
+			 export_handle->sha1_digest_thread,
+			 NULL );
+		}
+		return( -1 );
+	}
+#endif
+	if( export_handle->calculate_md5 != 0 )
+	{
+		if( md5_update(
+		     &( export_handle->md5_context ),
+		     data,
+		     read_size,
+		     error ) != 1 )
 		{
 			liberror_error_set(
 			 error,
@@ -1508,20 +1833,36 @@ int export_handle_update_integrity_hash(
 			 "%s: unable to update MD5 digest hash.",
 			 function );
 
-			return( -1 );
+			result = -1;
 		}
 	}
-	if( export_handle->calculate_sha1 != 0 )
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( export_handle->sha1_digest_thread != NULL )
 	{
-		/* TODO check for return value */
-		sha1_update(
-		 &( export_handle->sha1_context ),
-		 data,
-		 read_size,
-		 error );
+		if( digest_thread_wait_for_update(
+		     export_handle->sha1_digest_thread,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update SHA1 digest hash.",
+			 function );
 
-		if( ( error != NULL )
-		 && ( *error != NULL ) )
+			result = -1;
+		}
+	}
+	else
+#endif
+	if( ( result == 1 )
+	 && ( export_handle->calculate_sha1 != 0 ) )
+	{
+		if( sha1_update(
+		     &( export_handle->sha1_context ),
+		     data,
+		     read_size,
+		     error ) != 1 )
 		{
 			liberror_error_set(
 			 error,
@@ -1530,10 +1871,48 @@ int export_handle_update_integrity_hash(
 			 "%s: unable to update SHA1 digest hash.",
 			 function );
 
-			return( -1 );
+			result = -1;
 		}
 	}
-	return( 1 );
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( export_handle->sha256_digest_thread != NULL )
+	{
+		if( digest_thread_wait_for_update(
+		     export_handle->sha256_digest_thread,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update SHA256 digest hash.",
+			 function );
+
+			result = -1;
+		}
+	}
+	else
+#endif
+	if( ( result == 1 )
+	 && ( export_handle->calculate_sha256 != 0 ) )
+	{
+		if( sha256_update(
+		     &( export_handle->sha256_context ),
+		     data,
+		     read_size,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update SHA256 digest hash.",
+			 function );
+
+			result = -1;
+		}
+	}
+	return( result );
 }
 
 /* Retrieves the input media size
@@ -1767,6 +2146,33 @@ int export_handle_set_header_codepage(
 	return( 1 );
 }
 
+/* Sets the value to indicate if empty ranges should be written as sparse regions
+ * This only applies to raw output written to a file
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_set_sparse_output(
+     export_handle_t *export_handle,
+     uint8_t sparse_output,
+     liberror_error_t **error )
+{
+	static char *function = "export_handle_set_sparse_output";
+
+	if( export_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	export_handle->sparse_output = sparse_output;
+
+	return( 1 );
+}
+
 /* Sets the output values of the export handle
  * Returns 1 if successful or -1 on error
  */
@@ -2537,6 +2943,8 @@ ssize_t export_handle_finalize(
          size_t calculated_md5_hash_string_size,
          libsystem_character_t *calculated_sha1_hash_string,
          size_t calculated_sha1_hash_string_size,
+         libsystem_character_t *calculated_sha256_hash_string,
+         size_t calculated_sha256_hash_string_size,
          liberror_error_t **error )
 {
 #if defined( USE_LIBEWF_GET_MD5_HASH )
@@ -2545,11 +2953,14 @@ ssize_t export_handle_finalize(
 
 	digest_hash_t calculated_md5_hash[ DIGEST_HASH_SIZE_MD5 ];
 	digest_hash_t calculated_sha1_hash[ DIGEST_HASH_SIZE_SHA1 ];
+	digest_hash_t calculated_sha256_hash[ DIGEST_HASH_SIZE_SHA256 ];
 
-	static char *function            = "export_handle_finalize";
-	size_t calculated_md5_hash_size  = DIGEST_HASH_SIZE_MD5;
-	size_t calculated_sha1_hash_size = DIGEST_HASH_SIZE_SHA1;
-	ssize_t write_count              = 0;
+	static char *function              = "export_handle_finalize";
+	size_t calculated_md5_hash_size    = DIGEST_HASH_SIZE_MD5;
+	size_t calculated_sha1_hash_size   = DIGEST_HASH_SIZE_SHA1;
+	size_t calculated_sha256_hash_size = DIGEST_HASH_SIZE_SHA256;
+	ssize_t write_count                = 0;
+	uint8_t sparse_region_last_byte    = 0;
 
 	if( export_handle == NULL )
 	{
@@ -2682,6 +3093,60 @@ ssize_t export_handle_finalize(
 			return( -1 );
 		}
 	}
+	if( export_handle->calculate_sha256 != 0 )
+	{
+		/* Finalize the SHA256 hash calculation
+		 */
+		if( sha256_finalize(
+		     &( export_handle->sha256_context ),
+		     calculated_sha256_hash,
+		     &calculated_sha256_hash_size,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize SHA256 hash.",
+			 function );
+
+			return( -1 );
+		}
+		if( digest_hash_copy_to_string(
+		     calculated_sha256_hash,
+		     calculated_sha256_hash_size,
+		     calculated_sha256_hash_string,
+		     calculated_sha256_hash_string_size,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create calculated SHA256 hash string.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_EWF )
+		 && ( export_handle_set_hash_value(
+		       export_handle,
+		       "SHA256",
+		       6,
+		       calculated_sha256_hash_string,
+		       calculated_sha256_hash_string_size - 1,
+		       error ) != 1 ) )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set hash value: SHA256.",
+			 function );
+
+			return( -1 );
+		}
+	}
 	if( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_EWF )
 	{
 #if defined( HAVE_V2_API )
@@ -2705,6 +3170,42 @@ ssize_t export_handle_finalize(
 			return( -1 );
 		}
 	}
+	else if( ( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_RAW )
+	      && ( export_handle->raw_output_sparse_size > 0 ) )
+	{
+		/* A sparse region at the end of the raw output file does not
+		 * extend the file, hence the last byte of the region is written
+		 */
+		if( libsystem_file_io_lseek(
+		     export_handle->raw_output_file_descriptor,
+		     -1,
+		     SEEK_CUR ) == -1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek end of sparse region in raw output file.",
+			 function );
+
+			return( -1 );
+		}
+		if( libsystem_file_io_write(
+		     export_handle->raw_output_file_descriptor,
+		     &sparse_region_last_byte,
+		     1 ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write end of sparse region in raw output file.",
+			 function );
+
+			return( -1 );
+		}
+		export_handle->raw_output_sparse_size = 0;
+	}
 	return( write_count );
 }
 
@@ -41,8 +41,10 @@
 
 #include "digest_context.h"
 #include "digest_hash.h"
+#include "digest_thread.h"
 #include "md5.h"
 #include "sha1.h"
+#include "sha256.h"
 #include "storage_media_buffer.h"
 
 #if defined( __cplusplus )
@@ -67,6 +69,10 @@ struct export_handle
 	 */
 	uint8_t calculate_sha1;
 
+	/* Value to indicate if the SHA256 digest hash should be calculated
+	 */
+	uint8_t calculate_sha256;
+
 	/* The MD5 digest context
 	 */
 	md5_context_t md5_context;
@@ -75,6 +81,22 @@ struct export_handle
 	 */
 	sha1_context_t sha1_context;
 
+	/* The SHA256 digest context
+	 */
+	sha256_context_t sha256_context;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The thread that calculates the SHA1 digest hash
+	 * concurrently with the MD5 digest hash
+	 */
+	digest_thread_t *sha1_digest_thread;
+
+	/* The thread that calculates the SHA256 digest hash
+	 * concurrently with the MD5 digest hash
+	 */
+	digest_thread_t *sha256_digest_thread;
+#endif
+
 	/* The libewf input handle
 	 */
 	libewf_handle_t *input_handle;
@@ -87,6 +109,19 @@ struct export_handle
 	 */
 	int raw_output_file_descriptor;
 
+	/* Value to indicate if empty input ranges should be written
+	 * as sparse regions of the raw output file
+	 */
+	uint8_t sparse_output;
+
+	/* Value to indicate if the last input range read was empty
+	 */
+	uint8_t input_range_is_empty;
+
+	/* The size of the sparse region at the end of the raw output file
+	 */
+	size64_t raw_output_sparse_size;
+
 	/* The libewf output handle
 	 */
 	libewf_handle_t *ewf_output_handle;
@@ -118,6 +153,7 @@ int export_handle_initialize(
      export_handle_t **export_handle,
      uint8_t calculate_md5,
      uint8_t calculate_sha1,
+     uint8_t calculate_sha256,
      liberror_error_t **error );
 
 int export_handle_free(
@@ -155,6 +191,10 @@ ssize_t export_handle_read_buffer(
          size_t read_size,
          liberror_error_t **error );
 
+int export_handle_buffer_is_empty(
+     const uint8_t *buffer,
+     size_t buffer_size );
+
 ssize_t export_handle_prepare_write_buffer(
          export_handle_t *export_handle,
          storage_media_buffer_t *storage_media_buffer,
@@ -203,6 +243,11 @@ int export_handle_set_header_codepage(
      int header_codepage,
      liberror_error_t **error );
 
+int export_handle_set_sparse_output(
+     export_handle_t *export_handle,
+     uint8_t sparse_output,
+     liberror_error_t **error );
+
 int export_handle_set_output_values(
      export_handle_t *export_handle,
      libsystem_character_t *acquiry_operating_system,
@@ -248,6 +293,8 @@ ssize_t export_handle_finalize(
          size_t calculated_md5_hash_string_size,
          libsystem_character_t *calculated_sha1_hash_string,
          size_t calculated_sha1_hash_string_size,
+         libsystem_character_t *calculated_sha256_hash_string,
+         size_t calculated_sha256_hash_string_size,
          liberror_error_t **error );
 
 int export_handle_crc_errors_fprint(
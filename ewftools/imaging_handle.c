@@ -51,6 +51,7 @@
 #include "imaging_handle.h"
 #include "md5.h"
 #include "sha1.h"
+#include "sha256.h"
 #include "storage_media_buffer.h"
 
 #if !defined( USE_LIBEWF_GET_HASH_VALUE_MD5 ) && !defined( USE_LIBEWF_GET_MD5_HASH )
@@ -66,6 +67,7 @@ int imaging_handle_initialize(
      imaging_handle_t **imaging_handle,
      uint8_t calculate_md5,
      uint8_t calculate_sha1,
+     uint8_t calculate_sha256,
      liberror_error_t **error )
 {
 	static char *function = "imaging_handle_initialize";
@@ -136,8 +138,9 @@ int imaging_handle_initialize(
 			return( -1 );
 		}
 #endif
-		( *imaging_handle )->calculate_md5  = calculate_md5;
-		( *imaging_handle )->calculate_sha1 = calculate_sha1;
+		( *imaging_handle )->calculate_md5    = calculate_md5;
+		( *imaging_handle )->calculate_sha1   = calculate_sha1;
+		( *imaging_handle )->calculate_sha256 = calculate_sha256;
 
 		if( ( ( *imaging_handle )->calculate_md5 != 0 )
 		 && ( md5_initialize(
@@ -187,6 +190,96 @@ int imaging_handle_initialize(
 
 			return( -1 );
 		}
+		if( ( ( *imaging_handle )->calculate_sha256 != 0 )
+		 && ( sha256_initialize(
+		       &( ( *imaging_handle )->sha256_context ),
+		       error ) != 1 ) )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize SHA256 context.",
+			 function );
+
+#if defined( HAVE_V2_API )
+			libewf_handle_free(
+			 &( ( *imaging_handle )->output_handle ),
+			 NULL );
+#endif
+			memory_free(
+			 *imaging_handle );
+
+			*imaging_handle = NULL;
+
+			return( -1 );
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		/* The MD5 digest hash is calculated by the calling thread, if more than one
+		 * digest hash is calculated the other digest hashes get a thread of their own
+		 */
+		if( ( ( *imaging_handle )->calculate_sha1 != 0 )
+		 && ( ( *imaging_handle )->calculate_md5 != 0 )
+		 && ( digest_thread_initialize(
+		       &( ( *imaging_handle )->sha1_digest_thread ),
+		       DIGEST_CONTEXT_TYPE_SHA1,
+		       (void *) &( ( *imaging_handle )->sha1_context ),
+		       error ) != 1 ) )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize SHA1 digest thread.",
+			 function );
+
+#if defined( HAVE_V2_API )
+			libewf_handle_free(
+			 &( ( *imaging_handle )->output_handle ),
+			 NULL );
+#endif
+			memory_free(
+			 *imaging_handle );
+
+			*imaging_handle = NULL;
+
+			return( -1 );
+		}
+		if( ( ( *imaging_handle )->calculate_sha256 != 0 )
+		 && ( ( ( *imaging_handle )->calculate_md5 != 0 )
+		  || ( ( *imaging_handle )->calculate_sha1 != 0 ) )
+		 && ( digest_thread_initialize(
+		       &( ( *imaging_handle )->sha256_digest_thread ),
+		       DIGEST_CONTEXT_TYPE_SHA256,
+		       (void *) &( ( *imaging_handle )->sha256_context ),
+		       error ) != 1 ) )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize SHA256 digest thread.",
+			 function );
+
+			if( ( *imaging_handle )->sha1_digest_thread != NULL )
+			{
+				digest_thread_free(
+				 &( ( *imaging_handle )->sha1_digest_thread ),
+				 NULL );
+			}
+#if defined( HAVE_V2_API )
+			libewf_handle_free(
+			 &( ( *imaging_handle )->output_handle ),
+			 NULL );
+#endif
+			memory_free(
+			 *imaging_handle );
+
+			*imaging_handle = NULL;
+
+			return( -1 );
+		}
+#endif
 	}
 	return( 1 );
 }
@@ -244,6 +337,36 @@ int imaging_handle_free(
 			result = -1;
 		}
 #endif
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( ( *imaging_handle )->sha1_digest_thread != NULL )
+		 && ( digest_thread_free(
+		       &( ( *imaging_handle )->sha1_digest_thread ),
+		       error ) != 1 ) )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free SHA1 digest thread.",
+			 function );
+
+			result = -1;
+		}
+		if( ( ( *imaging_handle )->sha256_digest_thread != NULL )
+		 && ( digest_thread_free(
+		       &( ( *imaging_handle )->sha256_digest_thread ),
+		       error ) != 1 ) )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free SHA256 digest thread.",
+			 function );
+
+			result = -1;
+		}
+#endif
 		memory_free(
 		 *imaging_handle );
 
@@ -1558,6 +1681,7 @@ int imaging_handle_update_integrity_hash(
 	uint8_t *data         = NULL;
 	static char *function = "imaging_handle_update_integrity_hash";
 	size_t data_size      = 0;
+	int result            = 1;
 
 	if( imaging_handle == NULL )
 	{
@@ -1608,17 +1732,56 @@ int imaging_handle_update_integrity_hash(
 
 		return( -1 );
 	}
-	if( imaging_handle->calculate_md5 != 0 )
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The digest threads calculate their digest hash while the calling thread
+	 * calculates the MD5 digest hash
+	 */
+	if( ( imaging_handle->sha1_digest_thread != NULL )
+	 && ( digest_thread_start_update(
+	       imaging_handle->sha1_digest_thread,
+	       data,
+	       read_size,
+	       error ) != 1 ) )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to start update of SHA1 digest hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( imaging_handle->sha256_digest_thread != NULL )
+	 && ( digest_thread_start_update(
+	       imaging_handle->sha256_digest_thread,
+	       data,
+	       read_size,
+	       error ) != 1 ) )
 	{
-		/* TODO check for return value */
-		md5_update(
-		 &( imaging_handle->md5_context ),
-		 data,
-		 read_size,
-		 error );
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to start update of SHA256 digest hash.",
+		 function );
 
-		if( ( error != NULL )
-		 && ( *error != NULL ) )
+		if( imaging_handle->sha1_digest_thread != NULL )
+		{
+			digest_thread_wait_for_update(
+			 imaging_handle->sha1_digest_thread,
+			 NULL );
+		}
+		return( -1 );
+	}
+#endif
+	if( imaging_handle->calculate_md5 != 0 )
+	{
+		if( md5_update(
+		     &( imaging_handle->md5_context ),
+		     data,
+		     read_size,
+		     error ) != 1 )
 		{
 			liberror_error_set(
 			 error,
@@ -1627,20 +1790,36 @@ int imaging_handle_update_integrity_hash(
 			 "%s: unable to update MD5 digest hash.",
 			 function );
 
-			return( -1 );
+			result = -1;
 		}
 	}
-	if( imaging_handle->calculate_sha1 != 0 )
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( imaging_handle->sha1_digest_thread != NULL )
 	{
-		/* TODO check for return value */
-		sha1_update(
-		 &( imaging_handle->sha1_context ),
-		 data,
-		 read_size,
-		 error );
+		if( digest_thread_wait_for_update(
+		     imaging_handle->sha1_digest_thread,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update SHA1 digest hash.",
+			 function );
 
-		if( ( error != NULL )
-		 && ( *error != NULL ) )
+			result = -1;
+		}
+	}
+	else
+#endif
+	if( ( result == 1 )
+	 && ( imaging_handle->calculate_sha1 != 0 ) )
+	{
+		if( sha1_update(
+		     &( imaging_handle->sha1_context ),
+		     data,
+		     read_size,
+		     error ) != 1 )
 		{
 			liberror_error_set(
 			 error,
@@ -1649,10 +1828,48 @@ int imaging_handle_update_integrity_hash(
 			 "%s: unable to update SHA1 digest hash.",
 			 function );
 
-			return( -1 );
+			result = -1;
 		}
 	}
-	return( 1 );
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( imaging_handle->sha256_digest_thread != NULL )
+	{
+		if( digest_thread_wait_for_update(
+		     imaging_handle->sha256_digest_thread,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update SHA256 digest hash.",
+			 function );
+
+			result = -1;
+		}
+	}
+	else
+#endif
+	if( ( result == 1 )
+	 && ( imaging_handle->calculate_sha256 != 0 ) )
+	{
+		if( sha256_update(
+		     &( imaging_handle->sha256_context ),
+		     data,
+		     read_size,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update SHA256 digest hash.",
+			 function );
+
+			result = -1;
+		}
+	}
+	return( result );
 }
 
 /* Retrieves the chunk size
@@ -1721,6 +1938,84 @@ int imaging_handle_get_chunk_size(
 	return( 1 );
 }
 
+/* Sets the maximum number of threads used to process the chunks
+ * Returns 1 if successful or -1 on error
+ */
+int imaging_handle_set_maximum_number_of_threads(
+     imaging_handle_t *imaging_handle,
+     int maximum_number_of_threads,
+     liberror_error_t **error )
+{
+	static char *function = "imaging_handle_set_maximum_number_of_threads";
+
+	if( imaging_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( imaging_handle->output_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid imaging handle - missing output handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_V2_API )
+	if( libewf_handle_set_maximum_number_of_threads(
+	     imaging_handle->output_handle,
+	     maximum_number_of_threads,
+	     error ) != 1 )
+#else
+	if( libewf_set_maximum_number_of_threads(
+	     imaging_handle->output_handle,
+	     maximum_number_of_threads ) != 1 )
+#endif
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set maximum number of threads.",
+		 function );
+
+		return( -1 );
+	}
+	if( imaging_handle->secondary_output_handle != NULL )
+	{
+#if defined( HAVE_V2_API )
+		if( libewf_handle_set_maximum_number_of_threads(
+		     imaging_handle->secondary_output_handle,
+		     maximum_number_of_threads,
+		     error ) != 1 )
+#else
+		if( libewf_set_maximum_number_of_threads(
+		     imaging_handle->secondary_output_handle,
+		     maximum_number_of_threads ) != 1 )
+#endif
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set maximum number of threads of secondary output handle.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
 /* Retrieves the output values of the imaging handle
  * Returns 1 if successful or -1 on error
  */
@@ -3487,6 +3782,8 @@ ssize_t imaging_handle_finalize(
          size_t calculated_md5_hash_string_size,
          libsystem_character_t *calculated_sha1_hash_string,
          size_t calculated_sha1_hash_string_size,
+         libsystem_character_t *calculated_sha256_hash_string,
+         size_t calculated_sha256_hash_string_size,
          liberror_error_t **error )
 {
 #if defined( USE_LIBEWF_GET_MD5_HASH )
@@ -3495,12 +3792,14 @@ ssize_t imaging_handle_finalize(
 
 	digest_hash_t calculated_md5_hash[ DIGEST_HASH_SIZE_MD5 ];
 	digest_hash_t calculated_sha1_hash[ DIGEST_HASH_SIZE_SHA1 ];
+	digest_hash_t calculated_sha256_hash[ DIGEST_HASH_SIZE_SHA256 ];
 
-	static char *function            = "imaging_handle_finalize";
-	size_t calculated_md5_hash_size  = DIGEST_HASH_SIZE_MD5;
-	size_t calculated_sha1_hash_size = DIGEST_HASH_SIZE_SHA1;
-	ssize_t secondary_write_count    = 0;
-	ssize_t write_count              = 0;
+	static char *function              = "imaging_handle_finalize";
+	size_t calculated_md5_hash_size    = DIGEST_HASH_SIZE_MD5;
+	size_t calculated_sha1_hash_size   = DIGEST_HASH_SIZE_SHA1;
+	size_t calculated_sha256_hash_size = DIGEST_HASH_SIZE_SHA256;
+	ssize_t secondary_write_count      = 0;
+	ssize_t write_count                = 0;
 
 	if( imaging_handle == NULL )
 	{
@@ -3630,6 +3929,59 @@ ssize_t imaging_handle_finalize(
 			return( -1 );
 		}
 	}
+	if( imaging_handle->calculate_sha256 != 0 )
+	{
+		/* Finalize the SHA256 hash calculation
+		 */
+		if( sha256_finalize(
+		     &( imaging_handle->sha256_context ),
+		     calculated_sha256_hash,
+		     &calculated_sha256_hash_size,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize SHA256 hash.",
+			 function );
+
+			return( -1 );
+		}
+		if( digest_hash_copy_to_string(
+		     calculated_sha256_hash,
+		     calculated_sha256_hash_size,
+		     calculated_sha256_hash_string,
+		     calculated_sha256_hash_string_size,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create calculated SHA256 hash string.",
+			 function );
+
+			return( -1 );
+		}
+		if( imaging_handle_set_hash_value(
+		     imaging_handle,
+		     "SHA256",
+		     6,
+		     calculated_sha256_hash_string,
+		     calculated_sha256_hash_string_size - 1,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set hash value: SHA256.",
+			 function );
+
+			return( -1 );
+		}
+	}
 #if defined( HAVE_V2_API )
 	write_count = libewf_handle_write_finalize(
 	               imaging_handle->output_handle,
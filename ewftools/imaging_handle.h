@@ -41,8 +41,10 @@
 
 #include "digest_context.h"
 #include "digest_hash.h"
+#include "digest_thread.h"
 #include "md5.h"
 #include "sha1.h"
+#include "sha256.h"
 #include "storage_media_buffer.h"
 
 #if defined( __cplusplus )
@@ -61,6 +63,10 @@ struct imaging_handle
 	 */
 	uint8_t calculate_sha1;
 
+	/* Value to indicate if the SHA256 digest hash should be calculated
+	 */
+	uint8_t calculate_sha256;
+
 	/* The MD5 digest context
 	 */
 	md5_context_t md5_context;
@@ -69,6 +75,22 @@ struct imaging_handle
 	 */
 	sha1_context_t sha1_context;
 
+	/* The SHA256 digest context
+	 */
+	sha256_context_t sha256_context;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The thread that calculates the SHA1 digest hash
+	 * concurrently with the other digest hashes
+	 */
+	digest_thread_t *sha1_digest_thread;
+
+	/* The thread that calculates the SHA256 digest hash
+	 * concurrently with the other digest hashes
+	 */
+	digest_thread_t *sha256_digest_thread;
+#endif
+
 	/* The libewf output handle
 	 */
 	libewf_handle_t *output_handle;
@@ -86,6 +108,7 @@ int imaging_handle_initialize(
      imaging_handle_t **imaging_handle,
      uint8_t calculate_md5,
      uint8_t calculate_sha1,
+     uint8_t calculate_sha256,
      liberror_error_t **error );
 
 int imaging_handle_free(
@@ -161,6 +184,11 @@ int imaging_handle_get_chunk_size(
      size32_t *chunk_size,
      liberror_error_t **error );
 
+int imaging_handle_set_maximum_number_of_threads(
+     imaging_handle_t *imaging_handle,
+     int maximum_number_of_threads,
+     liberror_error_t **error );
+
 int imaging_handle_get_output_values(
      imaging_handle_t *imaging_handle,
      libsystem_character_t *case_number,
@@ -262,6 +290,8 @@ ssize_t imaging_handle_finalize(
          size_t calculated_md5_hash_string_size,
          libsystem_character_t *calculated_sha1_hash_string,
          size_t calculated_sha1_hash_string_size,
+         libsystem_character_t *calculated_sha256_hash_string,
+         size_t calculated_sha256_hash_string_size,
          liberror_error_t **error );
 
 int imaging_handle_acquiry_errors_fprint(
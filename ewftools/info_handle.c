@@ -352,13 +352,13 @@ int info_handle_open_input(
 	     info_handle->input_handle,
 	     filenames,
 	     amount_of_filenames,
-	     LIBEWF_OPEN_READ,
+	     LIBEWF_OPEN_READ_ON_DEMAND,
 	     error ) != 1 )
 #else
 	info_handle->input_handle = libewf_open_wide(
 	                             filenames,
 	                             amount_of_filenames,
-	                             LIBEWF_OPEN_READ );
+	                             LIBEWF_OPEN_READ_ON_DEMAND );
 
 	if( info_handle->input_handle == NULL )
 #endif
@@ -368,13 +368,13 @@ int info_handle_open_input(
 	     info_handle->input_handle,
 	     filenames,
 	     amount_of_filenames,
-	     LIBEWF_OPEN_READ,
+	     LIBEWF_OPEN_READ_ON_DEMAND,
 	     error ) != 1 )
 #else
 	info_handle->input_handle = libewf_open(
 	                             filenames,
 	                             amount_of_filenames,
-	                             LIBEWF_OPEN_READ );
+	                             LIBEWF_OPEN_READ_ON_DEMAND );
 
 	if( info_handle->input_handle == NULL )
 #endif
@@ -100,14 +100,14 @@ int storage_media_buffer_initialize(
 #if defined( HAVE_LOW_LEVEL_FUNCTIONS )
 			/* Add 4 bytes to allow for write CRC buffer alignment
 			 */
-			( *buffer )->raw_buffer = (uint8_t *) memory_allocate(
-			                                       sizeof( uint8_t ) * ( size + 4 ) );
+			( *buffer )->raw_buffer_allocation = (uint8_t *) memory_allocate(
+			                                                  sizeof( uint8_t ) * ( size + 4 + STORAGE_MEDIA_BUFFER_ALIGNMENT ) );
 #else
-			( *buffer )->raw_buffer = (uint8_t *) memory_allocate(
-			                                       sizeof( uint8_t ) * size );
+			( *buffer )->raw_buffer_allocation = (uint8_t *) memory_allocate(
+			                                                  sizeof( uint8_t ) * ( size + STORAGE_MEDIA_BUFFER_ALIGNMENT ) );
 #endif
 			
-			if( ( *buffer )->raw_buffer == NULL )
+			if( ( *buffer )->raw_buffer_allocation == NULL )
 			{
 				liberror_error_set(
 				 error,
@@ -123,6 +123,8 @@ int storage_media_buffer_initialize(
 
 				return( -1 );
 			}
+			( *buffer )->raw_buffer      = storage_media_buffer_align(
+			                                ( *buffer )->raw_buffer_allocation );
 			( *buffer )->raw_buffer_size = size;
 
 #if defined( HAVE_LOW_LEVEL_FUNCTIONS )
@@ -141,7 +143,7 @@ int storage_media_buffer_initialize(
 				 function );
 
 				memory_free(
-				 ( *buffer )->raw_buffer );
+				 ( *buffer )->raw_buffer_allocation );
 				memory_free(
 				 *buffer );
 
@@ -179,10 +181,10 @@ int storage_media_buffer_free(
 	}
 	if( *buffer != NULL )
 	{
-		if( ( *buffer )->raw_buffer != NULL )
+		if( ( *buffer )->raw_buffer_allocation != NULL )
 		{
 			memory_free(
-			 ( *buffer )->raw_buffer );
+			 ( *buffer )->raw_buffer_allocation );
 		}
 #if defined( HAVE_LOW_LEVEL_FUNCTIONS )
 		if( ( *buffer )->compression_buffer != NULL )
@@ -224,8 +226,8 @@ int storage_media_buffer_resize(
 	if( size > buffer->raw_buffer_size )
 	{
 		reallocation = memory_reallocate(
-				buffer->raw_buffer,
-				sizeof( uint8_t ) * size );
+				buffer->raw_buffer_allocation,
+				sizeof( uint8_t ) * ( size + STORAGE_MEDIA_BUFFER_ALIGNMENT ) );
 
 		if( reallocation == NULL )
 		{
@@ -238,9 +240,14 @@ int storage_media_buffer_resize(
 
 			return( -1 );
 		}
-		buffer->raw_buffer        = (uint8_t *) reallocation;
-		buffer->raw_buffer_size   = size;
-		buffer->raw_buffer_amount = 0;
+		/* The data is not preserved since the alignment within
+		 * the reallocated raw buffer can differ
+		 */
+		buffer->raw_buffer_allocation = (uint8_t *) reallocation;
+		buffer->raw_buffer            = storage_media_buffer_align(
+		                                 buffer->raw_buffer_allocation );
+		buffer->raw_buffer_size       = size;
+		buffer->raw_buffer_amount     = 0;
 
 #if defined( HAVE_LOW_LEVEL_FUNCTIONS )
 		/* The compression buffer is cleared
@@ -32,11 +32,25 @@
 extern "C" {
 #endif
 
+/* The alignment of the raw buffer, this allows the raw buffer
+ * to be used for direct (unbuffered) reads
+ */
+#define STORAGE_MEDIA_BUFFER_ALIGNMENT	4096
+
+/* Determines the first aligned byte within an allocated buffer
+ */
+#define storage_media_buffer_align( allocation ) \
+	&( ( allocation )[ ( STORAGE_MEDIA_BUFFER_ALIGNMENT - ( (intptr_t) ( allocation ) % STORAGE_MEDIA_BUFFER_ALIGNMENT ) ) % STORAGE_MEDIA_BUFFER_ALIGNMENT ] )
+
 typedef struct storage_media_buffer storage_media_buffer_t;
 
 struct storage_media_buffer
 {
-	/* The raw buffer
+	/* The allocated raw buffer
+	 */
+	uint8_t *raw_buffer_allocation;
+
+	/* The raw buffer, aligned within the allocated raw buffer
 	 */
 	uint8_t *raw_buffer;
 
@@ -0,0 +1,463 @@
+/*
+ * Storage media buffer queue
+ *
+ * Copyright (c) 2008-2009, Joachim Metz <forensics@hoffmannbv.nl>,
+ * Hoffmann Investigations.
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <thread.h>
+
+#include <liberror.h>
+
+#include "storage_media_buffer.h"
+#include "storage_media_buffer_queue.h"
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Initialize a queue
+ * Make sure the value queue is pointing to is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int storage_media_buffer_queue_initialize(
+     storage_media_buffer_queue_t **queue,
+     int maximum_amount_of_buffers,
+     liberror_error_t **error )
+{
+	static char *function = "storage_media_buffer_queue_initialize";
+
+	if( queue == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_amount_of_buffers <= 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum amount of buffers value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( *queue == NULL )
+	{
+		*queue = (storage_media_buffer_queue_t *) memory_allocate(
+		                                           sizeof( storage_media_buffer_queue_t ) );
+
+		if( *queue == NULL )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_MEMORY,
+			 LIBERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create queue.",
+			 function );
+
+			return( -1 );
+		}
+		if( memory_set(
+		     *queue,
+		     0,
+		     sizeof( storage_media_buffer_queue_t ) ) == NULL )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_MEMORY,
+			 LIBERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear queue.",
+			 function );
+
+			memory_free(
+			 *queue );
+
+			*queue = NULL;
+
+			return( -1 );
+		}
+		( *queue )->buffers = (storage_media_buffer_t **) memory_allocate(
+		                                                   sizeof( storage_media_buffer_t * ) * maximum_amount_of_buffers );
+
+		if( ( *queue )->buffers == NULL )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_MEMORY,
+			 LIBERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create buffers.",
+			 function );
+
+			memory_free(
+			 *queue );
+
+			*queue = NULL;
+
+			return( -1 );
+		}
+		( *queue )->maximum_amount_of_buffers = maximum_amount_of_buffers;
+
+		if( thread_mutex_initialize(
+		     &( ( *queue )->mutex ) ) != 0 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize mutex.",
+			 function );
+
+			memory_free(
+			 ( *queue )->buffers );
+			memory_free(
+			 *queue );
+
+			*queue = NULL;
+
+			return( -1 );
+		}
+		if( thread_condition_initialize(
+		     &( ( *queue )->pushed_condition ) ) != 0 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize pushed condition.",
+			 function );
+
+			thread_mutex_free(
+			 &( ( *queue )->mutex ) );
+			memory_free(
+			 ( *queue )->buffers );
+			memory_free(
+			 *queue );
+
+			*queue = NULL;
+
+			return( -1 );
+		}
+		if( thread_condition_initialize(
+		     &( ( *queue )->popped_condition ) ) != 0 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize popped condition.",
+			 function );
+
+			thread_condition_free(
+			 &( ( *queue )->pushed_condition ) );
+			thread_mutex_free(
+			 &( ( *queue )->mutex ) );
+			memory_free(
+			 ( *queue )->buffers );
+			memory_free(
+			 *queue );
+
+			*queue = NULL;
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Frees the queue
+ * The queued buffers are not freed
+ * Returns 1 if successful or -1 on error
+ */
+int storage_media_buffer_queue_free(
+     storage_media_buffer_queue_t **queue,
+     liberror_error_t **error )
+{
+	static char *function = "storage_media_buffer_queue_free";
+
+	if( queue == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( *queue != NULL )
+	{
+		thread_condition_free(
+		 &( ( *queue )->popped_condition ) );
+		thread_condition_free(
+		 &( ( *queue )->pushed_condition ) );
+		thread_mutex_free(
+		 &( ( *queue )->mutex ) );
+
+		memory_free(
+		 ( *queue )->buffers );
+		memory_free(
+		 *queue );
+
+		*queue = NULL;
+	}
+	return( 1 );
+}
+
+/* Pushes a buffer onto the end of the queue
+ * Blocks while the queue is full
+ * Returns 1 if successful, 0 if the queue was finished or -1 on error
+ */
+int storage_media_buffer_queue_push(
+     storage_media_buffer_queue_t *queue,
+     storage_media_buffer_t *buffer,
+     liberror_error_t **error )
+{
+	static char *function = "storage_media_buffer_queue_push";
+	int buffer_index      = 0;
+	int result            = 1;
+
+	if( queue == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( thread_mutex_grab(
+	     &( queue->mutex ) ) != 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( ( queue->is_finished == 0 )
+	    && ( queue->amount_of_buffers >= queue->maximum_amount_of_buffers ) )
+	{
+		thread_condition_wait(
+		 &( queue->popped_condition ),
+		 &( queue->mutex ) );
+	}
+	if( queue->is_finished != 0 )
+	{
+		result = 0;
+	}
+	else
+	{
+		buffer_index = queue->first_buffer + queue->amount_of_buffers;
+
+		if( buffer_index >= queue->maximum_amount_of_buffers )
+		{
+			buffer_index -= queue->maximum_amount_of_buffers;
+		}
+		queue->buffers[ buffer_index ] = buffer;
+
+		queue->amount_of_buffers += 1;
+
+		thread_condition_signal(
+		 &( queue->pushed_condition ) );
+	}
+	if( thread_mutex_release(
+	     &( queue->mutex ) ) != 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Pops a buffer from the front of the queue
+ * Blocks while the queue is empty and not finished
+ * Returns 1 if successful, 0 if the queue is finished and empty or -1 on error
+ */
+int storage_media_buffer_queue_pop(
+     storage_media_buffer_queue_t *queue,
+     storage_media_buffer_t **buffer,
+     liberror_error_t **error )
+{
+	static char *function = "storage_media_buffer_queue_pop";
+	int result            = 1;
+
+	if( queue == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( thread_mutex_grab(
+	     &( queue->mutex ) ) != 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( ( queue->is_finished == 0 )
+	    && ( queue->amount_of_buffers <= 0 ) )
+	{
+		thread_condition_wait(
+		 &( queue->pushed_condition ),
+		 &( queue->mutex ) );
+	}
+	if( queue->amount_of_buffers <= 0 )
+	{
+		*buffer = NULL;
+
+		result = 0;
+	}
+	else
+	{
+		*buffer = queue->buffers[ queue->first_buffer ];
+
+		queue->first_buffer += 1;
+
+		if( queue->first_buffer >= queue->maximum_amount_of_buffers )
+		{
+			queue->first_buffer = 0;
+		}
+		queue->amount_of_buffers -= 1;
+
+		thread_condition_signal(
+		 &( queue->popped_condition ) );
+	}
+	if( thread_mutex_release(
+	     &( queue->mutex ) ) != 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Marks the queue as finished
+ * Buffers that are still queued can be popped, no more buffers can be pushed
+ * Returns 1 if successful or -1 on error
+ */
+int storage_media_buffer_queue_finish(
+     storage_media_buffer_queue_t *queue,
+     liberror_error_t **error )
+{
+	static char *function = "storage_media_buffer_queue_finish";
+
+	if( queue == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( thread_mutex_grab(
+	     &( queue->mutex ) ) != 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	queue->is_finished = 1;
+
+	thread_condition_broadcast(
+	 &( queue->pushed_condition ) );
+	thread_condition_broadcast(
+	 &( queue->popped_condition ) );
+
+	if( thread_mutex_release(
+	     &( queue->mutex ) ) != 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#endif
+
@@ -0,0 +1,108 @@
+/*
+ * Storage media buffer queue
+ *
+ * Copyright (c) 2008-2009, Joachim Metz <forensics@hoffmannbv.nl>,
+ * Hoffmann Investigations.
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _STORAGE_MEDIA_BUFFER_QUEUE_H )
+#define _STORAGE_MEDIA_BUFFER_QUEUE_H
+
+#include <common.h>
+#include <thread.h>
+#include <types.h>
+
+#include <liberror.h>
+
+#include "storage_media_buffer.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+typedef struct storage_media_buffer_queue storage_media_buffer_queue_t;
+
+struct storage_media_buffer_queue
+{
+	/* Dynamic array of the queued buffers, used as a ring buffer
+	 * The queue does not own the buffers
+	 */
+	storage_media_buffer_t **buffers;
+
+	/* The maximum amount of buffers in the queue
+	 */
+	int maximum_amount_of_buffers;
+
+	/* The index of the first queued buffer
+	 */
+	int first_buffer;
+
+	/* The amount of queued buffers
+	 */
+	int amount_of_buffers;
+
+	/* Value to indicate no more buffers will be pushed
+	 */
+	uint8_t is_finished;
+
+	/* The mutex that protects the queue
+	 */
+	thread_mutex_t mutex;
+
+	/* The condition that signals a buffer was pushed
+	 */
+	thread_condition_t pushed_condition;
+
+	/* The condition that signals a buffer was popped
+	 */
+	thread_condition_t popped_condition;
+};
+
+int storage_media_buffer_queue_initialize(
+     storage_media_buffer_queue_t **queue,
+     int maximum_amount_of_buffers,
+     liberror_error_t **error );
+
+int storage_media_buffer_queue_free(
+     storage_media_buffer_queue_t **queue,
+     liberror_error_t **error );
+
+int storage_media_buffer_queue_push(
+     storage_media_buffer_queue_t *queue,
+     storage_media_buffer_t *buffer,
+     liberror_error_t **error );
+
+int storage_media_buffer_queue_pop(
+     storage_media_buffer_queue_t *queue,
+     storage_media_buffer_t **buffer,
+     liberror_error_t **error );
+
+int storage_media_buffer_queue_finish(
+     storage_media_buffer_queue_t *queue,
+     liberror_error_t **error );
+
+#endif
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif
+
@@ -41,10 +41,11 @@
 #include "digest_hash.h"
 #include "md5.h"
 #include "sha1.h"
+#include "sha256.h"
 #include "storage_media_buffer.h"
 #include "verification_handle.h"
 
-#define VERIFICATION_HANDLE_VALUE_SIZE			64
+#define VERIFICATION_HANDLE_VALUE_SIZE			128
 #define VERIFICATION_HANDLE_VALUE_IDENTIFIER_SIZE	32
 
 #if !defined( USE_LIBEWF_GET_HASH_VALUE_MD5 ) && !defined( USE_LIBEWF_GET_MD5_HASH )
@@ -58,6 +59,7 @@ int verification_handle_initialize(
      verification_handle_t **verification_handle,
      uint8_t calculate_md5,
      uint8_t calculate_sha1,
+     uint8_t calculate_sha256,
      liberror_error_t **error )
 {
 	static char *function = "verification_handle_initialize";
@@ -128,8 +130,9 @@ int verification_handle_initialize(
 			return( -1 );
 		}
 #endif
-		( *verification_handle )->calculate_md5  = calculate_md5;
-		( *verification_handle )->calculate_sha1 = calculate_sha1;
+		( *verification_handle )->calculate_md5    = calculate_md5;
+		( *verification_handle )->calculate_sha1   = calculate_sha1;
+		( *verification_handle )->calculate_sha256 = calculate_sha256;
 
 		if( ( ( *verification_handle )->calculate_md5 != 0 )
 		 && ( md5_initialize(
@@ -179,6 +182,96 @@ int verification_handle_initialize(
 
 			return( -1 );
 		}
+		if( ( ( *verification_handle )->calculate_sha256 != 0 )
+		 && ( sha256_initialize(
+		       &( ( *verification_handle )->sha256_context ),
+		       error ) != 1 ) )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize SHA256 context.",
+			 function );
+
+#if defined( HAVE_V2_API )
+			libewf_handle_free(
+			 &( ( *verification_handle )->input_handle ),
+			 NULL );
+#endif
+			memory_free(
+			 *verification_handle );
+
+			*verification_handle = NULL;
+
+			return( -1 );
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		/* The MD5 digest hash is calculated by the calling thread, if more than one
+		 * digest hash is calculated the other digest hashes get a thread of their own
+		 */
+		if( ( ( *verification_handle )->calculate_sha1 != 0 )
+		 && ( ( *verification_handle )->calculate_md5 != 0 )
+		 && ( digest_thread_initialize(
+		       &( ( *verification_handle )->sha1_digest_thread ),
+		       DIGEST_CONTEXT_TYPE_SHA1,
+		       (void *) &( ( *verification_handle )->sha1_context ),
+		       error ) != 1 ) )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize SHA1 digest thread.",
+			 function );
+
+#if defined( HAVE_V2_API )
+			libewf_handle_free(
+			 &( ( *verification_handle )->input_handle ),
+			 NULL );
+#endif
+			memory_free(
+			 *verification_handle );
+
+			*verification_handle = NULL;
+
+			return( -1 );
+		}
+		if( ( ( *verification_handle )->calculate_sha256 != 0 )
+		 && ( ( ( *verification_handle )->calculate_md5 != 0 )
+		  || ( ( *verification_handle )->calculate_sha1 != 0 ) )
+		 && ( digest_thread_initialize(
+		       &( ( *verification_handle )->sha256_digest_thread ),
+		       DIGEST_CONTEXT_TYPE_SHA256,
+		       (void *) &( ( *verification_handle )->sha256_context ),
+		       error ) != 1 ) )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize SHA256 digest thread.",
+			 function );
+
+			if( ( *verification_handle )->sha1_digest_thread != NULL )
+			{
+				digest_thread_free(
+				 &( ( *verification_handle )->sha1_digest_thread ),
+				 NULL );
+			}
+#if defined( HAVE_V2_API )
+			libewf_handle_free(
+			 &( ( *verification_handle )->input_handle ),
+			 NULL );
+#endif
+			memory_free(
+			 *verification_handle );
+
+			*verification_handle = NULL;
+
+			return( -1 );
+		}
+#endif
 	}
 	return( 1 );
 }
@@ -222,6 +315,36 @@ int verification_handle_free(
 			result = -1;
 		}
 #endif
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( ( *verification_handle )->sha1_digest_thread != NULL )
+		 && ( digest_thread_free(
+		       &( ( *verification_handle )->sha1_digest_thread ),
+		       error ) != 1 ) )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free SHA1 digest thread.",
+			 function );
+
+			result = -1;
+		}
+		if( ( ( *verification_handle )->sha256_digest_thread != NULL )
+		 && ( digest_thread_free(
+		       &( ( *verification_handle )->sha256_digest_thread ),
+		       error ) != 1 ) )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free SHA256 digest thread.",
+			 function );
+
+			result = -1;
+		}
+#endif
 		memory_free(
 		 *verification_handle );
 
@@ -275,12 +398,14 @@ int verification_handle_signal_abort(
 }
 
 /* Opens the input of the verification handle
+ * The segment file IO flags are combined with the read flag
  * Returns 1 if successful or -1 on error
  */
 int verification_handle_open_input(
      verification_handle_t *verification_handle,
      libsystem_character_t * const * filenames,
      int amount_of_filenames,
+     uint8_t segment_file_io_flags,
      liberror_error_t **error )
 {
 	libsystem_character_t **libewf_filenames = NULL;
@@ -406,13 +531,13 @@ int verification_handle_open_input(
 	     verification_handle->input_handle,
 	     filenames,
 	     amount_of_filenames,
-	     LIBEWF_OPEN_READ,
+	     LIBEWF_OPEN_READ | segment_file_io_flags,
 	     error ) != 1 )
 #else
 	verification_handle->input_handle = libewf_open_wide(
 	                                     filenames,
 	                                     amount_of_filenames,
-	                                     LIBEWF_OPEN_READ );
+	                                     LIBEWF_OPEN_READ | segment_file_io_flags );
 
 	if( verification_handle->input_handle == NULL )
 #endif
@@ -422,13 +547,13 @@ int verification_handle_open_input(
 	     verification_handle->input_handle,
 	     filenames,
 	     amount_of_filenames,
-	     LIBEWF_OPEN_READ,
+	     LIBEWF_OPEN_READ | segment_file_io_flags,
 	     error ) != 1 )
 #else
 	verification_handle->input_handle = libewf_open(
 	                                     filenames,
 	                                     amount_of_filenames,
-	                                     LIBEWF_OPEN_READ );
+	                                     LIBEWF_OPEN_READ | segment_file_io_flags );
 
 	if( verification_handle->input_handle == NULL )
 #endif
@@ -787,6 +912,7 @@ int verification_handle_update_integrity_hash(
 	uint8_t *data         = NULL;
 	static char *function = "verification_handle_update_integrity_hash";
 	size_t data_size      = 0;
+	int result            = 1;
 
 	if( verification_handle == NULL )
 	{
@@ -837,17 +963,56 @@ int verification_handle_update_integrity_hash(
 
 		return( -1 );
 	}
-	if( verification_handle->calculate_md5 != 0 )
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The digest threads calculate their digest hash while the calling thread
+	 * calculates the MD5 digest hash
+	 */
+	if( ( verification_handle->sha1_digest_thread != NULL )
+	 && ( digest_thread_start_update(
+	       verification_handle->sha1_digest_thread,
+	       data,
+	       read_size,
+	       error ) != 1 ) )
 	{
-		/* TODO check for return value */
-		md5_update(
-		 &( verification_handle->md5_context ),
-		 data,
-		 read_size,
-		 error );
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to start update of SHA1 digest hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( verification_handle->sha256_digest_thread != NULL )
+	 && ( digest_thread_start_update(
+	       verification_handle->sha256_digest_thread,
+	       data,
+	       read_size,
+	       error ) != 1 ) )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to start update of SHA256 digest hash.",
+		 function );
 
-		if( ( error != NULL )
-		 && ( *error != NULL ) )
+		if( verification_handle->sha1_digest_thread != NULL )
+		{
+			digest_thread_wait_for_update(
+			 verification_handle->sha1_digest_thread,
+			 NULL );
+		}
+		return( -1 );
+	}
+#endif
+	if( verification_handle->calculate_md5 != 0 )
+	{
+		if( md5_update(
+		     &( verification_handle->md5_context ),
+		     data,
+		     read_size,
+		     error ) != 1 )
 		{
 			liberror_error_set(
 			 error,
@@ -856,20 +1021,36 @@ int verification_handle_update_integrity_hash(
 			 "%s: unable to update MD5 digest hash.",
 			 function );
 
-			return( -1 );
+			result = -1;
 		}
 	}
-	if( verification_handle->calculate_sha1 != 0 )
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( verification_handle->sha1_digest_thread != NULL )
 	{
-		/* TODO check for return value */
-		sha1_update(
-		 &( verification_handle->sha1_context ),
-		 data,
-		 read_size,
-		 error );
+		if( digest_thread_wait_for_update(
+		     verification_handle->sha1_digest_thread,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update SHA1 digest hash.",
+			 function );
 
-		if( ( error != NULL )
-		 && ( *error != NULL ) )
+			result = -1;
+		}
+	}
+	else
+#endif
+	if( ( result == 1 )
+	 && ( verification_handle->calculate_sha1 != 0 ) )
+	{
+		if( sha1_update(
+		     &( verification_handle->sha1_context ),
+		     data,
+		     read_size,
+		     error ) != 1 )
 		{
 			liberror_error_set(
 			 error,
@@ -878,10 +1059,48 @@ int verification_handle_update_integrity_hash(
 			 "%s: unable to update SHA1 digest hash.",
 			 function );
 
-			return( -1 );
+			result = -1;
 		}
 	}
-	return( 1 );
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( verification_handle->sha256_digest_thread != NULL )
+	{
+		if( digest_thread_wait_for_update(
+		     verification_handle->sha256_digest_thread,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update SHA256 digest hash.",
+			 function );
+
+			result = -1;
+		}
+	}
+	else
+#endif
+	if( ( result == 1 )
+	 && ( verification_handle->calculate_sha256 != 0 ) )
+	{
+		if( sha256_update(
+		     &( verification_handle->sha256_context ),
+		     data,
+		     read_size,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update SHA256 digest hash.",
+			 function );
+
+			result = -1;
+		}
+	}
+	return( result );
 }
 
 /* Retrieves several verification values
@@ -1274,6 +1493,75 @@ int verification_handle_set_error_handling_values(
 	return( 1 );
 }
 
+/* Sets the maximum number of threads used to process the chunks
+ * More than one thread reads, checks and decompresses the chunks ahead concurrently
+ * while the integrity hashes are calculated over the chunks in order
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_set_maximum_number_of_threads(
+     verification_handle_t *verification_handle,
+     int maximum_number_of_threads,
+     liberror_error_t **error )
+{
+	static char *function = "verification_handle_set_maximum_number_of_threads";
+
+	if( verification_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->input_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid verification handle - missing input handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_number_of_threads <= 0 )
+	 || ( maximum_number_of_threads > LIBEWF_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_OUT_OF_RANGE,
+		 "%s: invalid maximum number of threads value out of range.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_V2_API )
+	if( libewf_handle_set_maximum_number_of_threads(
+	     verification_handle->input_handle,
+	     maximum_number_of_threads,
+	     error ) != 1 )
+#else
+	if( libewf_set_maximum_number_of_threads(
+	     verification_handle->input_handle,
+	     maximum_number_of_threads ) != 1 )
+#endif
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set maximum number of threads in input handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
 #if defined( HAVE_LOW_LEVEL_FUNCTIONS )
 
 /* Appends a read error to the output handle
@@ -1366,6 +1654,11 @@ int verification_handle_finalize(
      libsystem_character_t *stored_sha1_hash_string,
      size_t stored_sha1_hash_string_size,
      int *stored_sha1_hash_available,
+     libsystem_character_t *calculated_sha256_hash_string,
+     size_t calculated_sha256_hash_string_size,
+     libsystem_character_t *stored_sha256_hash_string,
+     size_t stored_sha256_hash_string_size,
+     int *stored_sha256_hash_available,
      liberror_error_t **error )
 {
 #if defined( USE_LIBEWF_GET_MD5_HASH )
@@ -1374,10 +1667,12 @@ int verification_handle_finalize(
 
 	digest_hash_t calculated_md5_hash[ DIGEST_HASH_SIZE_MD5 ];
 	digest_hash_t calculated_sha1_hash[ DIGEST_HASH_SIZE_SHA1 ];
+	digest_hash_t calculated_sha256_hash[ DIGEST_HASH_SIZE_SHA256 ];
 
-	static char *function            = "verification_handle_finalize";
-	size_t calculated_md5_hash_size  = DIGEST_HASH_SIZE_MD5;
-	size_t calculated_sha1_hash_size = DIGEST_HASH_SIZE_SHA1;
+	static char *function              = "verification_handle_finalize";
+	size_t calculated_md5_hash_size    = DIGEST_HASH_SIZE_MD5;
+	size_t calculated_sha1_hash_size   = DIGEST_HASH_SIZE_SHA1;
+	size_t calculated_sha256_hash_size = DIGEST_HASH_SIZE_SHA256;
 
 	if( verification_handle == NULL )
 	{
@@ -1403,7 +1698,8 @@ int verification_handle_finalize(
 	}
 #if !defined( HAVE_V2_API )
 #if defined( USE_LIBEWF_GET_MD5_HASH )
-	if( verification_handle->calculate_sha1 != 0 )
+	if( ( verification_handle->calculate_sha1 != 0 )
+	 || ( verification_handle->calculate_sha256 != 0 ) )
 	{
 		if( libewf_parse_hash_values(
 		     verification_handle->input_handle ) == -1 )
@@ -1607,6 +1903,72 @@ int verification_handle_finalize(
 			return( -1 );
 		}
 	}
+	if( verification_handle->calculate_sha256 != 0 )
+	{
+		/* Finalize the SHA256 hash calculation
+		 */
+		if( sha256_finalize(
+		     &( verification_handle->sha256_context ),
+		     calculated_sha256_hash,
+		     &calculated_sha256_hash_size,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize SHA256 hash.",
+			 function );
+
+			return( -1 );
+		}
+		if( digest_hash_copy_to_string(
+		     calculated_sha256_hash,
+		     calculated_sha256_hash_size,
+		     calculated_sha256_hash_string,
+		     calculated_sha256_hash_string_size,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create calculated SHA256 hash string.",
+			 function );
+
+			return( -1 );
+		}
+		if( stored_sha256_hash_available == NULL )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid stored SHA256 hash available value.",
+			 function );
+
+			return( -1 );
+		}
+		*stored_sha256_hash_available = verification_handle_get_hash_value(
+		                                 verification_handle,
+		                                 "SHA256",
+		                                 6,
+		                                 stored_sha256_hash_string,
+		                                 stored_sha256_hash_string_size,
+		                                 error );
+
+		if( *stored_sha256_hash_available == -1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine stored SHA256 hash string.",
+			 function );
+
+			return( -1 );
+		}
+	}
 	return( 1 );
 }
 
@@ -1775,6 +2137,14 @@ int verification_handle_additional_hash_values_fprint(
 		{
 			continue;
 		}
+		if( ( verification_handle->calculate_sha256 != 0 )
+		 && ( narrow_string_compare(
+		       hash_identifier,
+		       "SHA256",
+		       6 ) == 0 ) )
+		{
+			continue;
+		}
 		if( verification_handle_get_hash_value(
 		     verification_handle,
 		     hash_identifier,
@@ -41,8 +41,10 @@
 
 #include "digest_context.h"
 #include "digest_hash.h"
+#include "digest_thread.h"
 #include "md5.h"
 #include "sha1.h"
+#include "sha256.h"
 #include "storage_media_buffer.h"
 
 #if defined( __cplusplus )
@@ -61,6 +63,10 @@ struct verification_handle
 	 */
 	uint8_t calculate_sha1;
 
+	/* Value to indicate if the SHA256 digest hash should be calculated
+	 */
+	uint8_t calculate_sha256;
+
 	/* The MD5 digest context
 	 */
 	md5_context_t md5_context;
@@ -69,6 +75,22 @@ struct verification_handle
 	 */
 	sha1_context_t sha1_context;
 
+	/* The SHA256 digest context
+	 */
+	sha256_context_t sha256_context;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The thread that calculates the SHA1 digest hash
+	 * concurrently with the MD5 digest hash
+	 */
+	digest_thread_t *sha1_digest_thread;
+
+	/* The thread that calculates the SHA256 digest hash
+	 * concurrently with the MD5 digest hash
+	 */
+	digest_thread_t *sha256_digest_thread;
+#endif
+
 	/* The libewf input handle
 	 */
 	libewf_handle_t *input_handle;
@@ -94,6 +116,7 @@ int verification_handle_initialize(
      verification_handle_t **verification_handle,
      uint8_t calculate_md5,
      uint8_t calculate_sha1,
+     uint8_t calculate_sha256,
      liberror_error_t **error );
 
 int verification_handle_free(
@@ -108,6 +131,7 @@ int verification_handle_open_input(
      verification_handle_t *verification_handle,
      libsystem_character_t * const * filenames,
      int amount_of_filenames,
+     uint8_t segment_file_io_flags,
      liberror_error_t **error );
 
 int verification_handle_close(
@@ -160,6 +184,11 @@ int verification_handle_set_error_handling_values(
      int wipe_chunk_on_error,
      liberror_error_t **error );
 
+int verification_handle_set_maximum_number_of_threads(
+     verification_handle_t *verification_handle,
+     int maximum_number_of_threads,
+     liberror_error_t **error );
+
 int verification_handle_add_read_error(
       verification_handle_t *verification_handle,
       off64_t start_offset,
@@ -178,6 +207,11 @@ int verification_handle_finalize(
      libsystem_character_t *stored_sha1_hash_string,
      size_t stored_sha1_hash_string_size,
      int *stored_sha1_hash_available,
+     libsystem_character_t *calculated_sha256_hash_string,
+     size_t calculated_sha256_hash_string_size,
+     libsystem_character_t *stored_sha256_hash_string,
+     size_t stored_sha256_hash_string_size,
+     int *stored_sha256_hash_available,
      liberror_error_t **error );
 
 int verification_handle_additional_hash_values_fprint(
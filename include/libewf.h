@@ -184,6 +184,63 @@ LIBEWF_EXTERN int libewf_glob_free(
 #endif
 #endif
 
+#if 0 || defined( HAVE_V2_API )
+/* Retrieves the compression library used to compress and uncompress data
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_EXTERN int libewf_get_compression_library(
+                   int *compression_library,
+                   libewf_error_t **error );
+
+/* Sets the compression library used to compress and uncompress data
+ * libdeflate is only available if libewf was build with libdeflate support
+ * the value applies to all handles and must be set before a handle is opened
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_EXTERN int libewf_set_compression_library(
+                   int compression_library,
+                   libewf_error_t **error );
+#else
+/* Retrieves the compression library used to compress and uncompress data
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_EXTERN int libewf_get_compression_library(
+                   int *compression_library );
+
+/* Sets the compression library used to compress and uncompress data
+ * libdeflate is only available if libewf was build with libdeflate support
+ * the value applies to all handles and must be set before a handle is opened
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_EXTERN int libewf_set_compression_library(
+                   int compression_library );
+#endif
+
+#if 0 || defined( HAVE_V2_API )
+/* Runs a checksum or empty block kernel on a buffer
+ * The Adler-32 kernels continue the checksum in value
+ * the empty block kernels add 1 to value if the buffer is an empty block
+ * Returns 1 if successful, 0 if the kernel is not supported by the processor or -1 on error
+ */
+LIBEWF_EXTERN int libewf_run_kernel(
+                   int kernel,
+                   const uint8_t *buffer,
+                   size_t size,
+                   uint32_t *value,
+                   libewf_error_t **error );
+#else
+/* Runs a checksum or empty block kernel on a buffer
+ * The Adler-32 kernels continue the checksum in value
+ * the empty block kernels add 1 to value if the buffer is an empty block
+ * Returns 1 if successful, 0 if the kernel is not supported by the processor or -1 on error
+ */
+LIBEWF_EXTERN int libewf_run_kernel(
+                   int kernel,
+                   const uint8_t *buffer,
+                   size_t size,
+                   uint32_t *value );
+#endif
+
 /* -------------------------------------------------------------------------
  * Notify functions (APIv1)
  * ------------------------------------------------------------------------- */
@@ -374,6 +431,18 @@ LIBEWF_EXTERN ssize_t libewf_read_random(
                        size_t buffer_size,
                        off64_t offset );
 
+/* Determines if a range of the media data is empty
+ * The range is empty if the chunks it spans are known to contain zero bytes only
+ * Chunks that are not yet known to be empty are only read if their compressed size
+ * is small enough to be an empty block, hence uncompressed chunks are never empty
+ * This is not a full zero test, a range that is not empty can contain zero bytes only
+ * Returns 1 if the range is empty, 0 if not or -1 on error
+ */
+LIBEWF_EXTERN int libewf_is_empty_range(
+                   libewf_handle_t *handle,
+                   off64_t offset,
+                   size64_t size );
+
 /* Prepares a buffer with chunk data before writing according to the handle settings
  * intended for raw write
  * The buffer size cannot be larger than the chunk size
@@ -534,6 +603,22 @@ LIBEWF_EXTERN int libewf_set_delta_segment_file_size(
                    libewf_handle_t *handle,
                    size64_t delta_segment_file_size );
 
+/* Sets the maximum number of threads used to process chunks
+ * The value must be set before the first read or write
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_EXTERN int libewf_set_maximum_number_of_threads(
+                   libewf_handle_t *handle,
+                   int maximum_number_of_threads );
+
+/* Retrieves the statistics of the handle
+ * The size of the statistics must be set before the call
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_EXTERN int libewf_get_statistics(
+                   libewf_handle_t *handle,
+                   libewf_statistics_t *statistics );
+
 #endif
 
 /* -------------------------------------------------------------------------
@@ -675,6 +760,33 @@ LIBEWF_EXTERN ssize_t libewf_handle_read_random(
                        off64_t offset,
                        libewf_error_t **error );
 
+/* Reads media data from an offset into a buffer
+ * This function does not change the current offset and
+ * can be called by multiple threads on the same handle at the same time
+ * Returns the amount of bytes read or -1 on error
+ */
+LIBEWF_EXTERN ssize_t libewf_handle_read_buffer_at_offset(
+                       libewf_handle_t *handle,
+                       void *buffer,
+                       size_t buffer_size,
+                       off64_t offset,
+                       libewf_error_t **error );
+
+/* Determines if a range of the media data is empty
+ * The range is empty if the chunks it spans are known to contain zero bytes only
+ * Chunks that are not yet known to be empty are only read if their compressed size
+ * is small enough to be an empty block, hence uncompressed chunks are never empty
+ * This is not a full zero test, a range that is not empty can contain zero bytes only
+ * Chunks that are known to be empty are neither read nor decompressed
+ * This function does not change the current offset
+ * Returns 1 if the range is empty, 0 if not or -1 on error
+ */
+LIBEWF_EXTERN int libewf_handle_is_empty_range(
+                   libewf_handle_t *handle,
+                   off64_t offset,
+                   size64_t size,
+                   libewf_error_t **error );
+
 /* Prepares a buffer with chunk data before writing according to the handle settings
  * This function should be used before libewf_handle_write_chunk
  * The chunk buffer size should contain the actual chunk size
@@ -889,6 +1001,30 @@ LIBEWF_EXTERN int libewf_handle_set_delta_segment_file_size(
                    size64_t delta_segment_file_size,
                    libewf_error_t **error );
 
+/* Sets the filename of the offset table index file
+ * The index file is read when the handle is opened for reading
+ * and written if it does not correspond with the segment files
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_EXTERN int libewf_handle_set_index_filename(
+                   libewf_handle_t *handle,
+                   const char *filename,
+                   size_t filename_length,
+                   libewf_error_t **error );
+
+#if defined( LIBEWF_HAVE_WIDE_CHARACTER_TYPE )
+/* Sets the filename of the offset table index file
+ * The index file is read when the handle is opened for reading
+ * and written if it does not correspond with the segment files
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_EXTERN int libewf_handle_set_index_filename_wide(
+                   libewf_handle_t *handle,
+                   const wchar_t *filename,
+                   size_t filename_length,
+                   libewf_error_t **error );
+#endif
+
 /* Retrieves the filename size of the (delta) segment file of the current chunk
  * The filename size includes the end of string character
  * Returns 1 if successful or -1 on error
@@ -939,6 +1075,52 @@ LIBEWF_EXTERN int libewf_handle_get_file_io_handle(
                    libewf_error_t **error );
 #endif
 
+/* Retrieves the maximum amount of bytes used by the chunk cache
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_EXTERN int libewf_handle_get_maximum_cache_size(
+                   libewf_handle_t *handle,
+                   size_t *maximum_cache_size,
+                   libewf_error_t **error );
+
+/* Sets the maximum amount of bytes used by the chunk cache
+ * The chunk cache always holds at least a single chunk
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_EXTERN int libewf_handle_set_maximum_cache_size(
+                   libewf_handle_t *handle,
+                   size_t maximum_cache_size,
+                   libewf_error_t **error );
+
+/* Retrieves the maximum number of threads used to process chunks
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_EXTERN int libewf_handle_get_maximum_number_of_threads(
+                   libewf_handle_t *handle,
+                   int *maximum_number_of_threads,
+                   libewf_error_t **error );
+
+/* Sets the maximum number of threads used to process chunks
+ * More than one thread allows the chunks to be compressed in parallel on write
+ * and the chunks following a sequential read to be read ahead in parallel
+ * The value must be set before the first read or write
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_EXTERN int libewf_handle_set_maximum_number_of_threads(
+                   libewf_handle_t *handle,
+                   int maximum_number_of_threads,
+                   libewf_error_t **error );
+
+/* Retrieves the statistics of the handle
+ * The statistics are counted from the moment the handle is created
+ * the size of the statistics must be set before the call
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_EXTERN int libewf_handle_get_statistics(
+                   libewf_handle_t *handle,
+                   libewf_statistics_t *statistics,
+                   libewf_error_t **error );
+
 #endif
 
 /* -------------------------------------------------------------------------
@@ -0,0 +1,2361 @@
+/*
+ * Asynchronous file functions
+ *
+ * Copyright (c) 2006-2009, Joachim Metz <forensics@hoffmannbv.nl>,
+ * Hoffmann Investigations.
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <thread.h>
+#include <types.h>
+
+#include <liberror.h>
+
+#if defined( HAVE_ERRNO_H ) || defined( WINAPI )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "libbfio_async_file.h"
+#include "libbfio_definitions.h"
+#include "libbfio_error_string.h"
+#include "libbfio_file.h"
+#include "libbfio_handle.h"
+#include "libbfio_system_string.h"
+#include "libbfio_types.h"
+
+#if defined( HAVE_LIBBFIO_ASYNC_FILE_IO_URING )
+#include <sys/mman.h>
+#endif
+
+/* Initializes the asynchronous file IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int libbfio_async_file_io_handle_initialize(
+     libbfio_async_file_io_handle_t **async_file_io_handle,
+     liberror_error_t **error )
+{
+	static char *function = "libbfio_async_file_io_handle_initialize";
+
+	if( async_file_io_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid asynchronous file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *async_file_io_handle == NULL )
+	{
+		*async_file_io_handle = (libbfio_async_file_io_handle_t *) memory_allocate(
+		                                                            sizeof( libbfio_async_file_io_handle_t ) );
+
+		if( *async_file_io_handle == NULL )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_MEMORY,
+			 LIBERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create asynchronous file IO handle.",
+			 function );
+
+			return( -1 );
+		}
+		if( memory_set(
+		     *async_file_io_handle,
+		     0,
+		     sizeof( libbfio_async_file_io_handle_t ) ) == NULL )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_MEMORY,
+			 LIBERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear asynchronous file IO handle.",
+			 function );
+
+			memory_free(
+			 *async_file_io_handle );
+
+			*async_file_io_handle = NULL;
+
+			return( -1 );
+		}
+#if defined( WINAPI ) && !defined( USE_CRT_FUNCTIONS )
+		( *async_file_io_handle )->file_io_handle.file_handle     = INVALID_HANDLE_VALUE;
+#else
+		( *async_file_io_handle )->file_io_handle.file_descriptor = -1;
+#endif
+		( *async_file_io_handle )->engine                         = LIBBFIO_ASYNC_FILE_ENGINE_SYNCHRONOUS;
+		( *async_file_io_handle )->queue_depth                    = LIBBFIO_ASYNC_FILE_DEFAULT_QUEUE_DEPTH;
+
+#if defined( HAVE_LIBBFIO_ASYNC_FILE_IO_URING )
+		( *async_file_io_handle )->ring_file_descriptor           = -1;
+#endif
+	}
+	return( 1 );
+}
+
+/* Initializes the asynchronous file handle
+ * Returns 1 if successful or -1 on error
+ */
+int libbfio_async_file_initialize(
+      libbfio_handle_t **handle,
+      liberror_error_t **error )
+{
+	libbfio_async_file_io_handle_t *io_handle = NULL;
+	static char *function                     = "libbfio_async_file_initialize";
+
+	if( handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *handle == NULL )
+	{
+		if( libbfio_async_file_io_handle_initialize(
+		     &io_handle,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create handle.",
+			 function );
+
+			return( -1 );
+		}
+		/* The exists, is open and get size functions of the file handle
+		 * are used since the file IO handle is the first value
+		 */
+		if( libbfio_handle_initialize(
+		     handle,
+		     (intptr_t *) io_handle,
+		     libbfio_async_file_io_handle_free,
+		     libbfio_async_file_io_handle_clone,
+		     libbfio_async_file_open,
+		     libbfio_async_file_close,
+		     libbfio_async_file_read,
+		     libbfio_async_file_write,
+		     libbfio_async_file_seek_offset,
+		     libbfio_file_exists,
+		     libbfio_file_is_open,
+		     libbfio_file_get_size,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create handle.",
+			 function );
+
+			memory_free(
+			 io_handle );
+
+			return( -1 );
+		}
+#if defined( HAVE_LIBBFIO_FILE_AT_OFFSET )
+		/* The read and write at offset functions of the file handle
+		 * do not depend on the current offset and can be used directly
+		 */
+		if( libbfio_handle_set_at_offset_functions(
+		     *handle,
+		     libbfio_file_read_at_offset,
+		     libbfio_file_write_at_offset,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set at offset functions.",
+			 function );
+
+			libbfio_handle_free(
+			 handle,
+			 NULL );
+
+			return( -1 );
+		}
+#endif
+	}
+	return( 1 );
+}
+
+/* Frees the asynchronous file IO handle and its attributes
+ * Returns 1 if succesful or -1 on error
+ */
+int libbfio_async_file_io_handle_free(
+     intptr_t *io_handle,
+     liberror_error_t **error )
+{
+	static char *function = "libbfio_async_file_io_handle_free";
+	int result            = 1;
+
+	if( io_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_is_open(
+	     io_handle,
+	     NULL ) == 1 )
+	{
+		if( libbfio_async_file_close(
+		     io_handle,
+		     error ) != 0 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close asynchronous file IO handle.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( ( (libbfio_async_file_io_handle_t *) io_handle )->file_io_handle.name != NULL )
+	{
+		memory_free(
+		 ( (libbfio_async_file_io_handle_t *) io_handle )->file_io_handle.name );
+	}
+	memory_free(
+	 io_handle );
+
+	return( result );
+}
+
+/* Clones (duplicates) the asynchronous file IO handle and its attributes
+ * Returns 1 if succesful or -1 on error
+ */
+int libbfio_async_file_io_handle_clone(
+     intptr_t **destination_io_handle,
+     intptr_t *source_io_handle,
+     liberror_error_t **error )
+{
+	libbfio_async_file_io_handle_t *destination_async_file_io_handle = NULL;
+	libbfio_async_file_io_handle_t *source_async_file_io_handle      = NULL;
+	static char *function                                            = "libbfio_async_file_io_handle_clone";
+
+	if( destination_io_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid destination IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *destination_io_handle != NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: destination IO handle already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_io_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid source IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	source_async_file_io_handle = (libbfio_async_file_io_handle_t *) source_io_handle;
+
+	if( libbfio_async_file_io_handle_initialize(
+	     &destination_async_file_io_handle,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create handle.",
+		 function );
+
+		return( -1 );
+	}
+	destination_async_file_io_handle->queue_depth = source_async_file_io_handle->queue_depth;
+
+	if( source_async_file_io_handle->file_io_handle.name != NULL )
+	{
+		destination_async_file_io_handle->file_io_handle.name = (libbfio_system_character_t *) memory_allocate(
+		                                                                                        sizeof( libbfio_system_character_t ) * source_async_file_io_handle->file_io_handle.name_size );
+
+		if( destination_async_file_io_handle->file_io_handle.name == NULL )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_MEMORY,
+			 LIBERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create name.",
+			 function );
+
+			libbfio_async_file_io_handle_free(
+			 (intptr_t *) destination_async_file_io_handle,
+			 NULL );
+
+			return( -1 );
+		}
+		if( libbfio_system_string_copy(
+		     destination_async_file_io_handle->file_io_handle.name,
+		     source_async_file_io_handle->file_io_handle.name,
+		     source_async_file_io_handle->file_io_handle.name_size ) == NULL )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_MEMORY,
+			 LIBERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to set name.",
+			 function );
+
+			libbfio_async_file_io_handle_free(
+			 (intptr_t *) destination_async_file_io_handle,
+			 NULL );
+
+			return( -1 );
+		}
+		destination_async_file_io_handle->file_io_handle.name[ source_async_file_io_handle->file_io_handle.name_size - 1 ] = 0;
+
+		destination_async_file_io_handle->file_io_handle.name_size = source_async_file_io_handle->file_io_handle.name_size;
+	}
+	*destination_io_handle = (intptr_t *) destination_async_file_io_handle;
+
+	return( 1 );
+}
+
+/* Retrieves the queue depth
+ * Returns 1 if succesful or -1 on error
+ */
+int libbfio_async_file_get_queue_depth(
+     libbfio_handle_t *handle,
+     int *queue_depth,
+     liberror_error_t **error )
+{
+	libbfio_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libbfio_async_file_get_queue_depth";
+
+	if( handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libbfio_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( queue_depth == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid queue depth.",
+		 function );
+
+		return( -1 );
+	}
+	*queue_depth = ( (libbfio_async_file_io_handle_t *) internal_handle->io_handle )->queue_depth;
+
+	return( 1 );
+}
+
+/* Sets the queue depth, the maximum amount of reads in flight
+ * The queue depth can only be set when the file is not open
+ * Returns 1 if succesful or -1 on error
+ */
+int libbfio_async_file_set_queue_depth(
+     libbfio_handle_t *handle,
+     int queue_depth,
+     liberror_error_t **error )
+{
+	libbfio_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libbfio_async_file_set_queue_depth";
+
+	if( handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libbfio_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( queue_depth <= 0 )
+	 || ( queue_depth > LIBBFIO_ASYNC_FILE_MAXIMUM_QUEUE_DEPTH ) )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_OUT_OF_RANGE,
+		 "%s: invalid queue depth value out of range.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_is_open(
+	     internal_handle->io_handle,
+	     NULL ) == 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: queue depth cannot be changed while the file is open.",
+		 function );
+
+		return( -1 );
+	}
+	( (libbfio_async_file_io_handle_t *) internal_handle->io_handle )->queue_depth = queue_depth;
+
+	return( 1 );
+}
+
+/* Retrieves the engine used for the asynchronous reads
+ * The engine is determined when the file is opened
+ * Returns 1 if succesful or -1 on error
+ */
+int libbfio_async_file_get_engine(
+     libbfio_handle_t *handle,
+     int *engine,
+     liberror_error_t **error )
+{
+	libbfio_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libbfio_async_file_get_engine";
+
+	if( handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libbfio_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( engine == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid engine.",
+		 function );
+
+		return( -1 );
+	}
+	*engine = ( (libbfio_async_file_io_handle_t *) internal_handle->io_handle )->engine;
+
+	return( 1 );
+}
+
+/* Opens the asynchronous file handle
+ * The io_uring engine is used if supported by the system,
+ * otherwise the read threads or synchronous reads are used
+ * Returns 1 if successful or -1 on error
+ */
+int libbfio_async_file_open(
+     intptr_t *io_handle,
+     int flags,
+     liberror_error_t **error )
+{
+	libbfio_async_file_io_handle_t *async_file_io_handle = NULL;
+	static char *function                                = "libbfio_async_file_open";
+
+#if defined( HAVE_LIBBFIO_ASYNC_FILE_IO_URING )
+	int result                                           = 0;
+#endif
+
+	if( io_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	async_file_io_handle = (libbfio_async_file_io_handle_t *) io_handle;
+
+	if( async_file_io_handle->completed_reads != NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid IO handle - completed reads already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_open(
+	     io_handle,
+	     flags,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_IO,
+		 LIBERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file.",
+		 function );
+
+		return( -1 );
+	}
+	async_file_io_handle->completed_reads = (libbfio_async_read_t **) memory_allocate(
+	                                                                   sizeof( libbfio_async_read_t * ) * async_file_io_handle->queue_depth );
+
+	if( async_file_io_handle->completed_reads == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_MEMORY,
+		 LIBERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create completed reads.",
+		 function );
+
+		libbfio_file_close(
+		 io_handle,
+		 NULL );
+
+		return( -1 );
+	}
+	async_file_io_handle->current_offset            = 0;
+	async_file_io_handle->amount_of_pending_reads   = 0;
+	async_file_io_handle->first_completed_read      = 0;
+	async_file_io_handle->amount_of_completed_reads = 0;
+	async_file_io_handle->engine                    = LIBBFIO_ASYNC_FILE_ENGINE_SYNCHRONOUS;
+
+#if defined( HAVE_LIBBFIO_ASYNC_FILE_IO_URING )
+	result = libbfio_async_file_initialize_ring(
+	          async_file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize ring.",
+		 function );
+
+		libbfio_async_file_close(
+		 io_handle,
+		 NULL );
+
+		return( -1 );
+	}
+	else if( result == 1 )
+	{
+		async_file_io_handle->engine = LIBBFIO_ASYNC_FILE_ENGINE_IO_URING;
+	}
+#endif
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( async_file_io_handle->engine == LIBBFIO_ASYNC_FILE_ENGINE_SYNCHRONOUS )
+	{
+		if( libbfio_async_file_start_threads(
+		     async_file_io_handle,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to start read threads.",
+			 function );
+
+			libbfio_async_file_close(
+			 io_handle,
+			 NULL );
+
+			return( -1 );
+		}
+		async_file_io_handle->engine = LIBBFIO_ASYNC_FILE_ENGINE_THREADS;
+	}
+#endif
+	return( 1 );
+}
+
+/* Closes the asynchronous file handle
+ * Waits for the reads that are still pending
+ * Returns 0 if successful or -1 on error
+ */
+int libbfio_async_file_close(
+     intptr_t *io_handle,
+     liberror_error_t **error )
+{
+	libbfio_async_file_io_handle_t *async_file_io_handle = NULL;
+	static char *function                                = "libbfio_async_file_close";
+	int result                                           = 0;
+
+	if( io_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	async_file_io_handle = (libbfio_async_file_io_handle_t *) io_handle;
+
+	if( async_file_io_handle->amount_of_pending_reads > 0 )
+	{
+		if( libbfio_async_file_io_handle_wait_for_reads(
+		     async_file_io_handle,
+		     async_file_io_handle->amount_of_pending_reads,
+		     error ) == -1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to wait for pending reads.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBBFIO_ASYNC_FILE_IO_URING )
+	if( async_file_io_handle->engine == LIBBFIO_ASYNC_FILE_ENGINE_IO_URING )
+	{
+		if( libbfio_async_file_free_ring(
+		     async_file_io_handle,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free ring.",
+			 function );
+
+			result = -1;
+		}
+	}
+#endif
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( async_file_io_handle->read_threads != NULL )
+	{
+		if( libbfio_async_file_stop_threads(
+		     async_file_io_handle,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to stop read threads.",
+			 function );
+
+			result = -1;
+		}
+	}
+#endif
+	if( async_file_io_handle->completed_reads != NULL )
+	{
+		memory_free(
+		 async_file_io_handle->completed_reads );
+
+		async_file_io_handle->completed_reads = NULL;
+	}
+	async_file_io_handle->amount_of_pending_reads   = 0;
+	async_file_io_handle->amount_of_completed_reads = 0;
+	async_file_io_handle->engine                    = LIBBFIO_ASYNC_FILE_ENGINE_SYNCHRONOUS;
+
+	if( libbfio_file_close(
+	     io_handle,
+	     error ) != 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_IO,
+		 LIBERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file.",
+		 function );
+
+		result = -1;
+	}
+	return( result );
+}
+
+/* Reads a buffer from the asynchronous file handle at a specific offset
+ * The current offset is not changed
+ * This function is safe to call from the read threads
+ * Returns the amount of bytes read if successful, or -1 on errror
+ */
+ssize_t libbfio_async_file_read_at_offset(
+         libbfio_async_file_io_handle_t *async_file_io_handle,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         liberror_error_t **error )
+{
+	static char *function = "libbfio_async_file_read_at_offset";
+	ssize_t read_count    = 0;
+
+#if defined( WINAPI )
+	off64_t current_offset = 0;
+#else
+	libbfio_system_character_t error_string[ LIBBFIO_ERROR_STRING_DEFAULT_SIZE ];
+#endif
+
+	if( async_file_io_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid asynchronous file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( WINAPI )
+	/* There is no positional read, the file is only accessed
+	 * by the synchronous engine so the file offset can be restored
+	 */
+	current_offset = async_file_io_handle->current_offset;
+
+	if( libbfio_file_seek_offset(
+	     (intptr_t *) async_file_io_handle,
+	     offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_IO,
+		 LIBERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: %" PRIi64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	read_count = libbfio_file_read(
+	              (intptr_t *) async_file_io_handle,
+	              buffer,
+	              size,
+	              error );
+
+	if( read_count < 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_IO,
+		 LIBERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read from file.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_seek_offset(
+	     (intptr_t *) async_file_io_handle,
+	     current_offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_IO,
+		 LIBERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: %" PRIi64 ".",
+		 function,
+		 current_offset );
+
+		return( -1 );
+	}
+#else
+	if( async_file_io_handle->file_io_handle.file_descriptor == -1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid asynchronous file IO handle - invalid file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	read_count = pread(
+	              async_file_io_handle->file_io_handle.file_descriptor,
+	              (void *) buffer,
+	              size,
+	              (off_t) offset );
+
+	if( read_count < 0 )
+	{
+		if( libbfio_error_string_copy_from_error_number(
+		     error_string,
+		     LIBBFIO_ERROR_STRING_DEFAULT_SIZE,
+		     errno,
+		     NULL ) == 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read from file: %" PRIs_LIBBFIO_SYSTEM " at offset: %" PRIi64 " with error: %" PRIs_LIBBFIO_SYSTEM "",
+			 function,
+			 async_file_io_handle->file_io_handle.name,
+			 offset,
+			 error_string );
+		}
+		else
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read from file: %" PRIs_LIBBFIO_SYSTEM " at offset: %" PRIi64 ".",
+			 function,
+			 async_file_io_handle->file_io_handle.name,
+			 offset );
+		}
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
+/* Reads a buffer from the asynchronous file handle at the current offset
+ * Returns the amount of bytes read if successful, or -1 on errror
+ */
+ssize_t libbfio_async_file_read(
+         intptr_t *io_handle,
+         uint8_t *buffer,
+         size_t size,
+         liberror_error_t **error )
+{
+	libbfio_async_file_io_handle_t *async_file_io_handle = NULL;
+	static char *function                                = "libbfio_async_file_read";
+	ssize_t read_count                                   = 0;
+
+	if( io_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	async_file_io_handle = (libbfio_async_file_io_handle_t *) io_handle;
+
+#if defined( WINAPI )
+	read_count = libbfio_file_read(
+	              io_handle,
+	              buffer,
+	              size,
+	              error );
+#else
+	read_count = libbfio_async_file_read_at_offset(
+	              async_file_io_handle,
+	              buffer,
+	              size,
+	              async_file_io_handle->current_offset,
+	              error );
+#endif
+	if( read_count < 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_IO,
+		 LIBERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read from file.",
+		 function );
+
+		return( -1 );
+	}
+	async_file_io_handle->current_offset += (off64_t) read_count;
+
+	return( read_count );
+}
+
+/* Writes a buffer to the asynchronous file handle at the current offset
+ * Returns the amount of bytes written if successful, or -1 on errror
+ */
+ssize_t libbfio_async_file_write(
+         intptr_t *io_handle,
+         uint8_t *buffer,
+         size_t size,
+         liberror_error_t **error )
+{
+	libbfio_async_file_io_handle_t *async_file_io_handle = NULL;
+	static char *function                                = "libbfio_async_file_write";
+	ssize_t write_count                                  = 0;
+
+#if !defined( WINAPI )
+	libbfio_system_character_t error_string[ LIBBFIO_ERROR_STRING_DEFAULT_SIZE ];
+#endif
+
+	if( io_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	async_file_io_handle = (libbfio_async_file_io_handle_t *) io_handle;
+
+#if defined( WINAPI )
+	write_count = libbfio_file_write(
+	               io_handle,
+	               buffer,
+	               size,
+	               error );
+
+	if( write_count < 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_IO,
+		 LIBERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write to file.",
+		 function );
+
+		return( -1 );
+	}
+#else
+	if( async_file_io_handle->file_io_handle.file_descriptor == -1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - invalid file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	write_count = pwrite(
+	               async_file_io_handle->file_io_handle.file_descriptor,
+	               (void *) buffer,
+	               size,
+	               (off_t) async_file_io_handle->current_offset );
+
+	if( write_count < 0 )
+	{
+		if( libbfio_error_string_copy_from_error_number(
+		     error_string,
+		     LIBBFIO_ERROR_STRING_DEFAULT_SIZE,
+		     errno,
+		     NULL ) == 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write to file: %" PRIs_LIBBFIO_SYSTEM " with error: %" PRIs_LIBBFIO_SYSTEM "",
+			 function,
+			 async_file_io_handle->file_io_handle.name,
+			 error_string );
+		}
+		else
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write to file: %" PRIs_LIBBFIO_SYSTEM ".",
+			 function,
+			 async_file_io_handle->file_io_handle.name );
+		}
+		return( -1 );
+	}
+#endif
+	async_file_io_handle->current_offset += (off64_t) write_count;
+
+	return( write_count );
+}
+
+/* Seeks a certain offset within the asynchronous file handle
+ * Returns the offset if the seek is successful or -1 on error
+ */
+off64_t libbfio_async_file_seek_offset(
+         intptr_t *io_handle,
+         off64_t offset,
+         int whence,
+         liberror_error_t **error )
+{
+	libbfio_async_file_io_handle_t *async_file_io_handle = NULL;
+	static char *function                                = "libbfio_async_file_seek_offset";
+
+#if !defined( WINAPI )
+	size64_t file_size                                   = 0;
+#endif
+
+	if( io_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	async_file_io_handle = (libbfio_async_file_io_handle_t *) io_handle;
+
+#if defined( WINAPI )
+	offset = libbfio_file_seek_offset(
+	          io_handle,
+	          offset,
+	          whence,
+	          error );
+
+	if( offset == -1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_IO,
+		 LIBERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset in file.",
+		 function );
+
+		return( -1 );
+	}
+#else
+	/* The reads and writes are positional
+	 * so only the current offset needs to be maintained
+	 */
+	if( whence == SEEK_CUR )
+	{
+		offset += async_file_io_handle->current_offset;
+	}
+	else if( whence == SEEK_END )
+	{
+		if( libbfio_file_get_size(
+		     io_handle,
+		     &file_size,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve file size.",
+			 function );
+
+			return( -1 );
+		}
+		offset += (off64_t) file_size;
+	}
+	else if( whence != SEEK_SET )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported whence.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_OUT_OF_RANGE,
+		 "%s: invalid offset value out of range.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	async_file_io_handle->current_offset = offset;
+
+	return( offset );
+}
+
+#if defined( HAVE_LIBBFIO_ASYNC_FILE_IO_URING )
+
+/* Initializes the io_uring submission and completion queues
+ * Returns 1 if successful, 0 if io_uring is not supported by the system or -1 on error
+ */
+int libbfio_async_file_initialize_ring(
+     libbfio_async_file_io_handle_t *async_file_io_handle,
+     liberror_error_t **error )
+{
+	struct io_uring_params parameters;
+
+	void *mapped_memory   = NULL;
+	static char *function = "libbfio_async_file_initialize_ring";
+	int result            = 1;
+
+	if( async_file_io_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid asynchronous file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( async_file_io_handle->ring_file_descriptor != -1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid asynchronous file IO handle - ring already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     &parameters,
+	     0,
+	     sizeof( struct io_uring_params ) ) == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_MEMORY,
+		 LIBERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear ring parameters.",
+		 function );
+
+		return( -1 );
+	}
+	/* The system call fails if the kernel does not support io_uring
+	 * or if its use is restricted
+	 */
+	async_file_io_handle->ring_file_descriptor = (int) syscall(
+	                                                    __NR_io_uring_setup,
+	                                                    (unsigned int) async_file_io_handle->queue_depth,
+	                                                    &parameters );
+
+	if( async_file_io_handle->ring_file_descriptor < 0 )
+	{
+		async_file_io_handle->ring_file_descriptor = -1;
+
+		return( 0 );
+	}
+	/* The read operation requires Linux 5.6 or later
+	 * which also introduced the current position feature
+	 */
+	if( ( parameters.features & IORING_FEAT_RW_CUR_POS ) == 0 )
+	{
+		result = 0;
+	}
+	if( result == 1 )
+	{
+		async_file_io_handle->submission_ring_size = (size_t) parameters.sq_off.array
+		                                           + ( (size_t) parameters.sq_entries * sizeof( uint32_t ) );
+
+		async_file_io_handle->completion_ring_size = (size_t) parameters.cq_off.cqes
+		                                           + ( (size_t) parameters.cq_entries * sizeof( struct io_uring_cqe ) );
+
+		if( ( parameters.features & IORING_FEAT_SINGLE_MMAP ) != 0 )
+		{
+			if( async_file_io_handle->completion_ring_size > async_file_io_handle->submission_ring_size )
+			{
+				async_file_io_handle->submission_ring_size = async_file_io_handle->completion_ring_size;
+			}
+			async_file_io_handle->completion_ring_size = async_file_io_handle->submission_ring_size;
+		}
+		mapped_memory = mmap(
+		                 NULL,
+		                 async_file_io_handle->submission_ring_size,
+		                 PROT_READ | PROT_WRITE,
+		                 MAP_SHARED | MAP_POPULATE,
+		                 async_file_io_handle->ring_file_descriptor,
+		                 IORING_OFF_SQ_RING );
+
+		if( mapped_memory == MAP_FAILED )
+		{
+			result = 0;
+		}
+		else
+		{
+			async_file_io_handle->submission_ring = (uint8_t *) mapped_memory;
+		}
+	}
+	if( result == 1 )
+	{
+		if( ( parameters.features & IORING_FEAT_SINGLE_MMAP ) != 0 )
+		{
+			async_file_io_handle->completion_ring = async_file_io_handle->submission_ring;
+		}
+		else
+		{
+			mapped_memory = mmap(
+			                 NULL,
+			                 async_file_io_handle->completion_ring_size,
+			                 PROT_READ | PROT_WRITE,
+			                 MAP_SHARED | MAP_POPULATE,
+			                 async_file_io_handle->ring_file_descriptor,
+			                 IORING_OFF_CQ_RING );
+
+			if( mapped_memory == MAP_FAILED )
+			{
+				result = 0;
+			}
+			else
+			{
+				async_file_io_handle->completion_ring = (uint8_t *) mapped_memory;
+			}
+		}
+	}
+	if( result == 1 )
+	{
+		async_file_io_handle->submission_entries_size = (size_t) parameters.sq_entries * sizeof( struct io_uring_sqe );
+
+		mapped_memory = mmap(
+		                 NULL,
+		                 async_file_io_handle->submission_entries_size,
+		                 PROT_READ | PROT_WRITE,
+		                 MAP_SHARED | MAP_POPULATE,
+		                 async_file_io_handle->ring_file_descriptor,
+		                 IORING_OFF_SQES );
+
+		if( mapped_memory == MAP_FAILED )
+		{
+			result = 0;
+		}
+		else
+		{
+			async_file_io_handle->submission_entries = (struct io_uring_sqe *) mapped_memory;
+		}
+	}
+	if( result != 1 )
+	{
+		if( libbfio_async_file_free_ring(
+		     async_file_io_handle,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free ring.",
+			 function );
+
+			return( -1 );
+		}
+		return( 0 );
+	}
+	async_file_io_handle->submission_head      = (uint32_t *) &( async_file_io_handle->submission_ring[ parameters.sq_off.head ] );
+	async_file_io_handle->submission_tail      = (uint32_t *) &( async_file_io_handle->submission_ring[ parameters.sq_off.tail ] );
+	async_file_io_handle->submission_ring_mask = (uint32_t *) &( async_file_io_handle->submission_ring[ parameters.sq_off.ring_mask ] );
+	async_file_io_handle->submission_array     = (uint32_t *) &( async_file_io_handle->submission_ring[ parameters.sq_off.array ] );
+
+	async_file_io_handle->completion_head      = (uint32_t *) &( async_file_io_handle->completion_ring[ parameters.cq_off.head ] );
+	async_file_io_handle->completion_tail      = (uint32_t *) &( async_file_io_handle->completion_ring[ parameters.cq_off.tail ] );
+	async_file_io_handle->completion_ring_mask = (uint32_t *) &( async_file_io_handle->completion_ring[ parameters.cq_off.ring_mask ] );
+	async_file_io_handle->completion_entries   = (struct io_uring_cqe *) &( async_file_io_handle->completion_ring[ parameters.cq_off.cqes ] );
+
+	return( 1 );
+}
+
+/* Frees the io_uring submission and completion queues
+ * Returns 1 if successful or -1 on error
+ */
+int libbfio_async_file_free_ring(
+     libbfio_async_file_io_handle_t *async_file_io_handle,
+     liberror_error_t **error )
+{
+	static char *function = "libbfio_async_file_free_ring";
+	int result            = 1;
+
+	if( async_file_io_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid asynchronous file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( async_file_io_handle->submission_entries != NULL )
+	{
+		if( munmap(
+		     async_file_io_handle->submission_entries,
+		     async_file_io_handle->submission_entries_size ) != 0 )
+		{
+			result = -1;
+		}
+		async_file_io_handle->submission_entries = NULL;
+	}
+	if( ( async_file_io_handle->completion_ring != NULL )
+	 && ( async_file_io_handle->completion_ring != async_file_io_handle->submission_ring ) )
+	{
+		if( munmap(
+		     async_file_io_handle->completion_ring,
+		     async_file_io_handle->completion_ring_size ) != 0 )
+		{
+			result = -1;
+		}
+	}
+	async_file_io_handle->completion_ring = NULL;
+
+	if( async_file_io_handle->submission_ring != NULL )
+	{
+		if( munmap(
+		     async_file_io_handle->submission_ring,
+		     async_file_io_handle->submission_ring_size ) != 0 )
+		{
+			result = -1;
+		}
+		async_file_io_handle->submission_ring = NULL;
+	}
+	if( async_file_io_handle->ring_file_descriptor != -1 )
+	{
+		if( close(
+		     async_file_io_handle->ring_file_descriptor ) != 0 )
+		{
+			result = -1;
+		}
+		async_file_io_handle->ring_file_descriptor = -1;
+	}
+	if( result != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to unmap or close ring.",
+		 function );
+	}
+	return( result );
+}
+
+#endif
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Starts the read threads
+ * Returns 1 if successful or -1 on error
+ */
+int libbfio_async_file_start_threads(
+     libbfio_async_file_io_handle_t *async_file_io_handle,
+     liberror_error_t **error )
+{
+	static char *function       = "libbfio_async_file_start_threads";
+	int amount_of_read_threads  = 0;
+
+	if( async_file_io_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid asynchronous file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( async_file_io_handle->read_threads != NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid asynchronous file IO handle - read threads already set.",
+		 function );
+
+		return( -1 );
+	}
+	amount_of_read_threads = async_file_io_handle->queue_depth;
+
+	if( amount_of_read_threads > LIBBFIO_ASYNC_FILE_MAXIMUM_NUMBER_OF_READ_THREADS )
+	{
+		amount_of_read_threads = LIBBFIO_ASYNC_FILE_MAXIMUM_NUMBER_OF_READ_THREADS;
+	}
+	async_file_io_handle->queued_reads = (libbfio_async_read_t **) memory_allocate(
+	                                                                sizeof( libbfio_async_read_t * ) * async_file_io_handle->queue_depth );
+
+	if( async_file_io_handle->queued_reads == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_MEMORY,
+		 LIBERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create queued reads.",
+		 function );
+
+		return( -1 );
+	}
+	async_file_io_handle->read_threads = (thread_t *) memory_allocate(
+	                                                   sizeof( thread_t ) * amount_of_read_threads );
+
+	if( async_file_io_handle->read_threads == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_MEMORY,
+		 LIBERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create read threads.",
+		 function );
+
+		memory_free(
+		 async_file_io_handle->queued_reads );
+
+		async_file_io_handle->queued_reads = NULL;
+
+		return( -1 );
+	}
+	if( thread_mutex_initialize(
+	     &( async_file_io_handle->mutex ) ) != 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize mutex.",
+		 function );
+
+		memory_free(
+		 async_file_io_handle->read_threads );
+		memory_free(
+		 async_file_io_handle->queued_reads );
+
+		async_file_io_handle->read_threads = NULL;
+		async_file_io_handle->queued_reads = NULL;
+
+		return( -1 );
+	}
+	if( thread_condition_initialize(
+	     &( async_file_io_handle->queued_condition ) ) != 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize queued condition.",
+		 function );
+
+		thread_mutex_free(
+		 &( async_file_io_handle->mutex ) );
+
+		memory_free(
+		 async_file_io_handle->read_threads );
+		memory_free(
+		 async_file_io_handle->queued_reads );
+
+		async_file_io_handle->read_threads = NULL;
+		async_file_io_handle->queued_reads = NULL;
+
+		return( -1 );
+	}
+	if( thread_condition_initialize(
+	     &( async_file_io_handle->completed_condition ) ) != 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize completed condition.",
+		 function );
+
+		thread_condition_free(
+		 &( async_file_io_handle->queued_condition ) );
+		thread_mutex_free(
+		 &( async_file_io_handle->mutex ) );
+
+		memory_free(
+		 async_file_io_handle->read_threads );
+		memory_free(
+		 async_file_io_handle->queued_reads );
+
+		async_file_io_handle->read_threads = NULL;
+		async_file_io_handle->queued_reads = NULL;
+
+		return( -1 );
+	}
+	async_file_io_handle->first_queued_read      = 0;
+	async_file_io_handle->amount_of_queued_reads = 0;
+	async_file_io_handle->stop_threads           = 0;
+	async_file_io_handle->amount_of_read_threads = 0;
+
+	while( async_file_io_handle->amount_of_read_threads < amount_of_read_threads )
+	{
+		if( thread_create(
+		     &( async_file_io_handle->read_threads[ async_file_io_handle->amount_of_read_threads ] ),
+		     libbfio_async_file_read_thread,
+		     async_file_io_handle ) != 0 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create read thread: %d.",
+			 function,
+			 async_file_io_handle->amount_of_read_threads );
+
+			libbfio_async_file_stop_threads(
+			 async_file_io_handle,
+			 NULL );
+
+			return( -1 );
+		}
+		async_file_io_handle->amount_of_read_threads += 1;
+	}
+	return( 1 );
+}
+
+/* Stops the read threads
+ * The reads that are still queued are completed before the threads stop
+ * Returns 1 if successful or -1 on error
+ */
+int libbfio_async_file_stop_threads(
+     libbfio_async_file_io_handle_t *async_file_io_handle,
+     liberror_error_t **error )
+{
+	static char *function = "libbfio_async_file_stop_threads";
+	int result            = 1;
+	int thread_iterator   = 0;
+
+	if( async_file_io_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid asynchronous file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( async_file_io_handle->read_threads == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid asynchronous file IO handle - missing read threads.",
+		 function );
+
+		return( -1 );
+	}
+	thread_mutex_grab(
+	 &( async_file_io_handle->mutex ) );
+
+	async_file_io_handle->stop_threads = 1;
+
+	thread_condition_broadcast(
+	 &( async_file_io_handle->queued_condition ) );
+
+	thread_mutex_release(
+	 &( async_file_io_handle->mutex ) );
+
+	for( thread_iterator = 0;
+	     thread_iterator < async_file_io_handle->amount_of_read_threads;
+	     thread_iterator++ )
+	{
+		if( thread_join(
+		     async_file_io_handle->read_threads[ thread_iterator ] ) != 0 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join read thread: %d.",
+			 function,
+			 thread_iterator );
+
+			result = -1;
+		}
+	}
+	thread_condition_free(
+	 &( async_file_io_handle->completed_condition ) );
+	thread_condition_free(
+	 &( async_file_io_handle->queued_condition ) );
+	thread_mutex_free(
+	 &( async_file_io_handle->mutex ) );
+
+	memory_free(
+	 async_file_io_handle->read_threads );
+	memory_free(
+	 async_file_io_handle->queued_reads );
+
+	async_file_io_handle->read_threads           = NULL;
+	async_file_io_handle->amount_of_read_threads = 0;
+	async_file_io_handle->queued_reads           = NULL;
+	async_file_io_handle->amount_of_queued_reads = 0;
+
+	return( result );
+}
+
+/* The read thread function
+ * Reads the queued reads until the threads are stopped and the queue is empty
+ * Returns NULL
+ */
+void *libbfio_async_file_read_thread(
+       void *arguments )
+{
+	libbfio_async_file_io_handle_t *async_file_io_handle = NULL;
+	libbfio_async_read_t *read                           = NULL;
+	int completed_read_index                             = 0;
+
+	async_file_io_handle = (libbfio_async_file_io_handle_t *) arguments;
+
+	if( async_file_io_handle == NULL )
+	{
+		return( NULL );
+	}
+	while( 1 )
+	{
+		thread_mutex_grab(
+		 &( async_file_io_handle->mutex ) );
+
+		while( ( async_file_io_handle->amount_of_queued_reads == 0 )
+		    && ( async_file_io_handle->stop_threads == 0 ) )
+		{
+			thread_condition_wait(
+			 &( async_file_io_handle->queued_condition ),
+			 &( async_file_io_handle->mutex ) );
+		}
+		if( async_file_io_handle->amount_of_queued_reads == 0 )
+		{
+			thread_mutex_release(
+			 &( async_file_io_handle->mutex ) );
+
+			break;
+		}
+		read = async_file_io_handle->queued_reads[ async_file_io_handle->first_queued_read ];
+
+		async_file_io_handle->first_queued_read = ( async_file_io_handle->first_queued_read + 1 )
+		                                        % async_file_io_handle->queue_depth;
+
+		async_file_io_handle->amount_of_queued_reads -= 1;
+
+		thread_mutex_release(
+		 &( async_file_io_handle->mutex ) );
+
+		/* A failed read is reported by the read count
+		 */
+		read->read_count = libbfio_async_file_read_at_offset(
+		                    async_file_io_handle,
+		                    read->buffer,
+		                    read->size,
+		                    read->offset,
+		                    NULL );
+
+		thread_mutex_grab(
+		 &( async_file_io_handle->mutex ) );
+
+		completed_read_index = ( async_file_io_handle->first_completed_read + async_file_io_handle->amount_of_completed_reads )
+		                     % async_file_io_handle->queue_depth;
+
+		async_file_io_handle->completed_reads[ completed_read_index ] = read;
+
+		async_file_io_handle->amount_of_completed_reads += 1;
+
+		thread_condition_signal(
+		 &( async_file_io_handle->completed_condition ) );
+
+		thread_mutex_release(
+		 &( async_file_io_handle->mutex ) );
+	}
+	return( NULL );
+}
+
+#endif
+
+/* Submits positional reads to the asynchronous file IO handle
+ * The reads are submitted up to the queue depth
+ * Returns the amount of reads submitted or -1 on error
+ */
+int libbfio_async_file_io_handle_submit_reads(
+     libbfio_async_file_io_handle_t *async_file_io_handle,
+     libbfio_async_read_t **reads,
+     int amount_of_reads,
+     liberror_error_t **error )
+{
+	libbfio_async_read_t *read = NULL;
+	static char *function      = "libbfio_async_file_io_handle_submit_reads";
+	int completed_read_index   = 0;
+	int read_iterator          = 0;
+
+#if defined( HAVE_LIBBFIO_ASYNC_FILE_IO_URING )
+	struct io_uring_sqe *submission_entry = NULL;
+	uint32_t submission_index             = 0;
+	uint32_t submission_tail              = 0;
+	int amount_of_submitted_reads         = 0;
+	int result                            = 0;
+#endif
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	int queued_read_index                 = 0;
+#endif
+
+	if( async_file_io_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid asynchronous file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( async_file_io_handle->completed_reads == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid asynchronous file IO handle - file not open.",
+		 function );
+
+		return( -1 );
+	}
+	if( reads == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reads.",
+		 function );
+
+		return( -1 );
+	}
+	if( amount_of_reads < 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid amount of reads value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( amount_of_reads > ( async_file_io_handle->queue_depth - async_file_io_handle->amount_of_pending_reads ) )
+	{
+		amount_of_reads = async_file_io_handle->queue_depth - async_file_io_handle->amount_of_pending_reads;
+	}
+	for( read_iterator = 0;
+	     read_iterator < amount_of_reads;
+	     read_iterator++ )
+	{
+		read = reads[ read_iterator ];
+
+		if( ( read == NULL )
+		 || ( read->buffer == NULL ) )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid read: %d.",
+			 function,
+			 read_iterator );
+
+			return( -1 );
+		}
+		if( read->size > (size_t) SSIZE_MAX )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid read: %d size value exceeds maximum.",
+			 function,
+			 read_iterator );
+
+			return( -1 );
+		}
+		if( read->offset < 0 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+			 "%s: invalid read: %d offset value less than zero.",
+			 function,
+			 read_iterator );
+
+			return( -1 );
+		}
+		read->read_count   = 0;
+		read->is_completed = 0;
+	}
+	if( amount_of_reads == 0 )
+	{
+		return( 0 );
+	}
+#if defined( HAVE_LIBBFIO_ASYNC_FILE_IO_URING )
+	if( async_file_io_handle->engine == LIBBFIO_ASYNC_FILE_ENGINE_IO_URING )
+	{
+		/* Only this handle adds submission queue entries
+		 * so the tail does not need to be read atomically
+		 */
+		submission_tail = *( async_file_io_handle->submission_tail );
+
+		for( read_iterator = 0;
+		     read_iterator < amount_of_reads;
+		     read_iterator++ )
+		{
+			read             = reads[ read_iterator ];
+			submission_index = submission_tail & *( async_file_io_handle->submission_ring_mask );
+			submission_entry = &( async_file_io_handle->submission_entries[ submission_index ] );
+
+			if( memory_set(
+			     submission_entry,
+			     0,
+			     sizeof( struct io_uring_sqe ) ) == NULL )
+			{
+				liberror_error_set(
+				 error,
+				 LIBERROR_ERROR_DOMAIN_MEMORY,
+				 LIBERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to clear submission entry.",
+				 function );
+
+				return( -1 );
+			}
+			submission_entry->opcode    = IORING_OP_READ;
+			submission_entry->fd        = async_file_io_handle->file_io_handle.file_descriptor;
+			submission_entry->off       = (uint64_t) read->offset;
+			submission_entry->addr      = (uint64_t) (uintptr_t) read->buffer;
+			submission_entry->user_data = (uint64_t) (uintptr_t) read;
+
+			/* A larger read is completed as a short read
+			 */
+			if( read->size > (size_t) UINT32_MAX )
+			{
+				submission_entry->len = UINT32_MAX;
+			}
+			else
+			{
+				submission_entry->len = (uint32_t) read->size;
+			}
+			async_file_io_handle->submission_array[ submission_index ] = submission_index;
+
+			submission_tail++;
+		}
+		__atomic_store_n(
+		 async_file_io_handle->submission_tail,
+		 submission_tail,
+		 __ATOMIC_RELEASE );
+
+		while( amount_of_submitted_reads < amount_of_reads )
+		{
+			result = (int) syscall(
+			                __NR_io_uring_enter,
+			                async_file_io_handle->ring_file_descriptor,
+			                (unsigned int) ( amount_of_reads - amount_of_submitted_reads ),
+			                0,
+			                0,
+			                NULL,
+			                0 );
+
+			if( result < 0 )
+			{
+				if( errno == EINTR )
+				{
+					continue;
+				}
+				liberror_error_set(
+				 error,
+				 LIBERROR_ERROR_DOMAIN_IO,
+				 LIBERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to submit reads.",
+				 function );
+
+				return( -1 );
+			}
+			amount_of_submitted_reads += result;
+		}
+	}
+#endif
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( async_file_io_handle->engine == LIBBFIO_ASYNC_FILE_ENGINE_THREADS )
+	{
+		thread_mutex_grab(
+		 &( async_file_io_handle->mutex ) );
+
+		for( read_iterator = 0;
+		     read_iterator < amount_of_reads;
+		     read_iterator++ )
+		{
+			queued_read_index = ( async_file_io_handle->first_queued_read + async_file_io_handle->amount_of_queued_reads )
+			                  % async_file_io_handle->queue_depth;
+
+			async_file_io_handle->queued_reads[ queued_read_index ] = reads[ read_iterator ];
+
+			async_file_io_handle->amount_of_queued_reads += 1;
+		}
+		thread_condition_broadcast(
+		 &( async_file_io_handle->queued_condition ) );
+
+		thread_mutex_release(
+		 &( async_file_io_handle->mutex ) );
+	}
+#endif
+	if( async_file_io_handle->engine == LIBBFIO_ASYNC_FILE_ENGINE_SYNCHRONOUS )
+	{
+		for( read_iterator = 0;
+		     read_iterator < amount_of_reads;
+		     read_iterator++ )
+		{
+			read = reads[ read_iterator ];
+
+			/* A failed read is reported by the read count
+			 */
+			read->read_count = libbfio_async_file_read_at_offset(
+			                    async_file_io_handle,
+			                    read->buffer,
+			                    read->size,
+			                    read->offset,
+			                    NULL );
+
+			completed_read_index = ( async_file_io_handle->first_completed_read + async_file_io_handle->amount_of_completed_reads )
+			                     % async_file_io_handle->queue_depth;
+
+			async_file_io_handle->completed_reads[ completed_read_index ] = read;
+
+			async_file_io_handle->amount_of_completed_reads += 1;
+		}
+	}
+	async_file_io_handle->amount_of_pending_reads += amount_of_reads;
+
+	return( amount_of_reads );
+}
+
+/* Waits until at least a minimum amount of the submitted reads are completed
+ * The completed reads are marked as completed
+ * Returns the amount of reads completed or -1 on error
+ */
+int libbfio_async_file_io_handle_wait_for_reads(
+     libbfio_async_file_io_handle_t *async_file_io_handle,
+     int minimum_amount_of_reads,
+     liberror_error_t **error )
+{
+	libbfio_async_read_t *read      = NULL;
+	static char *function           = "libbfio_async_file_io_handle_wait_for_reads";
+	int amount_of_completed_reads   = 0;
+
+#if defined( HAVE_LIBBFIO_ASYNC_FILE_IO_URING )
+	struct io_uring_cqe *completion_entry = NULL;
+	uint32_t completion_head              = 0;
+	uint32_t completion_tail              = 0;
+	int result                            = 0;
+#endif
+
+	if( async_file_io_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid asynchronous file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( minimum_amount_of_reads < 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid minimum amount of reads value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( minimum_amount_of_reads > async_file_io_handle->amount_of_pending_reads )
+	{
+		minimum_amount_of_reads = async_file_io_handle->amount_of_pending_reads;
+	}
+#if defined( HAVE_LIBBFIO_ASYNC_FILE_IO_URING )
+	if( async_file_io_handle->engine == LIBBFIO_ASYNC_FILE_ENGINE_IO_URING )
+	{
+		while( async_file_io_handle->amount_of_pending_reads > 0 )
+		{
+			completion_head = *( async_file_io_handle->completion_head );
+			completion_tail = __atomic_load_n(
+			                   async_file_io_handle->completion_tail,
+			                   __ATOMIC_ACQUIRE );
+
+			while( completion_head != completion_tail )
+			{
+				completion_entry = &( async_file_io_handle->completion_entries[ completion_head & *( async_file_io_handle->completion_ring_mask ) ] );
+
+				read = (libbfio_async_read_t *) (uintptr_t) completion_entry->user_data;
+
+				if( completion_entry->res < 0 )
+				{
+					read->read_count = -1;
+				}
+				else
+				{
+					read->read_count = (ssize_t) completion_entry->res;
+				}
+				read->is_completed = 1;
+
+				async_file_io_handle->amount_of_pending_reads -= 1;
+
+				amount_of_completed_reads++;
+				completion_head++;
+			}
+			__atomic_store_n(
+			 async_file_io_handle->completion_head,
+			 completion_head,
+			 __ATOMIC_RELEASE );
+
+			if( amount_of_completed_reads >= minimum_amount_of_reads )
+			{
+				break;
+			}
+			result = (int) syscall(
+			                __NR_io_uring_enter,
+			                async_file_io_handle->ring_file_descriptor,
+			                0,
+			                (unsigned int) ( minimum_amount_of_reads - amount_of_completed_reads ),
+			                IORING_ENTER_GETEVENTS,
+			                NULL,
+			                0 );
+
+			if( ( result < 0 )
+			 && ( errno != EINTR ) )
+			{
+				liberror_error_set(
+				 error,
+				 LIBERROR_ERROR_DOMAIN_IO,
+				 LIBERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to wait for reads.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		return( amount_of_completed_reads );
+	}
+#endif
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( async_file_io_handle->engine == LIBBFIO_ASYNC_FILE_ENGINE_THREADS )
+	{
+		thread_mutex_grab(
+		 &( async_file_io_handle->mutex ) );
+
+		while( 1 )
+		{
+			while( async_file_io_handle->amount_of_completed_reads > 0 )
+			{
+				read = async_file_io_handle->completed_reads[ async_file_io_handle->first_completed_read ];
+
+				async_file_io_handle->first_completed_read = ( async_file_io_handle->first_completed_read + 1 )
+				                                           % async_file_io_handle->queue_depth;
+
+				async_file_io_handle->amount_of_completed_reads -= 1;
+				async_file_io_handle->amount_of_pending_reads   -= 1;
+
+				read->is_completed = 1;
+
+				amount_of_completed_reads++;
+			}
+			if( amount_of_completed_reads >= minimum_amount_of_reads )
+			{
+				break;
+			}
+			thread_condition_wait(
+			 &( async_file_io_handle->completed_condition ),
+			 &( async_file_io_handle->mutex ) );
+		}
+		thread_mutex_release(
+		 &( async_file_io_handle->mutex ) );
+
+		return( amount_of_completed_reads );
+	}
+#endif
+	/* The synchronous reads were completed when submitted
+	 */
+	while( async_file_io_handle->amount_of_completed_reads > 0 )
+	{
+		read = async_file_io_handle->completed_reads[ async_file_io_handle->first_completed_read ];
+
+		async_file_io_handle->first_completed_read = ( async_file_io_handle->first_completed_read + 1 )
+		                                           % async_file_io_handle->queue_depth;
+
+		async_file_io_handle->amount_of_completed_reads -= 1;
+		async_file_io_handle->amount_of_pending_reads   -= 1;
+
+		read->is_completed = 1;
+
+		amount_of_completed_reads++;
+	}
+	return( amount_of_completed_reads );
+}
+
+/* Submits positional reads to the asynchronous file handle
+ * The reads are submitted up to the queue depth, reads that are not
+ * submitted should be submitted again after waiting for completed reads
+ * Returns the amount of reads submitted or -1 on error
+ */
+int libbfio_async_file_submit_reads(
+     libbfio_handle_t *handle,
+     libbfio_async_read_t **reads,
+     int amount_of_reads,
+     liberror_error_t **error )
+{
+	libbfio_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libbfio_async_file_submit_reads";
+	int amount_of_submitted_reads              = 0;
+
+	if( handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libbfio_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	amount_of_submitted_reads = libbfio_async_file_io_handle_submit_reads(
+	                             (libbfio_async_file_io_handle_t *) internal_handle->io_handle,
+	                             reads,
+	                             amount_of_reads,
+	                             error );
+
+	if( amount_of_submitted_reads == -1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_IO,
+		 LIBERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to submit reads.",
+		 function );
+
+		return( -1 );
+	}
+	return( amount_of_submitted_reads );
+}
+
+/* Waits until at least a minimum amount of the submitted reads are completed
+ * Returns the amount of reads completed or -1 on error
+ */
+int libbfio_async_file_wait_for_reads(
+     libbfio_handle_t *handle,
+     int minimum_amount_of_reads,
+     liberror_error_t **error )
+{
+	libbfio_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libbfio_async_file_wait_for_reads";
+	int amount_of_completed_reads              = 0;
+
+	if( handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libbfio_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	amount_of_completed_reads = libbfio_async_file_io_handle_wait_for_reads(
+	                             (libbfio_async_file_io_handle_t *) internal_handle->io_handle,
+	                             minimum_amount_of_reads,
+	                             error );
+
+	if( amount_of_completed_reads == -1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_IO,
+		 LIBERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to wait for reads.",
+		 function );
+
+		return( -1 );
+	}
+	return( amount_of_completed_reads );
+}
+
@@ -0,0 +1,326 @@
+/*
+ * Asynchronous file functions
+ *
+ * Copyright (c) 2006-2009, Joachim Metz <forensics@hoffmannbv.nl>,
+ * Hoffmann Investigations.
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBBFIO_ASYNC_FILE_H )
+#define _LIBBFIO_ASYNC_FILE_H
+
+#include <common.h>
+#include <thread.h>
+#include <types.h>
+
+#include <liberror.h>
+
+#include "libbfio_extern.h"
+#include "libbfio_file.h"
+#include "libbfio_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The asynchronous reads are done using io_uring if available
+ */
+#if defined( HAVE_LINUX_IO_URING_H ) && defined( HAVE_SYS_MMAN_H ) && defined( HAVE_SYS_SYSCALL_H )
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+
+#if defined( __NR_io_uring_setup ) && defined( __NR_io_uring_enter ) && defined( IORING_FEAT_RW_CUR_POS )
+#define HAVE_LIBBFIO_ASYNC_FILE_IO_URING	1
+#endif
+#endif
+
+/* The asynchronous file engines
+ */
+enum LIBBFIO_ASYNC_FILE_ENGINES
+{
+	LIBBFIO_ASYNC_FILE_ENGINE_SYNCHRONOUS	= 0,
+	LIBBFIO_ASYNC_FILE_ENGINE_THREADS	= 1,
+	LIBBFIO_ASYNC_FILE_ENGINE_IO_URING	= 2
+};
+
+typedef struct libbfio_async_read libbfio_async_read_t;
+
+/* A positional read, the caller owns the read
+ * and must keep it unchanged until it is completed
+ */
+struct libbfio_async_read
+{
+	/* The buffer to read into
+	 */
+	uint8_t *buffer;
+
+	/* The size of the buffer
+	 */
+	size_t size;
+
+	/* The offset to read from
+	 */
+	off64_t offset;
+
+	/* The amount of bytes read or -1 on error
+	 * set when the read is completed
+	 */
+	ssize_t read_count;
+
+	/* Value to indicate the read is completed
+	 */
+	uint8_t is_completed;
+};
+
+typedef struct libbfio_async_file_io_handle libbfio_async_file_io_handle_t;
+
+struct libbfio_async_file_io_handle
+{
+	/* The file IO handle
+	 * this must be the first value, so the file functions
+	 * can be used to set the name and open the file
+	 */
+	libbfio_file_io_handle_t file_io_handle;
+
+	/* The current offset
+	 */
+	off64_t current_offset;
+
+	/* The engine used for the asynchronous reads
+	 */
+	int engine;
+
+	/* The maximum amount of reads in flight
+	 */
+	int queue_depth;
+
+	/* The amount of submitted reads that were not yet completed
+	 */
+	int amount_of_pending_reads;
+
+	/* The completed reads that were not yet returned, used as a ring buffer
+	 */
+	libbfio_async_read_t **completed_reads;
+
+	/* The index of the first completed read
+	 */
+	int first_completed_read;
+
+	/* The amount of completed reads
+	 */
+	int amount_of_completed_reads;
+
+#if defined( HAVE_LIBBFIO_ASYNC_FILE_IO_URING )
+	/* The io_uring file descriptor
+	 */
+	int ring_file_descriptor;
+
+	/* The mapped submission queue ring
+	 */
+	uint8_t *submission_ring;
+
+	/* The size of the mapped submission queue ring
+	 */
+	size_t submission_ring_size;
+
+	/* The mapped completion queue ring
+	 */
+	uint8_t *completion_ring;
+
+	/* The size of the mapped completion queue ring
+	 */
+	size_t completion_ring_size;
+
+	/* The mapped submission queue entries
+	 */
+	struct io_uring_sqe *submission_entries;
+
+	/* The size of the mapped submission queue entries
+	 */
+	size_t submission_entries_size;
+
+	/* References to the submission queue ring values
+	 */
+	uint32_t *submission_head;
+	uint32_t *submission_tail;
+	uint32_t *submission_ring_mask;
+	uint32_t *submission_array;
+
+	/* References to the completion queue ring values
+	 */
+	uint32_t *completion_head;
+	uint32_t *completion_tail;
+	uint32_t *completion_ring_mask;
+	struct io_uring_cqe *completion_entries;
+#endif
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The read threads
+	 */
+	thread_t *read_threads;
+
+	/* The amount of read threads
+	 */
+	int amount_of_read_threads;
+
+	/* The queued reads that were not yet started, used as a ring buffer
+	 */
+	libbfio_async_read_t **queued_reads;
+
+	/* The index of the first queued read
+	 */
+	int first_queued_read;
+
+	/* The amount of queued reads
+	 */
+	int amount_of_queued_reads;
+
+	/* Value to indicate the read threads should stop
+	 */
+	uint8_t stop_threads;
+
+	/* The mutex that protects the queued and completed reads
+	 */
+	thread_mutex_t mutex;
+
+	/* The condition that signals a read was queued
+	 */
+	thread_condition_t queued_condition;
+
+	/* The condition that signals a read was completed
+	 */
+	thread_condition_t completed_condition;
+#endif
+};
+
+int libbfio_async_file_io_handle_initialize(
+     libbfio_async_file_io_handle_t **async_file_io_handle,
+     liberror_error_t **error );
+
+LIBBFIO_EXTERN int libbfio_async_file_initialize(
+                    libbfio_handle_t **handle,
+                    liberror_error_t **error );
+
+int libbfio_async_file_io_handle_free(
+     intptr_t *io_handle,
+     liberror_error_t **error );
+
+int libbfio_async_file_io_handle_clone(
+     intptr_t **destination_io_handle,
+     intptr_t *source_io_handle,
+     liberror_error_t **error );
+
+LIBBFIO_EXTERN int libbfio_async_file_get_queue_depth(
+                    libbfio_handle_t *handle,
+                    int *queue_depth,
+                    liberror_error_t **error );
+
+LIBBFIO_EXTERN int libbfio_async_file_set_queue_depth(
+                    libbfio_handle_t *handle,
+                    int queue_depth,
+                    liberror_error_t **error );
+
+LIBBFIO_EXTERN int libbfio_async_file_get_engine(
+                    libbfio_handle_t *handle,
+                    int *engine,
+                    liberror_error_t **error );
+
+int libbfio_async_file_open(
+     intptr_t *io_handle,
+     int flags,
+     liberror_error_t **error );
+
+int libbfio_async_file_close(
+     intptr_t *io_handle,
+     liberror_error_t **error );
+
+ssize_t libbfio_async_file_read_at_offset(
+         libbfio_async_file_io_handle_t *async_file_io_handle,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         liberror_error_t **error );
+
+ssize_t libbfio_async_file_read(
+         intptr_t *io_handle,
+         uint8_t *buffer,
+         size_t size,
+         liberror_error_t **error );
+
+ssize_t libbfio_async_file_write(
+         intptr_t *io_handle,
+         uint8_t *buffer,
+         size_t size,
+         liberror_error_t **error );
+
+off64_t libbfio_async_file_seek_offset(
+         intptr_t *io_handle,
+         off64_t offset,
+         int whence,
+         liberror_error_t **error );
+
+#if defined( HAVE_LIBBFIO_ASYNC_FILE_IO_URING )
+int libbfio_async_file_initialize_ring(
+     libbfio_async_file_io_handle_t *async_file_io_handle,
+     liberror_error_t **error );
+
+int libbfio_async_file_free_ring(
+     libbfio_async_file_io_handle_t *async_file_io_handle,
+     liberror_error_t **error );
+#endif
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+int libbfio_async_file_start_threads(
+     libbfio_async_file_io_handle_t *async_file_io_handle,
+     liberror_error_t **error );
+
+int libbfio_async_file_stop_threads(
+     libbfio_async_file_io_handle_t *async_file_io_handle,
+     liberror_error_t **error );
+
+void *libbfio_async_file_read_thread(
+       void *arguments );
+#endif
+
+int libbfio_async_file_io_handle_submit_reads(
+     libbfio_async_file_io_handle_t *async_file_io_handle,
+     libbfio_async_read_t **reads,
+     int amount_of_reads,
+     liberror_error_t **error );
+
+int libbfio_async_file_io_handle_wait_for_reads(
+     libbfio_async_file_io_handle_t *async_file_io_handle,
+     int minimum_amount_of_reads,
+     liberror_error_t **error );
+
+LIBBFIO_EXTERN int libbfio_async_file_submit_reads(
+                    libbfio_handle_t *handle,
+                    libbfio_async_read_t **reads,
+                    int amount_of_reads,
+                    liberror_error_t **error );
+
+LIBBFIO_EXTERN int libbfio_async_file_wait_for_reads(
+                    libbfio_handle_t *handle,
+                    int minimum_amount_of_reads,
+                    liberror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif
+
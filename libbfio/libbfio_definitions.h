@@ -62,6 +62,16 @@
 
 #endif /* HAVE_LOCAL_LIBBFIO */
 
+/* The default and maximum amount of reads in flight of the asynchronous file handle
+ */
+#define LIBBFIO_ASYNC_FILE_DEFAULT_QUEUE_DEPTH			32
+#define LIBBFIO_ASYNC_FILE_MAXIMUM_QUEUE_DEPTH			4096
+
+/* The maximum number of threads used by the asynchronous file handle
+ * if io_uring is not available
+ */
+#define LIBBFIO_ASYNC_FILE_MAXIMUM_NUMBER_OF_READ_THREADS	8
+
 /* Platform specific macros
  */
 #if defined( _MSC_VER )
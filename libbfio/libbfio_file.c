@@ -190,6 +190,27 @@ int libbfio_file_initialize(
 
 			return( -1 );
 		}
+#if defined( HAVE_LIBBFIO_FILE_AT_OFFSET )
+		if( libbfio_handle_set_at_offset_functions(
+		     *handle,
+		     libbfio_file_read_at_offset,
+		     libbfio_file_write_at_offset,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set at offset functions.",
+			 function );
+
+			libbfio_handle_free(
+			 handle,
+			 NULL );
+
+			return( -1 );
+		}
+#endif
 	}
 	return( 1 );
 }
@@ -2166,6 +2187,260 @@ ssize_t libbfio_file_write(
 	return( write_count );
 }
 
+#if defined( HAVE_LIBBFIO_FILE_AT_OFFSET )
+
+/* Reads a buffer from the file handle at a specific offset
+ * The current offset of the file handle is not changed
+ * Returns the amount of bytes read if successful, or -1 on error
+ */
+ssize_t libbfio_file_read_at_offset(
+         intptr_t *io_handle,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         liberror_error_t **error )
+{
+	libbfio_system_character_t error_string[ LIBBFIO_ERROR_STRING_DEFAULT_SIZE ];
+
+	libbfio_file_io_handle_t *file_io_handle = NULL;
+	static char *function                    = "libbfio_file_read_at_offset";
+	ssize_t read_count                       = 0;
+
+	if( io_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	file_io_handle = (libbfio_file_io_handle_t *) io_handle;
+
+	if( file_io_handle->name == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - missing name.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->file_descriptor == -1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - invalid file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	read_count = pread(
+	              file_io_handle->file_descriptor,
+	              (void *) buffer,
+	              size,
+	              (off_t) offset );
+
+	if( read_count < 0 )
+	{
+		if( libbfio_error_string_copy_from_error_number(
+		     error_string,
+		     LIBBFIO_ERROR_STRING_DEFAULT_SIZE,
+		     errno,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read from file: %" PRIs_LIBBFIO_SYSTEM " at offset: %" PRIi64 " with error: %" PRIs_LIBBFIO_SYSTEM "",
+			 function,
+			 file_io_handle->name,
+			 offset,
+			 error_string );
+		}
+		else
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read from file: %" PRIs_LIBBFIO_SYSTEM " at offset: %" PRIi64 ".",
+			 function,
+			 file_io_handle->name,
+			 offset );
+		}
+		return( -1 );
+	}
+	return( read_count );
+}
+
+/* Writes a buffer to the file handle at a specific offset
+ * The current offset of the file handle is not changed
+ * Returns the amount of bytes written if successful, or -1 on errror
+ */
+ssize_t libbfio_file_write_at_offset(
+         intptr_t *io_handle,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         liberror_error_t **error )
+{
+	libbfio_system_character_t error_string[ LIBBFIO_ERROR_STRING_DEFAULT_SIZE ];
+
+	libbfio_file_io_handle_t *file_io_handle = NULL;
+	static char *function                    = "libbfio_file_write_at_offset";
+	ssize_t write_count                      = 0;
+
+	if( io_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	file_io_handle = (libbfio_file_io_handle_t *) io_handle;
+
+	if( file_io_handle->name == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - missing name.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->file_descriptor == -1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - invalid file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	write_count = pwrite(
+	               file_io_handle->file_descriptor,
+	               (void *) buffer,
+	               size,
+	               (off_t) offset );
+
+	if( write_count < 0 )
+	{
+		if( libbfio_error_string_copy_from_error_number(
+		     error_string,
+		     LIBBFIO_ERROR_STRING_DEFAULT_SIZE,
+		     errno,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write to file: %" PRIs_LIBBFIO_SYSTEM " at offset: %" PRIi64 " with error: %" PRIs_LIBBFIO_SYSTEM "",
+			 function,
+			 file_io_handle->name,
+			 offset,
+			 error_string );
+		}
+		else
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write to file: %" PRIs_LIBBFIO_SYSTEM " at offset: %" PRIi64 ".",
+			 function,
+			 file_io_handle->name,
+			 offset );
+		}
+		return( -1 );
+	}
+	return( write_count );
+}
+
+#endif
+
 #if defined( WINAPI ) && !defined( HAVE_SETFILEPOINTEREX )
 
 /* Cross Windows safe version of SetFilePointerEx
@@ -38,6 +38,12 @@
 extern "C" {
 #endif
 
+/* Reading and writing at a specific offset is done using pread and pwrite if available
+ */
+#if !defined( WINAPI ) && defined( HAVE_PREAD ) && defined( HAVE_PWRITE )
+#define HAVE_LIBBFIO_FILE_AT_OFFSET	1
+#endif
+
 typedef struct libbfio_file_io_handle libbfio_file_io_handle_t;
 
 struct libbfio_file_io_handle
@@ -139,6 +145,22 @@ ssize_t libbfio_file_write(
          size_t size,
          liberror_error_t **error );
 
+#if defined( HAVE_LIBBFIO_FILE_AT_OFFSET )
+ssize_t libbfio_file_read_at_offset(
+         intptr_t *io_handle,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         liberror_error_t **error );
+
+ssize_t libbfio_file_write_at_offset(
+         intptr_t *io_handle,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         liberror_error_t **error );
+#endif
+
 #if defined( WINAPI ) && !defined( HAVE_SETFILEPOINTEREX )
 BOOL SafeSetFilePointerEx(
       HANDLE file_handle,
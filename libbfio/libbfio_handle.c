@@ -107,7 +107,7 @@ int libbfio_handle_initialize(
 		internal_handle->is_open         = is_open;
 		internal_handle->get_size        = get_size;
 
-		if( libbfio_list_initialize(
+		if( libbfio_offset_list_initialize(
 		     &( internal_handle->offsets_read ),
 		     error ) != 1 )
 		{
@@ -154,6 +154,20 @@ int libbfio_handle_free(
 	{
 		internal_handle = (libbfio_internal_handle_t *) *handle;
 
+		if( ( internal_handle->write_buffer_data_size > 0 )
+		 && ( libbfio_handle_flush(
+		       *handle,
+		       error ) != 1 ) )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to flush write buffer.",
+			 function );
+
+			result = -1;
+		}
 		if( internal_handle->io_handle != NULL )
 		{
 			if( internal_handle->free_io_handle == NULL )
@@ -175,10 +189,14 @@ int libbfio_handle_free(
 				result = -1;
 			}
 		}
+		if( internal_handle->write_buffer != NULL )
+		{
+			memory_free(
+			 internal_handle->write_buffer );
+		}
 		if( ( internal_handle->offsets_read != NULL )
-		 && ( libbfio_list_free(
+		 && ( libbfio_offset_list_free(
 		       &( internal_handle->offsets_read ),
-		       &libbfio_offset_list_values_free,
 		       error ) != 1 ) )
 		{
 			liberror_error_set(
@@ -279,6 +297,22 @@ int libbfio_handle_clone(
 
 		return( -1 );
 	}
+	/* Make sure the buffered data is available to the destination handle
+	 */
+	if( ( internal_source_handle->write_buffer_data_size > 0 )
+	 && ( libbfio_handle_flush(
+	       source_handle,
+	       error ) != 1 ) )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_IO,
+		 LIBERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to flush write buffer of source handle.",
+		 function );
+
+		return( -1 );
+	}
 	if( internal_source_handle->clone_io_handle(
 	     &destination_io_handle,
 	     internal_source_handle->io_handle,
@@ -321,6 +355,27 @@ int libbfio_handle_clone(
 
 		return( -1 );
 	}
+	if( libbfio_handle_set_at_offset_functions(
+	     *destination_handle,
+	     internal_source_handle->read_at_offset,
+	     internal_source_handle->write_at_offset,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set at offset functions in destination handle.",
+		 function );
+
+		libbfio_handle_free(
+		 destination_handle,
+		 NULL );
+
+		return( -1 );
+	}
+	( (libbfio_internal_handle_t *) *destination_handle )->write_buffer_size = internal_source_handle->write_buffer_size;
+
 	if( libbfio_handle_open(
 	     *destination_handle,
 	     internal_source_handle->flags,
@@ -537,6 +592,22 @@ int libbfio_handle_reopen(
 	 */
 	if( internal_handle->flags != flags )
 	{
+		if( internal_handle->write_buffer_data_size > 0 )
+		{
+			if( libbfio_handle_flush(
+			     handle,
+			     error ) != 1 )
+			{
+				liberror_error_set(
+				 error,
+				 LIBERROR_ERROR_DOMAIN_IO,
+				 LIBERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to flush write buffer.",
+				 function );
+
+				return( -1 );
+			}
+		}
 		if( internal_handle->close(
 		     internal_handle->io_handle,
 		     error ) != 0 )
@@ -675,6 +746,22 @@ int libbfio_handle_close(
 			return( 0 );
 		}
 	}
+	if( internal_handle->write_buffer_data_size > 0 )
+	{
+		if( libbfio_handle_flush(
+		     handle,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to flush write buffer.",
+			 function );
+
+			return( -1 );
+		}
+	}
 	if( internal_handle->close(
 	     internal_handle->io_handle,
 	     error ) != 0 )
@@ -688,6 +775,16 @@ int libbfio_handle_close(
 
 		return( -1 );
 	}
+	/* The write buffer is freed on close, so that the buffers of
+	 * handles that are no longer written to do not remain allocated
+	 */
+	if( internal_handle->write_buffer != NULL )
+	{
+		memory_free(
+		 internal_handle->write_buffer );
+
+		internal_handle->write_buffer = NULL;
+	}
 	return( 0 );
 }
 
@@ -751,6 +848,22 @@ ssize_t libbfio_handle_read(
 
 		return( -1 );
 	}
+	if( internal_handle->write_buffer_data_size > 0 )
+	{
+		if( libbfio_handle_flush(
+		     handle,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to flush write buffer.",
+			 function );
+
+			return( -1 );
+		}
+	}
 	if( internal_handle->open_on_demand != 0 )
 	{
 		if( internal_handle->is_open == NULL )
@@ -972,6 +1085,71 @@ ssize_t libbfio_handle_write(
 
 		return( -1 );
 	}
+	if( internal_handle->write_buffer_size > 0 )
+	{
+		/* Flush the write buffer if the data does not fit
+		 */
+		if( ( internal_handle->write_buffer_data_size + size ) > internal_handle->write_buffer_size )
+		{
+			if( internal_handle->write_buffer_data_size > 0 )
+			{
+				if( libbfio_handle_flush(
+				     handle,
+				     error ) != 1 )
+				{
+					liberror_error_set(
+					 error,
+					 LIBERROR_ERROR_DOMAIN_IO,
+					 LIBERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to flush write buffer.",
+					 function );
+
+					return( -1 );
+				}
+			}
+		}
+		/* Data that fits in the write buffer is buffered
+		 * otherwise it is written directly
+		 */
+		if( size < internal_handle->write_buffer_size )
+		{
+			if( internal_handle->write_buffer == NULL )
+			{
+				internal_handle->write_buffer = (uint8_t *) memory_allocate(
+				                                             sizeof( uint8_t ) * internal_handle->write_buffer_size );
+
+				if( internal_handle->write_buffer == NULL )
+				{
+					liberror_error_set(
+					 error,
+					 LIBERROR_ERROR_DOMAIN_MEMORY,
+					 LIBERROR_MEMORY_ERROR_INSUFFICIENT,
+					 "%s: unable to create write buffer.",
+					 function );
+
+					return( -1 );
+				}
+			}
+			if( memory_copy(
+			     &( internal_handle->write_buffer[ internal_handle->write_buffer_data_size ] ),
+			     buffer,
+			     size ) == NULL )
+			{
+				liberror_error_set(
+				 error,
+				 LIBERROR_ERROR_DOMAIN_MEMORY,
+				 LIBERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy data to write buffer.",
+				 function );
+
+				return( -1 );
+			}
+			internal_handle->write_buffer_data_size += size;
+			internal_handle->offset                 += (off64_t) size;
+
+			return( (ssize_t) size );
+		}
+	}
 	write_count = internal_handle->write(
 	               internal_handle->io_handle,
 	               buffer,
@@ -994,17 +1172,21 @@ ssize_t libbfio_handle_write(
 	return( write_count );
 }
 
-/* Seeks a certain offset within the handle
- * Returns the offset if the seek is successful or -1 on error
+/* Reads a buffer from the handle at a specific offset
+ * The current offset of the handle is not changed
+ * Returns the amount of bytes read if successful, or -1 on error
  */
-off64_t libbfio_handle_seek_offset(
+ssize_t libbfio_handle_read_at_offset(
          libbfio_handle_t *handle,
+         uint8_t *buffer,
+         size_t size,
          off64_t offset,
-         int whence,
          liberror_error_t **error )
 {
 	libbfio_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libbfio_handle_seek_offset";
+	static char *function                      = "libbfio_handle_read_at_offset";
+	off64_t current_offset                     = 0;
+	ssize_t read_count                         = 0;
 	int is_open                                = 0;
 
 	if( handle == NULL )
@@ -1031,112 +1213,58 @@ off64_t libbfio_handle_seek_offset(
 
 		return( -1 );
 	}
-	if( internal_handle->seek_offset == NULL )
+	if( size > (size_t) SSIZE_MAX )
 	{
 		liberror_error_set(
 		 error,
-		 LIBERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing seek offset function.",
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( whence != SEEK_CUR )
-	 && ( whence != SEEK_END )
-	 && ( whence != SEEK_SET ) )
+	if( offset < 0 )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported whence.",
+		 LIBERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->offset != offset )
+	/* Buffered data must be written first since it can overlap
+	 */
+	if( internal_handle->write_buffer_data_size > 0 )
 	{
-		if( internal_handle->open_on_demand != 0 )
+		if( libbfio_handle_flush(
+		     handle,
+		     error ) != 1 )
 		{
-			if( internal_handle->is_open == NULL )
-			{
-				liberror_error_set(
-				 error,
-				 LIBERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
-				 "%s: invalid handle - missing is open function.",
-				 function );
-
-				return( -1 );
-			}
-			if( internal_handle->open == NULL )
-			{
-				liberror_error_set(
-				 error,
-				 LIBERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
-				 "%s: invalid handle - missing open function.",
-				 function );
-
-				return( -1 );
-			}
-			is_open = internal_handle->is_open(
-				   internal_handle->io_handle,
-				   error );
-
-			if( is_open == -1 )
-			{
-				liberror_error_set(
-				 error,
-				 LIBERROR_ERROR_DOMAIN_IO,
-				 LIBERROR_IO_ERROR_OPEN_FAILED,
-				 "%s: unable to determine if handle is open.",
-				 function );
-
-				return( -1 );
-			}
-			else if( is_open == 0 )
-			{
-				if( internal_handle->open(
-				     internal_handle->io_handle,
-				     internal_handle->flags,
-				     error ) != 1 )
-				{
-					liberror_error_set(
-					 error,
-					 LIBERROR_ERROR_DOMAIN_IO,
-					 LIBERROR_IO_ERROR_OPEN_FAILED,
-					 "%s: unable to open handle on demand.",
-					 function );
-
-					return( -1 );
-				}
-				if( internal_handle->seek_offset(
-				     internal_handle->io_handle,
-				     internal_handle->offset,
-				     SEEK_SET,
-				     error ) == -1 )
-				{
-					liberror_error_set(
-					 error,
-					 LIBERROR_ERROR_DOMAIN_IO,
-					 LIBERROR_IO_ERROR_SEEK_FAILED,
-					 "%s: unable to find current offset: %" PRIi64 " in handle.",
-					 function,
-					 internal_handle->offset );
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to flush write buffer.",
+			 function );
 
-					return( -1 );
-				}
-			}
+			return( -1 );
 		}
-		offset = internal_handle->seek_offset(
-			  internal_handle->io_handle,
-			  offset,
-			  whence,
-			  error );
+	}
+	/* If the IO handle cannot read at a specific offset
+	 * seek the offset, read and seek back to the current offset
+	 */
+	if( internal_handle->read_at_offset == NULL )
+	{
+		current_offset = internal_handle->offset;
 
-		if( offset == -1 )
+		if( libbfio_handle_seek_offset(
+		     handle,
+		     offset,
+		     SEEK_SET,
+		     error ) == -1 )
 		{
 			liberror_error_set(
 			 error,
@@ -1148,35 +1276,747 @@ off64_t libbfio_handle_seek_offset(
 
 			return( -1 );
 		}
-		internal_handle->offset = offset;
-	}
-	return( offset );
-}
+		read_count = libbfio_handle_read(
+		              handle,
+		              buffer,
+		              size,
+		              error );
 
-/* Function to determine if a file object exists
- * Return 1 if file object exists, 0 if not or -1 on error
- */
-int libbfio_handle_exists(
-     libbfio_handle_t *handle,
-     liberror_error_t **error )
-{
-	libbfio_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libbfio_handle_exists";
-	int result                                 = 0;
+		if( read_count < 0 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read from handle.",
+			 function );
 
-	if( handle == NULL )
-	{
-		liberror_error_set(
-		 error,
-		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
-		 function );
+			return( -1 );
+		}
+		if( libbfio_handle_seek_offset(
+		     handle,
+		     current_offset,
+		     SEEK_SET,
+		     error ) == -1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to find current offset: %" PRIi64 " in handle.",
+			 function,
+			 current_offset );
 
-		return( -1 );
+			return( -1 );
+		}
+		return( read_count );
 	}
-	internal_handle = (libbfio_internal_handle_t *) handle;
-
+	if( internal_handle->open_on_demand != 0 )
+	{
+		if( internal_handle->is_open == NULL )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid handle - missing is open function.",
+			 function );
+
+			return( -1 );
+		}
+		if( internal_handle->open == NULL )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid handle - missing open function.",
+			 function );
+
+			return( -1 );
+		}
+		is_open = internal_handle->is_open(
+			   internal_handle->io_handle,
+		           error );
+
+		if( is_open == -1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to determine if handle is open.",
+			 function );
+
+			return( -1 );
+		}
+		else if( is_open == 0 )
+		{
+			/* There is no need to seek the current offset after opening
+			 * since the read at offset function does not depend on it
+			 */
+			if( internal_handle->open(
+			     internal_handle->io_handle,
+			     internal_handle->flags,
+			     error ) != 1 )
+			{
+				liberror_error_set(
+				 error,
+				 LIBERROR_ERROR_DOMAIN_IO,
+				 LIBERROR_IO_ERROR_OPEN_FAILED,
+				 "%s: unable to open handle on demand.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
+	read_count = internal_handle->read_at_offset(
+	              internal_handle->io_handle,
+	              buffer,
+	              size,
+	              offset,
+	              error );
+
+	if( read_count < 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_IO,
+		 LIBERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read from handle at offset: %" PRIi64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	if( internal_handle->track_offsets_read != 0 )
+	{
+		if( internal_handle->offsets_read == NULL )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid handle - missing offsets read table.",
+			 function );
+
+			return( -1 );
+		}
+		if( libbfio_offset_list_add_offset(
+		     internal_handle->offsets_read,
+		     offset,
+		     read_count,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to add offset range to offsets read table.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( internal_handle->open_on_demand != 0 )
+	{
+		if( internal_handle->close == NULL )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid handle - missing close function.",
+			 function );
+
+			return( -1 );
+		}
+		if( internal_handle->close(
+		     internal_handle->io_handle,
+		     error ) != 0 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to close handle on demand.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( read_count );
+}
+
+/* Writes a buffer to the handle at a specific offset
+ * The current offset of the handle is not changed
+ * Returns the amount of bytes written if successful, or -1 on errror
+ */
+ssize_t libbfio_handle_write_at_offset(
+         libbfio_handle_t *handle,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         liberror_error_t **error )
+{
+	libbfio_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libbfio_handle_write_at_offset";
+	off64_t current_offset                     = 0;
+	ssize_t write_count                        = 0;
+	int is_open                                = 0;
+
+	if( handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libbfio_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	/* Buffered data must be written first since it can overlap
+	 */
+	if( internal_handle->write_buffer_data_size > 0 )
+	{
+		if( libbfio_handle_flush(
+		     handle,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to flush write buffer.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	/* If the IO handle cannot write at a specific offset
+	 * seek the offset, write and seek back to the current offset
+	 */
+	if( internal_handle->write_at_offset == NULL )
+	{
+		current_offset = internal_handle->offset;
+
+		if( libbfio_handle_seek_offset(
+		     handle,
+		     offset,
+		     SEEK_SET,
+		     error ) == -1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to find offset: %" PRIi64 " in handle.",
+			 function,
+			 offset );
+
+			return( -1 );
+		}
+		write_count = libbfio_handle_write(
+		               handle,
+		               buffer,
+		               size,
+		               error );
+
+		if( write_count < 0 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write to handle.",
+			 function );
+
+			return( -1 );
+		}
+		if( libbfio_handle_seek_offset(
+		     handle,
+		     current_offset,
+		     SEEK_SET,
+		     error ) == -1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to find current offset: %" PRIi64 " in handle.",
+			 function,
+			 current_offset );
+
+			return( -1 );
+		}
+		return( write_count );
+	}
+	if( internal_handle->open_on_demand != 0 )
+	{
+		if( internal_handle->is_open == NULL )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid handle - missing is open function.",
+			 function );
+
+			return( -1 );
+		}
+		if( internal_handle->open == NULL )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid handle - missing open function.",
+			 function );
+
+			return( -1 );
+		}
+		is_open = internal_handle->is_open(
+			   internal_handle->io_handle,
+		           error );
+
+		if( is_open == -1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to determine if handle is open.",
+			 function );
+
+			return( -1 );
+		}
+		else if( is_open == 0 )
+		{
+			/* There is no need to seek the current offset after opening
+			 * since the write at offset function does not depend on it
+			 */
+			if( internal_handle->open(
+			     internal_handle->io_handle,
+			     internal_handle->flags,
+			     error ) != 1 )
+			{
+				liberror_error_set(
+				 error,
+				 LIBERROR_ERROR_DOMAIN_IO,
+				 LIBERROR_IO_ERROR_OPEN_FAILED,
+				 "%s: unable to open handle on demand.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
+	write_count = internal_handle->write_at_offset(
+	               internal_handle->io_handle,
+	               buffer,
+	               size,
+	               offset,
+	               error );
+
+	if( write_count < 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_IO,
+		 LIBERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write to handle at offset: %" PRIi64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	if( internal_handle->open_on_demand != 0 )
+	{
+		if( internal_handle->close == NULL )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid handle - missing close function.",
+			 function );
+
+			return( -1 );
+		}
+		if( internal_handle->close(
+		     internal_handle->io_handle,
+		     error ) != 0 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to close handle on demand.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( write_count );
+}
+
+/* Writes the data in the write buffer to the handle
+ * Returns 1 if successful or -1 on error
+ */
+int libbfio_handle_flush(
+     libbfio_handle_t *handle,
+     liberror_error_t **error )
+{
+	libbfio_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libbfio_handle_flush";
+	size_t buffer_offset                       = 0;
+	ssize_t write_count                        = 0;
+
+	if( handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libbfio_internal_handle_t *) handle;
+
+	if( internal_handle->write_buffer_data_size == 0 )
+	{
+		return( 1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->write == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing write function.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->write_buffer == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing write buffer.",
+		 function );
+
+		return( -1 );
+	}
+	while( buffer_offset < internal_handle->write_buffer_data_size )
+	{
+		write_count = internal_handle->write(
+		               internal_handle->io_handle,
+		               &( internal_handle->write_buffer[ buffer_offset ] ),
+		               internal_handle->write_buffer_data_size - buffer_offset,
+		               error );
+
+		if( write_count <= 0 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write buffered data to handle.",
+			 function );
+
+			return( -1 );
+		}
+		buffer_offset += (size_t) write_count;
+	}
+	internal_handle->write_buffer_data_size = 0;
+
+	return( 1 );
+}
+
+/* Seeks a certain offset within the handle
+ * Returns the offset if the seek is successful or -1 on error
+ */
+off64_t libbfio_handle_seek_offset(
+         libbfio_handle_t *handle,
+         off64_t offset,
+         int whence,
+         liberror_error_t **error )
+{
+	libbfio_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libbfio_handle_seek_offset";
+	int is_open                                = 0;
+
+	if( handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libbfio_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->seek_offset == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing seek offset function.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( whence != SEEK_CUR )
+	 && ( whence != SEEK_END )
+	 && ( whence != SEEK_SET ) )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported whence.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->offset != offset )
+	{
+		if( internal_handle->write_buffer_data_size > 0 )
+		{
+			if( libbfio_handle_flush(
+			     handle,
+			     error ) != 1 )
+			{
+				liberror_error_set(
+				 error,
+				 LIBERROR_ERROR_DOMAIN_IO,
+				 LIBERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to flush write buffer.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		if( internal_handle->open_on_demand != 0 )
+		{
+			if( internal_handle->is_open == NULL )
+			{
+				liberror_error_set(
+				 error,
+				 LIBERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: invalid handle - missing is open function.",
+				 function );
+
+				return( -1 );
+			}
+			if( internal_handle->open == NULL )
+			{
+				liberror_error_set(
+				 error,
+				 LIBERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: invalid handle - missing open function.",
+				 function );
+
+				return( -1 );
+			}
+			is_open = internal_handle->is_open(
+				   internal_handle->io_handle,
+				   error );
+
+			if( is_open == -1 )
+			{
+				liberror_error_set(
+				 error,
+				 LIBERROR_ERROR_DOMAIN_IO,
+				 LIBERROR_IO_ERROR_OPEN_FAILED,
+				 "%s: unable to determine if handle is open.",
+				 function );
+
+				return( -1 );
+			}
+			else if( is_open == 0 )
+			{
+				if( internal_handle->open(
+				     internal_handle->io_handle,
+				     internal_handle->flags,
+				     error ) != 1 )
+				{
+					liberror_error_set(
+					 error,
+					 LIBERROR_ERROR_DOMAIN_IO,
+					 LIBERROR_IO_ERROR_OPEN_FAILED,
+					 "%s: unable to open handle on demand.",
+					 function );
+
+					return( -1 );
+				}
+				if( internal_handle->seek_offset(
+				     internal_handle->io_handle,
+				     internal_handle->offset,
+				     SEEK_SET,
+				     error ) == -1 )
+				{
+					liberror_error_set(
+					 error,
+					 LIBERROR_ERROR_DOMAIN_IO,
+					 LIBERROR_IO_ERROR_SEEK_FAILED,
+					 "%s: unable to find current offset: %" PRIi64 " in handle.",
+					 function,
+					 internal_handle->offset );
+
+					return( -1 );
+				}
+			}
+		}
+		offset = internal_handle->seek_offset(
+			  internal_handle->io_handle,
+			  offset,
+			  whence,
+			  error );
+
+		if( offset == -1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to find offset: %" PRIi64 " in handle.",
+			 function,
+			 offset );
+
+			return( -1 );
+		}
+		internal_handle->offset = offset;
+	}
+	return( offset );
+}
+
+/* Sets the functions to read and write at a specific offset
+ * These functions are optional, if not set reading and writing at an offset
+ * is done by seeking the offset and using the read and write functions
+ * Returns 1 if successful or -1 on error
+ */
+int libbfio_handle_set_at_offset_functions(
+     libbfio_handle_t *handle,
+     ssize_t (*read_at_offset)( intptr_t *io_handle, uint8_t *buffer, size_t size, off64_t offset, liberror_error_t **error ),
+     ssize_t (*write_at_offset)( intptr_t *io_handle, uint8_t *buffer, size_t size, off64_t offset, liberror_error_t **error ),
+     liberror_error_t **error )
+{
+	libbfio_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libbfio_handle_set_at_offset_functions";
+
+	if( handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libbfio_internal_handle_t *) handle;
+
+	internal_handle->read_at_offset  = read_at_offset;
+	internal_handle->write_at_offset = write_at_offset;
+
+	return( 1 );
+}
+
+/* Function to determine if a file object exists
+ * Return 1 if file object exists, 0 if not or -1 on error
+ */
+int libbfio_handle_exists(
+     libbfio_handle_t *handle,
+     liberror_error_t **error )
+{
+	libbfio_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libbfio_handle_exists";
+	int result                                 = 0;
+
+	if( handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libbfio_internal_handle_t *) handle;
+
 	if( internal_handle->io_handle == NULL )
 	{
 		liberror_error_set(
@@ -1281,6 +2121,44 @@ int libbfio_handle_is_open(
 	return( result );
 }
 
+/* Determines if the handle can be read at an offset by multiple threads at the same time
+ * This requires a positional read that does not change the state of the handle
+ * Returns 1 if the handle can be read concurrently, 0 if not or -1 on error
+ */
+int libbfio_handle_can_read_at_offset_concurrently(
+     libbfio_handle_t *handle,
+     liberror_error_t **error )
+{
+	libbfio_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libbfio_handle_can_read_at_offset_concurrently";
+
+	if( handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libbfio_internal_handle_t *) handle;
+
+	/* Without a read at offset function the read requires a seek,
+	 * on demand opening and tracking the offsets read modify the handle
+	 * and a handle opened for writing can have buffered data
+	 */
+	if( ( internal_handle->read_at_offset == NULL )
+	 || ( internal_handle->open_on_demand != 0 )
+	 || ( internal_handle->track_offsets_read != 0 )
+	 || ( ( internal_handle->flags & LIBBFIO_FLAG_WRITE ) != 0 ) )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
 /* Retrieves the flags
  * Returns 1 if successful or -1 on error
  */
@@ -1410,6 +2288,22 @@ int libbfio_handle_get_size(
 	}
 	if( internal_handle->size_set == 0 )
 	{
+		if( internal_handle->write_buffer_data_size > 0 )
+		{
+			if( libbfio_handle_flush(
+			     handle,
+			     error ) != 1 )
+			{
+				liberror_error_set(
+				 error,
+				 LIBERROR_ERROR_DOMAIN_IO,
+				 LIBERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to flush write buffer.",
+				 function );
+
+				return( -1 );
+			}
+		}
 		if( internal_handle->get_size == NULL )
 		{
 			liberror_error_set(
@@ -1525,6 +2419,114 @@ int libbfio_handle_set_open_on_demand(
 	return( 1 );
 }
 
+/* Retrieves the write buffer size
+ * Returns 1 if successful or -1 on error
+ */
+int libbfio_handle_get_write_buffer_size(
+     libbfio_handle_t *handle,
+     size_t *write_buffer_size,
+     liberror_error_t **error )
+{
+	libbfio_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libbfio_handle_get_write_buffer_size";
+
+	if( handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libbfio_internal_handle_t *) handle;
+
+	if( write_buffer_size == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write buffer size.",
+		 function );
+
+		return( -1 );
+	}
+	*write_buffer_size = internal_handle->write_buffer_size;
+
+	return( 1 );
+}
+
+/* Sets the write buffer size
+ * Writes smaller than the write buffer size are combined in the write buffer
+ * and written when the buffer is full, the handle is flushed, read, seeked or closed
+ * A size of 0 disables the write buffer
+ * Returns 1 if successful or -1 on error
+ */
+int libbfio_handle_set_write_buffer_size(
+     libbfio_handle_t *handle,
+     size_t write_buffer_size,
+     liberror_error_t **error )
+{
+	libbfio_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libbfio_handle_set_write_buffer_size";
+
+	if( handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libbfio_internal_handle_t *) handle;
+
+	if( write_buffer_size > (size_t) SSIZE_MAX )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid write buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->write_buffer_size != write_buffer_size )
+	{
+		if( internal_handle->write_buffer_data_size > 0 )
+		{
+			if( libbfio_handle_flush(
+			     handle,
+			     error ) != 1 )
+			{
+				liberror_error_set(
+				 error,
+				 LIBERROR_ERROR_DOMAIN_IO,
+				 LIBERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to flush write buffer.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		if( internal_handle->write_buffer != NULL )
+		{
+			memory_free(
+			 internal_handle->write_buffer );
+
+			internal_handle->write_buffer = NULL;
+		}
+		internal_handle->write_buffer_size = write_buffer_size;
+	}
+	return( 1 );
+}
+
 /* Set the value to have the library track the offsets read
  * 0 disables tracking any other value enables it
  * Returns 1 if successful or -1 on error
@@ -1612,8 +2614,20 @@ int libbfio_handle_get_amount_of_offsets_read(
 
 		return( -1 );
 	}
-	*amount_of_read_offsets = internal_handle->offsets_read->amount_of_elements;
+	if( libbfio_offset_list_get_amount_of_offsets(
+	     internal_handle->offsets_read,
+	     amount_of_read_offsets,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve amount of offsets.",
+		 function );
 
+		return( -1 );
+	}
 	return( 1 );
 }
 
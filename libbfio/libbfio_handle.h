@@ -30,6 +30,7 @@
 
 #include "libbfio_extern.h"
 #include "libbfio_list_type.h"
+#include "libbfio_offset_list.h"
 #include "libbfio_types.h"
 
 #if defined( __cplusplus )
@@ -75,7 +76,20 @@ struct libbfio_internal_handle
 
 	/* The offset ranges that were read
 	 */
-	libbfio_list_t *offsets_read;
+	libbfio_offset_list_t *offsets_read;
+
+	/* The write buffer, used to combine small writes into larger writes
+	 */
+	uint8_t *write_buffer;
+
+	/* The size of the write buffer
+	 * 0 if writes are not buffered
+	 */
+	size_t write_buffer_size;
+
+	/* The amount of data in the write buffer
+	 */
+	size_t write_buffer_data_size;
 
 	/* The free io handle function
 	 */
@@ -146,6 +160,25 @@ struct libbfio_internal_handle
 	       size64_t *size,
 	       liberror_error_t **error );
 
+	/* The read at offset function
+	 * NULL if the IO handle only supports reading at the current offset
+	 */
+	ssize_t (*read_at_offset)(
+	           intptr_t *io_handle,
+	           uint8_t *buffer,
+	           size_t size,
+	           off64_t offset,
+	           liberror_error_t **error );
+
+	/* The write at offset function
+	 * NULL if the IO handle only supports writing at the current offset
+	 */
+	ssize_t (*write_at_offset)(
+	           intptr_t *io_handle,
+	           uint8_t *buffer,
+	           size_t size,
+	           off64_t offset,
+	           liberror_error_t **error );
 };
 
 LIBBFIO_EXTERN int libbfio_handle_initialize(
@@ -198,12 +231,36 @@ LIBBFIO_EXTERN ssize_t libbfio_handle_write(
                         size_t size,
                         liberror_error_t **error );
 
+LIBBFIO_EXTERN ssize_t libbfio_handle_read_at_offset(
+                        libbfio_handle_t *handle,
+                        uint8_t *buffer,
+                        size_t size,
+                        off64_t offset,
+                        liberror_error_t **error );
+
+LIBBFIO_EXTERN ssize_t libbfio_handle_write_at_offset(
+                        libbfio_handle_t *handle,
+                        uint8_t *buffer,
+                        size_t size,
+                        off64_t offset,
+                        liberror_error_t **error );
+
+LIBBFIO_EXTERN int libbfio_handle_flush(
+                    libbfio_handle_t *handle,
+                    liberror_error_t **error );
+
 LIBBFIO_EXTERN off64_t libbfio_handle_seek_offset(
                         libbfio_handle_t *handle,
                         off64_t offset,
                         int whence,
                         liberror_error_t **error );
 
+LIBBFIO_EXTERN int libbfio_handle_set_at_offset_functions(
+                    libbfio_handle_t *handle,
+                    ssize_t (*read_at_offset)( intptr_t *io_handle, uint8_t *buffer, size_t size, off64_t offset, liberror_error_t **error ),
+                    ssize_t (*write_at_offset)( intptr_t *io_handle, uint8_t *buffer, size_t size, off64_t offset, liberror_error_t **error ),
+                    liberror_error_t **error );
+
 LIBBFIO_EXTERN int libbfio_handle_exists(
                     libbfio_handle_t *handle,
                     liberror_error_t **error );
@@ -212,6 +269,10 @@ LIBBFIO_EXTERN int libbfio_handle_is_open(
                     libbfio_handle_t *handle,
                     liberror_error_t **error );
 
+LIBBFIO_EXTERN int libbfio_handle_can_read_at_offset_concurrently(
+                    libbfio_handle_t *handle,
+                    liberror_error_t **error );
+
 LIBBFIO_EXTERN int libbfio_handle_get_flags(
                     libbfio_handle_t *handle,
                     int *flags,
@@ -237,6 +298,16 @@ LIBBFIO_EXTERN int libbfio_handle_set_open_on_demand(
                     uint8_t open_on_demand,
                     liberror_error_t **error );
 
+LIBBFIO_EXTERN int libbfio_handle_get_write_buffer_size(
+                    libbfio_handle_t *handle,
+                    size_t *write_buffer_size,
+                    liberror_error_t **error );
+
+LIBBFIO_EXTERN int libbfio_handle_set_write_buffer_size(
+                    libbfio_handle_t *handle,
+                    size_t write_buffer_size,
+                    liberror_error_t **error );
+
 LIBBFIO_EXTERN int libbfio_handle_set_track_offsets_read(
                     libbfio_handle_t *handle,
                     uint8_t track_offsets_read,
@@ -0,0 +1,1139 @@
+/*
+ * Memory mapped file functions
+ *
+ * Copyright (c) 2006-2009, Joachim Metz <forensics@hoffmannbv.nl>,
+ * Hoffmann Investigations.
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include <liberror.h>
+
+#include "libbfio_definitions.h"
+#include "libbfio_file.h"
+#include "libbfio_handle.h"
+#include "libbfio_mmap_file.h"
+#include "libbfio_system_string.h"
+#include "libbfio_types.h"
+
+#if defined( HAVE_LIBBFIO_MMAP_FILE_MMAP )
+#include <sys/mman.h>
+#endif
+
+/* Initializes the memory mapped file IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int libbfio_mmap_file_io_handle_initialize(
+     libbfio_mmap_file_io_handle_t **mmap_file_io_handle,
+     liberror_error_t **error )
+{
+	static char *function = "libbfio_mmap_file_io_handle_initialize";
+
+	if( mmap_file_io_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid memory mapped file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *mmap_file_io_handle == NULL )
+	{
+		*mmap_file_io_handle = (libbfio_mmap_file_io_handle_t *) memory_allocate(
+		                                                          sizeof( libbfio_mmap_file_io_handle_t ) );
+
+		if( *mmap_file_io_handle == NULL )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_MEMORY,
+			 LIBERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create memory mapped file IO handle.",
+			 function );
+
+			return( -1 );
+		}
+		if( memory_set(
+		     *mmap_file_io_handle,
+		     0,
+		     sizeof( libbfio_mmap_file_io_handle_t ) ) == NULL )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_MEMORY,
+			 LIBERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear memory mapped file IO handle.",
+			 function );
+
+			memory_free(
+			 *mmap_file_io_handle );
+
+			*mmap_file_io_handle = NULL;
+
+			return( -1 );
+		}
+#if defined( WINAPI ) && !defined( USE_CRT_FUNCTIONS )
+		( *mmap_file_io_handle )->file_io_handle.file_handle     = INVALID_HANDLE_VALUE;
+#else
+		( *mmap_file_io_handle )->file_io_handle.file_descriptor = -1;
+#endif
+		( *mmap_file_io_handle )->access_pattern                 = LIBBFIO_MMAP_FILE_ACCESS_PATTERN_NORMAL;
+	}
+	return( 1 );
+}
+
+/* Initializes the memory mapped file handle
+ * Returns 1 if successful or -1 on error
+ */
+int libbfio_mmap_file_initialize(
+      libbfio_handle_t **handle,
+      liberror_error_t **error )
+{
+	libbfio_mmap_file_io_handle_t *io_handle = NULL;
+	static char *function                    = "libbfio_mmap_file_initialize";
+
+	if( handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *handle == NULL )
+	{
+		if( libbfio_mmap_file_io_handle_initialize(
+		     &io_handle,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create handle.",
+			 function );
+
+			return( -1 );
+		}
+		/* The exists and is open functions of the file handle
+		 * are used since the file IO handle is the first value
+		 */
+		if( libbfio_handle_initialize(
+		     handle,
+		     (intptr_t *) io_handle,
+		     libbfio_mmap_file_io_handle_free,
+		     libbfio_mmap_file_io_handle_clone,
+		     libbfio_mmap_file_open,
+		     libbfio_mmap_file_close,
+		     libbfio_mmap_file_read,
+		     libbfio_mmap_file_write,
+		     libbfio_mmap_file_seek_offset,
+		     libbfio_file_exists,
+		     libbfio_file_is_open,
+		     libbfio_mmap_file_get_size,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create handle.",
+			 function );
+
+			memory_free(
+			 io_handle );
+
+			return( -1 );
+		}
+#if defined( HAVE_LIBBFIO_MMAP_FILE_MMAP ) && defined( HAVE_LIBBFIO_FILE_AT_OFFSET )
+		if( libbfio_handle_set_at_offset_functions(
+		     *handle,
+		     libbfio_mmap_file_read_at_offset,
+		     NULL,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set at offset functions.",
+			 function );
+
+			libbfio_handle_free(
+			 handle,
+			 NULL );
+
+			return( -1 );
+		}
+#endif
+	}
+	return( 1 );
+}
+
+/* Frees the memory mapped file IO handle and its attributes
+ * Returns 1 if succesful or -1 on error
+ */
+int libbfio_mmap_file_io_handle_free(
+     intptr_t *io_handle,
+     liberror_error_t **error )
+{
+	static char *function = "libbfio_mmap_file_io_handle_free";
+	int result            = 1;
+
+	if( io_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_is_open(
+	     io_handle,
+	     NULL ) == 1 )
+	{
+		if( libbfio_mmap_file_close(
+		     io_handle,
+		     error ) != 0 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close memory mapped file IO handle.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( ( (libbfio_mmap_file_io_handle_t *) io_handle )->file_io_handle.name != NULL )
+	{
+		memory_free(
+		 ( (libbfio_mmap_file_io_handle_t *) io_handle )->file_io_handle.name );
+	}
+	memory_free(
+	 io_handle );
+
+	return( result );
+}
+
+/* Clones (duplicates) the memory mapped file IO handle and its attributes
+ * Returns 1 if succesful or -1 on error
+ */
+int libbfio_mmap_file_io_handle_clone(
+     intptr_t **destination_io_handle,
+     intptr_t *source_io_handle,
+     liberror_error_t **error )
+{
+	libbfio_mmap_file_io_handle_t *destination_mmap_file_io_handle = NULL;
+	libbfio_mmap_file_io_handle_t *source_mmap_file_io_handle      = NULL;
+	static char *function                                          = "libbfio_mmap_file_io_handle_clone";
+
+	if( destination_io_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid destination IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *destination_io_handle != NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: destination IO handle already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_io_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid source IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	source_mmap_file_io_handle = (libbfio_mmap_file_io_handle_t *) source_io_handle;
+
+	if( libbfio_mmap_file_io_handle_initialize(
+	     &destination_mmap_file_io_handle,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create handle.",
+		 function );
+
+		return( -1 );
+	}
+	destination_mmap_file_io_handle->access_pattern = source_mmap_file_io_handle->access_pattern;
+
+	if( source_mmap_file_io_handle->file_io_handle.name != NULL )
+	{
+		destination_mmap_file_io_handle->file_io_handle.name = (libbfio_system_character_t *) memory_allocate(
+		                                                                                       sizeof( libbfio_system_character_t ) * source_mmap_file_io_handle->file_io_handle.name_size );
+
+		if( destination_mmap_file_io_handle->file_io_handle.name == NULL )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_MEMORY,
+			 LIBERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create name.",
+			 function );
+
+			libbfio_mmap_file_io_handle_free(
+			 (intptr_t *) destination_mmap_file_io_handle,
+			 NULL );
+
+			return( -1 );
+		}
+		if( libbfio_system_string_copy(
+		     destination_mmap_file_io_handle->file_io_handle.name,
+		     source_mmap_file_io_handle->file_io_handle.name,
+		     source_mmap_file_io_handle->file_io_handle.name_size ) == NULL )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_MEMORY,
+			 LIBERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to set name.",
+			 function );
+
+			libbfio_mmap_file_io_handle_free(
+			 (intptr_t *) destination_mmap_file_io_handle,
+			 NULL );
+
+			return( -1 );
+		}
+		destination_mmap_file_io_handle->file_io_handle.name[ source_mmap_file_io_handle->file_io_handle.name_size - 1 ] = 0;
+
+		destination_mmap_file_io_handle->file_io_handle.name_size = source_mmap_file_io_handle->file_io_handle.name_size;
+	}
+	*destination_io_handle = (intptr_t *) destination_mmap_file_io_handle;
+
+	return( 1 );
+}
+
+/* Retrieves the access pattern hint
+ * Returns 1 if succesful or -1 on error
+ */
+int libbfio_mmap_file_get_access_pattern(
+     libbfio_handle_t *handle,
+     int *access_pattern,
+     liberror_error_t **error )
+{
+	libbfio_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libbfio_mmap_file_get_access_pattern";
+
+	if( handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libbfio_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( access_pattern == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid access pattern.",
+		 function );
+
+		return( -1 );
+	}
+	*access_pattern = ( (libbfio_mmap_file_io_handle_t *) internal_handle->io_handle )->access_pattern;
+
+	return( 1 );
+}
+
+/* Sets the access pattern hint
+ * The hint is passed to the system when the file is mapped,
+ * so it can be changed between sequential and random phases
+ * Returns 1 if succesful or -1 on error
+ */
+int libbfio_mmap_file_set_access_pattern(
+     libbfio_handle_t *handle,
+     int access_pattern,
+     liberror_error_t **error )
+{
+	libbfio_internal_handle_t *internal_handle         = NULL;
+	libbfio_mmap_file_io_handle_t *mmap_file_io_handle = NULL;
+	static char *function                              = "libbfio_mmap_file_set_access_pattern";
+
+	if( handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libbfio_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	mmap_file_io_handle = (libbfio_mmap_file_io_handle_t *) internal_handle->io_handle;
+
+	if( ( access_pattern != LIBBFIO_MMAP_FILE_ACCESS_PATTERN_NORMAL )
+	 && ( access_pattern != LIBBFIO_MMAP_FILE_ACCESS_PATTERN_SEQUENTIAL )
+	 && ( access_pattern != LIBBFIO_MMAP_FILE_ACCESS_PATTERN_RANDOM ) )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported access pattern.",
+		 function );
+
+		return( -1 );
+	}
+	mmap_file_io_handle->access_pattern = access_pattern;
+
+	if( libbfio_mmap_file_advise(
+	     mmap_file_io_handle,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set access pattern.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Determines if the file is memory mapped
+ * Returns 1 if mapped, 0 if not or -1 on error
+ */
+int libbfio_mmap_file_is_mapped(
+     libbfio_handle_t *handle,
+     liberror_error_t **error )
+{
+	libbfio_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libbfio_mmap_file_is_mapped";
+
+	if( handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libbfio_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( (libbfio_mmap_file_io_handle_t *) internal_handle->io_handle )->mapped_data == NULL )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Passes the access pattern hint of the mapped file data to the system
+ * Returns 1 if succesful or -1 on error
+ */
+int libbfio_mmap_file_advise(
+     libbfio_mmap_file_io_handle_t *mmap_file_io_handle,
+     liberror_error_t **error )
+{
+	static char *function = "libbfio_mmap_file_advise";
+
+#if defined( HAVE_LIBBFIO_MMAP_FILE_MMAP )
+	int advice            = 0;
+#endif
+
+	if( mmap_file_io_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid memory mapped file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBBFIO_MMAP_FILE_MMAP )
+	if( mmap_file_io_handle->mapped_data == NULL )
+	{
+		return( 1 );
+	}
+	switch( mmap_file_io_handle->access_pattern )
+	{
+		case LIBBFIO_MMAP_FILE_ACCESS_PATTERN_SEQUENTIAL:
+			advice = MADV_SEQUENTIAL;
+			break;
+
+		case LIBBFIO_MMAP_FILE_ACCESS_PATTERN_RANDOM:
+			advice = MADV_RANDOM;
+			break;
+
+		default:
+			advice = MADV_NORMAL;
+			break;
+	}
+	if( madvise(
+	     (void *) mmap_file_io_handle->mapped_data,
+	     (size_t) mmap_file_io_handle->file_size,
+	     advice ) != 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_IO,
+		 LIBERROR_IO_ERROR_GENERIC,
+		 "%s: unable to advise mapped file data.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Opens the memory mapped file handle
+ * The file can only be opened for reading, if the file cannot be mapped
+ * it is read using the file functions
+ * Returns 1 if successful or -1 on error
+ */
+int libbfio_mmap_file_open(
+     intptr_t *io_handle,
+     int flags,
+     liberror_error_t **error )
+{
+	libbfio_mmap_file_io_handle_t *mmap_file_io_handle = NULL;
+	static char *function                              = "libbfio_mmap_file_open";
+
+#if defined( HAVE_LIBBFIO_MMAP_FILE_MMAP )
+	void *mapped_data                                  = NULL;
+#endif
+
+	if( io_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	mmap_file_io_handle = (libbfio_mmap_file_io_handle_t *) io_handle;
+
+	if( ( flags & LIBBFIO_FLAG_WRITE ) != 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: write access currently not supported.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_open(
+	     io_handle,
+	     flags,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_IO,
+		 LIBERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_get_size(
+	     io_handle,
+	     &( mmap_file_io_handle->file_size ),
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file size.",
+		 function );
+
+		libbfio_file_close(
+		 io_handle,
+		 NULL );
+
+		return( -1 );
+	}
+	mmap_file_io_handle->mapped_data    = NULL;
+	mmap_file_io_handle->current_offset = 0;
+
+#if defined( HAVE_LIBBFIO_MMAP_FILE_MMAP )
+	/* An empty file cannot be mapped and a file that does not fit
+	 * in the address space is read using the file functions
+	 */
+	if( ( mmap_file_io_handle->file_size > 0 )
+	 && ( mmap_file_io_handle->file_size <= (size64_t) SSIZE_MAX ) )
+	{
+		mapped_data = mmap(
+		               NULL,
+		               (size_t) mmap_file_io_handle->file_size,
+		               PROT_READ,
+		               MAP_SHARED,
+		               mmap_file_io_handle->file_io_handle.file_descriptor,
+		               0 );
+
+		if( mapped_data != MAP_FAILED )
+		{
+			mmap_file_io_handle->mapped_data = (uint8_t *) mapped_data;
+		}
+	}
+	if( libbfio_mmap_file_advise(
+	     mmap_file_io_handle,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set access pattern.",
+		 function );
+
+		libbfio_mmap_file_close(
+		 io_handle,
+		 NULL );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Closes the memory mapped file handle
+ * Returns 0 if successful or -1 on error
+ */
+int libbfio_mmap_file_close(
+     intptr_t *io_handle,
+     liberror_error_t **error )
+{
+	libbfio_mmap_file_io_handle_t *mmap_file_io_handle = NULL;
+	static char *function                              = "libbfio_mmap_file_close";
+	int result                                         = 0;
+
+	if( io_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	mmap_file_io_handle = (libbfio_mmap_file_io_handle_t *) io_handle;
+
+#if defined( HAVE_LIBBFIO_MMAP_FILE_MMAP )
+	if( mmap_file_io_handle->mapped_data != NULL )
+	{
+		if( munmap(
+		     (void *) mmap_file_io_handle->mapped_data,
+		     (size_t) mmap_file_io_handle->file_size ) != 0 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to unmap file data.",
+			 function );
+
+			result = -1;
+		}
+		mmap_file_io_handle->mapped_data = NULL;
+	}
+#endif
+	if( libbfio_file_close(
+	     io_handle,
+	     error ) != 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_IO,
+		 LIBERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file.",
+		 function );
+
+		result = -1;
+	}
+	mmap_file_io_handle->file_size      = 0;
+	mmap_file_io_handle->current_offset = 0;
+
+	return( result );
+}
+
+/* Reads a buffer from the memory mapped file handle
+ * Returns the amount of bytes read if successful, or -1 on errror
+ */
+ssize_t libbfio_mmap_file_read(
+         intptr_t *io_handle,
+         uint8_t *buffer,
+         size_t size,
+         liberror_error_t **error )
+{
+	libbfio_mmap_file_io_handle_t *mmap_file_io_handle = NULL;
+	static char *function                              = "libbfio_mmap_file_read";
+	size64_t read_size                                 = 0;
+	ssize_t read_count                                 = 0;
+
+	if( io_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	mmap_file_io_handle = (libbfio_mmap_file_io_handle_t *) io_handle;
+
+	if( mmap_file_io_handle->mapped_data == NULL )
+	{
+		read_count = libbfio_file_read(
+		              io_handle,
+		              buffer,
+		              size,
+		              error );
+
+		if( read_count < 0 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read from file.",
+			 function );
+
+			return( -1 );
+		}
+		mmap_file_io_handle->current_offset += (off64_t) read_count;
+
+		return( read_count );
+	}
+	if( buffer == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	/* Check if the end of the data was reached
+	 */
+	if( (size64_t) mmap_file_io_handle->current_offset >= mmap_file_io_handle->file_size )
+	{
+		return( 0 );
+	}
+	/* Check the amount data available
+	 */
+	read_size = mmap_file_io_handle->file_size - (size64_t) mmap_file_io_handle->current_offset;
+
+	/* Cannot read more data than available
+	 */
+	if( read_size > (size64_t) size )
+	{
+		read_size = (size64_t) size;
+	}
+	if( memory_copy(
+	     buffer,
+	     &( mmap_file_io_handle->mapped_data[ mmap_file_io_handle->current_offset ] ),
+	     (size_t) read_size ) == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_MEMORY,
+		 LIBERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to read buffer from mapped file data.",
+		 function );
+
+		return( -1 );
+	}
+	mmap_file_io_handle->current_offset += (off64_t) read_size;
+
+	return( (ssize_t) read_size );
+}
+
+#if defined( HAVE_LIBBFIO_MMAP_FILE_MMAP ) && defined( HAVE_LIBBFIO_FILE_AT_OFFSET )
+
+/* Reads a buffer from the memory mapped file handle at a specific offset
+ * The current offset of the memory mapped file handle is not changed
+ * Returns the amount of bytes read if successful, or -1 on error
+ */
+ssize_t libbfio_mmap_file_read_at_offset(
+         intptr_t *io_handle,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         liberror_error_t **error )
+{
+	libbfio_mmap_file_io_handle_t *mmap_file_io_handle = NULL;
+	static char *function                              = "libbfio_mmap_file_read_at_offset";
+	size64_t read_size                                 = 0;
+	ssize_t read_count                                 = 0;
+
+	if( io_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	mmap_file_io_handle = (libbfio_mmap_file_io_handle_t *) io_handle;
+
+	if( mmap_file_io_handle->mapped_data == NULL )
+	{
+		read_count = libbfio_file_read_at_offset(
+		              io_handle,
+		              buffer,
+		              size,
+		              offset,
+		              error );
+
+		if( read_count < 0 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read from file at offset: %" PRIi64 ".",
+			 function,
+			 offset );
+
+			return( -1 );
+		}
+		return( read_count );
+	}
+	if( buffer == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) offset >= mmap_file_io_handle->file_size )
+	{
+		return( 0 );
+	}
+	read_size = mmap_file_io_handle->file_size - (size64_t) offset;
+
+	if( read_size > (size64_t) size )
+	{
+		read_size = (size64_t) size;
+	}
+	if( memory_copy(
+	     buffer,
+	     &( mmap_file_io_handle->mapped_data[ offset ] ),
+	     (size_t) read_size ) == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_MEMORY,
+		 LIBERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to read buffer from mapped file data.",
+		 function );
+
+		return( -1 );
+	}
+	return( (ssize_t) read_size );
+}
+
+#endif
+
+/* Writes a buffer to the memory mapped file handle
+ * Returns the amount of bytes written if successful, or -1 on errror
+ */
+ssize_t libbfio_mmap_file_write(
+         intptr_t *io_handle,
+         uint8_t *buffer,
+         size_t size,
+         liberror_error_t **error )
+{
+	static char *function = "libbfio_mmap_file_write";
+
+	liberror_error_set(
+	 error,
+	 LIBERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: write access currently not supported.",
+	 function );
+
+	return( -1 );
+}
+
+/* Seeks a certain offset within the memory mapped file handle
+ * Returns the offset if the seek is successful or -1 on error
+ */
+off64_t libbfio_mmap_file_seek_offset(
+         intptr_t *io_handle,
+         off64_t offset,
+         int whence,
+         liberror_error_t **error )
+{
+	libbfio_mmap_file_io_handle_t *mmap_file_io_handle = NULL;
+	static char *function                              = "libbfio_mmap_file_seek_offset";
+
+	if( io_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	mmap_file_io_handle = (libbfio_mmap_file_io_handle_t *) io_handle;
+
+	if( whence == SEEK_CUR )
+	{
+		offset += mmap_file_io_handle->current_offset;
+	}
+	else if( whence == SEEK_END )
+	{
+		offset += (off64_t) mmap_file_io_handle->file_size;
+	}
+	else if( whence != SEEK_SET )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported whence.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_OUT_OF_RANGE,
+		 "%s: invalid offset value out of range.",
+		 function );
+
+		return( -1 );
+	}
+	if( mmap_file_io_handle->mapped_data == NULL )
+	{
+		offset = libbfio_file_seek_offset(
+		          io_handle,
+		          offset,
+		          SEEK_SET,
+		          error );
+
+		if( offset == -1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek offset in file.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	mmap_file_io_handle->current_offset = offset;
+
+	return( offset );
+}
+
+/* Retrieves the memory mapped file size
+ * Returns 1 if successful or -1 on error
+ */
+int libbfio_mmap_file_get_size(
+     intptr_t *io_handle,
+     size64_t *size,
+     liberror_error_t **error )
+{
+	libbfio_mmap_file_io_handle_t *mmap_file_io_handle = NULL;
+	static char *function                              = "libbfio_mmap_file_get_size";
+
+	if( io_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	mmap_file_io_handle = (libbfio_mmap_file_io_handle_t *) io_handle;
+
+	if( size == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size.",
+		 function );
+
+		return( -1 );
+	}
+	/* The size of the mapped file is determined when the file is opened
+	 */
+	if( mmap_file_io_handle->mapped_data != NULL )
+	{
+		*size = mmap_file_io_handle->file_size;
+	}
+	else if( libbfio_file_get_size(
+	          io_handle,
+	          size,
+	          error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file size.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
@@ -0,0 +1,164 @@
+/*
+ * Memory mapped file functions
+ *
+ * Copyright (c) 2006-2009, Joachim Metz <forensics@hoffmannbv.nl>,
+ * Hoffmann Investigations.
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBBFIO_MMAP_FILE_H )
+#define _LIBBFIO_MMAP_FILE_H
+
+#include <common.h>
+#include <types.h>
+
+#include <liberror.h>
+
+#include "libbfio_extern.h"
+#include "libbfio_file.h"
+#include "libbfio_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The file is mapped using mmap if available
+ * otherwise the file is read using the file functions
+ */
+#if defined( HAVE_SYS_MMAN_H ) && !defined( WINAPI )
+#define HAVE_LIBBFIO_MMAP_FILE_MMAP	1
+#endif
+
+/* The memory mapped file access patterns
+ */
+enum LIBBFIO_MMAP_FILE_ACCESS_PATTERNS
+{
+	LIBBFIO_MMAP_FILE_ACCESS_PATTERN_NORMAL		= 0,
+	LIBBFIO_MMAP_FILE_ACCESS_PATTERN_SEQUENTIAL	= 1,
+	LIBBFIO_MMAP_FILE_ACCESS_PATTERN_RANDOM		= 2
+};
+
+typedef struct libbfio_mmap_file_io_handle libbfio_mmap_file_io_handle_t;
+
+struct libbfio_mmap_file_io_handle
+{
+	/* The file IO handle
+	 * this must be the first value, so the file functions
+	 * can be used to set the name and open the file
+	 */
+	libbfio_file_io_handle_t file_io_handle;
+
+	/* The mapped file data
+	 * NULL if the file could not be mapped
+	 */
+	uint8_t *mapped_data;
+
+	/* The size of the file
+	 */
+	size64_t file_size;
+
+	/* The current offset
+	 */
+	off64_t current_offset;
+
+	/* The access pattern hint
+	 */
+	int access_pattern;
+};
+
+int libbfio_mmap_file_io_handle_initialize(
+     libbfio_mmap_file_io_handle_t **mmap_file_io_handle,
+     liberror_error_t **error );
+
+LIBBFIO_EXTERN int libbfio_mmap_file_initialize(
+                    libbfio_handle_t **handle,
+                    liberror_error_t **error );
+
+int libbfio_mmap_file_io_handle_free(
+     intptr_t *io_handle,
+     liberror_error_t **error );
+
+int libbfio_mmap_file_io_handle_clone(
+     intptr_t **destination_io_handle,
+     intptr_t *source_io_handle,
+     liberror_error_t **error );
+
+LIBBFIO_EXTERN int libbfio_mmap_file_get_access_pattern(
+                    libbfio_handle_t *handle,
+                    int *access_pattern,
+                    liberror_error_t **error );
+
+LIBBFIO_EXTERN int libbfio_mmap_file_set_access_pattern(
+                    libbfio_handle_t *handle,
+                    int access_pattern,
+                    liberror_error_t **error );
+
+LIBBFIO_EXTERN int libbfio_mmap_file_is_mapped(
+                    libbfio_handle_t *handle,
+                    liberror_error_t **error );
+
+int libbfio_mmap_file_advise(
+     libbfio_mmap_file_io_handle_t *mmap_file_io_handle,
+     liberror_error_t **error );
+
+int libbfio_mmap_file_open(
+     intptr_t *io_handle,
+     int flags,
+     liberror_error_t **error );
+
+int libbfio_mmap_file_close(
+     intptr_t *io_handle,
+     liberror_error_t **error );
+
+ssize_t libbfio_mmap_file_read(
+         intptr_t *io_handle,
+         uint8_t *buffer,
+         size_t size,
+         liberror_error_t **error );
+
+#if defined( HAVE_LIBBFIO_MMAP_FILE_MMAP ) && defined( HAVE_LIBBFIO_FILE_AT_OFFSET )
+ssize_t libbfio_mmap_file_read_at_offset(
+         intptr_t *io_handle,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         liberror_error_t **error );
+#endif
+
+ssize_t libbfio_mmap_file_write(
+         intptr_t *io_handle,
+         uint8_t *buffer,
+         size_t size,
+         liberror_error_t **error );
+
+off64_t libbfio_mmap_file_seek_offset(
+         intptr_t *io_handle,
+         off64_t offset,
+         int whence,
+         liberror_error_t **error );
+
+int libbfio_mmap_file_get_size(
+     intptr_t *io_handle,
+     size64_t *size,
+     liberror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif
+
@@ -26,86 +26,269 @@
 
 #include <liberror.h>
 
-#include "libbfio_list_type.h"
 #include "libbfio_offset_list.h"
 
-/* Frees offset list values
+/* Initializes the offset list
+ * Returns 1 if successful or -1 on error
  */
-int libbfio_offset_list_values_free(
-     intptr_t *values,
+int libbfio_offset_list_initialize(
+     libbfio_offset_list_t **offset_list,
      liberror_error_t **error )
 {
-	if( values != NULL )
+	static char *function = "libbfio_offset_list_initialize";
+
+	if( offset_list == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset list.",
+		 function );
+
+		return( -1 );
+	}
+	if( *offset_list == NULL )
+	{
+		*offset_list = (libbfio_offset_list_t *) memory_allocate(
+		                                          sizeof( libbfio_offset_list_t ) );
+
+		if( *offset_list == NULL )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_MEMORY,
+			 LIBERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create offset list.",
+			 function );
+
+			return( -1 );
+		}
+		if( memory_set(
+		     *offset_list,
+		     0,
+		     sizeof( libbfio_offset_list_t ) ) == NULL )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_MEMORY,
+			 LIBERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear offset list.",
+			 function );
+
+			memory_free(
+			 *offset_list );
+
+			*offset_list = NULL;
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Frees the offset list
+ * Returns 1 if successful or -1 on error
+ */
+int libbfio_offset_list_free(
+     libbfio_offset_list_t **offset_list,
+     liberror_error_t **error )
+{
+	static char *function = "libbfio_offset_list_free";
+
+	if( offset_list == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset list.",
+		 function );
+
+		return( -1 );
+	}
+	if( *offset_list != NULL )
 	{
+		if( ( *offset_list )->values != NULL )
+		{
+			memory_free(
+			 ( *offset_list )->values );
+		}
 		memory_free(
-		 values );
+		 *offset_list );
+
+		*offset_list = NULL;
 	}
 	return( 1 );
 }
 
-/* Compares two offset list values
- * Returns LIBBFIO_LIST_COMPARE_LESS, LIBBFIO_LIST_COMPARE_EQUAL, LIBBFIO_LIST_COMPARE_GREATER if successful or -1 on error
+/* Resizes the offset list values
+ * The allocated amount of values is at least doubled to limit the amount of reallocations
+ * Returns 1 if successful or -1 on error
  */
-int libbfio_offset_list_values_compare(
-     intptr_t *first,
-     intptr_t *second,
+int libbfio_offset_list_resize(
+     libbfio_offset_list_t *offset_list,
+     int amount_of_values,
      liberror_error_t **error )
 {
-	static char *function = "libbfio_offset_list_values_compare";
+	void *reallocation             = NULL;
+	static char *function          = "libbfio_offset_list_resize";
+	size_t values_size             = 0;
+	int amount_of_allocated_values = 0;
 
-	if( first == NULL )
+	if( offset_list == NULL )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid first offset list value.",
+		 "%s: invalid offset list.",
 		 function );
 
 		return( -1 );
 	}
-	if( second == NULL )
+	if( amount_of_values < 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid amount of values less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( amount_of_values > offset_list->amount_of_allocated_values )
+	{
+		amount_of_allocated_values = offset_list->amount_of_allocated_values;
+
+		if( amount_of_allocated_values < 16 )
+		{
+			amount_of_allocated_values = 16;
+		}
+		while( amount_of_allocated_values < amount_of_values )
+		{
+			if( amount_of_allocated_values > ( INT_MAX / 2 ) )
+			{
+				amount_of_allocated_values = amount_of_values;
+
+				break;
+			}
+			amount_of_allocated_values *= 2;
+		}
+		values_size = sizeof( libbfio_offset_list_values_t ) * (size_t) amount_of_allocated_values;
+
+		if( values_size > (size_t) SSIZE_MAX )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid values size value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		reallocation = memory_reallocate(
+		                offset_list->values,
+		                values_size );
+
+		if( reallocation == NULL )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_MEMORY,
+			 LIBERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize offset list values.",
+			 function );
+
+			return( -1 );
+		}
+		offset_list->values                     = (libbfio_offset_list_values_t *) reallocation;
+		offset_list->amount_of_allocated_values = amount_of_allocated_values;
+	}
+	return( 1 );
+}
+
+/* Finds the index of the first offset range that ends at or after the offset
+ * using a binary search, this is the range that contains or directly precedes
+ * the offset or otherwise the first range after the offset
+ * The index is set to the amount of values if no such range exists
+ * Returns 1 if successful or -1 on error
+ */
+int libbfio_offset_list_find_index(
+     libbfio_offset_list_t *offset_list,
+     off64_t offset,
+     int *index,
+     liberror_error_t **error )
+{
+	libbfio_offset_list_values_t *offset_values = NULL;
+	static char *function                       = "libbfio_offset_list_find_index";
+	int lower_index                             = 0;
+	int middle_index                            = 0;
+	int upper_index                             = 0;
+
+	if( offset_list == NULL )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid second offset list value.",
+		 "%s: invalid offset list.",
 		 function );
 
-		return( 1 );
+		return( -1 );
 	}
-	if( ( (libbfio_offset_list_values_t *) first )->offset < ( (libbfio_offset_list_values_t *) second )->offset )
+	if( index == NULL )
 	{
-		return( LIBBFIO_LIST_COMPARE_LESS );
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index.",
+		 function );
+
+		return( -1 );
 	}
-	else if( ( (libbfio_offset_list_values_t *) first )->offset > ( (libbfio_offset_list_values_t *) second )->offset )
+	upper_index = offset_list->amount_of_values;
+
+	while( lower_index < upper_index )
 	{
-		return( LIBBFIO_LIST_COMPARE_GREATER );
+		middle_index  = lower_index + ( ( upper_index - lower_index ) / 2 );
+		offset_values = &( offset_list->values[ middle_index ] );
+
+		if( (off64_t) ( offset_values->offset + offset_values->size ) < offset )
+		{
+			lower_index = middle_index + 1;
+		}
+		else
+		{
+			upper_index = middle_index;
+		}
 	}
-	return( LIBBFIO_LIST_COMPARE_EQUAL );
+	*index = lower_index;
+
+	return( 1 );
 }
 
 /* Add an offset
+ * Ranges that overlap or are adjacent to the offset range are merged with it
  * Returns 1 if successful, or -1 on error
  */
 int libbfio_offset_list_add_offset(
-     libbfio_list_t *offset_list,
+     libbfio_offset_list_t *offset_list,
      off64_t offset,
      size64_t size,
      liberror_error_t **error )
 {
-	libbfio_list_element_t *list_element        = NULL;
-	libbfio_list_element_t *remove_element      = NULL;
 	libbfio_offset_list_values_t *offset_values = NULL;
-	static char *function                      = "libbfio_offset_list_add_offset";
-	off64_t last_offset                        = 0;
-	off64_t last_range_offset                  = 0;
-	int iterator                               = 0;
-	int create_list_element                    = 1;
-	int merge_next_list_element_check          = 0;
-	int merge_previous_list_element_check      = 0;
-	int result                                 = 0;
+	static char *function                       = "libbfio_offset_list_add_offset";
+	off64_t last_offset                         = 0;
+	off64_t last_range_offset                   = 0;
+	int amount_of_merged_values                 = 0;
+	int first_index                             = 0;
+	int last_index                              = 0;
+	int value_index                             = 0;
 
 	if( offset_list == NULL )
 	{
@@ -129,268 +312,175 @@ int libbfio_offset_list_add_offset(
 
 		return( -1 );
 	}
-	/* Check if new range should be merged with an existing range
-	 */
-	if( offset_list->amount_of_elements > 0 )
+	if( size > (size64_t) INT64_MAX )
 	{
-		list_element = offset_list->first;
-
-		for( iterator = 0; iterator < offset_list->amount_of_elements; iterator++ )
-		{
-			if( list_element == NULL )
-			{
-				liberror_error_set(
-				 error,
-				 LIBERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
-				 "%s: corruption detected for element: %d.",
-				 function,
-				 iterator + 1 );
-
-				return( -1 );
-			}
-			if( list_element->value == NULL )
-			{
-				liberror_error_set(
-				 error,
-				 LIBERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
-				 "%s: missing offset list values for element: %d.",
-				 function,
-				 iterator + 1 );
-
-				return( -1 );
-			}
-			offset_values = (libbfio_offset_list_values_t *) list_element->value;
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
 
-			last_offset       = offset + size;
-			last_range_offset = offset_values->offset + offset_values->size;
+		return( -1 );
+	}
+	/* An empty range does not add anything to the list
+	 */
+	if( size == 0 )
+	{
+		return( 1 );
+	}
+	last_offset = offset + (off64_t) size;
 
-			/* Check if the offset range overlaps at the end of an existing offset range
-			 */
-			if( ( offset >= offset_values->offset )
-			 && ( offset <= last_range_offset ) )
-			{
-				if( last_offset > last_range_offset )
-				{
-					offset_values->size += (size64_t) ( last_offset - last_range_offset );
-				}
-				create_list_element           = 0;
-				merge_next_list_element_check = 1;
-			}
-			/* Check if the offset range overlaps at the beginning of an existing offset range
-			 */
-			else if( ( last_offset >= offset_values->offset )
-			      && ( last_offset <= last_range_offset ) )
-			{
-				if( offset < offset_values->offset )
-				{
-					offset_values->offset  = offset;
-					offset_values->size   += (size64_t) ( offset_values->offset - offset );
-				}
-				create_list_element               = 0;
-				merge_previous_list_element_check = 1;
-			}
-			/* Check if the offset range overlaps an existing offset range entirely
-			 */
-			else if( ( offset < offset_values->offset )
-			      && ( last_offset > last_range_offset ) )
-			{
-				offset_values->offset = offset;
-				offset_values->size   = size;
+	if( libbfio_offset_list_find_index(
+	     offset_list,
+	     offset,
+	     &first_index,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to find index of offset: %" PRIi64 ".",
+		 function,
+		 offset );
 
-				create_list_element               = 0;
-				merge_next_list_element_check     = 1;
-				merge_previous_list_element_check = 1;
-			}
-			if( create_list_element == 0 )
-			{
-				break;
-			}
-			list_element = list_element->next;
-		}
-		/* Check if current range should also be merged with previous
-		 */
-		if( merge_previous_list_element_check != 0 )
+		return( -1 );
+	}
+	/* Determine the ranges that overlap or are adjacent to the offset range
+	 */
+	for( last_index = first_index;
+	     last_index < offset_list->amount_of_values;
+	     last_index++ )
+	{
+		if( offset_list->values[ last_index ].offset > last_offset )
 		{
-			if( list_element == NULL )
-			{
-				liberror_error_set(
-				 error,
-				 LIBERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
-				 "%s: invalid list element.",
-				 function );
-
-				return( -1 );
-			}
-			if( list_element->previous != NULL )
-			{
-				if( list_element->previous->value == NULL )
-				{
-					liberror_error_set(
-					 error,
-					 LIBERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
-					 "%s: missing offset list values for previous list element.",
-					 function );
-
-					return( -1 );
-				}
-				last_offset = ( (libbfio_offset_list_values_t *) list_element->previous->value )->offset + ( (libbfio_offset_list_values_t *) list_element->previous->value )->size;
-
-				if( last_offset == offset_values->offset )
-				{
-					/* Merge offset range with previous
-					 */
-					offset_values->offset  = ( (libbfio_offset_list_values_t *) list_element->previous->value )->offset;
-					offset_values->size   += ( (libbfio_offset_list_values_t *) list_element->previous->value )->size;
-
-					/* Remove previous list element
-					 */
-					remove_element = list_element->previous;
-
-					if( libbfio_list_remove_element(
-					     offset_list,
-					     remove_element,
-					     error ) != 1 )
-					{
-						liberror_error_set(
-						 error,
-						 LIBERROR_ERROR_DOMAIN_RUNTIME,
-						 LIBERROR_RUNTIME_ERROR_REMOVE_FAILED,
-						 "%s: unable to remove next list element.",
-						 function );
-
-						return( -1 );
-					}
-					memory_free(
-					 remove_element->value );
-					memory_free(
-					 remove_element );
-				}
-			}
-		}
-		/* Check if current range should also be merged with next
-		 */
-		if( merge_next_list_element_check != 0 )
-		{
-			if( list_element == NULL )
-			{
-				liberror_error_set(
-				 error,
-				 LIBERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
-				 "%s: invalid list element.",
-				 function );
-
-				return( -1 );
-			}
-			if( list_element->next != NULL )
-			{
-				if( list_element->next->value == NULL )
-				{
-					liberror_error_set(
-					 error,
-					 LIBERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
-					 "%s: missing offset list values for next list element.",
-					 function );
-
-					return( -1 );
-				}
-				last_offset = offset_values->offset + offset_values->size;
-
-				if( last_offset == ( (libbfio_offset_list_values_t *) list_element->next->value )->offset )
-				{
-					/* Merge offset range with next
-					 */
-					offset_values->size += ( (libbfio_offset_list_values_t *) list_element->next->value )->size;
-
-					/* Remove next list element
-					 */
-					remove_element = list_element->next;
-
-					if( libbfio_list_remove_element(
-					     offset_list,
-					     remove_element,
-					     error ) != 1 )
-					{
-						liberror_error_set(
-						 error,
-						 LIBERROR_ERROR_DOMAIN_RUNTIME,
-						 LIBERROR_RUNTIME_ERROR_REMOVE_FAILED,
-						 "%s: unable to remove next list element.",
-						 function );
-
-						return( -1 );
-					}
-					memory_free(
-					 remove_element->value );
-					memory_free(
-					 remove_element );
-				}
-			}
+			break;
 		}
 	}
-	if( create_list_element != 0 )
-	{
-		offset_values = (libbfio_offset_list_values_t *) memory_allocate(
-		                                                 sizeof( libbfio_offset_list_values_t ) );
+	amount_of_merged_values = last_index - first_index;
 
-		if( offset_values == NULL )
+	if( amount_of_merged_values == 0 )
+	{
+		/* Insert a new range before the first range after the offset range
+		 */
+		if( offset_list->amount_of_values == INT_MAX )
 		{
 			liberror_error_set(
 			 error,
-			 LIBERROR_ERROR_DOMAIN_MEMORY,
-			 LIBERROR_MEMORY_ERROR_INSUFFICIENT,
-			 "%s: unable to create offset values.",
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid amount of values value exceeds maximum.",
 			 function );
 
 			return( -1 );
 		}
-		offset_values->offset = offset;
-		offset_values->size   = size;
-
-		result = libbfio_list_insert_value(
-		          offset_list,
-		          (intptr_t *) offset_values,
-		          &libbfio_offset_list_values_compare,
-		          error );
-
-		if( result != 1 )
-		{
-			memory_free(
-			 offset_values );
-		}
-		if( result == -1 )
+		if( libbfio_offset_list_resize(
+		     offset_list,
+		     offset_list->amount_of_values + 1,
+		     error ) != 1 )
 		{
 			liberror_error_set(
 			 error,
 			 LIBERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBERROR_RUNTIME_ERROR_APPEND_FAILED,
-			 "%s: unable to insert offset values in offset list.",
+			 LIBERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to resize offset list.",
 			 function );
 
 			return( -1 );
 		}
+		for( value_index = offset_list->amount_of_values;
+		     value_index > first_index;
+		     value_index-- )
+		{
+			offset_list->values[ value_index ] = offset_list->values[ value_index - 1 ];
+		}
+		offset_list->values[ first_index ].offset = offset;
+		offset_list->values[ first_index ].size   = size;
+
+		offset_list->amount_of_values += 1;
+	}
+	else
+	{
+		/* Merge the ranges into the first range
+		 */
+		offset_values     = &( offset_list->values[ first_index ] );
+		last_range_offset = offset_list->values[ last_index - 1 ].offset
+		                  + (off64_t) offset_list->values[ last_index - 1 ].size;
+
+		if( offset_values->offset < offset )
+		{
+			offset = offset_values->offset;
+		}
+		if( last_range_offset > last_offset )
+		{
+			last_offset = last_range_offset;
+		}
+		offset_values->offset = offset;
+		offset_values->size   = (size64_t) ( last_offset - offset );
+
+		if( amount_of_merged_values > 1 )
+		{
+			for( value_index = last_index;
+			     value_index < offset_list->amount_of_values;
+			     value_index++ )
+			{
+				offset_list->values[ value_index - amount_of_merged_values + 1 ] = offset_list->values[ value_index ];
+			}
+			offset_list->amount_of_values -= amount_of_merged_values - 1;
+		}
 	}
 	return( 1 );
 }
 
+/* Retrieves the amount of offsets
+ * Returns 1 if successful or -1 on error
+ */
+int libbfio_offset_list_get_amount_of_offsets(
+     libbfio_offset_list_t *offset_list,
+     int *amount_of_offsets,
+     liberror_error_t **error )
+{
+	static char *function = "libbfio_offset_list_get_amount_of_offsets";
+
+	if( offset_list == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset list.",
+		 function );
+
+		return( -1 );
+	}
+	if( amount_of_offsets == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid amount of offsets.",
+		 function );
+
+		return( -1 );
+	}
+	*amount_of_offsets = offset_list->amount_of_values;
+
+	return( 1 );
+}
+
 /* Retrieves a specific offset
  * Returns 1 if successful, 0 if not available or -1 on error
  */
 int libbfio_offset_list_get_offset(
-     libbfio_list_t *offset_list,
+     libbfio_offset_list_t *offset_list,
      int index,
      off64_t *offset,
      size64_t *size,
      liberror_error_t **error )
 {
-	libbfio_list_element_t *list_element = NULL;
-	static char *function               = "libbfio_offset_list_get_offset";
-	int result                          = 0;
+	static char *function = "libbfio_offset_list_get_offset";
 
 	if( offset_list == NULL )
 	{
@@ -425,56 +515,30 @@ int libbfio_offset_list_get_offset(
 
 		return( -1 );
 	}
-	result = libbfio_list_get_element(
-	          offset_list,
-	          index,
-	          &list_element,
-	          error );
-
-	if( result == -1 )
+	if( ( index < 0 )
+	 || ( index >= offset_list->amount_of_values ) )
 	{
-		liberror_error_set(
-		 error,
-		 LIBERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve list element.",
-		 function );
-
-		return( -1 );
+		return( 0 );
 	}
-	else if( result == 1 )
-	{
-		if( list_element == NULL )
-		{
-			liberror_error_set(
-			 error,
-			 LIBERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: invalid list element.",
-			 function );
+	*offset = offset_list->values[ index ].offset;
+	*size   = offset_list->values[ index ].size;
 
-			return( -1 );
-		}
-		*offset = ( (libbfio_offset_list_values_t *) list_element->value )->offset;
-		*size   = ( (libbfio_offset_list_values_t *) list_element->value )->size;
-	}
-	return( result );
+	return( 1 );
 }
 
 /* Retrieves a specific offset by its value
  * Returns 1 if successful, 0 if not available or -1 on error
  */
 int libbfio_offset_list_get_offset_by_value(
-     libbfio_list_t *offset_list,
+     libbfio_offset_list_t *offset_list,
      off64_t offset_value,
      off64_t *offset,
      size64_t *size,
      liberror_error_t **error )
 {
-	libbfio_list_element_t *list_element        = NULL;
 	libbfio_offset_list_values_t *offset_values = NULL;
-	static char *function                      = "libbfio_offset_list_get_offset_by_value";
-	int iterator                               = 0;
+	static char *function                       = "libbfio_offset_list_get_offset_by_value";
+	int index                                   = 0;
 
 	if( offset_list == NULL )
 	{
@@ -509,63 +573,51 @@ int libbfio_offset_list_get_offset_by_value(
 
 		return( -1 );
 	}
-	list_element = offset_list->first;
-
-	for( iterator = 0; iterator < offset_list->amount_of_elements; iterator++ )
+	if( libbfio_offset_list_find_index(
+	     offset_list,
+	     offset_value,
+	     &index,
+	     error ) != 1 )
 	{
-		if( list_element == NULL )
-		{
-			liberror_error_set(
-			 error,
-			 LIBERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: corruption detected for element: %d.",
-			 function,
-			 iterator + 1 );
-
-			return( -1 );
-		}
-		if( list_element->value == NULL )
-		{
-			liberror_error_set(
-			 error,
-			 LIBERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing offset list values for element: %d.",
-			 function,
-			 iterator + 1 );
-
-			return( -1 );
-		}
-		offset_values = (libbfio_offset_list_values_t *) list_element->value;
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to find index of offset: %" PRIi64 ".",
+		 function,
+		 offset_value );
 
-		if( ( offset_value >= offset_values->offset )
-		 && ( offset_value <= (off64_t) ( offset_values->offset + offset_values->size ) ) )
-		{
-			*offset = offset_values->offset;
-			*size   = offset_values->size;
+		return( -1 );
+	}
+	if( index >= offset_list->amount_of_values )
+	{
+		return( 0 );
+	}
+	offset_values = &( offset_list->values[ index ] );
 
-			return( 1 );
-		}
-		list_element = list_element->next;
+	if( offset_value < offset_values->offset )
+	{
+		return( 0 );
 	}
-	return( 0 );
+	*offset = offset_values->offset;
+	*size   = offset_values->size;
+
+	return( 1 );
 }
 
 /* Determines if a certain offset range is present in the list
  * Returns 1 if present, 0 if not present or -1 on error
  */
 int libbfio_offset_list_range_is_present(
-     libbfio_list_t *offset_list,
+     libbfio_offset_list_t *offset_list,
      off64_t offset,
      size64_t size,
      liberror_error_t **error )
 {
-	libbfio_list_element_t *list_element        = NULL;
 	libbfio_offset_list_values_t *offset_values = NULL;
-	static char *function                      = "libbfio_offset_list_range_is_present";
-	off64_t last_offset                        = 0;
-	int iterator                               = 0;
+	static char *function                       = "libbfio_offset_list_range_is_present";
+	off64_t last_offset                         = 0;
+	int index                                   = 0;
 
 	if( offset_list == NULL )
 	{
@@ -600,48 +652,42 @@ int libbfio_offset_list_range_is_present(
 
 		return( -1 );
 	}
-	last_offset  = offset + size;
-	list_element = offset_list->first;
+	last_offset = offset + size;
 
-	for( iterator = 0; iterator < offset_list->amount_of_elements; iterator++ )
+	if( libbfio_offset_list_find_index(
+	     offset_list,
+	     offset,
+	     &index,
+	     error ) != 1 )
 	{
-		if( list_element == NULL )
-		{
-			liberror_error_set(
-			 error,
-			 LIBERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: corruption detected for element: %d.",
-			 function,
-			 iterator + 1 );
-
-			return( -1 );
-		}
-		if( list_element->value == NULL )
-		{
-			liberror_error_set(
-			 error,
-			 LIBERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing offset list values for element: %d.",
-			 function,
-			 iterator + 1 );
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to find index of offset: %" PRIi64 ".",
+		 function,
+		 offset );
 
-			return( -1 );
-		}
-		offset_values = (libbfio_offset_list_values_t *) list_element->value;
+		return( -1 );
+	}
+	/* The range found can end exactly at the offset, in which case
+	 * the next range is the first that can overlap the offset range
+	 */
+	if( ( index < offset_list->amount_of_values )
+	 && ( (off64_t) ( offset_list->values[ index ].offset + offset_list->values[ index ].size ) == offset ) )
+	{
+		index++;
+	}
+	if( index >= offset_list->amount_of_values )
+	{
+		return( 0 );
+	}
+	offset_values = &( offset_list->values[ index ] );
 
-		if( ( offset >= offset_values->offset )
-		 && ( offset < (off64_t) ( offset_values->offset + offset_values->size ) ) )
-		{
-			return( 1 );
-		}
-		if( ( offset_values->offset >= offset )
-		 && ( offset_values->offset < last_offset ) )
-		{
-			return( 1 );
-		}
-		list_element = list_element->next;
+	if( ( offset >= offset_values->offset )
+	 || ( offset_values->offset < last_offset ) )
+	{
+		return( 1 );
 	}
 	return( 0 );
 }
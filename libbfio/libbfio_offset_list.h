@@ -28,8 +28,6 @@
 
 #include <liberror.h>
 
-#include "libbfio_list_type.h"
-
 #if defined( __cplusplus )
 extern "C" {
 #endif
@@ -47,37 +45,72 @@ struct libbfio_offset_list_values
 	size64_t size;
 };
 
-int libbfio_offset_list_values_free(
-     intptr_t *values,
+typedef struct libbfio_offset_list libbfio_offset_list_t;
+
+/* The offset list contains non overlapping offset ranges
+ * sorted by offset, so they can be found using a binary search
+ */
+struct libbfio_offset_list
+{
+	/* The offset list values
+	 */
+	libbfio_offset_list_values_t *values;
+
+	/* The amount of offset list values
+	 */
+	int amount_of_values;
+
+	/* The amount of allocated offset list values
+	 */
+	int amount_of_allocated_values;
+};
+
+int libbfio_offset_list_initialize(
+     libbfio_offset_list_t **offset_list,
      liberror_error_t **error );
 
-int libbfio_offset_list_values_compare(
-     intptr_t *first,
-     intptr_t *second,
+int libbfio_offset_list_free(
+     libbfio_offset_list_t **offset_list,
+     liberror_error_t **error );
+
+int libbfio_offset_list_resize(
+     libbfio_offset_list_t *offset_list,
+     int amount_of_values,
+     liberror_error_t **error );
+
+int libbfio_offset_list_find_index(
+     libbfio_offset_list_t *offset_list,
+     off64_t offset,
+     int *index,
      liberror_error_t **error );
 
 int libbfio_offset_list_add_offset(
-     libbfio_list_t *offset_list,
+     libbfio_offset_list_t *offset_list,
      off64_t offset,
      size64_t size,
      liberror_error_t **error );
 
+int libbfio_offset_list_get_amount_of_offsets(
+     libbfio_offset_list_t *offset_list,
+     int *amount_of_offsets,
+     liberror_error_t **error );
+
 int libbfio_offset_list_get_offset(
-     libbfio_list_t *offset_list,
+     libbfio_offset_list_t *offset_list,
      int index,
      off64_t *offset,
      size64_t *size,
      liberror_error_t **error );
 
 int libbfio_offset_list_get_offset_by_value(
-     libbfio_list_t *offset_list,
+     libbfio_offset_list_t *offset_list,
      off64_t offset_value,
      off64_t *offset,
      size64_t *size,
      liberror_error_t **error );
 
 int libbfio_offset_list_range_is_present(
-     libbfio_list_t *offset_list,
+     libbfio_offset_list_t *offset_list,
      off64_t offset,
      size64_t size,
      liberror_error_t **error );
@@ -436,6 +436,8 @@ int libbfio_pool_open_handle(
 			return( -1 );
 		}
 	}
+	internal_pool->amount_of_opens += 1;
+
 	if( libbfio_handle_open(
 	     handle,
 	     flags,
@@ -519,6 +521,8 @@ int libbfio_pool_add_handle_to_last_used_list(
 
 			return( -1 );
 		}
+		internal_pool->amount_of_closes += 1;
+
 		if( libbfio_handle_close(
 		     (libbfio_handle_t *) ( last_used_list_element->value ),
 		     error ) != 0 )
@@ -743,6 +747,123 @@ int libbfio_pool_get_handle(
 	return( 1 );
 }
 
+/* Retrieves a certain handle from the pool that can be read at an offset
+ * by multiple threads at the same time without access to the pool
+ * This requires an unlimited amount of open handles, otherwise the pool can close the handle
+ * Returns 1 if successful, 0 if the handle cannot be read concurrently or -1 on error
+ */
+int libbfio_pool_get_handle_for_concurrent_read(
+     libbfio_pool_t *pool,
+     int entry,
+     libbfio_handle_t **handle,
+     liberror_error_t **error )
+{
+	libbfio_internal_pool_t *internal_pool = NULL;
+	static char *function                  = "libbfio_pool_get_handle_for_concurrent_read";
+	int result                             = 0;
+
+	if( pool == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pool.",
+		 function );
+
+		return( -1 );
+	}
+	internal_pool = (libbfio_internal_pool_t *) pool;
+
+	if( internal_pool->handles == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid pool - missing handles.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( entry < 0 )
+	 || ( entry >= internal_pool->amount_of_handles ) )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_OUT_OF_RANGE,
+		 "%s: invalid entry value out of range.",
+		 function );
+
+		return( -1 );
+	}
+	if( handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_pool->maximum_amount_of_open_handles != LIBBFIO_POOL_UNLIMITED_AMOUNT_OF_OPEN_HANDLES )
+	{
+		return( 0 );
+	}
+	/* A handle that is not open yet is opened by the pool on the first read
+	 */
+	result = libbfio_handle_is_open(
+	          internal_pool->handles[ entry ],
+	          error );
+
+	if( result == -1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if entry: %d is open.",
+		 function,
+		 entry );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	result = libbfio_handle_can_read_at_offset_concurrently(
+	          internal_pool->handles[ entry ],
+	          error );
+
+	if( result == -1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if entry: %d can be read concurrently.",
+		 function,
+		 entry );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	/* The read is counted here since it bypasses the pool
+	 */
+	internal_pool->amount_of_reads += 1;
+
+	*handle = internal_pool->handles[ entry ];
+
+	return( 1 );
+}
+
 /* Appends a handle to the pool
  * Sets the entry
  * Returns 1 if successful or -1 on error
@@ -1164,6 +1285,8 @@ int libbfio_pool_reopen(
 
 		return( -1 );
 	}
+	internal_pool->amount_of_opens += 1;
+
 	if( libbfio_handle_reopen(
 	     internal_pool->handles[ entry ],
 	     flags,
@@ -1263,6 +1386,8 @@ int libbfio_pool_close(
 		memory_free(
 		 last_used_list_element );
 	}
+	internal_pool->amount_of_closes += 1;
+
 	if( libbfio_handle_close(
 	     internal_pool->handles[ entry ],
 	     error ) != 0 )
@@ -1452,6 +1577,8 @@ ssize_t libbfio_pool_read(
 			return( -1 );
 		}
 	}
+	internal_pool->amount_of_reads += 1;
+
 	read_count = libbfio_handle_read(
 	              internal_pool->handles[ entry ],
 	              buffer,
@@ -1576,6 +1703,8 @@ ssize_t libbfio_pool_write(
 			return( -1 );
 		}
 	}
+	internal_pool->amount_of_writes += 1;
+
 	write_count = libbfio_handle_write(
 	               internal_pool->handles[ entry ],
 	               buffer,
@@ -1597,6 +1726,266 @@ ssize_t libbfio_pool_write(
 	return( write_count );
 }
 
+/* Reads from a handle in the pool at a specific offset
+ * The current offset of the handle is not changed
+ * Returns the amount of bytes read or -1 on error
+ */
+ssize_t libbfio_pool_read_at_offset(
+         libbfio_pool_t *pool,
+         int entry,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         liberror_error_t **error )
+{
+	libbfio_internal_pool_t *internal_pool = NULL;
+	static char *function                  = "libbfio_pool_read_at_offset";
+	ssize_t read_count                     = 0;
+	int flags                              = 0;
+	int is_open                            = 0;
+
+	if( pool == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pool.",
+		 function );
+
+		return( -1 );
+	}
+	internal_pool = (libbfio_internal_pool_t *) pool;
+
+	if( internal_pool->handles == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid pool - missing handles.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( entry < 0 )
+	 || ( entry >= internal_pool->amount_of_handles ) )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_OUT_OF_RANGE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+	/* Make sure the handle is open
+	 */
+	is_open = libbfio_handle_is_open(
+	           internal_pool->handles[ entry ],
+	           error );
+
+	if( is_open == -1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if entry: %d is open.",
+		 function,
+	         entry );
+
+		return( -1 );
+	}
+	else if( is_open == 0 )
+	{
+		if( libbfio_handle_get_flags(
+		     internal_pool->handles[ entry ],
+		     &flags,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve flags.",
+			 function );
+
+			return( -1 );
+		}
+		if( libbfio_pool_open_handle(
+		     internal_pool,
+		     internal_pool->handles[ entry ],
+		     flags,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open entry: %d.",
+			 function,
+			 entry );
+
+			return( -1 );
+		}
+	}
+	internal_pool->amount_of_reads += 1;
+
+	read_count = libbfio_handle_read_at_offset(
+	              internal_pool->handles[ entry ],
+	              buffer,
+	              size,
+	              offset,
+	              error );
+
+	if( read_count < 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_IO,
+		 LIBERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read from entry: %d at offset: %" PRIi64 ".",
+		 function,
+		 entry,
+		 offset );
+
+		return( -1 );
+	}
+	return( read_count );
+}
+
+/* Writes to a handle in the pool at a specific offset
+ * The current offset of the handle is not changed
+ * Returns the amount of bytes written or -1 on error
+ */
+ssize_t libbfio_pool_write_at_offset(
+         libbfio_pool_t *pool,
+         int entry,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         liberror_error_t **error )
+{
+	libbfio_internal_pool_t *internal_pool = NULL;
+	static char *function                  = "libbfio_pool_write_at_offset";
+	ssize_t write_count                    = 0;
+	int flags                              = 0;
+	int is_open                            = 0;
+
+	if( pool == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pool.",
+		 function );
+
+		return( -1 );
+	}
+	internal_pool = (libbfio_internal_pool_t *) pool;
+
+	if( internal_pool->handles == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid pool - missing handles.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( entry < 0 )
+	 || ( entry >= internal_pool->amount_of_handles ) )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_OUT_OF_RANGE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+	/* Make sure the handle is open
+	 */
+	is_open = libbfio_handle_is_open(
+	           internal_pool->handles[ entry ],
+	           error );
+
+	if( is_open == -1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if entry: %d is open.",
+		 function,
+	         entry );
+
+		return( -1 );
+	}
+	else if( is_open == 0 )
+	{
+		if( libbfio_handle_get_flags(
+		     internal_pool->handles[ entry ],
+		     &flags,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve flags.",
+			 function );
+
+			return( -1 );
+		}
+		if( libbfio_pool_open_handle(
+		     internal_pool,
+		     internal_pool->handles[ entry ],
+		     flags,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open entry: %d.",
+			 function,
+			 entry );
+
+			return( -1 );
+		}
+	}
+	internal_pool->amount_of_writes += 1;
+
+	write_count = libbfio_handle_write_at_offset(
+	               internal_pool->handles[ entry ],
+	               buffer,
+	               size,
+	               offset,
+	               error );
+
+	if( write_count < 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_IO,
+		 LIBERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write to entry: %d at offset: %" PRIi64 ".",
+		 function,
+		 entry,
+		 offset );
+
+		return( -1 );
+	}
+	return( write_count );
+}
+
 /* Seeks an offset in a handle in the pool
  * Returns the offset if successful or -1 on error
  */
@@ -1700,6 +2089,8 @@ off64_t libbfio_pool_seek_offset(
 			return( -1 );
 		}
 	}
+	internal_pool->amount_of_seeks += 1;
+
 	seek_offset = libbfio_handle_seek_offset(
 	               internal_pool->handles[ entry ],
 	               offset,
@@ -1997,3 +2388,96 @@ int libbfio_pool_get_amount_of_handles(
 	return( 1 );
 }
 
+/* Retrieves the amount of reads, writes, seeks, opens and closes
+ * of the handles in the pool
+ * Returns 1 if successful or -1 on error
+ */
+int libbfio_pool_get_statistics(
+     libbfio_pool_t *pool,
+     uint64_t *amount_of_reads,
+     uint64_t *amount_of_writes,
+     uint64_t *amount_of_seeks,
+     uint64_t *amount_of_opens,
+     uint64_t *amount_of_closes,
+     liberror_error_t **error )
+{
+	libbfio_internal_pool_t *internal_pool = NULL;
+	static char *function                  = "libbfio_pool_get_statistics";
+
+	if( pool == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pool.",
+		 function );
+
+		return( -1 );
+	}
+	internal_pool = (libbfio_internal_pool_t *) pool;
+
+	if( amount_of_reads == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid amount of reads.",
+		 function );
+
+		return( -1 );
+	}
+	if( amount_of_writes == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid amount of writes.",
+		 function );
+
+		return( -1 );
+	}
+	if( amount_of_seeks == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid amount of seeks.",
+		 function );
+
+		return( -1 );
+	}
+	if( amount_of_opens == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid amount of opens.",
+		 function );
+
+		return( -1 );
+	}
+	if( amount_of_closes == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid amount of closes.",
+		 function );
+
+		return( -1 );
+	}
+	*amount_of_reads  = internal_pool->amount_of_reads;
+	*amount_of_writes = internal_pool->amount_of_writes;
+	*amount_of_seeks  = internal_pool->amount_of_seeks;
+	*amount_of_opens  = internal_pool->amount_of_opens;
+	*amount_of_closes = internal_pool->amount_of_closes;
+
+	return( 1 );
+}
+
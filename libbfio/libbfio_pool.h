@@ -67,6 +67,15 @@ struct libbfio_internal_pool
 	 * the value of the list element refers to the corresponding file io handle
 	 */
 	libbfio_list_t *last_used_list;
+
+	/* The amount of reads, writes, seeks, opens and closes
+	 * of the handles in the pool
+	 */
+	uint64_t amount_of_reads;
+	uint64_t amount_of_writes;
+	uint64_t amount_of_seeks;
+	uint64_t amount_of_opens;
+	uint64_t amount_of_closes;
 };
 
 LIBBFIO_EXTERN int libbfio_pool_initialize(
@@ -106,6 +115,12 @@ LIBBFIO_EXTERN int libbfio_pool_get_handle(
                     libbfio_handle_t **handle,
                     liberror_error_t **error );
 
+LIBBFIO_EXTERN int libbfio_pool_get_handle_for_concurrent_read(
+                    libbfio_pool_t *pool,
+                    int entry,
+                    libbfio_handle_t **handle,
+                    liberror_error_t **error );
+
 LIBBFIO_EXTERN int libbfio_pool_add_handle(
                     libbfio_pool_t *pool,
                     int *entry,
@@ -155,6 +170,22 @@ LIBBFIO_EXTERN ssize_t libbfio_pool_write(
                         size_t size,
                         liberror_error_t **error );
 
+LIBBFIO_EXTERN ssize_t libbfio_pool_read_at_offset(
+                        libbfio_pool_t *pool,
+                        int entry,
+                        uint8_t *buffer,
+                        size_t size,
+                        off64_t offset,
+                        liberror_error_t **error );
+
+LIBBFIO_EXTERN ssize_t libbfio_pool_write_at_offset(
+                        libbfio_pool_t *pool,
+                        int entry,
+                        uint8_t *buffer,
+                        size_t size,
+                        off64_t offset,
+                        liberror_error_t **error );
+
 LIBBFIO_EXTERN off64_t libbfio_pool_seek_offset(
                         libbfio_pool_t *pool,
                         int entry,
@@ -179,6 +210,15 @@ LIBBFIO_EXTERN int libbfio_pool_get_amount_of_handles(
                     int *amount_of_handles,
                     liberror_error_t **error );
 
+LIBBFIO_EXTERN int libbfio_pool_get_statistics(
+                    libbfio_pool_t *pool,
+                    uint64_t *amount_of_reads,
+                    uint64_t *amount_of_writes,
+                    uint64_t *amount_of_seeks,
+                    uint64_t *amount_of_opens,
+                    uint64_t *amount_of_closes,
+                    liberror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -72,6 +72,7 @@ rm -rf ${RPM_BUILD_ROOT}
 %doc AUTHORS COPYING NEWS README
 %attr(755,root,root) %{_bindir}/ewfacquire
 %attr(755,root,root) %{_bindir}/ewfacquirestream
+%attr(755,root,root) %{_bindir}/ewfbench
 %attr(755,root,root) %{_bindir}/ewfexport
 %attr(755,root,root) %{_bindir}/ewfinfo
 %attr(755,root,root) %{_bindir}/ewfverify
@@ -26,9 +26,7 @@
 #include <common.h>
 #include <types.h>
 
-#if defined( HAVE_ZLIB_H ) || defined( ZLIB_DLL )
-#include <zlib.h>
-#endif
+#include "libewf_checksum.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -39,8 +37,10 @@ extern "C" {
  */
 typedef uint32_t ewf_crc_t;
 
+/* The Adler-32 is calculated by libewf to allow for SIMD optimized versions
+ */
 #define ewf_crc_calculate( buffer, size, previous_key ) \
-	(ewf_crc_t) adler32( (uLong) previous_key, (const Bytef *) buffer, (uInt) size );
+	(ewf_crc_t) libewf_checksum_calculate_adler32( (const uint8_t *) buffer, (size_t) size, (uint32_t) previous_key )
 
 #if defined( __cplusplus )
 }
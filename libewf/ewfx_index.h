@@ -0,0 +1,162 @@
+/*
+ * libewf EWF eXtention offset table index
+ *
+ * Copyright (c) 2006-2009, Joachim Metz <forensics@hoffmannbv.nl>,
+ * Hoffmann Investigations.
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _EWFX_INDEX_H )
+#define _EWFX_INDEX_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct ewfx_index_header ewfx_index_header_t;
+typedef struct ewfx_index_segment ewfx_index_segment_t;
+typedef struct ewfx_index_table ewfx_index_table_t;
+typedef struct ewfx_index_chunk ewfx_index_chunk_t;
+
+/* The index file contains the header
+ * followed by the segment, table and chunk entries
+ * and is terminated by a 4 byte CRC of all previous data
+ */
+struct ewfx_index_header
+{
+	/* The index file signature
+	 * consists of 8 bytes
+	 */
+	uint8_t signature[ 8 ];
+
+	/* The format version
+	 * consists of 4 bytes (32 bits)
+	 */
+	uint8_t version[ 4 ];
+
+	/* The amount of segment files
+	 * consists of 4 bytes (32 bits)
+	 */
+	uint8_t amount_of_segments[ 4 ];
+
+	/* The amount of table sections
+	 * consists of 4 bytes (32 bits)
+	 */
+	uint8_t amount_of_tables[ 4 ];
+
+	/* The amount of chunks
+	 * consists of 4 bytes (32 bits)
+	 */
+	uint8_t amount_of_chunks[ 4 ];
+
+	/* The CRC of the header, header2 and xheader section data
+	 * consists of 4 bytes (32 bits)
+	 */
+	uint8_t header_sections_crc[ 4 ];
+
+	/* The CRC of the hash and xhash section data
+	 * consists of 4 bytes (32 bits)
+	 */
+	uint8_t hash_sections_crc[ 4 ];
+
+	/* The CRC of the header data
+	 * consists of 4 bytes
+	 */
+	uint8_t crc[ 4 ];
+};
+
+struct ewfx_index_segment
+{
+	/* The size of the segment file
+	 * consists of 8 bytes (64 bits)
+	 */
+	uint8_t file_size[ 8 ];
+};
+
+struct ewfx_index_table
+{
+	/* The file offset of the table offsets
+	 * consists of 8 bytes (64 bits)
+	 */
+	uint8_t offsets_file_offset[ 8 ];
+
+	/* The first chunk in the table
+	 * consists of 4 bytes (32 bits)
+	 */
+	uint8_t first_chunk[ 4 ];
+
+	/* The amount of chunks in the table
+	 * consists of 4 bytes (32 bits)
+	 */
+	uint8_t amount_of_chunks[ 4 ];
+
+	/* The number of the segment file that contains the table
+	 * consists of 2 bytes (16 bits)
+	 */
+	uint8_t segment_number[ 2 ];
+
+	/* Padding
+	 * consists of 2 bytes
+	 * value should be 0x00
+	 */
+	uint8_t padding[ 2 ];
+
+	/* The CRC of the table section header
+	 * consists of 4 bytes (32 bits)
+	 */
+	uint8_t table_crc[ 4 ];
+
+	/* The CRC stored after the table offsets
+	 * consists of 4 bytes (32 bits)
+	 * value is 0 for the EWF-S01 format which does not contain it
+	 */
+	uint8_t offsets_crc[ 4 ];
+};
+
+struct ewfx_index_chunk
+{
+	/* The file offset of the chunk
+	 * consists of 8 bytes (64 bits)
+	 */
+	uint8_t file_offset[ 8 ];
+
+	/* The size of the chunk
+	 * consists of 4 bytes (32 bits)
+	 */
+	uint8_t size[ 4 ];
+
+	/* The chunk offset flags
+	 * consists of 1 byte
+	 */
+	uint8_t flags;
+
+	/* Padding
+	 * consists of 3 bytes
+	 * value should be 0x00
+	 */
+	uint8_t padding[ 3 ];
+};
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif
+
@@ -0,0 +1,236 @@
+/*
+ * Checksum functions
+ *
+ * Copyright (c) 2006-2009, Joachim Metz <forensics@hoffmannbv.nl>,
+ * Hoffmann Investigations.
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <types.h>
+
+#if defined( HAVE_ZLIB_H ) || defined( ZLIB_DLL )
+#include <zlib.h>
+#endif
+
+#include "libewf_checksum.h"
+
+#if defined( HAVE_SIMD_SUPPORT )
+#include <emmintrin.h>
+#include <immintrin.h>
+#endif
+
+/* The largest prime smaller than 65536
+ */
+#define LIBEWF_CHECKSUM_ADLER32_BASE		65521
+
+/* The largest amount of bytes that can be added before the sums
+ * need to be reduced, so that they do not overflow 32-bit
+ */
+#define LIBEWF_CHECKSUM_ADLER32_MAXIMUM_SIZE	5552
+
+#if defined( HAVE_SIMD_SUPPORT )
+
+/* Calculates the Adler-32 of the buffer using SSSE3
+ * Sums 32 bytes per iteration, the remainder is calculated by zlib
+ * Returns the Adler-32
+ */
+__attribute__((target("ssse3")))
+uint32_t libewf_checksum_calculate_adler32_ssse3(
+          const uint8_t *buffer,
+          size_t size,
+          uint32_t initial_value )
+{
+	__m128i bytes1          = _mm_setzero_si128();
+	__m128i bytes2          = _mm_setzero_si128();
+	__m128i previous_sums1  = _mm_setzero_si128();
+	__m128i sums1           = _mm_setzero_si128();
+	__m128i sums2           = _mm_setzero_si128();
+	const __m128i ones      = _mm_set1_epi16( 1 );
+	const __m128i weights1  = _mm_setr_epi8( 32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17 );
+	const __m128i weights2  = _mm_setr_epi8( 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1 );
+	const __m128i zero      = _mm_setzero_si128();
+	uint32_t sum1           = initial_value & 0xffff;
+	uint32_t sum2           = initial_value >> 16;
+	size_t amount_of_blocks = 0;
+
+	while( size >= 32 )
+	{
+		amount_of_blocks = LIBEWF_CHECKSUM_ADLER32_MAXIMUM_SIZE / 32;
+
+		if( amount_of_blocks > ( size / 32 ) )
+		{
+			amount_of_blocks = size / 32;
+		}
+		size -= amount_of_blocks * 32;
+
+		/* Every block adds 32 times the sum1 at the start of the block to sum2
+		 */
+		previous_sums1 = _mm_set_epi32( 0, 0, 0, (int) ( sum1 * amount_of_blocks ) );
+		sums1          = _mm_setzero_si128();
+		sums2          = _mm_set_epi32( 0, 0, 0, (int) sum2 );
+
+		while( amount_of_blocks > 0 )
+		{
+			bytes1 = _mm_loadu_si128( (const __m128i *) buffer );
+			bytes2 = _mm_loadu_si128( (const __m128i *) &( buffer[ 16 ] ) );
+
+			previous_sums1 = _mm_add_epi32( previous_sums1, sums1 );
+
+			sums1 = _mm_add_epi32( sums1, _mm_sad_epu8( bytes1, zero ) );
+			sums1 = _mm_add_epi32( sums1, _mm_sad_epu8( bytes2, zero ) );
+
+			sums2 = _mm_add_epi32( sums2, _mm_madd_epi16( _mm_maddubs_epi16( bytes1, weights1 ), ones ) );
+			sums2 = _mm_add_epi32( sums2, _mm_madd_epi16( _mm_maddubs_epi16( bytes2, weights2 ), ones ) );
+
+			buffer           += 32;
+			amount_of_blocks -= 1;
+		}
+		sums2 = _mm_add_epi32( sums2, _mm_slli_epi32( previous_sums1, 5 ) );
+
+		sums1 = _mm_add_epi32( sums1, _mm_shuffle_epi32( sums1, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+		sums2 = _mm_add_epi32( sums2, _mm_shuffle_epi32( sums2, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+		sums2 = _mm_add_epi32( sums2, _mm_shuffle_epi32( sums2, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+
+		sum1 = ( sum1 + (uint32_t) _mm_cvtsi128_si32( sums1 ) ) % LIBEWF_CHECKSUM_ADLER32_BASE;
+		sum2 = (uint32_t) _mm_cvtsi128_si32( sums2 ) % LIBEWF_CHECKSUM_ADLER32_BASE;
+	}
+	return( (uint32_t) adler32(
+	                    (uLong) ( ( sum2 << 16 ) | sum1 ),
+	                    (const Bytef *) buffer,
+	                    (uInt) size ) );
+}
+
+/* Calculates the Adler-32 of the buffer using AVX2
+ * Sums 64 bytes per iteration, the remainder is calculated by zlib
+ * Returns the Adler-32
+ */
+__attribute__((target("avx2")))
+uint32_t libewf_checksum_calculate_adler32_avx2(
+          const uint8_t *buffer,
+          size_t size,
+          uint32_t initial_value )
+{
+	__m256i bytes1          = _mm256_setzero_si256();
+	__m256i bytes2          = _mm256_setzero_si256();
+	__m256i previous_sums1  = _mm256_setzero_si256();
+	__m256i sums1           = _mm256_setzero_si256();
+	__m256i sums2           = _mm256_setzero_si256();
+	__m128i sums1_128bit    = _mm_setzero_si128();
+	__m128i sums2_128bit    = _mm_setzero_si128();
+	const __m256i ones      = _mm256_set1_epi16( 1 );
+	const __m256i weights1  = _mm256_setr_epi8(
+	                           64, 63, 62, 61, 60, 59, 58, 57, 56, 55, 54, 53, 52, 51, 50, 49,
+	                           48, 47, 46, 45, 44, 43, 42, 41, 40, 39, 38, 37, 36, 35, 34, 33 );
+	const __m256i weights2  = _mm256_setr_epi8(
+	                           32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17,
+	                           16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1 );
+	const __m256i zero      = _mm256_setzero_si256();
+	uint32_t sum1           = initial_value & 0xffff;
+	uint32_t sum2           = initial_value >> 16;
+	size_t amount_of_blocks = 0;
+
+	while( size >= 64 )
+	{
+		amount_of_blocks = LIBEWF_CHECKSUM_ADLER32_MAXIMUM_SIZE / 64;
+
+		if( amount_of_blocks > ( size / 64 ) )
+		{
+			amount_of_blocks = size / 64;
+		}
+		size -= amount_of_blocks * 64;
+
+		/* Every block adds 64 times the sum1 at the start of the block to sum2
+		 */
+		previous_sums1 = _mm256_set_epi32( 0, 0, 0, 0, 0, 0, 0, (int) ( sum1 * amount_of_blocks ) );
+		sums1          = _mm256_setzero_si256();
+		sums2          = _mm256_set_epi32( 0, 0, 0, 0, 0, 0, 0, (int) sum2 );
+
+		while( amount_of_blocks > 0 )
+		{
+			bytes1 = _mm256_loadu_si256( (const __m256i *) buffer );
+			bytes2 = _mm256_loadu_si256( (const __m256i *) &( buffer[ 32 ] ) );
+
+			previous_sums1 = _mm256_add_epi32( previous_sums1, sums1 );
+
+			sums1 = _mm256_add_epi32( sums1, _mm256_sad_epu8( bytes1, zero ) );
+			sums1 = _mm256_add_epi32( sums1, _mm256_sad_epu8( bytes2, zero ) );
+
+			sums2 = _mm256_add_epi32( sums2, _mm256_madd_epi16( _mm256_maddubs_epi16( bytes1, weights1 ), ones ) );
+			sums2 = _mm256_add_epi32( sums2, _mm256_madd_epi16( _mm256_maddubs_epi16( bytes2, weights2 ), ones ) );
+
+			buffer           += 64;
+			amount_of_blocks -= 1;
+		}
+		sums2 = _mm256_add_epi32( sums2, _mm256_slli_epi32( previous_sums1, 6 ) );
+
+		sums1_128bit = _mm_add_epi32(
+		                _mm256_castsi256_si128( sums1 ),
+		                _mm256_extracti128_si256( sums1, 1 ) );
+		sums2_128bit = _mm_add_epi32(
+		                _mm256_castsi256_si128( sums2 ),
+		                _mm256_extracti128_si256( sums2, 1 ) );
+
+		sums1_128bit = _mm_add_epi32( sums1_128bit, _mm_shuffle_epi32( sums1_128bit, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+		sums2_128bit = _mm_add_epi32( sums2_128bit, _mm_shuffle_epi32( sums2_128bit, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+		sums2_128bit = _mm_add_epi32( sums2_128bit, _mm_shuffle_epi32( sums2_128bit, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+
+		sum1 = ( sum1 + (uint32_t) _mm_cvtsi128_si32( sums1_128bit ) ) % LIBEWF_CHECKSUM_ADLER32_BASE;
+		sum2 = (uint32_t) _mm_cvtsi128_si32( sums2_128bit ) % LIBEWF_CHECKSUM_ADLER32_BASE;
+	}
+	return( (uint32_t) adler32(
+	                    (uLong) ( ( sum2 << 16 ) | sum1 ),
+	                    (const Bytef *) buffer,
+	                    (uInt) size ) );
+}
+
+#endif
+
+/* Calculates the Adler-32 of the buffer
+ * Returns the Adler-32
+ */
+uint32_t libewf_checksum_calculate_adler32(
+          const uint8_t *buffer,
+          size_t size,
+          uint32_t initial_value )
+{
+#if defined( HAVE_SIMD_SUPPORT )
+	int instruction_set = 0;
+
+	instruction_set = libewf_cpuid_get_instruction_set();
+
+	if( instruction_set == LIBEWF_CPUID_INSTRUCTION_SET_AVX2 )
+	{
+		return( libewf_checksum_calculate_adler32_avx2(
+		         buffer,
+		         size,
+		         initial_value ) );
+	}
+	else if( instruction_set == LIBEWF_CPUID_INSTRUCTION_SET_SSSE3 )
+	{
+		return( libewf_checksum_calculate_adler32_ssse3(
+		         buffer,
+		         size,
+		         initial_value ) );
+	}
+#endif
+	return( (uint32_t) adler32(
+	                    (uLong) initial_value,
+	                    (const Bytef *) buffer,
+	                    (uInt) size ) );
+}
+
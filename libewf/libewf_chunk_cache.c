@@ -27,6 +27,7 @@
 #include <liberror.h>
 
 #include "libewf_chunk_cache.h"
+#include "libewf_definitions.h"
 
 /* Initialize the chunk cache
  * Returns 1 if successful or -1 on error
@@ -135,7 +136,33 @@ int libewf_chunk_cache_initialize(
 
 			return( -1 );
 		}
-		( *chunk_cache )->allocated_size = size;
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( thread_read_write_lock_initialize(
+		     &( ( *chunk_cache )->read_write_lock ) ) != 0 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize read/write lock.",
+			 function );
+
+			memory_free(
+			 ( *chunk_cache )->data );
+			memory_free(
+			 ( *chunk_cache )->compressed );
+			memory_free(
+			 *chunk_cache );
+
+			*chunk_cache = NULL;
+
+			return( -1 );
+		}
+#endif
+		( *chunk_cache )->allocated_size            = size;
+		( *chunk_cache )->maximum_cache_size        = LIBEWF_DEFAULT_MAXIMUM_CACHE_SIZE;
+		( *chunk_cache )->most_recently_used_entry  = -1;
+		( *chunk_cache )->least_recently_used_entry = -1;
 	}
 	return( 1 );
 }
@@ -148,6 +175,7 @@ int libewf_chunk_cache_free(
      liberror_error_t **error )
 {
 	static char *function = "libewf_chunk_cache_free";
+	int result            = 1;
 
 	if( chunk_cache == NULL )
 	{
@@ -162,6 +190,19 @@ int libewf_chunk_cache_free(
 	}
 	if( *chunk_cache != NULL )
 	{
+		if( libewf_chunk_cache_empty(
+		     *chunk_cache,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to empty chunk cache.",
+			 function );
+
+			result = -1;
+		}
 		if( ( *chunk_cache )->compressed != NULL )
 		{
 			memory_free(
@@ -177,12 +218,26 @@ int libewf_chunk_cache_free(
 			memory_free(
 			 ( *chunk_cache )->zero_byte_empty_block_compressed );
 		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( thread_read_write_lock_free(
+		     &( ( *chunk_cache )->read_write_lock ) ) != 0 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read/write lock.",
+			 function );
+
+			result = -1;
+		}
+#endif
 		memory_free(
 		 *chunk_cache );
 
 		*chunk_cache = NULL;
 	}
-	return( 1 );
+	return( result );
 }
 
 /* Resizes the chunk cache
@@ -256,8 +311,1078 @@ int libewf_chunk_cache_resize(
 		chunk_cache->chunk          = 0;
 		chunk_cache->amount         = 0;
 		chunk_cache->offset         = 0;
-		chunk_cache->cached         = 0;
 	}
 	return( 1 );
 }
 
+
+
+/* Empties the chunk cache
+ * Frees the cache entries, these are recreated on demand
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_empty(
+     libewf_chunk_cache_t *chunk_cache,
+     liberror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_empty";
+	int entry_index       = 0;
+
+	if( chunk_cache == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_cache->entries != NULL )
+	{
+		for( entry_index = 0;
+		     entry_index < chunk_cache->amount_of_entries;
+		     entry_index++ )
+		{
+			if( chunk_cache->entries[ entry_index ].data != NULL )
+			{
+				memory_free(
+				 chunk_cache->entries[ entry_index ].data );
+			}
+		}
+		memory_free(
+		 chunk_cache->entries );
+
+		chunk_cache->entries = NULL;
+	}
+	if( chunk_cache->hash_buckets != NULL )
+	{
+		memory_free(
+		 chunk_cache->hash_buckets );
+
+		chunk_cache->hash_buckets = NULL;
+	}
+	chunk_cache->entry_size                = 0;
+	chunk_cache->amount_of_entries         = 0;
+	chunk_cache->amount_of_hash_buckets    = 0;
+	chunk_cache->most_recently_used_entry  = -1;
+	chunk_cache->least_recently_used_entry = -1;
+
+	return( 1 );
+}
+
+/* Sets the maximum amount of bytes used by the cache entries
+ * The cache always contains at least a single entry
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_set_maximum_cache_size(
+     libewf_chunk_cache_t *chunk_cache,
+     size_t maximum_cache_size,
+     liberror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_set_maximum_cache_size";
+
+	if( chunk_cache == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_cache_size > (size_t) SSIZE_MAX )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid maximum cache size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	/* The cache entries are recreated using the new maximum cache size
+	 */
+	if( libewf_chunk_cache_empty(
+	     chunk_cache,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_cache->maximum_cache_size = maximum_cache_size;
+
+	return( 1 );
+}
+
+/* Finds the cache entry for a specific chunk
+ * Returns 1 if successful, 0 if no such entry or -1 on error
+ */
+int libewf_chunk_cache_find_entry(
+     libewf_chunk_cache_t *chunk_cache,
+     uint32_t chunk,
+     int *entry_index,
+     liberror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_find_entry";
+	int hash_entry_index  = 0;
+
+	if( chunk_cache == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry_index == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry index.",
+		 function );
+
+		return( -1 );
+	}
+	*entry_index = -1;
+
+	if( ( chunk_cache->entries == NULL )
+	 || ( chunk_cache->hash_buckets == NULL ) )
+	{
+		return( 0 );
+	}
+	hash_entry_index = chunk_cache->hash_buckets[ chunk & (uint32_t) ( chunk_cache->amount_of_hash_buckets - 1 ) ];
+
+	while( hash_entry_index != -1 )
+	{
+		if( chunk_cache->entries[ hash_entry_index ].chunk == chunk )
+		{
+			*entry_index = hash_entry_index;
+
+			return( 1 );
+		}
+		hash_entry_index = chunk_cache->entries[ hash_entry_index ].next_hash_entry;
+	}
+	return( 0 );
+}
+
+/* Unlinks a cache entry from its hash bucket and from the recently used list
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_unlink_entry(
+     libewf_chunk_cache_t *chunk_cache,
+     int entry_index,
+     liberror_error_t **error )
+{
+	libewf_chunk_cache_entry_t *entry = NULL;
+	static char *function             = "libewf_chunk_cache_unlink_entry";
+	int *hash_entry_index             = NULL;
+
+	if( chunk_cache == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_cache->entries == NULL )
+	 || ( chunk_cache->hash_buckets == NULL ) )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid chunk cache - missing entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( entry_index < 0 )
+	 || ( entry_index >= chunk_cache->amount_of_entries ) )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_OUT_OF_RANGE,
+		 "%s: invalid entry index value out of range.",
+		 function );
+
+		return( -1 );
+	}
+	entry = &( chunk_cache->entries[ entry_index ] );
+
+	/* An entry that was never assigned a chunk is not part of a hash bucket
+	 * in which case the entry index is not found
+	 */
+	hash_entry_index = &( chunk_cache->hash_buckets[ entry->chunk & (uint32_t) ( chunk_cache->amount_of_hash_buckets - 1 ) ] );
+
+	while( *hash_entry_index != -1 )
+	{
+		if( *hash_entry_index == entry_index )
+		{
+			*hash_entry_index = entry->next_hash_entry;
+
+			break;
+		}
+		hash_entry_index = &( chunk_cache->entries[ *hash_entry_index ].next_hash_entry );
+	}
+	entry->next_hash_entry = -1;
+
+	if( entry->previous_entry != -1 )
+	{
+		chunk_cache->entries[ entry->previous_entry ].next_entry = entry->next_entry;
+	}
+	else if( chunk_cache->most_recently_used_entry == entry_index )
+	{
+		chunk_cache->most_recently_used_entry = entry->next_entry;
+	}
+	if( entry->next_entry != -1 )
+	{
+		chunk_cache->entries[ entry->next_entry ].previous_entry = entry->previous_entry;
+	}
+	else if( chunk_cache->least_recently_used_entry == entry_index )
+	{
+		chunk_cache->least_recently_used_entry = entry->previous_entry;
+	}
+	entry->previous_entry = -1;
+	entry->next_entry     = -1;
+
+	return( 1 );
+}
+
+/* Links an unlinked cache entry into the hash bucket of its chunk
+ * and either in front (most recently used) or at the back (least recently used) of the recently used list
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_link_entry(
+     libewf_chunk_cache_t *chunk_cache,
+     int entry_index,
+     uint8_t most_recently_used,
+     liberror_error_t **error )
+{
+	libewf_chunk_cache_entry_t *entry = NULL;
+	static char *function             = "libewf_chunk_cache_link_entry";
+	int hash_bucket                   = 0;
+
+	if( chunk_cache == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_cache->entries == NULL )
+	 || ( chunk_cache->hash_buckets == NULL ) )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid chunk cache - missing entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( entry_index < 0 )
+	 || ( entry_index >= chunk_cache->amount_of_entries ) )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_OUT_OF_RANGE,
+		 "%s: invalid entry index value out of range.",
+		 function );
+
+		return( -1 );
+	}
+	entry = &( chunk_cache->entries[ entry_index ] );
+
+	/* Entries that do not contain a chunk are kept out of the hash buckets
+	 */
+	if( entry->cached != 0 )
+	{
+		hash_bucket = (int) ( entry->chunk & (uint32_t) ( chunk_cache->amount_of_hash_buckets - 1 ) );
+
+		entry->next_hash_entry                    = chunk_cache->hash_buckets[ hash_bucket ];
+		chunk_cache->hash_buckets[ hash_bucket ] = entry_index;
+	}
+	if( most_recently_used != 0 )
+	{
+		entry->previous_entry = -1;
+		entry->next_entry     = chunk_cache->most_recently_used_entry;
+
+		if( chunk_cache->most_recently_used_entry != -1 )
+		{
+			chunk_cache->entries[ chunk_cache->most_recently_used_entry ].previous_entry = entry_index;
+		}
+		chunk_cache->most_recently_used_entry = entry_index;
+
+		if( chunk_cache->least_recently_used_entry == -1 )
+		{
+			chunk_cache->least_recently_used_entry = entry_index;
+		}
+	}
+	else
+	{
+		entry->previous_entry = chunk_cache->least_recently_used_entry;
+		entry->next_entry     = -1;
+
+		if( chunk_cache->least_recently_used_entry != -1 )
+		{
+			chunk_cache->entries[ chunk_cache->least_recently_used_entry ].next_entry = entry_index;
+		}
+		chunk_cache->least_recently_used_entry = entry_index;
+
+		if( chunk_cache->most_recently_used_entry == -1 )
+		{
+			chunk_cache->most_recently_used_entry = entry_index;
+		}
+	}
+	return( 1 );
+}
+
+/* Retrieves the cache entry of a specific chunk
+ * The entry becomes the most recently used entry
+ * Returns 1 if successful, 0 if the chunk is not cached or -1 on error
+ */
+int libewf_chunk_cache_get_entry(
+     libewf_chunk_cache_t *chunk_cache,
+     uint32_t chunk,
+     libewf_chunk_cache_entry_t **entry,
+     liberror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_get_entry";
+	int entry_index       = 0;
+	int result            = 0;
+
+	if( chunk_cache == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+	*entry = NULL;
+
+	result = libewf_chunk_cache_find_entry(
+	          chunk_cache,
+	          chunk,
+	          &entry_index,
+	          error );
+
+	if( result == -1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to find entry for chunk: %" PRIu32 ".",
+		 function,
+		 chunk );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( chunk_cache->entries[ entry_index ].cached == 0 )
+	{
+		return( 0 );
+	}
+	if( chunk_cache->most_recently_used_entry != entry_index )
+	{
+		if( libewf_chunk_cache_unlink_entry(
+		     chunk_cache,
+		     entry_index,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to unlink entry: %d.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+		if( libewf_chunk_cache_link_entry(
+		     chunk_cache,
+		     entry_index,
+		     1,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to link entry: %d.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+	}
+	*entry = &( chunk_cache->entries[ entry_index ] );
+
+	return( 1 );
+}
+
+/* Sets the cache entry of a specific chunk
+ * Reuses the entry of the chunk if present otherwise evicts the least recently used entry
+ * The entry data buffer is of at least entry size and the entry becomes the most recently used entry
+ * The entry is marked as cached, if the data cannot be provided the entry should be removed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_set_entry(
+     libewf_chunk_cache_t *chunk_cache,
+     uint32_t chunk,
+     size_t entry_size,
+     libewf_chunk_cache_entry_t **entry,
+     liberror_error_t **error )
+{
+	void *reallocation       = NULL;
+	static char *function    = "libewf_chunk_cache_set_entry";
+	size_t amount_of_entries = 0;
+	int entry_index          = 0;
+	int result               = 0;
+
+	if( chunk_cache == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( entry_size == 0 )
+	 || ( entry_size > (size_t) SSIZE_MAX ) )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_OUT_OF_RANGE,
+		 "%s: invalid entry size value out of range.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+	*entry = NULL;
+
+	/* Larger entries reduce the amount of entries that fit within the maximum cache size
+	 */
+	if( ( chunk_cache->entries != NULL )
+	 && ( entry_size > chunk_cache->entry_size ) )
+	{
+		if( libewf_chunk_cache_empty(
+		     chunk_cache,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to empty chunk cache.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( chunk_cache->entries == NULL )
+	{
+		amount_of_entries = chunk_cache->maximum_cache_size / entry_size;
+
+		if( amount_of_entries == 0 )
+		{
+			amount_of_entries = 1;
+		}
+		else if( amount_of_entries > (size_t) ( INT16_MAX + 1 ) )
+		{
+			amount_of_entries = (size_t) ( INT16_MAX + 1 );
+		}
+		chunk_cache->entries = (libewf_chunk_cache_entry_t *) memory_allocate(
+		                                                       sizeof( libewf_chunk_cache_entry_t ) * amount_of_entries );
+
+		if( chunk_cache->entries == NULL )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_MEMORY,
+			 LIBERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create entries.",
+			 function );
+
+			return( -1 );
+		}
+		if( memory_set(
+		     chunk_cache->entries,
+		     0,
+		     sizeof( libewf_chunk_cache_entry_t ) * amount_of_entries ) == NULL )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_MEMORY,
+			 LIBERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear entries.",
+			 function );
+
+			memory_free(
+			 chunk_cache->entries );
+
+			chunk_cache->entries = NULL;
+
+			return( -1 );
+		}
+		/* Use a power of 2 for the amount of hash buckets
+		 */
+		chunk_cache->amount_of_hash_buckets = 1;
+
+		while( (size_t) chunk_cache->amount_of_hash_buckets < amount_of_entries )
+		{
+			chunk_cache->amount_of_hash_buckets *= 2;
+		}
+		chunk_cache->hash_buckets = (int *) memory_allocate(
+		                                     sizeof( int ) * chunk_cache->amount_of_hash_buckets );
+
+		if( chunk_cache->hash_buckets == NULL )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_MEMORY,
+			 LIBERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create hash buckets.",
+			 function );
+
+			memory_free(
+			 chunk_cache->entries );
+
+			chunk_cache->entries                = NULL;
+			chunk_cache->amount_of_hash_buckets = 0;
+
+			return( -1 );
+		}
+		for( entry_index = 0;
+		     entry_index < chunk_cache->amount_of_hash_buckets;
+		     entry_index++ )
+		{
+			chunk_cache->hash_buckets[ entry_index ] = -1;
+		}
+		chunk_cache->amount_of_entries = (int) amount_of_entries;
+		chunk_cache->entry_size        = entry_size;
+
+		/* Initially all the entries are in the recently used list in order of their index
+		 */
+		for( entry_index = 0;
+		     entry_index < chunk_cache->amount_of_entries;
+		     entry_index++ )
+		{
+			chunk_cache->entries[ entry_index ].previous_entry  = entry_index - 1;
+			chunk_cache->entries[ entry_index ].next_entry      = entry_index + 1;
+			chunk_cache->entries[ entry_index ].next_hash_entry = -1;
+		}
+		chunk_cache->entries[ chunk_cache->amount_of_entries - 1 ].next_entry = -1;
+
+		chunk_cache->most_recently_used_entry  = 0;
+		chunk_cache->least_recently_used_entry = chunk_cache->amount_of_entries - 1;
+	}
+	result = libewf_chunk_cache_find_entry(
+	          chunk_cache,
+	          chunk,
+	          &entry_index,
+	          error );
+
+	if( result == -1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to find entry for chunk: %" PRIu32 ".",
+		 function,
+		 chunk );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		entry_index = chunk_cache->least_recently_used_entry;
+	}
+	if( libewf_chunk_cache_unlink_entry(
+	     chunk_cache,
+	     entry_index,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_REMOVE_FAILED,
+		 "%s: unable to unlink entry: %d.",
+		 function,
+		 entry_index );
+
+		return( -1 );
+	}
+	chunk_cache->entries[ entry_index ].chunk  = chunk;
+	chunk_cache->entries[ entry_index ].amount = 0;
+	chunk_cache->entries[ entry_index ].cached = 0;
+
+	if( chunk_cache->entries[ entry_index ].allocated_size < chunk_cache->entry_size )
+	{
+		reallocation = memory_reallocate(
+		                chunk_cache->entries[ entry_index ].data,
+		                sizeof( uint8_t ) * chunk_cache->entry_size );
+
+		if( reallocation == NULL )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_MEMORY,
+			 LIBERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize entry: %d data.",
+			 function,
+			 entry_index );
+
+			/* Keep the unused entry in the recently used list
+			 */
+			libewf_chunk_cache_link_entry(
+			 chunk_cache,
+			 entry_index,
+			 0,
+			 NULL );
+
+			return( -1 );
+		}
+		chunk_cache->entries[ entry_index ].data           = (uint8_t *) reallocation;
+		chunk_cache->entries[ entry_index ].allocated_size = chunk_cache->entry_size;
+	}
+	chunk_cache->entries[ entry_index ].cached = 1;
+
+	if( libewf_chunk_cache_link_entry(
+	     chunk_cache,
+	     entry_index,
+	     1,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to link entry: %d.",
+		 function,
+		 entry_index );
+
+		return( -1 );
+	}
+	*entry = &( chunk_cache->entries[ entry_index ] );
+
+	return( 1 );
+}
+
+/* Removes the cache entry of a specific chunk
+ * The entry becomes the least recently used entry so it is reused first
+ * Returns 1 if successful, 0 if the chunk is not cached or -1 on error
+ */
+int libewf_chunk_cache_remove_entry(
+     libewf_chunk_cache_t *chunk_cache,
+     uint32_t chunk,
+     liberror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_remove_entry";
+	int entry_index       = 0;
+	int result            = 0;
+
+	result = libewf_chunk_cache_find_entry(
+	          chunk_cache,
+	          chunk,
+	          &entry_index,
+	          error );
+
+	if( result == -1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to find entry for chunk: %" PRIu32 ".",
+		 function,
+		 chunk );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( libewf_chunk_cache_unlink_entry(
+	     chunk_cache,
+	     entry_index,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_REMOVE_FAILED,
+		 "%s: unable to unlink entry: %d.",
+		 function,
+		 entry_index );
+
+		return( -1 );
+	}
+	chunk_cache->entries[ entry_index ].amount = 0;
+	chunk_cache->entries[ entry_index ].cached = 0;
+
+	if( libewf_chunk_cache_link_entry(
+	     chunk_cache,
+	     entry_index,
+	     0,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to link entry: %d.",
+		 function,
+		 entry_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the empty block that matches the compressed data
+ * Returns 1 if successful, 0 if no such empty block or -1 on error
+ */
+int libewf_chunk_cache_get_empty_block(
+     libewf_chunk_cache_t *chunk_cache,
+     const uint8_t *compressed,
+     size_t compressed_size,
+     uint8_t *value,
+     size_t *uncompressed_size,
+     liberror_error_t **error )
+{
+	libewf_chunk_cache_empty_block_t *empty_block = NULL;
+	static char *function                         = "libewf_chunk_cache_get_empty_block";
+	int empty_block_index                         = 0;
+
+	if( chunk_cache == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed.",
+		 function );
+
+		return( -1 );
+	}
+	if( value == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncompressed_size == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid uncompressed size.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_size > LIBEWF_CHUNK_CACHE_EMPTY_BLOCK_MAXIMUM_COMPRESSED_SIZE )
+	{
+		return( 0 );
+	}
+	for( empty_block_index = 0;
+	     empty_block_index < chunk_cache->amount_of_empty_blocks;
+	     empty_block_index++ )
+	{
+		empty_block = &( chunk_cache->empty_blocks[ empty_block_index ] );
+
+		if( ( empty_block->compressed_size == compressed_size )
+		 && ( memory_compare(
+		       empty_block->compressed,
+		       compressed,
+		       compressed_size ) == 0 ) )
+		{
+			*value             = empty_block->value;
+			*uncompressed_size = empty_block->uncompressed_size;
+
+			return( 1 );
+		}
+	}
+	return( 0 );
+}
+
+/* Adds an empty block for the compressed data
+ * The empty block is not added if the compressed data is too large,
+ * the empty block is already known or the maximum amount of empty blocks was reached
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_add_empty_block(
+     libewf_chunk_cache_t *chunk_cache,
+     const uint8_t *compressed,
+     size_t compressed_size,
+     uint8_t value,
+     size_t uncompressed_size,
+     liberror_error_t **error )
+{
+	libewf_chunk_cache_empty_block_t *empty_block = NULL;
+	static char *function                         = "libewf_chunk_cache_add_empty_block";
+	size_t empty_block_uncompressed_size          = 0;
+	uint8_t empty_block_value                     = 0;
+	int result                                    = 0;
+
+	if( chunk_cache == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( compressed_size == 0 )
+	 || ( compressed_size > LIBEWF_CHUNK_CACHE_EMPTY_BLOCK_MAXIMUM_COMPRESSED_SIZE )
+	 || ( chunk_cache->amount_of_empty_blocks >= LIBEWF_CHUNK_CACHE_MAXIMUM_AMOUNT_OF_EMPTY_BLOCKS ) )
+	{
+		return( 1 );
+	}
+	/* Another thread could have added the same empty block in the meantime
+	 */
+	result = libewf_chunk_cache_get_empty_block(
+	          chunk_cache,
+	          compressed,
+	          compressed_size,
+	          &empty_block_value,
+	          &empty_block_uncompressed_size,
+	          error );
+
+	if( result == -1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve empty block.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		return( 1 );
+	}
+	empty_block = &( chunk_cache->empty_blocks[ chunk_cache->amount_of_empty_blocks ] );
+
+	if( memory_copy(
+	     empty_block->compressed,
+	     compressed,
+	     compressed_size ) == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_MEMORY,
+		 LIBERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to set empty block compressed data.",
+		 function );
+
+		return( -1 );
+	}
+	empty_block->compressed_size   = compressed_size;
+	empty_block->uncompressed_size = uncompressed_size;
+	empty_block->value             = value;
+
+	chunk_cache->amount_of_empty_blocks += 1;
+
+	return( 1 );
+}
+
+/* Grabs the chunk cache for reading
+ * Multiple threads can read the cache entries at the same time
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_grab_for_read(
+     libewf_chunk_cache_t *chunk_cache,
+     liberror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_grab_for_read";
+
+	if( chunk_cache == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( thread_read_write_lock_grab_for_read(
+	     &( chunk_cache->read_write_lock ) ) != 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Grabs the chunk cache for writing
+ * Only a single thread can modify the cache entries at the same time
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_grab_for_write(
+     libewf_chunk_cache_t *chunk_cache,
+     liberror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_grab_for_write";
+
+	if( chunk_cache == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( thread_read_write_lock_grab_for_write(
+	     &( chunk_cache->read_write_lock ) ) != 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Releases the chunk cache after it was grabbed for reading or writing
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_release(
+     libewf_chunk_cache_t *chunk_cache,
+     liberror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_release";
+
+	if( chunk_cache == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( thread_read_write_lock_release(
+	     &( chunk_cache->read_write_lock ) ) != 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
@@ -24,6 +24,7 @@
 #define _LIBEWF_CHUNK_CACHE_H
 
 #include <common.h>
+#include <thread.h>
 #include <types.h>
 
 #include <liberror.h>
@@ -32,6 +33,77 @@
 extern "C" {
 #endif
 
+/* The maximum size of the compressed data of an empty block that is remembered
+ * this covers the empty blocks of chunks of 64 KiB compressed with any compression level
+ */
+#define LIBEWF_CHUNK_CACHE_EMPTY_BLOCK_MAXIMUM_COMPRESSED_SIZE	512
+
+/* The maximum amount of empty block encodings that are remembered
+ */
+#define LIBEWF_CHUNK_CACHE_MAXIMUM_AMOUNT_OF_EMPTY_BLOCKS	8
+
+typedef struct libewf_chunk_cache_empty_block libewf_chunk_cache_empty_block_t;
+
+/* An encoding of a block that consists of a single repeated byte value
+ * these are detected on read so that the same compressed data
+ * does not need to be decompressed again
+ */
+struct libewf_chunk_cache_empty_block
+{
+	/* The compressed data
+	 */
+	uint8_t compressed[ LIBEWF_CHUNK_CACHE_EMPTY_BLOCK_MAXIMUM_COMPRESSED_SIZE ];
+
+	/* The size of the compressed data
+	 */
+	size_t compressed_size;
+
+	/* The size of the uncompressed data
+	 */
+	size_t uncompressed_size;
+
+	/* The byte value of the uncompressed data
+	 */
+	uint8_t value;
+};
+
+typedef struct libewf_chunk_cache_entry libewf_chunk_cache_entry_t;
+
+struct libewf_chunk_cache_entry
+{
+	/* The identifier of the cached chunk
+	 */
+	uint32_t chunk;
+
+	/* The amount of data in the chunk
+	 */
+	size_t amount;
+
+	/* A value to indicate if the chunk is cached
+	 */
+	uint8_t cached;
+
+	/* The allocated size of the data buffer
+	 */
+	size_t allocated_size;
+
+	/* The data buffer
+	 */
+	uint8_t *data;
+
+	/* The index of the next more recently used entry or -1 if not set
+	 */
+	int previous_entry;
+
+	/* The index of the next less recently used entry or -1 if not set
+	 */
+	int next_entry;
+
+	/* The index of the next entry in the same hash bucket or -1 if not set
+	 */
+	int next_hash_entry;
+};
+
 typedef struct libewf_chunk_cache libewf_chunk_cache_t;
 
 struct libewf_chunk_cache
@@ -52,10 +124,6 @@ struct libewf_chunk_cache
 	 */
 	size_t offset;
 
-	/* A value to indicate if the chunk is cached
-	 */
-	uint8_t cached;
-
 	/* The compressed data buffer
 	 */
 	uint8_t *compressed;
@@ -75,6 +143,52 @@ struct libewf_chunk_cache
 	/* The size of the uncompress zero byte empty block data
 	 */
 	size_t zero_byte_empty_block_uncompressed_size;
+
+	/* The empty block encodings detected on read
+	 */
+	libewf_chunk_cache_empty_block_t empty_blocks[ LIBEWF_CHUNK_CACHE_MAXIMUM_AMOUNT_OF_EMPTY_BLOCKS ];
+
+	/* The amount of empty block encodings
+	 */
+	int amount_of_empty_blocks;
+
+	/* The maximum amount of bytes used by the cache entries
+	 */
+	size_t maximum_cache_size;
+
+	/* The size of the data buffer of a cache entry
+	 */
+	size_t entry_size;
+
+	/* The amount of cache entries
+	 */
+	int amount_of_entries;
+
+	/* Dynamic array of the cache entries
+	 */
+	libewf_chunk_cache_entry_t *entries;
+
+	/* The amount of hash buckets, which is a power of 2
+	 */
+	int amount_of_hash_buckets;
+
+	/* Dynamic array containing the index of the first entry per hash bucket
+	 */
+	int *hash_buckets;
+
+	/* The index of the most recently used entry or -1 if not set
+	 */
+	int most_recently_used_entry;
+
+	/* The index of the least recently used entry or -1 if not set
+	 */
+	int least_recently_used_entry;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The read/write lock of the cache entries
+	 */
+	thread_read_write_lock_t read_write_lock;
+#endif
 };
 
 int libewf_chunk_cache_initialize(
@@ -91,6 +205,78 @@ int libewf_chunk_cache_resize(
      size_t size,
      liberror_error_t **error );
 
+int libewf_chunk_cache_empty(
+     libewf_chunk_cache_t *chunk_cache,
+     liberror_error_t **error );
+
+int libewf_chunk_cache_set_maximum_cache_size(
+     libewf_chunk_cache_t *chunk_cache,
+     size_t maximum_cache_size,
+     liberror_error_t **error );
+
+int libewf_chunk_cache_find_entry(
+     libewf_chunk_cache_t *chunk_cache,
+     uint32_t chunk,
+     int *entry_index,
+     liberror_error_t **error );
+
+int libewf_chunk_cache_unlink_entry(
+     libewf_chunk_cache_t *chunk_cache,
+     int entry_index,
+     liberror_error_t **error );
+
+int libewf_chunk_cache_link_entry(
+     libewf_chunk_cache_t *chunk_cache,
+     int entry_index,
+     uint8_t most_recently_used,
+     liberror_error_t **error );
+
+int libewf_chunk_cache_get_entry(
+     libewf_chunk_cache_t *chunk_cache,
+     uint32_t chunk,
+     libewf_chunk_cache_entry_t **entry,
+     liberror_error_t **error );
+
+int libewf_chunk_cache_set_entry(
+     libewf_chunk_cache_t *chunk_cache,
+     uint32_t chunk,
+     size_t entry_size,
+     libewf_chunk_cache_entry_t **entry,
+     liberror_error_t **error );
+
+int libewf_chunk_cache_remove_entry(
+     libewf_chunk_cache_t *chunk_cache,
+     uint32_t chunk,
+     liberror_error_t **error );
+
+int libewf_chunk_cache_get_empty_block(
+     libewf_chunk_cache_t *chunk_cache,
+     const uint8_t *compressed,
+     size_t compressed_size,
+     uint8_t *value,
+     size_t *uncompressed_size,
+     liberror_error_t **error );
+
+int libewf_chunk_cache_add_empty_block(
+     libewf_chunk_cache_t *chunk_cache,
+     const uint8_t *compressed,
+     size_t compressed_size,
+     uint8_t value,
+     size_t uncompressed_size,
+     liberror_error_t **error );
+
+int libewf_chunk_cache_grab_for_read(
+     libewf_chunk_cache_t *chunk_cache,
+     liberror_error_t **error );
+
+int libewf_chunk_cache_grab_for_write(
+     libewf_chunk_cache_t *chunk_cache,
+     liberror_error_t **error );
+
+int libewf_chunk_cache_release(
+     libewf_chunk_cache_t *chunk_cache,
+     liberror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -36,34 +36,74 @@ extern "C" {
 #define LIBEWF_CHUNK_OFFSET_FLAGS_TAINTED 	0x02
 #define LIBEWF_CHUNK_OFFSET_FLAGS_CORRUPTED 	0x04
 #define LIBEWF_CHUNK_OFFSET_FLAGS_MISSING 	0x08
+#define LIBEWF_CHUNK_OFFSET_FLAGS_EMPTY_BLOCK 	0x10
+#define LIBEWF_CHUNK_OFFSET_FLAGS_WIDE_FILE_OFFSET	0x40
 #define LIBEWF_CHUNK_OFFSET_FLAGS_DELTA_CHUNK 	0x80
 
+/* The maximum file offset of a chunk in a segment file that can be stored packed
+ * larger file offsets are stored in the wide file offsets of the offset table
+ */
+#define LIBEWF_CHUNK_OFFSET_MAXIMUM_PACKED_FILE_OFFSET	(off64_t) 0x000000ffffffffffULL
+
+/* The maximum size of a chunk that can be stored
+ */
+#define LIBEWF_CHUNK_OFFSET_MAXIMUM_SIZE	(size_t) UINT32_MAX
+
 typedef struct libewf_chunk_offset libewf_chunk_offset_t;
 
+/* The chunk offset is stored packed to keep the offset table small
+ * for images with a large amount of chunks
+ */
 struct libewf_chunk_offset
 {
-	/* A reference to the segment file handle
+	/* The lower 32-bit of the file offset of the chunk in the segment file
+	 * or of the index of the wide file offset in the offset table
 	 */
-	libewf_segment_file_handle_t *segment_file_handle;
+	uint32_t file_offset_lower;
 
-	/* The file offset of the chunk in the segment file
+	/* The size of the chunk
 	 */
-	off64_t file_offset;
+	uint32_t size;
 
-	/* The size of the chunk
+	/* The index of the segment file handle in the offset table
+	 * the index is stored + 1, 0 indicates the chunk offset is not set
 	 */
-	size_t size;
+	uint16_t segment_file_index;
+
+	/* The upper 8-bit of the file offset of the chunk in the segment file
+	 * or of the index of the wide file offset in the offset table
+	 */
+	uint8_t file_offset_upper;
 
 	/* Flags
 	 * 0x01 indicates if the chunk is compressed
 	 * 0x02 indicates if the chunk is tainted and possibly corrupted
 	 * 0x04 indicates if the chunk is corrupted
 	 * 0x08 indicates if the chunk is missing
+	 * 0x10 indicates if the chunk is an empty block that only contains zero bytes
+	 * 0x40 indicates if the file offset is stored in the wide file offsets of the offset table
 	 * 0x80 indicates if the chunk is a delta chunk
 	 */
 	uint8_t flags;
 };
 
+/* Retrieves the packed 40-bit value of the chunk offset
+ */
+#define libewf_chunk_offset_get_packed_file_offset( chunk_offset ) \
+	(off64_t) ( ( (uint64_t) ( chunk_offset )->file_offset_upper << 32 ) \
+	          | (uint64_t) ( chunk_offset )->file_offset_lower )
+
+/* Sets the packed 40-bit value of the chunk offset
+ * the value should not exceed LIBEWF_CHUNK_OFFSET_MAXIMUM_PACKED_FILE_OFFSET
+ */
+#define libewf_chunk_offset_set_packed_file_offset( chunk_offset, file_offset ) \
+	do \
+	{ \
+		( chunk_offset )->file_offset_lower = (uint32_t) ( (uint64_t) ( file_offset ) & 0xffffffffUL ); \
+		( chunk_offset )->file_offset_upper = (uint8_t) ( (uint64_t) ( file_offset ) >> 32 ); \
+	} \
+	while( 0 )
+
 #if defined( __cplusplus )
 }
 #endif
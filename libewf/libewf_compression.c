@@ -21,6 +21,8 @@
  */
 
 #include <common.h>
+#include <memory.h>
+#include <thread.h>
 #include <types.h>
 
 #include <liberror.h>
@@ -34,11 +36,252 @@
 #include <zlib.h>
 #endif
 
+#if defined( HAVE_LIBDEFLATE )
+#include <libdeflate.h>
+#endif
+
 #include "libewf_compression.h"
+#include "libewf_definitions.h"
 
 #include "ewf_definitions.h"
 
-/* Compresses data, wraps zlib uncompress function
+/* The compression library used to compress and uncompress data
+ * libdeflate is used by default if available since it is faster than zlib
+ * for compressing and uncompressing a buffer at once
+ *
+ * The value is only changed by libewf_compression_set_library which must be
+ * called before a handle is opened, it is not guarded since the compression
+ * and read-ahead threads only read it while a handle is open
+ */
+#if defined( HAVE_LIBDEFLATE )
+static int libewf_compression_library = LIBEWF_COMPRESSION_LIBRARY_LIBDEFLATE;
+#else
+static int libewf_compression_library = LIBEWF_COMPRESSION_LIBRARY_ZLIB;
+#endif
+
+#if defined( HAVE_LIBDEFLATE )
+
+/* The libdeflate compressors and decompressor are kept per thread
+ * so that they are created once instead of for every chunk
+ * and the compression and read-ahead threads do not need to share them
+ */
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+static thread_key_t libewf_compression_context_key;
+static thread_once_t libewf_compression_context_key_once = THREAD_ONCE_INITIALIZER;
+static int libewf_compression_context_key_created        = 0;
+#else
+static libewf_compression_context_t *libewf_compression_context = NULL;
+#endif
+
+/* Creates the key of the thread specific compression context
+ * The context is freed when the thread exits
+ * This function is called once by libewf_compression_get_context
+ */
+void libewf_compression_initialize_context_key(
+      void )
+{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( thread_key_create(
+	     &libewf_compression_context_key,
+	     libewf_compression_context_free ) == 0 )
+	{
+		libewf_compression_context_key_created = 1;
+	}
+#endif
+}
+
+/* Frees a compression context including its compressors and decompressor
+ */
+void libewf_compression_context_free(
+      void *compression_context )
+{
+	libewf_compression_context_t *context = NULL;
+	int compressor_index                  = 0;
+
+	if( compression_context == NULL )
+	{
+		return;
+	}
+	context = (libewf_compression_context_t *) compression_context;
+
+	for( compressor_index = 0;
+	     compressor_index < LIBEWF_COMPRESSION_CONTEXT_AMOUNT_OF_COMPRESSORS;
+	     compressor_index++ )
+	{
+		if( context->compressors[ compressor_index ] != NULL )
+		{
+			libdeflate_free_compressor(
+			 context->compressors[ compressor_index ] );
+		}
+	}
+	if( context->decompressor != NULL )
+	{
+		libdeflate_free_decompressor(
+		 context->decompressor );
+	}
+	memory_free(
+	 context );
+}
+
+/* Retrieves the compression context of the calling thread
+ * The context is created on first use
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_get_context(
+     libewf_compression_context_t **compression_context,
+     liberror_error_t **error )
+{
+	libewf_compression_context_t *context = NULL;
+	static char *function                 = "libewf_compression_get_context";
+
+	if( compression_context == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( ( thread_once(
+	       &libewf_compression_context_key_once,
+	       libewf_compression_initialize_context_key ) != 0 )
+	 || ( libewf_compression_context_key_created == 0 ) )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create compression context key.",
+		 function );
+
+		return( -1 );
+	}
+	context = (libewf_compression_context_t *) thread_key_get_value(
+	                                            libewf_compression_context_key );
+#else
+	context = libewf_compression_context;
+#endif
+	if( context == NULL )
+	{
+		context = (libewf_compression_context_t *) memory_allocate(
+		                                            sizeof( libewf_compression_context_t ) );
+
+		if( context == NULL )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_MEMORY,
+			 LIBERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create compression context.",
+			 function );
+
+			return( -1 );
+		}
+		if( memory_set(
+		     context,
+		     0,
+		     sizeof( libewf_compression_context_t ) ) == NULL )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_MEMORY,
+			 LIBERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear compression context.",
+			 function );
+
+			memory_free(
+			 context );
+
+			return( -1 );
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( thread_key_set_value(
+		     libewf_compression_context_key,
+		     context ) != 0 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set compression context.",
+			 function );
+
+			memory_free(
+			 context );
+
+			return( -1 );
+		}
+#else
+		libewf_compression_context = context;
+#endif
+	}
+	*compression_context = context;
+
+	return( 1 );
+}
+
+#endif
+
+/* Retrieves the compression library used to compress and uncompress data
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_get_library(
+     int *compression_library,
+     liberror_error_t **error )
+{
+	static char *function = "libewf_compression_get_library";
+
+	if( compression_library == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression library.",
+		 function );
+
+		return( -1 );
+	}
+	*compression_library = libewf_compression_library;
+
+	return( 1 );
+}
+
+/* Sets the compression library used to compress and uncompress data
+ * The value must be set before a handle is opened
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_set_library(
+     int compression_library,
+     liberror_error_t **error )
+{
+	static char *function = "libewf_compression_set_library";
+
+	if( ( compression_library != LIBEWF_COMPRESSION_LIBRARY_ZLIB )
+#if defined( HAVE_LIBDEFLATE )
+	 && ( compression_library != LIBEWF_COMPRESSION_LIBRARY_LIBDEFLATE )
+#endif
+	 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported compression library.",
+		 function );
+
+		return( -1 );
+	}
+	libewf_compression_library = compression_library;
+
+	return( 1 );
+}
+
+/* Compresses data, wraps the zlib compress2 or libdeflate zlib compress function
  * Returns 1 on success or -1 on error
  */
 int libewf_compress(
@@ -49,10 +292,16 @@ int libewf_compress(
      int8_t compression_level,
      liberror_error_t **error )
 {
-	static char *function        = "libewf_compress";
-	uLongf safe_compressed_size  = 0;
-	int zlib_compression_level   = 0;
-	int result                   = 0;
+#if defined( HAVE_LIBDEFLATE )
+	libewf_compression_context_t *compression_context = NULL;
+	struct libdeflate_compressor *compressor          = NULL;
+	size_t libdeflate_compressed_size                 = 0;
+	int compressor_index                              = 0;
+#endif
+	static char *function                             = "libewf_compress";
+	uLongf safe_compressed_size                       = 0;
+	int zlib_compression_level                        = 0;
+	int result                                        = 0;
 
 	if( compressed_data == NULL )
 	{
@@ -101,18 +350,30 @@ int libewf_compress(
 	if( compression_level == EWF_COMPRESSION_DEFAULT )
 	{
 		zlib_compression_level = Z_BEST_SPEED;
+#if defined( HAVE_LIBDEFLATE )
+		compressor_index       = 1;
+#endif
 	}
 	else if( compression_level == EWF_COMPRESSION_FAST )
 	{
 		zlib_compression_level = Z_BEST_SPEED;
+#if defined( HAVE_LIBDEFLATE )
+		compressor_index       = 1;
+#endif
 	}
 	else if( compression_level == EWF_COMPRESSION_BEST )
 	{
 		zlib_compression_level = Z_BEST_COMPRESSION;
+#if defined( HAVE_LIBDEFLATE )
+		compressor_index       = 2;
+#endif
 	}
 	else if( compression_level == EWF_COMPRESSION_NONE )
 	{
 		zlib_compression_level = Z_NO_COMPRESSION;
+#if defined( HAVE_LIBDEFLATE )
+		compressor_index       = 0;
+#endif
 	}
 	else
 	{
@@ -125,6 +386,78 @@ int libewf_compress(
 
 		return( -1 );
 	}
+#if defined( HAVE_LIBDEFLATE )
+	if( libewf_compression_library == LIBEWF_COMPRESSION_LIBRARY_LIBDEFLATE )
+	{
+		if( libewf_compression_get_context(
+		     &compression_context,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve compression context.",
+			 function );
+
+			*compressed_size = 0;
+
+			return( -1 );
+		}
+		compressor = compression_context->compressors[ compressor_index ];
+
+		if( compressor == NULL )
+		{
+			/* The zlib compression levels map onto the equivalent libdeflate compression levels
+			 */
+			compressor = libdeflate_alloc_compressor(
+			              zlib_compression_level );
+
+			if( compressor == NULL )
+			{
+				liberror_error_set(
+				 error,
+				 LIBERROR_ERROR_DOMAIN_MEMORY,
+				 LIBERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create compressor.",
+				 function );
+
+				*compressed_size = 0;
+
+				return( -1 );
+			}
+			compression_context->compressors[ compressor_index ] = compressor;
+		}
+		libdeflate_compressed_size = libdeflate_zlib_compress(
+		                              compressor,
+		                              uncompressed_data,
+		                              uncompressed_size,
+		                              compressed_data,
+		                              *compressed_size );
+
+		if( libdeflate_compressed_size != 0 )
+		{
+			*compressed_size = libdeflate_compressed_size;
+
+			result = 1;
+		}
+		else
+		{
+#if defined( HAVE_VERBOSE_OUTPUT )
+			libnotify_verbose_printf(
+			 "%s: unable to write compressed data: target buffer too small.\n",
+			 function );
+#endif
+
+			*compressed_size = libdeflate_zlib_compress_bound(
+			                    compressor,
+			                    uncompressed_size );
+
+			result = -1;
+		}
+		return( result );
+	}
+#endif
 	safe_compressed_size = (uLongf) *compressed_size;
 
 	result = compress2(
@@ -185,7 +518,7 @@ int libewf_compress(
 	return( -1 );
 }
 
-/* Uncompresses data, wraps zlib uncompress function
+/* Uncompresses data, wraps the zlib uncompress or libdeflate zlib decompress function
  * Returns 1 on success, 0 on failure or -1 on error
  */
 int libewf_uncompress(
@@ -195,9 +528,15 @@ int libewf_uncompress(
      size_t compressed_size,
      liberror_error_t **error )
 {
-	static char *function         = "libewf_uncompress";
-	uLongf safe_uncompressed_size = 0;
-	int result                    = 0;
+#if defined( HAVE_LIBDEFLATE )
+	libewf_compression_context_t *compression_context = NULL;
+	struct libdeflate_decompressor *decompressor      = NULL;
+	size_t libdeflate_uncompressed_size               = 0;
+	enum libdeflate_result libdeflate_result          = LIBDEFLATE_SUCCESS;
+#endif
+	static char *function                             = "libewf_uncompress";
+	uLongf safe_uncompressed_size                     = 0;
+	int result                                        = 0;
 
 	if( uncompressed_data == NULL )
 	{
@@ -243,6 +582,98 @@ int libewf_uncompress(
 
 		return( -1 );
 	}
+#if defined( HAVE_LIBDEFLATE )
+	if( libewf_compression_library == LIBEWF_COMPRESSION_LIBRARY_LIBDEFLATE )
+	{
+		if( libewf_compression_get_context(
+		     &compression_context,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve compression context.",
+			 function );
+
+			*uncompressed_size = 0;
+
+			return( -1 );
+		}
+		decompressor = compression_context->decompressor;
+
+		if( decompressor == NULL )
+		{
+			decompressor = libdeflate_alloc_decompressor();
+
+			if( decompressor == NULL )
+			{
+				liberror_error_set(
+				 error,
+				 LIBERROR_ERROR_DOMAIN_MEMORY,
+				 LIBERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create decompressor.",
+				 function );
+
+				*uncompressed_size = 0;
+
+				return( -1 );
+			}
+			compression_context->decompressor = decompressor;
+		}
+		libdeflate_result = libdeflate_zlib_decompress(
+		                     decompressor,
+		                     compressed_data,
+		                     compressed_size,
+		                     uncompressed_data,
+		                     *uncompressed_size,
+		                     &libdeflate_uncompressed_size );
+
+		if( libdeflate_result == LIBDEFLATE_SUCCESS )
+		{
+			*uncompressed_size = libdeflate_uncompressed_size;
+
+			return( 1 );
+		}
+		else if( libdeflate_result == LIBDEFLATE_BAD_DATA )
+		{
+#if defined( HAVE_VERBOSE_OUTPUT )
+			libnotify_verbose_printf(
+			 "%s: unable to read compressed data: data error.\n",
+			 function );
+#endif
+
+			*uncompressed_size = 0;
+
+			return( 0 );
+		}
+		else if( libdeflate_result == LIBDEFLATE_INSUFFICIENT_SPACE )
+		{
+#if defined( HAVE_VERBOSE_OUTPUT )
+			libnotify_verbose_printf(
+			 "%s: unable to read compressed data: target buffer too small.\n",
+			 function );
+#endif
+
+			/* Estimate that a factor 2 enlargement should suffice
+			 */
+			*uncompressed_size *= 2;
+		}
+		else
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_COMPRESSION,
+			 LIBERROR_COMPRESSION_ERROR_UNCOMPRESS_FAILED,
+			 "%s: libdeflate returned undefined error: %d.",
+			 function,
+			 (int) libdeflate_result );
+
+			*uncompressed_size = 0;
+		}
+		return( -1 );
+	}
+#endif
 	safe_uncompressed_size = (uLongf) *uncompressed_size;
 
 	result = uncompress(
@@ -32,6 +32,57 @@
 extern "C" {
 #endif
 
+#if defined( HAVE_LIBDEFLATE )
+
+/* The amount of libdeflate compressors per context
+ * one for every zlib compression level used: none, fast and best
+ */
+#define LIBEWF_COMPRESSION_CONTEXT_AMOUNT_OF_COMPRESSORS	3
+
+struct libdeflate_compressor;
+struct libdeflate_decompressor;
+
+typedef struct libewf_compression_context libewf_compression_context_t;
+
+/* The libdeflate compressors and decompressor of a thread
+ */
+struct libewf_compression_context
+{
+	/* The compressors per compression level
+	 * they are created on first use
+	 */
+	struct libdeflate_compressor *compressors[ LIBEWF_COMPRESSION_CONTEXT_AMOUNT_OF_COMPRESSORS ];
+
+	/* The decompressor
+	 * it is created on first use
+	 */
+	struct libdeflate_decompressor *decompressor;
+};
+
+#endif
+
+int libewf_compression_get_library(
+     int *compression_library,
+     liberror_error_t **error );
+
+int libewf_compression_set_library(
+     int compression_library,
+     liberror_error_t **error );
+
+#if defined( HAVE_LIBDEFLATE )
+
+void libewf_compression_initialize_context_key(
+      void );
+
+void libewf_compression_context_free(
+      void *compression_context );
+
+int libewf_compression_get_context(
+     libewf_compression_context_t **compression_context,
+     liberror_error_t **error );
+
+#endif
+
 int libewf_compress(
      uint8_t *compressed_data,
      size_t *compressed_size,
@@ -0,0 +1,953 @@
+/*
+ * Compression pool functions
+ *
+ * Copyright (c) 2006-2009, Joachim Metz <forensics@hoffmannbv.nl>,
+ * Hoffmann Investigations.
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <thread.h>
+#include <types.h>
+
+#include <liberror.h>
+#include <libnotify.h>
+
+#include "libewf_chunk_cache.h"
+#include "libewf_compression_pool.h"
+#include "libewf_write_io_handle.h"
+
+#include "ewf_crc.h"
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Initialize the compression pool and starts the threads
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_pool_initialize(
+     libewf_compression_pool_t **compression_pool,
+     libewf_media_values_t *media_values,
+     libewf_statistics_t *statistics,
+     int8_t compression_level,
+     uint8_t compression_flags,
+     uint8_t ewf_format,
+     int amount_of_threads,
+     liberror_error_t **error )
+{
+	static char *function = "libewf_compression_pool_initialize";
+	size_t entries_size   = 0;
+	int entry_index       = 0;
+	int thread_index      = 0;
+
+	if( compression_pool == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( amount_of_threads <= 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid amount of threads value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( *compression_pool == NULL )
+	{
+		*compression_pool = (libewf_compression_pool_t *) memory_allocate(
+		                                                   sizeof( libewf_compression_pool_t ) );
+
+		if( *compression_pool == NULL )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_MEMORY,
+			 LIBERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create compression pool.",
+			 function );
+
+			return( -1 );
+		}
+		if( memory_set(
+		     *compression_pool,
+		     0,
+		     sizeof( libewf_compression_pool_t ) ) == NULL )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_MEMORY,
+			 LIBERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear compression pool.",
+			 function );
+
+			memory_free(
+			 *compression_pool );
+
+			*compression_pool = NULL;
+
+			return( -1 );
+		}
+		if( thread_mutex_initialize(
+		     &( ( *compression_pool )->mutex ) ) != 0 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize mutex.",
+			 function );
+
+			memory_free(
+			 *compression_pool );
+
+			*compression_pool = NULL;
+
+			return( -1 );
+		}
+		if( thread_condition_initialize(
+		     &( ( *compression_pool )->queued_condition ) ) != 0 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize queued condition.",
+			 function );
+
+			thread_mutex_free(
+			 &( ( *compression_pool )->mutex ) );
+			memory_free(
+			 *compression_pool );
+
+			*compression_pool = NULL;
+
+			return( -1 );
+		}
+		if( thread_condition_initialize(
+		     &( ( *compression_pool )->processed_condition ) ) != 0 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize processed condition.",
+			 function );
+
+			thread_condition_free(
+			 &( ( *compression_pool )->queued_condition ) );
+			thread_mutex_free(
+			 &( ( *compression_pool )->mutex ) );
+			memory_free(
+			 *compression_pool );
+
+			*compression_pool = NULL;
+
+			return( -1 );
+		}
+		( *compression_pool )->media_values      = media_values;
+		( *compression_pool )->statistics        = statistics;
+		( *compression_pool )->compression_level = compression_level;
+		( *compression_pool )->compression_flags = compression_flags;
+		( *compression_pool )->ewf_format        = ewf_format;
+
+		/* From here on the compression pool can be freed using libewf_compression_pool_free
+		 */
+		entries_size = sizeof( libewf_compression_pool_entry_t )
+		             * amount_of_threads
+		             * LIBEWF_COMPRESSION_POOL_ENTRIES_PER_THREAD;
+
+		( *compression_pool )->entries = (libewf_compression_pool_entry_t *) memory_allocate(
+		                                                                      entries_size );
+
+		if( ( *compression_pool )->entries == NULL )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_MEMORY,
+			 LIBERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create entries.",
+			 function );
+
+			libewf_compression_pool_free(
+			 compression_pool,
+			 NULL );
+
+			return( -1 );
+		}
+		if( memory_set(
+		     ( *compression_pool )->entries,
+		     0,
+		     entries_size ) == NULL )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_MEMORY,
+			 LIBERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear entries.",
+			 function );
+
+			memory_free(
+			 ( *compression_pool )->entries );
+
+			( *compression_pool )->entries = NULL;
+
+			libewf_compression_pool_free(
+			 compression_pool,
+			 NULL );
+
+			return( -1 );
+		}
+		( *compression_pool )->amount_of_entries = amount_of_threads
+		                                         * LIBEWF_COMPRESSION_POOL_ENTRIES_PER_THREAD;
+
+		for( entry_index = 0;
+		     entry_index < ( *compression_pool )->amount_of_entries;
+		     entry_index++ )
+		{
+			( *compression_pool )->entries[ entry_index ].data = (uint8_t *) memory_allocate(
+			                                                                  sizeof( uint8_t ) * media_values->chunk_size );
+
+			if( ( *compression_pool )->entries[ entry_index ].data == NULL )
+			{
+				liberror_error_set(
+				 error,
+				 LIBERROR_ERROR_DOMAIN_MEMORY,
+				 LIBERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create data of entry: %d.",
+				 function,
+				 entry_index );
+
+				libewf_compression_pool_free(
+				 compression_pool,
+				 NULL );
+
+				return( -1 );
+			}
+			( *compression_pool )->entries[ entry_index ].allocated_size = media_values->chunk_size;
+		}
+		( *compression_pool )->threads = (thread_t *) memory_allocate(
+		                                               sizeof( thread_t ) * amount_of_threads );
+
+		if( ( *compression_pool )->threads == NULL )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_MEMORY,
+			 LIBERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create threads.",
+			 function );
+
+			libewf_compression_pool_free(
+			 compression_pool,
+			 NULL );
+
+			return( -1 );
+		}
+		for( thread_index = 0;
+		     thread_index < amount_of_threads;
+		     thread_index++ )
+		{
+			if( thread_create(
+			     &( ( *compression_pool )->threads[ thread_index ] ),
+			     libewf_compression_pool_process_chunks,
+			     *compression_pool ) != 0 )
+			{
+				liberror_error_set(
+				 error,
+				 LIBERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create thread: %d.",
+				 function,
+				 thread_index );
+
+				libewf_compression_pool_free(
+				 compression_pool,
+				 NULL );
+
+				return( -1 );
+			}
+			/* Only the threads that were created are joined on free
+			 */
+			( *compression_pool )->amount_of_threads += 1;
+		}
+	}
+	return( 1 );
+}
+
+/* Stops the threads and frees the compression pool including elements
+ * Chunks that were not retrieved are discarded
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_pool_free(
+     libewf_compression_pool_t **compression_pool,
+     liberror_error_t **error )
+{
+	static char *function = "libewf_compression_pool_free";
+	int entry_index       = 0;
+	int thread_index      = 0;
+	int result            = 1;
+
+	if( compression_pool == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *compression_pool != NULL )
+	{
+		if( ( *compression_pool )->amount_of_threads > 0 )
+		{
+			if( thread_mutex_grab(
+			     &( ( *compression_pool )->mutex ) ) != 0 )
+			{
+				liberror_error_set(
+				 error,
+				 LIBERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to grab mutex.",
+				 function );
+
+				return( -1 );
+			}
+			( *compression_pool )->stop_threads = 1;
+
+			thread_condition_broadcast(
+			 &( ( *compression_pool )->queued_condition ) );
+
+			if( thread_mutex_release(
+			     &( ( *compression_pool )->mutex ) ) != 0 )
+			{
+				liberror_error_set(
+				 error,
+				 LIBERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release mutex.",
+				 function );
+
+				return( -1 );
+			}
+			for( thread_index = 0;
+			     thread_index < ( *compression_pool )->amount_of_threads;
+			     thread_index++ )
+			{
+				if( thread_join(
+				     ( *compression_pool )->threads[ thread_index ] ) != 0 )
+				{
+					liberror_error_set(
+					 error,
+					 LIBERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to join thread: %d.",
+					 function,
+					 thread_index );
+
+					result = -1;
+				}
+			}
+		}
+		if( ( *compression_pool )->threads != NULL )
+		{
+			memory_free(
+			 ( *compression_pool )->threads );
+		}
+		if( ( *compression_pool )->entries != NULL )
+		{
+			for( entry_index = 0;
+			     entry_index < ( *compression_pool )->amount_of_entries;
+			     entry_index++ )
+			{
+				if( ( *compression_pool )->entries[ entry_index ].data != NULL )
+				{
+					memory_free(
+					 ( *compression_pool )->entries[ entry_index ].data );
+				}
+			}
+			memory_free(
+			 ( *compression_pool )->entries );
+		}
+		if( thread_condition_free(
+		     &( ( *compression_pool )->processed_condition ) ) != 0 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free processed condition.",
+			 function );
+
+			result = -1;
+		}
+		if( thread_condition_free(
+		     &( ( *compression_pool )->queued_condition ) ) != 0 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free queued condition.",
+			 function );
+
+			result = -1;
+		}
+		if( thread_mutex_free(
+		     &( ( *compression_pool )->mutex ) ) != 0 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *compression_pool );
+
+		*compression_pool = NULL;
+	}
+	return( result );
+}
+
+/* The start function of the compression pool threads
+ * Processes the queued chunks in order until the threads are stopped
+ * Every thread uses its own chunk cache to compress the chunk data
+ * Returns NULL
+ */
+void *libewf_compression_pool_process_chunks(
+       void *arguments )
+{
+	libewf_chunk_cache_t *chunk_cache                 = NULL;
+	libewf_compression_pool_t *compression_pool       = NULL;
+	libewf_compression_pool_entry_t *entry            = NULL;
+	liberror_error_t *error                           = NULL;
+	void *reallocation                                = NULL;
+	static char *function                             = "libewf_compression_pool_process_chunks";
+	size_t compressed_chunk_data_size                 = 0;
+	ssize_t processed_data_size                       = 0;
+	uint8_t entry_state                               = 0;
+
+	if( arguments == NULL )
+	{
+		return( NULL );
+	}
+	compression_pool = (libewf_compression_pool_t *) arguments;
+
+	if( libewf_chunk_cache_initialize(
+	     &chunk_cache,
+	     compression_pool->media_values->chunk_size + sizeof( ewf_crc_t ),
+	     &error ) != 1 )
+	{
+		liberror_error_set(
+		 &error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk cache.",
+		 function );
+
+#if defined( HAVE_VERBOSE_OUTPUT )
+		libnotify_print_error_backtrace(
+		 error );
+#endif
+		liberror_error_free(
+		 &error );
+
+		/* Without a chunk cache the thread marks every chunk it processes as failed
+		 */
+		chunk_cache = NULL;
+	}
+	if( thread_mutex_grab(
+	     &( compression_pool->mutex ) ) != 0 )
+	{
+		libewf_chunk_cache_free(
+		 &chunk_cache,
+		 NULL );
+
+		return( NULL );
+	}
+	while( compression_pool->stop_threads == 0 )
+	{
+		entry = &( compression_pool->entries[ compression_pool->process_entry ] );
+
+		if( entry->state != LIBEWF_COMPRESSION_POOL_ENTRY_STATE_QUEUED )
+		{
+			thread_condition_wait(
+			 &( compression_pool->queued_condition ),
+			 &( compression_pool->mutex ) );
+
+			continue;
+		}
+		entry->state = LIBEWF_COMPRESSION_POOL_ENTRY_STATE_PROCESSING;
+
+		compression_pool->process_entry += 1;
+
+		if( compression_pool->process_entry >= compression_pool->amount_of_entries )
+		{
+			compression_pool->process_entry = 0;
+		}
+		/* The entry is owned by this thread until its state is changed
+		 * the chunk is processed without holding the mutex
+		 */
+		thread_mutex_release(
+		 &( compression_pool->mutex ) );
+
+		entry_state = LIBEWF_COMPRESSION_POOL_ENTRY_STATE_FAILED;
+
+		if( chunk_cache != NULL )
+		{
+			/* The compressed data size contains the maximum allowed buffer size
+			 */
+			compressed_chunk_data_size = chunk_cache->allocated_size;
+
+			processed_data_size = libewf_write_io_handle_process_chunk(
+			                       chunk_cache,
+			                       compression_pool->media_values,
+			                       compression_pool->compression_level,
+			                       compression_pool->compression_flags,
+			                       compression_pool->ewf_format,
+			                       entry->data,
+			                       entry->data_size,
+			                       chunk_cache->compressed,
+			                       &compressed_chunk_data_size,
+			                       &( entry->is_compressed ),
+			                       0,
+			                       &( entry->chunk_crc ),
+			                       &( entry->write_crc ),
+			                       compression_pool->statistics,
+			                       &error );
+
+			if( processed_data_size <= -1 )
+			{
+				liberror_error_set(
+				 &error,
+				 LIBERROR_ERROR_DOMAIN_CONVERSION,
+				 LIBERROR_CONVERSION_ERROR_OUTPUT_FAILED,
+				 "%s: unable to process chunk: %" PRIu32 ".",
+				 function,
+				 entry->chunk );
+			}
+			else if( entry->is_compressed == 0 )
+			{
+				entry->processed_data_size = (size_t) processed_data_size;
+
+				entry_state = LIBEWF_COMPRESSION_POOL_ENTRY_STATE_PROCESSED;
+			}
+			else
+			{
+				/* Make sure the compressed chunk data fits in the entry
+				 */
+				if( (size_t) processed_data_size > entry->allocated_size )
+				{
+					reallocation = memory_reallocate(
+					                entry->data,
+					                sizeof( uint8_t ) * processed_data_size );
+
+					if( reallocation == NULL )
+					{
+						liberror_error_set(
+						 &error,
+						 LIBERROR_ERROR_DOMAIN_MEMORY,
+						 LIBERROR_MEMORY_ERROR_INSUFFICIENT,
+						 "%s: unable to resize data of chunk: %" PRIu32 ".",
+						 function,
+						 entry->chunk );
+					}
+					else
+					{
+						entry->data           = (uint8_t *) reallocation;
+						entry->allocated_size = (size_t) processed_data_size;
+					}
+				}
+				if( (size_t) processed_data_size <= entry->allocated_size )
+				{
+					if( memory_copy(
+					     entry->data,
+					     chunk_cache->compressed,
+					     (size_t) processed_data_size ) == NULL )
+					{
+						liberror_error_set(
+						 &error,
+						 LIBERROR_ERROR_DOMAIN_MEMORY,
+						 LIBERROR_MEMORY_ERROR_COPY_FAILED,
+						 "%s: unable to set compressed data of chunk: %" PRIu32 ".",
+						 function,
+						 entry->chunk );
+					}
+					else
+					{
+						entry->processed_data_size = (size_t) processed_data_size;
+
+						entry_state = LIBEWF_COMPRESSION_POOL_ENTRY_STATE_PROCESSED;
+					}
+				}
+			}
+			if( error != NULL )
+			{
+#if defined( HAVE_VERBOSE_OUTPUT )
+				libnotify_print_error_backtrace(
+				 error );
+#endif
+				liberror_error_free(
+				 &error );
+			}
+		}
+		if( thread_mutex_grab(
+		     &( compression_pool->mutex ) ) != 0 )
+		{
+			libewf_chunk_cache_free(
+			 &chunk_cache,
+			 NULL );
+
+			return( NULL );
+		}
+		entry->state = entry_state;
+
+		thread_condition_broadcast(
+		 &( compression_pool->processed_condition ) );
+	}
+	thread_mutex_release(
+	 &( compression_pool->mutex ) );
+
+	libewf_chunk_cache_free(
+	 &chunk_cache,
+	 NULL );
+
+	return( NULL );
+}
+
+/* Appends a chunk to the compression pool to be processed
+ * The chunk data is copied into the pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_pool_append_chunk(
+     libewf_compression_pool_t *compression_pool,
+     uint32_t chunk,
+     uint8_t *chunk_data,
+     size_t chunk_data_size,
+     liberror_error_t **error )
+{
+	libewf_compression_pool_entry_t *entry = NULL;
+	static char *function                  = "libewf_compression_pool_append_chunk";
+	int entry_index                        = 0;
+	int result                             = 1;
+
+	if( compression_pool == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data_size > (size_t) compression_pool->media_values->chunk_size )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_TOO_LARGE,
+		 "%s: invalid chunk data size value exceeds media values chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( thread_mutex_grab(
+	     &( compression_pool->mutex ) ) != 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( compression_pool->amount_of_used_entries >= compression_pool->amount_of_entries )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_OUT_OF_RANGE,
+		 "%s: no free entry available.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		entry_index = ( compression_pool->first_entry + compression_pool->amount_of_used_entries )
+		            % compression_pool->amount_of_entries;
+
+		entry = &( compression_pool->entries[ entry_index ] );
+
+		if( memory_copy(
+		     entry->data,
+		     chunk_data,
+		     chunk_data_size ) == NULL )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_MEMORY,
+			 LIBERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to set chunk data in entry.",
+			 function );
+
+			result = -1;
+		}
+		else
+		{
+			entry->chunk               = chunk;
+			entry->data_size           = chunk_data_size;
+			entry->processed_data_size = 0;
+			entry->is_compressed       = 0;
+			entry->chunk_crc           = 0;
+			entry->write_crc           = 0;
+			entry->state               = LIBEWF_COMPRESSION_POOL_ENTRY_STATE_QUEUED;
+
+			compression_pool->amount_of_used_entries += 1;
+
+			thread_condition_signal(
+			 &( compression_pool->queued_condition ) );
+		}
+	}
+	if( thread_mutex_release(
+	     &( compression_pool->mutex ) ) != 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Retrieves the oldest entry of the compression pool if it has been processed
+ * Waits for the oldest entry to be processed if flush is set or no free entries remain
+ * Returns 1 if successful, 0 if no processed entry is available or -1 on error
+ */
+int libewf_compression_pool_get_processed_entry(
+     libewf_compression_pool_t *compression_pool,
+     libewf_compression_pool_entry_t **entry,
+     uint8_t flush,
+     liberror_error_t **error )
+{
+	libewf_compression_pool_entry_t *first_entry = NULL;
+	static char *function                        = "libewf_compression_pool_get_processed_entry";
+	int result                                   = 0;
+
+	if( compression_pool == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+	*entry = NULL;
+
+	if( thread_mutex_grab(
+	     &( compression_pool->mutex ) ) != 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( compression_pool->amount_of_used_entries > 0 )
+	{
+		first_entry = &( compression_pool->entries[ compression_pool->first_entry ] );
+
+		while( ( ( first_entry->state == LIBEWF_COMPRESSION_POOL_ENTRY_STATE_QUEUED )
+		      || ( first_entry->state == LIBEWF_COMPRESSION_POOL_ENTRY_STATE_PROCESSING ) )
+		    && ( ( flush != 0 )
+		      || ( compression_pool->amount_of_used_entries >= compression_pool->amount_of_entries ) ) )
+		{
+			thread_condition_wait(
+			 &( compression_pool->processed_condition ),
+			 &( compression_pool->mutex ) );
+		}
+		if( first_entry->state == LIBEWF_COMPRESSION_POOL_ENTRY_STATE_PROCESSED )
+		{
+			*entry = first_entry;
+
+			result = 1;
+		}
+		else if( first_entry->state == LIBEWF_COMPRESSION_POOL_ENTRY_STATE_FAILED )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_CONVERSION,
+			 LIBERROR_CONVERSION_ERROR_OUTPUT_FAILED,
+			 "%s: unable to process chunk: %" PRIu32 ".",
+			 function,
+			 first_entry->chunk );
+
+			result = -1;
+		}
+	}
+	if( thread_mutex_release(
+	     &( compression_pool->mutex ) ) != 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Removes the oldest entry from the compression pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_pool_remove_entry(
+     libewf_compression_pool_t *compression_pool,
+     liberror_error_t **error )
+{
+	static char *function = "libewf_compression_pool_remove_entry";
+	int result            = 1;
+
+	if( compression_pool == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( thread_mutex_grab(
+	     &( compression_pool->mutex ) ) != 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( compression_pool->amount_of_used_entries <= 0 )
+	 || ( ( compression_pool->entries[ compression_pool->first_entry ].state != LIBEWF_COMPRESSION_POOL_ENTRY_STATE_PROCESSED )
+	  && ( compression_pool->entries[ compression_pool->first_entry ].state != LIBEWF_COMPRESSION_POOL_ENTRY_STATE_FAILED ) ) )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_OUT_OF_RANGE,
+		 "%s: no processed entry available.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		compression_pool->entries[ compression_pool->first_entry ].state = LIBEWF_COMPRESSION_POOL_ENTRY_STATE_EMPTY;
+
+		compression_pool->first_entry += 1;
+
+		if( compression_pool->first_entry >= compression_pool->amount_of_entries )
+		{
+			compression_pool->first_entry = 0;
+		}
+		compression_pool->amount_of_used_entries -= 1;
+	}
+	if( thread_mutex_release(
+	     &( compression_pool->mutex ) ) != 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+#endif
+
@@ -0,0 +1,215 @@
+/*
+ * Compression pool functions
+ *
+ * Copyright (c) 2006-2009, Joachim Metz <forensics@hoffmannbv.nl>,
+ * Hoffmann Investigations.
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_COMPRESSION_POOL_H )
+#define _LIBEWF_COMPRESSION_POOL_H
+
+#include <common.h>
+#include <thread.h>
+#include <types.h>
+
+#include <liberror.h>
+
+#include "libewf_media_values.h"
+#include "libewf_types.h"
+
+#include "ewf_crc.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* The amount of pool entries per thread
+ * this allows the threads to continue processing
+ * while the processed chunks are being written
+ */
+#define LIBEWF_COMPRESSION_POOL_ENTRIES_PER_THREAD	4
+
+enum LIBEWF_COMPRESSION_POOL_ENTRY_STATES
+{
+	LIBEWF_COMPRESSION_POOL_ENTRY_STATE_EMPTY	= 0,
+	LIBEWF_COMPRESSION_POOL_ENTRY_STATE_QUEUED	= 1,
+	LIBEWF_COMPRESSION_POOL_ENTRY_STATE_PROCESSING	= 2,
+	LIBEWF_COMPRESSION_POOL_ENTRY_STATE_PROCESSED	= 3,
+	LIBEWF_COMPRESSION_POOL_ENTRY_STATE_FAILED	= 4
+};
+
+typedef struct libewf_compression_pool_entry libewf_compression_pool_entry_t;
+
+struct libewf_compression_pool_entry
+{
+	/* The state of the entry
+	 */
+	uint8_t state;
+
+	/* The chunk
+	 */
+	uint32_t chunk;
+
+	/* The allocated size of the data buffer
+	 */
+	size_t allocated_size;
+
+	/* The data buffer
+	 * contains the chunk data when queued
+	 * and the processed chunk data when processed
+	 */
+	uint8_t *data;
+
+	/* The size of the chunk data
+	 */
+	size_t data_size;
+
+	/* The size of the processed chunk data
+	 */
+	size_t processed_data_size;
+
+	/* Value to indicate if the processed chunk data is compressed
+	 */
+	int8_t is_compressed;
+
+	/* The CRC of the processed chunk data
+	 */
+	ewf_crc_t chunk_crc;
+
+	/* Value to indicate if the CRC should be written separately
+	 */
+	int8_t write_crc;
+
+	/* The buffer used to write the CRC
+	 */
+	uint8_t crc_buffer[ 4 ];
+};
+
+typedef struct libewf_compression_pool libewf_compression_pool_t;
+
+struct libewf_compression_pool
+{
+	/* The media values
+	 */
+	libewf_media_values_t *media_values;
+
+	/* The statistics
+	 */
+	libewf_statistics_t *statistics;
+
+	/* The compression level
+	 */
+	int8_t compression_level;
+
+	/* The compression flags
+	 */
+	uint8_t compression_flags;
+
+	/* The EWF format
+	 */
+	uint8_t ewf_format;
+
+	/* The amount of threads
+	 */
+	int amount_of_threads;
+
+	/* Dynamic array of the threads
+	 */
+	thread_t *threads;
+
+	/* The amount of entries
+	 */
+	int amount_of_entries;
+
+	/* Dynamic array of the entries, used as a ring buffer
+	 */
+	libewf_compression_pool_entry_t *entries;
+
+	/* The index of the oldest entry in use
+	 */
+	int first_entry;
+
+	/* The amount of entries in use
+	 */
+	int amount_of_used_entries;
+
+	/* The index of the next entry to be processed
+	 */
+	int process_entry;
+
+	/* Value to indicate the threads should stop
+	 */
+	uint8_t stop_threads;
+
+	/* The mutex that protects the entries
+	 */
+	thread_mutex_t mutex;
+
+	/* The condition that signals the threads a chunk was queued
+	 */
+	thread_condition_t queued_condition;
+
+	/* The condition that signals a chunk was processed
+	 */
+	thread_condition_t processed_condition;
+};
+
+int libewf_compression_pool_initialize(
+     libewf_compression_pool_t **compression_pool,
+     libewf_media_values_t *media_values,
+     libewf_statistics_t *statistics,
+     int8_t compression_level,
+     uint8_t compression_flags,
+     uint8_t ewf_format,
+     int amount_of_threads,
+     liberror_error_t **error );
+
+int libewf_compression_pool_free(
+     libewf_compression_pool_t **compression_pool,
+     liberror_error_t **error );
+
+void *libewf_compression_pool_process_chunks(
+       void *arguments );
+
+int libewf_compression_pool_append_chunk(
+     libewf_compression_pool_t *compression_pool,
+     uint32_t chunk,
+     uint8_t *chunk_data,
+     size_t chunk_data_size,
+     liberror_error_t **error );
+
+int libewf_compression_pool_get_processed_entry(
+     libewf_compression_pool_t *compression_pool,
+     libewf_compression_pool_entry_t **entry,
+     uint8_t flush,
+     liberror_error_t **error );
+
+int libewf_compression_pool_remove_entry(
+     libewf_compression_pool_t *compression_pool,
+     liberror_error_t **error );
+
+#endif
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif
+
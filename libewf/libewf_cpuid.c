@@ -0,0 +1,141 @@
+/*
+ * CPUID functions
+ *
+ * Copyright (c) 2006-2009, Joachim Metz <forensics@hoffmannbv.nl>,
+ * Hoffmann Investigations.
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <types.h>
+
+#include <thread.h>
+
+#include "libewf_cpuid.h"
+
+#if defined( HAVE_SIMD_SUPPORT )
+#include <cpuid.h>
+#endif
+
+/* The instruction set supported by both the processor and the operating system
+ * the value is determined once by libewf_cpuid_initialize_instruction_set
+ */
+static int libewf_cpuid_instruction_set = LIBEWF_CPUID_INSTRUCTION_SET_UNDETERMINED;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+/* Value to make sure the instruction set is determined only once
+ * since the checksum and empty block functions are called from multiple threads
+ */
+static thread_once_t libewf_cpuid_instruction_set_once = THREAD_ONCE_INITIALIZER;
+#endif
+
+/* Determines the instruction set supported by both the processor and the operating system
+ * Returns the instruction set
+ */
+int libewf_cpuid_determine_instruction_set(
+     void )
+{
+#if defined( HAVE_SIMD_SUPPORT )
+	unsigned int register_eax = 0;
+	unsigned int register_ebx = 0;
+	unsigned int register_ecx = 0;
+	unsigned int register_edx = 0;
+	unsigned int xcr0_lower   = 0;
+	unsigned int xcr0_upper   = 0;
+#endif
+	int instruction_set       = LIBEWF_CPUID_INSTRUCTION_SET_SCALAR;
+
+#if defined( HAVE_SIMD_SUPPORT )
+	if( __get_cpuid(
+	     1,
+	     &register_eax,
+	     &register_ebx,
+	     &register_ecx,
+	     &register_edx ) == 0 )
+	{
+		return( instruction_set );
+	}
+	if( ( register_edx & bit_SSE2 ) == 0 )
+	{
+		return( instruction_set );
+	}
+	instruction_set = LIBEWF_CPUID_INSTRUCTION_SET_SSE2;
+
+	if( ( register_ecx & bit_SSSE3 ) == 0 )
+	{
+		return( instruction_set );
+	}
+	instruction_set = LIBEWF_CPUID_INSTRUCTION_SET_SSSE3;
+
+	/* AVX2 also requires the operating system to save the YMM registers
+	 */
+	if( ( ( register_ecx & bit_OSXSAVE ) != 0 )
+	 && ( ( register_ecx & bit_AVX ) != 0 ) )
+	{
+		__asm__ __volatile__(
+		 "xgetbv"
+		 : "=a" ( xcr0_lower ), "=d" ( xcr0_upper )
+		 : "c" ( 0 ) );
+
+		if( ( ( xcr0_lower & 0x06 ) == 0x06 )
+		 && ( __get_cpuid_max( 0, &register_ebx ) >= 7 ) )
+		{
+			__cpuid_count(
+			 7,
+			 0,
+			 register_eax,
+			 register_ebx,
+			 register_ecx,
+			 register_edx );
+
+			if( ( register_ebx & bit_AVX2 ) != 0 )
+			{
+				instruction_set = LIBEWF_CPUID_INSTRUCTION_SET_AVX2;
+			}
+		}
+	}
+#endif
+	return( instruction_set );
+}
+
+/* Determines the instruction set and stores it in libewf_cpuid_instruction_set
+ */
+void libewf_cpuid_initialize_instruction_set(
+      void )
+{
+	libewf_cpuid_instruction_set = libewf_cpuid_determine_instruction_set();
+}
+
+/* Retrieves the instruction set supported by both the processor and the operating system
+ * The instruction set is determined on the first call
+ * Returns the instruction set
+ */
+int libewf_cpuid_get_instruction_set(
+     void )
+{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	thread_once(
+	 &libewf_cpuid_instruction_set_once,
+	 libewf_cpuid_initialize_instruction_set );
+#else
+	if( libewf_cpuid_instruction_set == LIBEWF_CPUID_INSTRUCTION_SET_UNDETERMINED )
+	{
+		libewf_cpuid_initialize_instruction_set();
+	}
+#endif
+	return( libewf_cpuid_instruction_set );
+}
@@ -0,0 +1,67 @@
+/*
+ * CPUID functions
+ *
+ * Copyright (c) 2006-2009, Joachim Metz <forensics@hoffmannbv.nl>,
+ * Hoffmann Investigations.
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_CPUID_H )
+#define _LIBEWF_CPUID_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The SIMD functions require compiler support
+ * for the target function attribute and the cpuid header
+ */
+#if defined( HAVE_CPUID_H ) && defined( HAVE_EMMINTRIN_H ) && defined( HAVE_IMMINTRIN_H ) \
+ && ( defined( __i386__ ) || defined( __x86_64__ ) ) \
+ && ( defined( __clang__ ) || ( __GNUC__ > 4 ) || ( ( __GNUC__ == 4 ) && ( __GNUC_MINOR__ >= 9 ) ) )
+#define HAVE_SIMD_SUPPORT	1
+#endif
+
+/* The instruction sets, every instruction set includes the ones before it
+ */
+enum LIBEWF_CPUID_INSTRUCTION_SETS
+{
+	LIBEWF_CPUID_INSTRUCTION_SET_UNDETERMINED	= 0,
+	LIBEWF_CPUID_INSTRUCTION_SET_SCALAR		= 1,
+	LIBEWF_CPUID_INSTRUCTION_SET_SSE2		= 2,
+	LIBEWF_CPUID_INSTRUCTION_SET_SSSE3		= 3,
+	LIBEWF_CPUID_INSTRUCTION_SET_AVX2		= 4
+};
+
+int libewf_cpuid_determine_instruction_set(
+     void );
+
+void libewf_cpuid_initialize_instruction_set(
+      void );
+
+int libewf_cpuid_get_instruction_set(
+     void );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif
+
@@ -31,6 +31,11 @@
 
 #define LIBEWF_2_TIB				0x20000000000ULL
 
+/* The size of the write buffer of a segment file
+ * used to combine the writes of the chunks and sections
+ */
+#define LIBEWF_SEGMENT_FILE_WRITE_BUFFER_SIZE	( 4 * 1024 * 1024 )
+
 /* Define HAVE_LOCAL_LIBEWF for local use of libewf
  */
 #if !defined( HAVE_LOCAL_LIBEWF )
@@ -48,15 +53,23 @@
  * bit 2	set to 1 for write access
  * bit 3-4	not used
  * bit 5        set to 1 to resume write
- * bit 6-8	not used
+ * bit 6	set to 1 to read the chunk offsets on demand
+ * bit 7	set to 1 to read the segment files using asynchronous file IO
+ * bit 8	set to 1 to read the segment files using memory mapped file IO
  */
 #define LIBEWF_FLAG_READ			(uint8_t) 0x01
 #define LIBEWF_FLAG_WRITE			(uint8_t) 0x02
 #define LIBEWF_FLAG_RESUME			(uint8_t) 0x10
+#define LIBEWF_FLAG_ON_DEMAND			(uint8_t) 0x20
+#define LIBEWF_FLAG_ASYNC_IO			(uint8_t) 0x40
+#define LIBEWF_FLAG_MEMORY_MAP			(uint8_t) 0x80
 
 /* The libewf file access macros
  */
 #define LIBEWF_OPEN_READ			( LIBEWF_FLAG_READ )
+#define LIBEWF_OPEN_READ_ON_DEMAND		( LIBEWF_FLAG_READ | LIBEWF_FLAG_ON_DEMAND )
+#define LIBEWF_OPEN_READ_ASYNC_IO		( LIBEWF_FLAG_READ | LIBEWF_FLAG_ASYNC_IO )
+#define LIBEWF_OPEN_READ_MEMORY_MAP		( LIBEWF_FLAG_READ | LIBEWF_FLAG_MEMORY_MAP )
 #define LIBEWF_OPEN_WRITE			( LIBEWF_FLAG_WRITE )
 #define LIBEWF_OPEN_WRITE_RESUME		( LIBEWF_FLAG_WRITE | LIBEWF_FLAG_RESUME )
 #define LIBEWF_OPEN_READ_WRITE			( LIBEWF_FLAG_READ | LIBEWF_FLAG_WRITE )
@@ -91,6 +104,14 @@ enum LIBEWF_FORMAT
  */
 #define LIBEWF_DEFAULT_SEGMENT_FILE_SIZE	( 1500 * 1024 * 1024 )
 
+/* The default maximum size of the chunk cache
+ */
+#define LIBEWF_DEFAULT_MAXIMUM_CACHE_SIZE	( 8 * 1024 * 1024 )
+
+/* The maximum number of threads used to process chunks
+ */
+#define LIBEWF_MAXIMUM_NUMBER_OF_THREADS	64
+
 /* The compression level definitions
  */
 enum LIBEWF_COMPRESSION_LEVELS
@@ -106,6 +127,25 @@ enum LIBEWF_COMPRESSION_LEVELS
  */
 #define LIBEWF_FLAG_COMPRESS_EMPTY_BLOCK	(uint8_t) 0x01
 
+/* The compression library definitions
+ */
+enum LIBEWF_COMPRESSION_LIBRARIES
+{
+	LIBEWF_COMPRESSION_LIBRARY_ZLIB		= 1,
+	LIBEWF_COMPRESSION_LIBRARY_LIBDEFLATE	= 2
+};
+
+/* The kernel definitions
+ */
+enum LIBEWF_KERNELS
+{
+	LIBEWF_KERNEL_ADLER32_ZLIB		= 1,
+	LIBEWF_KERNEL_ADLER32_SSSE3		= 2,
+	LIBEWF_KERNEL_ADLER32_AVX2		= 3,
+	LIBEWF_KERNEL_EMPTY_BLOCK_SCALAR	= 4,
+	LIBEWF_KERNEL_EMPTY_BLOCK_SSE2		= 5,
+	LIBEWF_KERNEL_EMPTY_BLOCK_AVX2		= 6
+};
 /* The media type definitions
  */
 enum LIBEWF_MEDIA_TYPES
@@ -27,48 +27,28 @@
 
 #include "libewf_empty_block.h"
 
+#if defined( HAVE_SIMD_SUPPORT )
+#include <emmintrin.h>
+#include <immintrin.h>
+#endif
+
 /* The largest primary (or scalar) available
  * supported by a single load and store instruction
  */
 typedef unsigned long int libewf_aligned_t;
 
-/* Check for empty block
- * An emtpy block is a block that contains the same value for every byte
- * Returns 1 if block is empty, 0 if not or -1 on error
+/* Check for empty block using the largest scalar
+ * Returns 1 if block is empty or 0 if not
  */
-int libewf_empty_block_test(
+int libewf_empty_block_test_scalar(
      const uint8_t *block_buffer,
-     size_t block_size,
-     liberror_error_t **error )
+     size_t block_size )
 {
 	libewf_aligned_t *aligned_block_iterator = NULL;
 	libewf_aligned_t *aligned_block_start    = NULL;
 	uint8_t *block_iterator                  = NULL;
 	uint8_t *block_start                     = NULL;
-	static char *function                    = "libewf_empty_block_test";
 
-	if( block_buffer == NULL )
-	{
-		liberror_error_set(
-		 error,
-		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid block buffer.",
-		 function );
-
-		return( -1 );
-	}
-	if( block_size > (size_t) SSIZE_MAX )
-	{
-		liberror_error_set(
-		 error,
-		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid block size value exceeds maximum.",
-		 function );
-
-		return( -1 );
-	}
 	block_start    = (uint8_t *) block_buffer;
 	block_iterator = (uint8_t *) block_buffer + 1;
 	block_size    -= 1;
@@ -126,3 +106,165 @@ int libewf_empty_block_test(
 	return( 1 );
 }
 
+#if defined( HAVE_SIMD_SUPPORT )
+
+/* Check for empty block using SSE2
+ * Compares 64 bytes per iteration to the first byte of the block
+ * Returns 1 if block is empty or 0 if not
+ */
+__attribute__((target("sse2")))
+int libewf_empty_block_test_sse2(
+     const uint8_t *block_buffer,
+     size_t block_size )
+{
+	__m128i block_value           = _mm_set1_epi8( (char) block_buffer[ 0 ] );
+	__m128i compare_result        = _mm_setzero_si128();
+	const uint8_t *block_iterator = block_buffer;
+
+	while( block_size >= 64 )
+	{
+		compare_result = _mm_and_si128(
+		                  _mm_and_si128(
+		                   _mm_cmpeq_epi8(
+		                    _mm_loadu_si128( (const __m128i *) block_iterator ),
+		                    block_value ),
+		                   _mm_cmpeq_epi8(
+		                    _mm_loadu_si128( (const __m128i *) &( block_iterator[ 16 ] ) ),
+		                    block_value ) ),
+		                  _mm_and_si128(
+		                   _mm_cmpeq_epi8(
+		                    _mm_loadu_si128( (const __m128i *) &( block_iterator[ 32 ] ) ),
+		                    block_value ),
+		                   _mm_cmpeq_epi8(
+		                    _mm_loadu_si128( (const __m128i *) &( block_iterator[ 48 ] ) ),
+		                    block_value ) ) );
+
+		if( _mm_movemask_epi8( compare_result ) != 0xffff )
+		{
+			return( 0 );
+		}
+		block_iterator += 64;
+		block_size     -= 64;
+	}
+	while( block_size != 0 )
+	{
+		if( *block_iterator != block_buffer[ 0 ] )
+		{
+			return( 0 );
+		}
+		block_iterator += 1;
+		block_size     -= 1;
+	}
+	return( 1 );
+}
+
+/* Check for empty block using AVX2
+ * Compares 128 bytes per iteration to the first byte of the block
+ * Returns 1 if block is empty or 0 if not
+ */
+__attribute__((target("avx2")))
+int libewf_empty_block_test_avx2(
+     const uint8_t *block_buffer,
+     size_t block_size )
+{
+	__m256i block_value           = _mm256_set1_epi8( (char) block_buffer[ 0 ] );
+	__m256i compare_result        = _mm256_setzero_si256();
+	const uint8_t *block_iterator = block_buffer;
+
+	while( block_size >= 128 )
+	{
+		compare_result = _mm256_and_si256(
+		                  _mm256_and_si256(
+		                   _mm256_cmpeq_epi8(
+		                    _mm256_loadu_si256( (const __m256i *) block_iterator ),
+		                    block_value ),
+		                   _mm256_cmpeq_epi8(
+		                    _mm256_loadu_si256( (const __m256i *) &( block_iterator[ 32 ] ) ),
+		                    block_value ) ),
+		                  _mm256_and_si256(
+		                   _mm256_cmpeq_epi8(
+		                    _mm256_loadu_si256( (const __m256i *) &( block_iterator[ 64 ] ) ),
+		                    block_value ),
+		                   _mm256_cmpeq_epi8(
+		                    _mm256_loadu_si256( (const __m256i *) &( block_iterator[ 96 ] ) ),
+		                    block_value ) ) );
+
+		if( _mm256_movemask_epi8( compare_result ) != -1 )
+		{
+			return( 0 );
+		}
+		block_iterator += 128;
+		block_size     -= 128;
+	}
+	while( block_size != 0 )
+	{
+		if( *block_iterator != block_buffer[ 0 ] )
+		{
+			return( 0 );
+		}
+		block_iterator += 1;
+		block_size     -= 1;
+	}
+	return( 1 );
+}
+
+#endif
+
+/* Check for empty block
+ * An emtpy block is a block that contains the same value for every byte
+ * Returns 1 if block is empty, 0 if not or -1 on error
+ */
+int libewf_empty_block_test(
+     const uint8_t *block_buffer,
+     size_t block_size,
+     liberror_error_t **error )
+{
+	static char *function = "libewf_empty_block_test";
+
+#if defined( HAVE_SIMD_SUPPORT )
+	int instruction_set   = 0;
+#endif
+
+	if( block_buffer == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_size > (size_t) SSIZE_MAX )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid block size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_SIMD_SUPPORT )
+	instruction_set = libewf_cpuid_get_instruction_set();
+
+	if( instruction_set == LIBEWF_CPUID_INSTRUCTION_SET_AVX2 )
+	{
+		return( libewf_empty_block_test_avx2(
+		         block_buffer,
+		         block_size ) );
+	}
+	else if( instruction_set >= LIBEWF_CPUID_INSTRUCTION_SET_SSE2 )
+	{
+		return( libewf_empty_block_test_sse2(
+		         block_buffer,
+		         block_size ) );
+	}
+#endif
+	return( libewf_empty_block_test_scalar(
+	         block_buffer,
+	         block_size ) );
+}
+
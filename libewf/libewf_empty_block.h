@@ -28,10 +28,26 @@
 
 #include <liberror.h>
 
+#include "libewf_cpuid.h"
+
 #if defined( __cplusplus )
 extern "C" {
 #endif
 
+int libewf_empty_block_test_scalar(
+     const uint8_t *block_buffer,
+     size_t block_size );
+
+#if defined( HAVE_SIMD_SUPPORT )
+int libewf_empty_block_test_sse2(
+     const uint8_t *block_buffer,
+     size_t block_size );
+
+int libewf_empty_block_test_avx2(
+     const uint8_t *block_buffer,
+     size_t block_size );
+#endif
+
 int libewf_empty_block_test(
      const uint8_t *block_buffer,
      size_t block_size,
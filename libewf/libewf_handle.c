@@ -30,10 +30,12 @@
 #include "libewf_definitions.h"
 #include "libewf_handle.h"
 #include "libewf_header_values.h"
+#include "libewf_index_file.h"
 #include "libewf_io_handle.h"
 #include "libewf_libbfio.h"
 #include "libewf_segment_file.h"
 #include "libewf_segment_file_handle.h"
+#include "libewf_statistics.h"
 #include "libewf_string.h"
 #include "libewf_types.h"
 #include "libewf_write_io_handle.h"
@@ -410,6 +412,23 @@ int libewf_handle_free(
 	{
 		internal_handle = (libewf_internal_handle_t *) *handle;
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		/* The read-ahead threads need to be stopped before the values they use are freed
+		 */
+		if( libewf_read_ahead_pool_free(
+		     &( internal_handle->read_ahead_pool ),
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read-ahead pool.",
+			 function );
+
+			result = -1;
+		}
+#endif
 		if( libewf_io_handle_free(
 		     &( internal_handle->io_handle ),
 		     error ) != 1 )
@@ -488,6 +507,20 @@ int libewf_handle_free(
 
 			result = -1;
 		}
+		if( ( internal_handle->index_file_io_handle != NULL )
+		 && ( libbfio_handle_free(
+		       &( internal_handle->index_file_io_handle ),
+		       error ) != 1 ) )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free index file io handle.",
+			 function );
+
+			result = -1;
+		}
 		if( libewf_chunk_cache_free(
 		     &( internal_handle->chunk_cache ),
 		     error ) != 1 )
@@ -646,6 +679,7 @@ int libewf_handle_open(
 	size_t filename_length                    = 0;
 	int file_io_pool_entry                    = 0;
 	int filename_iterator                     = 0;
+	int result                                = 0;
 
 	if( handle == NULL )
 	{
@@ -693,6 +727,18 @@ int libewf_handle_open(
 
 		return( -1 );
 	}
+	if( ( ( flags & LIBEWF_FLAG_ASYNC_IO ) == LIBEWF_FLAG_ASYNC_IO )
+	 && ( ( flags & LIBEWF_FLAG_MEMORY_MAP ) == LIBEWF_FLAG_MEMORY_MAP ) )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported flags - asynchronous file IO and memory mapping cannot be combined.",
+		 function );
+
+		return( -1 );
+	}
 	if( libbfio_pool_initialize(
 	     &file_io_pool,
 	     0,
@@ -738,9 +784,31 @@ int libewf_handle_open(
 			}
 			file_io_handle = NULL;
 
-			if( libbfio_file_initialize(
-			     &file_io_handle,
-			     error ) != 1 )
+			/* Asynchronous and memory mapped file IO are only used when the segment files are not written
+			 */
+			if( ( ( flags & LIBEWF_FLAG_ASYNC_IO ) == LIBEWF_FLAG_ASYNC_IO )
+			 && ( ( flags & LIBEWF_FLAG_WRITE ) == 0 )
+			 && ( ( flags & LIBEWF_FLAG_RESUME ) == 0 ) )
+			{
+				result = libbfio_async_file_initialize(
+				          &file_io_handle,
+				          error );
+			}
+			else if( ( ( flags & LIBEWF_FLAG_MEMORY_MAP ) == LIBEWF_FLAG_MEMORY_MAP )
+			      && ( ( flags & LIBEWF_FLAG_WRITE ) == 0 )
+			      && ( ( flags & LIBEWF_FLAG_RESUME ) == 0 ) )
+			{
+				result = libbfio_mmap_file_initialize(
+				          &file_io_handle,
+				          error );
+			}
+			else
+			{
+				result = libbfio_file_initialize(
+				          &file_io_handle,
+				          error );
+			}
+			if( result != 1 )
 			{
 				liberror_error_set(
 				 error,
@@ -1006,6 +1074,7 @@ int libewf_handle_open_wide(
 	size_t filename_length                    = 0;
 	int file_io_pool_entry                    = 0;
 	int filename_iterator                     = 0;
+	int result                                = 0;
 
 	if( handle == NULL )
 	{
@@ -1053,6 +1122,18 @@ int libewf_handle_open_wide(
 
 		return( -1 );
 	}
+	if( ( ( flags & LIBEWF_FLAG_ASYNC_IO ) == LIBEWF_FLAG_ASYNC_IO )
+	 && ( ( flags & LIBEWF_FLAG_MEMORY_MAP ) == LIBEWF_FLAG_MEMORY_MAP ) )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported flags - asynchronous file IO and memory mapping cannot be combined.",
+		 function );
+
+		return( -1 );
+	}
 	if( libbfio_pool_initialize(
 	     &file_io_pool,
 	     0,
@@ -1096,9 +1177,31 @@ int libewf_handle_open_wide(
 			}
 			file_io_handle = NULL;
 
-			if( libbfio_file_initialize(
-			     &file_io_handle,
-			     error ) != 1 )
+			/* Asynchronous and memory mapped file IO are only used when the segment files are not written
+			 */
+			if( ( ( flags & LIBEWF_FLAG_ASYNC_IO ) == LIBEWF_FLAG_ASYNC_IO )
+			 && ( ( flags & LIBEWF_FLAG_WRITE ) == 0 )
+			 && ( ( flags & LIBEWF_FLAG_RESUME ) == 0 ) )
+			{
+				result = libbfio_async_file_initialize(
+				          &file_io_handle,
+				          error );
+			}
+			else if( ( ( flags & LIBEWF_FLAG_MEMORY_MAP ) == LIBEWF_FLAG_MEMORY_MAP )
+			      && ( ( flags & LIBEWF_FLAG_WRITE ) == 0 )
+			      && ( ( flags & LIBEWF_FLAG_RESUME ) == 0 ) )
+			{
+				result = libbfio_mmap_file_initialize(
+				          &file_io_handle,
+				          error );
+			}
+			else
+			{
+				result = libbfio_file_initialize(
+				          &file_io_handle,
+				          error );
+			}
+			if( result != 1 )
 			{
 				liberror_error_set(
 				 error,
@@ -1539,6 +1642,15 @@ int libewf_handle_open_file_io_pool(
 				return( -1 );
 			}
 		}
+		/* The chunk offsets are only read on demand when the segment files are not written
+		 */
+		if( ( ( ( flags & LIBEWF_FLAG_ON_DEMAND ) == LIBEWF_FLAG_ON_DEMAND )
+		  || ( internal_handle->index_file_io_handle != NULL ) )
+		 && ( ( flags & LIBEWF_FLAG_WRITE ) == 0 )
+		 && ( ( flags & LIBEWF_FLAG_RESUME ) == 0 ) )
+		{
+			internal_handle->offset_table->read_on_demand = 1;
+		}
 		result = libewf_segment_table_build(
 		          internal_handle->segment_table,
 		          internal_handle->io_handle,
@@ -1574,6 +1686,68 @@ int libewf_handle_open_file_io_pool(
 				return( -1 );
 			}
 		}
+		/* The index file is read before the delta segment files
+		 * so that it only contains the chunk offsets of the segment files
+		 */
+		if( ( result == 1 )
+		 && ( internal_handle->index_file_io_handle != NULL )
+		 && ( internal_handle->offset_table->read_on_demand != 0 ) )
+		{
+			result = libewf_index_file_read(
+			          internal_handle->index_file_io_handle,
+			          internal_handle->offset_table,
+			          internal_handle->segment_table,
+			          internal_handle->header_sections,
+			          internal_handle->hash_sections,
+			          file_io_pool,
+			          error );
+
+			if( result == -1 )
+			{
+				libnotify_print_error_backtrace(
+				 *error );
+				liberror_error_free(
+				 error );
+			}
+			if( result != 1 )
+			{
+				/* An index file that does not correspond is discarded, the table sections
+				 * are not marked as read so their chunk offsets are read from the segment files
+				 * and the index file is rewritten
+				 */
+				if( libewf_offset_table_read_table_sections(
+				     internal_handle->offset_table,
+				     file_io_pool,
+				     error ) != 1 )
+				{
+					liberror_error_set(
+					 error,
+					 LIBERROR_ERROR_DOMAIN_IO,
+					 LIBERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read table sections.",
+					 function );
+
+					internal_handle->io_handle->file_io_pool = NULL;
+
+					return( -1 );
+				}
+				if( libewf_index_file_write(
+				     internal_handle->index_file_io_handle,
+				     internal_handle->offset_table,
+				     internal_handle->segment_table,
+				     internal_handle->header_sections,
+				     internal_handle->hash_sections,
+				     file_io_pool,
+				     error ) != 1 )
+				{
+					libnotify_print_error_backtrace(
+					 *error );
+					liberror_error_free(
+					 error );
+				}
+			}
+			result = 1;
+		}
 		if( ( flags & LIBEWF_FLAG_RESUME ) == 0 )
 		{
 			if( ( internal_handle->delta_segment_table->amount > 1 )
@@ -1734,6 +1908,21 @@ int libewf_handle_close(
 
 		return( -1 );
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libewf_read_ahead_pool_free(
+	     &( internal_handle->read_ahead_pool ),
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free read-ahead pool.",
+		 function );
+
+		return( -1 );
+	}
+#endif
 	if( ( internal_handle->io_handle->pool_created_in_library != 0 )
 	 && ( libbfio_pool_close_all(
 	       internal_handle->io_handle->file_io_pool,
@@ -1765,6 +1954,7 @@ off64_t libewf_handle_seek_offset(
 	static char *function                     = "libewf_handle_seek_offset";
 	uint64_t chunk                            = 0;
 	uint64_t chunk_offset                     = 0;
+	int result                                = 0;
 
 	if( handle == NULL )
 	{
@@ -1859,11 +2049,32 @@ off64_t libewf_handle_seek_offset(
 
 			return( -1 );
 		}
-		if( libewf_offset_table_seek_chunk_offset(
-		     internal_handle->offset_table,
-		     (uint32_t) chunk,
-		     internal_handle->io_handle->file_io_pool,
-		     error ) == -1 )
+		if( libewf_io_handle_grab_file_io_pool(
+		     internal_handle->io_handle,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab file io pool.",
+			 function );
+
+			return( -1 );
+		}
+		result = libewf_offset_table_seek_chunk_offset(
+		          internal_handle->offset_table,
+		          (uint32_t) chunk,
+		          internal_handle->io_handle->file_io_pool,
+		          error );
+
+		if( libewf_io_handle_release_file_io_pool(
+		     internal_handle->io_handle,
+		     NULL ) != 1 )
+		{
+			result = -1;
+		}
+		if( result == -1 )
 		{
 			liberror_error_set(
 			 error,
@@ -1935,6 +2146,17 @@ ssize_t libewf_handle_prepare_read_chunk(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
+	if( internal_handle->io_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing io handle.",
+		 function );
+
+		return( -1 );
+	}
 	if( internal_handle->chunk_cache == NULL )
 	{
 		liberror_error_set(
@@ -1979,6 +2201,7 @@ ssize_t libewf_handle_prepare_read_chunk(
 	                   (ewf_crc_t) chunk_crc,
 	                   read_crc,
 	                   &crc_mismatch,
+	                   &( internal_handle->io_handle->statistics ),
 	                   error );
 
 	if( chunk_data_size <= -1 )
@@ -2231,8 +2454,85 @@ ssize_t libewf_handle_read_buffer(
 			return( -1 );
 		}
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The chunks are only read ahead if the handle is opened for reading only
+	 */
+	if( ( internal_handle->read_ahead_pool == NULL )
+	 && ( internal_handle->io_handle->maximum_number_of_threads > 1 )
+	 && ( ( internal_handle->io_handle->flags & LIBEWF_FLAG_WRITE ) == 0 )
+	 && ( libewf_read_ahead_pool_initialize(
+	       &( internal_handle->read_ahead_pool ),
+	       internal_handle->read_io_handle,
+	       internal_handle->io_handle,
+	       internal_handle->media_values,
+	       internal_handle->offset_table,
+	       internal_handle->chunk_cache,
+	       internal_handle->io_handle->maximum_number_of_threads,
+	       error ) != 1 ) )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create read-ahead pool.",
+		 function );
+
+		return( -1 );
+	}
+#endif
 	while( size > 0 )
 	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( internal_handle->read_ahead_pool != NULL )
+		{
+			if( libewf_read_ahead_pool_queue_chunks(
+			     internal_handle->read_ahead_pool,
+			     internal_handle->io_handle->current_chunk,
+			     error ) != 1 )
+			{
+				liberror_error_set(
+				 error,
+				 LIBERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to queue chunks to read ahead.",
+				 function );
+
+				return( -1 );
+			}
+			/* Wait for the chunk if it is being read ahead
+			 */
+			if( libewf_read_ahead_pool_wait_for_chunk(
+			     internal_handle->read_ahead_pool,
+			     internal_handle->io_handle->current_chunk,
+			     error ) != 1 )
+			{
+				liberror_error_set(
+				 error,
+				 LIBERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to wait for chunk read ahead.",
+				 function );
+
+				return( -1 );
+			}
+		}
+#endif
+		/* The chunk cache is used exclusively
+		 * since it can be shared with libewf_handle_read_buffer_at_offset
+		 */
+		if( libewf_chunk_cache_grab_for_write(
+		     internal_handle->chunk_cache,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab chunk cache for writing.",
+			 function );
+
+			return( -1 );
+		}
 		chunk_read_count = libewf_read_io_handle_read_chunk_data(
 		                    internal_handle->read_io_handle,
 		                    internal_handle->io_handle,
@@ -2245,6 +2545,19 @@ ssize_t libewf_handle_read_buffer(
 		                    size,
 		                    error );
 
+		if( libewf_chunk_cache_release(
+		     internal_handle->chunk_cache,
+		     NULL ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release chunk cache.",
+			 function );
+
+			return( -1 );
+		}
 		if( chunk_read_count <= -1 )
 		{
 			liberror_error_set(
@@ -2337,28 +2650,24 @@ ssize_t libewf_handle_read_random(
 	return( read_count );
 }
 
-/* Writes a chunk in EWF format from a buffer at the current offset
- * the necessary settings of the write values must have been made
- * size contains the size of the data within the buffer while
- * data size contains the size of the actual input data
- * Will initialize write if necessary
- * Returns the amount of input bytes written, 0 when no longer bytes can be written or -1 on error
+/* Reads media data from an offset into a buffer
+ * This function does not change the current offset and
+ * can be called by multiple threads on the same handle at the same time
+ * Returns the amount of bytes read or -1 on error
  */
-ssize_t libewf_handle_prepare_write_chunk(
+ssize_t libewf_handle_read_buffer_at_offset(
          libewf_handle_t *handle,
-         void *chunk_buffer,
-         size_t chunk_buffer_size,
-         void *compressed_buffer,
-         size_t *compressed_buffer_size,
-         int8_t *is_compressed,
-         uint32_t *chunk_crc,
-         int8_t *write_crc,
+         void *buffer,
+         size_t size,
+         off64_t offset,
          liberror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_prepare_write_chunk";
-	ssize_t chunk_data_size                   = 0;
-	uint8_t chunk_exists                      = 0;
+	static char *function                     = "libewf_handle_read_buffer_at_offset";
+	ssize_t chunk_read_count                  = 0;
+	ssize_t total_read_count                  = 0;
+	uint64_t chunk                            = 0;
+	uint64_t chunk_offset                     = 0;
 
 	if( handle == NULL )
 	{
@@ -2384,6 +2693,17 @@ ssize_t libewf_handle_prepare_write_chunk(
 
 		return( -1 );
 	}
+	if( internal_handle->media_values == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
 	if( internal_handle->chunk_cache == NULL )
 	{
 		liberror_error_set(
@@ -2395,108 +2715,142 @@ ssize_t libewf_handle_prepare_write_chunk(
 
 		return( -1 );
 	}
-	if( ( chunk_buffer == internal_handle->chunk_cache->data )
-	 || ( chunk_buffer == internal_handle->chunk_cache->compressed ) )
+	if( buffer == NULL )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid chunk buffer - same as chunk cache.",
+		 "%s: invalid buffer.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( compressed_buffer == internal_handle->chunk_cache->data )
-	 || ( compressed_buffer == internal_handle->chunk_cache->compressed ) )
+	if( size > (size_t) SSIZE_MAX )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid compressed buffer - same as chunk cache.",
+		 LIBERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->read_io_handle != NULL )
+	if( ( offset < 0 )
+	 || ( offset > (off64_t) internal_handle->media_values->media_size ) )
 	{
-		/* Check if chunk has already been created within a segment file
-		 */
-		if( ( internal_handle->io_handle->current_chunk >= internal_handle->offset_table->amount_of_chunk_offsets )
-		 || ( internal_handle->offset_table->chunk_offset == NULL )
-		 || ( internal_handle->offset_table->chunk_offset[ internal_handle->io_handle->current_chunk ].segment_file_handle == NULL ) )
-		{
-			if( ( ( internal_handle->io_handle->flags & LIBEWF_FLAG_READ ) == LIBEWF_FLAG_READ )
-			 && ( ( internal_handle->io_handle->flags & LIBEWF_FLAG_RESUME ) == 0 ) )
-			{
-				liberror_error_set(
-				 error,
-				 LIBERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
-				 "%s: chunk: %d does not exist.",
-				 function,
-				 internal_handle->io_handle->current_chunk );
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_OUT_OF_RANGE,
+		 "%s: invalid offset value out of range.",
+		 function );
 
-				return( -1 );
-			}
-		}
-		else
-		{
-			chunk_exists = 1;
-		}
+		return( -1 );
 	}
-	chunk_data_size = libewf_write_io_handle_process_chunk(
-	                   internal_handle->chunk_cache,
-	                   internal_handle->media_values,
-	                   internal_handle->io_handle->compression_level,
-	                   internal_handle->io_handle->compression_flags,
-	                   internal_handle->io_handle->ewf_format,
-	                   (uint8_t *) chunk_buffer,
-	                   chunk_buffer_size,
-	                   (uint8_t *) compressed_buffer,
-	                   compressed_buffer_size,
-	                   is_compressed,
-	                   chunk_exists,
-	                   (ewf_crc_t *) chunk_crc,
-	                   write_crc,
-	                   error );
+#if defined( HAVE_VERBOSE_OUTPUT )
+	libnotify_verbose_printf(
+	 "%s: reading size: %" PRIzu " at offset: %" PRIi64 ".\n",
+	 function,
+	 size,
+	 offset );
+#endif
 
-	if( chunk_data_size <= -1 )
+	/* Determine the chunk and the offset within the decompressed chunk that is requested
+	 */
+	chunk        = offset / internal_handle->media_values->chunk_size;
+	chunk_offset = offset % internal_handle->media_values->chunk_size;
+
+	if( chunk >= (uint64_t) INT32_MAX )
 	{
 		liberror_error_set(
 		 error,
-		 LIBERROR_ERROR_DOMAIN_CONVERSION,
-		 LIBERROR_CONVERSION_ERROR_OUTPUT_FAILED,
-		 "%s: unable to prepare chunk.",
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid chunk value exceeds maximum.",
 		 function );
 
 		return( -1 );
 	}
-	return( chunk_data_size );
+	while( size > 0 )
+	{
+		chunk_read_count = libewf_read_io_handle_read_chunk_data_concurrent(
+		                    internal_handle->read_io_handle,
+		                    internal_handle->io_handle,
+		                    internal_handle->media_values,
+		                    internal_handle->offset_table,
+		                    internal_handle->chunk_cache,
+		                    (uint32_t) chunk,
+		                    (uint32_t) chunk_offset,
+		                    (uint8_t *) &( (uint8_t *) buffer )[ total_read_count ],
+		                    size,
+		                    error );
+
+		if( chunk_read_count <= -1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read data from chunk: %" PRIu64 ".",
+			 function,
+			 chunk );
+
+			return( -1 );
+		}
+		else if( chunk_read_count == 0 )
+		{
+			break;
+		}
+		size             -= chunk_read_count;
+		total_read_count += chunk_read_count;
+		chunk_offset     += chunk_read_count;
+
+		if( chunk_offset == internal_handle->media_values->chunk_size )
+		{
+			chunk_offset = 0;
+			chunk       += 1;
+		}
+		else if( chunk_offset > internal_handle->media_values->chunk_size )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_VALUE_OUT_OF_RANGE,
+			 "%s: invalid chunk offset.",
+			 function );
+
+			return( -1 );
+		}
+		if( internal_handle->abort == 1 )
+		{
+			break;
+		}
+	}
+	return( total_read_count );
 }
 
-/* Writes a chunk in EWF format from a buffer at the current offset
- * the necessary settings of the write values must have been made
- * size contains the size of the data within the buffer while
- * data size contains the size of the actual input data
- * Will initialize write if necessary
- * Returns the amount of input bytes written, 0 when no longer bytes can be written or -1 on error
+/* Determines if a range of the media data is empty
+ * The range is empty if the chunks it spans are known to contain zero bytes only
+ * Chunks that are not yet known to be empty are only read if their compressed size
+ * is small enough to be an empty block, hence uncompressed chunks are never empty
+ * This is not a full zero test, a range that is not empty can contain zero bytes only
+ * Chunks that are known to be empty are neither read nor decompressed
+ * This function does not change the current offset
+ * Returns 1 if the range is empty, 0 if not or -1 on error
  */
-ssize_t libewf_handle_write_chunk(
-         libewf_handle_t *handle,
-         void *chunk_buffer,
-         size_t chunk_buffer_size,
-         size_t data_size,
-         int8_t is_compressed,
-         void *crc_buffer,
-         uint32_t chunk_crc,
-         int8_t write_crc,
-         liberror_error_t **error )
+int libewf_handle_is_empty_range(
+     libewf_handle_t *handle,
+     off64_t offset,
+     size64_t size,
+     liberror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_write_chunk";
-	ssize_t write_count                       = 0;
+	static char *function                     = "libewf_handle_is_empty_range";
+	uint64_t chunk                            = 0;
+	uint64_t last_chunk                       = 0;
+	int result                                = 0;
 
 	if( handle == NULL )
 	{
@@ -2533,114 +2887,398 @@ ssize_t libewf_handle_write_chunk(
 
 		return( -1 );
 	}
-	if( internal_handle->write_io_handle == NULL )
+	if( internal_handle->chunk_cache == NULL )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing subhandle write.",
+		 "%s: invalid handle - missing chunk cache.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( internal_handle->write_io_handle->values_initialized == 0 )
-	 && ( libewf_write_io_handle_initialize_values(
-	       internal_handle->write_io_handle,
-	       internal_handle->io_handle,
-	       internal_handle->media_values,
-	       internal_handle->segment_table,
-	       error ) != 1 ) )
+	if( internal_handle->media_values->chunk_size == 0 )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to initialize write io handle values.",
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing chunk size.",
 		 function );
 
 		return( -1 );
 	}
-	if( chunk_buffer == NULL )
+	if( ( offset < 0 )
+	 || ( offset > (off64_t) internal_handle->media_values->media_size ) )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid chunk buffer.",
+		 LIBERROR_ARGUMENT_ERROR_VALUE_OUT_OF_RANGE,
+		 "%s: invalid offset value out of range.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( chunk_buffer == internal_handle->chunk_cache->data )
-	 || ( chunk_buffer == internal_handle->chunk_cache->compressed ) )
+	if( size > ( internal_handle->media_values->media_size - (size64_t) offset ) )
+	{
+		size = internal_handle->media_values->media_size - (size64_t) offset;
+	}
+	if( size == 0 )
+	{
+		return( 0 );
+	}
+	chunk      = (uint64_t) offset / internal_handle->media_values->chunk_size;
+	last_chunk = ( (uint64_t) offset + size - 1 ) / internal_handle->media_values->chunk_size;
+
+	if( last_chunk >= (uint64_t) INT32_MAX )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid chunk value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	while( chunk <= last_chunk )
+	{
+		result = libewf_read_io_handle_is_empty_chunk(
+		          internal_handle->io_handle,
+		          internal_handle->media_values,
+		          internal_handle->offset_table,
+		          internal_handle->chunk_cache,
+		          (uint32_t) chunk,
+		          error );
+
+		if( result == -1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if chunk: %" PRIu64 " is empty.",
+			 function,
+			 chunk );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		chunk += 1;
+	}
+	return( result );
+}
+
+/* Writes a chunk in EWF format from a buffer at the current offset
+ * the necessary settings of the write values must have been made
+ * size contains the size of the data within the buffer while
+ * data size contains the size of the actual input data
+ * Will initialize write if necessary
+ * Returns the amount of input bytes written, 0 when no longer bytes can be written or -1 on error
+ */
+ssize_t libewf_handle_prepare_write_chunk(
+         libewf_handle_t *handle,
+         void *chunk_buffer,
+         size_t chunk_buffer_size,
+         void *compressed_buffer,
+         size_t *compressed_buffer_size,
+         int8_t *is_compressed,
+         uint32_t *chunk_crc,
+         int8_t *write_crc,
+         liberror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_prepare_write_chunk";
+	ssize_t chunk_data_size                   = 0;
+	uint8_t chunk_exists                      = 0;
+
+	if( handle == NULL )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid chunk buffer - same as chunk cache.",
+		 "%s: invalid handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->offset_table == NULL )
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing offset table.",
+		 "%s: invalid handle - missing io handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( data_size > internal_handle->media_values->chunk_size )
+	if( internal_handle->chunk_cache == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_buffer == internal_handle->chunk_cache->data )
+	 || ( chunk_buffer == internal_handle->chunk_cache->compressed ) )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBERROR_ARGUMENT_ERROR_VALUE_OUT_OF_RANGE,
-		 "%s: data size cannot be larger than maximum chunk size.",
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk buffer - same as chunk cache.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_VERBOSE_OUTPUT )
-	libnotify_verbose_printf(
-	 "%s: writing chunk: %d of total: %d.\n",
-	 function,
-	 internal_handle->io_handle->current_chunk,
-	 internal_handle->offset_table->amount_of_chunk_offsets );
-	libnotify_verbose_printf(
-	 "%s: writing chunk buffer of size: %" PRIzd " with data of size: %" PRIzd ".\n",
-	 function,
-	 chunk_buffer_size,
-	 data_size );
-#endif
+	if( ( compressed_buffer == internal_handle->chunk_cache->data )
+	 || ( compressed_buffer == internal_handle->chunk_cache->compressed ) )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed buffer - same as chunk cache.",
+		 function );
 
-	if( ( ( internal_handle->io_handle->flags & LIBEWF_FLAG_READ ) == LIBEWF_FLAG_READ )
-	 && ( ( internal_handle->io_handle->flags & LIBEWF_FLAG_RESUME ) == 0 ) )
+		return( -1 );
+	}
+	if( internal_handle->read_io_handle != NULL )
 	{
 		/* Check if chunk has already been created within a segment file
 		 */
 		if( ( internal_handle->io_handle->current_chunk >= internal_handle->offset_table->amount_of_chunk_offsets )
 		 || ( internal_handle->offset_table->chunk_offset == NULL )
-		 || ( internal_handle->offset_table->chunk_offset[ internal_handle->io_handle->current_chunk ].segment_file_handle == NULL ) )
+		 || ( internal_handle->offset_table->chunk_offset[ internal_handle->io_handle->current_chunk ].segment_file_index == 0 ) )
 		{
-			liberror_error_set(
-			 error,
-			 LIBERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: chunk: %d does not exist.",
-			 function,
-			 internal_handle->io_handle->current_chunk );
-
-			return( -1 );
-		}
-		write_count = libewf_write_io_handle_write_existing_chunk(
-		               internal_handle->write_io_handle,
-		               internal_handle->io_handle,
+			if( ( ( internal_handle->io_handle->flags & LIBEWF_FLAG_READ ) == LIBEWF_FLAG_READ )
+			 && ( ( internal_handle->io_handle->flags & LIBEWF_FLAG_RESUME ) == 0 ) )
+			{
+				liberror_error_set(
+				 error,
+				 LIBERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: chunk: %d does not exist.",
+				 function,
+				 internal_handle->io_handle->current_chunk );
+
+				return( -1 );
+			}
+		}
+		else
+		{
+			chunk_exists = 1;
+		}
+	}
+	chunk_data_size = libewf_write_io_handle_process_chunk(
+	                   internal_handle->chunk_cache,
+	                   internal_handle->media_values,
+	                   internal_handle->io_handle->compression_level,
+	                   internal_handle->io_handle->compression_flags,
+	                   internal_handle->io_handle->ewf_format,
+	                   (uint8_t *) chunk_buffer,
+	                   chunk_buffer_size,
+	                   (uint8_t *) compressed_buffer,
+	                   compressed_buffer_size,
+	                   is_compressed,
+	                   chunk_exists,
+	                   (ewf_crc_t *) chunk_crc,
+	                   write_crc,
+	                   &( internal_handle->io_handle->statistics ),
+	                   error );
+
+	if( chunk_data_size <= -1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBERROR_CONVERSION_ERROR_OUTPUT_FAILED,
+		 "%s: unable to prepare chunk.",
+		 function );
+
+		return( -1 );
+	}
+	return( chunk_data_size );
+}
+
+/* Writes a chunk in EWF format from a buffer at the current offset
+ * the necessary settings of the write values must have been made
+ * size contains the size of the data within the buffer while
+ * data size contains the size of the actual input data
+ * Will initialize write if necessary
+ * Returns the amount of input bytes written, 0 when no longer bytes can be written or -1 on error
+ */
+ssize_t libewf_handle_write_chunk(
+         libewf_handle_t *handle,
+         void *chunk_buffer,
+         size_t chunk_buffer_size,
+         size_t data_size,
+         int8_t is_compressed,
+         void *crc_buffer,
+         uint32_t chunk_crc,
+         int8_t write_crc,
+         liberror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_write_chunk";
+	ssize_t write_count                       = 0;
+
+	if( handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing io handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->write_io_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing subhandle write.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_handle->write_io_handle->values_initialized == 0 )
+	 && ( libewf_write_io_handle_initialize_values(
+	       internal_handle->write_io_handle,
+	       internal_handle->io_handle,
+	       internal_handle->media_values,
+	       internal_handle->segment_table,
+	       error ) != 1 ) )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize write io handle values.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_buffer == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_buffer == internal_handle->chunk_cache->data )
+	 || ( chunk_buffer == internal_handle->chunk_cache->compressed ) )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk buffer - same as chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->offset_table == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing offset table.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > internal_handle->media_values->chunk_size )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_OUT_OF_RANGE,
+		 "%s: data size cannot be larger than maximum chunk size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_VERBOSE_OUTPUT )
+	libnotify_verbose_printf(
+	 "%s: writing chunk: %d of total: %d.\n",
+	 function,
+	 internal_handle->io_handle->current_chunk,
+	 internal_handle->offset_table->amount_of_chunk_offsets );
+	libnotify_verbose_printf(
+	 "%s: writing chunk buffer of size: %" PRIzd " with data of size: %" PRIzd ".\n",
+	 function,
+	 chunk_buffer_size,
+	 data_size );
+#endif
+
+	if( ( ( internal_handle->io_handle->flags & LIBEWF_FLAG_READ ) == LIBEWF_FLAG_READ )
+	 && ( ( internal_handle->io_handle->flags & LIBEWF_FLAG_RESUME ) == 0 ) )
+	{
+		/* Check if chunk has already been created within a segment file
+		 */
+		if( ( internal_handle->io_handle->current_chunk >= internal_handle->offset_table->amount_of_chunk_offsets )
+		 || ( internal_handle->offset_table->chunk_offset == NULL )
+		 || ( internal_handle->offset_table->chunk_offset[ internal_handle->io_handle->current_chunk ].segment_file_index == 0 ) )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: chunk: %d does not exist.",
+			 function,
+			 internal_handle->io_handle->current_chunk );
+
+			return( -1 );
+		}
+		write_count = libewf_write_io_handle_write_existing_chunk(
+		               internal_handle->write_io_handle,
+		               internal_handle->io_handle,
 		               internal_handle->media_values,
 		               internal_handle->offset_table,
 		               internal_handle->delta_segment_table,
@@ -2657,6 +3295,34 @@ ssize_t libewf_handle_write_chunk(
 	}
 	else
 	{
+		/* Make sure the chunks queued by write buffer are written first
+		 */
+		write_count = libewf_write_io_handle_write_processed_chunks(
+		               internal_handle->write_io_handle,
+		               internal_handle->io_handle,
+		               internal_handle->media_values,
+		               internal_handle->offset_table,
+		               internal_handle->segment_table,
+		               &( internal_handle->header_values ),
+		               internal_handle->hash_values,
+		               internal_handle->header_sections,
+		               internal_handle->hash_sections,
+		               internal_handle->sessions,
+		               internal_handle->acquiry_errors,
+		               1,
+		               error );
+
+		if( write_count <= -1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write processed chunks.",
+			 function );
+
+			return( -1 );
+		}
 		write_count = libewf_write_io_handle_write_new_chunk(
 		               internal_handle->write_io_handle,
 		               internal_handle->io_handle,
@@ -2858,7 +3524,7 @@ ssize_t libewf_handle_write_buffer(
 			 */
 			if( ( internal_handle->io_handle->current_chunk >= internal_handle->offset_table->amount_of_chunk_offsets )
 			 || ( internal_handle->offset_table->chunk_offset == NULL )
-			 || ( internal_handle->offset_table->chunk_offset[ internal_handle->io_handle->current_chunk ].segment_file_handle == NULL ) )
+			 || ( internal_handle->offset_table->chunk_offset[ internal_handle->io_handle->current_chunk ].segment_file_index == 0 ) )
 			{
 				liberror_error_set(
 				 error,
@@ -2917,104 +3583,590 @@ ssize_t libewf_handle_write_buffer(
 			 "%s: unable to write data from buffer.",
 			 function );
 
-			return( -1 );
-		}
-		else if( write_count == 0 )
-		{
-			break;
-		}
-		total_write_count += write_count;
-		size              -= write_count;
+			return( -1 );
+		}
+		else if( write_count == 0 )
+		{
+			break;
+		}
+		total_write_count += write_count;
+		size              -= write_count;
+
+		internal_handle->io_handle->current_chunk_offset += (uint32_t) write_count;
+
+		if( internal_handle->io_handle->current_chunk_offset == internal_handle->media_values->chunk_size )
+		{
+			internal_handle->io_handle->current_chunk_offset = 0;
+			internal_handle->io_handle->current_chunk       += 1;
+		}
+		else if( internal_handle->io_handle->current_chunk_offset > internal_handle->media_values->chunk_size )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_VALUE_OUT_OF_RANGE,
+			 "%s: invalid current chunk offset: %" PRIu32 " larger than chunk size: %" PRIu32 ".",
+			 function,
+			 internal_handle->io_handle->current_chunk_offset,
+			 internal_handle->media_values->chunk_size );
+
+			return( -1 );
+		}
+		if( internal_handle->abort == 1 )
+		{
+			break;
+		}
+	}
+	return( total_write_count );
+}
+
+/* Writes data in EWF format from a buffer at an specific offset,
+ * the necessary settings of the write values must have been made
+ * Will initialize write if necessary
+ * Returns the amount of input bytes written, 0 when no longer bytes can be written or -1 on error
+ */
+ssize_t libewf_handle_write_random(
+         libewf_handle_t *handle,
+         void *buffer,
+         size_t size,
+         off64_t offset,
+         liberror_error_t **error )
+{
+	static char *function = "libewf_handle_write_random";
+	ssize_t write_count   = 0;
+
+	if( libewf_handle_seek_offset(
+	     handle,
+	     offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_IO,
+		 LIBERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset.",
+		 function );
+
+		return( -1 );
+	}
+	write_count = libewf_handle_write_buffer(
+	               handle,
+	               buffer,
+	               size,
+	               error );
+
+	if( write_count <= -1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_IO,
+		 LIBERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write buffer.",
+		 function );
+
+		return( -1 );
+	}
+	return( write_count );
+}
+
+/* Finalizes the write by correcting the EWF the meta data in the segment files
+ * This function is required after write from stream
+ * Returns the amount of bytes written or -1 on error
+ */
+ssize_t libewf_handle_write_finalize(
+         libewf_handle_t *handle,
+         liberror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_write_finalize";
+	ssize_t write_count                       = 0;
+
+	if( handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	write_count = libewf_write_io_handle_finalize(
+	               internal_handle->write_io_handle,
+	               internal_handle->io_handle,
+	               internal_handle->media_values,
+	               internal_handle->offset_table,
+	               internal_handle->segment_table,
+	               &( internal_handle->header_values ),
+	               internal_handle->hash_values,
+	               internal_handle->header_sections,
+	               internal_handle->hash_sections,
+	               internal_handle->sessions,
+	               internal_handle->acquiry_errors,
+	               internal_handle->chunk_cache,
+	               error );
+
+	if( write_count <= -1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_IO,
+		 LIBERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write finalize.",
+		 function );
+
+		return( -1 );
+	}
+	return( write_count );
+}
+
+/* Retrieves the current offset of the media data within the EWF file(s)
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_offset(
+     libewf_handle_t *handle,
+     off64_t *offset,
+     liberror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_offset";
+
+	if( handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing io handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset.",
+		 function );
+
+		return( -1 );
+	}
+	*offset = ( internal_handle->io_handle->current_chunk * internal_handle->media_values->chunk_size )
+	        + internal_handle->io_handle->current_chunk_offset;
+
+	return( 1 );
+}
+
+/* Retrieves the segment filename size
+ * The filename size should include the end of string character
+ * Returns 1 if successful, 0 if value not present or -1 on error
+ */
+int libewf_handle_get_segment_filename_size(
+     libewf_handle_t *handle,
+     size_t *filename_size,
+     liberror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_segment_filename_size";
+	int result                                = 0;
+
+	if( handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->segment_table == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing segment table.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_segment_table_get_basename_size(
+	          internal_handle->segment_table,
+	          filename_size,
+	          error );
+
+	if( result == -1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment table basename size.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Retrieves the segment filename
+ * The filename size should include the end of string character
+ * Returns 1 if successful, 0 if value not present or -1 on error
+ */
+int libewf_handle_get_segment_filename(
+     libewf_handle_t *handle,
+     char *filename,
+     size_t filename_size,
+     liberror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_segment_filename";
+	int result                                = 0;
+
+	if( handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->segment_table == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing segment table.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_segment_table_get_basename(
+	          internal_handle->segment_table,
+	          filename,
+	          filename_size,
+	          error );
+
+	if( result == -1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment table basename.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Sets the segment file
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_segment_filename(
+     libewf_handle_t *handle,
+     const char *filename,
+     size_t filename_length,
+     liberror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_segment_filename";
+
+	if( handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->write_io_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: segment filename cannot be changed.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->segment_table == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing segment table.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename[ filename_length - 1 ] != 0 )
+	{
+		filename_length += 1;
+	}
+	if( libewf_segment_table_set_basename(
+	     internal_handle->segment_table,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set segment table basename.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Retrieves the segment filename size
+ * The filename size includes the end of string character
+ * Returns 1 if successful, 0 if value not present or -1 on error
+ */
+int libewf_handle_get_segment_filename_size_wide(
+     libewf_handle_t *handle,
+     size_t *filename_size,
+     liberror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_segment_filename_size_wide";
+	int result                                = 0;
+
+	if( handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->segment_table == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing segment table.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_segment_table_get_basename_size_wide(
+	          internal_handle->segment_table,
+	          filename_size,
+	          error );
+
+	if( result == -1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment table basename size.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Retrieves the segment filename
+ * The filename size should include the end of string character
+ * Returns 1 if successful, 0 if value not present or -1 on error
+ */
+int libewf_handle_get_segment_filename_wide(
+     libewf_handle_t *handle,
+     wchar_t *filename,
+     size_t filename_size,
+     liberror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_segment_filename_wide";
+	int result                                = 0;
+
+	if( handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
 
-		internal_handle->io_handle->current_chunk_offset += (uint32_t) write_count;
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
 
-		if( internal_handle->io_handle->current_chunk_offset == internal_handle->media_values->chunk_size )
-		{
-			internal_handle->io_handle->current_chunk_offset = 0;
-			internal_handle->io_handle->current_chunk       += 1;
-		}
-		else if( internal_handle->io_handle->current_chunk_offset > internal_handle->media_values->chunk_size )
-		{
-			liberror_error_set(
-			 error,
-			 LIBERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBERROR_RUNTIME_ERROR_VALUE_OUT_OF_RANGE,
-			 "%s: invalid current chunk offset: %" PRIu32 " larger than chunk size: %" PRIu32 ".",
-			 function,
-			 internal_handle->io_handle->current_chunk_offset,
-			 internal_handle->media_values->chunk_size );
+	if( internal_handle->segment_table == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing segment table.",
+		 function );
 
-			return( -1 );
-		}
-		if( internal_handle->abort == 1 )
-		{
-			break;
-		}
+		return( -1 );
 	}
-	return( total_write_count );
+	result = libewf_segment_table_get_basename_wide(
+	          internal_handle->segment_table,
+	          filename,
+	          filename_size,
+	          error );
+
+	if( result == -1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment table basename.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
 }
 
-/* Writes data in EWF format from a buffer at an specific offset,
- * the necessary settings of the write values must have been made
- * Will initialize write if necessary
- * Returns the amount of input bytes written, 0 when no longer bytes can be written or -1 on error
+/* Sets the segment file
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libewf_handle_write_random(
-         libewf_handle_t *handle,
-         void *buffer,
-         size_t size,
-         off64_t offset,
-         liberror_error_t **error )
+int libewf_handle_set_segment_filename_wide(
+     libewf_handle_t *handle,
+     const wchar_t *filename,
+     size_t filename_length,
+     liberror_error_t **error )
 {
-	static char *function = "libewf_handle_write_random";
-	ssize_t write_count   = 0;
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_segment_filename_wide";
 
-	if( libewf_handle_seek_offset(
-	     handle,
-	     offset,
-	     SEEK_SET,
-	     error ) == -1 )
+	if( handle == NULL )
 	{
 		liberror_error_set(
 		 error,
-		 LIBERROR_ERROR_DOMAIN_IO,
-		 LIBERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
 		 function );
 
 		return( -1 );
 	}
-	write_count = libewf_handle_write_buffer(
-	               handle,
-	               buffer,
-	               size,
-	               error );
+	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( write_count <= -1 )
+	if( internal_handle->write_io_handle == NULL )
 	{
 		liberror_error_set(
 		 error,
-		 LIBERROR_ERROR_DOMAIN_IO,
-		 LIBERROR_IO_ERROR_WRITE_FAILED,
-		 "%s: unable to write buffer.",
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: segment filename cannot be changed.",
 		 function );
 
 		return( -1 );
 	}
-	return( write_count );
+	if( internal_handle->segment_table == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing segment table.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename[ filename_length - 1 ] != 0 )
+	{
+		filename_length += 1;
+	}
+	if( libewf_segment_table_set_basename_wide(
+	     internal_handle->segment_table,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set segment table basename.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
 }
 
-/* Finalizes the write by correcting the EWF the meta data in the segment files
- * This function is required after write from stream
- * Returns the amount of bytes written or -1 on error
+#endif
+
+/* Retrieves the segment file size
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libewf_handle_write_finalize(
-         libewf_handle_t *handle,
-         liberror_error_t **error )
+int libewf_handle_get_segment_file_size(
+     libewf_handle_t *handle,
+     size64_t *segment_file_size,
+     liberror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_write_finalize";
-	ssize_t write_count                       = 0;
+	static char *function                     = "libewf_handle_get_segment_file_size";
 
 	if( handle == NULL )
 	{
@@ -3029,45 +4181,43 @@ ssize_t libewf_handle_write_finalize(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	write_count = libewf_write_io_handle_finalize(
-	               internal_handle->write_io_handle,
-	               internal_handle->io_handle,
-	               internal_handle->media_values,
-	               internal_handle->offset_table,
-	               internal_handle->segment_table,
-	               &( internal_handle->header_values ),
-	               internal_handle->hash_values,
-	               internal_handle->header_sections,
-	               internal_handle->hash_sections,
-	               internal_handle->sessions,
-	               internal_handle->acquiry_errors,
-	               internal_handle->chunk_cache,
-	               error );
+	if( internal_handle->segment_table == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing segment table.",
+		 function );
 
-	if( write_count <= -1 )
+		return( -1 );
+	}
+	if( segment_file_size == NULL )
 	{
 		liberror_error_set(
 		 error,
-		 LIBERROR_ERROR_DOMAIN_IO,
-		 LIBERROR_IO_ERROR_WRITE_FAILED,
-		 "%s: unable to write finalize.",
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file size.",
 		 function );
 
 		return( -1 );
 	}
-	return( write_count );
+	*segment_file_size = internal_handle->segment_table->maximum_segment_size;
+
+	return( 1 );
 }
 
-/* Retrieves the current offset of the media data within the EWF file(s)
+/* Sets the segment file size
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_get_offset(
+int libewf_handle_set_segment_file_size(
      libewf_handle_t *handle,
-     off64_t *offset,
+     size64_t segment_file_size,
      liberror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_offset";
+	static char *function                     = "libewf_handle_set_segment_file_size";
 
 	if( handle == NULL )
 	{
@@ -3082,56 +4232,69 @@ int libewf_handle_get_offset(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->io_handle == NULL )
+	if( internal_handle->segment_table == NULL )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing io handle.",
+		 "%s: invalid handle - missing segment table.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values == NULL )
+	if( ( internal_handle->read_io_handle != NULL )
+	 || ( internal_handle->write_io_handle == NULL )
+	 || ( internal_handle->write_io_handle->values_initialized != 0 ) )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: segment file size cannot be changed.",
 		 function );
 
 		return( -1 );
 	}
-	if( offset == NULL )
+	if( segment_file_size > (size64_t) INT64_MAX )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid offset.",
+		 LIBERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid segment file size value exceeds maximum.",
 		 function );
 
 		return( -1 );
 	}
-	*offset = ( internal_handle->io_handle->current_chunk * internal_handle->media_values->chunk_size )
-	        + internal_handle->io_handle->current_chunk_offset;
+	if( ( segment_file_size == 0 )
+	 || ( segment_file_size > internal_handle->write_io_handle->maximum_segment_file_size ) )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_OUT_OF_RANGE,
+		 "%s: invalid segment file size value out of range.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle->segment_table->maximum_segment_size = segment_file_size;
 
 	return( 1 );
 }
 
-/* Retrieves the segment filename size
- * The filename size should include the end of string character
+/* Retrieves the delta segment filename size
+ * The filename size includes the end of string character
  * Returns 1 if successful, 0 if value not present or -1 on error
  */
-int libewf_handle_get_segment_filename_size(
+int libewf_handle_get_delta_segment_filename_size(
      libewf_handle_t *handle,
      size_t *filename_size,
      liberror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_segment_filename_size";
+	static char *function                     = "libewf_handle_get_delta_segment_filename_size";
 	int result                                = 0;
 
 	if( handle == NULL )
@@ -3147,19 +4310,19 @@ int libewf_handle_get_segment_filename_size(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->segment_table == NULL )
+	if( internal_handle->delta_segment_table == NULL )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing segment table.",
+		 "%s: invalid handle - missing delta segment table.",
 		 function );
 
 		return( -1 );
 	}
 	result = libewf_segment_table_get_basename_size(
-	          internal_handle->segment_table,
+	          internal_handle->delta_segment_table,
 	          filename_size,
 	          error );
 
@@ -3177,18 +4340,18 @@ int libewf_handle_get_segment_filename_size(
 	return( result );
 }
 
-/* Retrieves the segment filename
+/* Retrieves the delta segment filename
  * The filename size should include the end of string character
  * Returns 1 if successful, 0 if value not present or -1 on error
  */
-int libewf_handle_get_segment_filename(
+int libewf_handle_get_delta_segment_filename(
      libewf_handle_t *handle,
      char *filename,
      size_t filename_size,
      liberror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_segment_filename";
+	static char *function                     = "libewf_handle_get_delta_segment_filename";
 	int result                                = 0;
 
 	if( handle == NULL )
@@ -3204,19 +4367,19 @@ int libewf_handle_get_segment_filename(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->segment_table == NULL )
+	if( internal_handle->delta_segment_table == NULL )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing segment table.",
+		 "%s: invalid handle - missing delta segment table.",
 		 function );
 
 		return( -1 );
 	}
 	result = libewf_segment_table_get_basename(
-	          internal_handle->segment_table,
+	          internal_handle->delta_segment_table,
 	          filename,
 	          filename_size,
 	          error );
@@ -3235,17 +4398,17 @@ int libewf_handle_get_segment_filename(
 	return( result );
 }
 
-/* Sets the segment file
+/* Sets the delta segment file
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_set_segment_filename(
+int libewf_handle_set_delta_segment_filename(
      libewf_handle_t *handle,
      const char *filename,
      size_t filename_length,
      liberror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_set_segment_filename";
+	static char *function                     = "libewf_handle_set_delta_segment_filename";
 
 	if( handle == NULL )
 	{
@@ -3266,18 +4429,18 @@ int libewf_handle_set_segment_filename(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: segment filename cannot be changed.",
+		 "%s: delta segment filename cannot be changed.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->segment_table == NULL )
+	if( internal_handle->delta_segment_table == NULL )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing segment table.",
+		 "%s: invalid handle - missing delta segment table.",
 		 function );
 
 		return( -1 );
@@ -3287,7 +4450,7 @@ int libewf_handle_set_segment_filename(
 		filename_length += 1;
 	}
 	if( libewf_segment_table_set_basename(
-	     internal_handle->segment_table,
+	     internal_handle->delta_segment_table,
 	     filename,
 	     filename_length,
 	     error ) != 1 )
@@ -3306,17 +4469,17 @@ int libewf_handle_set_segment_filename(
 
 #if defined( HAVE_WIDE_CHARACTER_TYPE )
 
-/* Retrieves the segment filename size
+/* Retrieves the delta segment filename size
  * The filename size includes the end of string character
  * Returns 1 if successful, 0 if value not present or -1 on error
  */
-int libewf_handle_get_segment_filename_size_wide(
+int libewf_handle_get_delta_segment_filename_size_wide(
      libewf_handle_t *handle,
      size_t *filename_size,
      liberror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_segment_filename_size_wide";
+	static char *function                     = "libewf_handle_get_delta_segment_filename_size_wide";
 	int result                                = 0;
 
 	if( handle == NULL )
@@ -3332,19 +4495,19 @@ int libewf_handle_get_segment_filename_size_wide(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->segment_table == NULL )
+	if( internal_handle->delta_segment_table == NULL )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing segment table.",
+		 "%s: invalid handle - missing delta segment table.",
 		 function );
 
 		return( -1 );
 	}
 	result = libewf_segment_table_get_basename_size_wide(
-	          internal_handle->segment_table,
+	          internal_handle->delta_segment_table,
 	          filename_size,
 	          error );
 
@@ -3362,18 +4525,18 @@ int libewf_handle_get_segment_filename_size_wide(
 	return( result );
 }
 
-/* Retrieves the segment filename
+/* Retrieves the delta segment filename
  * The filename size should include the end of string character
  * Returns 1 if successful, 0 if value not present or -1 on error
  */
-int libewf_handle_get_segment_filename_wide(
+int libewf_handle_get_delta_segment_filename_wide(
      libewf_handle_t *handle,
      wchar_t *filename,
      size_t filename_size,
      liberror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_segment_filename_wide";
+	static char *function                     = "libewf_handle_get_delta_segment_filename_wide";
 	int result                                = 0;
 
 	if( handle == NULL )
@@ -3389,19 +4552,19 @@ int libewf_handle_get_segment_filename_wide(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->segment_table == NULL )
+	if( internal_handle->delta_segment_table == NULL )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing segment table.",
+		 "%s: invalid handle - missing delta segment table.",
 		 function );
 
 		return( -1 );
 	}
 	result = libewf_segment_table_get_basename_wide(
-	          internal_handle->segment_table,
+	          internal_handle->delta_segment_table,
 	          filename,
 	          filename_size,
 	          error );
@@ -3420,17 +4583,17 @@ int libewf_handle_get_segment_filename_wide(
 	return( result );
 }
 
-/* Sets the segment file
+/* Sets the delta segment file
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_set_segment_filename_wide(
+int libewf_handle_set_delta_segment_filename_wide(
      libewf_handle_t *handle,
      const wchar_t *filename,
      size_t filename_length,
      liberror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_set_segment_filename_wide";
+	static char *function                     = "libewf_handle_set_delta_segment_filename_wide";
 
 	if( handle == NULL )
 	{
@@ -3451,18 +4614,18 @@ int libewf_handle_set_segment_filename_wide(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: segment filename cannot be changed.",
+		 "%s: delta segment filename cannot be changed.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->segment_table == NULL )
+	if( internal_handle->delta_segment_table == NULL )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing segment table.",
+		 "%s: invalid handle - missing delta segment table.",
 		 function );
 
 		return( -1 );
@@ -3472,7 +4635,7 @@ int libewf_handle_set_segment_filename_wide(
 		filename_length += 1;
 	}
 	if( libewf_segment_table_set_basename_wide(
-	     internal_handle->segment_table,
+	     internal_handle->delta_segment_table,
 	     filename,
 	     filename_length,
 	     error ) != 1 )
@@ -3491,16 +4654,16 @@ int libewf_handle_set_segment_filename_wide(
 
 #endif
 
-/* Retrieves the segment file size
+/* Retrieves the delta segment file size
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_get_segment_file_size(
+int libewf_handle_get_delta_segment_file_size(
      libewf_handle_t *handle,
-     size64_t *segment_file_size,
+     size64_t *delta_segment_file_size,
      liberror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_segment_file_size";
+	static char *function                     = "libewf_handle_get_delta_segment_file_size";
 
 	if( handle == NULL )
 	{
@@ -3515,43 +4678,43 @@ int libewf_handle_get_segment_file_size(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->segment_table == NULL )
+	if( internal_handle->delta_segment_table == NULL )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing segment table.",
+		 "%s: invalid handle - missing delta segment table.",
 		 function );
 
 		return( -1 );
 	}
-	if( segment_file_size == NULL )
+	if( delta_segment_file_size == NULL )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid segment file size.",
+		 "%s: invalid delta segment file size.",
 		 function );
 
 		return( -1 );
 	}
-	*segment_file_size = internal_handle->segment_table->maximum_segment_size;
+	*delta_segment_file_size = internal_handle->delta_segment_table->maximum_segment_size;
 
 	return( 1 );
 }
 
-/* Sets the segment file size
+/* Sets the delta segment file size
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_set_segment_file_size(
+int libewf_handle_set_delta_segment_file_size(
      libewf_handle_t *handle,
-     size64_t segment_file_size,
+     size64_t delta_segment_file_size,
      liberror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_set_segment_file_size";
+	static char *function                     = "libewf_handle_set_delta_segment_file_size";
 
 	if( handle == NULL )
 	{
@@ -3566,70 +4729,67 @@ int libewf_handle_set_segment_file_size(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->segment_table == NULL )
+	if( internal_handle->delta_segment_table == NULL )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing segment table.",
+		 "%s: invalid handle - missing delta segment table.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( internal_handle->read_io_handle != NULL )
-	 || ( internal_handle->write_io_handle == NULL )
+	if( ( internal_handle->write_io_handle == NULL )
 	 || ( internal_handle->write_io_handle->values_initialized != 0 ) )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: segment file size cannot be changed.",
+		 "%s: delta segment file size cannot be changed.",
 		 function );
 
 		return( -1 );
 	}
-	if( segment_file_size > (size64_t) INT64_MAX )
+	if( delta_segment_file_size > (size64_t) INT64_MAX )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid segment file size value exceeds maximum.",
+		 "%s: invalid delta segment file size value exceeds maximum.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( segment_file_size == 0 )
-	 || ( segment_file_size > internal_handle->write_io_handle->maximum_segment_file_size ) )
+	if( delta_segment_file_size == 0 )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBERROR_ARGUMENT_ERROR_VALUE_OUT_OF_RANGE,
-		 "%s: invalid segment file size value out of range.",
+		 "%s: invalid delta segment file size value out of range.",
 		 function );
 
 		return( -1 );
 	}
-	internal_handle->segment_table->maximum_segment_size = segment_file_size;
+	internal_handle->delta_segment_table->maximum_segment_size = delta_segment_file_size;
 
 	return( 1 );
 }
 
-/* Retrieves the delta segment filename size
- * The filename size includes the end of string character
- * Returns 1 if successful, 0 if value not present or -1 on error
+/* Sets the filename of the offset table index file
+ * Returns 1 if successful or -1 on error
  */
-int libewf_handle_get_delta_segment_filename_size(
+int libewf_handle_set_index_filename(
      libewf_handle_t *handle,
-     size_t *filename_size,
+     const char *filename,
+     size_t filename_length,
      liberror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_delta_segment_filename_size";
-	int result                                = 0;
+	static char *function                     = "libewf_handle_set_index_filename";
 
 	if( handle == NULL )
 	{
@@ -3644,105 +4804,120 @@ int libewf_handle_get_delta_segment_filename_size(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->delta_segment_table == NULL )
+	if( internal_handle->io_handle == NULL )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing delta segment table.",
+		 "%s: invalid handle - missing io handle.",
 		 function );
 
 		return( -1 );
 	}
-	result = libewf_segment_table_get_basename_size(
-	          internal_handle->delta_segment_table,
-	          filename_size,
-	          error );
-
-	if( result == -1 )
+	if( filename == NULL )
 	{
 		liberror_error_set(
 		 error,
-		 LIBERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve segment table basename size.",
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
 		 function );
 
 		return( -1 );
 	}
-	return( result );
-}
-
-/* Retrieves the delta segment filename
- * The filename size should include the end of string character
- * Returns 1 if successful, 0 if value not present or -1 on error
- */
-int libewf_handle_get_delta_segment_filename(
-     libewf_handle_t *handle,
-     char *filename,
-     size_t filename_size,
-     liberror_error_t **error )
-{
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_delta_segment_filename";
-	int result                                = 0;
-
-	if( handle == NULL )
+	if( filename_length == 0 )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
+		 LIBERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid filename length value is zero.",
 		 function );
 
 		return( -1 );
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
-	if( internal_handle->delta_segment_table == NULL )
+	/* The index file is used when the handle is opened
+	 */
+	if( internal_handle->io_handle->file_io_pool != NULL )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing delta segment table.",
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: index filename cannot be changed.",
 		 function );
 
 		return( -1 );
 	}
-	result = libewf_segment_table_get_basename(
-	          internal_handle->delta_segment_table,
-	          filename,
-	          filename_size,
-	          error );
+	if( internal_handle->index_file_io_handle != NULL )
+	{
+		if( libbfio_handle_free(
+		     &( internal_handle->index_file_io_handle ),
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free index file io handle.",
+			 function );
 
-	if( result == -1 )
+			return( -1 );
+		}
+	}
+	if( filename[ filename_length - 1 ] != 0 )
+	{
+		filename_length += 1;
+	}
+	if( libbfio_file_initialize(
+	     &( internal_handle->index_file_io_handle ),
+	     error ) != 1 )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve segment table basename.",
+		 LIBERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create index file io handle.",
 		 function );
 
 		return( -1 );
 	}
-	return( result );
+	if( libbfio_file_set_name(
+	     internal_handle->index_file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set name in index file io handle.",
+		 function );
+
+		libbfio_handle_free(
+		 &( internal_handle->index_file_io_handle ),
+		 NULL );
+
+		return( -1 );
+	}
+	return( 1 );
 }
 
-/* Sets the delta segment file
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Sets the filename of the offset table index file
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_set_delta_segment_filename(
+int libewf_handle_set_index_filename_wide(
      libewf_handle_t *handle,
-     const char *filename,
+     const wchar_t *filename,
      size_t filename_length,
      liberror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_set_delta_segment_filename";
+	static char *function                     = "libewf_handle_set_index_filename_wide";
 
 	if( handle == NULL )
 	{
@@ -3757,34 +4932,87 @@ int libewf_handle_set_delta_segment_filename(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->write_io_handle == NULL )
+	if( internal_handle->io_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing io handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename_length == 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid filename length value is zero.",
+		 function );
+
+		return( -1 );
+	}
+	/* The index file is used when the handle is opened
+	 */
+	if( internal_handle->io_handle->file_io_pool != NULL )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: delta segment filename cannot be changed.",
+		 "%s: index filename cannot be changed.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->delta_segment_table == NULL )
+	if( internal_handle->index_file_io_handle != NULL )
+	{
+		if( libbfio_handle_free(
+		     &( internal_handle->index_file_io_handle ),
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free index file io handle.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( filename[ filename_length - 1 ] != 0 )
+	{
+		filename_length += 1;
+	}
+	if( libbfio_file_initialize(
+	     &( internal_handle->index_file_io_handle ),
+	     error ) != 1 )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing delta segment table.",
+		 LIBERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create index file io handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( filename[ filename_length - 1 ] != 0 )
-	{
-		filename_length += 1;
-	}
-	if( libewf_segment_table_set_basename(
-	     internal_handle->delta_segment_table,
+	if( libbfio_file_set_name_wide(
+	     internal_handle->index_file_io_handle,
 	     filename,
 	     filename_length,
 	     error ) != 1 )
@@ -3793,28 +5021,31 @@ int libewf_handle_set_delta_segment_filename(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set segment table basename.",
+		 "%s: unable to set name in index file io handle.",
 		 function );
 
+		libbfio_handle_free(
+		 &( internal_handle->index_file_io_handle ),
+		 NULL );
+
 		return( -1 );
 	}
 	return( 1 );
 }
 
-#if defined( HAVE_WIDE_CHARACTER_TYPE )
+#endif
 
-/* Retrieves the delta segment filename size
- * The filename size includes the end of string character
- * Returns 1 if successful, 0 if value not present or -1 on error
+/* Retrieves the filename size of the (delta) segment file of the current chunk
+ * The filename size should include the end of string character
+ * Returns 1 if successful or -1 on error
  */
-int libewf_handle_get_delta_segment_filename_size_wide(
+int libewf_handle_get_filename_size(
      libewf_handle_t *handle,
      size_t *filename_size,
      liberror_error_t **error )
 {
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_delta_segment_filename_size_wide";
-	int result                                = 0;
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "libewf_handle_get_filename_size";
 
 	if( handle == NULL )
 	{
@@ -3827,51 +5058,49 @@ int libewf_handle_get_delta_segment_filename_size_wide(
 
 		return( -1 );
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
-	if( internal_handle->delta_segment_table == NULL )
+	if( libewf_handle_get_file_io_handle(
+	     handle,
+	     &file_io_handle,
+	     error ) != 1 )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing delta segment table.",
+		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file io handle for current chunk.",
 		 function );
 
 		return( -1 );
 	}
-	result = libewf_segment_table_get_basename_size_wide(
-	          internal_handle->delta_segment_table,
-	          filename_size,
-	          error );
-
-	if( result == -1 )
+	if( libbfio_file_get_name_size(
+	     file_io_handle,
+	     filename_size,
+	     error ) != 1 )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve segment table basename size.",
+		 "%s: unable to retrieve filename size.",
 		 function );
 
 		return( -1 );
 	}
-	return( result );
+	return( 1 );
 }
 
-/* Retrieves the delta segment filename
+/* Retrieves the filename of the (delta) segment file of the current chunk
  * The filename size should include the end of string character
- * Returns 1 if successful, 0 if value not present or -1 on error
+ * Returns 1 if successful or -1 on error
  */
-int libewf_handle_get_delta_segment_filename_wide(
+int libewf_handle_get_filename(
      libewf_handle_t *handle,
-     wchar_t *filename,
+     char *filename,
      size_t filename_size,
      liberror_error_t **error )
 {
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_delta_segment_filename_wide";
-	int result                                = 0;
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "libewf_handle_get_filename";
 
 	if( handle == NULL )
 	{
@@ -3884,50 +5113,51 @@ int libewf_handle_get_delta_segment_filename_wide(
 
 		return( -1 );
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
-	if( internal_handle->delta_segment_table == NULL )
+	if( libewf_handle_get_file_io_handle(
+	     handle,
+	     &file_io_handle,
+	     error ) != 1 )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing delta segment table.",
+		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file io handle for current chunk.",
 		 function );
 
 		return( -1 );
 	}
-	result = libewf_segment_table_get_basename_wide(
-	          internal_handle->delta_segment_table,
-	          filename,
-	          filename_size,
-	          error );
-
-	if( result == -1 )
+	if( libbfio_file_get_name(
+	     file_io_handle,
+	     filename,
+	     filename_size,
+	     error ) != 1 )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve segment table basename.",
+		 "%s: unable to retrieve filename.",
 		 function );
 
 		return( -1 );
 	}
-	return( result );
+	return( 1 );
 }
 
-/* Sets the delta segment file
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Retrieves the filename size of the (delta) segment file of the current chunk
+ * The filename size includes the end of string character
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_set_delta_segment_filename_wide(
+int libewf_handle_get_filename_size_wide(
      libewf_handle_t *handle,
-     const wchar_t *filename,
-     size_t filename_length,
+     size_t *filename_size,
      liberror_error_t **error )
 {
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_set_delta_segment_filename_wide";
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "libewf_handle_get_filename_size_wide";
 
 	if( handle == NULL )
 	{
@@ -3940,45 +5170,30 @@ int libewf_handle_set_delta_segment_filename_wide(
 
 		return( -1 );
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
-	if( internal_handle->write_io_handle == NULL )
-	{
-		liberror_error_set(
-		 error,
-		 LIBERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: delta segment filename cannot be changed.",
-		 function );
-
-		return( -1 );
-	}
-	if( internal_handle->delta_segment_table == NULL )
+	if( libewf_handle_get_file_io_handle(
+	     handle,
+	     &file_io_handle,
+	     error ) != 1 )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing delta segment table.",
+		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file io handle for current chunk.",
 		 function );
 
 		return( -1 );
 	}
-	if( filename[ filename_length - 1 ] != 0 )
-	{
-		filename_length += 1;
-	}
-	if( libewf_segment_table_set_basename_wide(
-	     internal_handle->delta_segment_table,
-	     filename,
-	     filename_length,
+	if( libbfio_file_get_name_size_wide(
+	     file_io_handle,
+	     filename_size,
 	     error ) != 1 )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set segment table basename.",
+		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve filename size.",
 		 function );
 
 		return( -1 );
@@ -3986,18 +5201,18 @@ int libewf_handle_set_delta_segment_filename_wide(
 	return( 1 );
 }
 
-#endif
-
-/* Retrieves the delta segment file size
+/* Retrieves the filename of the (delta) segment file of the current chunk
+ * The filename size should include the end of string character
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_get_delta_segment_file_size(
+int libewf_handle_get_filename_wide(
      libewf_handle_t *handle,
-     size64_t *delta_segment_file_size,
+     wchar_t *filename,
+     size_t filename_size,
      liberror_error_t **error )
 {
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_delta_segment_file_size";
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "libewf_handle_get_filename_wide";
 
 	if( handle == NULL )
 	{
@@ -4010,45 +5225,55 @@ int libewf_handle_get_delta_segment_file_size(
 
 		return( -1 );
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
-	if( internal_handle->delta_segment_table == NULL )
+	if( libewf_handle_get_file_io_handle(
+	     handle,
+	     &file_io_handle,
+	     error ) != 1 )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing delta segment table.",
+		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file io handle for current chunk.",
 		 function );
 
 		return( -1 );
 	}
-	if( delta_segment_file_size == NULL )
+	if( libbfio_file_get_name_wide(
+	     file_io_handle,
+	     filename,
+	     filename_size,
+	     error ) != 1 )
 	{
 		liberror_error_set(
 		 error,
-		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid delta segment file size.",
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve filename.",
 		 function );
 
 		return( -1 );
 	}
-	*delta_segment_file_size = internal_handle->delta_segment_table->maximum_segment_size;
-
 	return( 1 );
 }
 
-/* Sets the delta segment file size
+#endif
+
+/* Retrieves the file io handle of the (delta) segment file of the current chunk
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_set_delta_segment_file_size(
+int libewf_handle_get_file_io_handle(
      libewf_handle_t *handle,
-     size64_t delta_segment_file_size,
+     libbfio_handle_t **file_io_handle,
      liberror_error_t **error )
 {
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_set_delta_segment_file_size";
+	libewf_internal_handle_t *internal_handle         = NULL;
+	libewf_segment_file_handle_t *segment_file_handle = NULL;
+	static char *function                             = "libewf_handle_get_file_io_handle";
+	off64_t chunk_file_offset                         = 0;
+	size_t chunk_size                                 = 0;
+	int file_io_pool_entry                            = 0;
+	uint8_t chunk_flags                               = 0;
 
 	if( handle == NULL )
 	{
@@ -4063,122 +5288,152 @@ int libewf_handle_set_delta_segment_file_size(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->delta_segment_table == NULL )
+	if( internal_handle->io_handle == NULL )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing delta segment table.",
+		 "%s: invalid handle - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( internal_handle->write_io_handle == NULL )
-	 || ( internal_handle->write_io_handle->values_initialized != 0 ) )
+	if( internal_handle->io_handle->file_io_pool == NULL )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: delta segment file size cannot be changed.",
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid IO handle - missing file IO pool.",
 		 function );
 
 		return( -1 );
 	}
-	if( delta_segment_file_size > (size64_t) INT64_MAX )
+	if( internal_handle->media_values == NULL )
 	{
 		liberror_error_set(
 		 error,
-		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid delta segment file size value exceeds maximum.",
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
 		 function );
 
 		return( -1 );
 	}
-	if( delta_segment_file_size == 0 )
+	if( internal_handle->offset_table == NULL )
 	{
 		liberror_error_set(
 		 error,
-		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBERROR_ARGUMENT_ERROR_VALUE_OUT_OF_RANGE,
-		 "%s: invalid delta segment file size value out of range.",
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing offset table.",
 		 function );
 
 		return( -1 );
 	}
-	internal_handle->delta_segment_table->maximum_segment_size = delta_segment_file_size;
-
-	return( 1 );
-}
-
-/* Retrieves the filename size of the (delta) segment file of the current chunk
- * The filename size should include the end of string character
- * Returns 1 if successful or -1 on error
- */
-int libewf_handle_get_filename_size(
-     libewf_handle_t *handle,
-     size_t *filename_size,
-     liberror_error_t **error )
-{
-	libbfio_handle_t *file_io_handle = NULL;
-	static char *function            = "libewf_handle_get_filename_size";
+	if( internal_handle->offset_table->chunk_offset == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid offset table - missing chunk offset.",
+		 function );
 
-	if( handle == NULL )
+		return( -1 );
+	}
+	if( internal_handle->io_handle->current_chunk >= internal_handle->offset_table->amount_of_chunk_offsets )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
+		 LIBERROR_ARGUMENT_ERROR_VALUE_OUT_OF_RANGE,
+		 "%s: invalid current chunk value out of range.",
 		 function );
 
 		return( -1 );
 	}
-	if( libewf_handle_get_file_io_handle(
-	     handle,
-	     &file_io_handle,
+	if( libewf_read_io_handle_read_table_section(
+	     internal_handle->io_handle,
+	     internal_handle->offset_table,
+	     internal_handle->io_handle->current_chunk,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_IO,
+		 LIBERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read table section of chunk: %" PRIu32 ".",
+		 function,
+		 internal_handle->io_handle->current_chunk );
+
+		return( -1 );
+	}
+	if( libewf_offset_table_get_chunk_offset(
+	     internal_handle->offset_table,
+	     internal_handle->io_handle->current_chunk,
+	     &segment_file_handle,
+	     &chunk_file_offset,
+	     &chunk_size,
+	     &chunk_flags,
 	     error ) != 1 )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve file io handle for current chunk.",
-		 function );
+		 "%s: unable to retrieve chunk offset: %" PRIu32 ".",
+		 function,
+		 internal_handle->io_handle->current_chunk );
 
 		return( -1 );
 	}
-	if( libbfio_file_get_name_size(
+
+	if( segment_file_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid segment file handle for chunk: %" PRIu32 ".",
+		 function,
+		 internal_handle->io_handle->current_chunk );
+
+		return( -1 );
+	}
+	file_io_pool_entry = segment_file_handle->file_io_pool_entry;
+
+	if( libbfio_pool_get_handle(
+	     internal_handle->io_handle->file_io_pool,
+	     file_io_pool_entry,
 	     file_io_handle,
-	     filename_size,
 	     error ) != 1 )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve filename size.",
-		 function );
+		 "%s: unable to retrieve file io handle for pool entry: %d (chunk: %" PRIu32 ").",
+		 function,
+		 file_io_pool_entry,
+		 internal_handle->io_handle->current_chunk );
 
 		return( -1 );
 	}
 	return( 1 );
 }
 
-/* Retrieves the filename of the (delta) segment file of the current chunk
- * The filename size should include the end of string character
+/* Retrieves the maximum amount of bytes used by the chunk cache
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_get_filename(
+int libewf_handle_get_maximum_cache_size(
      libewf_handle_t *handle,
-     char *filename,
-     size_t filename_size,
+     size_t *maximum_cache_size,
      liberror_error_t **error )
 {
-	libbfio_handle_t *file_io_handle = NULL;
-	static char *function            = "libewf_handle_get_filename";
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_maximum_cache_size";
 
 	if( handle == NULL )
 	{
@@ -4191,51 +5446,47 @@ int libewf_handle_get_filename(
 
 		return( -1 );
 	}
-	if( libewf_handle_get_file_io_handle(
-	     handle,
-	     &file_io_handle,
-	     error ) != 1 )
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->chunk_cache == NULL )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve file io handle for current chunk.",
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing chunk cache.",
 		 function );
 
 		return( -1 );
 	}
-	if( libbfio_file_get_name(
-	     file_io_handle,
-	     filename,
-	     filename_size,
-	     error ) != 1 )
+	if( maximum_cache_size == NULL )
 	{
 		liberror_error_set(
 		 error,
-		 LIBERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve filename.",
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid maximum cache size.",
 		 function );
 
 		return( -1 );
 	}
+	*maximum_cache_size = internal_handle->chunk_cache->maximum_cache_size;
+
 	return( 1 );
 }
 
-#if defined( HAVE_WIDE_CHARACTER_TYPE )
-
-/* Retrieves the filename size of the (delta) segment file of the current chunk
- * The filename size includes the end of string character
+/* Sets the maximum amount of bytes used by the chunk cache
+ * The chunk cache always holds at least a single chunk
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_get_filename_size_wide(
+int libewf_handle_set_maximum_cache_size(
      libewf_handle_t *handle,
-     size_t *filename_size,
+     size_t maximum_cache_size,
      liberror_error_t **error )
 {
-	libbfio_handle_t *file_io_handle = NULL;
-	static char *function            = "libewf_handle_get_filename_size_wide";
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_maximum_cache_size";
+	int result                                = 0;
 
 	if( handle == NULL )
 	{
@@ -4248,30 +5499,39 @@ int libewf_handle_get_filename_size_wide(
 
 		return( -1 );
 	}
-	if( libewf_handle_get_file_io_handle(
-	     handle,
-	     &file_io_handle,
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( libewf_chunk_cache_grab_for_write(
+	     internal_handle->chunk_cache,
 	     error ) != 1 )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve file io handle for current chunk.",
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab chunk cache for writing.",
 		 function );
 
 		return( -1 );
 	}
-	if( libbfio_file_get_name_size_wide(
-	     file_io_handle,
-	     filename_size,
-	     error ) != 1 )
+	result = libewf_chunk_cache_set_maximum_cache_size(
+	          internal_handle->chunk_cache,
+	          maximum_cache_size,
+	          error );
+
+	if( libewf_chunk_cache_release(
+	     internal_handle->chunk_cache,
+	     NULL ) != 1 )
+	{
+		result = -1;
+	}
+	if( result != 1 )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve filename size.",
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set maximum cache size.",
 		 function );
 
 		return( -1 );
@@ -4279,18 +5539,16 @@ int libewf_handle_get_filename_size_wide(
 	return( 1 );
 }
 
-/* Retrieves the filename of the (delta) segment file of the current chunk
- * The filename size should include the end of string character
+/* Retrieves the maximum number of threads used to process chunks
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_get_filename_wide(
+int libewf_handle_get_maximum_number_of_threads(
      libewf_handle_t *handle,
-     wchar_t *filename,
-     size_t filename_size,
+     int *maximum_number_of_threads,
      liberror_error_t **error )
 {
-	libbfio_handle_t *file_io_handle = NULL;
-	static char *function            = "libewf_handle_get_filename_wide";
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_maximum_number_of_threads";
 
 	if( handle == NULL )
 	{
@@ -4303,52 +5561,47 @@ int libewf_handle_get_filename_wide(
 
 		return( -1 );
 	}
-	if( libewf_handle_get_file_io_handle(
-	     handle,
-	     &file_io_handle,
-	     error ) != 1 )
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve file io handle for current chunk.",
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing io handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( libbfio_file_get_name_wide(
-	     file_io_handle,
-	     filename,
-	     filename_size,
-	     error ) != 1 )
+	if( maximum_number_of_threads == NULL )
 	{
 		liberror_error_set(
 		 error,
-		 LIBERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve filename.",
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid maximum number of threads.",
 		 function );
 
 		return( -1 );
 	}
+	*maximum_number_of_threads = internal_handle->io_handle->maximum_number_of_threads;
+
 	return( 1 );
 }
 
-#endif
-
-/* Retrieves the file io handle of the (delta) segment file of the current chunk
+/* Sets the maximum number of threads used to process chunks
+ * More than one thread allows the chunks to be compressed in parallel on write
+ * The value is ignored when libewf is built without multi-threading support
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_get_file_io_handle(
+int libewf_handle_set_maximum_number_of_threads(
      libewf_handle_t *handle,
-     libbfio_handle_t **file_io_handle,
+     int maximum_number_of_threads,
      liberror_error_t **error )
 {
-	libewf_internal_handle_t *internal_handle         = NULL;
-	libewf_segment_file_handle_t *segment_file_handle = NULL;
-	static char *function                             = "libewf_handle_get_file_io_handle";
-	int file_io_pool_entry                            = 0;
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_maximum_number_of_threads";
 
 	if( handle == NULL )
 	{
@@ -4369,96 +5622,186 @@ int libewf_handle_get_file_io_handle(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
+		 "%s: invalid handle - missing io handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->io_handle->file_io_pool == NULL )
+	if( internal_handle->write_io_handle != NULL )
+	{
+		if( internal_handle->write_io_handle->values_initialized != 0 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: maximum number of threads cannot be changed.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( internal_handle->read_ahead_pool != NULL )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - invalid IO handle - missing file IO pool.",
+		 LIBERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: maximum number of threads cannot be changed.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values == NULL )
+#endif
+	if( maximum_number_of_threads <= 0 )
 	{
 		liberror_error_set(
 		 error,
-		 LIBERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum number of threads value zero or less.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->offset_table == NULL )
+	if( maximum_number_of_threads > LIBEWF_MAXIMUM_NUMBER_OF_THREADS )
 	{
 		liberror_error_set(
 		 error,
-		 LIBERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing offset table.",
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid maximum number of threads value exceeds maximum.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->offset_table->chunk_offset == NULL )
+	internal_handle->io_handle->maximum_number_of_threads = maximum_number_of_threads;
+
+	return( 1 );
+}
+
+/* Retrieves the statistics of the handle
+ * The file IO values are retrieved from the file IO pool
+ * the size of the statistics must be set by the caller
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_statistics(
+     libewf_handle_t *handle,
+     libewf_statistics_t *statistics,
+     liberror_error_t **error )
+{
+	libewf_statistics_t handle_statistics;
+
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_statistics";
+
+	if( handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - invalid offset table - missing chunk offset.",
+		 "%s: invalid handle - missing io handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->io_handle->current_chunk >= internal_handle->offset_table->amount_of_chunk_offsets )
+	if( statistics == NULL )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBERROR_ARGUMENT_ERROR_VALUE_OUT_OF_RANGE,
-		 "%s: invalid current chunk value out of range.",
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics.",
 		 function );
 
 		return( -1 );
 	}
-	segment_file_handle = internal_handle->offset_table->chunk_offset[ internal_handle->io_handle->current_chunk ].segment_file_handle;
-
-	if( segment_file_handle == NULL )
+	/* A smaller size is allowed so that callers built against
+	 * an earlier version of the structure keep working
+	 */
+	if( ( statistics->size <= sizeof( size_t ) )
+	 || ( statistics->size > sizeof( libewf_statistics_t ) ) )
 	{
 		liberror_error_set(
 		 error,
-		 LIBERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid segment file handle for chunk: %" PRIu32 ".",
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported statistics size: %" PRIzd ".",
 		 function,
-		 internal_handle->io_handle->current_chunk );
+		 statistics->size );
 
 		return( -1 );
 	}
-	file_io_pool_entry = segment_file_handle->file_io_pool_entry;
-
-	if( libbfio_pool_get_handle(
-	     internal_handle->io_handle->file_io_pool,
-	     file_io_pool_entry,
-	     file_io_handle,
+	if( libewf_statistics_copy(
+	     &handle_statistics,
+	     &( internal_handle->io_handle->statistics ),
 	     error ) != 1 )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve file io handle for pool entry: %d (chunk: %" PRIu32 ").",
-		 function,
-		 file_io_pool_entry,
-		 internal_handle->io_handle->current_chunk );
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to copy statistics.",
+		 function );
+
+		return( -1 );
+	}
+	handle_statistics.size                     = statistics->size;
+	handle_statistics.amount_of_file_io_reads  = 0;
+	handle_statistics.amount_of_file_io_writes = 0;
+	handle_statistics.amount_of_file_io_seeks  = 0;
+	handle_statistics.amount_of_file_io_opens  = 0;
+	handle_statistics.amount_of_file_io_closes = 0;
+
+	if( internal_handle->io_handle->file_io_pool != NULL )
+	{
+		if( libbfio_pool_get_statistics(
+		     internal_handle->io_handle->file_io_pool,
+		     &( handle_statistics.amount_of_file_io_reads ),
+		     &( handle_statistics.amount_of_file_io_writes ),
+		     &( handle_statistics.amount_of_file_io_seeks ),
+		     &( handle_statistics.amount_of_file_io_opens ),
+		     &( handle_statistics.amount_of_file_io_closes ),
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve file IO pool statistics.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	/* Only the members that fit in the size of the caller are copied
+	 */
+	if( memory_copy(
+	     statistics,
+	     &handle_statistics,
+	     statistics->size ) == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_MEMORY,
+		 LIBERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy statistics.",
+		 function );
 
 		return( -1 );
 	}
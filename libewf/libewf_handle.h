@@ -36,6 +36,7 @@
 #include "libewf_io_handle.h"
 #include "libewf_media_values.h"
 #include "libewf_offset_table.h"
+#include "libewf_read_ahead_pool.h"
 #include "libewf_read_io_handle.h"
 #include "libewf_segment_table.h"
 #include "libewf_sector_table.h"
@@ -83,11 +84,22 @@ struct libewf_internal_handle
 	 */
 	libewf_offset_table_t *offset_table;
 
-	/* A simple cache is implemented here to avoid having to read and decompress the
-	 * same chunk while reading the data.
+	/* The index file that contains the offset table
+	 */
+	libbfio_handle_t *index_file_io_handle;
+
+	/* The chunk cache contains the most recently used chunks to avoid having
+	 * to read and decompress the same chunk while reading the data.
 	 */
 	libewf_chunk_cache_t *chunk_cache;
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The read-ahead pool reads and decompresses the chunks following
+	 * the chunk that is read into the chunk cache while reading sequentially
+	 */
+	libewf_read_ahead_pool_t *read_ahead_pool;
+#endif
+
 	/* The media values
 	 */
 	libewf_media_values_t *media_values;
@@ -211,6 +223,19 @@ LIBEWF_EXTERN ssize_t libewf_handle_read_random(
                        off64_t offset,
                        liberror_error_t **error );
 
+LIBEWF_EXTERN ssize_t libewf_handle_read_buffer_at_offset(
+                       libewf_handle_t *handle,
+                       void *buffer,
+                       size_t size,
+                       off64_t offset,
+                       liberror_error_t **error );
+
+LIBEWF_EXTERN int libewf_handle_is_empty_range(
+                   libewf_handle_t *handle,
+                   off64_t offset,
+                   size64_t size,
+                   liberror_error_t **error );
+
 LIBEWF_EXTERN ssize_t libewf_handle_prepare_write_chunk(
                        libewf_handle_t *handle,
                        void *chunk_buffer,
@@ -347,6 +372,20 @@ LIBEWF_EXTERN int libewf_handle_set_delta_segment_file_size(
                    size64_t delta_segment_file_size,
                    liberror_error_t **error );
 
+LIBEWF_EXTERN int libewf_handle_set_index_filename(
+                   libewf_handle_t *handle,
+                   const char *filename,
+                   size_t filename_length,
+                   liberror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+LIBEWF_EXTERN int libewf_handle_set_index_filename_wide(
+                   libewf_handle_t *handle,
+                   const wchar_t *filename,
+                   size_t filename_length,
+                   liberror_error_t **error );
+#endif
+
 LIBEWF_EXTERN int libewf_handle_get_filename_size(
                    libewf_handle_t *handle,
                    size_t *filename_size,
@@ -376,6 +415,31 @@ LIBEWF_EXTERN int libewf_handle_get_file_io_handle(
                    libbfio_handle_t **file_io_handle,
                    liberror_error_t **error );
 
+LIBEWF_EXTERN int libewf_handle_get_maximum_cache_size(
+                   libewf_handle_t *handle,
+                   size_t *maximum_cache_size,
+                   liberror_error_t **error );
+
+LIBEWF_EXTERN int libewf_handle_set_maximum_cache_size(
+                   libewf_handle_t *handle,
+                   size_t maximum_cache_size,
+                   liberror_error_t **error );
+
+LIBEWF_EXTERN int libewf_handle_get_maximum_number_of_threads(
+                   libewf_handle_t *handle,
+                   int *maximum_number_of_threads,
+                   liberror_error_t **error );
+
+LIBEWF_EXTERN int libewf_handle_set_maximum_number_of_threads(
+                   libewf_handle_t *handle,
+                   int maximum_number_of_threads,
+                   liberror_error_t **error );
+
+LIBEWF_EXTERN int libewf_handle_get_statistics(
+                   libewf_handle_t *handle,
+                   libewf_statistics_t *statistics,
+                   liberror_error_t **error );
+
 int libewf_internal_handle_add_segment_file(
      libewf_internal_handle_t *internal_handle,
      int file_io_pool_entry,
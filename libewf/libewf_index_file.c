@@ -0,0 +1,1521 @@
+/*
+ * Offset table index file functions
+ *
+ * Copyright (c) 2006-2009, Joachim Metz <forensics@hoffmannbv.nl>,
+ * Hoffmann Investigations.
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include <liberror.h>
+#include <libnotify.h>
+
+#include "libewf_chunk_offset.h"
+#include "libewf_hash_sections.h"
+#include "libewf_header_sections.h"
+#include "libewf_index_file.h"
+#include "libewf_libbfio.h"
+#include "libewf_offset_table.h"
+#include "libewf_segment_file_handle.h"
+#include "libewf_segment_table.h"
+#include "libewf_table_section.h"
+
+#include "ewf_crc.h"
+#include "ewf_definitions.h"
+#include "ewf_table.h"
+#include "ewfx_index.h"
+
+const uint8_t idx_file_signature[ 8 ] = { 0x69, 0x64, 0x78, 0x09, 0x0D, 0x0A, 0xFF, 0x00 };
+
+/* Retrieves the segment number of a segment file handle
+ * Returns 1 if successful, 0 if no such segment file handle or -1 on error
+ */
+int libewf_index_file_get_segment_number(
+     libewf_segment_table_t *segment_table,
+     libewf_segment_file_handle_t *segment_file_handle,
+     uint16_t *segment_number,
+     liberror_error_t **error )
+{
+	static char *function    = "libewf_index_file_get_segment_number";
+	uint16_t segment_counter = 0;
+	uint16_t segment_index   = 0;
+
+	if( segment_table == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment table.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_number == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment number.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_table->amount <= 1 )
+	{
+		return( 0 );
+	}
+	/* The table sections are stored in order of the segment files
+	 * therefore the search starts at the previous segment number
+	 */
+	segment_index = *segment_number;
+
+	if( ( segment_index == 0 )
+	 || ( segment_index >= segment_table->amount ) )
+	{
+		segment_index = 1;
+	}
+	for( segment_counter = 1;
+	     segment_counter < segment_table->amount;
+	     segment_counter++ )
+	{
+		if( segment_table->segment_file_handle[ segment_index ] == segment_file_handle )
+		{
+			*segment_number = segment_index;
+
+			return( 1 );
+		}
+		segment_index++;
+
+		if( segment_index >= segment_table->amount )
+		{
+			segment_index = 1;
+		}
+	}
+	return( 0 );
+}
+
+/* Calculates the CRCs of the header and hash section data
+ * The header sections are the header, header2 and xheader sections
+ * the hash sections are the hash and xhash sections
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_file_calculate_sections_crc(
+     libewf_header_sections_t *header_sections,
+     libewf_hash_sections_t *hash_sections,
+     uint32_t *header_sections_crc,
+     uint32_t *hash_sections_crc,
+     liberror_error_t **error )
+{
+	static char *function = "libewf_index_file_calculate_sections_crc";
+
+	if( header_sections == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid header sections.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_sections == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash sections.",
+		 function );
+
+		return( -1 );
+	}
+	if( header_sections_crc == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid header sections CRC.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_sections_crc == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash sections CRC.",
+		 function );
+
+		return( -1 );
+	}
+	*header_sections_crc = 1;
+
+	if( header_sections->header != NULL )
+	{
+		*header_sections_crc = ewf_crc_calculate(
+		                        header_sections->header,
+		                        header_sections->header_size,
+		                        *header_sections_crc );
+	}
+	if( header_sections->header2 != NULL )
+	{
+		*header_sections_crc = ewf_crc_calculate(
+		                        header_sections->header2,
+		                        header_sections->header2_size,
+		                        *header_sections_crc );
+	}
+	if( header_sections->xheader != NULL )
+	{
+		*header_sections_crc = ewf_crc_calculate(
+		                        header_sections->xheader,
+		                        header_sections->xheader_size,
+		                        *header_sections_crc );
+	}
+	*hash_sections_crc = 1;
+
+	if( hash_sections->md5_hash_set != 0 )
+	{
+		*hash_sections_crc = ewf_crc_calculate(
+		                      hash_sections->md5_hash,
+		                      16,
+		                      *hash_sections_crc );
+	}
+	if( hash_sections->xhash != NULL )
+	{
+		*hash_sections_crc = ewf_crc_calculate(
+		                      hash_sections->xhash,
+		                      hash_sections->xhash_size,
+		                      *hash_sections_crc );
+	}
+	return( 1 );
+}
+
+/* Reads the CRC that is stored after the offsets of a table section
+ * The CRC is set to 0 for the EWF-S01 format which does not contain it
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_file_read_offsets_crc(
+     libewf_table_section_t *table_section,
+     libbfio_pool_t *file_io_pool,
+     uint32_t *offsets_crc,
+     liberror_error_t **error )
+{
+	uint8_t stored_crc_buffer[ 4 ];
+
+	static char *function = "libewf_index_file_read_offsets_crc";
+	off64_t file_offset   = 0;
+	ssize_t read_count    = 0;
+
+	if( table_section == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid table section.",
+		 function );
+
+		return( -1 );
+	}
+	if( table_section->segment_file_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid table section - missing segment file handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( offsets_crc == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offsets CRC.",
+		 function );
+
+		return( -1 );
+	}
+	if( table_section->ewf_format == EWF_FORMAT_S01 )
+	{
+		*offsets_crc = 0;
+
+		return( 1 );
+	}
+	file_offset = table_section->offsets_file_offset
+	            + (off64_t) ( sizeof( ewf_table_offset_t ) * table_section->amount_of_chunks );
+
+	read_count = libbfio_pool_read_at_offset(
+	              file_io_pool,
+	              table_section->segment_file_handle->file_io_pool_entry,
+	              stored_crc_buffer,
+	              sizeof( ewf_crc_t ),
+	              file_offset,
+	              error );
+
+	if( read_count != (ssize_t) sizeof( ewf_crc_t ) )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_IO,
+		 LIBERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read offsets CRC.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 stored_crc_buffer,
+	 *offsets_crc );
+
+	return( 1 );
+}
+
+/* Reads the offset table from an index file
+ * The index file is only used if it corresponds with the segment files
+ * and the table sections that were found in them
+ * Returns 1 if successful, 0 if the index file cannot be used or -1 on error
+ */
+int libewf_index_file_read(
+     libbfio_handle_t *file_io_handle,
+     libewf_offset_table_t *offset_table,
+     libewf_segment_table_t *segment_table,
+     libewf_header_sections_t *header_sections,
+     libewf_hash_sections_t *hash_sections,
+     libbfio_pool_t *file_io_pool,
+     liberror_error_t **error )
+{
+	ewfx_index_header_t index_header;
+	uint8_t stored_crc_buffer[ 4 ];
+
+	libewf_table_section_t *table_section = NULL;
+	uint8_t *index_data                   = NULL;
+	uint8_t *index_entry                  = NULL;
+	static char *function                 = "libewf_index_file_read";
+	ewf_crc_t calculated_crc              = 0;
+	ewf_crc_t stored_crc                  = 0;
+	off64_t file_offset                   = 0;
+	size64_t expected_file_size           = 0;
+	size64_t file_size                    = 0;
+	size64_t segment_file_size            = 0;
+	size64_t stored_segment_file_size     = 0;
+	size_t index_data_size                = 0;
+	ssize_t read_count                    = 0;
+	uint32_t amount_of_chunks             = 0;
+	uint32_t amount_of_segments           = 0;
+	uint32_t amount_of_tables             = 0;
+	uint32_t chunk_iterator               = 0;
+	uint32_t chunk_size                   = 0;
+	uint32_t first_chunk                  = 0;
+	uint32_t hash_sections_crc            = 0;
+	uint32_t header_sections_crc          = 0;
+	uint32_t offsets_crc                  = 0;
+	uint32_t stored_hash_sections_crc     = 0;
+	uint32_t stored_header_sections_crc   = 0;
+	uint32_t stored_offsets_crc           = 0;
+	uint32_t stored_table_crc             = 0;
+	uint32_t table_iterator               = 0;
+	uint32_t version                      = 0;
+	uint16_t segment_number               = 0;
+	int result                            = 1;
+
+	if( file_io_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file io handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset_table == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset table.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_table == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment table.",
+		 function );
+
+		return( -1 );
+	}
+	/* The header and hash section data identify the image
+	 * it is part of the index file so that an index file of another image is not used
+	 */
+	if( libewf_index_file_calculate_sections_crc(
+	     header_sections,
+	     hash_sections,
+	     &header_sections_crc,
+	     &hash_sections_crc,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to calculate sections CRC.",
+		 function );
+
+		return( -1 );
+	}
+	result = libbfio_handle_exists(
+	          file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_IO,
+		 LIBERROR_IO_ERROR_GENERIC,
+		 "%s: unable to test if index file exists.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( libbfio_handle_open(
+	     file_io_handle,
+	     LIBBFIO_OPEN_READ,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_IO,
+		 LIBERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_handle_get_size(
+	     file_io_handle,
+	     &file_size,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve index file size.",
+		 function );
+
+		libbfio_handle_close(
+		 file_io_handle,
+		 NULL );
+
+		return( -1 );
+	}
+	result = 1;
+
+	if( file_size < (size64_t) ( sizeof( ewfx_index_header_t ) + sizeof( ewf_crc_t ) ) )
+	{
+		result = 0;
+	}
+	if( result == 1 )
+	{
+		read_count = libbfio_handle_read(
+		              file_io_handle,
+		              (uint8_t *) &index_header,
+		              sizeof( ewfx_index_header_t ),
+		              error );
+
+		if( read_count != (ssize_t) sizeof( ewfx_index_header_t ) )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read index file header.",
+			 function );
+
+			libbfio_handle_close(
+			 file_io_handle,
+			 NULL );
+
+			return( -1 );
+		}
+		calculated_crc = ewf_crc_calculate(
+		                  &index_header,
+		                  ( sizeof( ewfx_index_header_t ) - sizeof( ewf_crc_t ) ),
+		                  1 );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 index_header.crc,
+		 stored_crc );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 index_header.version,
+		 version );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 index_header.amount_of_segments,
+		 amount_of_segments );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 index_header.amount_of_tables,
+		 amount_of_tables );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 index_header.amount_of_chunks,
+		 amount_of_chunks );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 index_header.header_sections_crc,
+		 stored_header_sections_crc );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 index_header.hash_sections_crc,
+		 stored_hash_sections_crc );
+
+		if( ( memory_compare(
+		       idx_file_signature,
+		       index_header.signature,
+		       8 ) != 0 )
+		 || ( stored_crc != calculated_crc )
+		 || ( version != LIBEWF_INDEX_FILE_VERSION ) )
+		{
+#if defined( HAVE_VERBOSE_OUTPUT )
+			libnotify_verbose_printf(
+			 "%s: unsupported index file header.\n",
+			 function );
+#endif
+
+			result = 0;
+		}
+	}
+	/* The index file must correspond with the segment files and table sections
+	 */
+	if( result == 1 )
+	{
+		if( ( amount_of_segments != (uint32_t) ( segment_table->amount - 1 ) )
+		 || ( amount_of_tables != offset_table->amount_of_table_sections )
+		 || ( amount_of_chunks != offset_table->last_chunk_offset_filled )
+		 || ( stored_header_sections_crc != header_sections_crc )
+		 || ( stored_hash_sections_crc != hash_sections_crc ) )
+		{
+#if defined( HAVE_VERBOSE_OUTPUT )
+			libnotify_verbose_printf(
+			 "%s: index file does not correspond with segment files.\n",
+			 function );
+#endif
+
+			result = 0;
+		}
+	}
+	if( result == 1 )
+	{
+		expected_file_size = sizeof( ewfx_index_header_t )
+		                   + ( (size64_t) amount_of_segments * sizeof( ewfx_index_segment_t ) )
+		                   + ( (size64_t) amount_of_tables * sizeof( ewfx_index_table_t ) )
+		                   + ( (size64_t) amount_of_chunks * sizeof( ewfx_index_chunk_t ) )
+		                   + sizeof( ewf_crc_t );
+
+		if( file_size != expected_file_size )
+		{
+#if defined( HAVE_VERBOSE_OUTPUT )
+			libnotify_verbose_printf(
+			 "%s: index file size does not match.\n",
+			 function );
+#endif
+
+			result = 0;
+		}
+	}
+	if( result == 1 )
+	{
+		/* The segment and table entries are read at once
+		 * the chunk entries are read per table section
+		 */
+		index_data_size = ( (size_t) amount_of_segments * sizeof( ewfx_index_segment_t ) )
+		                + ( (size_t) amount_of_tables * sizeof( ewfx_index_table_t ) );
+
+		if( ( (size64_t) index_data_size > (size64_t) SSIZE_MAX )
+		 || ( index_data_size == 0 ) )
+		{
+			result = 0;
+		}
+	}
+	if( result == 1 )
+	{
+		index_data = (uint8_t *) memory_allocate(
+		                          index_data_size );
+
+		if( index_data == NULL )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_MEMORY,
+			 LIBERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create index data.",
+			 function );
+
+			libbfio_handle_close(
+			 file_io_handle,
+			 NULL );
+
+			return( -1 );
+		}
+		read_count = libbfio_handle_read(
+		              file_io_handle,
+		              index_data,
+		              index_data_size,
+		              error );
+
+		if( read_count != (ssize_t) index_data_size )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read index data.",
+			 function );
+
+			memory_free(
+			 index_data );
+			libbfio_handle_close(
+			 file_io_handle,
+			 NULL );
+
+			return( -1 );
+		}
+		calculated_crc = ewf_crc_calculate(
+		                  &index_header,
+		                  sizeof( ewfx_index_header_t ),
+		                  1 );
+
+		calculated_crc = ewf_crc_calculate(
+		                  index_data,
+		                  index_data_size,
+		                  calculated_crc );
+
+		index_entry = index_data;
+
+		for( segment_number = 1;
+		     segment_number < segment_table->amount;
+		     segment_number++ )
+		{
+			if( libbfio_pool_get_size(
+			     file_io_pool,
+			     segment_table->segment_file_handle[ segment_number ]->file_io_pool_entry,
+			     &segment_file_size,
+			     error ) != 1 )
+			{
+				liberror_error_set(
+				 error,
+				 LIBERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve size of segment file: %" PRIu16 ".",
+				 function,
+				 segment_number );
+
+				memory_free(
+				 index_data );
+				libbfio_handle_close(
+				 file_io_handle,
+				 NULL );
+
+				return( -1 );
+			}
+			byte_stream_copy_to_uint64_little_endian(
+			 ( (ewfx_index_segment_t *) index_entry )->file_size,
+			 stored_segment_file_size );
+
+			if( stored_segment_file_size != segment_file_size )
+			{
+#if defined( HAVE_VERBOSE_OUTPUT )
+				libnotify_verbose_printf(
+				 "%s: size of segment file: %" PRIu16 " does not match.\n",
+				 function,
+				 segment_number );
+#endif
+
+				result = 0;
+
+				break;
+			}
+			index_entry += sizeof( ewfx_index_segment_t );
+		}
+	}
+	if( result == 1 )
+	{
+		for( table_iterator = 0;
+		     table_iterator < amount_of_tables;
+		     table_iterator++ )
+		{
+			table_section = &( offset_table->table_sections[ table_iterator ] );
+
+			byte_stream_copy_to_uint16_little_endian(
+			 ( (ewfx_index_table_t *) index_entry )->segment_number,
+			 segment_number );
+
+			byte_stream_copy_to_uint64_little_endian(
+			 ( (ewfx_index_table_t *) index_entry )->offsets_file_offset,
+			 file_offset );
+
+			byte_stream_copy_to_uint32_little_endian(
+			 ( (ewfx_index_table_t *) index_entry )->first_chunk,
+			 first_chunk );
+
+			byte_stream_copy_to_uint32_little_endian(
+			 ( (ewfx_index_table_t *) index_entry )->amount_of_chunks,
+			 amount_of_chunks );
+
+			byte_stream_copy_to_uint32_little_endian(
+			 ( (ewfx_index_table_t *) index_entry )->table_crc,
+			 stored_table_crc );
+
+			byte_stream_copy_to_uint32_little_endian(
+			 ( (ewfx_index_table_t *) index_entry )->offsets_crc,
+			 stored_offsets_crc );
+
+			if( ( segment_number == 0 )
+			 || ( segment_number >= segment_table->amount )
+			 || ( segment_table->segment_file_handle[ segment_number ] != table_section->segment_file_handle )
+			 || ( file_offset != table_section->offsets_file_offset )
+			 || ( first_chunk != table_section->first_chunk )
+			 || ( amount_of_chunks != table_section->amount_of_chunks )
+			 || ( stored_table_crc != table_section->table_crc ) )
+			{
+#if defined( HAVE_VERBOSE_OUTPUT )
+				libnotify_verbose_printf(
+				 "%s: table section: %" PRIu32 " does not match.\n",
+				 function,
+				 table_iterator );
+#endif
+
+				result = 0;
+
+				break;
+			}
+			/* The CRC of the offsets changes when the chunks are stored differently
+			 */
+			if( libewf_index_file_read_offsets_crc(
+			     table_section,
+			     file_io_pool,
+			     &offsets_crc,
+			     error ) != 1 )
+			{
+				liberror_error_set(
+				 error,
+				 LIBERROR_ERROR_DOMAIN_IO,
+				 LIBERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read offsets CRC of table section: %" PRIu32 ".",
+				 function,
+				 table_iterator );
+
+				memory_free(
+				 index_data );
+				libbfio_handle_close(
+				 file_io_handle,
+				 NULL );
+
+				return( -1 );
+			}
+			if( stored_offsets_crc != offsets_crc )
+			{
+#if defined( HAVE_VERBOSE_OUTPUT )
+				libnotify_verbose_printf(
+				 "%s: offsets CRC of table section: %" PRIu32 " does not match.\n",
+				 function,
+				 table_iterator );
+#endif
+
+				result = 0;
+
+				break;
+			}
+			index_entry += sizeof( ewfx_index_table_t );
+		}
+	}
+	if( index_data != NULL )
+	{
+		memory_free(
+		 index_data );
+
+		index_data = NULL;
+	}
+	/* The chunk entries are read per table section
+	 */
+	for( table_iterator = 0;
+	     ( result == 1 ) && ( table_iterator < amount_of_tables );
+	     table_iterator++ )
+	{
+		table_section   = &( offset_table->table_sections[ table_iterator ] );
+		index_data_size = sizeof( ewfx_index_chunk_t ) * table_section->amount_of_chunks;
+
+		if( index_data_size > (size_t) SSIZE_MAX )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid index data size value exceeds maximum.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+		index_data = (uint8_t *) memory_allocate(
+		                          index_data_size );
+
+		if( index_data == NULL )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_MEMORY,
+			 LIBERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create index data.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+		read_count = libbfio_handle_read(
+		              file_io_handle,
+		              index_data,
+		              index_data_size,
+		              error );
+
+		if( read_count != (ssize_t) index_data_size )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read index chunk entries.",
+			 function );
+
+			memory_free(
+			 index_data );
+
+			result = -1;
+
+			break;
+		}
+		calculated_crc = ewf_crc_calculate(
+		                  index_data,
+		                  index_data_size,
+		                  calculated_crc );
+
+		index_entry = index_data;
+
+		for( chunk_iterator = 0;
+		     chunk_iterator < table_section->amount_of_chunks;
+		     chunk_iterator++ )
+		{
+			byte_stream_copy_to_uint64_little_endian(
+			 ( (ewfx_index_chunk_t *) index_entry )->file_offset,
+			 file_offset );
+
+			byte_stream_copy_to_uint32_little_endian(
+			 ( (ewfx_index_chunk_t *) index_entry )->size,
+			 chunk_size );
+
+			if( libewf_offset_table_set_chunk_offset(
+			     offset_table,
+			     table_section->first_chunk + chunk_iterator,
+			     table_section->segment_file_handle,
+			     file_offset,
+			     (size_t) chunk_size,
+			     ( (ewfx_index_chunk_t *) index_entry )->flags,
+			     error ) != 1 )
+			{
+				liberror_error_set(
+				 error,
+				 LIBERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set chunk offset: %" PRIu32 ".",
+				 function,
+				 table_section->first_chunk + chunk_iterator );
+
+				result = -1;
+
+				break;
+			}
+			index_entry += sizeof( ewfx_index_chunk_t );
+		}
+		memory_free(
+		 index_data );
+
+		index_data = NULL;
+	}
+	if( result == 1 )
+	{
+		read_count = libbfio_handle_read(
+		              file_io_handle,
+		              stored_crc_buffer,
+		              sizeof( ewf_crc_t ),
+		              error );
+
+		if( read_count != (ssize_t) sizeof( ewf_crc_t ) )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read CRC.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( result == 1 )
+	{
+		byte_stream_copy_to_uint32_little_endian(
+		 stored_crc_buffer,
+		 stored_crc );
+
+		/* The table sections are not marked as read if the CRC does not match
+		 * so that their chunk offsets are read from the segment files instead
+		 */
+		if( stored_crc != calculated_crc )
+		{
+#if defined( HAVE_VERBOSE_OUTPUT )
+			libnotify_verbose_printf(
+			 "%s: CRC does not match (in file: %" PRIu32 " calculated: %" PRIu32 ").\n",
+			 function,
+			 stored_crc,
+			 calculated_crc );
+#endif
+
+			result = 0;
+		}
+	}
+	if( result == -1 )
+	{
+		libbfio_handle_close(
+		 file_io_handle,
+		 NULL );
+
+		return( -1 );
+	}
+	if( libbfio_handle_close(
+	     file_io_handle,
+	     error ) != 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_IO,
+		 LIBERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( result == 1 )
+	{
+		for( table_iterator = 0;
+		     table_iterator < amount_of_tables;
+		     table_iterator++ )
+		{
+			offset_table->table_sections[ table_iterator ].is_read = 1;
+		}
+	}
+	return( result );
+}
+
+/* Writes the offset table to an index file
+ * All the table sections must have been read
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_file_write(
+     libbfio_handle_t *file_io_handle,
+     libewf_offset_table_t *offset_table,
+     libewf_segment_table_t *segment_table,
+     libewf_header_sections_t *header_sections,
+     libewf_hash_sections_t *hash_sections,
+     libbfio_pool_t *file_io_pool,
+     liberror_error_t **error )
+{
+	ewfx_index_header_t index_header;
+	uint8_t calculated_crc_buffer[ 4 ];
+
+	libewf_segment_file_handle_t *segment_file_handle = NULL;
+	libewf_table_section_t *table_section             = NULL;
+	uint8_t *index_data                               = NULL;
+	uint8_t *index_entry                              = NULL;
+	static char *function                             = "libewf_index_file_write";
+	ewf_crc_t calculated_crc                          = 0;
+	off64_t file_offset                               = 0;
+	size64_t segment_file_size                        = 0;
+	size_t chunk_size                                 = 0;
+	size_t index_data_size                            = 0;
+	ssize_t write_count                               = 0;
+	uint32_t chunk_iterator                           = 0;
+	uint32_t hash_sections_crc                        = 0;
+	uint32_t header_sections_crc                      = 0;
+	uint32_t offsets_crc                              = 0;
+	uint32_t table_iterator                           = 0;
+	uint16_t segment_number                           = 0;
+	uint8_t chunk_flags                               = 0;
+	int result                                        = 1;
+
+	if( file_io_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file io handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset_table == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset table.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_table == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment table.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_table->amount <= 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid segment table - missing segment files.",
+		 function );
+
+		return( -1 );
+	}
+	for( table_iterator = 0;
+	     table_iterator < offset_table->amount_of_table_sections;
+	     table_iterator++ )
+	{
+		if( offset_table->table_sections[ table_iterator ].is_read == 0 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: table section: %" PRIu32 " was not read.",
+			 function,
+			 table_iterator );
+
+			return( -1 );
+		}
+	}
+	if( libewf_index_file_calculate_sections_crc(
+	     header_sections,
+	     hash_sections,
+	     &header_sections_crc,
+	     &hash_sections_crc,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to calculate sections CRC.",
+		 function );
+
+		return( -1 );
+	}
+	/* The segment and table entries are written at once
+	 * the chunk entries are written per table section
+	 */
+	index_data_size = ( (size_t) ( segment_table->amount - 1 ) * sizeof( ewfx_index_segment_t ) )
+	                + ( (size_t) offset_table->amount_of_table_sections * sizeof( ewfx_index_table_t ) );
+
+	if( index_data_size > (size_t) SSIZE_MAX )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid index data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	index_data = (uint8_t *) memory_allocate(
+	                          index_data_size );
+
+	if( index_data == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_MEMORY,
+		 LIBERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create index data.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     index_data,
+	     0,
+	     index_data_size ) == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_MEMORY,
+		 LIBERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear index data.",
+		 function );
+
+		memory_free(
+		 index_data );
+
+		return( -1 );
+	}
+	index_entry = index_data;
+
+	for( segment_number = 1;
+	     segment_number < segment_table->amount;
+	     segment_number++ )
+	{
+		if( libbfio_pool_get_size(
+		     file_io_pool,
+		     segment_table->segment_file_handle[ segment_number ]->file_io_pool_entry,
+		     &segment_file_size,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve size of segment file: %" PRIu16 ".",
+			 function,
+			 segment_number );
+
+			memory_free(
+			 index_data );
+
+			return( -1 );
+		}
+		byte_stream_copy_from_uint64_little_endian(
+		 ( (ewfx_index_segment_t *) index_entry )->file_size,
+		 segment_file_size );
+
+		index_entry += sizeof( ewfx_index_segment_t );
+	}
+	segment_number = 1;
+
+	for( table_iterator = 0;
+	     table_iterator < offset_table->amount_of_table_sections;
+	     table_iterator++ )
+	{
+		table_section = &( offset_table->table_sections[ table_iterator ] );
+
+		if( libewf_index_file_get_segment_number(
+		     segment_table,
+		     table_section->segment_file_handle,
+		     &segment_number,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment number of table section: %" PRIu32 ".",
+			 function,
+			 table_iterator );
+
+			memory_free(
+			 index_data );
+
+			return( -1 );
+		}
+		if( libewf_index_file_read_offsets_crc(
+		     table_section,
+		     file_io_pool,
+		     &offsets_crc,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read offsets CRC of table section: %" PRIu32 ".",
+			 function,
+			 table_iterator );
+
+			memory_free(
+			 index_data );
+
+			return( -1 );
+		}
+		byte_stream_copy_from_uint64_little_endian(
+		 ( (ewfx_index_table_t *) index_entry )->offsets_file_offset,
+		 table_section->offsets_file_offset );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 ( (ewfx_index_table_t *) index_entry )->first_chunk,
+		 table_section->first_chunk );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 ( (ewfx_index_table_t *) index_entry )->amount_of_chunks,
+		 table_section->amount_of_chunks );
+
+		byte_stream_copy_from_uint16_little_endian(
+		 ( (ewfx_index_table_t *) index_entry )->segment_number,
+		 segment_number );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 ( (ewfx_index_table_t *) index_entry )->table_crc,
+		 table_section->table_crc );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 ( (ewfx_index_table_t *) index_entry )->offsets_crc,
+		 offsets_crc );
+
+		index_entry += sizeof( ewfx_index_table_t );
+	}
+	if( memory_set(
+	     &index_header,
+	     0,
+	     sizeof( ewfx_index_header_t ) ) == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_MEMORY,
+		 LIBERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear index header.",
+		 function );
+
+		memory_free(
+		 index_data );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     index_header.signature,
+	     idx_file_signature,
+	     8 ) == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_MEMORY,
+		 LIBERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to set index file signature.",
+		 function );
+
+		memory_free(
+		 index_data );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 index_header.version,
+	 LIBEWF_INDEX_FILE_VERSION );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 index_header.amount_of_segments,
+	 (uint32_t) ( segment_table->amount - 1 ) );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 index_header.amount_of_tables,
+	 offset_table->amount_of_table_sections );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 index_header.amount_of_chunks,
+	 offset_table->last_chunk_offset_filled );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 index_header.header_sections_crc,
+	 header_sections_crc );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 index_header.hash_sections_crc,
+	 hash_sections_crc );
+
+	calculated_crc = ewf_crc_calculate(
+	                  &index_header,
+	                  ( sizeof( ewfx_index_header_t ) - sizeof( ewf_crc_t ) ),
+	                  1 );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 index_header.crc,
+	 calculated_crc );
+
+	if( libbfio_handle_open(
+	     file_io_handle,
+	     LIBBFIO_OPEN_WRITE_TRUNCATE,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_IO,
+		 LIBERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open index file.",
+		 function );
+
+		memory_free(
+		 index_data );
+
+		return( -1 );
+	}
+	write_count = libbfio_handle_write(
+	               file_io_handle,
+	               (uint8_t *) &index_header,
+	               sizeof( ewfx_index_header_t ),
+	               error );
+
+	if( write_count != (ssize_t) sizeof( ewfx_index_header_t ) )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_IO,
+		 LIBERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write index file header.",
+		 function );
+
+		result = -1;
+	}
+	if( result == 1 )
+	{
+		calculated_crc = ewf_crc_calculate(
+		                  &index_header,
+		                  sizeof( ewfx_index_header_t ),
+		                  1 );
+
+		calculated_crc = ewf_crc_calculate(
+		                  index_data,
+		                  index_data_size,
+		                  calculated_crc );
+
+		write_count = libbfio_handle_write(
+		               file_io_handle,
+		               index_data,
+		               index_data_size,
+		               error );
+
+		if( write_count != (ssize_t) index_data_size )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write index data.",
+			 function );
+
+			result = -1;
+		}
+	}
+	memory_free(
+	 index_data );
+
+	index_data = NULL;
+
+	for( table_iterator = 0;
+	     ( result == 1 ) && ( table_iterator < offset_table->amount_of_table_sections );
+	     table_iterator++ )
+	{
+		table_section   = &( offset_table->table_sections[ table_iterator ] );
+		index_data_size = sizeof( ewfx_index_chunk_t ) * table_section->amount_of_chunks;
+
+		index_data = (uint8_t *) memory_allocate(
+		                          index_data_size );
+
+		if( index_data == NULL )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_MEMORY,
+			 LIBERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create index data.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+		if( memory_set(
+		     index_data,
+		     0,
+		     index_data_size ) == NULL )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_MEMORY,
+			 LIBERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear index data.",
+			 function );
+
+			memory_free(
+			 index_data );
+
+			result = -1;
+
+			break;
+		}
+		index_entry = index_data;
+
+		for( chunk_iterator = 0;
+		     chunk_iterator < table_section->amount_of_chunks;
+		     chunk_iterator++ )
+		{
+			if( libewf_offset_table_get_chunk_offset(
+			     offset_table,
+			     table_section->first_chunk + chunk_iterator,
+			     &segment_file_handle,
+			     &file_offset,
+			     &chunk_size,
+			     &chunk_flags,
+			     error ) != 1 )
+			{
+				liberror_error_set(
+				 error,
+				 LIBERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve chunk offset: %" PRIu32 ".",
+				 function,
+				 table_section->first_chunk + chunk_iterator );
+
+				result = -1;
+
+				break;
+			}
+			byte_stream_copy_from_uint64_little_endian(
+			 ( (ewfx_index_chunk_t *) index_entry )->file_offset,
+			 file_offset );
+
+			byte_stream_copy_from_uint32_little_endian(
+			 ( (ewfx_index_chunk_t *) index_entry )->size,
+			 (uint32_t) chunk_size );
+
+			( (ewfx_index_chunk_t *) index_entry )->flags = chunk_flags;
+
+			index_entry += sizeof( ewfx_index_chunk_t );
+		}
+		if( result == 1 )
+		{
+			calculated_crc = ewf_crc_calculate(
+			                  index_data,
+			                  index_data_size,
+			                  calculated_crc );
+
+			write_count = libbfio_handle_write(
+			               file_io_handle,
+			               index_data,
+			               index_data_size,
+			               error );
+
+			if( write_count != (ssize_t) index_data_size )
+			{
+				liberror_error_set(
+				 error,
+				 LIBERROR_ERROR_DOMAIN_IO,
+				 LIBERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write index chunk entries.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 index_data );
+
+		index_data = NULL;
+	}
+	if( result == 1 )
+	{
+		byte_stream_copy_from_uint32_little_endian(
+		 calculated_crc_buffer,
+		 calculated_crc );
+
+		write_count = libbfio_handle_write(
+		               file_io_handle,
+		               calculated_crc_buffer,
+		               sizeof( ewf_crc_t ),
+		               error );
+
+		if( write_count != (ssize_t) sizeof( ewf_crc_t ) )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write CRC.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( result == -1 )
+	{
+		libbfio_handle_close(
+		 file_io_handle,
+		 NULL );
+
+		return( -1 );
+	}
+	if( libbfio_handle_close(
+	     file_io_handle,
+	     error ) != 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_IO,
+		 LIBERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close index file.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
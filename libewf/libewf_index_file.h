@@ -0,0 +1,88 @@
+/*
+ * Offset table index file functions
+ *
+ * Copyright (c) 2006-2009, Joachim Metz <forensics@hoffmannbv.nl>,
+ * Hoffmann Investigations.
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_INDEX_FILE_H )
+#define _LIBEWF_INDEX_FILE_H
+
+#include <common.h>
+#include <types.h>
+
+#include <liberror.h>
+
+#include "libewf_hash_sections.h"
+#include "libewf_header_sections.h"
+#include "libewf_libbfio.h"
+#include "libewf_offset_table.h"
+#include "libewf_segment_table.h"
+#include "libewf_table_section.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#define LIBEWF_INDEX_FILE_VERSION	2
+
+extern const uint8_t idx_file_signature[ 8 ];
+
+int libewf_index_file_get_segment_number(
+     libewf_segment_table_t *segment_table,
+     libewf_segment_file_handle_t *segment_file_handle,
+     uint16_t *segment_number,
+     liberror_error_t **error );
+
+int libewf_index_file_calculate_sections_crc(
+     libewf_header_sections_t *header_sections,
+     libewf_hash_sections_t *hash_sections,
+     uint32_t *header_sections_crc,
+     uint32_t *hash_sections_crc,
+     liberror_error_t **error );
+
+int libewf_index_file_read_offsets_crc(
+     libewf_table_section_t *table_section,
+     libbfio_pool_t *file_io_pool,
+     uint32_t *offsets_crc,
+     liberror_error_t **error );
+
+int libewf_index_file_read(
+     libbfio_handle_t *file_io_handle,
+     libewf_offset_table_t *offset_table,
+     libewf_segment_table_t *segment_table,
+     libewf_header_sections_t *header_sections,
+     libewf_hash_sections_t *hash_sections,
+     libbfio_pool_t *file_io_pool,
+     liberror_error_t **error );
+
+int libewf_index_file_write(
+     libbfio_handle_t *file_io_handle,
+     libewf_offset_table_t *offset_table,
+     libewf_segment_table_t *segment_table,
+     libewf_header_sections_t *header_sections,
+     libewf_hash_sections_t *hash_sections,
+     libbfio_pool_t *file_io_pool,
+     liberror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif
+
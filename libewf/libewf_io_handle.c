@@ -87,9 +87,29 @@ int libewf_io_handle_initialize(
 
 			return( -1 );
 		}
-		( *io_handle )->format            = LIBEWF_FORMAT_UNKNOWN;
-		( *io_handle )->ewf_format        = EWF_FORMAT_UNKNOWN;
-		( *io_handle )->compression_level = EWF_COMPRESSION_UNKNOWN;
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( thread_mutex_initialize(
+		     &( ( *io_handle )->file_io_pool_mutex ) ) != 0 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize file io pool mutex.",
+			 function );
+
+			memory_free(
+			 *io_handle );
+
+			*io_handle = NULL;
+
+			return( -1 );
+		}
+#endif
+		( *io_handle )->format                    = LIBEWF_FORMAT_UNKNOWN;
+		( *io_handle )->ewf_format                = EWF_FORMAT_UNKNOWN;
+		( *io_handle )->compression_level         = EWF_COMPRESSION_UNKNOWN;
+		( *io_handle )->maximum_number_of_threads = 1;
 	}
 	return( 1 );
 }
@@ -132,6 +152,20 @@ int libewf_io_handle_free(
 
 			result = -1;
 		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( thread_mutex_free(
+		     &( ( *io_handle )->file_io_pool_mutex ) ) != 0 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file io pool mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
 		memory_free(
 		 *io_handle );
 
@@ -140,3 +174,77 @@ int libewf_io_handle_free(
 	return( result );
 }
 
+/* Grabs the file io pool for exclusive use by the calling thread
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_io_handle_grab_file_io_pool(
+     libewf_io_handle_t *io_handle,
+     liberror_error_t **error )
+{
+	static char *function = "libewf_io_handle_grab_file_io_pool";
+
+	if( io_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid io handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( thread_mutex_grab(
+	     &( io_handle->file_io_pool_mutex ) ) != 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab file io pool mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Releases the file io pool after it was grabbed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_io_handle_release_file_io_pool(
+     libewf_io_handle_t *io_handle,
+     liberror_error_t **error )
+{
+	static char *function = "libewf_io_handle_release_file_io_pool";
+
+	if( io_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid io handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( thread_mutex_release(
+	     &( io_handle->file_io_pool_mutex ) ) != 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release file io pool mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
@@ -24,11 +24,13 @@
 #define _LIBEWF_IO_HANDLE_H
 
 #include <common.h>
+#include <thread.h>
 #include <types.h>
 
 #include <liberror.h>
 
 #include "libewf_libbfio.h"
+#include "libewf_types.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -50,6 +52,12 @@ struct libewf_io_handle
 	 */
 	uint8_t pool_created_in_library;
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The mutex that serializes access to the file io pool
+	 */
+	thread_mutex_t file_io_pool_mutex;
+#endif
+
 	/* The current chunk
 	 */
 	uint32_t current_chunk;
@@ -74,6 +82,15 @@ struct libewf_io_handle
 	 * like empty block compression
 	 */
 	uint8_t compression_flags;
+
+	/* The maximum number of threads used to process chunks
+	 */
+	int maximum_number_of_threads;
+
+	/* The statistics
+	 * the file io values are maintained by the file io pool
+	 */
+	libewf_statistics_t statistics;
 };
 
 int libewf_io_handle_initialize(
@@ -84,6 +101,14 @@ int libewf_io_handle_free(
      libewf_io_handle_t **io_handle,
      liberror_error_t **error );
 
+int libewf_io_handle_grab_file_io_pool(
+     libewf_io_handle_t *io_handle,
+     liberror_error_t **error );
+
+int libewf_io_handle_release_file_io_pool(
+     libewf_io_handle_t *io_handle,
+     liberror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -508,6 +508,47 @@ ssize_t libewf_read_random(
 	return( read_count );
 }
 
+/* Determines if a range of the media data is empty
+ * The range is empty if the chunks it spans are known to contain zero bytes only
+ * Chunks that are not yet known to be empty are only read if their compressed size
+ * is small enough to be an empty block, hence uncompressed chunks are never empty
+ * This is not a full zero test, a range that is not empty can contain zero bytes only
+ * Returns 1 if the range is empty, 0 if not or -1 on error
+ */
+int libewf_is_empty_range(
+     libewf_handle_t *handle,
+     off64_t offset,
+     size64_t size )
+{
+	liberror_error_t *error = NULL;
+	static char *function   = "libewf_is_empty_range";
+	int result              = 0;
+
+	result = libewf_handle_is_empty_range(
+	          handle,
+	          offset,
+	          size,
+	          &error );
+
+	if( result == -1 )
+	{
+		liberror_error_set(
+		 &error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if range is empty.",
+		 function );
+
+		libnotify_print_error_backtrace(
+		 error );
+		liberror_error_free(
+		 &error );
+
+		return( -1 );
+	}
+	return( result );
+}
+
 /* Prepares a buffer with chunk data before writing according to the handle settings
  * intended for raw write
  * The buffer size cannot be larger than the chunk size
@@ -1148,6 +1189,72 @@ int libewf_set_delta_segment_file_size(
 	return( 1 );
 }
 
+/* Sets the maximum number of threads used to process chunks
+ * The value must be set before the first read or write
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_set_maximum_number_of_threads(
+     libewf_handle_t *handle,
+     int maximum_number_of_threads )
+{
+	liberror_error_t *error = NULL;
+	static char *function   = "libewf_set_maximum_number_of_threads";
+
+	if( libewf_handle_set_maximum_number_of_threads(
+	     handle,
+	     maximum_number_of_threads,
+	     &error ) != 1 )
+	{
+		liberror_error_set(
+		 &error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set maximum number of threads.",
+		 function );
+
+		libnotify_print_error_backtrace(
+		 error );
+		liberror_error_free(
+		 &error );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the statistics of the handle
+ * The size of the statistics must be set by the caller
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_get_statistics(
+     libewf_handle_t *handle,
+     libewf_statistics_t *statistics )
+{
+	liberror_error_t *error = NULL;
+	static char *function   = "libewf_get_statistics";
+
+	if( libewf_handle_get_statistics(
+	     handle,
+	     statistics,
+	     &error ) != 1 )
+	{
+		liberror_error_set(
+		 &error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve statistics.",
+		 function );
+
+		libnotify_print_error_backtrace(
+		 error );
+		liberror_error_free(
+		 &error );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
 /* Retrieves the amount of sectors per chunk from the media information
  * Returns 1 if successful or -1 on error
  */
@@ -103,6 +103,11 @@ LIBEWF_EXTERN ssize_t libewf_read_random(
                        size_t buffer_size,
                        off64_t offset );
 
+LIBEWF_EXTERN int libewf_is_empty_range(
+                   libewf_handle_t *handle,
+                   off64_t offset,
+                   size64_t size );
+
 LIBEWF_EXTERN ssize_t libewf_raw_write_prepare_buffer(
                        libewf_handle_t *handle,
                        void *buffer,
@@ -196,6 +201,14 @@ LIBEWF_EXTERN int libewf_set_delta_segment_file_size(
                    libewf_handle_t *handle,
                    size64_t delta_segment_file_size );
 
+LIBEWF_EXTERN int libewf_set_maximum_number_of_threads(
+                   libewf_handle_t *handle,
+                   int maximum_number_of_threads );
+
+LIBEWF_EXTERN int libewf_get_statistics(
+                   libewf_handle_t *handle,
+                   libewf_statistics_t *statistics );
+
 /* Meta data functions
  */
 LIBEWF_EXTERN int libewf_get_sectors_per_chunk(
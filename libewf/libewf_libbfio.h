@@ -29,9 +29,11 @@
  */
 #if defined( HAVE_LOCAL_LIBBFIO )
 
+#include <libbfio_async_file.h>
 #include <libbfio_definitions.h>
 #include <libbfio_file.h>
 #include <libbfio_handle.h>
+#include <libbfio_mmap_file.h>
 #include <libbfio_pool.h>
 #include <libbfio_types.h>
 
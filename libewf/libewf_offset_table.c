@@ -35,6 +35,7 @@
 #include "libewf_offset_table.h"
 #include "libewf_section_list.h"
 
+#include "ewf_crc.h"
 #include "ewf_definitions.h"
 #include "ewf_table.h"
 
@@ -185,6 +186,21 @@ int libewf_offset_table_free(
 			memory_free(
 			 ( *offset_table )->chunk_offset );
 		}
+		if( ( *offset_table )->segment_file_handles != NULL )
+		{
+			memory_free(
+			 ( *offset_table )->segment_file_handles );
+		}
+		if( ( *offset_table )->table_sections != NULL )
+		{
+			memory_free(
+			 ( *offset_table )->table_sections );
+		}
+		if( ( *offset_table )->wide_file_offsets != NULL )
+		{
+			memory_free(
+			 ( *offset_table )->wide_file_offsets );
+		}
 		memory_free(
 		 *offset_table );
 
@@ -267,33 +283,21 @@ int libewf_offset_table_resize(
 	return( 1 );
 }
 
-/* Fills the offset table from the table offsets
+/* Retrieves the index of a segment file handle in the offset table
+ * The segment file handle is added if not referenced by the offset table before
+ * The index is stored + 1, 0 indicates no segment file handle
  * Returns 1 if successful or -1 on error
  */
-int libewf_offset_table_fill(
+int libewf_offset_table_get_segment_file_index(
      libewf_offset_table_t *offset_table,
-     off64_t base_offset,
-     ewf_table_offset_t *offsets,
-     uint32_t amount_of_chunks,
      libewf_segment_file_handle_t *segment_file_handle,
-     uint8_t tainted,
+     uint16_t *segment_file_index,
      liberror_error_t **error )
 {
-#if defined( HAVE_VERBOSE_OUTPUT )
-	char *chunk_type                    = NULL;
-	char *remarks                       = NULL;
-#endif
-
-	libewf_chunk_offset_t *chunk_offset = NULL;
-	static char *function               = "libewf_offset_table_fill";
-	uint32_t chunk_size                 = 0;
-	uint32_t current_offset             = 0;
-	uint32_t next_offset                = 0;
-	uint32_t raw_offset                 = 0;
-	uint32_t offset_iterator            = 0;
-	uint8_t compressed                  = 0;
-	uint8_t corrupted                   = 0;
-	uint8_t overflow                    = 0;
+	void *reallocation               = NULL;
+	static char *function            = "libewf_offset_table_get_segment_file_index";
+	size_t segment_file_handles_size = 0;
+	uint16_t segment_file_iterator   = 0;
 
 	if( offset_table == NULL )
 	{
@@ -306,289 +310,255 @@ int libewf_offset_table_fill(
 
 		return( -1 );
 	}
-	if( base_offset < 0 )
+	if( segment_file_handle == NULL )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
-		 "%s: invalid base offset.",
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( offsets == NULL )
+	if( segment_file_index == NULL )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid offsets.",
+		 "%s: invalid segment file index.",
 		 function );
 
 		return( -1 );
 	}
-	if( segment_file_handle == NULL )
+	/* The chunk offsets are mostly set per segment file
+	 * so check the segment file handle that was last used first
+	 */
+	if( ( offset_table->last_segment_file_index > 0 )
+	 && ( offset_table->segment_file_handles[ offset_table->last_segment_file_index - 1 ] == segment_file_handle ) )
+	{
+		*segment_file_index = offset_table->last_segment_file_index;
+
+		return( 1 );
+	}
+	for( segment_file_iterator = 0;
+	     segment_file_iterator < offset_table->amount_of_segment_file_handles;
+	     segment_file_iterator++ )
+	{
+		if( offset_table->segment_file_handles[ segment_file_iterator ] == segment_file_handle )
+		{
+			offset_table->last_segment_file_index = segment_file_iterator + 1;
+
+			*segment_file_index = offset_table->last_segment_file_index;
+
+			return( 1 );
+		}
+	}
+	if( offset_table->amount_of_segment_file_handles >= (uint16_t) ( UINT16_MAX - 1 ) )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid amount of segment file handles value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	segment_file_handles_size = sizeof( libewf_segment_file_handle_t * )
+	                          * ( offset_table->amount_of_segment_file_handles + 1 );
+
+	reallocation = memory_reallocate(
+	                offset_table->segment_file_handles,
+	                segment_file_handles_size );
+
+	if( reallocation == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_MEMORY,
+		 LIBERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to resize segment file handles.",
+		 function );
+
+		return( -1 );
+	}
+	offset_table->segment_file_handles = (libewf_segment_file_handle_t **) reallocation;
+
+	offset_table->segment_file_handles[ offset_table->amount_of_segment_file_handles ] = segment_file_handle;
+
+	offset_table->amount_of_segment_file_handles += 1;
+	offset_table->last_segment_file_index         = offset_table->amount_of_segment_file_handles;
+
+	*segment_file_index = offset_table->last_segment_file_index;
+
+	return( 1 );
+}
+
+/* Sets the file offset of a chunk offset
+ * File offsets that are too large to be stored packed are stored in the wide file offsets
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_offset_table_set_chunk_file_offset(
+     libewf_offset_table_t *offset_table,
+     libewf_chunk_offset_t *chunk_offset,
+     off64_t file_offset,
+     liberror_error_t **error )
+{
+	void *reallocation                   = NULL;
+	static char *function                = "libewf_offset_table_set_chunk_file_offset";
+	off64_t wide_file_offset_index       = 0;
+	size_t wide_file_offsets_size        = 0;
+	uint32_t amount_of_wide_file_offsets = 0;
+
+	if( offset_table == NULL )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid segment file.",
+		 "%s: invalid offset table.",
 		 function );
 
 		return( -1 );
 	}
-	/* Allocate additional entries in the offset table if needed
-	 * - a single reallocation saves processing time
+	if( chunk_offset == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_offset < 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid file offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_offset <= LIBEWF_CHUNK_OFFSET_MAXIMUM_PACKED_FILE_OFFSET )
+	{
+		libewf_chunk_offset_set_packed_file_offset(
+		 chunk_offset,
+		 file_offset );
+
+		chunk_offset->flags &= ~( LIBEWF_CHUNK_OFFSET_FLAGS_WIDE_FILE_OFFSET );
+
+		return( 1 );
+	}
+	/* A chunk offset that already refers to a wide file offset reuses it
 	 */
-	if( offset_table->amount_of_chunk_offsets < ( offset_table->last_chunk_offset_filled + amount_of_chunks ) )
+	if( ( chunk_offset->flags & LIBEWF_CHUNK_OFFSET_FLAGS_WIDE_FILE_OFFSET ) != 0 )
 	{
-		if( libewf_offset_table_resize(
-		     offset_table,
-		     offset_table->last_chunk_offset_filled + amount_of_chunks,
-		     error ) != 1 )
+		wide_file_offset_index = libewf_chunk_offset_get_packed_file_offset(
+		                          chunk_offset );
+
+		if( wide_file_offset_index >= (off64_t) offset_table->amount_of_wide_file_offsets )
 		{
 			liberror_error_set(
 			 error,
 			 LIBERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBERROR_RUNTIME_ERROR_RESIZE_FAILED,
-			 "%s: unable to resize offset table.",
+			 LIBERROR_RUNTIME_ERROR_VALUE_OUT_OF_RANGE,
+			 "%s: invalid wide file offset index value out of range.",
 			 function );
 
 			return( -1 );
 		}
-	}
-	byte_stream_copy_to_uint32_little_endian(
-	 offsets[ offset_iterator ].offset,
-	 raw_offset );
+		offset_table->wide_file_offsets[ wide_file_offset_index ] = file_offset;
 
-	/* The size of the last chunk must be determined differently
-	 */
-	while( offset_iterator < ( amount_of_chunks - 1 ) )
+		return( 1 );
+	}
+	if( offset_table->amount_of_wide_file_offsets >= offset_table->amount_of_allocated_wide_file_offsets )
 	{
-		if( overflow == 0 )
-		{
-			compressed     = (uint8_t) ( raw_offset >> 31 );
-			current_offset = raw_offset & EWF_OFFSET_COMPRESSED_READ_MASK;
-		}
-		else
+		/* Double the amount of allocated wide file offsets to reduce the amount of reallocations
+		 */
+		if( offset_table->amount_of_allocated_wide_file_offsets == 0 )
 		{
-			current_offset = raw_offset;
+			amount_of_wide_file_offsets = 1024;
 		}
-		byte_stream_copy_to_uint32_little_endian(
-		 offsets[ offset_iterator + 1 ].offset,
-		 raw_offset );
-
-		if( overflow == 0 )
+		else if( offset_table->amount_of_allocated_wide_file_offsets < ( UINT32_MAX / 2 ) )
 		{
-			next_offset = raw_offset & EWF_OFFSET_COMPRESSED_READ_MASK;
+			amount_of_wide_file_offsets = offset_table->amount_of_allocated_wide_file_offsets * 2;
 		}
 		else
 		{
-			next_offset = raw_offset;
-		}
-		corrupted = 0;
-
-		/* This is to compensate for the crappy >2Gb segment file
-		 * solution in EnCase 6.7
-		 */
-		if( next_offset < current_offset )
-		{
-			if( raw_offset < current_offset )
-			{
-#if defined( HAVE_VERBOSE_OUTPUT )
-				libnotify_verbose_printf(
-				 "%s: chunk offset %" PRIu32 " larger than raw %" PRIu32 ".\n",
-				 function,
-				 current_offset,
-				 raw_offset );
-#endif
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid amount of wide file offsets value exceeds maximum.",
+			 function );
 
-				corrupted = 1;
-			}
-#if defined( HAVE_VERBOSE_OUTPUT )
-			else
-			{
-				libnotify_verbose_printf(
-				 "%s: chunk offset %" PRIu32 " larger than next %" PRIu32 ".\n",
-				 function,
-				 current_offset,
-				 next_offset );
-			}
-#endif
-			chunk_size = raw_offset - current_offset;
-		}
-		else
-		{
-			chunk_size = next_offset - current_offset;
+			return( -1 );
 		}
-		if( chunk_size == 0 )
+		wide_file_offsets_size = sizeof( off64_t ) * amount_of_wide_file_offsets;
+
+		if( wide_file_offsets_size > (size_t) SSIZE_MAX )
 		{
-			libnotify_verbose_printf(
-			 "%s: invalid chunk size value is zero.\n",
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid wide file offsets size value exceeds maximum.",
 			 function );
 
-			corrupted = 1;
+			return( -1 );
 		}
-		if( chunk_size > (uint32_t) INT32_MAX )
+		reallocation = memory_reallocate(
+		                offset_table->wide_file_offsets,
+		                wide_file_offsets_size );
+
+		if( reallocation == NULL )
 		{
-			libnotify_verbose_printf(
-			 "%s: invalid chunk size value exceeds maximum.\n",
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_MEMORY,
+			 LIBERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize wide file offsets.",
 			 function );
 
-			corrupted = 1;
-		}
-#if defined( HAVE_VERBOSE_OUTPUT )
-		if( compressed == 0 )
-		{
-			chunk_type = "uncompressed";
-		}
-		else
-		{
-			chunk_type = "compressed";
-		}
-		if( corrupted != 0 )
-		{
-			remarks = " corrupted";
-		}
-		else if( tainted != 0 )
-		{
-			remarks = " tainted";
-		}
-		else
-		{
-			remarks = "";
+			return( -1 );
 		}
-		libnotify_verbose_printf(
-		 "%s: %s chunk %" PRIu32 " read with: base %" PRIu64 ", offset %" PRIu32 " and size %" PRIu32 "%s.\n",
-		 function,
-		 chunk_type,
-		 offset_table->last_chunk_offset_filled,
-		 base_offset,
-		 current_offset,
-		 chunk_size,
-		 remarks );
-#endif
+		offset_table->wide_file_offsets                     = (off64_t *) reallocation;
+		offset_table->amount_of_allocated_wide_file_offsets = amount_of_wide_file_offsets;
+	}
+	offset_table->wide_file_offsets[ offset_table->amount_of_wide_file_offsets ] = file_offset;
 
-		chunk_offset = &( offset_table->chunk_offset[ offset_table->last_chunk_offset_filled ] );
+	libewf_chunk_offset_set_packed_file_offset(
+	 chunk_offset,
+	 offset_table->amount_of_wide_file_offsets );
 
-		chunk_offset->segment_file_handle = segment_file_handle;
-		chunk_offset->file_offset         = (off64_t) ( base_offset + current_offset );
-		chunk_offset->size                = (size_t) chunk_size;
-		chunk_offset->flags              |= compressed;
+	chunk_offset->flags |= LIBEWF_CHUNK_OFFSET_FLAGS_WIDE_FILE_OFFSET;
 
-		if( corrupted != 0 )
-		{
-			chunk_offset->flags |= LIBEWF_CHUNK_OFFSET_FLAGS_CORRUPTED;
-		}
-		else if( tainted != 0 )
-		{
-			chunk_offset->flags |= LIBEWF_CHUNK_OFFSET_FLAGS_TAINTED;
-		}
-		offset_table->last_chunk_offset_filled++;
+	offset_table->amount_of_wide_file_offsets += 1;
 
-		/* This is to compensate for the crappy >2Gb segment file
-		 * solution in EnCase 6.7
-		 */
-		if( ( overflow == 0 )
-		 && ( ( current_offset + chunk_size ) > (uint32_t) INT32_MAX ) )
-		{
-#if defined( HAVE_VERBOSE_OUTPUT )
-			libnotify_verbose_printf(
-			 "%s: chunk offset overflow at: %" PRIu32 ".\n",
-			 function,
-			 current_offset );
-#endif
+	return( 1 );
+}
 
-			overflow   = 1;
-			compressed = 0;
-		}
-		offset_iterator++;
-	}
-	byte_stream_copy_to_uint32_little_endian(
-	 offsets[ offset_iterator ].offset,
-	 raw_offset );
-
-	if( overflow == 0 )
-	{
-		compressed     = (uint8_t) ( raw_offset >> 31 );
-		current_offset = raw_offset & EWF_OFFSET_COMPRESSED_READ_MASK;
-	}
-	else
-	{
-		current_offset = raw_offset;
-	}
-	corrupted = 0;
-
-#if defined( HAVE_VERBOSE_OUTPUT )
-	if( compressed == 0 )
-	{
-		chunk_type = "uncompressed";
-	}
-	else
-	{
-		chunk_type = "compressed";
-	}
-	if( corrupted != 0 )
-	{
-		remarks = " corrupted";
-	}
-	else if( tainted != 0 )
-	{
-		remarks = " tainted";
-	}
-	else
-	{
-		remarks = "";
-	}
-	libnotify_verbose_printf(
-	 "%s: %s last chunk %" PRIu32 " read with: base %" PRIu64 " and offset %" PRIu32 "%s.\n",
-	 function,
-	 chunk_type,
-	 offset_table->last_chunk_offset_filled,
-	 base_offset,
-	 current_offset,
-	 remarks );
-#endif
-
-	chunk_offset = &( offset_table->chunk_offset[ offset_table->last_chunk_offset_filled ] );
-
-	chunk_offset->segment_file_handle = segment_file_handle;
-	chunk_offset->file_offset         = (off64_t) ( base_offset + current_offset );
-	chunk_offset->flags              |= compressed;
-
-	if( corrupted != 0 )
-	{
-		chunk_offset->flags |= LIBEWF_CHUNK_OFFSET_FLAGS_CORRUPTED;
-	}
-	else if( tainted != 0 )
-	{
-		chunk_offset->flags |= LIBEWF_CHUNK_OFFSET_FLAGS_TAINTED;
-	}
-	return( 1 );
-}
-
-/* Calculate the last offset and fills the offset table
+/* Retrieves the values of a specific chunk offset
+ * The segment file handle is set to NULL if the chunk offset is not set
  * Returns 1 if successful or -1 on error
  */
-int libewf_offset_table_fill_last_offset(
+int libewf_offset_table_get_chunk_offset(
      libewf_offset_table_t *offset_table,
-     libewf_list_t *section_list,
-     uint8_t tainted,
+     uint32_t chunk,
+     libewf_segment_file_handle_t **segment_file_handle,
+     off64_t *file_offset,
+     size_t *size,
+     uint8_t *flags,
      liberror_error_t **error )
 {
-#if defined( HAVE_VERBOSE_OUTPUT )
-	char *remarks                                     = NULL;
-#endif
-
-	libewf_chunk_offset_t *chunk_offset               = NULL;
-	libewf_list_element_t *list_element               = NULL;
-	libewf_section_list_values_t *section_list_values = NULL;
-	static char *function                             = "libewf_offset_table_fill_last_offset";
-	off64_t last_offset                               = 0;
-	off64_t chunk_size                                = 0;
-	uint8_t corrupted                                 = 0;
+	libewf_chunk_offset_t *chunk_offset = NULL;
+	static char *function               = "libewf_offset_table_get_chunk_offset";
 
 	if( offset_table == NULL )
 	{
@@ -612,145 +582,107 @@ int libewf_offset_table_fill_last_offset(
 
 		return( -1 );
 	}
-	if( section_list == NULL )
+	if( chunk >= offset_table->amount_of_chunk_offsets )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_OUT_OF_RANGE,
+		 "%s: chunk: %" PRIu32 " out of range [0,%" PRIu32 "].",
+		 function,
+		 chunk,
+		 offset_table->amount_of_chunk_offsets - 1 );
+
+		return( -1 );
+	}
+	if( segment_file_handle == NULL )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid section list.",
+		 "%s: invalid segment file handle.",
 		 function );
 
 		return( -1 );
 	}
-	/* There is no indication how large the last chunk is. The only thing known is where it starts.
-	 * However it can be determined where the next section starts within the file.
-	 * The size of the last chunk is determined by subtracting the last offset from the offset of the section that follows.
-	 */
-	list_element = section_list->first;
-	chunk_offset = &( offset_table->chunk_offset[ offset_table->last_chunk_offset_filled ] );
-	last_offset  = chunk_offset->file_offset;
-
-	while( list_element != NULL )
+	if( file_offset == NULL )
 	{
-		section_list_values = (libewf_section_list_values_t *) list_element->value;
-
-		if( section_list_values == NULL )
-		{
-			liberror_error_set(
-			 error,
-			 LIBERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: invalid section list values.",
-			 function );
-
-			return( -1 );
-		}
-#if defined( HAVE_DEBUG_OUTPUT )
-		libnotify_verbose_printf(
-		 "%s: start offset: %" PRIi64 " last offset: %" PRIi64 " \n",
-		 function,
-		 section_list_values->start_offset,
-		 last_offset );
-#endif
-
-		if( ( section_list_values->start_offset < last_offset )
-		 && ( last_offset < section_list_values->end_offset ) )
-		{
-			chunk_size = section_list_values->end_offset - last_offset;
-
-			if( last_offset > (off64_t) INT64_MAX )
-			{
-				liberror_error_set(
-				 error,
-				 LIBERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-				 "%s: invalid last chunk offset value exceeds maximum.",
-				 function );
-
-				return( -1 );
-			}
-			corrupted = 0;
-
-			if( chunk_size == 0 )
-			{
-#if defined( HAVE_VERBOSE_OUTPUT )
-				libnotify_verbose_printf(
-				 "%s: invalid chunk size value is zero.\n",
-				 function );
-#endif
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file offset.",
+		 function );
 
-				corrupted = 1;
-			}
-			if( chunk_size > (off64_t) INT32_MAX )
-			{
-#if defined( HAVE_VERBOSE_OUTPUT )
-				libnotify_verbose_printf(
-				 "%s: invalid chunk size value exceeds maximum.\n",
-				 function );
-#endif
+		return( -1 );
+	}
+	if( size == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size.",
+		 function );
 
-				corrupted = 1;
-			}
-#if defined( HAVE_VERBOSE_OUTPUT )
-			if( corrupted != 0 )
-			{
-				remarks = " corrupted";
-			}
-			else if( tainted != 0 )
-			{
-				remarks = " tainted";
-			}
-			else
-			{
-				remarks = "";
-			}
-			libnotify_verbose_printf(
-			 "%s: last chunk %" PRIu32 " calculated with offset: %" PRIu64 " and size %" PRIzu "%s.\n",
-			 function,
-			 offset_table->last_chunk_offset_filled,
-			 last_offset,
-			 (size_t) chunk_size,
-			 remarks );
-#endif
+		return( -1 );
+	}
+	if( flags == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid flags.",
+		 function );
 
-			chunk_offset->size = (size_t) chunk_size;
+		return( -1 );
+	}
+	chunk_offset = &( offset_table->chunk_offset[ chunk ] );
 
-			if( corrupted != 0 )
-			{
-				chunk_offset->flags |= LIBEWF_CHUNK_OFFSET_FLAGS_CORRUPTED;
-			}
-			else if( tainted != 0 )
-			{
-				chunk_offset->flags |= LIBEWF_CHUNK_OFFSET_FLAGS_TAINTED;
-			}
-			offset_table->last_chunk_offset_filled++;
+	if( chunk_offset->segment_file_index == 0 )
+	{
+		*segment_file_handle = NULL;
+	}
+	else if( chunk_offset->segment_file_index <= offset_table->amount_of_segment_file_handles )
+	{
+		*segment_file_handle = offset_table->segment_file_handles[ chunk_offset->segment_file_index - 1 ];
+	}
+	else
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_OUT_OF_RANGE,
+		 "%s: invalid segment file index for chunk: %" PRIu32 " value out of range.",
+		 function,
+		 chunk );
 
-			break;
-		}
-		list_element = list_element->next;
+		return( -1 );
 	}
+	*file_offset = libewf_offset_table_get_chunk_file_offset( offset_table, chunk_offset );
+	*size        = (size_t) chunk_offset->size;
+	*flags       = chunk_offset->flags & ~( LIBEWF_CHUNK_OFFSET_FLAGS_WIDE_FILE_OFFSET );
+
 	return( 1 );
 }
 
-/* Fills the offsets from the offset table
- * amount_of_chunk_offsets contains the amount of chunk offsets to fill
+/* Sets the values of a specific chunk offset
  * Returns 1 if successful or -1 on error
  */
-int libewf_offset_table_fill_offsets(
+int libewf_offset_table_set_chunk_offset(
      libewf_offset_table_t *offset_table,
-     uint32_t offset_table_index,
-     uint32_t amount_of_chunk_offsets,
-     off64_t base_offset,
-     ewf_table_offset_t *offsets,
-     uint32_t amount_of_offsets,
+     uint32_t chunk,
+     libewf_segment_file_handle_t *segment_file_handle,
+     off64_t file_offset,
+     size_t size,
+     uint8_t flags,
      liberror_error_t **error )
 {
 	libewf_chunk_offset_t *chunk_offset = NULL;
-	static char *function               = "libewf_offset_table_fill_offsets";
-	off64_t offset64_value              = 0;
-	uint32_t offset32_value             = 0;
-	uint32_t offset_iterator            = 0;
+	static char *function               = "libewf_offset_table_set_chunk_offset";
+	uint16_t segment_file_index         = 0;
 
 	if( offset_table == NULL )
 	{
@@ -774,75 +706,140 @@ int libewf_offset_table_fill_offsets(
 
 		return( -1 );
 	}
-	if( base_offset < 0 )
+	if( chunk >= offset_table->amount_of_chunk_offsets )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
-		 "%s: invalid base offset.",
-		 function );
+		 LIBERROR_ARGUMENT_ERROR_VALUE_OUT_OF_RANGE,
+		 "%s: chunk: %" PRIu32 " out of range [0,%" PRIu32 "].",
+		 function,
+		 chunk,
+		 offset_table->amount_of_chunk_offsets - 1 );
 
 		return( -1 );
 	}
-	if( offsets == NULL )
+	if( file_offset < 0 )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid table offsets.",
+		 LIBERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid file offset value less than zero.",
 		 function );
 
 		return( -1 );
 	}
-	if( amount_of_offsets < amount_of_chunk_offsets )
+	if( size > LIBEWF_CHUNK_OFFSET_MAXIMUM_SIZE )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
-		 "%s: amount of offsets too small.",
+		 LIBERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
 		 function );
 
 		return( -1 );
 	}
-	for( offset_iterator = 0;
-	     offset_iterator < amount_of_chunk_offsets;
-	     offset_iterator++ )
+	if( ( segment_file_handle != NULL )
+	 && ( libewf_offset_table_get_segment_file_index(
+	       offset_table,
+	       segment_file_handle,
+	       &segment_file_index,
+	       error ) != 1 ) )
 	{
-		chunk_offset   = &( offset_table->chunk_offset[ offset_table_index + offset_iterator ] );
-		offset64_value = chunk_offset->file_offset - base_offset;
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment file index.",
+		 function );
 
-		if( ( offset64_value < 0 )
-		 || ( offset64_value > (off64_t) INT32_MAX ) )
-		{
-			liberror_error_set(
-			 error,
-			 LIBERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-			 "%s: invalid chunk offset value.",
-			 function );
+		return( -1 );
+	}
+	chunk_offset = &( offset_table->chunk_offset[ chunk ] );
 
-			return( -1 );
-		}
-		offset32_value = (uint32_t) offset64_value;
+	/* The wide file offset flag is maintained when the file offset is set
+	 */
+	chunk_offset->segment_file_index = segment_file_index;
+	chunk_offset->size               = (uint32_t) size;
+	chunk_offset->flags              = ( chunk_offset->flags & LIBEWF_CHUNK_OFFSET_FLAGS_WIDE_FILE_OFFSET )
+	                                 | ( flags & ~( LIBEWF_CHUNK_OFFSET_FLAGS_WIDE_FILE_OFFSET ) );
+
+	if( libewf_offset_table_set_chunk_file_offset(
+	     offset_table,
+	     chunk_offset,
+	     file_offset,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set file offset of chunk: %" PRIu32 ".",
+		 function,
+		 chunk );
 
-		if( ( chunk_offset->flags & LIBEWF_CHUNK_OFFSET_FLAGS_COMPRESSED ) == LIBEWF_CHUNK_OFFSET_FLAGS_COMPRESSED )
-		{
-			offset32_value |= EWF_OFFSET_COMPRESSED_WRITE_MASK;
-		}
-		byte_stream_copy_from_uint32_little_endian(
-		 offsets[ offset_iterator ].offset,
-		 offset32_value );
+		return( -1 );
 	}
 	return( 1 );
 }
 
-/* Compares the offsets with the ones in the offset table and makes corrections if necessary
+/* Sets additional flags of a specific chunk offset
  * Returns 1 if successful or -1 on error
  */
-int libewf_offset_table_compare(
+int libewf_offset_table_set_chunk_flags(
+     libewf_offset_table_t *offset_table,
+     uint32_t chunk,
+     uint8_t flags,
+     liberror_error_t **error )
+{
+	static char *function = "libewf_offset_table_set_chunk_flags";
+
+	if( offset_table == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset table.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset_table->chunk_offset == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid offset table - missing chunk offsets.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk >= offset_table->amount_of_chunk_offsets )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_OUT_OF_RANGE,
+		 "%s: chunk: %" PRIu32 " out of range [0,%" PRIu32 "].",
+		 function,
+		 chunk,
+		 offset_table->amount_of_chunk_offsets - 1 );
+
+		return( -1 );
+	}
+	offset_table->chunk_offset[ chunk ].flags |= flags & ~( LIBEWF_CHUNK_OFFSET_FLAGS_WIDE_FILE_OFFSET );
+
+	return( 1 );
+}
+
+/* Fills the offset table from the table offsets
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_offset_table_fill(
      libewf_offset_table_t *offset_table,
      off64_t base_offset,
      ewf_table_offset_t *offsets,
@@ -857,15 +854,15 @@ int libewf_offset_table_compare(
 #endif
 
 	libewf_chunk_offset_t *chunk_offset = NULL;
-	static char *function               = "libewf_offset_table_compare";
+	static char *function               = "libewf_offset_table_fill";
 	uint32_t chunk_size                 = 0;
+	uint16_t segment_file_index         = 0;
 	uint32_t current_offset             = 0;
 	uint32_t next_offset                = 0;
 	uint32_t raw_offset                 = 0;
 	uint32_t offset_iterator            = 0;
 	uint8_t compressed                  = 0;
 	uint8_t corrupted                   = 0;
-	uint8_t mismatch                    = 0;
 	uint8_t overflow                    = 0;
 
 	if( offset_table == NULL )
@@ -915,17 +912,34 @@ int libewf_offset_table_compare(
 	/* Allocate additional entries in the offset table if needed
 	 * - a single reallocation saves processing time
 	 */
-	if( ( offset_table->amount_of_chunk_offsets < ( offset_table->last_chunk_offset_compared + amount_of_chunks ) )
-	 && ( libewf_offset_table_resize(
-	       offset_table,
-	       offset_table->last_chunk_offset_compared + amount_of_chunks,
-	       error ) != 1 ) )
+	if( offset_table->amount_of_chunk_offsets < ( offset_table->last_chunk_offset_filled + amount_of_chunks ) )
+	{
+		if( libewf_offset_table_resize(
+		     offset_table,
+		     offset_table->last_chunk_offset_filled + amount_of_chunks,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to resize offset table.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( libewf_offset_table_get_segment_file_index(
+	     offset_table,
+	     segment_file_handle,
+	     &segment_file_index,
+	     error ) != 1 )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBERROR_RUNTIME_ERROR_RESIZE_FAILED,
-		 "%s: unable to resize offset table.",
+		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment file index.",
 		 function );
 
 		return( -1 );
@@ -988,73 +1002,28 @@ int libewf_offset_table_compare(
 				 next_offset );
 			}
 #endif
-
 			chunk_size = raw_offset - current_offset;
 		}
 		else
 		{
 			chunk_size = next_offset - current_offset;
 		}
-
 		if( chunk_size == 0 )
 		{
-#if defined( HAVE_VERBOSE_OUTPUT )
 			libnotify_verbose_printf(
-			 "%s: invalid chunk size - size is zero.\n",
+			 "%s: invalid chunk size value is zero.\n",
 			 function );
-#endif
 
 			corrupted = 1;
 		}
 		if( chunk_size > (uint32_t) INT32_MAX )
 		{
-#if defined( HAVE_VERBOSE_OUTPUT )
 			libnotify_verbose_printf(
 			 "%s: invalid chunk size value exceeds maximum.\n",
 			 function );
-#endif
 
 			corrupted = 1;
 		}
-		chunk_offset = &( offset_table->chunk_offset[ offset_table->last_chunk_offset_compared ] );
-
-		if( chunk_offset->file_offset != (off64_t) ( base_offset + current_offset ) )
-		{
-#if defined( HAVE_VERBOSE_OUTPUT )
-			libnotify_verbose_printf(
-			 "%s: file offset mismatch for chunk offset: %" PRIu32 ".\n",
-			 function,
-			 offset_table->last_chunk_offset_compared );
-#endif
-
-			mismatch = 1;
-		}
-		else if( chunk_offset->size != (size_t) chunk_size )
-		{
-#if defined( HAVE_VERBOSE_OUTPUT )
-			libnotify_verbose_printf(
-			 "%s: chunk size mismatch for chunk offset: %" PRIu32 ".\n",
-			 function,
-			 offset_table->last_chunk_offset_compared );
-#endif
-
-			mismatch = 1;
-		}
-		else if( ( chunk_offset->flags & LIBEWF_CHUNK_OFFSET_FLAGS_COMPRESSED ) != compressed )
-		{
-#if defined( HAVE_VERBOSE_OUTPUT )
-			libnotify_verbose_printf(
-			 "%s: compressed mismatch for chunk offset: %" PRIu32 ".\n",
-			 function,
-			 offset_table->last_chunk_offset_compared );
-#endif
-
-			mismatch = 1;
-		}
-		else
-		{
-			mismatch = 0;
-		}
 #if defined( HAVE_VERBOSE_OUTPUT )
 		if( compressed == 0 )
 		{
@@ -1072,10 +1041,6 @@ int libewf_offset_table_compare(
 		{
 			remarks = " tainted";
 		}
-		else if( mismatch == 1 )
-		{
-			remarks = " corrected";
-		}
 		else
 		{
 			remarks = "";
@@ -1084,24 +1049,44 @@ int libewf_offset_table_compare(
 		 "%s: %s chunk %" PRIu32 " read with: base %" PRIu64 ", offset %" PRIu32 " and size %" PRIu32 "%s.\n",
 		 function,
 		 chunk_type,
-		 offset_table->last_chunk_offset_compared,
+		 offset_table->last_chunk_offset_filled,
 		 base_offset,
 		 current_offset,
 		 chunk_size,
 		 remarks );
 #endif
 
-		if( ( corrupted == 0 )
-		 && ( tainted == 0 )
-		 && ( mismatch == 1 ) )
+		chunk_offset = &( offset_table->chunk_offset[ offset_table->last_chunk_offset_filled ] );
+
+		if( libewf_offset_table_set_chunk_file_offset(
+		     offset_table,
+		     chunk_offset,
+		     base_offset + current_offset,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set chunk file offset.",
+			 function );
+
+			return( -1 );
+		}
+
+		chunk_offset->segment_file_index = segment_file_index;
+		chunk_offset->size               = chunk_size;
+		chunk_offset->flags             |= compressed;
+
+		if( corrupted != 0 )
 		{
-			chunk_offset->segment_file_handle = segment_file_handle;
-			chunk_offset->file_offset         = (off64_t) ( base_offset + current_offset );
-			chunk_offset->size                = (size_t) chunk_size;
-			chunk_offset->flags              |= compressed;
-			chunk_offset->flags              &= ~ ( LIBEWF_CHUNK_OFFSET_FLAGS_TAINTED | LIBEWF_CHUNK_OFFSET_FLAGS_CORRUPTED ) ;
+			chunk_offset->flags |= LIBEWF_CHUNK_OFFSET_FLAGS_CORRUPTED;
 		}
-		offset_table->last_chunk_offset_compared++;
+		else if( tainted != 0 )
+		{
+			chunk_offset->flags |= LIBEWF_CHUNK_OFFSET_FLAGS_TAINTED;
+		}
+		offset_table->last_chunk_offset_filled++;
 
 		/* This is to compensate for the crappy >2Gb segment file
 		 * solution in EnCase 6.7
@@ -1136,102 +1121,1214 @@ int libewf_offset_table_compare(
 	}
 	corrupted = 0;
 
-	chunk_offset = &( offset_table->chunk_offset[ offset_table->last_chunk_offset_compared ] );
-
-	if( chunk_offset->file_offset != (off64_t) ( base_offset + current_offset ) )
-	{
 #if defined( HAVE_VERBOSE_OUTPUT )
-		libnotify_verbose_printf(
-		 "%s: file offset mismatch for chunk offset: %" PRIu32 ".\n",
-		 function,
-		 offset_table->last_chunk_offset_compared );
-#endif
-
-		mismatch = 1;
-	}
-	else if( ( chunk_offset->flags & LIBEWF_CHUNK_OFFSET_FLAGS_COMPRESSED ) != compressed )
+	if( compressed == 0 )
 	{
-#if defined( HAVE_VERBOSE_OUTPUT )
-		libnotify_verbose_printf(
-		 "%s: compressed mismatch for chunk offset: %" PRIu32 ".\n",
-		 function,
-		 offset_table->last_chunk_offset_compared );
-#endif
-
-		mismatch = 1;
+		chunk_type = "uncompressed";
 	}
 	else
 	{
-		mismatch = 0;
+		chunk_type = "compressed";
 	}
-#if defined( HAVE_VERBOSE_OUTPUT )
-	if( compressed == 0 )
+	if( corrupted != 0 )
 	{
-		chunk_type = "uncompressed";
+		remarks = " corrupted";
+	}
+	else if( tainted != 0 )
+	{
+		remarks = " tainted";
 	}
 	else
 	{
-		chunk_type = "compressed";
+		remarks = "";
+	}
+	libnotify_verbose_printf(
+	 "%s: %s last chunk %" PRIu32 " read with: base %" PRIu64 " and offset %" PRIu32 "%s.\n",
+	 function,
+	 chunk_type,
+	 offset_table->last_chunk_offset_filled,
+	 base_offset,
+	 current_offset,
+	 remarks );
+#endif
+
+	chunk_offset = &( offset_table->chunk_offset[ offset_table->last_chunk_offset_filled ] );
+
+	if( libewf_offset_table_set_chunk_file_offset(
+	     offset_table,
+	     chunk_offset,
+	     base_offset + current_offset,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set chunk file offset.",
+		 function );
+
+		return( -1 );
 	}
+
+	chunk_offset->segment_file_index = segment_file_index;
+	chunk_offset->flags             |= compressed;
+
 	if( corrupted != 0 )
 	{
-		remarks = " corrupted";
+		chunk_offset->flags |= LIBEWF_CHUNK_OFFSET_FLAGS_CORRUPTED;
+	}
+	else if( tainted != 0 )
+	{
+		chunk_offset->flags |= LIBEWF_CHUNK_OFFSET_FLAGS_TAINTED;
+	}
+	return( 1 );
+}
+
+/* Calculate the last offset and fills the offset table
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_offset_table_fill_last_offset(
+     libewf_offset_table_t *offset_table,
+     libewf_list_t *section_list,
+     uint8_t tainted,
+     liberror_error_t **error )
+{
+#if defined( HAVE_VERBOSE_OUTPUT )
+	char *remarks                                     = NULL;
+#endif
+
+	libewf_chunk_offset_t *chunk_offset               = NULL;
+	libewf_list_element_t *list_element               = NULL;
+	libewf_section_list_values_t *section_list_values = NULL;
+	static char *function                             = "libewf_offset_table_fill_last_offset";
+	off64_t last_offset                               = 0;
+	off64_t chunk_size                                = 0;
+	uint8_t corrupted                                 = 0;
+
+	if( offset_table == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset table.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset_table->chunk_offset == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid offset table - missing chunk offsets.",
+		 function );
+
+		return( -1 );
+	}
+	if( section_list == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid section list.",
+		 function );
+
+		return( -1 );
+	}
+	/* There is no indication how large the last chunk is. The only thing known is where it starts.
+	 * However it can be determined where the next section starts within the file.
+	 * The size of the last chunk is determined by subtracting the last offset from the offset of the section that follows.
+	 */
+	list_element = section_list->first;
+	chunk_offset = &( offset_table->chunk_offset[ offset_table->last_chunk_offset_filled ] );
+	last_offset  = libewf_offset_table_get_chunk_file_offset( offset_table, chunk_offset );
+
+	while( list_element != NULL )
+	{
+		section_list_values = (libewf_section_list_values_t *) list_element->value;
+
+		if( section_list_values == NULL )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid section list values.",
+			 function );
+
+			return( -1 );
+		}
+#if defined( HAVE_DEBUG_OUTPUT )
+		libnotify_verbose_printf(
+		 "%s: start offset: %" PRIi64 " last offset: %" PRIi64 " \n",
+		 function,
+		 section_list_values->start_offset,
+		 last_offset );
+#endif
+
+		if( ( section_list_values->start_offset < last_offset )
+		 && ( last_offset < section_list_values->end_offset ) )
+		{
+			chunk_size = section_list_values->end_offset - last_offset;
+
+			if( last_offset > (off64_t) INT64_MAX )
+			{
+				liberror_error_set(
+				 error,
+				 LIBERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+				 "%s: invalid last chunk offset value exceeds maximum.",
+				 function );
+
+				return( -1 );
+			}
+			corrupted = 0;
+
+			if( chunk_size == 0 )
+			{
+#if defined( HAVE_VERBOSE_OUTPUT )
+				libnotify_verbose_printf(
+				 "%s: invalid chunk size value is zero.\n",
+				 function );
+#endif
+
+				corrupted = 1;
+			}
+			if( chunk_size > (off64_t) INT32_MAX )
+			{
+#if defined( HAVE_VERBOSE_OUTPUT )
+				libnotify_verbose_printf(
+				 "%s: invalid chunk size value exceeds maximum.\n",
+				 function );
+#endif
+
+				corrupted = 1;
+			}
+#if defined( HAVE_VERBOSE_OUTPUT )
+			if( corrupted != 0 )
+			{
+				remarks = " corrupted";
+			}
+			else if( tainted != 0 )
+			{
+				remarks = " tainted";
+			}
+			else
+			{
+				remarks = "";
+			}
+			libnotify_verbose_printf(
+			 "%s: last chunk %" PRIu32 " calculated with offset: %" PRIu64 " and size %" PRIzu "%s.\n",
+			 function,
+			 offset_table->last_chunk_offset_filled,
+			 last_offset,
+			 (size_t) chunk_size,
+			 remarks );
+#endif
+
+			chunk_offset->size = (uint32_t) chunk_size;
+
+			if( corrupted != 0 )
+			{
+				chunk_offset->flags |= LIBEWF_CHUNK_OFFSET_FLAGS_CORRUPTED;
+			}
+			else if( tainted != 0 )
+			{
+				chunk_offset->flags |= LIBEWF_CHUNK_OFFSET_FLAGS_TAINTED;
+			}
+			offset_table->last_chunk_offset_filled++;
+
+			break;
+		}
+		list_element = list_element->next;
+	}
+	return( 1 );
+}
+
+/* Fills the offsets from the offset table
+ * amount_of_chunk_offsets contains the amount of chunk offsets to fill
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_offset_table_fill_offsets(
+     libewf_offset_table_t *offset_table,
+     uint32_t offset_table_index,
+     uint32_t amount_of_chunk_offsets,
+     off64_t base_offset,
+     ewf_table_offset_t *offsets,
+     uint32_t amount_of_offsets,
+     liberror_error_t **error )
+{
+	libewf_chunk_offset_t *chunk_offset = NULL;
+	static char *function               = "libewf_offset_table_fill_offsets";
+	off64_t offset64_value              = 0;
+	uint32_t offset32_value             = 0;
+	uint32_t offset_iterator            = 0;
+
+	if( offset_table == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset table.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset_table->chunk_offset == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid offset table - missing chunk offsets.",
+		 function );
+
+		return( -1 );
+	}
+	if( base_offset < 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid base offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( offsets == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid table offsets.",
+		 function );
+
+		return( -1 );
+	}
+	if( amount_of_offsets < amount_of_chunk_offsets )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: amount of offsets too small.",
+		 function );
+
+		return( -1 );
+	}
+	for( offset_iterator = 0;
+	     offset_iterator < amount_of_chunk_offsets;
+	     offset_iterator++ )
+	{
+		chunk_offset   = &( offset_table->chunk_offset[ offset_table_index + offset_iterator ] );
+		offset64_value = libewf_offset_table_get_chunk_file_offset( offset_table, chunk_offset ) - base_offset;
+
+		if( ( offset64_value < 0 )
+		 || ( offset64_value > (off64_t) INT32_MAX ) )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid chunk offset value.",
+			 function );
+
+			return( -1 );
+		}
+		offset32_value = (uint32_t) offset64_value;
+
+		if( ( chunk_offset->flags & LIBEWF_CHUNK_OFFSET_FLAGS_COMPRESSED ) == LIBEWF_CHUNK_OFFSET_FLAGS_COMPRESSED )
+		{
+			offset32_value |= EWF_OFFSET_COMPRESSED_WRITE_MASK;
+		}
+		byte_stream_copy_from_uint32_little_endian(
+		 offsets[ offset_iterator ].offset,
+		 offset32_value );
+	}
+	return( 1 );
+}
+
+/* Compares the offsets with the ones in the offset table and makes corrections if necessary
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_offset_table_compare(
+     libewf_offset_table_t *offset_table,
+     off64_t base_offset,
+     ewf_table_offset_t *offsets,
+     uint32_t amount_of_chunks,
+     libewf_segment_file_handle_t *segment_file_handle,
+     uint8_t tainted,
+     liberror_error_t **error )
+{
+#if defined( HAVE_VERBOSE_OUTPUT )
+	char *chunk_type                    = NULL;
+	char *remarks                       = NULL;
+#endif
+
+	libewf_chunk_offset_t *chunk_offset = NULL;
+	static char *function               = "libewf_offset_table_compare";
+	uint32_t chunk_size                 = 0;
+	uint16_t segment_file_index         = 0;
+	uint32_t current_offset             = 0;
+	uint32_t next_offset                = 0;
+	uint32_t raw_offset                 = 0;
+	uint32_t offset_iterator            = 0;
+	uint8_t compressed                  = 0;
+	uint8_t corrupted                   = 0;
+	uint8_t mismatch                    = 0;
+	uint8_t overflow                    = 0;
+
+	if( offset_table == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset table.",
+		 function );
+
+		return( -1 );
+	}
+	if( base_offset < 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid base offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( offsets == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offsets.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	/* Allocate additional entries in the offset table if needed
+	 * - a single reallocation saves processing time
+	 */
+	if( ( offset_table->amount_of_chunk_offsets < ( offset_table->last_chunk_offset_compared + amount_of_chunks ) )
+	 && ( libewf_offset_table_resize(
+	       offset_table,
+	       offset_table->last_chunk_offset_compared + amount_of_chunks,
+	       error ) != 1 ) )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize offset table.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_offset_table_get_segment_file_index(
+	     offset_table,
+	     segment_file_handle,
+	     &segment_file_index,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment file index.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 offsets[ offset_iterator ].offset,
+	 raw_offset );
+
+	/* The size of the last chunk must be determined differently
+	 */
+	while( offset_iterator < ( amount_of_chunks - 1 ) )
+	{
+		if( overflow == 0 )
+		{
+			compressed     = (uint8_t) ( raw_offset >> 31 );
+			current_offset = raw_offset & EWF_OFFSET_COMPRESSED_READ_MASK;
+		}
+		else
+		{
+			current_offset = raw_offset;
+		}
+		byte_stream_copy_to_uint32_little_endian(
+		 offsets[ offset_iterator + 1 ].offset,
+		 raw_offset );
+
+		if( overflow == 0 )
+		{
+			next_offset = raw_offset & EWF_OFFSET_COMPRESSED_READ_MASK;
+		}
+		else
+		{
+			next_offset = raw_offset;
+		}
+		corrupted = 0;
+
+		/* This is to compensate for the crappy >2Gb segment file
+		 * solution in EnCase 6.7
+		 */
+		if( next_offset < current_offset )
+		{
+			if( raw_offset < current_offset )
+			{
+#if defined( HAVE_VERBOSE_OUTPUT )
+				libnotify_verbose_printf(
+				 "%s: chunk offset %" PRIu32 " larger than raw %" PRIu32 ".\n",
+				 function,
+				 current_offset,
+				 raw_offset );
+#endif
+
+				corrupted = 1;
+			}
+#if defined( HAVE_VERBOSE_OUTPUT )
+			else
+			{
+				libnotify_verbose_printf(
+				 "%s: chunk offset %" PRIu32 " larger than next %" PRIu32 ".\n",
+				 function,
+				 current_offset,
+				 next_offset );
+			}
+#endif
+
+			chunk_size = raw_offset - current_offset;
+		}
+		else
+		{
+			chunk_size = next_offset - current_offset;
+		}
+
+		if( chunk_size == 0 )
+		{
+#if defined( HAVE_VERBOSE_OUTPUT )
+			libnotify_verbose_printf(
+			 "%s: invalid chunk size - size is zero.\n",
+			 function );
+#endif
+
+			corrupted = 1;
+		}
+		if( chunk_size > (uint32_t) INT32_MAX )
+		{
+#if defined( HAVE_VERBOSE_OUTPUT )
+			libnotify_verbose_printf(
+			 "%s: invalid chunk size value exceeds maximum.\n",
+			 function );
+#endif
+
+			corrupted = 1;
+		}
+		chunk_offset = &( offset_table->chunk_offset[ offset_table->last_chunk_offset_compared ] );
+
+		if( libewf_offset_table_get_chunk_file_offset( offset_table, chunk_offset ) != (off64_t) ( base_offset + current_offset ) )
+		{
+#if defined( HAVE_VERBOSE_OUTPUT )
+			libnotify_verbose_printf(
+			 "%s: file offset mismatch for chunk offset: %" PRIu32 ".\n",
+			 function,
+			 offset_table->last_chunk_offset_compared );
+#endif
+
+			mismatch = 1;
+		}
+		else if( (size_t) chunk_offset->size != (size_t) chunk_size )
+		{
+#if defined( HAVE_VERBOSE_OUTPUT )
+			libnotify_verbose_printf(
+			 "%s: chunk size mismatch for chunk offset: %" PRIu32 ".\n",
+			 function,
+			 offset_table->last_chunk_offset_compared );
+#endif
+
+			mismatch = 1;
+		}
+		else if( ( chunk_offset->flags & LIBEWF_CHUNK_OFFSET_FLAGS_COMPRESSED ) != compressed )
+		{
+#if defined( HAVE_VERBOSE_OUTPUT )
+			libnotify_verbose_printf(
+			 "%s: compressed mismatch for chunk offset: %" PRIu32 ".\n",
+			 function,
+			 offset_table->last_chunk_offset_compared );
+#endif
+
+			mismatch = 1;
+		}
+		else
+		{
+			mismatch = 0;
+		}
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( compressed == 0 )
+		{
+			chunk_type = "uncompressed";
+		}
+		else
+		{
+			chunk_type = "compressed";
+		}
+		if( corrupted != 0 )
+		{
+			remarks = " corrupted";
+		}
+		else if( tainted != 0 )
+		{
+			remarks = " tainted";
+		}
+		else if( mismatch == 1 )
+		{
+			remarks = " corrected";
+		}
+		else
+		{
+			remarks = "";
+		}
+		libnotify_verbose_printf(
+		 "%s: %s chunk %" PRIu32 " read with: base %" PRIu64 ", offset %" PRIu32 " and size %" PRIu32 "%s.\n",
+		 function,
+		 chunk_type,
+		 offset_table->last_chunk_offset_compared,
+		 base_offset,
+		 current_offset,
+		 chunk_size,
+		 remarks );
+#endif
+
+		if( ( corrupted == 0 )
+		 && ( tainted == 0 )
+		 && ( mismatch == 1 ) )
+		{
+			if( libewf_offset_table_set_chunk_file_offset(
+			     offset_table,
+			     chunk_offset,
+			     base_offset + current_offset,
+			     error ) != 1 )
+			{
+				liberror_error_set(
+				 error,
+				 LIBERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set chunk file offset.",
+				 function );
+
+				return( -1 );
+			}
+
+			chunk_offset->segment_file_index = segment_file_index;
+			chunk_offset->size               = chunk_size;
+			chunk_offset->flags             |= compressed;
+			chunk_offset->flags             &= ~ ( LIBEWF_CHUNK_OFFSET_FLAGS_TAINTED | LIBEWF_CHUNK_OFFSET_FLAGS_CORRUPTED ) ;
+		}
+		offset_table->last_chunk_offset_compared++;
+
+		/* This is to compensate for the crappy >2Gb segment file
+		 * solution in EnCase 6.7
+		 */
+		if( ( overflow == 0 )
+		 && ( ( current_offset + chunk_size ) > (uint32_t) INT32_MAX ) )
+		{
+#if defined( HAVE_VERBOSE_OUTPUT )
+			libnotify_verbose_printf(
+			 "%s: chunk offset overflow at: %" PRIu32 ".\n",
+			 function,
+			 current_offset );
+#endif
+
+			overflow   = 1;
+			compressed = 0;
+		}
+		offset_iterator++;
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 offsets[ offset_iterator ].offset,
+	 raw_offset );
+
+	if( overflow == 0 )
+	{
+		compressed     = (uint8_t) ( raw_offset >> 31 );
+		current_offset = raw_offset & EWF_OFFSET_COMPRESSED_READ_MASK;
+	}
+	else
+	{
+		current_offset = raw_offset;
+	}
+	corrupted = 0;
+
+	chunk_offset = &( offset_table->chunk_offset[ offset_table->last_chunk_offset_compared ] );
+
+	if( libewf_offset_table_get_chunk_file_offset( offset_table, chunk_offset ) != (off64_t) ( base_offset + current_offset ) )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		libnotify_verbose_printf(
+		 "%s: file offset mismatch for chunk offset: %" PRIu32 ".\n",
+		 function,
+		 offset_table->last_chunk_offset_compared );
+#endif
+
+		mismatch = 1;
+	}
+	else if( ( chunk_offset->flags & LIBEWF_CHUNK_OFFSET_FLAGS_COMPRESSED ) != compressed )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		libnotify_verbose_printf(
+		 "%s: compressed mismatch for chunk offset: %" PRIu32 ".\n",
+		 function,
+		 offset_table->last_chunk_offset_compared );
+#endif
+
+		mismatch = 1;
+	}
+	else
+	{
+		mismatch = 0;
+	}
+#if defined( HAVE_VERBOSE_OUTPUT )
+	if( compressed == 0 )
+	{
+		chunk_type = "uncompressed";
+	}
+	else
+	{
+		chunk_type = "compressed";
+	}
+	if( corrupted != 0 )
+	{
+		remarks = " corrupted";
+	}
+	else if( tainted != 0 )
+	{
+		remarks = " tainted";
+	}
+	else if( mismatch == 1 )
+	{
+		remarks = " corrected";
+	}
+	else
+	{
+		remarks = "";
+	}
+	libnotify_verbose_printf(
+	 "%s: %s last chunk %" PRIu32 " read with: base %" PRIu64 " and offset %" PRIu32 "%s.\n",
+	 function,
+	 chunk_type,
+	 offset_table->last_chunk_offset_compared,
+	 base_offset,
+	 current_offset,
+	 remarks );
+#endif
+
+	if( ( corrupted == 0 )
+	 && ( tainted == 0 )
+	 && ( mismatch == 1 ) )
+	{
+		if( libewf_offset_table_set_chunk_file_offset(
+		     offset_table,
+		     chunk_offset,
+		     base_offset + current_offset,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set chunk file offset.",
+			 function );
+
+			return( -1 );
+		}
+
+		chunk_offset->segment_file_index = segment_file_index;
+		chunk_offset->flags             |= compressed;
+		chunk_offset->flags             &= ~ ( LIBEWF_CHUNK_OFFSET_FLAGS_TAINTED | LIBEWF_CHUNK_OFFSET_FLAGS_CORRUPTED ) ;
+	}
+	return( 1 );
+}
+
+/* Calculate the last offset and compares it with the one in the offset table and makes corrections if necessary
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_offset_table_compare_last_offset(
+     libewf_offset_table_t *offset_table,
+     libewf_list_t *section_list,
+     uint8_t tainted,
+     liberror_error_t **error )
+{
+#if defined( HAVE_VERBOSE_OUTPUT )
+	char *remarks                                     = NULL;
+#endif
+
+	libewf_chunk_offset_t *chunk_offset               = NULL;
+	libewf_list_element_t *list_element               = NULL;
+	libewf_section_list_values_t *section_list_values = NULL;
+	static char *function                             = "libewf_offset_table_fill_last_offset";
+	off64_t last_offset                               = 0;
+	off64_t chunk_size                                = 0;
+	uint8_t corrupted                                 = 0;
+	uint8_t mismatch                                  = 0;
+
+	if( offset_table == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset table.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset_table->chunk_offset == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid offset table - missing chunk offsets.",
+		 function );
+
+		return( -1 );
+	}
+	if( section_list == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid section list.",
+		 function );
+
+		return( -1 );
+	}
+	/* There is no indication how large the last chunk is. The only thing known is where it starts.
+	 * However it can be determined where the next section starts within the file.
+	 * The size of the last chunk is determined by subtracting the last offset from the offset of the section that follows.
+	 */
+	list_element = section_list->first;
+	chunk_offset = &( offset_table->chunk_offset[ offset_table->last_chunk_offset_compared ] );
+	last_offset  = libewf_offset_table_get_chunk_file_offset( offset_table, chunk_offset );
+
+	while( list_element != NULL )
+	{
+		section_list_values = (libewf_section_list_values_t *) list_element->value;
+
+		if( section_list_values == NULL )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid section list values.",
+			 function );
+
+			return( -1 );
+		}
+#if defined( HAVE_DEBUG_OUTPUT )
+		libnotify_verbose_printf(
+		 "%s: start offset: %" PRIi64 " last offset: %" PRIi64 " \n",
+		 function,
+		 section_list_values->start_offset,
+		 last_offset );
+#endif
+
+		if( ( section_list_values->start_offset < last_offset )
+		 && ( last_offset < section_list_values->end_offset ) )
+		{
+			chunk_size = section_list_values->end_offset - last_offset;
+
+			if( last_offset > (off64_t) INT64_MAX )
+			{
+				liberror_error_set(
+				 error,
+				 LIBERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+				 "%s: invalid last chunk offset value exceeds maximum.",
+				 function );
+
+				return( -1 );
+			}
+			if( chunk_size == 0 )
+			{
+				libnotify_verbose_printf(
+				 "%s: invalid chunk size - size is zero.\n",
+				 function );
+
+				corrupted = 1;
+			}
+			if( chunk_size > (off64_t) INT32_MAX )
+			{
+				libnotify_verbose_printf(
+				 "%s: invalid chunk size value exceeds maximum.\n",
+				 function );
+
+				corrupted = 1;
+			}
+			if( (size_t) chunk_offset->size != (size_t) chunk_size )
+			{
+#if defined( HAVE_VERBOSE_OUTPUT )
+				libnotify_verbose_printf(
+				 "%s: chunk size mismatch for chunk offset: %" PRIu32 ".\n",
+				 function,
+				 offset_table->last_chunk_offset_compared );
+#endif
+
+				mismatch = 1;
+			}
+			else
+			{
+				mismatch = 0;
+			}
+#if defined( HAVE_VERBOSE_OUTPUT )
+			if( corrupted != 0 )
+			{
+				remarks = " corrupted";
+			}
+			else if( tainted != 0 )
+			{
+				remarks = " tainted";
+			}
+			else if( mismatch == 1 )
+			{
+				remarks = " corrected";
+			}
+			else
+			{
+				remarks = "";
+			}
+			libnotify_verbose_printf(
+			 "%s: last chunk %" PRIu32 " calculated with offset: %" PRIu64 " and size %" PRIzu "%s.\n",
+			 function,
+			 offset_table->last_chunk_offset_compared,
+			 last_offset,
+			 (size_t) chunk_size,
+			 remarks );
+#endif
+
+			if( ( corrupted == 0 )
+			 && ( tainted == 0 )
+			 && ( mismatch == 1 ) )
+			{
+				chunk_offset->size   = (uint32_t) chunk_size;
+				chunk_offset->flags &= ~ ( LIBEWF_CHUNK_OFFSET_FLAGS_TAINTED | LIBEWF_CHUNK_OFFSET_FLAGS_CORRUPTED ) ;
+			}
+			offset_table->last_chunk_offset_compared++;
+
+			break;
+		}
+		list_element = list_element->next;
+	}
+	return( 1 );
+}
+
+/* Appends a table section of which the chunk offsets are read on demand
+ * The chunks of the table section follow the last chunk offset filled
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_offset_table_append_table_section(
+     libewf_offset_table_t *offset_table,
+     libewf_segment_file_handle_t *segment_file_handle,
+     off64_t offsets_file_offset,
+     off64_t base_offset,
+     uint32_t amount_of_chunks,
+     uint32_t table_crc,
+     uint8_t ewf_format,
+     liberror_error_t **error )
+{
+	libewf_table_section_t *table_section = NULL;
+	void *reallocation                    = NULL;
+	static char *function                 = "libewf_offset_table_append_table_section";
+	size_t table_sections_size            = 0;
+	uint32_t amount_of_table_sections     = 0;
+	uint16_t segment_file_index           = 0;
+
+	if( offset_table == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset table.",
+		 function );
+
+		return( -1 );
+	}
+	if( offsets_file_offset <= 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid offsets file offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( amount_of_chunks == 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid amount of chunks value is zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset_table->last_chunk_offset_filled > ( UINT32_MAX - amount_of_chunks ) )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid amount of chunks value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	/* The segment file handle is referenced in advance so that
+	 * reading the chunk offsets on demand does not need to resize
+	 * the segment file handles
+	 */
+	if( libewf_offset_table_get_segment_file_index(
+	     offset_table,
+	     segment_file_handle,
+	     &segment_file_index,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment file index.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset_table->amount_of_chunk_offsets < ( offset_table->last_chunk_offset_filled + amount_of_chunks ) )
+	{
+		if( libewf_offset_table_resize(
+		     offset_table,
+		     offset_table->last_chunk_offset_filled + amount_of_chunks,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to resize offset table.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( offset_table->amount_of_table_sections >= offset_table->amount_of_allocated_table_sections )
+	{
+		/* Double the amount of allocated table sections to reduce the amount of reallocations
+		 */
+		if( offset_table->amount_of_allocated_table_sections == 0 )
+		{
+			amount_of_table_sections = 16;
+		}
+		else if( offset_table->amount_of_allocated_table_sections < ( UINT32_MAX / 2 ) )
+		{
+			amount_of_table_sections = offset_table->amount_of_allocated_table_sections * 2;
+		}
+		else
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid amount of table sections value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		table_sections_size = sizeof( libewf_table_section_t ) * amount_of_table_sections;
+
+		if( table_sections_size > (size_t) SSIZE_MAX )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid table sections size value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		reallocation = memory_reallocate(
+		                offset_table->table_sections,
+		                table_sections_size );
+
+		if( reallocation == NULL )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_MEMORY,
+			 LIBERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize table sections.",
+			 function );
+
+			return( -1 );
+		}
+		offset_table->table_sections                     = (libewf_table_section_t *) reallocation;
+		offset_table->amount_of_allocated_table_sections = amount_of_table_sections;
+	}
+	table_section = &( offset_table->table_sections[ offset_table->amount_of_table_sections ] );
+
+	if( memory_set(
+	     table_section,
+	     0,
+	     sizeof( libewf_table_section_t ) ) == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_MEMORY,
+		 LIBERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear table section.",
+		 function );
+
+		return( -1 );
+	}
+	table_section->segment_file_handle = segment_file_handle;
+	table_section->offsets_file_offset = offsets_file_offset;
+	table_section->base_offset         = base_offset;
+	table_section->first_chunk         = offset_table->last_chunk_offset_filled;
+	table_section->amount_of_chunks    = amount_of_chunks;
+	table_section->table_crc           = table_crc;
+	table_section->ewf_format          = ewf_format;
+
+#if defined( HAVE_VERBOSE_OUTPUT )
+	libnotify_verbose_printf(
+	 "%s: table section with chunks %" PRIu32 " - %" PRIu32 " at offset: %" PRIi64 " read on demand.\n",
+	 function,
+	 table_section->first_chunk,
+	 table_section->first_chunk + amount_of_chunks - 1,
+	 offsets_file_offset );
+#endif
+
+	offset_table->amount_of_table_sections += 1;
+	offset_table->last_chunk_offset_filled += amount_of_chunks;
+
+	return( 1 );
+}
+
+/* Sets the location of the table2 offsets of the last table section
+ * The table2 offsets are only used if they correspond with the last table section
+ * Returns 1 if successful, 0 if the table2 section does not correspond or -1 on error
+ */
+int libewf_offset_table_set_table2_section(
+     libewf_offset_table_t *offset_table,
+     libewf_segment_file_handle_t *segment_file_handle,
+     off64_t offsets_file_offset,
+     off64_t base_offset,
+     uint32_t amount_of_chunks,
+     liberror_error_t **error )
+{
+	libewf_table_section_t *table_section = NULL;
+	static char *function                 = "libewf_offset_table_set_table2_section";
+
+	if( offset_table == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset table.",
+		 function );
+
+		return( -1 );
 	}
-	else if( tainted != 0 )
+	if( offsets_file_offset <= 0 )
 	{
-		remarks = " tainted";
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid offsets file offset.",
+		 function );
+
+		return( -1 );
 	}
-	else if( mismatch == 1 )
+	if( offset_table->amount_of_table_sections == 0 )
 	{
-		remarks = " corrected";
+		return( 0 );
 	}
-	else
+	table_section = &( offset_table->table_sections[ offset_table->amount_of_table_sections - 1 ] );
+
+	if( ( table_section->segment_file_handle != segment_file_handle )
+	 || ( table_section->base_offset != base_offset )
+	 || ( table_section->amount_of_chunks != amount_of_chunks )
+	 || ( table_section->table2_offsets_file_offset != 0 ) )
 	{
-		remarks = "";
-	}
-	libnotify_verbose_printf(
-	 "%s: %s last chunk %" PRIu32 " read with: base %" PRIu64 " and offset %" PRIu32 "%s.\n",
-	 function,
-	 chunk_type,
-	 offset_table->last_chunk_offset_compared,
-	 base_offset,
-	 current_offset,
-	 remarks );
+#if defined( HAVE_VERBOSE_OUTPUT )
+		libnotify_verbose_printf(
+		 "%s: table2 section does not correspond with table section.\n",
+		 function );
 #endif
 
-	if( ( corrupted == 0 )
-	 && ( tainted == 0 )
-	 && ( mismatch == 1 ) )
-	{
-		chunk_offset->segment_file_handle = segment_file_handle;
-		chunk_offset->file_offset         = (off64_t) ( base_offset + current_offset );
-		chunk_offset->flags              |= compressed;
-		chunk_offset->flags              &= ~ ( LIBEWF_CHUNK_OFFSET_FLAGS_TAINTED | LIBEWF_CHUNK_OFFSET_FLAGS_CORRUPTED ) ;
+		return( 0 );
 	}
+	table_section->table2_offsets_file_offset = offsets_file_offset;
+
 	return( 1 );
 }
 
-/* Calculate the last offset and compares it with the one in the offset table and makes corrections if necessary
- * Returns 1 if successful or -1 on error
+/* Reads the chunk offsets of the table section that contains the chunk
+ * if they were not read before
+ * Returns 1 if successful, 0 if no chunk offsets were read or -1 on error
  */
-int libewf_offset_table_compare_last_offset(
+int libewf_offset_table_read_table_section(
      libewf_offset_table_t *offset_table,
-     libewf_list_t *section_list,
-     uint8_t tainted,
+     uint32_t chunk,
+     libbfio_pool_t *file_io_pool,
      liberror_error_t **error )
 {
-#if defined( HAVE_VERBOSE_OUTPUT )
-	char *remarks                                     = NULL;
-#endif
-
-	libewf_chunk_offset_t *chunk_offset               = NULL;
-	libewf_list_element_t *list_element               = NULL;
-	libewf_section_list_values_t *section_list_values = NULL;
-	static char *function                             = "libewf_offset_table_fill_last_offset";
-	off64_t last_offset                               = 0;
-	off64_t chunk_size                                = 0;
-	uint8_t corrupted                                 = 0;
-	uint8_t mismatch                                  = 0;
+	uint8_t stored_crc_buffer[ 4 ];
+
+	libewf_table_section_t *table_section = NULL;
+	ewf_table_offset_t *offsets           = NULL;
+	static char *function                 = "libewf_offset_table_read_table_section";
+	ewf_crc_t calculated_crc              = 0;
+	ewf_crc_t stored_crc                  = 0;
+	off64_t offsets_file_offset           = 0;
+	size_t offsets_size                   = 0;
+	ssize_t read_count                    = 0;
+	uint32_t last_chunk_offset            = 0;
+	uint32_t lower_index                  = 0;
+	uint32_t middle_index                 = 0;
+	uint32_t upper_index                  = 0;
+	uint8_t offsets_tainted               = 0;
+	int table_iterator                    = 0;
+	int result                            = 1;
 
 	if( offset_table == NULL )
 	{
@@ -1244,144 +2341,308 @@ int libewf_offset_table_compare_last_offset(
 
 		return( -1 );
 	}
-	if( offset_table->chunk_offset == NULL )
+	if( offset_table->amount_of_table_sections == 0 )
+	{
+		return( 0 );
+	}
+	/* The table sections are stored in order of their first chunk
+	 */
+	upper_index = offset_table->amount_of_table_sections;
+
+	while( lower_index < upper_index )
+	{
+		middle_index  = lower_index + ( ( upper_index - lower_index ) / 2 );
+		table_section = &( offset_table->table_sections[ middle_index ] );
+
+		if( chunk < table_section->first_chunk )
+		{
+			upper_index = middle_index;
+		}
+		else if( chunk >= ( table_section->first_chunk + table_section->amount_of_chunks ) )
+		{
+			lower_index = middle_index + 1;
+		}
+		else
+		{
+			break;
+		}
+		table_section = NULL;
+	}
+	if( ( table_section == NULL )
+	 || ( table_section->is_read != 0 ) )
+	{
+		return( 0 );
+	}
+	if( table_section->segment_file_handle == NULL )
 	{
 		liberror_error_set(
 		 error,
 		 LIBERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid offset table - missing chunk offsets.",
+		 "%s: invalid table section - missing segment file handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( section_list == NULL )
+	offsets_size = sizeof( ewf_table_offset_t ) * table_section->amount_of_chunks;
+
+	if( offsets_size > (size_t) SSIZE_MAX )
 	{
 		liberror_error_set(
 		 error,
-		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid section list.",
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid offsets size value exceeds maximum.",
 		 function );
 
 		return( -1 );
 	}
-	/* There is no indication how large the last chunk is. The only thing known is where it starts.
-	 * However it can be determined where the next section starts within the file.
-	 * The size of the last chunk is determined by subtracting the last offset from the offset of the section that follows.
-	 */
-	list_element = section_list->first;
-	chunk_offset = &( offset_table->chunk_offset[ offset_table->last_chunk_offset_compared ] );
-	last_offset  = chunk_offset->file_offset;
+	offsets = (ewf_table_offset_t *) memory_allocate(
+	                                  offsets_size );
 
-	while( list_element != NULL )
+	if( offsets == NULL )
 	{
-		section_list_values = (libewf_section_list_values_t *) list_element->value;
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_MEMORY,
+		 LIBERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create table offsets.",
+		 function );
 
-		if( section_list_values == NULL )
+		return( -1 );
+	}
+	/* The table offsets are filled first after which the table2 offsets are compared
+	 */
+	for( table_iterator = 0;
+	     table_iterator < 2;
+	     table_iterator++ )
+	{
+		if( table_iterator == 0 )
+		{
+			offsets_file_offset = table_section->offsets_file_offset;
+		}
+		else
+		{
+			offsets_file_offset = table_section->table2_offsets_file_offset;
+		}
+		if( offsets_file_offset == 0 )
+		{
+			continue;
+		}
+#if defined( HAVE_VERBOSE_OUTPUT )
+		libnotify_verbose_printf(
+		 "%s: reading %s offsets of chunks %" PRIu32 " - %" PRIu32 " at offset: %" PRIi64 ".\n",
+		 function,
+		 ( table_iterator == 0 ) ? "table" : "table2",
+		 table_section->first_chunk,
+		 table_section->first_chunk + table_section->amount_of_chunks - 1,
+		 offsets_file_offset );
+#endif
+
+		if( libbfio_pool_seek_offset(
+		     file_io_pool,
+		     table_section->segment_file_handle->file_io_pool_entry,
+		     offsets_file_offset,
+		     SEEK_SET,
+		     error ) == -1 )
 		{
 			liberror_error_set(
 			 error,
-			 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
-			 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
-			 "%s: invalid section list values.",
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek table offsets.",
 			 function );
 
+			memory_free(
+			 offsets );
+
 			return( -1 );
 		}
-#if defined( HAVE_DEBUG_OUTPUT )
-		libnotify_verbose_printf(
-		 "%s: start offset: %" PRIi64 " last offset: %" PRIi64 " \n",
-		 function,
-		 section_list_values->start_offset,
-		 last_offset );
-#endif
-
-		if( ( section_list_values->start_offset < last_offset )
-		 && ( last_offset < section_list_values->end_offset ) )
+		read_count = libbfio_pool_read(
+		              file_io_pool,
+		              table_section->segment_file_handle->file_io_pool_entry,
+		              (uint8_t *) offsets,
+		              offsets_size,
+		              error );
+
+		if( read_count != (ssize_t) offsets_size )
 		{
-			chunk_size = section_list_values->end_offset - last_offset;
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read table offsets.",
+			 function );
 
-			if( last_offset > (off64_t) INT64_MAX )
+			memory_free(
+			 offsets );
+
+			return( -1 );
+		}
+		offsets_tainted = 0;
+
+		/* The EWF-S01 format does not contain a CRC after the offsets
+		 */
+		if( table_section->ewf_format != EWF_FORMAT_S01 )
+		{
+			calculated_crc = ewf_crc_calculate(
+			                  offsets,
+			                  offsets_size,
+			                  1 );
+
+			read_count = libbfio_pool_read(
+			              file_io_pool,
+			              table_section->segment_file_handle->file_io_pool_entry,
+			              stored_crc_buffer,
+			              sizeof( ewf_crc_t ),
+			              error );
+
+			if( read_count != (ssize_t) sizeof( ewf_crc_t ) )
 			{
 				liberror_error_set(
 				 error,
-				 LIBERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-				 "%s: invalid last chunk offset value exceeds maximum.",
+				 LIBERROR_ERROR_DOMAIN_IO,
+				 LIBERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read CRC.",
 				 function );
 
-				return( -1 );
-			}
-			if( chunk_size == 0 )
-			{
-				libnotify_verbose_printf(
-				 "%s: invalid chunk size - size is zero.\n",
-				 function );
+				memory_free(
+				 offsets );
 
-				corrupted = 1;
+				return( -1 );
 			}
-			if( chunk_size > (off64_t) INT32_MAX )
-			{
-				libnotify_verbose_printf(
-				 "%s: invalid chunk size value exceeds maximum.\n",
-				 function );
+			byte_stream_copy_to_uint32_little_endian(
+			 stored_crc_buffer,
+			 stored_crc );
 
-				corrupted = 1;
-			}
-			if( chunk_offset->size != (size_t) chunk_size )
+			if( stored_crc != calculated_crc )
 			{
-#if defined( HAVE_VERBOSE_OUTPUT )
 				libnotify_verbose_printf(
-				 "%s: chunk size mismatch for chunk offset: %" PRIu32 ".\n",
+				 "%s: CRC does not match (in file: %" PRIu32 " calculated: %" PRIu32 ").\n",
 				 function,
-				 offset_table->last_chunk_offset_compared );
-#endif
+				 stored_crc,
+				 calculated_crc );
 
-				mismatch = 1;
-			}
-			else
-			{
-				mismatch = 0;
+				offsets_tainted = 1;
 			}
-#if defined( HAVE_VERBOSE_OUTPUT )
-			if( corrupted != 0 )
-			{
-				remarks = " corrupted";
-			}
-			else if( tainted != 0 )
-			{
-				remarks = " tainted";
-			}
-			else if( mismatch == 1 )
+		}
+		/* The fill and compare functions operate on the last chunk offset
+		 * filled or compared, which is set to the first chunk of the table section
+		 */
+		if( table_iterator == 0 )
+		{
+			last_chunk_offset                      = offset_table->last_chunk_offset_filled;
+			offset_table->last_chunk_offset_filled = table_section->first_chunk;
+
+			result = libewf_offset_table_fill(
+			          offset_table,
+			          table_section->base_offset,
+			          offsets,
+			          table_section->amount_of_chunks,
+			          table_section->segment_file_handle,
+			          offsets_tainted,
+			          error );
+
+			if( result == 1 )
 			{
-				remarks = " corrected";
+				result = libewf_offset_table_fill_last_offset(
+				          offset_table,
+				          table_section->segment_file_handle->section_list,
+				          offsets_tainted,
+				          error );
 			}
-			else
+			offset_table->last_chunk_offset_filled = last_chunk_offset;
+		}
+		else
+		{
+			last_chunk_offset                        = offset_table->last_chunk_offset_compared;
+			offset_table->last_chunk_offset_compared = table_section->first_chunk;
+
+			result = libewf_offset_table_compare(
+			          offset_table,
+			          table_section->base_offset,
+			          offsets,
+			          table_section->amount_of_chunks,
+			          table_section->segment_file_handle,
+			          offsets_tainted,
+			          error );
+
+			if( result == 1 )
 			{
-				remarks = "";
+				result = libewf_offset_table_compare_last_offset(
+				          offset_table,
+				          table_section->segment_file_handle->section_list,
+				          offsets_tainted,
+				          error );
 			}
-			libnotify_verbose_printf(
-			 "%s: last chunk %" PRIu32 " calculated with offset: %" PRIu64 " and size %" PRIzu "%s.\n",
+			offset_table->last_chunk_offset_compared = last_chunk_offset;
+		}
+		if( result != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to %s offset table.",
 			 function,
-			 offset_table->last_chunk_offset_compared,
-			 last_offset,
-			 (size_t) chunk_size,
-			 remarks );
-#endif
+			 ( table_iterator == 0 ) ? "fill" : "compare" );
 
-			if( ( corrupted == 0 )
-			 && ( tainted == 0 )
-			 && ( mismatch == 1 ) )
-			{
-				chunk_offset->size   = (size_t) chunk_size;
-				chunk_offset->flags &= ~ ( LIBEWF_CHUNK_OFFSET_FLAGS_TAINTED | LIBEWF_CHUNK_OFFSET_FLAGS_CORRUPTED ) ;
-			}
-			offset_table->last_chunk_offset_compared++;
+			memory_free(
+			 offsets );
 
-			break;
+			return( -1 );
+		}
+	}
+	memory_free(
+	 offsets );
+
+	table_section->is_read = 1;
+
+	return( 1 );
+}
+
+/* Reads the chunk offsets of all the table sections that were not read before
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_offset_table_read_table_sections(
+     libewf_offset_table_t *offset_table,
+     libbfio_pool_t *file_io_pool,
+     liberror_error_t **error )
+{
+	static char *function   = "libewf_offset_table_read_table_sections";
+	uint32_t table_iterator = 0;
+
+	if( offset_table == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset table.",
+		 function );
+
+		return( -1 );
+	}
+	for( table_iterator = 0;
+	     table_iterator < offset_table->amount_of_table_sections;
+	     table_iterator++ )
+	{
+		if( libewf_offset_table_read_table_section(
+		     offset_table,
+		     offset_table->table_sections[ table_iterator ].first_chunk,
+		     file_io_pool,
+		     error ) == -1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read table section: %" PRIu32 ".",
+			 function,
+			 table_iterator );
+
+			return( -1 );
 		}
-		list_element = list_element->next;
 	}
 	return( 1 );
 }
@@ -1395,7 +2656,11 @@ off64_t libewf_offset_table_seek_chunk_offset(
          libbfio_pool_t *file_io_pool,
          liberror_error_t **error )
 {
-	static char *function = "libewf_segment_table_seek_chunk_offset";
+	libewf_segment_file_handle_t *segment_file_handle = NULL;
+	static char *function                             = "libewf_segment_table_seek_chunk_offset";
+	off64_t file_offset                               = 0;
+	size_t chunk_size                                 = 0;
+	uint8_t chunk_flags                               = 0;
 
 	if( offset_table == NULL )
 	{
@@ -1432,7 +2697,42 @@ off64_t libewf_offset_table_seek_chunk_offset(
 
 		return( -1 );
 	}
-	if( offset_table->chunk_offset[ chunk ].segment_file_handle == NULL )
+	if( libewf_offset_table_read_table_section(
+	     offset_table,
+	     chunk,
+	     file_io_pool,
+	     error ) == -1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_IO,
+		 LIBERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read table section of chunk: %" PRIu32 ".",
+		 function,
+		 chunk );
+
+		return( -1 );
+	}
+	if( libewf_offset_table_get_chunk_offset(
+	     offset_table,
+	     chunk,
+	     &segment_file_handle,
+	     &file_offset,
+	     &chunk_size,
+	     &chunk_flags,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk offset: %" PRIu32 ".",
+		 function,
+		 chunk );
+
+		return( -1 );
+	}
+	if( segment_file_handle == NULL )
 	{
 		liberror_error_set(
 		 error,
@@ -1446,8 +2746,8 @@ off64_t libewf_offset_table_seek_chunk_offset(
 	}
 	if( libbfio_pool_seek_offset(
 	     file_io_pool,
-	     offset_table->chunk_offset[ chunk ].segment_file_handle->file_io_pool_entry,
-	     offset_table->chunk_offset[ chunk ].file_offset,
+	     segment_file_handle->file_io_pool_entry,
+	     file_offset,
 	     SEEK_SET,
 	     error ) == -1 )
 	{
@@ -1457,10 +2757,9 @@ off64_t libewf_offset_table_seek_chunk_offset(
 		 LIBERROR_IO_ERROR_SEEK_FAILED,
 		 "%s: unable to find chunk offset: %" PRIi64 ".",
 		 function,
-		 offset_table->chunk_offset[ chunk ].file_offset );
+		 file_offset );
 
 		return( -1 );
 	}
-	return( offset_table->chunk_offset[ chunk ].file_offset );
+	return( file_offset );
 }
-
@@ -32,6 +32,7 @@
 #include "libewf_libbfio.h"
 #include "libewf_list_type.h"
 #include "libewf_segment_file_handle.h"
+#include "libewf_table_section.h"
 
 #include "ewf_table.h"
 
@@ -59,8 +60,58 @@ struct libewf_offset_table
 	/* Dynamic array of chunk offsets
 	 */
 	libewf_chunk_offset_t *chunk_offset;
+
+	/* Dynamic array of references to the segment file handles
+	 * the chunk offsets refer to these by index
+	 */
+	libewf_segment_file_handle_t **segment_file_handles;
+
+	/* The amount of segment file handles
+	 */
+	uint16_t amount_of_segment_file_handles;
+
+	/* The index of the segment file handle that was last used
+	 */
+	uint16_t last_segment_file_index;
+
+	/* Value to indicate the chunk offsets of the table sections
+	 * are read on demand instead of when the table section is read
+	 */
+	uint8_t read_on_demand;
+
+	/* Dynamic array of the table sections of which the chunk offsets are read on demand
+	 */
+	libewf_table_section_t *table_sections;
+
+	/* The amount of table sections
+	 */
+	uint32_t amount_of_table_sections;
+
+	/* The amount of allocated table sections
+	 */
+	uint32_t amount_of_allocated_table_sections;
+
+	/* Dynamic array of the file offsets that are too large to be stored packed
+	 * the chunk offsets refer to these by index
+	 */
+	off64_t *wide_file_offsets;
+
+	/* The amount of wide file offsets
+	 */
+	uint32_t amount_of_wide_file_offsets;
+
+	/* The amount of allocated wide file offsets
+	 */
+	uint32_t amount_of_allocated_wide_file_offsets;
 };
 
+/* Retrieves the file offset of a chunk offset in the offset table
+ */
+#define libewf_offset_table_get_chunk_file_offset( offset_table, chunk_offset ) \
+	( ( ( ( chunk_offset )->flags & LIBEWF_CHUNK_OFFSET_FLAGS_WIDE_FILE_OFFSET ) != 0 ) \
+	 ? ( offset_table )->wide_file_offsets[ libewf_chunk_offset_get_packed_file_offset( chunk_offset ) ] \
+	 : libewf_chunk_offset_get_packed_file_offset( chunk_offset ) )
+
 int libewf_offset_table_initialize(
      libewf_offset_table_t **offset_table,
      uint32_t amount_of_chunk_offsets,
@@ -75,6 +126,42 @@ int libewf_offset_table_resize(
      uint32_t amount_of_chunk_offsets,
      liberror_error_t **error );
 
+int libewf_offset_table_get_segment_file_index(
+     libewf_offset_table_t *offset_table,
+     libewf_segment_file_handle_t *segment_file_handle,
+     uint16_t *segment_file_index,
+     liberror_error_t **error );
+
+int libewf_offset_table_set_chunk_file_offset(
+     libewf_offset_table_t *offset_table,
+     libewf_chunk_offset_t *chunk_offset,
+     off64_t file_offset,
+     liberror_error_t **error );
+
+int libewf_offset_table_get_chunk_offset(
+     libewf_offset_table_t *offset_table,
+     uint32_t chunk,
+     libewf_segment_file_handle_t **segment_file_handle,
+     off64_t *file_offset,
+     size_t *size,
+     uint8_t *flags,
+     liberror_error_t **error );
+
+int libewf_offset_table_set_chunk_offset(
+     libewf_offset_table_t *offset_table,
+     uint32_t chunk,
+     libewf_segment_file_handle_t *segment_file_handle,
+     off64_t file_offset,
+     size_t size,
+     uint8_t flags,
+     liberror_error_t **error );
+
+int libewf_offset_table_set_chunk_flags(
+     libewf_offset_table_t *offset_table,
+     uint32_t chunk,
+     uint8_t flags,
+     liberror_error_t **error );
+
 int libewf_offset_table_fill(
      libewf_offset_table_t *offset_table,
      off64_t base_offset,
@@ -114,6 +201,35 @@ int libewf_offset_table_compare_last_offset(
      uint8_t tainted,
      liberror_error_t **error );
 
+int libewf_offset_table_append_table_section(
+     libewf_offset_table_t *offset_table,
+     libewf_segment_file_handle_t *segment_file_handle,
+     off64_t offsets_file_offset,
+     off64_t base_offset,
+     uint32_t amount_of_chunks,
+     uint32_t table_crc,
+     uint8_t ewf_format,
+     liberror_error_t **error );
+
+int libewf_offset_table_set_table2_section(
+     libewf_offset_table_t *offset_table,
+     libewf_segment_file_handle_t *segment_file_handle,
+     off64_t offsets_file_offset,
+     off64_t base_offset,
+     uint32_t amount_of_chunks,
+     liberror_error_t **error );
+
+int libewf_offset_table_read_table_section(
+     libewf_offset_table_t *offset_table,
+     uint32_t chunk,
+     libbfio_pool_t *file_io_pool,
+     liberror_error_t **error );
+
+int libewf_offset_table_read_table_sections(
+     libewf_offset_table_t *offset_table,
+     libbfio_pool_t *file_io_pool,
+     liberror_error_t **error );
+
 off64_t libewf_offset_table_seek_chunk_offset(
          libewf_offset_table_t *offset_table,
          uint32_t chunk,
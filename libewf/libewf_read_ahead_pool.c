@@ -0,0 +1,745 @@
+/*
+ * Read-ahead pool functions
+ *
+ * Copyright (c) 2006-2009, Joachim Metz <forensics@hoffmannbv.nl>,
+ * Hoffmann Investigations.
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <thread.h>
+#include <types.h>
+
+#include <liberror.h>
+#include <libnotify.h>
+
+#include "libewf_read_ahead_pool.h"
+
+#include "ewf_crc.h"
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Initialize the read-ahead pool and starts the threads
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_ahead_pool_initialize(
+     libewf_read_ahead_pool_t **read_ahead_pool,
+     libewf_read_io_handle_t *read_io_handle,
+     libewf_io_handle_t *io_handle,
+     libewf_media_values_t *media_values,
+     libewf_offset_table_t *offset_table,
+     libewf_chunk_cache_t *chunk_cache,
+     int amount_of_threads,
+     liberror_error_t **error )
+{
+	static char *function         = "libewf_read_ahead_pool_initialize";
+	size_t amount_of_cache_chunks = 0;
+	int maximum_amount_of_chunks  = 0;
+	int thread_index              = 0;
+
+	if( read_ahead_pool == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_io_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read io handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid io handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset_table == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset table.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_cache == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( amount_of_threads <= 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid amount of threads value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	/* Make sure the chunks read ahead fit in the chunk cache
+	 * together with the chunks that are being read
+	 */
+	maximum_amount_of_chunks = amount_of_threads * LIBEWF_READ_AHEAD_POOL_CHUNKS_PER_THREAD;
+
+	amount_of_cache_chunks = chunk_cache->maximum_cache_size
+	                       / ( media_values->chunk_size + sizeof( ewf_crc_t ) );
+
+	if( (size_t) maximum_amount_of_chunks > ( amount_of_cache_chunks / 2 ) )
+	{
+		maximum_amount_of_chunks = (int) ( amount_of_cache_chunks / 2 );
+	}
+	if( maximum_amount_of_chunks <= 0 )
+	{
+		maximum_amount_of_chunks = 1;
+	}
+	if( *read_ahead_pool == NULL )
+	{
+		*read_ahead_pool = (libewf_read_ahead_pool_t *) memory_allocate(
+		                                                 sizeof( libewf_read_ahead_pool_t ) );
+
+		if( *read_ahead_pool == NULL )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_MEMORY,
+			 LIBERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create read-ahead pool.",
+			 function );
+
+			return( -1 );
+		}
+		if( memory_set(
+		     *read_ahead_pool,
+		     0,
+		     sizeof( libewf_read_ahead_pool_t ) ) == NULL )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_MEMORY,
+			 LIBERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear read-ahead pool.",
+			 function );
+
+			memory_free(
+			 *read_ahead_pool );
+
+			*read_ahead_pool = NULL;
+
+			return( -1 );
+		}
+		if( thread_mutex_initialize(
+		     &( ( *read_ahead_pool )->mutex ) ) != 0 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize mutex.",
+			 function );
+
+			memory_free(
+			 *read_ahead_pool );
+
+			*read_ahead_pool = NULL;
+
+			return( -1 );
+		}
+		if( thread_condition_initialize(
+		     &( ( *read_ahead_pool )->queued_condition ) ) != 0 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize queued condition.",
+			 function );
+
+			thread_mutex_free(
+			 &( ( *read_ahead_pool )->mutex ) );
+			memory_free(
+			 *read_ahead_pool );
+
+			*read_ahead_pool = NULL;
+
+			return( -1 );
+		}
+		if( thread_condition_initialize(
+		     &( ( *read_ahead_pool )->processed_condition ) ) != 0 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize processed condition.",
+			 function );
+
+			thread_condition_free(
+			 &( ( *read_ahead_pool )->queued_condition ) );
+			thread_mutex_free(
+			 &( ( *read_ahead_pool )->mutex ) );
+			memory_free(
+			 *read_ahead_pool );
+
+			*read_ahead_pool = NULL;
+
+			return( -1 );
+		}
+		( *read_ahead_pool )->read_io_handle           = read_io_handle;
+		( *read_ahead_pool )->io_handle                = io_handle;
+		( *read_ahead_pool )->media_values             = media_values;
+		( *read_ahead_pool )->offset_table             = offset_table;
+		( *read_ahead_pool )->chunk_cache              = chunk_cache;
+		( *read_ahead_pool )->maximum_amount_of_chunks = maximum_amount_of_chunks;
+
+		/* From here on the read-ahead pool can be freed using libewf_read_ahead_pool_free
+		 */
+		( *read_ahead_pool )->queued_chunks = (uint32_t *) memory_allocate(
+		                                                    sizeof( uint32_t ) * maximum_amount_of_chunks );
+
+		if( ( *read_ahead_pool )->queued_chunks == NULL )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_MEMORY,
+			 LIBERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create queued chunks.",
+			 function );
+
+			libewf_read_ahead_pool_free(
+			 read_ahead_pool,
+			 NULL );
+
+			return( -1 );
+		}
+		( *read_ahead_pool )->processing_chunks = (int64_t *) memory_allocate(
+		                                                       sizeof( int64_t ) * amount_of_threads );
+
+		if( ( *read_ahead_pool )->processing_chunks == NULL )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_MEMORY,
+			 LIBERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create processing chunks.",
+			 function );
+
+			libewf_read_ahead_pool_free(
+			 read_ahead_pool,
+			 NULL );
+
+			return( -1 );
+		}
+		for( thread_index = 0;
+		     thread_index < amount_of_threads;
+		     thread_index++ )
+		{
+			( *read_ahead_pool )->processing_chunks[ thread_index ] = -1;
+		}
+		( *read_ahead_pool )->threads = (thread_t *) memory_allocate(
+		                                              sizeof( thread_t ) * amount_of_threads );
+
+		if( ( *read_ahead_pool )->threads == NULL )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_MEMORY,
+			 LIBERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create threads.",
+			 function );
+
+			libewf_read_ahead_pool_free(
+			 read_ahead_pool,
+			 NULL );
+
+			return( -1 );
+		}
+		for( thread_index = 0;
+		     thread_index < amount_of_threads;
+		     thread_index++ )
+		{
+			if( thread_create(
+			     &( ( *read_ahead_pool )->threads[ thread_index ] ),
+			     libewf_read_ahead_pool_read_chunks,
+			     *read_ahead_pool ) != 0 )
+			{
+				liberror_error_set(
+				 error,
+				 LIBERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create thread: %d.",
+				 function,
+				 thread_index );
+
+				libewf_read_ahead_pool_free(
+				 read_ahead_pool,
+				 NULL );
+
+				return( -1 );
+			}
+			/* Only the threads that were created are joined on free
+			 */
+			( *read_ahead_pool )->amount_of_threads += 1;
+		}
+	}
+	return( 1 );
+}
+
+/* Stops the threads and frees the read-ahead pool including elements
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_ahead_pool_free(
+     libewf_read_ahead_pool_t **read_ahead_pool,
+     liberror_error_t **error )
+{
+	static char *function = "libewf_read_ahead_pool_free";
+	int thread_index      = 0;
+	int result            = 1;
+
+	if( read_ahead_pool == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_ahead_pool != NULL )
+	{
+		if( ( *read_ahead_pool )->amount_of_threads > 0 )
+		{
+			if( thread_mutex_grab(
+			     &( ( *read_ahead_pool )->mutex ) ) != 0 )
+			{
+				liberror_error_set(
+				 error,
+				 LIBERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to grab mutex.",
+				 function );
+
+				return( -1 );
+			}
+			( *read_ahead_pool )->stop_threads = 1;
+
+			thread_condition_broadcast(
+			 &( ( *read_ahead_pool )->queued_condition ) );
+
+			if( thread_mutex_release(
+			     &( ( *read_ahead_pool )->mutex ) ) != 0 )
+			{
+				liberror_error_set(
+				 error,
+				 LIBERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release mutex.",
+				 function );
+
+				return( -1 );
+			}
+			for( thread_index = 0;
+			     thread_index < ( *read_ahead_pool )->amount_of_threads;
+			     thread_index++ )
+			{
+				if( thread_join(
+				     ( *read_ahead_pool )->threads[ thread_index ] ) != 0 )
+				{
+					liberror_error_set(
+					 error,
+					 LIBERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to join thread: %d.",
+					 function,
+					 thread_index );
+
+					result = -1;
+				}
+			}
+		}
+		if( ( *read_ahead_pool )->threads != NULL )
+		{
+			memory_free(
+			 ( *read_ahead_pool )->threads );
+		}
+		if( ( *read_ahead_pool )->processing_chunks != NULL )
+		{
+			memory_free(
+			 ( *read_ahead_pool )->processing_chunks );
+		}
+		if( ( *read_ahead_pool )->queued_chunks != NULL )
+		{
+			memory_free(
+			 ( *read_ahead_pool )->queued_chunks );
+		}
+		if( thread_condition_free(
+		     &( ( *read_ahead_pool )->processed_condition ) ) != 0 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free processed condition.",
+			 function );
+
+			result = -1;
+		}
+		if( thread_condition_free(
+		     &( ( *read_ahead_pool )->queued_condition ) ) != 0 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free queued condition.",
+			 function );
+
+			result = -1;
+		}
+		if( thread_mutex_free(
+		     &( ( *read_ahead_pool )->mutex ) ) != 0 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *read_ahead_pool );
+
+		*read_ahead_pool = NULL;
+	}
+	return( result );
+}
+
+/* The start function of the read-ahead pool threads
+ * Reads and decompresses the queued chunks into the chunk cache until the threads are stopped
+ * Returns NULL
+ */
+void *libewf_read_ahead_pool_read_chunks(
+       void *arguments )
+{
+	libewf_read_ahead_pool_t *read_ahead_pool = NULL;
+	liberror_error_t *error                   = NULL;
+	static char *function                     = "libewf_read_ahead_pool_read_chunks";
+	uint32_t chunk                            = 0;
+	int thread_index                          = 0;
+
+	if( arguments == NULL )
+	{
+		return( NULL );
+	}
+	read_ahead_pool = (libewf_read_ahead_pool_t *) arguments;
+
+	if( thread_mutex_grab(
+	     &( read_ahead_pool->mutex ) ) != 0 )
+	{
+		return( NULL );
+	}
+	while( read_ahead_pool->stop_threads == 0 )
+	{
+		if( read_ahead_pool->amount_of_queued_chunks <= 0 )
+		{
+			thread_condition_wait(
+			 &( read_ahead_pool->queued_condition ),
+			 &( read_ahead_pool->mutex ) );
+
+			continue;
+		}
+		chunk = read_ahead_pool->queued_chunks[ read_ahead_pool->first_queued_chunk ];
+
+		read_ahead_pool->first_queued_chunk += 1;
+
+		if( read_ahead_pool->first_queued_chunk >= read_ahead_pool->maximum_amount_of_chunks )
+		{
+			read_ahead_pool->first_queued_chunk = 0;
+		}
+		read_ahead_pool->amount_of_queued_chunks -= 1;
+
+		/* There are never more chunks being processed than threads
+		 */
+		for( thread_index = 0;
+		     thread_index < read_ahead_pool->amount_of_threads;
+		     thread_index++ )
+		{
+			if( read_ahead_pool->processing_chunks[ thread_index ] == -1 )
+			{
+				break;
+			}
+		}
+		read_ahead_pool->processing_chunks[ thread_index ] = (int64_t) chunk;
+
+		thread_mutex_release(
+		 &( read_ahead_pool->mutex ) );
+
+		/* A size of 0 only reads the chunk into the chunk cache
+		 * if the chunk cannot be read the error is reported when the chunk is read by the caller
+		 */
+		if( libewf_read_io_handle_read_chunk_data_concurrent(
+		     read_ahead_pool->read_io_handle,
+		     read_ahead_pool->io_handle,
+		     read_ahead_pool->media_values,
+		     read_ahead_pool->offset_table,
+		     read_ahead_pool->chunk_cache,
+		     chunk,
+		     0,
+		     NULL,
+		     0,
+		     &error ) == -1 )
+		{
+			liberror_error_set(
+			 &error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read ahead chunk: %" PRIu32 ".",
+			 function,
+			 chunk );
+
+#if defined( HAVE_VERBOSE_OUTPUT )
+			libnotify_print_error_backtrace(
+			 error );
+#endif
+			liberror_error_free(
+			 &error );
+		}
+		if( thread_mutex_grab(
+		     &( read_ahead_pool->mutex ) ) != 0 )
+		{
+			return( NULL );
+		}
+		read_ahead_pool->processing_chunks[ thread_index ] = -1;
+
+		thread_condition_broadcast(
+		 &( read_ahead_pool->processed_condition ) );
+	}
+	thread_mutex_release(
+	 &( read_ahead_pool->mutex ) );
+
+	return( NULL );
+}
+
+/* Queues the chunks following the chunk that is read if the reads are sequential
+ * A non sequential read discards the chunks that are queued
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_ahead_pool_queue_chunks(
+     libewf_read_ahead_pool_t *read_ahead_pool,
+     uint32_t chunk,
+     liberror_error_t **error )
+{
+	static char *function    = "libewf_read_ahead_pool_queue_chunks";
+	uint32_t last_chunk      = 0;
+	int queued_chunk_index   = 0;
+	int amount_of_new_chunks = 0;
+
+	if( read_ahead_pool == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( thread_mutex_grab(
+	     &( read_ahead_pool->mutex ) ) != 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk != read_ahead_pool->last_read_chunk )
+	{
+		if( chunk == ( read_ahead_pool->last_read_chunk + 1 ) )
+		{
+			if( read_ahead_pool->amount_of_sequential_chunks < LIBEWF_READ_AHEAD_POOL_SEQUENTIAL_THRESHOLD )
+			{
+				read_ahead_pool->amount_of_sequential_chunks += 1;
+			}
+		}
+		else
+		{
+			read_ahead_pool->amount_of_sequential_chunks = 0;
+			read_ahead_pool->amount_of_queued_chunks     = 0;
+			read_ahead_pool->next_chunk                  = chunk + 1;
+		}
+		read_ahead_pool->last_read_chunk = chunk;
+	}
+	if( read_ahead_pool->amount_of_sequential_chunks >= LIBEWF_READ_AHEAD_POOL_SEQUENTIAL_THRESHOLD )
+	{
+		if( read_ahead_pool->next_chunk <= chunk )
+		{
+			read_ahead_pool->next_chunk = chunk + 1;
+		}
+		last_chunk = chunk + (uint32_t) read_ahead_pool->maximum_amount_of_chunks;
+
+		if( last_chunk >= read_ahead_pool->offset_table->amount_of_chunk_offsets )
+		{
+			last_chunk = read_ahead_pool->offset_table->amount_of_chunk_offsets - 1;
+		}
+		while( ( read_ahead_pool->next_chunk <= last_chunk )
+		    && ( read_ahead_pool->amount_of_queued_chunks < read_ahead_pool->maximum_amount_of_chunks ) )
+		{
+			queued_chunk_index = ( read_ahead_pool->first_queued_chunk + read_ahead_pool->amount_of_queued_chunks )
+			                   % read_ahead_pool->maximum_amount_of_chunks;
+
+			read_ahead_pool->queued_chunks[ queued_chunk_index ] = read_ahead_pool->next_chunk;
+
+			read_ahead_pool->amount_of_queued_chunks += 1;
+			read_ahead_pool->next_chunk              += 1;
+
+			amount_of_new_chunks++;
+		}
+		if( amount_of_new_chunks > 0 )
+		{
+			thread_condition_broadcast(
+			 &( read_ahead_pool->queued_condition ) );
+		}
+	}
+	if( thread_mutex_release(
+	     &( read_ahead_pool->mutex ) ) != 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Waits until the chunk is no longer being read by one of the threads
+ * this prevents the chunk from being read and decompressed twice
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_ahead_pool_wait_for_chunk(
+     libewf_read_ahead_pool_t *read_ahead_pool,
+     uint32_t chunk,
+     liberror_error_t **error )
+{
+	static char *function = "libewf_read_ahead_pool_wait_for_chunk";
+	int thread_index      = 0;
+
+	if( read_ahead_pool == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( thread_mutex_grab(
+	     &( read_ahead_pool->mutex ) ) != 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( thread_index < read_ahead_pool->amount_of_threads )
+	{
+		if( read_ahead_pool->processing_chunks[ thread_index ] == (int64_t) chunk )
+		{
+			thread_condition_wait(
+			 &( read_ahead_pool->processed_condition ),
+			 &( read_ahead_pool->mutex ) );
+
+			thread_index = 0;
+		}
+		else
+		{
+			thread_index++;
+		}
+	}
+	if( thread_mutex_release(
+	     &( read_ahead_pool->mutex ) ) != 0 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#endif
+
@@ -0,0 +1,168 @@
+/*
+ * Read-ahead pool functions
+ *
+ * Copyright (c) 2006-2009, Joachim Metz <forensics@hoffmannbv.nl>,
+ * Hoffmann Investigations.
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_READ_AHEAD_POOL_H )
+#define _LIBEWF_READ_AHEAD_POOL_H
+
+#include <common.h>
+#include <thread.h>
+#include <types.h>
+
+#include <liberror.h>
+
+#include "libewf_chunk_cache.h"
+#include "libewf_io_handle.h"
+#include "libewf_media_values.h"
+#include "libewf_offset_table.h"
+#include "libewf_read_io_handle.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* The amount of chunks read ahead per thread
+ */
+#define LIBEWF_READ_AHEAD_POOL_CHUNKS_PER_THREAD	4
+
+/* The amount of consecutive chunks that need to be read
+ * before the reads are considered sequential
+ */
+#define LIBEWF_READ_AHEAD_POOL_SEQUENTIAL_THRESHOLD	2
+
+typedef struct libewf_read_ahead_pool libewf_read_ahead_pool_t;
+
+struct libewf_read_ahead_pool
+{
+	/* The read io handle
+	 */
+	libewf_read_io_handle_t *read_io_handle;
+
+	/* The io handle
+	 */
+	libewf_io_handle_t *io_handle;
+
+	/* The media values
+	 */
+	libewf_media_values_t *media_values;
+
+	/* The offset table
+	 */
+	libewf_offset_table_t *offset_table;
+
+	/* The chunk cache the chunks are read into
+	 */
+	libewf_chunk_cache_t *chunk_cache;
+
+	/* The amount of threads
+	 */
+	int amount_of_threads;
+
+	/* Dynamic array of the threads
+	 */
+	thread_t *threads;
+
+	/* Dynamic array of the chunk processed per thread or -1 if not set
+	 */
+	int64_t *processing_chunks;
+
+	/* The maximum amount of chunks to read ahead
+	 */
+	int maximum_amount_of_chunks;
+
+	/* Dynamic array of the queued chunks, used as a ring buffer
+	 */
+	uint32_t *queued_chunks;
+
+	/* The index of the first queued chunk
+	 */
+	int first_queued_chunk;
+
+	/* The amount of queued chunks
+	 */
+	int amount_of_queued_chunks;
+
+	/* The chunk that was last read
+	 */
+	uint32_t last_read_chunk;
+
+	/* The amount of consecutive chunks read
+	 */
+	int amount_of_sequential_chunks;
+
+	/* The next chunk to read ahead
+	 */
+	uint32_t next_chunk;
+
+	/* Value to indicate the threads should stop
+	 */
+	uint8_t stop_threads;
+
+	/* The mutex that protects the queue
+	 */
+	thread_mutex_t mutex;
+
+	/* The condition that signals the threads a chunk was queued
+	 */
+	thread_condition_t queued_condition;
+
+	/* The condition that signals a chunk was read
+	 */
+	thread_condition_t processed_condition;
+};
+
+int libewf_read_ahead_pool_initialize(
+     libewf_read_ahead_pool_t **read_ahead_pool,
+     libewf_read_io_handle_t *read_io_handle,
+     libewf_io_handle_t *io_handle,
+     libewf_media_values_t *media_values,
+     libewf_offset_table_t *offset_table,
+     libewf_chunk_cache_t *chunk_cache,
+     int amount_of_threads,
+     liberror_error_t **error );
+
+int libewf_read_ahead_pool_free(
+     libewf_read_ahead_pool_t **read_ahead_pool,
+     liberror_error_t **error );
+
+void *libewf_read_ahead_pool_read_chunks(
+       void *arguments );
+
+int libewf_read_ahead_pool_queue_chunks(
+     libewf_read_ahead_pool_t *read_ahead_pool,
+     uint32_t chunk,
+     liberror_error_t **error );
+
+int libewf_read_ahead_pool_wait_for_chunk(
+     libewf_read_ahead_pool_t *read_ahead_pool,
+     uint32_t chunk,
+     liberror_error_t **error );
+
+#endif
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif
+
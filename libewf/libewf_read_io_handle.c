@@ -30,12 +30,15 @@
 #include "libewf_definitions.h"
 #include "libewf_compression.h"
 #include "libewf_chunk_cache.h"
+#include "libewf_chunk_offset.h"
+#include "libewf_empty_block.h"
 #include "libewf_libbfio.h"
 #include "libewf_media_values.h"
 #include "libewf_offset_table.h"
 #include "libewf_read_io_handle.h"
 #include "libewf_sector_table.h"
 #include "libewf_segment_file_handle.h"
+#include "libewf_statistics.h"
 
 #include "ewf_crc.h"
 #include "ewf_file_header.h"
@@ -176,10 +179,12 @@ ssize_t libewf_read_io_handle_process_chunk(
          ewf_crc_t chunk_crc,
          int8_t read_crc,
          uint8_t *crc_mismatch,
+         libewf_statistics_t *statistics,
          liberror_error_t **error )
 {
 	uint8_t *crc_buffer      = NULL;
 	static char *function    = "libewf_read_io_handle_process_chunk";
+	uint64_t timestamp       = 0;
 	ewf_crc_t calculated_crc = 0;
 
 	if( chunk_buffer == NULL )
@@ -234,11 +239,21 @@ ssize_t libewf_read_io_handle_process_chunk(
 			 crc_buffer,
 			 chunk_crc );
 		}
+		if( statistics != NULL )
+		{
+			timestamp = libewf_statistics_get_timestamp();
+		}
 		calculated_crc = ewf_crc_calculate(
 		                  chunk_buffer,
 		                  chunk_buffer_size,
 		                  1 );
 
+		if( statistics != NULL )
+		{
+			libewf_statistics_add_time(
+			 statistics->checksum_time,
+			 timestamp );
+		}
 		if( chunk_crc != calculated_crc )
 		{
 #if defined( HAVE_VERBOSE_OUTPUT )
@@ -250,6 +265,13 @@ ssize_t libewf_read_io_handle_process_chunk(
 #endif
 
 			*crc_mismatch = 1;
+
+			if( statistics != NULL )
+			{
+				libewf_statistics_add(
+				 statistics->amount_of_crc_errors,
+				 1 );
+			}
 		}
 		*uncompressed_buffer_size = chunk_buffer_size;
 	}
@@ -288,6 +310,12 @@ ssize_t libewf_read_io_handle_process_chunk(
 
 			return( -1 );
 		}
+		/* The decompression time includes the Adler-32 validation done by zlib
+		 */
+		if( statistics != NULL )
+		{
+			timestamp = libewf_statistics_get_timestamp();
+		}
 		if( libewf_uncompress(
 		     uncompressed_buffer,
 		     uncompressed_buffer_size,
@@ -304,10 +332,249 @@ ssize_t libewf_read_io_handle_process_chunk(
 
 			return( -1 );
 		}
+		if( statistics != NULL )
+		{
+			libewf_statistics_add_time(
+			 statistics->decompression_time,
+			 timestamp );
+		}
+	}
+	if( statistics != NULL )
+	{
+		libewf_statistics_add(
+		 statistics->amount_of_media_bytes_read,
+		 *uncompressed_buffer_size );
 	}
 	return( (ssize_t) *uncompressed_buffer_size );
 }
 
+/* Reads the chunk offsets of the table section that contains the chunk
+ * if the offset table reads them on demand
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_io_handle_read_table_section(
+     libewf_io_handle_t *io_handle,
+     libewf_offset_table_t *offset_table,
+     uint32_t chunk,
+     liberror_error_t **error )
+{
+	static char *function = "libewf_read_io_handle_read_table_section";
+	int result            = 0;
+
+	if( io_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid io handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset_table == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset table.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset_table->read_on_demand == 0 )
+	{
+		return( 1 );
+	}
+	/* The table section is read using the file io pool
+	 * which also protects the table section from being read twice
+	 */
+	if( libewf_io_handle_grab_file_io_pool(
+	     io_handle,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab file io pool.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_offset_table_read_table_section(
+	          offset_table,
+	          chunk,
+	          io_handle->file_io_pool,
+	          error );
+
+	if( result == -1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_IO,
+		 LIBERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read table section of chunk: %" PRIu32 ".",
+		 function,
+		 chunk );
+	}
+	if( libewf_io_handle_release_file_io_pool(
+	     io_handle,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release file io pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( result == -1 )
+	{
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Determines the size of the data of a specific chunk
+ * The last chunk can be smaller than the chunk size
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_io_handle_get_chunk_data_size(
+     libewf_media_values_t *media_values,
+     uint32_t chunk,
+     size_t *chunk_data_size,
+     liberror_error_t **error )
+{
+	static char *function = "libewf_read_io_handle_get_chunk_data_size";
+	size64_t chunk_start  = 0;
+
+	if( media_values == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data_size == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data size.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_start      = (size64_t) chunk * (size64_t) media_values->chunk_size;
+	*chunk_data_size = (size_t) media_values->chunk_size;
+
+	if( ( media_values->media_size != 0 )
+	 && ( ( chunk_start + (size64_t) *chunk_data_size ) > media_values->media_size ) )
+	{
+		if( chunk_start >= media_values->media_size )
+		{
+			*chunk_data_size = 0;
+		}
+		else
+		{
+			*chunk_data_size = (size_t) ( media_values->media_size - chunk_start );
+		}
+	}
+	return( 1 );
+}
+
+/* Sets a chunk as an empty block that consists of a single repeated byte value
+ * The compressed data of the empty block is remembered in the chunk cache
+ * so that chunks with the same compressed data do not need to be decompressed
+ * The chunk is marked empty in the offset table if it only contains zero bytes
+ * The chunk cache should be grabbed for writing by the caller
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_io_handle_set_empty_block(
+     libewf_media_values_t *media_values,
+     libewf_offset_table_t *offset_table,
+     libewf_chunk_cache_t *chunk_cache,
+     uint32_t chunk,
+     const uint8_t *compressed,
+     size_t compressed_size,
+     uint8_t value,
+     size_t uncompressed_size,
+     liberror_error_t **error )
+{
+	static char *function  = "libewf_read_io_handle_set_empty_block";
+	size_t chunk_data_size = 0;
+
+	if( libewf_chunk_cache_add_empty_block(
+	     chunk_cache,
+	     compressed,
+	     compressed_size,
+	     value,
+	     uncompressed_size,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to add empty block.",
+		 function );
+
+		return( -1 );
+	}
+	if( value != 0 )
+	{
+		return( 1 );
+	}
+	if( libewf_read_io_handle_get_chunk_data_size(
+	     media_values,
+	     chunk,
+	     &chunk_data_size,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk data size.",
+		 function );
+
+		return( -1 );
+	}
+	/* Only mark the chunk empty if its size is the expected size
+	 * otherwise the chunk is read as stored
+	 */
+	if( ( chunk_data_size != 0 )
+	 && ( chunk_data_size == uncompressed_size ) )
+	{
+		if( libewf_offset_table_set_chunk_flags(
+		     offset_table,
+		     chunk,
+		     LIBEWF_CHUNK_OFFSET_FLAGS_EMPTY_BLOCK,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set flags of chunk: %" PRIu32 ".",
+			 function,
+			 chunk );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
 /* Reads a certain chunk of data into the chunk buffer
  * Will read until the requested size is filled or the entire chunk is read
  * read_crc is set if the crc has been read into crc_buffer
@@ -327,14 +594,20 @@ ssize_t libewf_read_io_handle_read_chunk(
          int8_t *read_crc,
          liberror_error_t **error )
 {
+	libbfio_handle_t *file_io_handle                  = NULL;
 	libewf_segment_file_handle_t *segment_file_handle = NULL;
 #if defined( HAVE_VERBOSE_OUTPUT )
         char *chunk_type                                  = NULL;
 #endif
 	static char *function                             = "libewf_read_io_handle_read_chunk";
+	off64_t file_offset                               = 0;
+	uint64_t timestamp                                = 0;
 	ssize_t read_count                                = 0;
 	ssize_t total_read_count                          = 0;
 	size_t chunk_size                                 = 0;
+	uint8_t chunk_flags                               = 0;
+	uint8_t crc_is_aligned                            = 0;
+	int result                                        = 0;
 
 	if( io_handle == NULL )
 	{
@@ -445,13 +718,46 @@ ssize_t libewf_read_io_handle_read_chunk(
 	*read_crc      = 0;
 	*is_compressed = 0;
 
+	if( libewf_read_io_handle_read_table_section(
+	     io_handle,
+	     offset_table,
+	     chunk,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_IO,
+		 LIBERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read table section of chunk: %" PRIu32 ".",
+		 function,
+		 chunk );
+
+		return( -1 );
+	}
 	/* Determine the size of the chunk including the CRC
 	 */
-	chunk_size = offset_table->chunk_offset[ chunk ].size;
+	if( libewf_offset_table_get_chunk_offset(
+	     offset_table,
+	     chunk,
+	     &segment_file_handle,
+	     &file_offset,
+	     &chunk_size,
+	     &chunk_flags,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk offset: %" PRIu32 ".",
+		 function,
+		 chunk );
 
+		return( -1 );
+	}
 	/* Determine if the chunk is compressed or not
 	 */
-	if( ( offset_table->chunk_offset[ chunk ].flags & LIBEWF_CHUNK_OFFSET_FLAGS_COMPRESSED ) == LIBEWF_CHUNK_OFFSET_FLAGS_COMPRESSED )
+	if( ( chunk_flags & LIBEWF_CHUNK_OFFSET_FLAGS_COMPRESSED ) == LIBEWF_CHUNK_OFFSET_FLAGS_COMPRESSED )
 	{
 		*is_compressed = 1;
 	}
@@ -460,8 +766,6 @@ ssize_t libewf_read_io_handle_read_chunk(
 		chunk_size -= sizeof( ewf_crc_t );
 		*read_crc   = 1;
 	}
-	segment_file_handle = offset_table->chunk_offset[ chunk ].segment_file_handle;
-
 	if( segment_file_handle == NULL )
 	{
 		liberror_error_set(
@@ -473,26 +777,77 @@ ssize_t libewf_read_io_handle_read_chunk(
 
 		return( -1 );
 	}
-	/* Make sure the segment file offset is in the right place
+	if( ( *read_crc != 0 )
+	 && ( crc_buffer == NULL ) )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid crc buffer.",
+		 function );
+
+		return( -1 );
+	}
+	/* The file io pool must not be used by other threads while reading
+	 * since it can open and close file io handles on demand
 	 */
-	if( libbfio_pool_seek_offset(
-	     io_handle->file_io_pool,
-	     segment_file_handle->file_io_pool_entry,
-	     offset_table->chunk_offset[ chunk ].file_offset,
-	     SEEK_SET,
-	     error ) <= -1 )
+	if( libewf_io_handle_grab_file_io_pool(
+	     io_handle,
+	     error ) != 1 )
 	{
 		liberror_error_set(
 		 error,
-		 LIBERROR_ERROR_DOMAIN_IO,
-		 LIBERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek chunk in segment file.",
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab file io pool.",
+		 function );
+
+		return( -1 );
+	}
+	/* If the pool cannot close the file io handle, e.g. when the amount of open handles
+	 * is unlimited, the chunk is read from the file io handle without holding the pool
+	 * so that the positional reads of multiple threads are not serialized
+	 */
+	result = libbfio_pool_get_handle_for_concurrent_read(
+	          io_handle->file_io_pool,
+	          segment_file_handle->file_io_pool_entry,
+	          &file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file io handle for concurrent read.",
 		 function );
 
+		libewf_io_handle_release_file_io_pool(
+		 io_handle,
+		 NULL );
+
 		return( -1 );
 	}
+	else if( result != 0 )
+	{
+		if( libewf_io_handle_release_file_io_pool(
+		     io_handle,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release file io pool.",
+			 function );
+
+			return( -1 );
+		}
+	}
 #if defined( HAVE_VERBOSE_OUTPUT )
-	if( ( offset_table->chunk_offset[ chunk ].flags & LIBEWF_CHUNK_OFFSET_FLAGS_DELTA_CHUNK ) == LIBEWF_CHUNK_OFFSET_FLAGS_DELTA_CHUNK )
+	if( ( chunk_flags & LIBEWF_CHUNK_OFFSET_FLAGS_DELTA_CHUNK ) == LIBEWF_CHUNK_OFFSET_FLAGS_DELTA_CHUNK )
 	{
 		chunk_type = "uncompressed delta";
 	}
@@ -510,8 +865,8 @@ ssize_t libewf_read_io_handle_read_chunk(
 	 chunk_type,
 	 chunk,
 	 offset_table->amount_of_chunk_offsets,
-	 offset_table->chunk_offset[ chunk ].file_offset,
-	 offset_table->chunk_offset[ chunk ].size );
+	 file_offset,
+	 chunk_size );
 #endif
 
 	/* Check if the chunk and crc buffers are aligned
@@ -521,17 +876,32 @@ ssize_t libewf_read_io_handle_read_chunk(
 	 && ( *read_crc != 0 )
 	 && ( &( chunk_buffer[ chunk_size ] ) == crc_buffer ) )
 	{
-		chunk_size += sizeof( ewf_crc_t );
+		chunk_size    += sizeof( ewf_crc_t );
+		crc_is_aligned = 1;
 	}
-	/* Read the chunk data
-	 */
-	read_count = libbfio_pool_read(
-	              io_handle->file_io_pool,
-	              segment_file_handle->file_io_pool_entry,
-	              chunk_buffer,
-	              chunk_size,
-	              error );
+	timestamp = libewf_statistics_get_timestamp();
 
+	/* Read the chunk data at its offset, this does not require a seek
+	 */
+	if( file_io_handle != NULL )
+	{
+		read_count = libbfio_handle_read_at_offset(
+		              file_io_handle,
+		              chunk_buffer,
+		              chunk_size,
+		              file_offset,
+		              error );
+	}
+	else
+	{
+		read_count = libbfio_pool_read_at_offset(
+		              io_handle->file_io_pool,
+		              segment_file_handle->file_io_pool_entry,
+		              chunk_buffer,
+		              chunk_size,
+		              file_offset,
+		              error );
+	}
 	if( read_count != (ssize_t) chunk_size )
 	{
 		liberror_error_set(
@@ -541,6 +911,12 @@ ssize_t libewf_read_io_handle_read_chunk(
 		 "%s: unable to read chunk in segment file.",
 		 function );
 
+		if( file_io_handle == NULL )
+		{
+			libewf_io_handle_release_file_io_pool(
+			 io_handle,
+			 NULL );
+		}
 		return( -1 );
 	}
 	total_read_count += read_count;
@@ -552,26 +928,27 @@ ssize_t libewf_read_io_handle_read_chunk(
 		/* Check if the chunk and crc buffers are aligned
 		 * if not the chunk and crc need to be read separately
 		 */
-		if( &( chunk_buffer[ chunk_size ] ) != crc_buffer )
+		if( crc_is_aligned == 0 )
 		{
-			if( crc_buffer == NULL )
+			if( file_io_handle != NULL )
 			{
-				liberror_error_set(
-				 error,
-				 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
-				 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
-				 "%s: invalid crc buffer.",
-				 function );
-
-				return( -1 );
+				read_count = libbfio_handle_read_at_offset(
+				              file_io_handle,
+				              crc_buffer,
+				              sizeof( ewf_crc_t ),
+				              file_offset + (off64_t) chunk_size,
+				              error );
+			}
+			else
+			{
+				read_count = libbfio_pool_read_at_offset(
+				              io_handle->file_io_pool,
+				              segment_file_handle->file_io_pool_entry,
+				              crc_buffer,
+				              sizeof( ewf_crc_t ),
+				              file_offset + (off64_t) chunk_size,
+				              error );
 			}
-			read_count = libbfio_pool_read(
-			              io_handle->file_io_pool,
-			              segment_file_handle->file_io_pool_entry,
-			              crc_buffer,
-			              sizeof( ewf_crc_t ),
-			              error );
-
 			if( read_count != (ssize_t) sizeof( ewf_crc_t ) )
 			{
 				liberror_error_set(
@@ -582,10 +959,47 @@ ssize_t libewf_read_io_handle_read_chunk(
 				 function,
 				 chunk );
 
+				if( file_io_handle == NULL )
+				{
+					libewf_io_handle_release_file_io_pool(
+					 io_handle,
+					 NULL );
+				}
 				return( -1 );
 			}
 			total_read_count += read_count;
 		}
+	}
+	libewf_statistics_add_time(
+	 io_handle->statistics.io_time,
+	 timestamp );
+
+	libewf_statistics_add(
+	 io_handle->statistics.amount_of_chunks_read,
+	 1 );
+
+	libewf_statistics_add(
+	 io_handle->statistics.amount_of_stored_bytes_read,
+	 total_read_count );
+
+	if( file_io_handle == NULL )
+	{
+		if( libewf_io_handle_release_file_io_pool(
+		     io_handle,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release file io pool.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( *read_crc != 0 )
+	{
 		byte_stream_copy_to_uint32_little_endian(
 		 crc_buffer,
 		 *chunk_crc );
@@ -609,23 +1023,32 @@ ssize_t libewf_read_io_handle_read_chunk_data(
          size_t size,
          liberror_error_t **error )
 {
+	uint8_t stored_buffer_data[ 4 ];
 	uint8_t stored_crc_buffer[ 4 ];
 
-	uint8_t *chunk_buffer      = NULL;
-	uint8_t *chunk_read_buffer = NULL;
-	uint8_t *crc_read_buffer   = NULL;
-	static char *function      = "libewf_read_io_handle_read_chunk_data";
-	ewf_crc_t chunk_crc        = 0;
-	size_t chunk_data_size     = 0;
-	size_t chunk_size          = 0;
-	size_t bytes_available     = 0;
-	ssize_t read_count         = 0;
-	int64_t sector             = 0;
-	uint32_t amount_of_sectors = 0;
-	int chunk_cache_data_used  = 0;
-	uint8_t crc_mismatch       = 0;
-	int8_t is_compressed       = 0;
-	int8_t read_crc            = 0;
+	libewf_chunk_cache_entry_t *cache_entry           = NULL;
+	libewf_segment_file_handle_t *segment_file_handle = NULL;
+	uint8_t *chunk_buffer                             = NULL;
+	uint8_t *chunk_read_buffer                        = NULL;
+	uint8_t *crc_read_buffer                          = NULL;
+	static char *function                             = "libewf_read_io_handle_read_chunk_data";
+	ewf_crc_t chunk_crc                               = 0;
+	off64_t file_offset                               = 0;
+	size_t chunk_data_size                            = 0;
+	size_t chunk_size                                 = 0;
+	size_t bytes_available                            = 0;
+	ssize_t read_count                                = 0;
+	int64_t sector                                    = 0;
+	uint32_t amount_of_sectors                        = 0;
+	int chunk_cache_data_used                         = 0;
+	int result                                        = 0;
+	size_t empty_block_size                           = 0;
+	uint8_t chunk_flags                               = 0;
+	uint8_t crc_mismatch                              = 0;
+	uint8_t empty_block_value                         = 0;
+	uint8_t restore_buffer_data                       = 0;
+	int8_t is_compressed                              = 0;
+	int8_t read_crc                                   = 0;
 
 	if( read_io_handle == NULL )
 	{
@@ -638,6 +1061,17 @@ ssize_t libewf_read_io_handle_read_chunk_data(
 
 		return( -1 );
 	}
+	if( io_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid io handle.",
+		 function );
+
+		return( -1 );
+	}
 	if( media_values == NULL )
 	{
 		liberror_error_set(
@@ -704,16 +1138,123 @@ ssize_t libewf_read_io_handle_read_chunk_data(
 
 		return( -1 );
 	}
-	/* Check if the chunk is not cached
-	 */
-	if( ( chunk_cache->chunk != chunk )
-	 || ( chunk_cache->cached == 0 ) )
-	{
-		/* Determine the size of the chunk including the CRC
-		 */
-		chunk_size = offset_table->chunk_offset[ chunk ].size;
+	result = libewf_chunk_cache_get_entry(
+	          chunk_cache,
+	          chunk,
+	          &cache_entry,
+	          error );
 
-		/* Make sure the chunk cache is large enough
+	if( result == -1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk cache entry.",
+		 function );
+
+		return( -1 );
+	}
+	/* Check if the chunk is not cached
+	 */
+	else if( result == 0 )
+	{
+		libewf_statistics_add(
+		 io_handle->statistics.amount_of_chunk_cache_misses,
+		 1 );
+
+		if( libewf_read_io_handle_read_table_section(
+		     io_handle,
+		     offset_table,
+		     chunk,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read table section of chunk: %" PRIu32 ".",
+			 function,
+			 chunk );
+
+			return( -1 );
+		}
+		/* Determine the size of the chunk including the CRC
+		 */
+		if( libewf_offset_table_get_chunk_offset(
+		     offset_table,
+		     chunk,
+		     &segment_file_handle,
+		     &file_offset,
+		     &chunk_size,
+		     &chunk_flags,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk offset: %" PRIu32 ".",
+			 function,
+			 chunk );
+
+			return( -1 );
+		}
+		/* The data of an empty block of zero bytes is set directly in the buffer
+		 * the chunk is not read and is not stored in the chunk cache
+		 */
+		if( ( chunk_flags & LIBEWF_CHUNK_OFFSET_FLAGS_EMPTY_BLOCK ) != 0 )
+		{
+			if( libewf_read_io_handle_get_chunk_data_size(
+			     media_values,
+			     chunk,
+			     &chunk_data_size,
+			     error ) != 1 )
+			{
+				liberror_error_set(
+				 error,
+				 LIBERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve chunk data size.",
+				 function );
+
+				return( -1 );
+			}
+			if( chunk_offset > chunk_data_size )
+			{
+				liberror_error_set(
+				 error,
+				 LIBERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBERROR_RUNTIME_ERROR_VALUE_OUT_OF_RANGE,
+				 "%s: chunk offset exceeds amount of bytes available in chunk.",
+				 function );
+
+				return( -1 );
+			}
+			bytes_available = chunk_data_size - chunk_offset;
+
+			if( bytes_available > size )
+			{
+				bytes_available = size;
+			}
+			if( ( bytes_available > 0 )
+			 && ( memory_set(
+			       buffer,
+			       0,
+			       bytes_available ) == NULL ) )
+			{
+				liberror_error_set(
+				 error,
+				 LIBERROR_ERROR_DOMAIN_MEMORY,
+				 LIBERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to set empty block data in buffer.",
+				 function );
+
+				return( -1 );
+			}
+			return( (ssize_t) bytes_available );
+		}
+		/* Make sure the chunk cache is large enough
 		 */
 		chunk_cache_data_used = (int) ( buffer == chunk_cache->data );
 
@@ -748,7 +1289,7 @@ ssize_t libewf_read_io_handle_read_chunk_data(
 				buffer = chunk_cache->data;
 			}
 		}
-		if( ( offset_table->chunk_offset[ chunk ].flags & LIBEWF_CHUNK_OFFSET_FLAGS_COMPRESSED ) == 0 )
+		if( ( chunk_flags & LIBEWF_CHUNK_OFFSET_FLAGS_COMPRESSED ) == 0 )
 		{
 			is_compressed = 0;
 		}
@@ -756,18 +1297,19 @@ ssize_t libewf_read_io_handle_read_chunk_data(
 		{
 			is_compressed = 1;
 		}
-		chunk_buffer = chunk_cache->data;
-
 		/* Directly read to the buffer if
 		 *  the buffer isn't the chunk cache
 		 *  and no data was previously copied into the chunk cache
-		 *  and the buffer contains the necessary amount of bytes to fill a chunk
+		 *  and the buffer contains the necessary amount of bytes to hold the chunk data
 		 *  and the buffer is not compressed
+		 * this includes the last chunk, which can be smaller than the chunk size
 		 */
 		if( ( buffer != chunk_cache->data )
 		 && ( chunk_offset == 0 )
-		 && ( size >= (size_t) media_values->chunk_size )
-		 && ( is_compressed == 0 ) )
+		 && ( is_compressed == 0 )
+		 && ( chunk_size > sizeof( ewf_crc_t ) )
+		 && ( ( chunk_size - sizeof( ewf_crc_t ) ) <= size )
+		 && ( ( chunk_size - sizeof( ewf_crc_t ) ) <= (size_t) media_values->chunk_size ) )
 		{
 			chunk_buffer = buffer;
 
@@ -775,6 +1317,28 @@ ssize_t libewf_read_io_handle_read_chunk_data(
 			 */
 			chunk_size -= sizeof( ewf_crc_t );
 		}
+		else
+		{
+			/* The chunk data is stored in the least recently used cache entry
+			 */
+			if( libewf_chunk_cache_set_entry(
+			     chunk_cache,
+			     chunk,
+			     chunk_cache->allocated_size,
+			     &cache_entry,
+			     error ) != 1 )
+			{
+				liberror_error_set(
+				 error,
+				 LIBERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set chunk cache entry.",
+				 function );
+
+				return( -1 );
+			}
+			chunk_buffer = cache_entry->data;
+		}
 		/* Determine if the chunk data should be directly read into chunk data buffer
 		 * or to use the intermediate storage for a compressed chunk
 		 */
@@ -786,12 +1350,37 @@ ssize_t libewf_read_io_handle_read_chunk_data(
 		{
 			chunk_read_buffer = chunk_buffer;
 		}
-		/* Use chunk and crc buffer alignment when the chunk cache data is directly being passed
+		/* Use chunk and crc buffer alignment when the chunk cache entry data is directly being passed
 		 */
-		if( chunk_read_buffer == chunk_cache->data )
+		if( ( cache_entry != NULL )
+		 && ( chunk_read_buffer == cache_entry->data ) )
 		{
 			crc_read_buffer = &( chunk_read_buffer[ media_values->chunk_size ] );
 		}
+		/* If the buffer has room behind the chunk data, the CRC is read
+		 * together with the chunk and the overwritten bytes are restored afterwards
+		 */
+		else if( ( chunk_read_buffer == buffer )
+		      && ( ( chunk_size + sizeof( ewf_crc_t ) ) <= size ) )
+		{
+			crc_read_buffer = &( chunk_read_buffer[ chunk_size ] );
+
+			if( memory_copy(
+			     stored_buffer_data,
+			     crc_read_buffer,
+			     sizeof( ewf_crc_t ) ) == NULL )
+			{
+				liberror_error_set(
+				 error,
+				 LIBERROR_ERROR_DOMAIN_MEMORY,
+				 LIBERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to store buffer data.",
+				 function );
+
+				return( -1 );
+			}
+			restore_buffer_data = 1;
+		}
 		else
 		{
 			crc_read_buffer = stored_crc_buffer;
@@ -810,6 +1399,21 @@ ssize_t libewf_read_io_handle_read_chunk_data(
 		              &read_crc,
 		              error );
 
+		if( ( restore_buffer_data != 0 )
+		 && ( memory_copy(
+		       crc_read_buffer,
+		       stored_buffer_data,
+		       sizeof( ewf_crc_t ) ) == NULL ) )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_MEMORY,
+			 LIBERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to restore buffer data.",
+			 function );
+
+			read_count = -1;
+		}
 		if( read_count <= -1 )
 		{
 			liberror_error_set(
@@ -819,6 +1423,13 @@ ssize_t libewf_read_io_handle_read_chunk_data(
 			 "%s: unable to read chunk.",
 			 function );
 
+			if( cache_entry != NULL )
+			{
+				libewf_chunk_cache_remove_entry(
+				 chunk_cache,
+				 chunk,
+				 NULL );
+			}
 			return( -1 );
 		}
 		if( is_compressed != 0 )
@@ -830,7 +1441,71 @@ ssize_t libewf_read_io_handle_read_chunk_data(
 		{
 			chunk_data_size = chunk_size;
 		}
-		if( libewf_read_io_handle_process_chunk(
+		/* Check if the compressed data is that of a known empty block
+		 */
+		result = 0;
+
+		if( ( is_compressed != 0 )
+		 && ( chunk_size <= LIBEWF_CHUNK_CACHE_EMPTY_BLOCK_MAXIMUM_COMPRESSED_SIZE ) )
+		{
+			result = libewf_chunk_cache_get_empty_block(
+			          chunk_cache,
+			          chunk_read_buffer,
+			          chunk_size,
+			          &empty_block_value,
+			          &empty_block_size,
+			          error );
+
+			if( result == -1 )
+			{
+				liberror_error_set(
+				 error,
+				 LIBERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve empty block.",
+				 function );
+
+				if( cache_entry != NULL )
+				{
+					libewf_chunk_cache_remove_entry(
+					 chunk_cache,
+					 chunk,
+					 NULL );
+				}
+				return( -1 );
+			}
+			else if( ( result != 0 )
+			      && ( empty_block_size > chunk_data_size ) )
+			{
+				result = 0;
+			}
+		}
+		if( result != 0 )
+		{
+			if( memory_set(
+			     chunk_buffer,
+			     empty_block_value,
+			     empty_block_size ) == NULL )
+			{
+				liberror_error_set(
+				 error,
+				 LIBERROR_ERROR_DOMAIN_MEMORY,
+				 LIBERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to set empty block data.",
+				 function );
+
+				if( cache_entry != NULL )
+				{
+					libewf_chunk_cache_remove_entry(
+					 chunk_cache,
+					 chunk,
+					 NULL );
+				}
+				return( -1 );
+			}
+			chunk_data_size = empty_block_size;
+		}
+		else if( libewf_read_io_handle_process_chunk(
 		     chunk_read_buffer,
 		     chunk_size,
 		     chunk_buffer,
@@ -839,6 +1514,7 @@ ssize_t libewf_read_io_handle_read_chunk_data(
 		     chunk_crc,
 		     read_crc,
 		     &crc_mismatch,
+		     &( io_handle->statistics ),
 		     error ) == -1 )
 		{
 			liberror_error_set(
@@ -848,27 +1524,64 @@ ssize_t libewf_read_io_handle_read_chunk_data(
 			 "%s: unable to process chunk data.",
 			 function );
 
+			if( cache_entry != NULL )
+			{
+				libewf_chunk_cache_remove_entry(
+				 chunk_cache,
+				 chunk,
+				 NULL );
+			}
 			return( -1 );
 		}
-		if( crc_mismatch != 0 )
+		/* Remember the compressed data if the chunk is an empty block
+		 */
+		if( ( is_compressed != 0 )
+		 && ( chunk_size <= LIBEWF_CHUNK_CACHE_EMPTY_BLOCK_MAXIMUM_COMPRESSED_SIZE )
+		 && ( chunk_data_size > 0 ) )
 		{
-			/* Wipe the chunk if nescessary
-			 */
-			if( ( read_io_handle->wipe_on_error != 0 )
-			 && ( memory_set(
-			       chunk_read_buffer,
-			       0,
-			       size ) == NULL ) )
+			if( result == 0 )
+			{
+				result = libewf_empty_block_test(
+				          chunk_buffer,
+				          chunk_data_size,
+				          error );
+
+				empty_block_value = chunk_buffer[ 0 ];
+			}
+			if( result == 1 )
+			{
+				result = libewf_read_io_handle_set_empty_block(
+				          media_values,
+				          offset_table,
+				          chunk_cache,
+				          chunk,
+				          chunk_read_buffer,
+				          chunk_size,
+				          empty_block_value,
+				          chunk_data_size,
+				          error );
+			}
+			if( result == -1 )
 			{
 				liberror_error_set(
 				 error,
-				 LIBERROR_ERROR_DOMAIN_MEMORY,
-				 LIBERROR_MEMORY_ERROR_SET_FAILED,
-				 "%s: unable to wipe chunk data.",
+				 LIBERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set empty block.",
 				 function );
 
+				if( cache_entry != NULL )
+				{
+					libewf_chunk_cache_remove_entry(
+					 chunk_cache,
+					 chunk,
+					 NULL );
+				}
 				return( -1 );
 			}
+		}
+		if( crc_mismatch != 0 )
+		{
 			/* Add CRC error
 			 */
 			sector            = (int64_t) chunk * (int64_t) media_values->sectors_per_chunk;
@@ -892,24 +1605,57 @@ ssize_t libewf_read_io_handle_read_chunk_data(
 				 "%s: unable to set CRC error.",
 				 function );
 
+				if( cache_entry != NULL )
+				{
+					libewf_chunk_cache_remove_entry(
+					 chunk_cache,
+					 chunk,
+					 NULL );
+				}
 				return( -1 );
 			}
 			chunk_data_size = amount_of_sectors * media_values->bytes_per_sector;
+
+			/* Wipe the chunk if nescessary
+			 */
+			if( ( read_io_handle->wipe_on_error != 0 )
+			 && ( memory_set(
+			       chunk_buffer,
+			       0,
+			       chunk_data_size ) == NULL ) )
+			{
+				liberror_error_set(
+				 error,
+				 LIBERROR_ERROR_DOMAIN_MEMORY,
+				 LIBERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to wipe chunk data.",
+				 function );
+
+				if( cache_entry != NULL )
+				{
+					libewf_chunk_cache_remove_entry(
+					 chunk_cache,
+					 chunk,
+					 NULL );
+				}
+				return( -1 );
+			}
 		}
 		/* Flag that the chunk was cached
 		 */
-		if( chunk_buffer == chunk_cache->data )
+		if( cache_entry != NULL )
 		{
-			chunk_cache->chunk  = chunk;
-			chunk_cache->amount = chunk_data_size;
-			chunk_cache->offset = 0;
-			chunk_cache->cached = 1;
+			cache_entry->amount = chunk_data_size;
 		}
 	}
 	else
 	{
-		chunk_buffer    = chunk_cache->data;
-		chunk_data_size = chunk_cache->amount;
+		libewf_statistics_add(
+		 io_handle->statistics.amount_of_chunk_cache_hits,
+		 1 );
+
+		chunk_buffer    = cache_entry->data;
+		chunk_data_size = cache_entry->amount;
 	}
 	/* Determine the available amount of data within the cached chunk
 	 */
@@ -943,11 +1689,9 @@ ssize_t libewf_read_io_handle_read_chunk_data(
 
 		return( -1 );
 	}
-	/* If the data was read into the chunk cache copy it to the buffer
-	 *  and the buffer is not the chunk cache itself
+	/* If the data was read into a chunk cache entry copy it to the buffer
 	 */
-	if( ( chunk_buffer == chunk_cache->data )
-	 && ( buffer != chunk_cache->data ) )
+	if( chunk_buffer != buffer )
 	{
 		/* Copy the relevant data to buffer
 		 */
@@ -970,3 +1714,1161 @@ ssize_t libewf_read_io_handle_read_chunk_data(
 	return( (ssize_t) bytes_available );
 }
 
+/* Reads a certain chunk of data from the segment file(s)
+ * Will read until the requested size is filled or the entire chunk is read
+ * Unlike libewf_read_io_handle_read_chunk_data this function does not use the chunk cache buffers
+ * and can be called by multiple threads at the same time
+ * A buffer of NULL and a size of 0 only reads the chunk into the chunk cache
+ * Returns the amount of bytes read, 0 if no bytes can be read or -1 on error
+ */
+ssize_t libewf_read_io_handle_read_chunk_data_concurrent(
+         libewf_read_io_handle_t *read_io_handle,
+         libewf_io_handle_t *io_handle,
+         libewf_media_values_t *media_values,
+         libewf_offset_table_t *offset_table,
+         libewf_chunk_cache_t *chunk_cache,
+         uint32_t chunk,
+         uint32_t chunk_offset,
+         uint8_t *buffer,
+         size_t size,
+         liberror_error_t **error )
+{
+	uint8_t stored_crc_buffer[ 4 ];
+
+	libewf_chunk_cache_entry_t *cache_entry           = NULL;
+	libewf_segment_file_handle_t *segment_file_handle = NULL;
+	uint8_t *chunk_buffer                             = NULL;
+	uint8_t *chunk_read_buffer                        = NULL;
+	uint8_t *read_buffer                              = NULL;
+	static char *function                             = "libewf_read_io_handle_read_chunk_data_concurrent";
+	ewf_crc_t chunk_crc                               = 0;
+	off64_t file_offset                               = 0;
+	size_t bytes_available                            = 0;
+	size_t chunk_buffer_size                          = 0;
+	size_t chunk_data_size                            = 0;
+	size_t chunk_size                                 = 0;
+	ssize_t read_count                                = 0;
+	int64_t sector                                    = 0;
+	uint32_t amount_of_sectors                        = 0;
+	int entry_index                                   = 0;
+	int result                                        = 0;
+	size_t empty_block_size                           = 0;
+	uint8_t chunk_flags                               = 0;
+	uint8_t crc_mismatch                              = 0;
+	uint8_t empty_block_value                         = 0;
+	uint8_t is_most_recently_used                     = 0;
+	int8_t is_compressed                              = 0;
+	int8_t read_crc                                   = 0;
+
+	if( read_io_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read io handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid io handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset_table == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset table.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset_table->chunk_offset == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid offset table - missing chunk offsets.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_cache == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer == NULL )
+	 && ( size != 0 ) )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	/* Check if the chunk is available
+	 */
+	if( chunk >= offset_table->amount_of_chunk_offsets )
+	{
+		return( 0 );
+	}
+	/* Check if the chunk is cached, other threads are allowed to read the cache at the same time
+	 */
+	if( libewf_chunk_cache_grab_for_read(
+	     chunk_cache,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab chunk cache for reading.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_chunk_cache_find_entry(
+	          chunk_cache,
+	          chunk,
+	          &entry_index,
+	          error );
+
+	if( result == -1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to find chunk cache entry.",
+		 function );
+
+		libewf_chunk_cache_release(
+		 chunk_cache,
+		 NULL );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		cache_entry = &( chunk_cache->entries[ entry_index ] );
+
+		if( cache_entry->cached == 0 )
+		{
+			result = 0;
+		}
+	}
+	if( result != 0 )
+	{
+		libewf_statistics_add(
+		 io_handle->statistics.amount_of_chunk_cache_hits,
+		 1 );
+	}
+	else
+	{
+		libewf_statistics_add(
+		 io_handle->statistics.amount_of_chunk_cache_misses,
+		 1 );
+	}
+	if( result != 0 )
+	{
+		if( chunk_offset > cache_entry->amount )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_VALUE_OUT_OF_RANGE,
+			 "%s: chunk offset exceeds amount of bytes available in chunk.",
+			 function );
+
+			libewf_chunk_cache_release(
+			 chunk_cache,
+			 NULL );
+
+			return( -1 );
+		}
+		bytes_available = cache_entry->amount - chunk_offset;
+
+		if( bytes_available > size )
+		{
+			bytes_available = size;
+		}
+		if( ( bytes_available > 0 )
+		 && ( memory_copy(
+		       buffer,
+		       &( cache_entry->data[ chunk_offset ] ),
+		       bytes_available ) == NULL ) )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_MEMORY,
+			 LIBERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to set chunk data in buffer.",
+			 function );
+
+			libewf_chunk_cache_release(
+			 chunk_cache,
+			 NULL );
+
+			return( -1 );
+		}
+		is_most_recently_used = (uint8_t) ( chunk_cache->most_recently_used_entry == entry_index );
+	}
+	if( libewf_chunk_cache_release(
+	     chunk_cache,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( result != 0 )
+	{
+		/* Only grab the cache for writing when the recently used list needs to change
+		 */
+		if( is_most_recently_used == 0 )
+		{
+			if( libewf_chunk_cache_grab_for_write(
+			     chunk_cache,
+			     error ) != 1 )
+			{
+				liberror_error_set(
+				 error,
+				 LIBERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to grab chunk cache for writing.",
+				 function );
+
+				return( -1 );
+			}
+			/* The entry could have been evicted in the meantime
+			 * in which case there is nothing to update
+			 */
+			result = libewf_chunk_cache_get_entry(
+			          chunk_cache,
+			          chunk,
+			          &cache_entry,
+			          error );
+
+			if( libewf_chunk_cache_release(
+			     chunk_cache,
+			     NULL ) != 1 )
+			{
+				result = -1;
+			}
+			if( result == -1 )
+			{
+				liberror_error_set(
+				 error,
+				 LIBERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to update chunk cache entry.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		return( (ssize_t) bytes_available );
+	}
+	if( libewf_read_io_handle_read_table_section(
+	     io_handle,
+	     offset_table,
+	     chunk,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_IO,
+		 LIBERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read table section of chunk: %" PRIu32 ".",
+		 function,
+		 chunk );
+
+		return( -1 );
+	}
+	/* Determine the size of the chunk including the CRC
+	 */
+	if( libewf_offset_table_get_chunk_offset(
+	     offset_table,
+	     chunk,
+	     &segment_file_handle,
+	     &file_offset,
+	     &chunk_size,
+	     &chunk_flags,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk offset: %" PRIu32 ".",
+		 function,
+		 chunk );
+
+		return( -1 );
+	}
+	/* The data of an empty block of zero bytes is set directly in the buffer
+	 * the chunk is not read and is not stored in the chunk cache
+	 */
+	if( ( chunk_flags & LIBEWF_CHUNK_OFFSET_FLAGS_EMPTY_BLOCK ) != 0 )
+	{
+		if( libewf_read_io_handle_get_chunk_data_size(
+		     media_values,
+		     chunk,
+		     &chunk_data_size,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk data size.",
+			 function );
+
+			return( -1 );
+		}
+		if( chunk_offset > chunk_data_size )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_VALUE_OUT_OF_RANGE,
+			 "%s: chunk offset exceeds amount of bytes available in chunk.",
+			 function );
+
+			return( -1 );
+		}
+		bytes_available = chunk_data_size - chunk_offset;
+
+		if( bytes_available > size )
+		{
+			bytes_available = size;
+		}
+		if( ( bytes_available > 0 )
+		 && ( memory_set(
+		       buffer,
+		       0,
+		       bytes_available ) == NULL ) )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_MEMORY,
+			 LIBERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to set empty block data in buffer.",
+			 function );
+
+			return( -1 );
+		}
+		return( (ssize_t) bytes_available );
+	}
+	if( ( chunk_flags & LIBEWF_CHUNK_OFFSET_FLAGS_COMPRESSED ) == 0 )
+	{
+		is_compressed = 0;
+	}
+	else
+	{
+		is_compressed = 1;
+	}
+	/* Directly read to the buffer if
+	 *  the buffer contains the necessary amount of bytes to hold the chunk data
+	 *  and the buffer is not compressed
+	 * otherwise use a buffer of the calling thread
+	 */
+	if( ( chunk_offset == 0 )
+	 && ( is_compressed == 0 )
+	 && ( chunk_size > sizeof( ewf_crc_t ) )
+	 && ( ( chunk_size - sizeof( ewf_crc_t ) ) <= size )
+	 && ( ( chunk_size - sizeof( ewf_crc_t ) ) <= (size_t) media_values->chunk_size ) )
+	{
+		chunk_buffer      = buffer;
+		chunk_read_buffer = buffer;
+
+		/* The CRC is read seperately for uncompressed chunks
+		 */
+		chunk_size -= sizeof( ewf_crc_t );
+	}
+	else
+	{
+		chunk_buffer_size = media_values->chunk_size + sizeof( ewf_crc_t );
+
+		if( ( is_compressed == 0 )
+		 && ( chunk_size > chunk_buffer_size ) )
+		{
+			chunk_buffer_size = chunk_size;
+		}
+		/* The compressed chunk is read behind the uncompressed chunk data
+		 */
+		if( is_compressed != 0 )
+		{
+			read_buffer = (uint8_t *) memory_allocate(
+			                           sizeof( uint8_t ) * ( chunk_buffer_size + chunk_size ) );
+		}
+		else
+		{
+			read_buffer = (uint8_t *) memory_allocate(
+			                           sizeof( uint8_t ) * chunk_buffer_size );
+		}
+		if( read_buffer == NULL )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_MEMORY,
+			 LIBERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create read buffer.",
+			 function );
+
+			return( -1 );
+		}
+		chunk_buffer = read_buffer;
+
+		if( is_compressed != 0 )
+		{
+			chunk_read_buffer = &( read_buffer[ chunk_buffer_size ] );
+		}
+		else
+		{
+			chunk_read_buffer = read_buffer;
+		}
+	}
+	read_count = libewf_read_io_handle_read_chunk(
+	              io_handle,
+	              offset_table,
+	              chunk,
+	              chunk_read_buffer,
+	              chunk_size,
+	              &is_compressed,
+	              stored_crc_buffer,
+	              &chunk_crc,
+	              &read_crc,
+	              error );
+
+	if( read_count <= -1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_IO,
+		 LIBERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunk.",
+		 function );
+
+		if( read_buffer != NULL )
+		{
+			memory_free(
+			 read_buffer );
+		}
+		return( -1 );
+	}
+	if( is_compressed != 0 )
+	{
+		chunk_data_size = chunk_buffer_size;
+	}
+	else
+	{
+		chunk_data_size = chunk_size;
+	}
+	/* Check if the compressed data is that of a known empty block
+	 */
+	result = 0;
+
+	if( ( is_compressed != 0 )
+	 && ( chunk_size <= LIBEWF_CHUNK_CACHE_EMPTY_BLOCK_MAXIMUM_COMPRESSED_SIZE ) )
+	{
+		if( libewf_chunk_cache_grab_for_read(
+		     chunk_cache,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab chunk cache for reading.",
+			 function );
+
+			if( read_buffer != NULL )
+			{
+				memory_free(
+				 read_buffer );
+			}
+			return( -1 );
+		}
+		result = libewf_chunk_cache_get_empty_block(
+		          chunk_cache,
+		          chunk_read_buffer,
+		          chunk_size,
+		          &empty_block_value,
+		          &empty_block_size,
+		          error );
+
+		if( libewf_chunk_cache_release(
+		     chunk_cache,
+		     NULL ) != 1 )
+		{
+			result = -1;
+		}
+		if( result == -1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve empty block.",
+			 function );
+
+			if( read_buffer != NULL )
+			{
+				memory_free(
+				 read_buffer );
+			}
+			return( -1 );
+		}
+		else if( ( result != 0 )
+		      && ( empty_block_size > chunk_data_size ) )
+		{
+			result = 0;
+		}
+	}
+	if( result != 0 )
+	{
+		if( memory_set(
+		     chunk_buffer,
+		     empty_block_value,
+		     empty_block_size ) == NULL )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_MEMORY,
+			 LIBERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to set empty block data.",
+			 function );
+
+			if( read_buffer != NULL )
+			{
+				memory_free(
+				 read_buffer );
+			}
+			return( -1 );
+		}
+		chunk_data_size = empty_block_size;
+	}
+	else if( libewf_read_io_handle_process_chunk(
+	     chunk_read_buffer,
+	     chunk_size,
+	     chunk_buffer,
+	     &chunk_data_size,
+	     is_compressed,
+	     chunk_crc,
+	     read_crc,
+	     &crc_mismatch,
+	     &( io_handle->statistics ),
+	     error ) == -1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_MEMORY,
+		 LIBERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to process chunk data.",
+		 function );
+
+		if( read_buffer != NULL )
+		{
+			memory_free(
+			 read_buffer );
+		}
+		return( -1 );
+	}
+	/* The CRC errors, the empty blocks and the cache entries are shared with the other threads
+	 */
+	if( libewf_chunk_cache_grab_for_write(
+	     chunk_cache,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab chunk cache for writing.",
+		 function );
+
+		if( read_buffer != NULL )
+		{
+			memory_free(
+			 read_buffer );
+		}
+		return( -1 );
+	}
+	/* Remember the compressed data if the chunk is an empty block
+	 */
+	if( ( is_compressed != 0 )
+	 && ( chunk_size <= LIBEWF_CHUNK_CACHE_EMPTY_BLOCK_MAXIMUM_COMPRESSED_SIZE )
+	 && ( chunk_data_size > 0 ) )
+	{
+		if( result == 0 )
+		{
+			result = libewf_empty_block_test(
+			          chunk_buffer,
+			          chunk_data_size,
+			          error );
+
+			empty_block_value = chunk_buffer[ 0 ];
+		}
+		if( result == 1 )
+		{
+			result = libewf_read_io_handle_set_empty_block(
+			          media_values,
+			          offset_table,
+			          chunk_cache,
+			          chunk,
+			          chunk_read_buffer,
+			          chunk_size,
+			          empty_block_value,
+			          chunk_data_size,
+			          error );
+		}
+		if( result == -1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set empty block.",
+			 function );
+
+			libewf_chunk_cache_release(
+			 chunk_cache,
+			 NULL );
+
+			if( read_buffer != NULL )
+			{
+				memory_free(
+				 read_buffer );
+			}
+			return( -1 );
+		}
+	}
+	if( crc_mismatch != 0 )
+	{
+		/* Add CRC error
+		 */
+		sector            = (int64_t) chunk * (int64_t) media_values->sectors_per_chunk;
+		amount_of_sectors = media_values->sectors_per_chunk;
+
+		if( ( sector + amount_of_sectors ) > (int64_t) media_values->amount_of_sectors )
+		{
+			amount_of_sectors = (uint32_t) ( (int64_t) media_values->amount_of_sectors - sector );
+		}
+		if( libewf_sector_table_add_sector(
+		     read_io_handle->crc_errors,
+		     sector,
+		     amount_of_sectors,
+		     1,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set CRC error.",
+			 function );
+
+			libewf_chunk_cache_release(
+			 chunk_cache,
+			 NULL );
+
+			if( read_buffer != NULL )
+			{
+				memory_free(
+				 read_buffer );
+			}
+			return( -1 );
+		}
+		chunk_data_size = amount_of_sectors * media_values->bytes_per_sector;
+
+		/* Wipe the chunk if nescessary
+		 */
+		if( ( read_io_handle->wipe_on_error != 0 )
+		 && ( memory_set(
+		       chunk_buffer,
+		       0,
+		       chunk_data_size ) == NULL ) )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_MEMORY,
+			 LIBERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to wipe chunk data.",
+			 function );
+
+			libewf_chunk_cache_release(
+			 chunk_cache,
+			 NULL );
+
+			if( read_buffer != NULL )
+			{
+				memory_free(
+				 read_buffer );
+			}
+			return( -1 );
+		}
+	}
+	/* Store a copy of the chunk data in the least recently used cache entry
+	 */
+	if( read_buffer != NULL )
+	{
+		if( libewf_chunk_cache_set_entry(
+		     chunk_cache,
+		     chunk,
+		     chunk_buffer_size,
+		     &cache_entry,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set chunk cache entry.",
+			 function );
+
+			libewf_chunk_cache_release(
+			 chunk_cache,
+			 NULL );
+
+			memory_free(
+			 read_buffer );
+
+			return( -1 );
+		}
+		if( memory_copy(
+		     cache_entry->data,
+		     chunk_buffer,
+		     chunk_data_size ) == NULL )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_MEMORY,
+			 LIBERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to set chunk cache entry data.",
+			 function );
+
+			libewf_chunk_cache_remove_entry(
+			 chunk_cache,
+			 chunk,
+			 NULL );
+			libewf_chunk_cache_release(
+			 chunk_cache,
+			 NULL );
+
+			memory_free(
+			 read_buffer );
+
+			return( -1 );
+		}
+		cache_entry->amount = chunk_data_size;
+	}
+	if( libewf_chunk_cache_release(
+	     chunk_cache,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release chunk cache.",
+		 function );
+
+		if( read_buffer != NULL )
+		{
+			memory_free(
+			 read_buffer );
+		}
+		return( -1 );
+	}
+	/* Determine the available amount of data within the chunk
+	 */
+	if( chunk_offset > chunk_data_size )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_VALUE_OUT_OF_RANGE,
+		 "%s: chunk offset exceeds amount of bytes available in chunk.",
+		 function );
+
+		if( read_buffer != NULL )
+		{
+			memory_free(
+			 read_buffer );
+		}
+		return( -1 );
+	}
+	bytes_available = chunk_data_size - chunk_offset;
+
+	if( bytes_available > size )
+	{
+		bytes_available = size;
+	}
+	if( read_buffer != NULL )
+	{
+		if( ( bytes_available > 0 )
+		 && ( memory_copy(
+		       buffer,
+		       &( chunk_buffer[ chunk_offset ] ),
+		       bytes_available ) == NULL ) )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_MEMORY,
+			 LIBERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to set chunk data in buffer.",
+			 function );
+
+			memory_free(
+			 read_buffer );
+
+			return( -1 );
+		}
+		memory_free(
+		 read_buffer );
+	}
+	return( (ssize_t) bytes_available );
+}
+
+/* Determines if a chunk is an empty block that only contains zero bytes
+ * A chunk that was not marked empty before is only read if its compressed data
+ * is small enough to be that of an empty block, the data is only decompressed
+ * if it does not match the compressed data of a known empty block
+ * Returns 1 if the chunk is empty, 0 if not or -1 on error
+ */
+int libewf_read_io_handle_is_empty_chunk(
+     libewf_io_handle_t *io_handle,
+     libewf_media_values_t *media_values,
+     libewf_offset_table_t *offset_table,
+     libewf_chunk_cache_t *chunk_cache,
+     uint32_t chunk,
+     liberror_error_t **error )
+{
+	uint8_t compressed[ LIBEWF_CHUNK_CACHE_EMPTY_BLOCK_MAXIMUM_COMPRESSED_SIZE ];
+
+	libewf_segment_file_handle_t *segment_file_handle = NULL;
+	uint8_t *chunk_buffer                             = NULL;
+	static char *function                             = "libewf_read_io_handle_is_empty_chunk";
+	ewf_crc_t chunk_crc                               = 0;
+	off64_t file_offset                               = 0;
+	size_t chunk_data_size                            = 0;
+	size_t chunk_size                                 = 0;
+	size_t empty_block_size                           = 0;
+	ssize_t read_count                                = 0;
+	int result                                        = 0;
+	uint8_t chunk_flags                               = 0;
+	uint8_t crc_mismatch                              = 0;
+	uint8_t empty_block_value                         = 0;
+	int8_t is_compressed                              = 0;
+	int8_t read_crc                                   = 0;
+
+	if( media_values == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset_table == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset table.",
+		 function );
+
+		return( -1 );
+	}
+	/* Check if the chunk is available
+	 */
+	if( chunk >= offset_table->amount_of_chunk_offsets )
+	{
+		return( 0 );
+	}
+	if( libewf_read_io_handle_read_table_section(
+	     io_handle,
+	     offset_table,
+	     chunk,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_IO,
+		 LIBERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read table section of chunk: %" PRIu32 ".",
+		 function,
+		 chunk );
+
+		return( -1 );
+	}
+	if( libewf_offset_table_get_chunk_offset(
+	     offset_table,
+	     chunk,
+	     &segment_file_handle,
+	     &file_offset,
+	     &chunk_size,
+	     &chunk_flags,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk offset: %" PRIu32 ".",
+		 function,
+		 chunk );
+
+		return( -1 );
+	}
+	if( ( chunk_flags & LIBEWF_CHUNK_OFFSET_FLAGS_EMPTY_BLOCK ) != 0 )
+	{
+		return( 1 );
+	}
+	if( ( ( chunk_flags & LIBEWF_CHUNK_OFFSET_FLAGS_COMPRESSED ) == 0 )
+	 || ( chunk_size > LIBEWF_CHUNK_CACHE_EMPTY_BLOCK_MAXIMUM_COMPRESSED_SIZE ) )
+	{
+		return( 0 );
+	}
+	read_count = libewf_read_io_handle_read_chunk(
+	              io_handle,
+	              offset_table,
+	              chunk,
+	              compressed,
+	              LIBEWF_CHUNK_CACHE_EMPTY_BLOCK_MAXIMUM_COMPRESSED_SIZE,
+	              &is_compressed,
+	              NULL,
+	              &chunk_crc,
+	              &read_crc,
+	              error );
+
+	if( read_count <= -1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_IO,
+		 LIBERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunk: %" PRIu32 ".",
+		 function,
+		 chunk );
+
+		return( -1 );
+	}
+	if( libewf_chunk_cache_grab_for_read(
+	     chunk_cache,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab chunk cache for reading.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_chunk_cache_get_empty_block(
+	          chunk_cache,
+	          compressed,
+	          chunk_size,
+	          &empty_block_value,
+	          &empty_block_size,
+	          error );
+
+	if( libewf_chunk_cache_release(
+	     chunk_cache,
+	     NULL ) != 1 )
+	{
+		result = -1;
+	}
+	if( result == -1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve empty block.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		empty_block_size = media_values->chunk_size + sizeof( ewf_crc_t );
+
+		chunk_buffer = (uint8_t *) memory_allocate(
+		                            sizeof( uint8_t ) * empty_block_size );
+
+		if( chunk_buffer == NULL )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_MEMORY,
+			 LIBERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create chunk buffer.",
+			 function );
+
+			return( -1 );
+		}
+		/* A chunk that cannot be decompressed is not empty
+		 * the error is reported when the chunk is read
+		 */
+		if( libewf_read_io_handle_process_chunk(
+		     compressed,
+		     chunk_size,
+		     chunk_buffer,
+		     &empty_block_size,
+		     is_compressed,
+		     chunk_crc,
+		     read_crc,
+		     &crc_mismatch,
+		     &( io_handle->statistics ),
+		     NULL ) != -1 )
+		{
+			if( empty_block_size > 0 )
+			{
+				result = libewf_empty_block_test(
+				          chunk_buffer,
+				          empty_block_size,
+				          error );
+
+				empty_block_value = chunk_buffer[ 0 ];
+			}
+		}
+		memory_free(
+		 chunk_buffer );
+
+		if( result == -1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if chunk: %" PRIu32 " is empty.",
+			 function,
+			 chunk );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			return( 0 );
+		}
+	}
+	if( libewf_chunk_cache_grab_for_write(
+	     chunk_cache,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab chunk cache for writing.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_read_io_handle_set_empty_block(
+	          media_values,
+	          offset_table,
+	          chunk_cache,
+	          chunk,
+	          compressed,
+	          chunk_size,
+	          empty_block_value,
+	          empty_block_size,
+	          error );
+
+	if( libewf_chunk_cache_release(
+	     chunk_cache,
+	     NULL ) != 1 )
+	{
+		result = -1;
+	}
+	if( result != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set empty block.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_read_io_handle_get_chunk_data_size(
+	     media_values,
+	     chunk,
+	     &chunk_data_size,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( empty_block_value != 0 )
+	 || ( empty_block_size != chunk_data_size ) )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
@@ -71,8 +71,32 @@ ssize_t libewf_read_io_handle_process_chunk(
          ewf_crc_t chunk_crc,
          int8_t read_crc,
          uint8_t *crc_mismatch,
+         libewf_statistics_t *statistics,
          liberror_error_t **error );
 
+int libewf_read_io_handle_read_table_section(
+     libewf_io_handle_t *io_handle,
+     libewf_offset_table_t *offset_table,
+     uint32_t chunk,
+     liberror_error_t **error );
+
+int libewf_read_io_handle_get_chunk_data_size(
+     libewf_media_values_t *media_values,
+     uint32_t chunk,
+     size_t *chunk_data_size,
+     liberror_error_t **error );
+
+int libewf_read_io_handle_set_empty_block(
+     libewf_media_values_t *media_values,
+     libewf_offset_table_t *offset_table,
+     libewf_chunk_cache_t *chunk_cache,
+     uint32_t chunk,
+     const uint8_t *compressed,
+     size_t compressed_size,
+     uint8_t value,
+     size_t uncompressed_size,
+     liberror_error_t **error );
+
 ssize_t libewf_read_io_handle_read_chunk(
          libewf_io_handle_t *io_handle,
          libewf_offset_table_t *offset_table,
@@ -97,6 +121,26 @@ ssize_t libewf_read_io_handle_read_chunk_data(
          size_t size,
          liberror_error_t **error );
 
+ssize_t libewf_read_io_handle_read_chunk_data_concurrent(
+         libewf_read_io_handle_t *read_io_handle,
+         libewf_io_handle_t *io_handle,
+         libewf_media_values_t *media_values,
+         libewf_offset_table_t *offset_table,
+         libewf_chunk_cache_t *chunk_cache,
+         uint32_t chunk,
+         uint32_t chunk_offset,
+         uint8_t *buffer,
+         size_t size,
+         liberror_error_t **error );
+
+int libewf_read_io_handle_is_empty_chunk(
+     libewf_io_handle_t *io_handle,
+     libewf_media_values_t *media_values,
+     libewf_offset_table_t *offset_table,
+     libewf_chunk_cache_t *chunk_cache,
+     uint32_t chunk,
+     liberror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -2237,6 +2237,7 @@ ssize_t libewf_section_table_read(
 	static char *function       = "libewf_section_table_read";
 	ewf_crc_t calculated_crc    = 0;
 	ewf_crc_t stored_crc        = 0;
+	off64_t offsets_file_offset = 0;
 	size_t offsets_size         = 0;
 	ssize_t section_read_count  = 0;
 	ssize_t read_count          = 0;
@@ -2368,7 +2369,47 @@ ssize_t libewf_section_table_read(
 	 calculated_crc );
 #endif
 
-	if( amount_of_chunks > 0 )
+	/* Only the location of the offsets is stored when they are read on demand
+	 */
+	if( ( amount_of_chunks > 0 )
+	 && ( offset_table->read_on_demand != 0 ) )
+	{
+		if( libbfio_pool_get_offset(
+		     file_io_pool,
+		     segment_file_handle->file_io_pool_entry,
+		     &offsets_file_offset,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to retrieve offsets file offset.",
+			 function );
+
+			return( -1 );
+		}
+		if( libewf_offset_table_append_table_section(
+		     offset_table,
+		     segment_file_handle,
+		     offsets_file_offset,
+		     (off64_t) base_offset,
+		     amount_of_chunks,
+		     stored_crc,
+		     ewf_format,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to append table section.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else if( amount_of_chunks > 0 )
 	{
 		/* Check if the maximum amount of offsets is not exceeded
 		 */
@@ -2541,7 +2582,8 @@ ssize_t libewf_section_table_read(
 	if( section_size != (size_t) section_read_count )
 	{
 		if( ( ewf_format != EWF_FORMAT_S01 )
-		 && ( format != LIBEWF_FORMAT_ENCASE1 ) )
+		 && ( format != LIBEWF_FORMAT_ENCASE1 )
+		 && ( offset_table->read_on_demand == 0 ) )
 		{
 			libnotify_verbose_printf(
 			 "%s: data found after table offsets.\n",
@@ -2590,6 +2632,7 @@ ssize_t libewf_section_table2_read(
 	static char *function       = "libewf_section_table2_read";
 	ewf_crc_t calculated_crc    = 0;
 	ewf_crc_t stored_crc        = 0;
+	off64_t offsets_file_offset = 0;
 	size_t offsets_size         = 0;
 	ssize_t section_read_count  = 0;
 	ssize_t read_count          = 0;
@@ -2721,7 +2764,45 @@ ssize_t libewf_section_table2_read(
 	 calculated_crc );
 #endif
 
-	if( amount_of_chunks > 0 )
+	/* Only the location of the offsets is stored when they are read on demand
+	 */
+	if( ( amount_of_chunks > 0 )
+	 && ( offset_table->read_on_demand != 0 ) )
+	{
+		if( libbfio_pool_get_offset(
+		     file_io_pool,
+		     segment_file_handle->file_io_pool_entry,
+		     &offsets_file_offset,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to retrieve offsets file offset.",
+			 function );
+
+			return( -1 );
+		}
+		if( libewf_offset_table_set_table2_section(
+		     offset_table,
+		     segment_file_handle,
+		     offsets_file_offset,
+		     (off64_t) base_offset,
+		     amount_of_chunks,
+		     error ) == -1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set table2 section.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else if( amount_of_chunks > 0 )
 	{
 		/* Check if the maximum amount of offsets is not exceeded
 		 */
@@ -2894,7 +2975,8 @@ ssize_t libewf_section_table2_read(
 	else if( section_size != (size_t) section_read_count )
 	{
 		if( ( ewf_format != EWF_FORMAT_S01 )
-		 && ( format != LIBEWF_FORMAT_ENCASE1 ) )
+		 && ( format != LIBEWF_FORMAT_ENCASE1 )
+		 && ( offset_table->read_on_demand == 0 ) )
 		{
 			libnotify_verbose_printf(
 			 "%s: unexpected data found after table offsets.\n",
@@ -6315,6 +6397,7 @@ ssize_t libewf_section_delta_chunk_read(
 	static char *function    = "libewf_section_delta_chunk_read";
 	ewf_crc_t calculated_crc = 0;
 	ewf_crc_t stored_crc     = 0;
+	off64_t chunk_offset     = 0;
 	ssize_t read_count       = 0;
 	uint32_t chunk           = 0;
 	uint32_t chunk_size      = 0;
@@ -6431,7 +6514,7 @@ ssize_t libewf_section_delta_chunk_read(
 	if( libbfio_pool_get_offset(
 	     file_io_pool,
 	     segment_file_handle->file_io_pool_entry,
-	     &( offset_table->chunk_offset[ chunk ].file_offset ),
+	     &chunk_offset,
 	     error ) != 1 )
 	{
 		liberror_error_set(
@@ -6443,17 +6526,53 @@ ssize_t libewf_section_delta_chunk_read(
 
 		return( -1 );
 	}
-	offset_table->chunk_offset[ chunk ].segment_file_handle = segment_file_handle;
-	offset_table->chunk_offset[ chunk ].size                = chunk_size;
-	offset_table->chunk_offset[ chunk ].flags               = LIBEWF_CHUNK_OFFSET_FLAGS_DELTA_CHUNK;
+	/* Make sure the table section of the chunk is read
+	 * so that the delta chunk is not overwritten when read on demand
+	 */
+	if( libewf_offset_table_read_table_section(
+	     offset_table,
+	     chunk,
+	     file_io_pool,
+	     error ) == -1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_IO,
+		 LIBERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read table section of chunk: %" PRIu32 ".",
+		 function,
+		 chunk );
+
+		return( -1 );
+	}
+	if( libewf_offset_table_set_chunk_offset(
+	     offset_table,
+	     chunk,
+	     segment_file_handle,
+	     chunk_offset,
+	     (size_t) chunk_size,
+	     LIBEWF_CHUNK_OFFSET_FLAGS_DELTA_CHUNK,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set chunk offset: %" PRIu32 ".",
+		 function,
+		 chunk );
+
+		return( -1 );
+	}
 
 	/* Skip the chunk data within the section
+	 * the table section read can change the current offset
 	 */
 	if( libbfio_pool_seek_offset(
 	     file_io_pool,
 	     segment_file_handle->file_io_pool_entry,
-	     section_size - read_count,
-	     SEEK_CUR,
+	     chunk_offset + (off64_t) ( section_size - read_count ),
+	     SEEK_SET,
 	     error ) == -1 )
 	{
 		liberror_error_set(
@@ -35,6 +35,7 @@
 #include "libewf_section.h"
 #include "libewf_segment_file.h"
 #include "libewf_segment_table.h"
+#include "libewf_statistics.h"
 #include "libewf_string.h"
 #include "libewf_system_string.h"
 
@@ -1406,9 +1407,12 @@ ssize_t libewf_segment_file_write_chunk(
 #endif
 	static char *function       = "libewf_segment_file_write_chunk";
 	off64_t segment_file_offset = 0;
+	uint64_t timestamp          = 0;
+	size_t chunk_offset_size    = 0;
 	size_t write_size           = 0;
 	ssize_t write_count         = 0;
 	ssize_t total_write_count   = 0;
+	uint8_t chunk_offset_flags  = 0;
 
 	if( segment_file_handle == NULL )
 	{
@@ -1501,21 +1505,34 @@ ssize_t libewf_segment_file_write_chunk(
 	}
 	/* Set the values in the offset table
 	 */
-	offset_table->chunk_offset[ chunk ].segment_file_handle = segment_file_handle;
-	offset_table->chunk_offset[ chunk ].file_offset         = segment_file_offset;
-	offset_table->chunk_offset[ chunk ].size                = chunk_size;
+	chunk_offset_size = chunk_size;
 
 	if( write_crc != 0 )
 	{
-		offset_table->chunk_offset[ chunk ].size += sizeof( ewf_crc_t );
+		chunk_offset_size += sizeof( ewf_crc_t );
 	}
-	if( is_compressed == 0 )
+	if( is_compressed != 0 )
 	{
-		offset_table->chunk_offset[ chunk ].flags = 0;
+		chunk_offset_flags = LIBEWF_CHUNK_OFFSET_FLAGS_COMPRESSED;
 	}
-	else
+	if( libewf_offset_table_set_chunk_offset(
+	     offset_table,
+	     chunk,
+	     segment_file_handle,
+	     segment_file_offset,
+	     chunk_offset_size,
+	     chunk_offset_flags,
+	     error ) != 1 )
 	{
-		offset_table->chunk_offset[ chunk ].flags |= LIBEWF_CHUNK_OFFSET_FLAGS_COMPRESSED;
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set chunk offset: %" PRIu32 ".",
+		 function,
+		 chunk );
+
+		return( -1 );
 	}
 
 #if defined( HAVE_VERBOSE_OUTPUT )
@@ -1535,7 +1552,7 @@ ssize_t libewf_segment_file_write_chunk(
 	 chunk_type,
 	 chunk,
 	 segment_file_offset,
-	 offset_table->chunk_offset[ chunk ].size,
+	 chunk_offset_size,
 	 *chunk_crc );
 #endif
 
@@ -1569,6 +1586,8 @@ ssize_t libewf_segment_file_write_chunk(
 			write_size += sizeof( ewf_crc_t );
 		}
 	}
+	timestamp = libewf_statistics_get_timestamp();
+
 	/* Write the chunk data to the segment file
 	 */
 	write_count = libbfio_pool_write(
@@ -1617,6 +1636,18 @@ ssize_t libewf_segment_file_write_chunk(
 		}
 		total_write_count += write_count;
 	}
+	libewf_statistics_add_time(
+	 io_handle->statistics.io_time,
+	 timestamp );
+
+	libewf_statistics_add(
+	 io_handle->statistics.amount_of_chunks_written,
+	 1 );
+
+	libewf_statistics_add(
+	 io_handle->statistics.amount_of_stored_bytes_written,
+	 total_write_count );
+
 	return( total_write_count );
 }
 
@@ -1638,6 +1669,7 @@ ssize_t libewf_segment_file_write_delta_chunk(
 {
 	static char *function       = "libewf_segment_file_write_delta_chunk";
 	off64_t segment_file_offset = 0;
+	uint64_t timestamp          = 0;
 	ssize_t write_count         = 0;
 
 	if( segment_file_handle == NULL )
@@ -1715,6 +1747,8 @@ ssize_t libewf_segment_file_write_delta_chunk(
 	 *chunk_crc );
 #endif
 
+	timestamp = libewf_statistics_get_timestamp();
+
 	/* Write the chunk in the delta segment file
 	 */
 	write_count = libewf_section_delta_chunk_write(
@@ -1729,6 +1763,20 @@ ssize_t libewf_segment_file_write_delta_chunk(
 	               no_section_append,
 	               error );
 
+	if( write_count > 0 )
+	{
+		libewf_statistics_add_time(
+		 io_handle->statistics.io_time,
+		 timestamp );
+
+		libewf_statistics_add(
+		 io_handle->statistics.amount_of_chunks_written,
+		 1 );
+
+		libewf_statistics_add(
+		 io_handle->statistics.amount_of_stored_bytes_written,
+		 write_count );
+	}
 	/* Set the values in the offset table
 	 * if the delta chunk was added newly
 	 *  and the delta chunk was written correctly
@@ -1736,10 +1784,25 @@ ssize_t libewf_segment_file_write_delta_chunk(
 	if( ( no_section_append == 0 )
 	 && ( write_count > 0 ) )
 	{
-		offset_table->chunk_offset[ chunk ].segment_file_handle = segment_file_handle;
-		offset_table->chunk_offset[ chunk ].file_offset         = segment_file_offset;
-		offset_table->chunk_offset[ chunk ].size                = chunk_size + sizeof( ewf_crc_t );
-		offset_table->chunk_offset[ chunk ].flags               = LIBEWF_CHUNK_OFFSET_FLAGS_DELTA_CHUNK;
+		if( libewf_offset_table_set_chunk_offset(
+		     offset_table,
+		     chunk,
+		     segment_file_handle,
+		     segment_file_offset,
+		     chunk_size + sizeof( ewf_crc_t ),
+		     LIBEWF_CHUNK_OFFSET_FLAGS_DELTA_CHUNK,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set chunk offset: %" PRIu32 ".",
+			 function,
+			 chunk );
+
+			return( -1 );
+		}
 	}
 	else if( write_count < 0 )
 	{
@@ -1214,6 +1214,24 @@ int libewf_segment_table_create_segment_file(
 	memory_free(
 	 filename );
 
+	if( libbfio_handle_set_write_buffer_size(
+	     file_io_handle,
+	     LIBEWF_SEGMENT_FILE_WRITE_BUFFER_SIZE,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set write buffer size in file io handle.",
+		 function );
+
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+
+		return( -1 );
+	}
 	if( segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_DWF )
 	{
 		flags = LIBBFIO_OPEN_READ_WRITE_TRUNCATE;
@@ -0,0 +1,70 @@
+/*
+ * Statistics functions
+ *
+ * Copyright (c) 2006-2009, Joachim Metz <forensics@hoffmannbv.nl>,
+ * Hoffmann Investigations.
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_STATISTICS_H )
+#define _LIBEWF_STATISTICS_H
+
+#include <common.h>
+#include <thread.h>
+#include <types.h>
+
+#include <liberror.h>
+
+#include "libewf_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* Adds an amount to a statistics value
+ * the chunks can be processed by multiple threads at the same time
+ * so the value is added atomically if supported by the compiler
+ */
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && defined( __GNUC__ )
+#define libewf_statistics_add( value, amount ) \
+	__atomic_fetch_add( &( value ), (uint64_t) ( amount ), __ATOMIC_RELAXED )
+
+#else
+#define libewf_statistics_add( value, amount ) \
+	( value ) += (uint64_t) ( amount )
+
+#endif
+
+/* Adds the time passed since a timestamp to a statistics value
+ */
+#define libewf_statistics_add_time( value, start_timestamp ) \
+	libewf_statistics_add( value, libewf_statistics_get_timestamp() - ( start_timestamp ) )
+
+uint64_t libewf_statistics_get_timestamp(
+          void );
+
+int libewf_statistics_copy(
+     libewf_statistics_t *destination_statistics,
+     libewf_statistics_t *source_statistics,
+     liberror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif
+
@@ -28,7 +28,15 @@
 
 #include <stdio.h>
 
+#if defined( HAVE_ZLIB_H ) || defined( ZLIB_DLL )
+#include <zlib.h>
+#endif
+
+#include "libewf_checksum.h"
+#include "libewf_compression.h"
+#include "libewf_cpuid.h"
 #include "libewf_definitions.h"
+#include "libewf_empty_block.h"
 #include "libewf_filename.h"
 #include "libewf_error.h"
 #include "libewf_libbfio.h"
@@ -1464,6 +1472,340 @@ int libewf_glob_free(
 }
 #endif
 
+#if defined( HAVE_V2_API )
+/* Retrieves the compression library used to compress and uncompress chunks
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_get_compression_library(
+     int *compression_library,
+     liberror_error_t **error )
+{
+	static char *function = "libewf_get_compression_library";
+
+	if( compression_library == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression library.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_compression_get_library(
+	     compression_library,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve compression library.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Sets the compression library used to compress and uncompress chunks
+ * The value applies to all handles and must be set before a handle is opened
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_set_compression_library(
+     int compression_library,
+     liberror_error_t **error )
+{
+	static char *function = "libewf_set_compression_library";
+
+	if( libewf_compression_set_library(
+	     compression_library,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set compression library.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+#else
+/* Retrieves the compression library used to compress and uncompress chunks
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_get_compression_library(
+     int *compression_library )
+{
+	liberror_error_t *error = NULL;
+	static char *function   = "libewf_get_compression_library";
+
+	if( libewf_compression_get_library(
+	     compression_library,
+	     &error ) != 1 )
+	{
+		liberror_error_set(
+		 &error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve compression library.",
+		 function );
+
+		libnotify_print_error_backtrace(
+		 error );
+		liberror_error_free(
+		 &error );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Sets the compression library used to compress and uncompress chunks
+ * The value applies to all handles and must be set before a handle is opened
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_set_compression_library(
+     int compression_library )
+{
+	liberror_error_t *error = NULL;
+	static char *function   = "libewf_set_compression_library";
+
+	if( libewf_compression_set_library(
+	     compression_library,
+	     &error ) != 1 )
+	{
+		liberror_error_set(
+		 &error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set compression library.",
+		 function );
+
+		libnotify_print_error_backtrace(
+		 error );
+		liberror_error_free(
+		 &error );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+#endif
+
+/* Runs a checksum or empty block kernel on a buffer
+ * The Adler-32 kernels continue the checksum in value
+ * the empty block kernels add 1 to value if the buffer is an empty block
+ * Returns 1 if successful, 0 if the kernel is not supported by the processor or -1 on error
+ */
+int libewf_support_run_kernel(
+     int kernel,
+     const uint8_t *buffer,
+     size_t size,
+     uint32_t *value,
+     liberror_error_t **error )
+{
+	static char *function        = "libewf_support_run_kernel";
+	int required_instruction_set = 0;
+
+	if( buffer == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( value == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value.",
+		 function );
+
+		return( -1 );
+	}
+	switch( kernel )
+	{
+		case LIBEWF_KERNEL_ADLER32_ZLIB:
+		case LIBEWF_KERNEL_EMPTY_BLOCK_SCALAR:
+			required_instruction_set = LIBEWF_CPUID_INSTRUCTION_SET_SCALAR;
+			break;
+
+		case LIBEWF_KERNEL_EMPTY_BLOCK_SSE2:
+			required_instruction_set = LIBEWF_CPUID_INSTRUCTION_SET_SSE2;
+			break;
+
+		case LIBEWF_KERNEL_ADLER32_SSSE3:
+			required_instruction_set = LIBEWF_CPUID_INSTRUCTION_SET_SSSE3;
+			break;
+
+		case LIBEWF_KERNEL_ADLER32_AVX2:
+		case LIBEWF_KERNEL_EMPTY_BLOCK_AVX2:
+			required_instruction_set = LIBEWF_CPUID_INSTRUCTION_SET_AVX2;
+			break;
+
+		default:
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported kernel.",
+			 function );
+
+			return( -1 );
+	}
+	/* Without SIMD support the instruction set is scalar
+	 */
+	if( libewf_cpuid_get_instruction_set() < required_instruction_set )
+	{
+		return( 0 );
+	}
+	switch( kernel )
+	{
+		case LIBEWF_KERNEL_ADLER32_ZLIB:
+			*value = (uint32_t) adler32(
+			                     (uLong) *value,
+			                     (const Bytef *) buffer,
+			                     (uInt) size );
+			break;
+
+		case LIBEWF_KERNEL_EMPTY_BLOCK_SCALAR:
+			*value += (uint32_t) libewf_empty_block_test_scalar(
+			                      buffer,
+			                      size );
+			break;
+
+#if defined( HAVE_SIMD_SUPPORT )
+		case LIBEWF_KERNEL_ADLER32_SSSE3:
+			*value = libewf_checksum_calculate_adler32_ssse3(
+			          buffer,
+			          size,
+			          *value );
+			break;
+
+		case LIBEWF_KERNEL_ADLER32_AVX2:
+			*value = libewf_checksum_calculate_adler32_avx2(
+			          buffer,
+			          size,
+			          *value );
+			break;
+
+		case LIBEWF_KERNEL_EMPTY_BLOCK_SSE2:
+			*value += (uint32_t) libewf_empty_block_test_sse2(
+			                      buffer,
+			                      size );
+			break;
+
+		case LIBEWF_KERNEL_EMPTY_BLOCK_AVX2:
+			*value += (uint32_t) libewf_empty_block_test_avx2(
+			                      buffer,
+			                      size );
+			break;
+#endif
+	}
+	return( 1 );
+}
+
+#if defined( HAVE_V2_API )
+/* Runs a checksum or empty block kernel on a buffer
+ * The Adler-32 kernels continue the checksum in value
+ * the empty block kernels add 1 to value if the buffer is an empty block
+ * Returns 1 if successful, 0 if the kernel is not supported by the processor or -1 on error
+ */
+int libewf_run_kernel(
+     int kernel,
+     const uint8_t *buffer,
+     size_t size,
+     uint32_t *value,
+     liberror_error_t **error )
+{
+	static char *function = "libewf_run_kernel";
+	int result            = 0;
+
+	result = libewf_support_run_kernel(
+	          kernel,
+	          buffer,
+	          size,
+	          value,
+	          error );
+
+	if( result == -1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to run kernel.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+#else
+/* Runs a checksum or empty block kernel on a buffer
+ * The Adler-32 kernels continue the checksum in value
+ * the empty block kernels add 1 to value if the buffer is an empty block
+ * Returns 1 if successful, 0 if the kernel is not supported by the processor or -1 on error
+ */
+int libewf_run_kernel(
+     int kernel,
+     const uint8_t *buffer,
+     size_t size,
+     uint32_t *value )
+{
+	liberror_error_t *error = NULL;
+	static char *function   = "libewf_run_kernel";
+	int result              = 0;
+
+	result = libewf_support_run_kernel(
+	          kernel,
+	          buffer,
+	          size,
+	          value,
+	          &error );
+
+	if( result == -1 )
+	{
+		liberror_error_set(
+		 &error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to run kernel.",
+		 function );
+
+		libnotify_print_error_backtrace(
+		 error );
+		liberror_error_free(
+		 &error );
+
+		return( -1 );
+	}
+	return( result );
+}
+#endif
+
 /* Globs the segment files according to the EWF naming schema
  * if format is known the filename should contain the base of the filename
  * otherwise the function will try to determine the format based on the extension
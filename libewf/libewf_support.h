@@ -101,6 +101,44 @@ LIBEWF_EXTERN int libewf_glob_free(
                    liberror_error_t **error );
 #endif
 
+#if defined( HAVE_V2_API )
+LIBEWF_EXTERN int libewf_get_compression_library(
+                   int *compression_library,
+                   liberror_error_t **error );
+
+LIBEWF_EXTERN int libewf_set_compression_library(
+                   int compression_library,
+                   liberror_error_t **error );
+#else
+LIBEWF_EXTERN int libewf_get_compression_library(
+                   int *compression_library );
+
+LIBEWF_EXTERN int libewf_set_compression_library(
+                   int compression_library );
+#endif
+
+int libewf_support_run_kernel(
+     int kernel,
+     const uint8_t *buffer,
+     size_t size,
+     uint32_t *value,
+     liberror_error_t **error );
+
+#if defined( HAVE_V2_API )
+LIBEWF_EXTERN int libewf_run_kernel(
+                   int kernel,
+                   const uint8_t *buffer,
+                   size_t size,
+                   uint32_t *value,
+                   liberror_error_t **error );
+#else
+LIBEWF_EXTERN int libewf_run_kernel(
+                   int kernel,
+                   const uint8_t *buffer,
+                   size_t size,
+                   uint32_t *value );
+#endif
+
 /* TODO
 LIBEWF_EXTERN int libewf_glob_file_io_handle(
                    libbfio_handle_t *file_io_handle,
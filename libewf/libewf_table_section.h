@@ -0,0 +1,85 @@
+/*
+ * Table section functions
+ *
+ * Copyright (c) 2006-2009, Joachim Metz <forensics@hoffmannbv.nl>,
+ * Hoffmann Investigations.
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_TABLE_SECTION_H )
+#define _LIBEWF_TABLE_SECTION_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_segment_file_handle.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_table_section libewf_table_section_t;
+
+/* The location of the offsets of a table section
+ * used to read the chunk offsets on demand
+ */
+struct libewf_table_section
+{
+	/* A reference to the segment file handle
+	 */
+	libewf_segment_file_handle_t *segment_file_handle;
+
+	/* The file offset of the table offsets in the segment file
+	 */
+	off64_t offsets_file_offset;
+
+	/* The file offset of the table2 offsets in the segment file
+	 * 0 if there is no table2 section
+	 */
+	off64_t table2_offsets_file_offset;
+
+	/* The base offset of the table offsets
+	 */
+	off64_t base_offset;
+
+	/* The first chunk in the table section
+	 */
+	uint32_t first_chunk;
+
+	/* The amount of chunks in the table section
+	 */
+	uint32_t amount_of_chunks;
+
+	/* The CRC of the table section header
+	 */
+	uint32_t table_crc;
+
+	/* The EWF format of the segment file
+	 */
+	uint8_t ewf_format;
+
+	/* Value to indicate the chunk offsets have been read
+	 */
+	uint8_t is_read;
+};
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif
+
@@ -30,12 +30,94 @@
  * The definitions in <libewf/types.h> are copied here
  * for local use of libewf
  */
-#if defined( HAVE_LOCAL_LIBEWF )
+#if !defined( HAVE_LOCAL_LIBEWF )
+#include <libewf/types.h>
+
+#else
 
 /* The following type definitions hide internal data structures
  */
 typedef intptr_t libewf_handle_t;
 
+/* The statistics of a handle
+ * the times are cumulative and in nanoseconds
+ */
+typedef struct libewf_statistics libewf_statistics_t;
+
+struct libewf_statistics
+{
+	/* The size of the structure
+	 * the caller must set it to sizeof( libewf_statistics_t )
+	 * so that members can be added in later versions
+	 */
+	size_t size;
+
+	/* The amount of chunks read from the segment files
+	 */
+	uint64_t amount_of_chunks_read;
+
+	/* The amount of chunks written to the segment files
+	 */
+	uint64_t amount_of_chunks_written;
+
+	/* The amount of chunks that were read from the chunk cache
+	 */
+	uint64_t amount_of_chunk_cache_hits;
+
+	/* The amount of chunks that were not in the chunk cache
+	 */
+	uint64_t amount_of_chunk_cache_misses;
+
+	/* The amount of chunk data bytes read from the segment files
+	 * this is the stored, possibly compressed, size
+	 */
+	uint64_t amount_of_stored_bytes_read;
+
+	/* The amount of media data bytes the chunks read contained
+	 * this is the uncompressed size
+	 */
+	uint64_t amount_of_media_bytes_read;
+
+	/* The amount of chunk data bytes written to the segment files
+	 * this is the stored, possibly compressed, size
+	 */
+	uint64_t amount_of_stored_bytes_written;
+
+	/* The amount of media data bytes the chunks written contained
+	 * this is the uncompressed size
+	 */
+	uint64_t amount_of_media_bytes_written;
+
+	/* The amount of chunks with a CRC mismatch
+	 */
+	uint64_t amount_of_crc_errors;
+
+	/* The amount of reads, writes, seeks, opens and closes
+	 * of the file io handles of the segment files
+	 */
+	uint64_t amount_of_file_io_reads;
+	uint64_t amount_of_file_io_writes;
+	uint64_t amount_of_file_io_seeks;
+	uint64_t amount_of_file_io_opens;
+	uint64_t amount_of_file_io_closes;
+
+	/* The time spent reading and writing chunks in the segment files
+	 */
+	uint64_t io_time;
+
+	/* The time spent compressing chunks (deflate)
+	 */
+	uint64_t compression_time;
+
+	/* The time spent decompressing chunks (inflate)
+	 */
+	uint64_t decompression_time;
+
+	/* The time spent calculating the chunk checksums (Adler-32)
+	 */
+	uint64_t checksum_time;
+};
+
 #endif
 
 #endif
@@ -40,6 +40,7 @@
 #include "libewf_sector_table.h"
 #include "libewf_segment_file.h"
 #include "libewf_segment_table.h"
+#include "libewf_statistics.h"
 #include "libewf_values_table.h"
 #include "libewf_write_io_handle.h"
 
@@ -120,6 +121,7 @@ int libewf_write_io_handle_free(
      liberror_error_t **error )
 {
 	static char *function = "libewf_write_io_handle_free";
+	int result            = 1;
 
 	if( write_io_handle == NULL )
 	{
@@ -144,12 +146,30 @@ int libewf_write_io_handle_free(
 			memory_free(
 			 ( *write_io_handle )->table_offsets );
 		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( *write_io_handle )->compression_pool != NULL )
+		{
+			if( libewf_compression_pool_free(
+			     &( ( *write_io_handle )->compression_pool ),
+			     error ) != 1 )
+			{
+				liberror_error_set(
+				 error,
+				 LIBERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free compression pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
 		memory_free(
 		 *write_io_handle );
 
 		*write_io_handle = NULL;
 	}
-	return( 1 );
+	return( result );
 }
 
 /* Initializes the write io handle value to start writing
@@ -302,6 +322,33 @@ int libewf_write_io_handle_initialize_values(
 			return( -1 );
 		}
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* Compress the chunks in parallel if more than one thread is allowed
+	 */
+	if( ( io_handle->maximum_number_of_threads > 1 )
+	 && ( write_io_handle->compression_pool == NULL ) )
+	{
+		if( libewf_compression_pool_initialize(
+		     &( write_io_handle->compression_pool ),
+		     media_values,
+		     &( io_handle->statistics ),
+		     io_handle->compression_level,
+		     io_handle->compression_flags,
+		     io_handle->ewf_format,
+		     io_handle->maximum_number_of_threads,
+		     error ) != 1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create compression pool.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
 
 	/* Flag that the write values were initialized
 	 */
@@ -1234,10 +1281,12 @@ ssize_t libewf_write_io_handle_process_chunk(
          uint8_t chunk_exists,
          ewf_crc_t *chunk_crc,
          int8_t *write_crc,
+         libewf_statistics_t *statistics,
          liberror_error_t **error )
 {
 	uint8_t *chunk_data_crc        = NULL;
 	static char *function          = "libewf_write_io_handle_process_chunk";
+	uint64_t timestamp             = 0;
 	size_t data_write_size         = 0;
 	int8_t chunk_compression_level = 0;
 	int chunk_cache_data_used      = 0;
@@ -1457,6 +1506,10 @@ ssize_t libewf_write_io_handle_process_chunk(
 		}
 		else
 		{
+			if( statistics != NULL )
+			{
+				timestamp = libewf_statistics_get_timestamp();
+			}
 			result = libewf_compress(
 				  (uint8_t *) compressed_chunk_data,
 				  compressed_chunk_data_size,
@@ -1509,6 +1562,12 @@ ssize_t libewf_write_io_handle_process_chunk(
 					  chunk_compression_level,
 					  error );
 			}
+			if( statistics != NULL )
+			{
+				libewf_statistics_add_time(
+				 statistics->compression_time,
+				 timestamp );
+			}
 			if( result != 1 )
 			{
 				liberror_error_set(
@@ -1588,11 +1647,21 @@ ssize_t libewf_write_io_handle_process_chunk(
 	}
 	else
 	{
+		if( statistics != NULL )
+		{
+			timestamp = libewf_statistics_get_timestamp();
+		}
 		*chunk_crc = ewf_crc_calculate(
 		              chunk_data,
 		              chunk_data_size,
 		              1 );
 
+		if( statistics != NULL )
+		{
+			libewf_statistics_add_time(
+			 statistics->checksum_time,
+			 timestamp );
+		}
 		data_write_size = chunk_data_size;
 		*is_compressed  = 0;
 
@@ -1613,6 +1682,12 @@ ssize_t libewf_write_io_handle_process_chunk(
 			*write_crc = 1;
 		}
 	}
+	if( statistics != NULL )
+	{
+		libewf_statistics_add(
+		 statistics->amount_of_media_bytes_written,
+		 chunk_data_size );
+	}
 	return( (ssize_t) data_write_size );
 }
 
@@ -1729,7 +1804,7 @@ ssize_t libewf_write_io_handle_write_new_chunk(
 	}
 	if( ( chunk < offset_table->amount_of_chunk_offsets )
 	 && ( offset_table->chunk_offset != NULL )
-	 && ( offset_table->chunk_offset[ chunk ].segment_file_handle != NULL ) )
+	 && ( offset_table->chunk_offset[ chunk ].segment_file_index != 0 ) )
 	{
 		liberror_error_set(
 		 error,
@@ -2417,11 +2492,14 @@ ssize_t libewf_write_io_handle_write_existing_chunk(
 	libewf_list_element_t *last_list_element          = NULL;
 	libewf_segment_file_handle_t *segment_file_handle = NULL;
 	static char *function                             = "libewf_write_io_handle_write_existing_chunk";
+	off64_t chunk_file_offset                         = 0;
 	off64_t last_section_start_offset                 = 0;
 	off64_t segment_file_offset                       = 0;
+	size_t chunk_offset_size                          = 0;
 	ssize_t total_write_count                         = 0;
 	ssize_t write_count                               = 0;
 	uint16_t segment_number                           = 0;
+	uint8_t chunk_offset_flags                        = 0;
 	uint8_t segment_file_type                         = 0;
 	uint8_t no_section_append                         = 0;
 	int result                                        = 0;
@@ -2571,8 +2649,25 @@ ssize_t libewf_write_io_handle_write_existing_chunk(
 
 		return( -1 );
 	}
-	segment_file_handle = offset_table->chunk_offset[ chunk ].segment_file_handle;
+	if( libewf_offset_table_get_chunk_offset(
+	     offset_table,
+	     chunk,
+	     &segment_file_handle,
+	     &chunk_file_offset,
+	     &chunk_offset_size,
+	     &chunk_offset_flags,
+	     error ) != 1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk offset: %" PRIu32 ".",
+		 function,
+		 chunk );
 
+		return( -1 );
+	}
 	if( segment_file_handle == NULL )
 	{
 		liberror_error_set(
@@ -2834,7 +2929,7 @@ ssize_t libewf_write_io_handle_write_existing_chunk(
 	}
 	else
 	{
-		segment_file_offset = offset_table->chunk_offset[ chunk ].file_offset
+		segment_file_offset = chunk_file_offset
 		                    - sizeof( ewfx_delta_chunk_header_t )
 		                    - sizeof( ewf_section_t );
 
@@ -2933,6 +3028,127 @@ ssize_t libewf_write_io_handle_write_existing_chunk(
 	return( total_write_count );
 }
 
+/* Writes the chunks processed by the compression pool in order
+ * Waits for all the queued chunks to be processed if flush is set
+ * Returns the amount of bytes written or -1 on error
+ */
+ssize_t libewf_write_io_handle_write_processed_chunks(
+         libewf_write_io_handle_t *write_io_handle,
+         libewf_io_handle_t *io_handle,
+         libewf_media_values_t *media_values,
+         libewf_offset_table_t *offset_table,
+         libewf_segment_table_t *segment_table,
+         libewf_values_table_t **header_values,
+         libewf_values_table_t *hash_values,
+         libewf_header_sections_t *header_sections,
+         libewf_hash_sections_t *hash_sections,
+         libewf_sector_table_t *sessions,
+         libewf_sector_table_t *acquiry_errors,
+         uint8_t flush,
+         liberror_error_t **error )
+{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	libewf_compression_pool_entry_t *entry = NULL;
+	int result                             = 0;
+#endif
+	static char *function                  = "libewf_write_io_handle_write_processed_chunks";
+	ssize_t total_write_count              = 0;
+	ssize_t write_count                    = 0;
+
+	if( write_io_handle == NULL )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write io handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( write_io_handle->compression_pool == NULL )
+	{
+		return( 0 );
+	}
+	do
+	{
+		result = libewf_compression_pool_get_processed_entry(
+		          write_io_handle->compression_pool,
+		          &entry,
+		          flush,
+		          error );
+
+		if( result == -1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve processed entry from compression pool.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result == 1 )
+		{
+			write_count = libewf_write_io_handle_write_new_chunk(
+			               write_io_handle,
+			               io_handle,
+			               media_values,
+			               offset_table,
+			               segment_table,
+			               header_values,
+			               hash_values,
+			               header_sections,
+			               hash_sections,
+			               sessions,
+			               acquiry_errors,
+			               entry->chunk,
+			               entry->data,
+			               entry->processed_data_size,
+			               entry->data_size,
+			               entry->is_compressed,
+			               entry->crc_buffer,
+			               entry->chunk_crc,
+			               entry->write_crc,
+			               error );
+
+			if( write_count <= -1 )
+			{
+				liberror_error_set(
+				 error,
+				 LIBERROR_ERROR_DOMAIN_IO,
+				 LIBERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write chunk: %" PRIu32 ".",
+				 function,
+				 entry->chunk );
+
+				return( -1 );
+			}
+			total_write_count += write_count;
+
+			if( libewf_compression_pool_remove_entry(
+			     write_io_handle->compression_pool,
+			     error ) != 1 )
+			{
+				liberror_error_set(
+				 error,
+				 LIBERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBERROR_RUNTIME_ERROR_REMOVE_FAILED,
+				 "%s: unable to remove entry from compression pool.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
+	while( result == 1 );
+#endif
+
+	return( total_write_count );
+}
+
 /* Writes a new chunk of data in EWF format from a buffer at the current offset
  * The necessary settings of the write values must have been made
  * Returns the amount of data bytes written, 0 when no longer bytes can be written or -1 on error
@@ -3156,6 +3372,89 @@ ssize_t libewf_write_io_handle_write_new_chunk_data(
 	{
 		crc_buffer = stored_crc_buffer;
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( write_io_handle->compression_pool != NULL )
+	{
+		if( write_size == media_values->chunk_size )
+		{
+			/* Write the chunks that have been processed, which makes sure a pool entry is available
+			 */
+			write_count = libewf_write_io_handle_write_processed_chunks(
+			               write_io_handle,
+			               io_handle,
+			               media_values,
+			               offset_table,
+			               segment_table,
+			               header_values,
+			               hash_values,
+			               header_sections,
+			               hash_sections,
+			               sessions,
+			               acquiry_errors,
+			               0,
+			               error );
+
+			if( write_count <= -1 )
+			{
+				liberror_error_set(
+				 error,
+				 LIBERROR_ERROR_DOMAIN_IO,
+				 LIBERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write processed chunks.",
+				 function );
+
+				return( -1 );
+			}
+			if( libewf_compression_pool_append_chunk(
+			     write_io_handle->compression_pool,
+			     chunk,
+			     chunk_buffer,
+			     write_size,
+			     error ) != 1 )
+			{
+				liberror_error_set(
+				 error,
+				 LIBERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append chunk: %" PRIu32 " to compression pool.",
+				 function,
+				 chunk );
+
+				return( -1 );
+			}
+			return( (ssize_t) read_size );
+		}
+		/* Write all the queued chunks before a partial chunk
+		 * so that the input write count is up to date
+		 */
+		write_count = libewf_write_io_handle_write_processed_chunks(
+		               write_io_handle,
+		               io_handle,
+		               media_values,
+		               offset_table,
+		               segment_table,
+		               header_values,
+		               hash_values,
+		               header_sections,
+		               hash_sections,
+		               sessions,
+		               acquiry_errors,
+		               1,
+		               error );
+
+		if( write_count <= -1 )
+		{
+			liberror_error_set(
+			 error,
+			 LIBERROR_ERROR_DOMAIN_IO,
+			 LIBERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write processed chunks.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
 	if( ( write_size == media_values->chunk_size )
 	 || ( ( media_values->media_size != 0 )
 	  && ( ( write_io_handle->input_write_count + (ssize64_t) write_size ) == (ssize64_t) media_values->media_size ) )
@@ -3183,6 +3482,7 @@ ssize_t libewf_write_io_handle_write_new_chunk_data(
 				   0,
 				   &chunk_crc,
 				   &write_crc,
+				   &( io_handle->statistics ),
 		                   error );
 
 		if( chunk_data_size <= -1 )
@@ -3511,6 +3811,23 @@ ssize_t libewf_write_io_handle_write_existing_chunk_data(
 
 		return( -1 );
 	}
+	/* Make sure the chunk is no longer cached
+	 */
+	if( libewf_chunk_cache_remove_entry(
+	     chunk_cache,
+	     chunk,
+	     error ) == -1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBERROR_RUNTIME_ERROR_REMOVE_FAILED,
+		 "%s: unable to remove chunk: %" PRIu32 " from chunk cache.",
+		 function,
+		 chunk );
+
+		return( -1 );
+	}
 	/* Report the amount of data written
 	 */
 	return( (ssize_t) data_size );
@@ -3630,6 +3947,36 @@ ssize_t libewf_write_io_handle_finalize(
 	{
 		return( 0 );
 	}
+	/* Write the chunks remaining in the compression pool to file
+	 */
+	write_count = libewf_write_io_handle_write_processed_chunks(
+	               write_io_handle,
+	               io_handle,
+	               media_values,
+	               offset_table,
+	               segment_table,
+	               header_values,
+	               hash_values,
+	               header_sections,
+	               hash_sections,
+	               sessions,
+	               acquiry_errors,
+	               1,
+	               error );
+
+	if( write_count == -1 )
+	{
+		liberror_error_set(
+		 error,
+		 LIBERROR_ERROR_DOMAIN_IO,
+		 LIBERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write processed chunks.",
+		 function );
+
+		return( -1 );
+	}
+	write_finalize_count += write_count;
+
 	/* Write data remaining in the chunk cache to file
 	 */
 	if( ( io_handle->current_chunk_offset != 0 )
@@ -29,6 +29,7 @@
 #include <liberror.h>
 
 #include "libewf_chunk_cache.h"
+#include "libewf_compression_pool.h"
 #include "libewf_libbfio.h"
 #include "libewf_io_handle.h"
 #include "libewf_media_values.h"
@@ -131,6 +132,12 @@ struct libewf_write_io_handle
 	/* Value to indicate if the write has been finalized
 	 */
 	uint8_t write_finalized;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The compression pool used to process chunks in parallel
+	 */
+	libewf_compression_pool_t *compression_pool;
+#endif
 };
 
 int libewf_write_io_handle_initialize(
@@ -221,6 +228,7 @@ ssize_t libewf_write_io_handle_process_chunk(
          uint8_t chunk_exists,
          ewf_crc_t *chunk_crc,
          int8_t *write_crc,
+         libewf_statistics_t *statistics,
          liberror_error_t **error );
 
 ssize_t libewf_write_io_handle_write_new_chunk(
@@ -262,6 +270,21 @@ ssize_t libewf_write_io_handle_write_existing_chunk(
          int8_t write_crc,
          liberror_error_t **error );
 
+ssize_t libewf_write_io_handle_write_processed_chunks(
+         libewf_write_io_handle_t *write_io_handle,
+         libewf_io_handle_t *io_handle,
+         libewf_media_values_t *media_values,
+         libewf_offset_table_t *offset_table,
+         libewf_segment_table_t *segment_table,
+         libewf_values_table_t **header_values,
+         libewf_values_table_t *hash_values,
+         libewf_header_sections_t *header_sections,
+         libewf_hash_sections_t *hash_sections,
+         libewf_sector_table_t *sessions,
+         libewf_sector_table_t *acquiry_errors,
+         uint8_t flush,
+         liberror_error_t **error );
+
 ssize_t libewf_write_io_handle_write_new_chunk_data(
          libewf_write_io_handle_t *write_io_handle,
          libewf_io_handle_t *io_handle,
@@ -50,6 +50,16 @@ PyMethodDef pyewf_object_methods[] = {
 	  METH_VARARGS | METH_KEYWORDS,
 	  "Read media data from EWF file(s)" },
 
+	{ "readinto",
+	  (PyCFunction) pyewf_file_read_buffer,
+	  METH_VARARGS | METH_KEYWORDS,
+	  "Read media data from EWF file(s) into a writable buffer" },
+
+	{ "read_at",
+	  (PyCFunction) pyewf_file_read_at_offset,
+	  METH_VARARGS | METH_KEYWORDS,
+	  "Read media data at a specific offset from EWF file(s) without changing the current offset" },
+
 	{ "seek",
 	  (PyCFunction) pyewf_file_seek_offset,
 	  METH_VARARGS | METH_KEYWORDS,
@@ -70,6 +80,11 @@ PyMethodDef pyewf_object_methods[] = {
 	  METH_NOARGS,
 	  "Retrieve all header values" },
 
+	{ "get_statistics",
+	  (PyCFunction) pyewf_file_get_statistics,
+	  METH_NOARGS,
+	  "Retrieve the read and write statistics" },
+
 	/* Sentinel */
 	{ NULL, NULL, 0, NULL }
 };
@@ -59,9 +59,25 @@ int pyewf_file_initialize(
 	int number_of_filenames     = 0;
 	int filename_iterator       = 0;
 
+#if defined( HAVE_V2_API )
+	int result                  = 0;
+#endif
+
 	pyewf_file->read_offset = 0;
 	pyewf_file->media_size  = 0;
 
+#if defined( WITH_THREAD )
+	pyewf_file->lock = PyThread_allocate_lock();
+
+	if( pyewf_file->lock == NULL )
+	{
+		PyErr_Format(
+		 PyExc_MemoryError,
+		 "Unable to create lock" );
+
+		return( -1 );
+	}
+#endif
 	if( PyArg_ParseTupleAndKeywords(
 	     arguments,
 	      keywords,
@@ -123,8 +139,8 @@ int pyewf_file_initialize(
 		                 sequence_object,
 		                 filename_iterator );
 
-		filename_size = PyString_Size(
-		                 string_object );
+		filename_size = 1 + PyString_Size(
+		                     string_object );
 
 		filenames[ filename_iterator ] = (char *) memory_allocate(
 		                                           sizeof( char ) * filename_size );
@@ -189,12 +205,18 @@ int pyewf_file_initialize(
 
 		return( -1 );
 	}
-	if( libewf_handle_open(
-	     pyewf_file->handle,
-             filenames,
-             number_of_filenames,
-             LIBEWF_OPEN_READ,
-	     NULL ) != 1 )
+	Py_BEGIN_ALLOW_THREADS
+
+	result = libewf_handle_open(
+	          pyewf_file->handle,
+	          filenames,
+	          number_of_filenames,
+	          LIBEWF_OPEN_READ,
+	          NULL );
+
+	Py_END_ALLOW_THREADS
+
+	if( result != 1 )
 	{
 		PyErr_Format(
 		 PyExc_IOError,
@@ -211,11 +233,15 @@ int pyewf_file_initialize(
 		return( -1 );
 	}
 #else
+	Py_BEGIN_ALLOW_THREADS
+
 	pyewf_file->handle = libewf_open(
 	                      filenames,
 	                      number_of_filenames,
 	                      LIBEWF_OPEN_READ );
 
+	Py_END_ALLOW_THREADS
+
 	if( pyewf_file->handle == NULL )
 	{
 		PyErr_Format(
@@ -273,6 +299,15 @@ int pyewf_file_initialize(
 void pyewf_file_free(
       pyewf_file_t *pyewf_file )
 {
+#if defined( WITH_THREAD )
+	if( pyewf_file->lock != NULL )
+	{
+		PyThread_free_lock(
+		 pyewf_file->lock );
+
+		pyewf_file->lock = NULL;
+	}
+#endif
 	pyewf_file->ob_type->tp_free(
 	 (PyObject*) pyewf_file );
 }
@@ -283,10 +318,32 @@ void pyewf_file_free(
 PyObject* pyewf_file_close(
            pyewf_file_t *pyewf_file )
 {
+	int result = 0;
+
+	Py_BEGIN_ALLOW_THREADS
+
+#if defined( WITH_THREAD )
+	PyThread_acquire_lock(
+	 pyewf_file->lock,
+	 WAIT_LOCK );
+#endif
 #if defined( HAVE_V2_API )
-	if( libewf_handle_close(
-	     pyewf_file->handle,
-	     NULL ) != 0 )
+	result = libewf_handle_close(
+	          pyewf_file->handle,
+	          NULL );
+#else
+	result = libewf_close(
+	          pyewf_file->handle );
+#endif
+#if defined( WITH_THREAD )
+	PyThread_release_lock(
+	 pyewf_file->lock );
+#endif
+
+	Py_END_ALLOW_THREADS
+
+#if defined( HAVE_V2_API )
+	if( result != 0 )
 	{
 		return( PyErr_Format(
 		         PyExc_IOError,
@@ -301,8 +358,7 @@ PyObject* pyewf_file_close(
 		         "libewf_handle_free failed to free handle" ) );
 	}
 #else
-	if( libewf_close(
-	     pyewf_file->handle ) != 0 )
+	if( result != 0 )
 	{
 		return( PyErr_Format(
 		         PyExc_IOError,
@@ -312,6 +368,69 @@ PyObject* pyewf_file_close(
 	return( Py_None );
 }
 
+/* Reads media data at a specific offset into a buffer
+ * The global interpreter lock is released while libewf reads the data
+ * the handle is locked since reading at an offset changes its current offset
+ * This function does not check if the data is within the media data
+ * Returns the amount of bytes read or -1 on error
+ */
+ssize_t pyewf_file_read_media_data(
+         pyewf_file_t *pyewf_file,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset )
+{
+	ssize_t read_count = 0;
+
+	if( size == 0 )
+	{
+		return( 0 );
+	}
+	Py_BEGIN_ALLOW_THREADS
+
+#if defined( WITH_THREAD )
+	PyThread_acquire_lock(
+	 pyewf_file->lock,
+	 WAIT_LOCK );
+#endif
+#if defined( HAVE_V2_API )
+	read_count = libewf_handle_read_random(
+	              pyewf_file->handle,
+	              buffer,
+	              size,
+	              offset,
+	              NULL );
+#else
+	read_count = libewf_read_random(
+	              pyewf_file->handle,
+	              buffer,
+	              size,
+	              offset );
+#endif
+#if defined( WITH_THREAD )
+	PyThread_release_lock(
+	 pyewf_file->lock );
+#endif
+
+	Py_END_ALLOW_THREADS
+
+	if( read_count != (ssize_t) size )
+	{
+		PyErr_Format(
+		 PyExc_IOError,
+#if defined( HAVE_V2_API )
+		 "libewf_handle_read_random failed to read data (requested %" PRIzd ", returned %" PRIzd ")",
+#else
+		 "libewf_read_random failed to read data (requested %" PRIzd ", returned %" PRIzd ")",
+#endif
+		 (ssize_t) size,
+		 read_count );
+
+		return( -1 );
+	}
+	return( read_count );
+}
+
 /* Read media data from a pyewf file object
  * Returns a Python object holding the data if successful or NULL on error
  */
@@ -355,40 +474,208 @@ PyObject* pyewf_file_read(
 	               NULL,
 	               read_size );
 
-#if defined( HAVE_V2_API )
-	read_count = libewf_handle_read_buffer(
-	              pyewf_file->handle,
-	              PyString_AsString(
-	               result_data),
+	if( result_data == NULL )
+	{
+		return( NULL );
+	}
+	read_count = pyewf_file_read_media_data(
+	              pyewf_file,
+	              (uint8_t *) PyString_AsString(
+	                           result_data ),
+	              (size_t) read_size,
+	              pyewf_file->read_offset );
+
+	if( read_count == -1 )
+	{
+		Py_DECREF(
+		 result_data );
+
+		return( NULL );
+	}
+	pyewf_file->read_offset += read_count;
+
+	return( result_data );
+}
+
+/* Read media data from a pyewf file object into a writable buffer object
+ * such as a bytearray, memoryview or array, without allocating a new string
+ * Returns a Python object holding the amount of bytes read if successful or NULL on error
+ */
+PyObject* pyewf_file_read_buffer(
+           pyewf_file_t *pyewf_file,
+           PyObject *arguments,
+           PyObject *keywords )
+{
+	static char *keyword_list[] = { "buffer", NULL };
+	ssize_t read_count          = 0;
+	size_t read_size            = 0;
+
+#if PY_VERSION_HEX >= 0x02060000
+	Py_buffer buffer;
+
+	if( PyArg_ParseTupleAndKeywords(
+	     arguments,
+	     keywords,
+	     "w*",
+	     keyword_list,
+	     &buffer ) == 0 )
+	{
+		return( NULL );
+	}
+	read_size = (size_t) buffer.len;
+#else
+	char *buffer_data           = NULL;
+	int buffer_size             = 0;
+
+	if( PyArg_ParseTupleAndKeywords(
+	     arguments,
+	     keywords,
+	     "w#",
+	     keyword_list,
+	     &buffer_data,
+	     &buffer_size ) == 0 )
+	{
+		return( NULL );
+	}
+	read_size = (size_t) buffer_size;
+#endif
+	/* Adjust the read size if it is larger than the size of the remaining media data
+	 */
+	if( pyewf_file->read_offset >= (off64_t) pyewf_file->media_size )
+	{
+		read_size = 0;
+	}
+	else if( (size64_t) read_size > ( pyewf_file->media_size - pyewf_file->read_offset ) )
+	{
+		read_size = (size_t) ( pyewf_file->media_size - pyewf_file->read_offset );
+	}
+	read_count = pyewf_file_read_media_data(
+	              pyewf_file,
+#if PY_VERSION_HEX >= 0x02060000
+	              (uint8_t *) buffer.buf,
+#else
+	              (uint8_t *) buffer_data,
+#endif
 	              read_size,
-	              NULL );
+	              pyewf_file->read_offset );
 
-	if( read_count != (ssize_t) read_size )
+#if PY_VERSION_HEX >= 0x02060000
+	PyBuffer_Release(
+	 &buffer );
+#endif
+
+	if( read_count == -1 )
+	{
+		return( NULL );
+	}
+	pyewf_file->read_offset += read_count;
+
+	return( PyInt_FromSsize_t(
+	         read_count ) );
+}
+
+/* Read media data at a specific offset from a pyewf file object
+ * This function does not change the current offset
+ * Returns a Python object holding the data if successful or NULL on error
+ */
+PyObject* pyewf_file_read_at_offset(
+           pyewf_file_t *pyewf_file,
+           PyObject *arguments,
+           PyObject *keywords )
+{
+	PyObject *result_data       = NULL;
+	static char *keyword_list[] = { "offset", "size", NULL };
+	off64_t read_offset         = 0;
+	ssize_t read_count          = 0;
+	int read_size               = 0;
+
+	if( PyArg_ParseTupleAndKeywords(
+	     arguments,
+	     keywords,
+	     "Li",
+	     keyword_list,
+	     &read_offset,
+	     &read_size ) == 0 )
+	{
+		return( NULL );
+	}
+	if( read_offset < 0 )
 	{
 		return( PyErr_Format(
-		         PyExc_IOError,
-		         "libewf_handle_read_buffer failed to read data (requested %" PRId32 ", returned %" PRIzd ")",
-		         read_size,
-		         read_count ) );
+		         PyExc_ValueError,
+		         "Invalid argument (offset): %" PRIi64,
+		         read_offset ) );
 	}
-#else
-	read_count = libewf_read_buffer(
-	              pyewf_file->handle,
-	              PyString_AsString(
-	               result_data),
-	              read_size );
+	if( read_size < 0 )
+	{
+		return( PyErr_Format(
+		         PyExc_ValueError,
+		         "Invalid argument (size): %d",
+		         read_size ) );
+	}
+	/* Adjust the read size if it is larger than the size of the remaining media data
+	 */
+	if( read_offset >= (off64_t) pyewf_file->media_size )
+	{
+		read_size = 0;
+	}
+	else if( (size64_t) read_size > ( pyewf_file->media_size - read_offset ) )
+	{
+		read_size = (int) ( pyewf_file->media_size - read_offset );
+	}
+	result_data = PyString_FromStringAndSize(
+	               NULL,
+	               read_size );
+
+	if( result_data == NULL )
+	{
+		return( NULL );
+	}
+#if defined( HAVE_V2_API )
+	/* The handle does not need to be locked since
+	 * libewf_handle_read_buffer_at_offset does not use the current offset
+	 */
+	if( read_size > 0 )
+	{
+		Py_BEGIN_ALLOW_THREADS
 
+		read_count = libewf_handle_read_buffer_at_offset(
+		              pyewf_file->handle,
+		              (uint8_t *) PyString_AsString(
+		                           result_data ),
+		              (size_t) read_size,
+		              read_offset,
+		              NULL );
+
+		Py_END_ALLOW_THREADS
+	}
 	if( read_count != (ssize_t) read_size )
 	{
+		Py_DECREF(
+		 result_data );
+
 		return( PyErr_Format(
 		         PyExc_IOError,
-		         "libewf_read_buffer failed to read data (requested %" PRId32 ", returned %" PRIzd ")",
+		         "libewf_handle_read_buffer_at_offset failed to read data (requested %" PRId32 ", returned %" PRIzd ")",
 		         read_size,
 		         read_count ) );
 	}
-#endif
-	pyewf_file->read_offset += read_count;
+#else
+	read_count = pyewf_file_read_media_data(
+	              pyewf_file,
+	              (uint8_t *) PyString_AsString(
+	                           result_data ),
+	              (size_t) read_size,
+	              read_offset );
+
+	if( read_count == -1 )
+	{
+		Py_DECREF(
+		 result_data );
 
+		return( NULL );
+	}
+#endif
 	return( result_data );
 }
 
@@ -842,3 +1129,107 @@ PyObject *pyewf_file_get_header_values(
 	return( dictionary_object );
 }
 
+/* Retrieves the statistics
+ * Returns a Python object holding the statistics if successful or NULL on error
+ */
+PyObject *pyewf_file_get_statistics(
+           pyewf_file_t *pyewf_file )
+{
+	libewf_statistics_t statistics;
+
+	const char *identifiers[ 18 ] = {
+		"amount_of_chunks_read",
+		"amount_of_chunks_written",
+		"amount_of_chunk_cache_hits",
+		"amount_of_chunk_cache_misses",
+		"amount_of_stored_bytes_read",
+		"amount_of_media_bytes_read",
+		"amount_of_stored_bytes_written",
+		"amount_of_media_bytes_written",
+		"amount_of_crc_errors",
+		"amount_of_file_io_reads",
+		"amount_of_file_io_writes",
+		"amount_of_file_io_seeks",
+		"amount_of_file_io_opens",
+		"amount_of_file_io_closes",
+		"io_time",
+		"compression_time",
+		"decompression_time",
+		"checksum_time" };
+
+	uint64_t values[ 18 ];
+
+	PyObject *dictionary_object = NULL;
+	PyObject *integer_object    = NULL;
+	int value_iterator          = 0;
+
+	statistics.size = sizeof( libewf_statistics_t );
+
+#if defined( HAVE_V2_API )
+	if( libewf_handle_get_statistics(
+	     pyewf_file->handle,
+	     &statistics,
+	     NULL ) != 1 )
+	{
+		return( PyErr_Format(
+		         PyExc_IOError,
+		         "libewf_handle_get_statistics failed to retrieve statistics" ) );
+	}
+#else
+	if( libewf_get_statistics(
+	     pyewf_file->handle,
+	     &statistics ) != 1 )
+	{
+		return( PyErr_Format(
+		         PyExc_IOError,
+		         "libewf_get_statistics failed to retrieve statistics" ) );
+	}
+#endif
+	values[ 0 ]  = statistics.amount_of_chunks_read;
+	values[ 1 ]  = statistics.amount_of_chunks_written;
+	values[ 2 ]  = statistics.amount_of_chunk_cache_hits;
+	values[ 3 ]  = statistics.amount_of_chunk_cache_misses;
+	values[ 4 ]  = statistics.amount_of_stored_bytes_read;
+	values[ 5 ]  = statistics.amount_of_media_bytes_read;
+	values[ 6 ]  = statistics.amount_of_stored_bytes_written;
+	values[ 7 ]  = statistics.amount_of_media_bytes_written;
+	values[ 8 ]  = statistics.amount_of_crc_errors;
+	values[ 9 ]  = statistics.amount_of_file_io_reads;
+	values[ 10 ] = statistics.amount_of_file_io_writes;
+	values[ 11 ] = statistics.amount_of_file_io_seeks;
+	values[ 12 ] = statistics.amount_of_file_io_opens;
+	values[ 13 ] = statistics.amount_of_file_io_closes;
+	values[ 14 ] = statistics.io_time;
+	values[ 15 ] = statistics.compression_time;
+	values[ 16 ] = statistics.decompression_time;
+	values[ 17 ] = statistics.checksum_time;
+
+	dictionary_object = PyDict_New();
+
+	if( dictionary_object == NULL )
+	{
+		return( NULL );
+	}
+	for( value_iterator = 0; value_iterator < 18; value_iterator++ )
+	{
+		integer_object = PyLong_FromUnsignedLongLong(
+		                  (unsigned PY_LONG_LONG) values[ value_iterator ] );
+
+		if( integer_object == NULL )
+		{
+			Py_DECREF(
+			 dictionary_object );
+
+			return( NULL );
+		}
+		PyDict_SetItemString(
+		 dictionary_object,
+		 identifiers[ value_iterator ],
+		 integer_object );
+
+		Py_DECREF(
+		 integer_object );
+	}
+	return( dictionary_object );
+}
+
@@ -35,6 +35,10 @@
 
 #include <Python.h>
 
+#if defined( WITH_THREAD )
+#include <pythread.h>
+#endif
+
 #include <libewf.h>
 
 #if defined( __cplusplus )
@@ -60,6 +64,13 @@ struct pyewf_file
 	/* The media size
 	 */
 	size64_t media_size;
+
+#if defined( WITH_THREAD )
+	/* The lock that serializes access to the libewf handle
+	 * while the global interpreter lock is released
+	 */
+	PyThread_type_lock lock;
+#endif
 };
 
 int pyewf_file_initialize(
@@ -78,6 +89,22 @@ PyObject* pyewf_file_read(
            PyObject *arguments,
            PyObject *keywords );
 
+PyObject* pyewf_file_read_buffer(
+           pyewf_file_t *pyewf_file,
+           PyObject *arguments,
+           PyObject *keywords );
+
+PyObject* pyewf_file_read_at_offset(
+           pyewf_file_t *pyewf_file,
+           PyObject *arguments,
+           PyObject *keywords );
+
+ssize_t pyewf_file_read_media_data(
+         pyewf_file_t *pyewf_file,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset );
+
 PyObject* pyewf_file_seek_offset(
            pyewf_file_t *pyewf_file,
            PyObject *arguments,
@@ -94,6 +121,9 @@ PyObject* pyewf_file_get_header_value(
 PyObject* pyewf_file_get_header_values(
            pyewf_file_t *pyewf_file );
 
+PyObject* pyewf_file_get_statistics(
+           pyewf_file_t *pyewf_file );
+
 #if defined( __cplusplus )
 }
 #endif